@@ -58,52 +58,55 @@ static bool DetectRectOverlap(vx_rectangle_t& a, vx_rectangle_t& b)
 	return (c.start_x < c.end_x) && (c.start_y < c.end_y) ? true : false;
 }
 
-void agoOptimizeDramaGetDataUsageOfROI(AgoGraph * agraph, AgoData * roiMasterImage, vx_uint32& inputUsageCount, vx_uint32& outputUsageCount, vx_uint32& inoutUsageCount)
+// image-ROIs of each master image in a data list, in list order
+typedef std::unordered_map<AgoData *, std::vector<AgoData *> > AgoRoiListMap;
+static void agoGetRoiListOfMaster(AgoDataList * dataList, AgoRoiListMap& roiListOfMaster)
+{
+	for (AgoData * data = dataList->head; data; data = data->next) {
+		if (data->ref.type == VX_TYPE_IMAGE && data->u.img.isROI) {
+			roiListOfMaster[data->u.img.roiMasterImage].push_back(data);
+		}
+	}
+}
+
+void agoOptimizeDramaGetDataUsageOfROI(const std::vector<AgoData *>& roiList, vx_uint32& inputUsageCount, vx_uint32& outputUsageCount, vx_uint32& inoutUsageCount)
 {
 	std::list<vx_rectangle_t> rectList;
 	vx_uint32 outputUsageCount_ = 0;
-	for (int isVirtual = 0; isVirtual <= 1; isVirtual++) {
-		for (AgoData * data = isVirtual ? agraph->ref.context->dataList.head : agraph->dataList.head; data; data = data->next) {
-			if (data->ref.type == VX_TYPE_IMAGE && data->u.img.isROI && data->u.img.roiMasterImage == roiMasterImage) {
-				inputUsageCount += data->inputUsageCount;
-				inoutUsageCount += data->inoutUsageCount;
-				if (data->outputUsageCount > 0) {
-					if (outputUsageCount == 0) {
-						bool detectedOverlap = false;
-						for (auto it = rectList.begin(); it != rectList.end(); it++) {
-							if (DetectRectOverlap(*it, data->u.img.rect_roi)) {
-								detectedOverlap = true;
-								break;
-							}
-						}
-						rectList.push_back(data->u.img.rect_roi);
-						if (detectedOverlap) {
-							outputUsageCount_ += data->outputUsageCount;
-						}
-						else {
-							outputUsageCount_ = max(outputUsageCount_, data->outputUsageCount);
-						}
-					}
-					else {
-						outputUsageCount_ += data->outputUsageCount;
+	for (AgoData * data : roiList) {
+		inputUsageCount += data->inputUsageCount;
+		inoutUsageCount += data->inoutUsageCount;
+		if (data->outputUsageCount > 0) {
+			if (outputUsageCount == 0) {
+				bool detectedOverlap = false;
+				for (auto it = rectList.begin(); it != rectList.end(); it++) {
+					if (DetectRectOverlap(*it, data->u.img.rect_roi)) {
+						detectedOverlap = true;
+						break;
 					}
 				}
+				rectList.push_back(data->u.img.rect_roi);
+				if (detectedOverlap) {
+					outputUsageCount_ += data->outputUsageCount;
+				}
+				else {
+					outputUsageCount_ = max(outputUsageCount_, data->outputUsageCount);
+				}
+			}
+			else {
+				outputUsageCount_ += data->outputUsageCount;
 			}
 		}
 	}
 	outputUsageCount += outputUsageCount_;
 }
 
-void agoOptimizeDramaMarkDataUsageOfROI(AgoGraph * agraph, AgoData * roiMasterImage, vx_uint32 inputUsageCount, vx_uint32 outputUsageCount, vx_uint32 inoutUsageCount)
+void agoOptimizeDramaMarkDataUsageOfROI(const std::vector<AgoData *>& roiList, vx_uint32 inputUsageCount, vx_uint32 outputUsageCount, vx_uint32 inoutUsageCount)
 {
-	for (int isVirtual = 0; isVirtual <= 1; isVirtual++) {
-		for (AgoData * data = isVirtual ? agraph->ref.context->dataList.head : agraph->dataList.head; data; data = data->next) {
-			if (data->ref.type == VX_TYPE_IMAGE && data->u.img.isROI && data->u.img.roiMasterImage == roiMasterImage) {
-				data->inputUsageCount = inputUsageCount;
-				data->outputUsageCount = outputUsageCount;
-				data->inoutUsageCount = inoutUsageCount;
-			}
-		}
+	for (AgoData * data : roiList) {
+		data->inputUsageCount = inputUsageCount;
+		data->outputUsageCount = outputUsageCount;
+		data->inoutUsageCount = inoutUsageCount;
 	}
 }
 
@@ -218,18 +221,24 @@ void agoOptimizeDramaMarkDataUsage(AgoGraph * agraph)
 			}
 		}
 	}
-	// add up ROI data usage
-	for (int isVirtual = 0; isVirtual <= 1; isVirtual++) {
+	// add up ROI data usage: collect the image-ROIs of each master image in one pass over the data lists
+	AgoRoiListMap roiListOfMaster;
+	agoGetRoiListOfMaster(&agraph->dataList, roiListOfMaster);
+	agoGetRoiListOfMaster(&agraph->ref.context->dataList, roiListOfMaster);
+	for (int isVirtual = 0; isVirtual <= 1 && !roiListOfMaster.empty(); isVirtual++) {
 		for (AgoData * data = isVirtual ? agraph->ref.context->dataList.head : agraph->dataList.head; data; data = data->next) {
 			if (data->ref.type == VX_TYPE_IMAGE && !data->u.img.isROI) {
-				agoOptimizeDramaGetDataUsageOfROI(agraph, data, data->inputUsageCount, data->outputUsageCount, data->inoutUsageCount);
-				agoOptimizeDramaMarkDataUsageOfROI(agraph, data, data->inputUsageCount, data->outputUsageCount, data->inoutUsageCount);
+				auto it = roiListOfMaster.find(data);
+				if (it != roiListOfMaster.end()) {
+					agoOptimizeDramaGetDataUsageOfROI(it->second, data->inputUsageCount, data->outputUsageCount, data->inoutUsageCount);
+					agoOptimizeDramaMarkDataUsageOfROI(it->second, data->inputUsageCount, data->outputUsageCount, data->inoutUsageCount);
+				}
 			}
 		}
 	}
 }
 
-static int agoSetDataHierarchicalLevel(AgoData * data, vx_uint32 hierarchical_level)
+static int agoSetDataHierarchicalLevel(AgoData * data, vx_uint32 hierarchical_level, const AgoRoiListMap * roiListOfMaster)
 {
 	data->hierarchical_level = hierarchical_level;
 	if(!hierarchical_level) {
@@ -245,20 +254,25 @@ static int agoSetDataHierarchicalLevel(AgoData * data, vx_uint32 hierarchical_le
 	// propagate hierarchical_level to all of its children (if available)
 	for (vx_uint32 child = 0; child < data->numChildren; child++) {
 		if (data->children[child]) {
-			agoSetDataHierarchicalLevel(data->children[child], hierarchical_level);
+			agoSetDataHierarchicalLevel(data->children[child], hierarchical_level, roiListOfMaster);
 		}
 	}
 	// propagate hierarchical_level to image-ROI master (if available)
 	if (data->ref.type == VX_TYPE_IMAGE) {
 		if (data->u.img.isROI) {
 			if (data->u.img.roiMasterImage && !data->u.img.roiMasterImage->hierarchical_level) {
-				agoSetDataHierarchicalLevel(data->u.img.roiMasterImage, hierarchical_level);
+				agoSetDataHierarchicalLevel(data->u.img.roiMasterImage, hierarchical_level, roiListOfMaster);
 			}
 		}
 		else if (hierarchical_level) {
-			for (AgoData * pdata = data->isVirtual ? ((AgoGraph *)data->ref.scope)->dataList.head : data->ref.context->dataList.head; pdata; pdata = pdata->next) {
-				if (pdata->ref.type == VX_TYPE_IMAGE && pdata->u.img.isROI && pdata->u.img.roiMasterImage == data && !pdata->hierarchical_level) {
-					agoSetDataHierarchicalLevel(pdata, hierarchical_level);
+			// roiListOfMaster[0] indexes the context data list and roiListOfMaster[1] the graph data list
+			const AgoRoiListMap& roiList = roiListOfMaster[data->isVirtual ? 1 : 0];
+			auto it = roiList.find(data);
+			if (it != roiList.end()) {
+				for (AgoData * pdata : it->second) {
+					if (!pdata->hierarchical_level) {
+						agoSetDataHierarchicalLevel(pdata, hierarchical_level, roiListOfMaster);
+					}
 				}
 			}
 		}
@@ -292,6 +306,11 @@ int agoOptimizeDramaComputeGraphHierarchy(AgoGraph * graph)
 
 	agoOptimizeDramaMarkDataUsage(graph);
 
+	// image-ROIs of each master image: [0] in context data list, [1] in graph data list
+	AgoRoiListMap roiListOfMaster[2];
+	agoGetRoiListOfMaster(&graph->ref.context->dataList, roiListOfMaster[0]);
+	agoGetRoiListOfMaster(&graph->dataList, roiListOfMaster[1]);
+
 	////////////////////////////////////////////////
 	// make sure that there is only one writer and
 	// make sure that virtual buffers always have a writer
@@ -326,7 +345,7 @@ int agoOptimizeDramaComputeGraphHierarchy(AgoGraph * graph)
 	////////////////////////////////////////////////
 	for (int isVirtual = 0; isVirtual <= 1; isVirtual++) {
 		for (AgoData * data = isVirtual ? graph->ref.context->dataList.head : graph->dataList.head; data; data = data->next) {
-			agoSetDataHierarchicalLevel(data, 0);
+			agoSetDataHierarchicalLevel(data, 0, roiListOfMaster);
 		}
 	}
 
@@ -384,7 +403,7 @@ int agoOptimizeDramaComputeGraphHierarchy(AgoGraph * graph)
 #endif
 				if (outputUsageCount == 0) {
 					// mark that this data object can be input to nodes with hierarchical_level = 1
-					agoSetDataHierarchicalLevel(data, 1);
+					agoSetDataHierarchicalLevel(data, 1, roiListOfMaster);
 				}
 			}
 		}
@@ -418,7 +437,7 @@ int agoOptimizeDramaComputeGraphHierarchy(AgoGraph * graph)
 			for (vx_uint32 arg = 0; arg < node->paramCount; arg++) {
 				AgoData * data = node->paramList[arg];
 				if (data && (kernel->argConfig[arg] & AGO_KERNEL_ARG_OUTPUT_FLAG))
-					agoSetDataHierarchicalLevel(data, node->hierarchical_level + 1);
+					agoSetDataHierarchicalLevel(data, node->hierarchical_level + 1, roiListOfMaster);
 			}
 		}
 	}
@@ -462,7 +481,7 @@ int agoOptimizeDramaComputeGraphHierarchy(AgoGraph * graph)
 					for (vx_uint32 arg = 0; arg < node->paramCount; arg++) {
 						AgoData * data = node->paramList[arg];
 						if (data && (kernel->argConfig[arg] & AGO_KERNEL_ARG_OUTPUT_FLAG))
-							agoSetDataHierarchicalLevel(data, node->hierarchical_level + 1);
+							agoSetDataHierarchicalLevel(data, node->hierarchical_level + 1, roiListOfMaster);
 					}
 				}
 			}
@@ -523,6 +542,11 @@ int agoOptimizeDrama(AgoGraph * agraph)
 	// perform divide
 	if (agoOptimizeDramaCheckArgs(agraph))
 		return -1;
+	if (agraph->optimizer_flags & AGO_GRAPH_OPTIMIZER_FLAG_PREOPTIMIZED) {
+		// nodes come from a graph snapshot that was optimized before export and
+		// agoVerifyGraph already computed the hierarchy: only allocate
+		return agoOptimizeDramaAlloc(agraph);
+	}
 	if (!(agraph->optimizer_flags & AGO_GRAPH_OPTIMIZER_FLAG_NO_DIVIDE)) { 
 		if(agoOptimizeDramaDivide(agraph)) 
 			return -1;
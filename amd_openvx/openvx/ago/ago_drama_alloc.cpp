@@ -852,6 +852,110 @@ static int agoOptimizeDramaAllocMergeSuperNodes(AgoGraph * graph)
 }
 #endif
 
+static int agoOptimizeDramaAllocCpuBuffers(AgoGraph * graph)
+{
+    // release the arena of a previous verification: its buffers are packed again below
+    if (graph->cpu_buffer_arena) {
+        for (AgoData * data = graph->dataList.head; data; data = data->next) {
+            if (!data->buffer_allocated && data->buffer >= graph->cpu_buffer_arena && data->buffer < graph->cpu_buffer_arena + graph->cpu_buffer_arena_size) {
+                data->buffer = nullptr;
+            }
+        }
+        agoReleaseMemory(graph->cpu_buffer_arena);
+        graph->cpu_buffer_arena = nullptr;
+        graph->cpu_buffer_arena_size = 0;
+    }
+    graph->cpu_buffer_bytes_saved = 0;
+    if (graph->optimizer_flags & AGO_GRAPH_OPTIMIZER_FLAG_NO_CPU_BUFFER_ALIAS)
+        return 0;
+
+    // get the list of virtual images that can share memory: plain images written by the graph and accessed only by CPU nodes,
+    // with a writer that covers the full image so that no pixel of another image is visible to consumers
+    auto isDataValidForArena = [=](AgoData * data) -> bool {
+        return data->isVirtual && !data->buffer && data->ref.type == VX_TYPE_IMAGE && !data->parent && !data->children &&
+            !data->u.img.isROI && !data->u.img.isUniform && data->roiDepList.empty() && !data->alias_data &&
+            !data->isInitialized && data->outputUsageCount == 1 && !(data->device_type_unused & AGO_TARGET_AFFINITY_CPU) &&
+            data->u.img.rect_valid.start_x == 0 && data->u.img.rect_valid.start_y == 0 &&
+            data->u.img.rect_valid.end_x == data->u.img.width && data->u.img.rect_valid.end_y == data->u.img.height;
+    };
+    for (AgoData * data = graph->dataList.head; data; data = data->next) {
+        data->hierarchical_life_start = INT_MAX;
+        data->hierarchical_life_end = 0;
+        data->initialization_flags = isDataValidForArena(data) ? 1 : 0;
+    }
+    // mark hierarchical level (start,end) of the images: CPU nodes at a level are executed before the next level starts,
+    // so images with disjoint [start,end] never hold live pixels at the same time
+    for (AgoNode * node = graph->nodeList.head; node; node = node->next) {
+        bool isCpuNode = node->attr_affinity.device_type == AGO_KERNEL_FLAG_DEVICE_CPU && !node->akernel->opencl_buffer_access_enable;
+#if (ENABLE_OPENCL || ENABLE_HIP)
+        isCpuNode = isCpuNode && !node->supernode;
+#endif
+        for (vx_uint32 i = 0; i < node->paramCount; i++) {
+            AgoData * data = node->paramList[i];
+            if (data && (data->initialization_flags & 1)) {
+                if (!isCpuNode) {
+                    data->initialization_flags = 0;
+                }
+                data->hierarchical_life_start = min(data->hierarchical_life_start, node->hierarchical_level);
+                data->hierarchical_life_end = max(data->hierarchical_life_end, node->hierarchical_level);
+            }
+        }
+    }
+    std::vector<AgoData *> D;
+    for (AgoData * data = graph->dataList.head; data; data = data->next) {
+        if ((data->initialization_flags & 1) && data->hierarchical_life_start <= data->hierarchical_life_end) {
+            D.push_back(data);
+        }
+    }
+    if (D.size() < 2)
+        return 0;
+
+    // place the largest images first at the lowest arena offset that doesn't overlap images with intersecting lifetimes:
+    // each slot keeps the padding of agoAllocMemory around the image so that kernels can over-read/write the same way
+    auto getSlotSize = [=](AgoData * data) -> vx_size {
+        return ALIGN32(ALIGN32(data->size) + 2 * AGO_MEMORY_ALLOC_EXTRA_PADDING);
+    };
+    std::stable_sort(D.begin(), D.end(), [=](AgoData * a, AgoData * b) { return getSlotSize(a) > getSlotSize(b); });
+    std::vector<vx_size> offset(D.size());
+    vx_size arenaSize = 0, separateSize = 0;
+    for (size_t i = 0; i < D.size(); i++) {
+        std::vector<std::pair<vx_size, vx_size>> busy;
+        for (size_t j = 0; j < i; j++) {
+            if (D[j]->hierarchical_life_start <= D[i]->hierarchical_life_end && D[i]->hierarchical_life_start <= D[j]->hierarchical_life_end) {
+                busy.push_back(std::make_pair(offset[j], offset[j] + getSlotSize(D[j])));
+            }
+        }
+        std::sort(busy.begin(), busy.end());
+        vx_size size = getSlotSize(D[i]), pos = 0;
+        for (auto& range : busy) {
+            if (range.first >= pos + size)
+                break;
+            pos = max(pos, range.second);
+        }
+        offset[i] = pos;
+        arenaSize = max(arenaSize, pos + size);
+        separateSize += size;
+    }
+    if (arenaSize >= separateSize)
+        return 0;
+
+    // allocate the arena and assign image buffers
+    graph->cpu_buffer_arena = (vx_uint8 *)agoAllocMemory(arenaSize);
+    if (!graph->cpu_buffer_arena) {
+        agoAddLogEntry(&graph->ref, VX_FAILURE, "ERROR: agoOptimizeDramaAllocCpuBuffers: agoAllocMemory(%d) failed\n", (int)arenaSize);
+        return -1;
+    }
+    graph->cpu_buffer_arena_size = arenaSize;
+    graph->cpu_buffer_bytes_saved = separateSize - arenaSize;
+    for (size_t i = 0; i < D.size(); i++) {
+        D[i]->buffer = graph->cpu_buffer_arena + offset[i] + AGO_MEMORY_ALLOC_EXTRA_PADDING;
+    }
+#if ENABLE_DEBUG_MESSAGES
+    agoAddLogEntry(&graph->ref, VX_SUCCESS, "OK: packed %d CPU virtual images into %d bytes (%d bytes saved)\n", (int)D.size(), (int)arenaSize, (int)graph->cpu_buffer_bytes_saved);
+#endif
+    return 0;
+}
+
 int agoOptimizeDramaAlloc(AgoGraph * agraph)
 {
     // return success if there is nothing to do
@@ -898,6 +1002,11 @@ int agoOptimizeDramaAlloc(AgoGraph * agraph)
     // remove unused data
     if (agoOptimizeDramaAllocRemoveUnusedData(agraph)) return -1;
 
+    // share memory between CPU virtual images with disjoint lifetimes
+    if (agoOptimizeDramaAllocCpuBuffers(agraph) < 0) {
+        return -1;
+    }
+
     // make sure all buffers are allocated and initialized
     for (AgoData * adata = agraph->dataList.head; adata; adata = adata->next) {
         if (agoAllocData(adata)) {
@@ -22,6 +22,171 @@ THE SOFTWARE.
 
 
 #include "ago_internal.h"
+#include <map>
+
+// check whether a node can be part of a fused pointwise node
+static bool agoOptimizeDramaMergeIsPointwiseNode(AgoGraph * agraph, AgoNode * anode)
+{
+	if (!agoGetFusedPointwiseOpName(anode->akernel->id) || anode->callback)
+		return false;
+#if (ENABLE_OPENCL || ENABLE_HIP)
+	// nodes without CPU affinity may get assigned to GPU in drama alloc
+	if (anode->attr_affinity.device_type != AGO_KERNEL_FLAG_DEVICE_CPU)
+		return false;
+#endif
+	// nodes referenced by graph parameters have to stay in the graph
+	for (auto parameter : agraph->parameters) {
+		if (parameter && parameter->scope == &anode->ref)
+			return false;
+	}
+	// all images of a fused node have the same dimensions
+	AgoData * oImg = anode->paramList[0];
+	for (vx_uint32 arg = 0; arg < anode->paramCount; arg++) {
+		AgoData * data = anode->paramList[arg];
+		if (!data)
+			return false;
+		if (data->ref.type == VX_TYPE_IMAGE && (data->u.img.width != oImg->u.img.width || data->u.img.height != oImg->u.img.height))
+			return false;
+	}
+	return true;
+}
+
+// check whether an output image can be kept in a strip buffer of a fused node:
+// it should be a plain virtual image that is written once and read once within the graph
+static bool agoOptimizeDramaMergeIsIntermediateImage(AgoData * data)
+{
+	return data->isVirtual && data->ref.type == VX_TYPE_IMAGE && !data->parent && !data->children &&
+		!data->u.img.isROI && !data->u.img.isUniform && data->roiDepList.empty() && !data->alias_data &&
+		data->inputUsageCount == 1 && data->outputUsageCount == 1 && data->inoutUsageCount == 0;
+}
+
+// generate the program of a fused node for nodes in topological order with group.back() as the only
+// node with an output outside the group: returns false if the group doesn't fit in a fused node
+static bool agoOptimizeDramaMergeGetPointwiseProgram(AgoKernel * fusedKernel, const std::vector<AgoNode *>& group, std::string& program, std::vector<AgoData *>& paramList)
+{
+	std::map<AgoData *, vx_uint32> tempIndex;
+	bool tempBusy[CONFIG_FUSED_POINTWISE_MAX_TEMPS] = { false };
+	program.clear();
+	paramList.assign(2, nullptr);
+	paramList[0] = group.back()->paramList[0];
+	for (size_t i = 0; i < group.size(); i++) {
+		AgoNode * anode = group[i];
+		std::string args;
+		std::vector<vx_uint32> tempReleased;
+		for (vx_uint32 arg = 1; arg < anode->paramCount; arg++) {
+			AgoData * data = anode->paramList[arg];
+			auto it = tempIndex.find(data);
+			if (it != tempIndex.end()) {
+				args += ",t" + std::to_string(it->second);
+				tempReleased.push_back(it->second);
+			}
+			else {
+				size_t index = std::find(paramList.begin() + 2, paramList.end(), data) - paramList.begin();
+				if (index == paramList.size())
+					paramList.push_back(data);
+				args += "," + std::to_string(index);
+			}
+		}
+		// the output is kept in the first free strip buffer, unless it is the output of the fused node
+		if (anode == group.back()) {
+			args = "0" + args;
+		}
+		else {
+			vx_uint32 index = 0;
+			while (index < CONFIG_FUSED_POINTWISE_MAX_TEMPS && tempBusy[index])
+				index++;
+			if (index == CONFIG_FUSED_POINTWISE_MAX_TEMPS)
+				return false;
+			tempBusy[index] = true;
+			tempIndex[anode->paramList[0]] = index;
+			args = "t" + std::to_string(index) + args;
+		}
+		for (auto index : tempReleased)
+			tempBusy[index] = false;
+		if (!program.empty())
+			program += ";";
+		program += std::string(agoGetFusedPointwiseOpName(anode->akernel->id)) + "(" + args + ")";
+	}
+	return group.size() <= CONFIG_FUSED_POINTWISE_MAX_OPS && paramList.size() <= fusedKernel->argCount &&
+		program.length() < VX_MAX_STRING_BUFFER_SIZE_AMD;
+}
+
+// fuse chains of pointwise CPU nodes into VX_KERNEL_AMD_FUSED_POINTWISE_DATA_DATA nodes, so that
+// intermediate images are processed in cache-resident strips instead of full images in memory
+static int agoOptimizeDramaMergePointwiseNodes(AgoGraph * agraph)
+{
+	AgoKernel * fusedKernel = agoFindKernelByEnum(agraph->ref.context, VX_KERNEL_AMD_FUSED_POINTWISE_DATA_DATA);
+	if (!fusedKernel)
+		return 0;
+
+	// find the consumer of each intermediate image
+	std::map<AgoData *, AgoNode *> consumer;
+	for (AgoNode * anode = agraph->nodeList.head; anode; anode = anode->next) {
+		if (agoOptimizeDramaMergeIsPointwiseNode(agraph, anode)) {
+			for (vx_uint32 arg = 1; arg < anode->paramCount; arg++) {
+				AgoData * data = anode->paramList[arg];
+				if (agoOptimizeDramaMergeIsIntermediateImage(data))
+					consumer[data] = anode;
+			}
+		}
+	}
+
+	// group the nodes by the last node of the chain: nodeList is sorted by hierarchy, so each group is in topological order
+	std::map<AgoNode *, std::vector<AgoNode *>> groups;
+	std::vector<AgoNode *> sinks;
+	for (AgoNode * anode = agraph->nodeList.head; anode; anode = anode->next) {
+		if (agoOptimizeDramaMergeIsPointwiseNode(agraph, anode)) {
+			AgoNode * sink = anode;
+			for (auto it = consumer.find(sink->paramList[0]); it != consumer.end(); it = consumer.find(sink->paramList[0]))
+				sink = it->second;
+			if (groups.find(sink) == groups.end())
+				sinks.push_back(sink);
+			groups[sink].push_back(anode);
+		}
+	}
+
+	int fusedCount = 0;
+	for (auto sink : sinks) {
+		// drop the first nodes of the chain until the rest fits in a fused node
+		std::vector<AgoNode *>& group = groups[sink];
+		std::string program;
+		std::vector<AgoData *> paramList;
+		while (group.size() >= 2 && !agoOptimizeDramaMergeGetPointwiseProgram(fusedKernel, group, program, paramList))
+			group.erase(group.begin());
+		if (group.size() < 2)
+			continue;
+
+		// create the fused node and remove the original nodes
+		AgoData * dataProgram = agoCreateDataFromDescription(agraph->ref.context, agraph, ("scalar:STRING," + program).c_str(), false);
+		if (!dataProgram)
+			return -1;
+		agoAddData(&agraph->dataList, dataProgram);
+		paramList[1] = dataProgram;
+		AgoNode * childnode = agoCreateNode(agraph, fusedKernel);
+		for (size_t arg = 0; arg < paramList.size(); arg++) {
+			childnode->paramList[arg] = paramList[arg];
+		}
+		agoImportNodeConfig(childnode, sink);
+		debug_printf("INFO: agoOptimizeDramaMergePointwiseNodes: added node %s with %s\n", childnode->akernel->name, program.c_str());
+		for (auto anode : group) {
+			if (agoRemoveNode(&agraph->nodeList, anode, true)) {
+				agoAddLogEntry(&agraph->ref, VX_FAILURE, "ERROR: agoOptimizeDramaMergePointwiseNodes: agoRemoveNode(*,%s) failed\n", anode->akernel->name);
+				return -1;
+			}
+		}
+		if (agoVerifyNode(childnode)) {
+			return -1;
+		}
+		fusedCount++;
+	}
+	if (fusedCount > 0) {
+		// keep nodeList sorted by hierarchy for the next iteration and the later passes
+		if (agoOptimizeDramaComputeGraphHierarchy(agraph))
+			return -1;
+		agoOptimizeDramaSortGraphHierarchy(agraph);
+	}
+	return fusedCount;
+}
 
 int agoOptimizeDramaMerge(AgoGraph * agraph)
 {
@@ -30,8 +195,13 @@ int agoOptimizeDramaMerge(AgoGraph * agraph)
 		// check and mark data usage
 		agoOptimizeDramaMarkDataUsage(agraph);
 
-		// TBD
 		graphGotModified = 0;
+		if (!(agraph->optimizer_flags & AGO_GRAPH_OPTIMIZER_FLAG_NO_POINTWISE_FUSION)) {
+			int status = agoOptimizeDramaMergePointwiseNodes(agraph);
+			if (status < 0)
+				return -1;
+			graphGotModified = status;
+		}
 	}
 	return 0;
 }
@@ -0,0 +1,737 @@
+/* 
+Copyright (c) 2015 - 2022 Advanced Micro Devices, Inc. All rights reserved.
+ 
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+ 
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+ 
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+#include "ago_internal.h"
+
+// Queue-based graph pipelining (vx_khr_pipelining):
+// - every frame takes one enqueued reference from each queued graph parameter and runs on a graph instance;
+//   instance 0 is the graph itself and the other instances are replicas with their own virtual data,
+//   cloned before the graph is optimized, so that up to CONFIG_GRAPH_PIPELINE_MAX_DEPTH frames execute
+//   concurrently: frame N+1 starts its first hierarchical levels while frame N is still running
+// - the references are bound by rewriting the node parameters that use the graph parameter after optimization
+// - frames complete in the order they were launched, which moves the references to the done queues
+//   and delivers the registered events
+
+static AgoData * agoGetRootData(AgoData * data)
+{
+    while (data->parent)
+        data = data->parent;
+    return data;
+}
+
+static int agoGraphFindQueue(AgoGraph * graph, AgoData * data)
+{
+    for (size_t q = 0; q < graph->paramQueues.size(); q++) {
+        if (graph->paramQueues[q].data == data)
+            return (int)q;
+    }
+    return -1;
+}
+
+static bool agoIsQueueReferenceCompatible(AgoContext * acontext, AgoData * data, AgoData * ref)
+{
+    if (ref == data)
+        return true;
+    if (ref->ref.type != data->ref.type || ref->isVirtual || ref->numChildren != data->numChildren)
+        return false;
+    switch (ref->ref.type) {
+    case VX_TYPE_IMAGE:
+        return !ref->u.img.isROI && ref->u.img.width == data->u.img.width && ref->u.img.height == data->u.img.height && ref->u.img.format == data->u.img.format;
+    case VX_TYPE_ARRAY:
+        return ref->u.arr.itemtype == data->u.arr.itemtype && ref->u.arr.itemsize == data->u.arr.itemsize && ref->u.arr.capacity == data->u.arr.capacity;
+    case VX_TYPE_SCALAR:
+        return ref->u.scalar.type == data->u.scalar.type;
+    case VX_TYPE_TENSOR:
+        return !ref->u.tensor.roiMaster && ref->u.tensor.num_dims == data->u.tensor.num_dims && ref->u.tensor.data_type == data->u.tensor.data_type &&
+            ref->u.tensor.fixed_point_pos == data->u.tensor.fixed_point_pos && !memcmp(ref->u.tensor.dims, data->u.tensor.dims, sizeof(vx_size) * data->u.tensor.num_dims);
+    default:
+        char descData[1024], descRef[1024];
+        agoGetDescriptionFromData(acontext, descData, data);
+        agoGetDescriptionFromData(acontext, descRef, ref);
+        return !strcmp(descData, descRef);
+    }
+}
+
+static int agoAddQueueReference(AgoGraph * graph, AgoGraphParameterQueue& queue, AgoData * ref)
+{
+    if (std::find(queue.refs.begin(), queue.refs.end(), ref) != queue.refs.end())
+        return VX_SUCCESS;
+    if (!agoIsQueueReferenceCompatible(graph->ref.context, queue.data, ref)) {
+        agoAddLogEntry(&graph->ref, VX_ERROR_INVALID_PARAMETERS, "ERROR: graph parameter %d: %s doesn't match the reference used to verify the graph\n", queue.index, ref->name.c_str());
+        return VX_ERROR_INVALID_PARAMETERS;
+    }
+    if (agoAllocData(ref)) {
+        agoAddLogEntry(&graph->ref, VX_ERROR_NO_MEMORY, "ERROR: graph parameter %d: agoAllocData(%s) failed\n", queue.index, ref->name.c_str());
+        return VX_ERROR_NO_MEMORY;
+    }
+    queue.refs.push_back(ref);
+    return VX_SUCCESS;
+}
+
+int agoGraphSetScheduleConfig(AgoGraph * graph, vx_enum mode, vx_uint32 count, const vx_graph_parameter_queue_params_t * params)
+{
+    if (mode != VX_GRAPH_SCHEDULE_MODE_NORMAL && mode != VX_GRAPH_SCHEDULE_MODE_QUEUE_AUTO && mode != VX_GRAPH_SCHEDULE_MODE_QUEUE_MANUAL)
+        return VX_ERROR_INVALID_PARAMETERS;
+    if (mode == VX_GRAPH_SCHEDULE_MODE_NORMAL && (count > 0 || params))
+        return VX_ERROR_INVALID_PARAMETERS;
+    if (count > 0 && !params)
+        return VX_ERROR_INVALID_PARAMETERS;
+    for (vx_uint32 i = 0; i < count; i++) {
+        if (params[i].graph_parameter_index >= graph->parameters.size() || !graph->parameters[params[i].graph_parameter_index] || params[i].refs_list_size < 1)
+            return VX_ERROR_INVALID_PARAMETERS;
+        for (vx_uint32 j = 0; j < i; j++) {
+            if (params[j].graph_parameter_index == params[i].graph_parameter_index)
+                return VX_ERROR_INVALID_PARAMETERS;
+        }
+        if (params[i].refs_list) {
+            for (vx_uint32 k = 0; k < params[i].refs_list_size; k++) {
+                if (!agoIsValidReference(params[i].refs_list[k]))
+                    return VX_ERROR_INVALID_REFERENCE;
+            }
+        }
+    }
+
+    if (graph->verified) {
+        // after verify, only the references of the queues can be supplied
+        if (mode != graph->schedule_mode || count != graph->paramQueues.size() || !graph->pipeline) {
+            agoAddLogEntry(&graph->ref, VX_FAILURE, "ERROR: vxSetGraphScheduleConfig: only refs_list can be changed after vxVerifyGraph\n");
+            return VX_FAILURE;
+        }
+        std::lock_guard<std::mutex> lock(graph->pipeline->lock);
+        for (vx_uint32 i = 0; i < count; i++) {
+            AgoGraphParameterQueue& queue = graph->paramQueues[i];
+            if (queue.index != params[i].graph_parameter_index || queue.refs_list_size != params[i].refs_list_size)
+                return VX_ERROR_INVALID_PARAMETERS;
+            for (vx_uint32 k = 0; params[i].refs_list && k < params[i].refs_list_size; k++) {
+                vx_status status = agoAddQueueReference(graph, queue, (AgoData *)params[i].refs_list[k]);
+                if (status != VX_SUCCESS)
+                    return status;
+            }
+        }
+        return VX_SUCCESS;
+    }
+
+    graph->schedule_mode = mode;
+    graph->paramQueues.clear();
+    for (vx_uint32 i = 0; i < count; i++) {
+        AgoGraphParameterQueue queue;
+        queue.index = params[i].graph_parameter_index;
+        queue.refs_list_size = params[i].refs_list_size;
+        queue.data = nullptr;
+        if (params[i].refs_list) {
+            // the first reference is used to verify the graph
+            vx_status status = vxSetGraphParameterByIndex(graph, queue.index, params[i].refs_list[0]);
+            if (status != VX_SUCCESS)
+                return status;
+            for (vx_uint32 k = 0; k < params[i].refs_list_size; k++)
+                queue.refs.push_back((AgoData *)params[i].refs_list[k]);
+        }
+        graph->paramQueues.push_back(queue);
+    }
+    return VX_SUCCESS;
+}
+
+static bool agoGraphIsReplicable(AgoGraph * graph, char * reason)
+{
+    // replicas share all the non-virtual data, so only the queued graph parameters may be written by nodes
+    if (!graph->autoAgeDelayList.empty()) {
+        strcpy(reason, "graph has auto-aged delays");
+        return false;
+    }
+    for (AgoNode * node = graph->nodeList.head; node; node = node->next) {
+        if (node->localDataPtr) {
+            sprintf(reason, "node %s has local data set by the application", node->akernel->name);
+            return false;
+        }
+#if (ENABLE_OPENCL||ENABLE_HIP)
+        if (node->attr_affinity.device_type != AGO_KERNEL_FLAG_DEVICE_CPU) {
+            sprintf(reason, "node %s doesn't have CPU affinity", node->akernel->name);
+            return false;
+        }
+#endif
+        for (vx_uint32 i = 0; i < node->paramCount; i++) {
+            AgoData * data = node->paramList[i];
+            if (!data)
+                continue;
+            if (agoIsPartOfDelay(data)) {
+                sprintf(reason, "node %s uses a delay object", node->akernel->name);
+                return false;
+            }
+            AgoData * root = agoGetRootData(data);
+            if (node->parameters[i].direction != VX_INPUT && !root->isVirtual && agoGraphFindQueue(graph, root) < 0) {
+                sprintf(reason, "node %s writes %s which is not a queued graph parameter", node->akernel->name, root->name.c_str());
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static void agoAddDataTreeToGraph(AgoGraph * graph, AgoData * data)
+{
+    agoAddData(&graph->dataList, data);
+    for (vx_uint32 i = 0; i < data->numChildren; i++) {
+        if (data->children[i])
+            agoAddDataTreeToGraph(graph, data->children[i]);
+    }
+}
+
+static bool agoMapDataTree(std::map<AgoData *, AgoData *>& dataMap, AgoData * data, AgoData * clone)
+{
+    dataMap[data] = clone;
+    if (data->numChildren != clone->numChildren)
+        return false;
+    for (vx_uint32 i = 0; i < data->numChildren; i++) {
+        if (!data->children[i] != !clone->children[i])
+            return false;
+        if (data->children[i] && !agoMapDataTree(dataMap, data->children[i], clone->children[i]))
+            return false;
+    }
+    return true;
+}
+
+static void agoReleaseGraphReplica(AgoGraph * replica)
+{
+    AgoContext * acontext = replica->ref.context;
+    CAgoLock lock(acontext->cs);
+    for (AgoNode * node = replica->nodeList.head; node; node = node->next) {
+        agoShutdownNode(node);
+    }
+#if ENABLE_OPENCL
+    agoGpuOclReleaseGraph(replica);
+#elif ENABLE_HIP
+    agoGpuHipReleaseGraph(replica);
+#endif
+    // replicas are not part of the context graph list: move it to the garbage list directly
+    replica->ref.internal_count = 0;
+    replica->next = acontext->graph_garbage_list;
+    acontext->graph_garbage_list = replica;
+}
+
+static AgoGraph * agoCreateGraphReplica(AgoGraph * graph, std::map<AgoNode *, AgoNode *>& nodeMap)
+{
+    AgoContext * acontext = graph->ref.context;
+    AgoGraph * replica = new AgoGraph;
+    agoResetReference(&replica->ref, VX_TYPE_GRAPH, acontext, NULL);
+    replica->ref.internal_count = 1;
+    replica->name = graph->name;
+    replica->attr_affinity = graph->attr_affinity;
+    replica->optimizer_flags = graph->optimizer_flags;
+    replica->state = VX_GRAPH_STATE_UNVERIFIED;
+
+    // clone the virtual data
+    std::map<AgoData *, AgoData *> dataMap;
+    bool success = true;
+    for (AgoData * data = graph->dataList.head; data && success; data = data->next) {
+        if (data->parent || !data->isVirtual)
+            continue;
+        char desc[1024];
+        agoGetDescriptionFromData(acontext, desc, data);
+        AgoData * clone = agoCreateDataFromDescription(acontext, replica, desc, false);
+        if (!clone) {
+            success = false;
+            break;
+        }
+        clone->name = data->name;
+        agoAddDataTreeToGraph(replica, clone);
+        success = agoMapDataTree(dataMap, data, clone);
+    }
+
+    // clone the nodes in the same order: the non-virtual data is shared
+    for (AgoNode * node = graph->nodeList.head; node && success; node = node->next) {
+        AgoNode * copy = agoCreateNode(replica, node->akernel);
+        copy->attr_border_mode = node->attr_border_mode;
+        copy->attr_affinity = node->attr_affinity;
+        copy->valid_rect_reset = node->valid_rect_reset;
+        copy->localDataSize = node->localDataSize;
+        copy->callback = node->callback;
+        for (vx_uint32 i = 0; i < node->paramCount; i++) {
+            AgoData * data = node->paramList[i];
+            if (!data)
+                continue;
+            auto it = dataMap.find(data);
+            if (it != dataMap.end())
+                data = it->second;
+            else if (agoGetRootData(data)->isVirtual) {
+                success = false;
+                break;
+            }
+            copy->paramList[i] = copy->paramListForAgeDelay[i] = data;
+            agoRetainData(replica, data, false);
+        }
+        nodeMap[node] = copy;
+    }
+
+    if (!success) {
+        agoReleaseGraphReplica(replica);
+        return nullptr;
+    }
+    return replica;
+}
+
+void agoGraphPipelineRelease(AgoGraph * graph)
+{
+    AgoGraphPipeline * pipeline = graph->pipeline;
+    if (!pipeline)
+        return;
+    {
+        std::lock_guard<std::mutex> lock(pipeline->lock);
+        pipeline->terminate = true;
+    }
+    pipeline->cv.notify_all();
+    for (auto& instance : pipeline->instances) {
+        if (instance->thread.joinable())
+            instance->thread.join();
+    }
+    for (auto& instance : pipeline->instances) {
+        if (instance->graph != graph)
+            agoReleaseGraphReplica(instance->graph);
+    }
+    for (auto& queue : graph->paramQueues) {
+        queue.ready.clear();
+        queue.done.clear();
+    }
+    delete pipeline;
+    graph->pipeline = nullptr;
+}
+
+int agoGraphPipelinePrepare(AgoGraph * graph)
+{
+    // re-verification starts over with new replicas
+    agoGraphPipelineRelease(graph);
+
+    vx_uint32 depth = CONFIG_GRAPH_PIPELINE_MAX_DEPTH;
+    for (auto& queue : graph->paramQueues) {
+        vx_parameter parameter = graph->parameters[queue.index];
+        queue.data = ((AgoNode *)parameter->scope)->paramList[parameter->index];
+        if (!queue.data || queue.data->isVirtual || queue.data->parent || (queue.data->ref.type == VX_TYPE_IMAGE && queue.data->u.img.isROI)) {
+            agoAddLogEntry(&graph->ref, VX_ERROR_INVALID_PARAMETERS, "ERROR: graph parameter %d: a queued graph parameter needs a non-virtual reference\n", queue.index);
+            return VX_ERROR_INVALID_PARAMETERS;
+        }
+        depth = min(depth, queue.refs_list_size);
+    }
+
+    AgoGraphPipeline * pipeline = new AgoGraphPipeline;
+    pipeline->launchCount = 0;
+    pipeline->completeCount = 0;
+    pipeline->status = VX_SUCCESS;
+    pipeline->terminate = false;
+    agoPerfCaptureReset(&pipeline->perf);
+    pipeline->instances.emplace_back(new AgoGraphInstance);
+    pipeline->instances[0]->graph = graph;
+    graph->pipeline = pipeline;
+
+    char reason[1024] = "";
+    if (depth > 1 && !agoGraphIsReplicable(graph, reason)) {
+        agoAddLogEntry(&graph->ref, VX_SUCCESS, "WARNING: graph pipelining depth is 1: %s\n", reason);
+        depth = 1;
+    }
+    for (vx_uint32 i = 1; i < depth; i++) {
+        std::unique_ptr<AgoGraphInstance> instance(new AgoGraphInstance);
+        instance->graph = agoCreateGraphReplica(graph, instance->nodeMap);
+        if (!instance->graph) {
+            agoAddLogEntry(&graph->ref, VX_SUCCESS, "WARNING: graph pipelining depth is %d: unable to replicate the graph\n", i);
+            break;
+        }
+        pipeline->instances.push_back(std::move(instance));
+    }
+    return VX_SUCCESS;
+}
+
+static int agoGraphInstanceFindSlots(AgoGraph * graph, AgoGraphInstance * instance)
+{
+    instance->slots.assign(graph->paramQueues.size(), std::vector<AgoGraphQueueSlot>());
+    for (size_t q = 0; q < graph->paramQueues.size(); q++) {
+        AgoData * data = graph->paramQueues[q].data;
+        for (AgoNode * node = instance->graph->nodeList.head; node; node = node->next) {
+            for (vx_uint32 i = 0; i < node->paramCount; i++) {
+                AgoData * param = node->paramList[i];
+                if (!param)
+                    continue;
+                vx_int32 child = -2;
+                if (param == data)
+                    child = -1;
+                else if (param->parent == data)
+                    child = param->siblingIndex;
+                else if (param->ref.type == VX_TYPE_IMAGE && param->u.img.isROI && param->u.img.roiMasterImage == data) {
+                    agoAddLogEntry(&graph->ref, VX_ERROR_NOT_SUPPORTED, "ERROR: graph parameter %d: ROI of a queued graph parameter is not supported\n", graph->paramQueues[q].index);
+                    return VX_ERROR_NOT_SUPPORTED;
+                }
+                if (child < -1)
+                    continue;
+                if (child >= 0 && ((vx_uint32)child >= data->numChildren || data->children[child] != param)) {
+                    agoAddLogEntry(&graph->ref, VX_ERROR_NOT_SUPPORTED, "ERROR: graph parameter %d: unable to locate %s\n", graph->paramQueues[q].index, param->name.c_str());
+                    return VX_ERROR_NOT_SUPPORTED;
+                }
+#if (ENABLE_OPENCL||ENABLE_HIP)
+                if (node->attr_affinity.device_type == AGO_KERNEL_FLAG_DEVICE_GPU) {
+                    agoAddLogEntry(&graph->ref, VX_ERROR_NOT_SUPPORTED, "ERROR: graph parameter %d: queued graph parameters are not supported on GPU nodes\n", graph->paramQueues[q].index);
+                    return VX_ERROR_NOT_SUPPORTED;
+                }
+#endif
+                instance->slots[q].push_back({ node, i, child });
+            }
+        }
+    }
+    return VX_SUCCESS;
+}
+
+static void agoGraphInstanceBind(AgoGraphInstance * instance, const std::vector<AgoData *>& refs)
+{
+    for (size_t q = 0; q < instance->slots.size(); q++) {
+        for (auto& slot : instance->slots[q]) {
+            slot.node->paramList[slot.index] = (slot.child < 0) ? refs[q] : refs[q]->children[slot.child];
+        }
+    }
+}
+
+static void agoGraphInstanceThread(AgoGraph * graph, AgoGraphInstance * instance, int index)
+{
+    AgoGraphPipeline * pipeline = graph->pipeline;
+    char threadName[64];
+    sprintf(threadName, "AGO graph instance %d", index);
+    agoTraceSetThreadName(threadName);
+    std::vector<AgoData *> boundRefs;
+    for (auto& queue : graph->paramQueues)
+        boundRefs.push_back(queue.data);
+    for (;;) {
+        AgoGraphFrame frame;
+        {
+            std::unique_lock<std::mutex> lock(pipeline->lock);
+            pipeline->cv.wait(lock, [pipeline, instance] { return pipeline->terminate || !instance->frames.empty(); });
+            if (instance->frames.empty())
+                break;
+            frame = std::move(instance->frames.front());
+            instance->frames.pop_front();
+        }
+
+        // execute the frame with the enqueued references
+        agoGraphInstanceBind(instance, frame.refs);
+        vx_status status = agoExecuteGraph(instance->graph);
+        vx_uint64 frameTime = instance->graph->perf.tmp;
+        agoGraphInstanceBind(instance, boundRefs);
+
+        // complete the frames in launch order
+        {
+            std::unique_lock<std::mutex> lock(pipeline->lock);
+            pipeline->cv.wait(lock, [pipeline, &frame] { return pipeline->completeCount == frame.seq; });
+            for (size_t q = 0; q < graph->paramQueues.size(); q++)
+                graph->paramQueues[q].done.push_back(frame.refs[q]);
+            if (status != VX_SUCCESS && pipeline->status == VX_SUCCESS)
+                pipeline->status = status;
+            vx_perf_t * perf = &pipeline->perf;
+            perf->tmp = frameTime;
+            perf->min = (perf->num == 0 || frameTime < perf->min) ? frameTime : perf->min;
+            perf->max = (perf->num == 0 || frameTime > perf->max) ? frameTime : perf->max;
+            perf->sum += frameTime;
+            perf->num++;
+            perf->avg = perf->sum / perf->num;
+            agoGraphPostEvents(graph, instance, status);
+            pipeline->completeCount++;
+        }
+        pipeline->cv.notify_all();
+    }
+}
+
+int agoGraphPipelineStart(AgoGraph * graph)
+{
+    AgoGraphPipeline * pipeline = graph->pipeline;
+    if (!pipeline) {
+        agoAddLogEntry(&graph->ref, VX_FAILURE, "ERROR: agoGraphPipelineStart: graph pipeline is not prepared\n");
+        return VX_FAILURE;
+    }
+    for (auto& instance : pipeline->instances) {
+        if (instance->graph != graph) {
+            vx_status status = vxVerifyGraph(instance->graph);
+            if (status != VX_SUCCESS) {
+                agoAddLogEntry(&graph->ref, status, "ERROR: agoGraphPipelineStart: verify of graph replica failed (%d:%s)\n", status, agoEnum2Name(status));
+                return status;
+            }
+        }
+        vx_status status = agoGraphInstanceFindSlots(graph, instance.get());
+        if (status != VX_SUCCESS)
+            return status;
+    }
+    for (auto& queue : graph->paramQueues) {
+        std::vector<AgoData *> refs;
+        refs.swap(queue.refs);
+        for (auto ref : refs) {
+            vx_status status = agoAddQueueReference(graph, queue, ref);
+            if (status != VX_SUCCESS)
+                return status;
+        }
+    }
+    for (size_t i = 0; i < pipeline->instances.size(); i++) {
+        pipeline->instances[i]->thread = std::thread(agoGraphInstanceThread, graph, pipeline->instances[i].get(), (int)i);
+    }
+    return VX_SUCCESS;
+}
+
+// launch frames while every queued graph parameter has a ready reference: caller must hold pipeline lock
+static vx_uint32 agoGraphPipelineLaunch(AgoGraph * graph)
+{
+    AgoGraphPipeline * pipeline = graph->pipeline;
+    vx_uint32 count = 0;
+    for (;;) {
+        for (auto& queue : graph->paramQueues) {
+            if (queue.ready.empty())
+                return count;
+        }
+        if (graph->paramQueues.empty() && count > 0)
+            return count;
+        AgoGraphFrame frame;
+        frame.seq = pipeline->launchCount++;
+        for (auto& queue : graph->paramQueues) {
+            frame.refs.push_back(queue.ready.front());
+            queue.ready.pop_front();
+        }
+        pipeline->instances[frame.seq % pipeline->instances.size()]->frames.push_back(std::move(frame));
+        count++;
+    }
+}
+
+static AgoGraphParameterQueue * agoGraphGetQueue(AgoGraph * graph, vx_uint32 index)
+{
+    for (auto& queue : graph->paramQueues) {
+        if (queue.index == index)
+            return &queue;
+    }
+    return nullptr;
+}
+
+int agoGraphParameterEnqueueReadyRef(AgoGraph * graph, vx_uint32 index, vx_reference * refs, vx_uint32 num_refs)
+{
+    AgoGraphParameterQueue * queue = agoGraphGetQueue(graph, index);
+    if (!queue || (num_refs > 0 && !refs))
+        return VX_ERROR_INVALID_PARAMETERS;
+    for (vx_uint32 i = 0; i < num_refs; i++) {
+        if (!agoIsValidReference(refs[i]))
+            return VX_ERROR_INVALID_REFERENCE;
+    }
+    AgoGraphPipeline * pipeline = graph->pipeline;
+    if (!pipeline || !graph->verified) {
+        agoAddLogEntry(&graph->ref, VX_FAILURE, "ERROR: vxGraphParameterEnqueueReadyRef: graph needs to be verified\n");
+        return VX_FAILURE;
+    }
+    vx_uint32 launched = 0;
+    {
+        std::lock_guard<std::mutex> lock(pipeline->lock);
+        for (vx_uint32 i = 0; i < num_refs; i++) {
+            vx_status status = agoAddQueueReference(graph, *queue, (AgoData *)refs[i]);
+            if (status != VX_SUCCESS)
+                return status;
+        }
+        for (vx_uint32 i = 0; i < num_refs; i++)
+            queue->ready.push_back((AgoData *)refs[i]);
+        if (graph->schedule_mode == VX_GRAPH_SCHEDULE_MODE_QUEUE_AUTO)
+            launched = agoGraphPipelineLaunch(graph);
+    }
+    if (launched > 0)
+        pipeline->cv.notify_all();
+    return VX_SUCCESS;
+}
+
+int agoGraphParameterDequeueDoneRef(AgoGraph * graph, vx_uint32 index, vx_reference * refs, vx_uint32 max_refs, vx_uint32 * num_refs)
+{
+    AgoGraphParameterQueue * queue = agoGraphGetQueue(graph, index);
+    if (!queue || !refs || max_refs < 1 || !num_refs)
+        return VX_ERROR_INVALID_PARAMETERS;
+    AgoGraphPipeline * pipeline = graph->pipeline;
+    if (!pipeline)
+        return VX_FAILURE;
+    std::unique_lock<std::mutex> lock(pipeline->lock);
+    pipeline->cv.wait(lock, [queue] { return !queue->done.empty(); });
+    vx_uint32 count = 0;
+    for (; count < max_refs && !queue->done.empty(); count++) {
+        refs[count] = &queue->done.front()->ref;
+        queue->done.pop_front();
+    }
+    *num_refs = count;
+    return VX_SUCCESS;
+}
+
+int agoGraphParameterCheckDoneRef(AgoGraph * graph, vx_uint32 index, vx_uint32 * num_refs)
+{
+    AgoGraphParameterQueue * queue = agoGraphGetQueue(graph, index);
+    if (!queue || !num_refs)
+        return VX_ERROR_INVALID_PARAMETERS;
+    *num_refs = 0;
+    AgoGraphPipeline * pipeline = graph->pipeline;
+    if (pipeline) {
+        std::lock_guard<std::mutex> lock(pipeline->lock);
+        *num_refs = (vx_uint32)queue->done.size();
+    }
+    return VX_SUCCESS;
+}
+
+int agoGraphPipelineSchedule(AgoGraph * graph)
+{
+    if (graph->schedule_mode != VX_GRAPH_SCHEDULE_MODE_QUEUE_MANUAL) {
+        agoAddLogEntry(&graph->ref, VX_ERROR_NOT_SUPPORTED, "ERROR: graph in VX_GRAPH_SCHEDULE_MODE_QUEUE_AUTO mode is scheduled by vxGraphParameterEnqueueReadyRef\n");
+        return VX_ERROR_NOT_SUPPORTED;
+    }
+    if (!graph->verified) {
+        vx_status status = vxVerifyGraph(graph);
+        if (status != VX_SUCCESS)
+            return status;
+    }
+    AgoGraphPipeline * pipeline = graph->pipeline;
+    vx_uint32 launched = 0;
+    {
+        std::lock_guard<std::mutex> lock(pipeline->lock);
+        launched = agoGraphPipelineLaunch(graph);
+    }
+    if (launched == 0) {
+        agoAddLogEntry(&graph->ref, VX_FAILURE, "ERROR: vxScheduleGraph: references need to be enqueued at all queued graph parameters\n");
+        return VX_FAILURE;
+    }
+    pipeline->cv.notify_all();
+    return VX_SUCCESS;
+}
+
+int agoGraphPipelineWait(AgoGraph * graph)
+{
+    AgoGraphPipeline * pipeline = graph->pipeline;
+    if (!pipeline)
+        return VX_FAILURE;
+    std::unique_lock<std::mutex> lock(pipeline->lock);
+    pipeline->cv.wait(lock, [pipeline] { return pipeline->completeCount == pipeline->launchCount; });
+    vx_status status = pipeline->status;
+    pipeline->status = VX_SUCCESS;
+    graph->status = status;
+    return status;
+}
+
+int agoRegisterEvent(AgoReference * ref, vx_enum type, vx_uint32 param, vx_uint32 app_value)
+{
+    AgoGraph * graph = nullptr;
+    if (ref->type == VX_TYPE_GRAPH) {
+        graph = (AgoGraph *)ref;
+        if (type == VX_EVENT_GRAPH_PARAMETER_CONSUMED) {
+            if (param >= graph->parameters.size())
+                return VX_ERROR_INVALID_PARAMETERS;
+        }
+        else if (type != VX_EVENT_GRAPH_COMPLETED)
+            return VX_ERROR_NOT_SUPPORTED;
+    }
+    else if (ref->type == VX_TYPE_NODE) {
+        if (type != VX_EVENT_NODE_COMPLETED && type != VX_EVENT_NODE_ERROR)
+            return VX_ERROR_NOT_SUPPORTED;
+        graph = (AgoGraph *)ref->scope;
+    }
+    else if (ref->type == VX_TYPE_PARAMETER && ((AgoParameter *)ref)->scope && ((AgoParameter *)ref)->scope->type == VX_TYPE_NODE) {
+        // a graph parameter is the node parameter that was added to the graph
+        if (type != VX_EVENT_GRAPH_PARAMETER_CONSUMED)
+            return VX_ERROR_NOT_SUPPORTED;
+        graph = (AgoGraph *)((AgoParameter *)ref)->scope->scope;
+        auto it = std::find(graph->parameters.begin(), graph->parameters.end(), (vx_parameter)ref);
+        if (it == graph->parameters.end())
+            return VX_ERROR_NOT_SUPPORTED;
+        param = (vx_uint32)(it - graph->parameters.begin());
+        ref = &graph->ref;
+    }
+    else
+        return VX_ERROR_NOT_SUPPORTED;
+    if (graph->verified) {
+        agoAddLogEntry(&graph->ref, VX_FAILURE, "ERROR: vxRegisterEvent: events need to be registered before vxVerifyGraph\n");
+        return VX_FAILURE;
+    }
+    graph->eventList.push_back({ ref, type, param, app_value });
+    return VX_SUCCESS;
+}
+
+void agoGraphPostEvents(AgoGraph * graph, AgoGraphInstance * instance, vx_status status)
+{
+    AgoGraph * igraph = instance ? instance->graph : graph;
+    for (auto& reg : graph->eventList) {
+        vx_event_info_t info;
+        memset(&info, 0, sizeof(info));
+        if (reg.type == VX_EVENT_GRAPH_PARAMETER_CONSUMED) {
+            info.graph_parameter_consumed.graph = graph;
+            info.graph_parameter_consumed.graph_parameter_index = reg.param;
+            agoPostEvent(graph->ref.context, reg.type, reg.app_value, info);
+        }
+        else if (reg.type == VX_EVENT_GRAPH_COMPLETED) {
+            info.graph_completed.graph = graph;
+            agoPostEvent(graph->ref.context, reg.type, reg.app_value, info);
+        }
+        else {
+            // the node may have been removed or replaced by the graph optimizer
+            AgoNode * node = (AgoNode *)reg.ref;
+            AgoNode * inode = node;
+            if (igraph != graph) {
+                auto it = instance->nodeMap.find(node);
+                inode = (it != instance->nodeMap.end()) ? it->second : nullptr;
+            }
+            vx_status nodeStatus = VX_SUCCESS;
+            for (AgoNode * cur = igraph->nodeList.head; cur && inode; cur = cur->next) {
+                if (cur == inode) {
+                    nodeStatus = inode->status;
+                    break;
+                }
+            }
+            if (reg.type == VX_EVENT_NODE_COMPLETED && status == VX_SUCCESS) {
+                info.node_completed.graph = graph;
+                info.node_completed.node = node;
+                agoPostEvent(graph->ref.context, reg.type, reg.app_value, info);
+            }
+            else if (reg.type == VX_EVENT_NODE_ERROR && status != VX_SUCCESS && nodeStatus != VX_SUCCESS) {
+                info.node_error.graph = graph;
+                info.node_error.node = node;
+                info.node_error.status = nodeStatus;
+                agoPostEvent(graph->ref.context, reg.type, reg.app_value, info);
+            }
+        }
+    }
+}
+
+void agoPostEvent(AgoContext * acontext, vx_enum type, vx_uint32 app_value, const vx_event_info_t& info)
+{
+    vx_event_t event;
+    event.type = type;
+    event.timestamp = (vx_uint64)std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    event.app_value = app_value;
+    event.event_info = info;
+    {
+        std::lock_guard<std::mutex> lock(acontext->event_lock);
+        if (!acontext->event_enabled)
+            return;
+        acontext->event_queue.push_back(event);
+    }
+    acontext->event_cv.notify_all();
+}
+
+int agoWaitEvent(AgoContext * acontext, vx_event_t * event, bool do_not_block)
+{
+    std::unique_lock<std::mutex> lock(acontext->event_lock);
+    if (do_not_block) {
+        if (acontext->event_queue.empty())
+            return VX_FAILURE;
+    }
+    else {
+        acontext->event_cv.wait(lock, [acontext] { return !acontext->event_queue.empty(); });
+    }
+    *event = acontext->event_queue.front();
+    acontext->event_queue.pop_front();
+    return VX_SUCCESS;
+}
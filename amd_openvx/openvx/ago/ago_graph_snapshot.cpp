@@ -0,0 +1,672 @@
+/*
+Copyright (c) 2015 - 2022 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+#include "ago_internal.h"
+#include <set>
+
+// Verified graph snapshots (vx_khr_ix):
+// - graphs are exported as they are after DRAMA optimization: the nodes in their sorted order with the
+//   selected kernels, node attributes and hierarchical levels, the data used by the nodes, graph parameters
+//   and auto-aged delays
+// - imported graphs carry AGO_GRAPH_OPTIMIZER_FLAG_PREOPTIMIZED, so their verification skips the
+//   divide, remove, analyze and merge passes and only validates the nodes and allocates the buffers
+// - the data listed in refs[] are exported as requested by uses[]; hidden data become graph data and
+//   keep their values unless a node of the graph writes them
+// - the payload is only valid for the build that exported it, which is checked with the header
+
+#define AGO_SNAPSHOT_MAGIC              0x50534741 // "AGSP"
+#define AGO_SNAPSHOT_VERSION            1
+#define AGO_SNAPSHOT_LISTED_REF         0x80000000 // data reference is refs[code & ~AGO_SNAPSHOT_LISTED_REF]
+#define AGO_SNAPSHOT_NULL_REF           0xffffffff
+
+struct AgoSnapshotHeader {
+    vx_uint32 magic;
+    vx_uint32 version;
+    vx_uint64 build_hash;
+    vx_uint64 numrefs;
+    vx_uint64 payload_size;
+    vx_uint64 payload_hash;
+};
+
+class AgoSnapshotWriter {
+public:
+    void put(const void * ptr, vx_size size) { buf.insert(buf.end(), (const vx_uint8 *)ptr, (const vx_uint8 *)ptr + size); }
+    void put32(vx_uint32 value) { put(&value, sizeof(value)); }
+    void put64(vx_uint64 value) { put(&value, sizeof(value)); }
+    void putString(const std::string& str) { put32((vx_uint32)str.length()); put(str.c_str(), str.length()); }
+    std::vector<vx_uint8> buf;
+};
+
+class AgoSnapshotReader {
+public:
+    AgoSnapshotReader(const vx_uint8 * ptr_, vx_size size_) : ptr{ ptr_ }, size{ size_ }, pos{ 0 }, failed{ false } {}
+    bool get(void * dst, vx_size count) {
+        if (failed || count > size - pos) {
+            failed = true;
+            return false;
+        }
+        memcpy(dst, ptr + pos, count);
+        pos += count;
+        return true;
+    }
+    vx_uint32 get32() { vx_uint32 value = 0; get(&value, sizeof(value)); return value; }
+    vx_uint64 get64() { vx_uint64 value = 0; get(&value, sizeof(value)); return value; }
+    std::string getString() {
+        vx_uint32 len = get32();
+        if (failed || len > size - pos) {
+            failed = true;
+            return std::string();
+        }
+        std::string str((const char *)ptr + pos, len);
+        pos += len;
+        return str;
+    }
+    const vx_uint8 * ptr;
+    vx_size size;
+    vx_size pos;
+    bool failed;
+};
+
+static vx_uint64 agoSnapshotHash(const vx_uint8 * ptr, vx_size size)
+{
+    // 64-bit FNV-1a
+    vx_uint64 hash = 0xcbf29ce484222325ull;
+    for (vx_size i = 0; i < size; i++) {
+        hash ^= ptr[i];
+        hash *= 0x100000001b3ull;
+    }
+    return hash;
+}
+
+static vx_uint64 agoSnapshotBuildHash()
+{
+    // the payload has kernel names, data descriptions and raw structures, so it only fits the same version and backend
+    char build[256];
+    sprintf(build, "AGO %s snapshot#%d ptr%d %s", AGO_VERSION, AGO_SNAPSHOT_VERSION, (int)sizeof(void *),
+#if ENABLE_OPENCL
+        "OpenCL"
+#elif ENABLE_HIP
+        "HIP"
+#else
+        "CPU"
+#endif
+        );
+    return agoSnapshotHash((const vx_uint8 *)build, strlen(build));
+}
+
+// returns the root of data and the child indices from the root down to data
+static AgoData * agoSnapshotGetRoot(AgoData * data, std::vector<vx_uint32>& path)
+{
+    path.clear();
+    while (data->parent) {
+        AgoData * parent = data->parent;
+        vx_uint32 index = 0;
+        if (parent->ref.type == VX_TYPE_DELAY) {
+            // delay slots are rotated by vxAgeDelay: use the slot the data was created for
+            index = (vx_uint32)data->siblingIndex;
+        }
+        else {
+            while (index < parent->numChildren && parent->children[index] != data)
+                index++;
+        }
+        path.insert(path.begin(), index);
+        data = parent;
+    }
+    return data;
+}
+
+static AgoData * agoSnapshotGetChild(AgoData * data, vx_uint32 index)
+{
+    if (data->ref.type == VX_TYPE_DELAY) {
+        for (vx_uint32 i = 0; i < data->numChildren; i++) {
+            if (data->children[i] && data->children[i]->siblingIndex == (vx_int32)index)
+                return data->children[i];
+        }
+        return nullptr;
+    }
+    return (index < data->numChildren) ? data->children[index] : nullptr;
+}
+
+static bool agoSnapshotHasROI(AgoData * data)
+{
+    if (data->ref.type == VX_TYPE_IMAGE && data->u.img.isROI)
+        return true;
+    for (vx_uint32 i = 0; i < data->numChildren; i++) {
+        if (data->children[i] && agoSnapshotHasROI(data->children[i]))
+            return true;
+    }
+    return false;
+}
+
+static void agoSnapshotAddData(AgoDataList * dataList, AgoData * data)
+{
+    agoAddData(dataList, data);
+    for (vx_uint32 i = 0; i < data->numChildren; i++) {
+        if (data->children[i])
+            agoSnapshotAddData(dataList, data->children[i]);
+    }
+}
+
+// description used to check an application created object: images only need to match in format and size,
+// so that ROI, uniform and handle images can be supplied for each other; scalars only need to match in type
+static void agoSnapshotGetMetaDescription(AgoContext * acontext, char * desc, AgoData * data)
+{
+    if (data->ref.type == VX_TYPE_IMAGE)
+        sprintf(desc, "image:%4.4s,%d,%d", FORMAT_STR(data->u.img.format), data->u.img.width, data->u.img.height);
+    else if (data->ref.type == VX_TYPE_SCALAR)
+        sprintf(desc, "scalar:0x%08x", data->u.scalar.type);
+    else
+        agoGetDescriptionFromData(acontext, desc, data);
+}
+
+static int agoSnapshotWriteValues(AgoSnapshotWriter& out, AgoData * data)
+{
+    if (data->ref.type == VX_TYPE_SCALAR || (data->ref.type == VX_TYPE_IMAGE && data->u.img.isUniform)) {
+        // values are part of the description
+    }
+    else if (data->ref.type == VX_TYPE_DELAY || data->ref.type == VX_TYPE_PYRAMID || data->ref.type == VX_TYPE_OBJECT_ARRAY || data->children) {
+        for (vx_uint32 i = 0; i < data->numChildren; i++) {
+            if (data->children[i] && agoSnapshotWriteValues(out, data->children[i]))
+                return -1;
+        }
+    }
+    else if (data->ref.type == VX_TYPE_THRESHOLD) {
+        out.put(&data->u.thr, sizeof(data->u.thr));
+    }
+    else {
+        if (data->buffer_sync_flags & AGO_BUFFER_SYNC_FLAG_DIRTY_BY_NODE_CL) {
+            vx_char name[256]; agoGetDataName(name, data);
+            agoAddLogEntry(&data->ref, VX_FAILURE, "ERROR: vxExportObjectsToMemory: values of %s are only available on the GPU\n", name);
+            return -1;
+        }
+        vx_size size = data->buffer ? data->size : 0;
+        if (data->ref.type == VX_TYPE_ARRAY) {
+            size = data->buffer ? data->u.arr.numitems * data->u.arr.itemsize : 0;
+            out.put64(data->buffer ? data->u.arr.numitems : 0);
+        }
+        out.put64(size);
+        if (size > 0)
+            out.put(data->buffer, size);
+    }
+    return 0;
+}
+
+static int agoSnapshotReadValues(AgoSnapshotReader& in, AgoData * data)
+{
+    if (data->ref.type == VX_TYPE_SCALAR || (data->ref.type == VX_TYPE_IMAGE && data->u.img.isUniform)) {
+        // values are part of the description
+    }
+    else if (data->ref.type == VX_TYPE_DELAY || data->ref.type == VX_TYPE_PYRAMID || data->ref.type == VX_TYPE_OBJECT_ARRAY || data->children) {
+        for (vx_uint32 i = 0; i < data->numChildren; i++) {
+            if (data->children[i] && agoSnapshotReadValues(in, data->children[i]))
+                return -1;
+        }
+    }
+    else if (data->ref.type == VX_TYPE_THRESHOLD) {
+        if (!in.get(&data->u.thr, sizeof(data->u.thr)))
+            return -1;
+        data->isInitialized = vx_true_e;
+    }
+    else {
+        vx_uint64 numitems = (data->ref.type == VX_TYPE_ARRAY) ? in.get64() : 0;
+        vx_uint64 size = in.get64();
+        if (in.failed)
+            return -1;
+        if (size > 0) {
+            bool valid = data->buffer && ((data->ref.type == VX_TYPE_ARRAY) ?
+                (numitems <= data->u.arr.capacity && size == numitems * data->u.arr.itemsize) : (size == data->size));
+            if (!valid || !in.get(data->buffer, (vx_size)size))
+                return -1;
+            if (data->ref.type == VX_TYPE_ARRAY)
+                data->u.arr.numitems = (vx_size)numitems;
+            data->isInitialized = vx_true_e;
+            data->buffer_sync_flags &= ~AGO_BUFFER_SYNC_FLAG_DIRTY_MASK;
+            data->buffer_sync_flags |= AGO_BUFFER_SYNC_FLAG_DIRTY_BY_COMMIT;
+        }
+    }
+    return 0;
+}
+
+static void agoSnapshotPutRef(AgoSnapshotWriter& out, const std::map<AgoData *, vx_uint32>& listed, const std::map<AgoData *, vx_uint32>& local, AgoData * data)
+{
+    if (!data) {
+        out.put32(AGO_SNAPSHOT_NULL_REF);
+        return;
+    }
+    std::vector<vx_uint32> path;
+    AgoData * root = agoSnapshotGetRoot(data, path);
+    auto it = listed.find(root);
+    out.put32((it != listed.end()) ? (it->second | AGO_SNAPSHOT_LISTED_REF) : local.at(root));
+    out.put32((vx_uint32)path.size());
+    for (auto index : path)
+        out.put32(index);
+}
+
+static int agoSnapshotGetRef(AgoSnapshotReader& in, vx_size numrefs, vx_reference * refs, const std::vector<AgoData *>& local, AgoData *& data)
+{
+    data = nullptr;
+    vx_uint32 code = in.get32();
+    if (in.failed)
+        return -1;
+    if (code == AGO_SNAPSHOT_NULL_REF)
+        return 0;
+    if (code & AGO_SNAPSHOT_LISTED_REF) {
+        vx_size index = code & ~AGO_SNAPSHOT_LISTED_REF;
+        if (index < numrefs && refs[index] && refs[index]->type != VX_TYPE_GRAPH)
+            data = (AgoData *)refs[index];
+    }
+    else if (code < local.size()) {
+        data = local[code];
+    }
+    vx_uint32 depth = in.get32();
+    for (vx_uint32 i = 0; i < depth && data; i++) {
+        vx_uint32 index = in.get32();
+        data = in.failed ? nullptr : agoSnapshotGetChild(data, index);
+    }
+    return data ? 0 : -1;
+}
+
+static int agoSnapshotExportGraph(AgoSnapshotWriter& out, AgoGraph * graph, const std::map<AgoData *, vx_uint32>& listed)
+{
+    AgoContext * context = graph->ref.context;
+
+    // collect the data used by the nodes that are not listed: virtual and optimizer data of the graph and hidden objects
+    std::vector<AgoData *> localList;
+    std::map<AgoData *, vx_uint32> local;
+    std::set<AgoData *> written;
+    std::vector<vx_uint32> path;
+    vx_uint32 nodeCount = 0;
+    for (AgoNode * node = graph->nodeList.head; node; node = node->next, nodeCount++) {
+        for (vx_uint32 i = 0; i < node->paramCount; i++) {
+            AgoData * data = node->paramListForAgeDelay[i];
+            if (!data)
+                continue;
+            AgoData * root = agoSnapshotGetRoot(data, path);
+            if (listed.find(root) == listed.end() && local.find(root) == local.end()) {
+                if (agoSnapshotHasROI(root)) {
+                    agoAddLogEntry(&graph->ref, VX_FAILURE, "ERROR: vxExportObjectsToMemory: image ROI %s must be listed for export\n", root->name.c_str());
+                    return -1;
+                }
+                local[root] = (vx_uint32)localList.size();
+                localList.push_back(root);
+            }
+            vx_uint32 argConfig = node->akernel->argConfig[i];
+            if ((argConfig & AGO_KERNEL_ARG_OUTPUT_FLAG) && !(argConfig & AGO_KERNEL_ARG_INPUT_FLAG))
+                written.insert(root);
+        }
+    }
+
+    // graph parameters shall be listed for export
+    std::vector<AgoData *> paramData;
+    for (size_t i = 0; i < graph->parameters.size(); i++) {
+        AgoParameter * parameter = graph->parameters[i];
+        AgoData * data = parameter ? ((AgoNode *)parameter->scope)->paramList[parameter->index] : nullptr;
+        if (data && listed.find(agoSnapshotGetRoot(data, path)) == listed.end()) {
+            agoAddLogEntry(&graph->ref, VX_FAILURE, "ERROR: vxExportObjectsToMemory: graph parameter #%d is not listed for export\n", (int)i);
+            return -1;
+        }
+        paramData.push_back(data);
+    }
+
+    // graph attributes
+    out.putString(graph->name);
+    out.put32(graph->optimizer_flags);
+    out.put(&graph->attr_affinity, sizeof(graph->attr_affinity));
+
+    // data of the graph, with values unless the graph writes them
+    out.put32((vx_uint32)localList.size());
+    for (auto data : localList) {
+        char desc[2048];
+        agoGetDescriptionFromData(context, desc, data);
+        bool values = !data->isVirtual && written.find(data) == written.end();
+        out.putString(data->name);
+        out.putString(desc);
+        out.put32(values ? 1 : 0);
+        if (values && agoSnapshotWriteValues(out, data))
+            return -1;
+    }
+
+    // optimized nodes in execution order
+    out.put32(nodeCount);
+    for (AgoNode * node = graph->nodeList.head; node; node = node->next) {
+        out.putString(node->akernel->name);
+        out.put(&node->attr_border_mode, sizeof(node->attr_border_mode));
+        out.put(&node->attr_affinity, sizeof(node->attr_affinity));
+        out.put32(node->hierarchical_level);
+        out.put32(node->paramCount);
+        for (vx_uint32 i = 0; i < node->paramCount; i++)
+            agoSnapshotPutRef(out, listed, local, node->paramListForAgeDelay[i]);
+    }
+
+    // graph parameters are bound to an optimized node that uses the same data on import
+    out.put32((vx_uint32)paramData.size());
+    for (size_t i = 0; i < paramData.size(); i++) {
+        agoSnapshotPutRef(out, listed, local, paramData[i]);
+        out.put32(graph->parameters[i] ? (vx_uint32)graph->parameters[i]->direction : 0);
+    }
+
+    // auto-aged delays that are still used after optimization
+    std::vector<AgoData *> delays;
+    for (auto delay : graph->autoAgeDelayList) {
+        if (listed.find(delay) != listed.end() || local.find(delay) != local.end())
+            delays.push_back(delay);
+    }
+    out.put32((vx_uint32)delays.size());
+    for (auto delay : delays)
+        agoSnapshotPutRef(out, listed, local, delay);
+
+    return 0;
+}
+
+static AgoGraph * agoSnapshotImportGraph(AgoContext * context, AgoSnapshotReader& in, vx_size numrefs, vx_reference * refs)
+{
+    AgoGraph * graph = agoCreateGraph(context);
+    if (!graph)
+        return nullptr;
+    int status = 0;
+
+    // graph attributes
+    graph->name = in.getString();
+    graph->optimizer_flags = in.get32() | AGO_GRAPH_OPTIMIZER_FLAG_PREOPTIMIZED;
+    in.get(&graph->attr_affinity, sizeof(graph->attr_affinity));
+
+    // data of the graph
+    std::vector<AgoData *> local;
+    vx_uint32 localCount = in.get32();
+    for (vx_uint32 i = 0; i < localCount && !in.failed && !status; i++) {
+        std::string name = in.getString();
+        std::string desc = in.getString();
+        vx_uint32 values = in.get32();
+        if (in.failed)
+            break;
+        AgoData * data = agoCreateDataFromDescription(context, graph, desc.c_str(), false);
+        if (!data) {
+            status = -1;
+            break;
+        }
+        data->name = name;
+        agoSnapshotAddData(&graph->dataList, data);
+        local.push_back(data);
+        if (values && (agoAllocData(data) || agoSnapshotReadValues(in, data))) {
+            agoAddLogEntry(&graph->ref, VX_FAILURE, "ERROR: vxImportObjectsFromMemory: invalid values for %s\n", name.c_str());
+            status = -1;
+        }
+    }
+
+    // optimized nodes in execution order
+    vx_uint32 nodeCount = status ? 0 : in.get32();
+    for (vx_uint32 n = 0; n < nodeCount && !in.failed && !status; n++) {
+        std::string kernelName = in.getString();
+        AgoKernel * kernel = in.failed ? nullptr : agoFindKernelByName(context, kernelName.c_str());
+        if (!kernel) {
+            agoAddLogEntry(&graph->ref, VX_FAILURE, "ERROR: vxImportObjectsFromMemory: kernel %s is not available\n", kernelName.c_str());
+            status = -1;
+            break;
+        }
+        AgoNode * node = agoCreateNode(graph, kernel);
+        in.get(&node->attr_border_mode, sizeof(node->attr_border_mode));
+        in.get(&node->attr_affinity, sizeof(node->attr_affinity));
+        node->hierarchical_level = in.get32();
+        vx_uint32 paramCount = in.get32();
+        if (paramCount != node->paramCount) {
+            status = -1;
+            break;
+        }
+        for (vx_uint32 i = 0; i < paramCount && !status; i++)
+            status = agoSnapshotGetRef(in, numrefs, refs, local, node->paramList[i]);
+    }
+
+    // graph parameters
+    vx_uint32 paramCount = status ? 0 : in.get32();
+    for (vx_uint32 p = 0; p < paramCount && !in.failed && !status; p++) {
+        AgoData * data = nullptr;
+        status = agoSnapshotGetRef(in, numrefs, refs, local, data);
+        vx_enum direction = (vx_enum)in.get32();
+        AgoParameter * parameter = nullptr;
+        for (AgoNode * node = graph->nodeList.head; node && data; node = node->next) {
+            for (vx_uint32 i = 0; i < node->paramCount; i++) {
+                if (node->paramList[i] == data && (!parameter || (node->parameters[i].direction == direction && parameter->direction != direction)))
+                    parameter = &node->parameters[i];
+            }
+        }
+        if (data && !parameter) {
+            agoAddLogEntry(&graph->ref, VX_FAILURE, "ERROR: vxImportObjectsFromMemory: graph parameter #%d is not used by any node\n", p);
+            status = -1;
+        }
+        graph->parameters.push_back(parameter);
+    }
+
+    // auto-aged delays
+    vx_uint32 delayCount = status ? 0 : in.get32();
+    for (vx_uint32 d = 0; d < delayCount && !in.failed && !status; d++) {
+        AgoData * delay = nullptr;
+        status = agoSnapshotGetRef(in, numrefs, refs, local, delay);
+        if (!status && delay->ref.type == VX_TYPE_DELAY) {
+            delay->ref.internal_count++;
+            graph->autoAgeDelayList.push_back(delay);
+        }
+    }
+
+    if (status || in.failed) {
+        agoAddLogEntry(&context->ref, VX_FAILURE, "ERROR: vxImportObjectsFromMemory: invalid graph %s\n", graph->name.c_str());
+        agoReleaseGraph(graph);
+        return nullptr;
+    }
+    return graph;
+}
+
+static bool agoSnapshotHasDuplicateNames(AgoContext * context, vx_size numrefs, const vx_reference * refs)
+{
+    std::set<std::string> names;
+    for (vx_size i = 0; i < numrefs; i++) {
+        const std::string& name = (refs[i]->type == VX_TYPE_GRAPH) ? ((AgoGraph *)refs[i])->name : ((AgoData *)refs[i])->name;
+        if (name.length() > 0 && !names.insert(name).second) {
+            agoAddLogEntry(&context->ref, VX_FAILURE, "ERROR: more than one reference is named %s\n", name.c_str());
+            return true;
+        }
+    }
+    return false;
+}
+
+int agoExportObjects(AgoContext * context, vx_size numrefs, const vx_reference * refs, const vx_enum * uses, const vx_uint8 ** ptr, vx_size * length)
+{
+    // check the list
+    std::map<AgoData *, vx_uint32> listed;
+    for (vx_size i = 0; i < numrefs; i++) {
+        if (refs[i]->type == VX_TYPE_GRAPH)
+            continue;
+        AgoData * data = (AgoData *)refs[i];
+        bool isData = (refs[i]->type >= VX_TYPE_DELAY && refs[i]->type <= VX_TYPE_REMAP) ||
+                      refs[i]->type == VX_TYPE_OBJECT_ARRAY || refs[i]->type == VX_TYPE_TENSOR;
+        if (!isData || data->isVirtual || data->parent) {
+            agoAddLogEntry(&context->ref, VX_FAILURE, "ERROR: vxExportObjectsToMemory: refs[%d] is not a graph or a non-virtual data object\n", (int)i);
+            return -1;
+        }
+        if (uses[i] != VX_IX_USE_APPLICATION_CREATE && uses[i] != VX_IX_USE_EXPORT_VALUES && uses[i] != VX_IX_USE_NO_EXPORT_VALUES) {
+            agoAddLogEntry(&context->ref, VX_FAILURE, "ERROR: vxExportObjectsToMemory: invalid uses[%d] = 0x%08x\n", (int)i, uses[i]);
+            return -1;
+        }
+        if (uses[i] != VX_IX_USE_APPLICATION_CREATE && (agoSnapshotHasROI(data) || data->import_type != VX_MEMORY_TYPE_NONE)) {
+            agoAddLogEntry(&context->ref, VX_FAILURE, "ERROR: vxExportObjectsToMemory: refs[%d] needs VX_IX_USE_APPLICATION_CREATE\n", (int)i);
+            return -1;
+        }
+        listed[data] = (vx_uint32)i;
+    }
+    if (agoSnapshotHasDuplicateNames(context, numrefs, refs))
+        return -1;
+
+    // listed data and then the graphs, in the order of refs[]
+    AgoSnapshotWriter out;
+    for (vx_size i = 0; i < numrefs; i++) {
+        out.put32((vx_uint32)refs[i]->type);
+        out.put32((vx_uint32)uses[i]);
+        if (refs[i]->type == VX_TYPE_GRAPH)
+            continue;
+        AgoData * data = (AgoData *)refs[i];
+        char desc[2048];
+        if (uses[i] == VX_IX_USE_APPLICATION_CREATE)
+            agoSnapshotGetMetaDescription(context, desc, data);
+        else
+            agoGetDescriptionFromData(context, desc, data);
+        out.putString(data->name);
+        out.putString(desc);
+        if (uses[i] == VX_IX_USE_EXPORT_VALUES && agoSnapshotWriteValues(out, data))
+            return -1;
+    }
+    for (vx_size i = 0; i < numrefs; i++) {
+        if (refs[i]->type == VX_TYPE_GRAPH) {
+            if (agoSnapshotExportGraph(out, (AgoGraph *)refs[i], listed))
+                return -1;
+        }
+    }
+
+    // header and payload
+    AgoSnapshotHeader header = { 0 };
+    header.magic = AGO_SNAPSHOT_MAGIC;
+    header.version = AGO_SNAPSHOT_VERSION;
+    header.build_hash = agoSnapshotBuildHash();
+    header.numrefs = numrefs;
+    header.payload_size = out.buf.size();
+    header.payload_hash = agoSnapshotHash(out.buf.data(), out.buf.size());
+    vx_uint8 * blob = new vx_uint8[sizeof(header) + out.buf.size()];
+    memcpy(blob, &header, sizeof(header));
+    if (out.buf.size() > 0)
+        memcpy(blob + sizeof(header), out.buf.data(), out.buf.size());
+    context->exported_memory_list.push_back(blob);
+    *ptr = blob;
+    *length = sizeof(header) + out.buf.size();
+    return 0;
+}
+
+int agoReleaseExportedMemory(AgoContext * context, const vx_uint8 * ptr)
+{
+    for (auto it = context->exported_memory_list.begin(); it != context->exported_memory_list.end(); it++) {
+        if (*it == ptr) {
+            delete[] *it;
+            context->exported_memory_list.erase(it);
+            return 0;
+        }
+    }
+    return -1;
+}
+
+int agoImportObjects(AgoContext * context, vx_size numrefs, vx_reference * refs, const vx_enum * uses, const vx_uint8 * ptr, vx_size length)
+{
+    AgoSnapshotHeader header;
+    if (length < sizeof(header)) {
+        agoAddLogEntry(&context->ref, VX_FAILURE, "ERROR: vxImportObjectsFromMemory: invalid length\n");
+        return -1;
+    }
+    memcpy(&header, ptr, sizeof(header));
+    if (header.magic != AGO_SNAPSHOT_MAGIC || header.version != AGO_SNAPSHOT_VERSION || header.build_hash != agoSnapshotBuildHash()) {
+        agoAddLogEntry(&context->ref, VX_FAILURE, "ERROR: vxImportObjectsFromMemory: the export is not from this version of the library\n");
+        return -1;
+    }
+    if (header.numrefs != numrefs || header.payload_size != length - sizeof(header) ||
+        header.payload_hash != agoSnapshotHash(ptr + sizeof(header), (vx_size)header.payload_size))
+    {
+        agoAddLogEntry(&context->ref, VX_FAILURE, "ERROR: vxImportObjectsFromMemory: numrefs mismatch or corrupted export\n");
+        return -1;
+    }
+    AgoSnapshotReader in(ptr + sizeof(header), (vx_size)header.payload_size);
+
+    // objects created by the import are released on failure
+    std::vector<bool> created(numrefs, false);
+    int status = 0;
+    for (vx_size i = 0; i < numrefs && !status; i++) {
+        vx_enum type = (vx_enum)in.get32();
+        vx_enum use = (vx_enum)in.get32();
+        if (in.failed || use != uses[i]) {
+            agoAddLogEntry(&context->ref, VX_FAILURE, "ERROR: vxImportObjectsFromMemory: uses[%d] doesn't match the export\n", (int)i);
+            status = -1;
+            break;
+        }
+        if (type == VX_TYPE_GRAPH) {
+            refs[i] = nullptr;
+            continue;
+        }
+        std::string name = in.getString();
+        std::string desc = in.getString();
+        if (in.failed) {
+            status = -1;
+            break;
+        }
+        if (use == VX_IX_USE_APPLICATION_CREATE) {
+            char meta[2048];
+            if (!agoIsValidReference(refs[i]) || refs[i]->type != type || ((AgoData *)refs[i])->isVirtual) {
+                status = -1;
+            }
+            else {
+                agoSnapshotGetMetaDescription(context, meta, (AgoData *)refs[i]);
+                status = strcmp(meta, desc.c_str()) ? -1 : 0;
+            }
+            if (status)
+                agoAddLogEntry(&context->ref, VX_FAILURE, "ERROR: vxImportObjectsFromMemory: refs[%d] doesn't match %s\n", (int)i, desc.c_str());
+        }
+        else {
+            AgoData * data = agoCreateDataFromDescription(context, nullptr, desc.c_str(), true);
+            refs[i] = data ? &data->ref : nullptr;
+            if (!data) {
+                status = -1;
+                break;
+            }
+            data->name = name;
+            agoSnapshotAddData(&context->dataList, data);
+            created[i] = true;
+            if (use == VX_IX_USE_EXPORT_VALUES && (agoAllocData(data) || agoSnapshotReadValues(in, data))) {
+                agoAddLogEntry(&context->ref, VX_FAILURE, "ERROR: vxImportObjectsFromMemory: invalid values for %s\n", name.c_str());
+                status = -1;
+            }
+        }
+    }
+    for (vx_size i = 0; i < numrefs && !status; i++) {
+        if (!refs[i]) {
+            AgoGraph * graph = agoSnapshotImportGraph(context, in, numrefs, refs);
+            if (!graph) {
+                status = -1;
+                break;
+            }
+            refs[i] = &graph->ref;
+            created[i] = true;
+        }
+    }
+    if (!status && (in.failed || in.pos != in.size)) {
+        agoAddLogEntry(&context->ref, VX_FAILURE, "ERROR: vxImportObjectsFromMemory: corrupted export\n");
+        status = -1;
+    }
+    if (!status && agoSnapshotHasDuplicateNames(context, numrefs, refs))
+        status = -1;
+
+    if (status) {
+        for (vx_size i = 0; i < numrefs; i++) {
+            if (created[i]) {
+                if (refs[i]->type == VX_TYPE_GRAPH)
+                    agoReleaseGraph((AgoGraph *)refs[i]);
+                else
+                    agoReleaseData((AgoData *)refs[i], true);
+                refs[i] = nullptr;
+            }
+        }
+    }
+    return status;
+}
@@ -232,3 +232,34 @@ int HafCpu_Convolve_S16_U8_MxN
 	return AGO_ERROR_HAFCPU_NOT_IMPLEMENTED;
 }
 
+
+void HafCpu_SelectDispatch(AgoHafCpuDispatch * dispatch, vx_enum isa)
+{
+#define HAFCPU_SET_DISPATCH(suffix) \
+	dispatch->Add_U8_U8U8_Wrap = HafCpu_Add_U8_U8U8_Wrap##suffix; \
+	dispatch->Add_U8_U8U8_Sat = HafCpu_Add_U8_U8U8_Sat##suffix; \
+	dispatch->Sub_U8_U8U8_Wrap = HafCpu_Sub_U8_U8U8_Wrap##suffix; \
+	dispatch->Sub_U8_U8U8_Sat = HafCpu_Sub_U8_U8U8_Sat##suffix; \
+	dispatch->AbsDiff_U8_U8U8 = HafCpu_AbsDiff_U8_U8U8##suffix; \
+	dispatch->Box_U8_U8_3x3 = HafCpu_Box_U8_U8_3x3##suffix; \
+	dispatch->Gaussian_U8_U8_3x3 = HafCpu_Gaussian_U8_U8_3x3##suffix; \
+	dispatch->Sobel_S16S16_U8_3x3_GXY = HafCpu_Sobel_S16S16_U8_3x3_GXY##suffix;
+	if (isa == VX_AMD_CPU_ISA_AVX512) {
+		HAFCPU_SET_DISPATCH(_AVX512)
+	}
+	else if (isa == VX_AMD_CPU_ISA_AVX2) {
+		HAFCPU_SET_DISPATCH(_AVX2)
+	}
+	else {
+		HAFCPU_SET_DISPATCH()
+	}
+	if (isa >= VX_AMD_CPU_ISA_AVX2) {
+		dispatch->ColorConvert_RGB_RGBX = HafCpu_ColorConvert_RGB_RGBX_AVX2;
+		dispatch->ColorConvert_RGBX_RGB = HafCpu_ColorConvert_RGBX_RGB_AVX2;
+	}
+	else {
+		dispatch->ColorConvert_RGB_RGBX = HafCpu_ColorConvert_RGB_RGBX;
+		dispatch->ColorConvert_RGBX_RGB = HafCpu_ColorConvert_RGBX_RGB;
+	}
+#undef HAFCPU_SET_DISPATCH
+}
@@ -3117,4 +3117,47 @@ int HafCpu_LaplacianReconstruct_DATA_DATA_DATA
 	vx_image input,
 	vx_image output
 );
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// runtime dispatch of hot CPU kernels: the AVX2 and AVX-512 variants are bit-exact to the SSE4.2 versions
+//
+typedef int (* HafCpu_U8_U8U8_f)(vx_uint32 dstWidth, vx_uint32 dstHeight, vx_uint8 * pDstImage, vx_uint32 dstImageStrideInBytes,
+	vx_uint8 * pSrcImage1, vx_uint32 srcImage1StrideInBytes, vx_uint8 * pSrcImage2, vx_uint32 srcImage2StrideInBytes);
+typedef int (* HafCpu_U8_U8_f)(vx_uint32 dstWidth, vx_uint32 dstHeight, vx_uint8 * pDstImage, vx_uint32 dstImageStrideInBytes,
+	vx_uint8 * pSrcImage, vx_uint32 srcImageStrideInBytes);
+typedef int (* HafCpu_U8_U8_3x3_f)(vx_uint32 dstWidth, vx_uint32 dstHeight, vx_uint8 * pDstImage, vx_uint32 dstImageStrideInBytes,
+	vx_uint8 * pSrcImage, vx_uint32 srcImageStrideInBytes, vx_uint8 * pScratch);
+typedef int (* HafCpu_S16S16_U8_3x3_f)(vx_uint32 dstWidth, vx_uint32 dstHeight, vx_int16 * pDstGxImage, vx_uint32 dstGxImageStrideInBytes,
+	vx_int16 * pDstGyImage, vx_uint32 dstGyImageStrideInBytes, vx_uint8 * pSrcImage, vx_uint32 srcImageStrideInBytes, vx_uint8 * pScratch);
+
+struct AgoHafCpuDispatch {
+	HafCpu_U8_U8U8_f       Add_U8_U8U8_Wrap;
+	HafCpu_U8_U8U8_f       Add_U8_U8U8_Sat;
+	HafCpu_U8_U8U8_f       Sub_U8_U8U8_Wrap;
+	HafCpu_U8_U8U8_f       Sub_U8_U8U8_Sat;
+	HafCpu_U8_U8U8_f       AbsDiff_U8_U8U8;
+	HafCpu_U8_U8_3x3_f     Box_U8_U8_3x3;
+	HafCpu_U8_U8_3x3_f     Gaussian_U8_U8_3x3;
+	HafCpu_S16S16_U8_3x3_f Sobel_S16S16_U8_3x3_GXY;
+	HafCpu_U8_U8_f         ColorConvert_RGB_RGBX;
+	HafCpu_U8_U8_f         ColorConvert_RGBX_RGB;
+};
+
+// selects the kernel variants for the given VX_AMD_CPU_ISA_* level
+void HafCpu_SelectDispatch(AgoHafCpuDispatch * dispatch, vx_enum isa);
+
+#define HAFCPU_DECLARE_DISPATCH_VARIANTS(suffix) \
+	int HafCpu_Add_U8_U8U8_Wrap_##suffix(vx_uint32, vx_uint32, vx_uint8 *, vx_uint32, vx_uint8 *, vx_uint32, vx_uint8 *, vx_uint32); \
+	int HafCpu_Add_U8_U8U8_Sat_##suffix(vx_uint32, vx_uint32, vx_uint8 *, vx_uint32, vx_uint8 *, vx_uint32, vx_uint8 *, vx_uint32); \
+	int HafCpu_Sub_U8_U8U8_Wrap_##suffix(vx_uint32, vx_uint32, vx_uint8 *, vx_uint32, vx_uint8 *, vx_uint32, vx_uint8 *, vx_uint32); \
+	int HafCpu_Sub_U8_U8U8_Sat_##suffix(vx_uint32, vx_uint32, vx_uint8 *, vx_uint32, vx_uint8 *, vx_uint32, vx_uint8 *, vx_uint32); \
+	int HafCpu_AbsDiff_U8_U8U8_##suffix(vx_uint32, vx_uint32, vx_uint8 *, vx_uint32, vx_uint8 *, vx_uint32, vx_uint8 *, vx_uint32); \
+	int HafCpu_Box_U8_U8_3x3_##suffix(vx_uint32, vx_uint32, vx_uint8 *, vx_uint32, vx_uint8 *, vx_uint32, vx_uint8 *); \
+	int HafCpu_Gaussian_U8_U8_3x3_##suffix(vx_uint32, vx_uint32, vx_uint8 *, vx_uint32, vx_uint8 *, vx_uint32, vx_uint8 *); \
+	int HafCpu_Sobel_S16S16_U8_3x3_GXY_##suffix(vx_uint32, vx_uint32, vx_int16 *, vx_uint32, vx_int16 *, vx_uint32, vx_uint8 *, vx_uint32, vx_uint8 *);
+HAFCPU_DECLARE_DISPATCH_VARIANTS(AVX2)
+HAFCPU_DECLARE_DISPATCH_VARIANTS(AVX512)
+// color conversions are memory bound: AVX-512 level uses the AVX2 variants
+int HafCpu_ColorConvert_RGB_RGBX_AVX2(vx_uint32, vx_uint32, vx_uint8 *, vx_uint32, vx_uint8 *, vx_uint32);
+int HafCpu_ColorConvert_RGBX_RGB_AVX2(vx_uint32, vx_uint32, vx_uint8 *, vx_uint32, vx_uint8 *, vx_uint32);
+
 #endif // __ago_haf_cpu_h__
@@ -0,0 +1,267 @@
+/* 
+Copyright (c) 2015 - 2022 Advanced Micro Devices, Inc. All rights reserved.
+ 
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+ 
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+ 
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+// AVX2 variants of hot CPU kernels, selected at runtime by HafCpu_SelectDispatch.
+// NOTE: this file is compiled with AVX2 code generation, so it must not include STL headers:
+//       inline functions instantiated here could be shared with code running on SSE4.2-only CPUs.
+#include "ago_haf_cpu.h"
+#include <immintrin.h>
+#include <stdint.h>
+
+#define HAFCPU_SIMD_ALPHA_MASK 0xFF000000
+
+static inline __m256i HafCpu_LoadU8ToU16_AVX2(const vx_uint8 * p)
+{
+	return _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)p));
+}
+
+static inline void HafCpu_StoreU16ToU8_AVX2(vx_uint8 * p, __m256i lo, __m256i hi)
+{
+	// packus works within 128-bit lanes: reorder 64-bit elements back into pixel order
+	_mm256_storeu_si256((__m256i *)p, _mm256_permute4x64_epi64(_mm256_packus_epi16(lo, hi), 0xD8));
+}
+
+#define HAFCPU_U8_U8U8_AVX2(name, vecop, scalarop) \
+int HafCpu_##name##_AVX2(vx_uint32 dstWidth, vx_uint32 dstHeight, vx_uint8 * pDstImage, vx_uint32 dstImageStrideInBytes, \
+	vx_uint8 * pSrcImage1, vx_uint32 srcImage1StrideInBytes, vx_uint8 * pSrcImage2, vx_uint32 srcImage2StrideInBytes) \
+{ \
+	for (vx_uint32 y = 0; y < dstHeight; y++) { \
+		vx_uint32 x = 0; \
+		for (; x + 32 <= dstWidth; x += 32) { \
+			__m256i a = _mm256_loadu_si256((const __m256i *)(pSrcImage1 + x)); \
+			__m256i b = _mm256_loadu_si256((const __m256i *)(pSrcImage2 + x)); \
+			_mm256_storeu_si256((__m256i *)(pDstImage + x), vecop); \
+		} \
+		for (; x < dstWidth; x++) { \
+			int a = pSrcImage1[x], b = pSrcImage2[x]; \
+			pDstImage[x] = (vx_uint8)(scalarop); \
+		} \
+		pSrcImage1 += srcImage1StrideInBytes; \
+		pSrcImage2 += srcImage2StrideInBytes; \
+		pDstImage += dstImageStrideInBytes; \
+	} \
+	return 0; \
+}
+
+HAFCPU_U8_U8U8_AVX2(Add_U8_U8U8_Wrap, _mm256_add_epi8(a, b), a + b)
+HAFCPU_U8_U8U8_AVX2(Add_U8_U8U8_Sat, _mm256_adds_epu8(a, b), (a + b) > 255 ? 255 : (a + b))
+HAFCPU_U8_U8U8_AVX2(Sub_U8_U8U8_Wrap, _mm256_sub_epi8(a, b), a - b)
+HAFCPU_U8_U8U8_AVX2(Sub_U8_U8U8_Sat, _mm256_subs_epu8(a, b), (a - b) < 0 ? 0 : (a - b))
+HAFCPU_U8_U8U8_AVX2(AbsDiff_U8_U8U8, _mm256_or_si256(_mm256_subs_epu8(a, b), _mm256_subs_epu8(b, a)), (a > b) ? (a - b) : (b - a))
+
+int HafCpu_Box_U8_U8_3x3_AVX2
+	(
+		vx_uint32     dstWidth,
+		vx_uint32     dstHeight,
+		vx_uint8    * pDstImage,
+		vx_uint32     dstImageStrideInBytes,
+		vx_uint8    * pSrcImage,
+		vx_uint32     srcImageStrideInBytes,
+		vx_uint8    * pScratch
+	)
+{
+	// sum/9 is computed as (sum * 7282) >> 16 which matches floor(sum/9) of the SSE4.2 version for all 3x3 U8 sums
+	const __m256i divFactor = _mm256_set1_epi16((short)7282);
+	int stride = (int)srcImageStrideInBytes;
+	for (vx_uint32 y = 0; y < dstHeight; y++) {
+		const vx_uint8 * pT = pSrcImage - stride, * pM = pSrcImage, * pB = pSrcImage + stride;
+		vx_uint32 x = 0;
+		for (; x + 32 <= dstWidth; x += 32) {
+			__m256i result[2];
+			for (int half = 0; half < 2; half++) {
+				int i = (int)x + half * 16;
+				__m256i sum = _mm256_add_epi16(HafCpu_LoadU8ToU16_AVX2(pT + i - 1), HafCpu_LoadU8ToU16_AVX2(pT + i));
+				sum = _mm256_add_epi16(sum, HafCpu_LoadU8ToU16_AVX2(pT + i + 1));
+				sum = _mm256_add_epi16(sum, HafCpu_LoadU8ToU16_AVX2(pM + i - 1));
+				sum = _mm256_add_epi16(sum, HafCpu_LoadU8ToU16_AVX2(pM + i));
+				sum = _mm256_add_epi16(sum, HafCpu_LoadU8ToU16_AVX2(pM + i + 1));
+				sum = _mm256_add_epi16(sum, HafCpu_LoadU8ToU16_AVX2(pB + i - 1));
+				sum = _mm256_add_epi16(sum, HafCpu_LoadU8ToU16_AVX2(pB + i));
+				sum = _mm256_add_epi16(sum, HafCpu_LoadU8ToU16_AVX2(pB + i + 1));
+				result[half] = _mm256_mulhi_epi16(sum, divFactor);
+			}
+			HafCpu_StoreU16ToU8_AVX2(pDstImage + x, result[0], result[1]);
+		}
+		for (; x < dstWidth; x++) {
+			int i = (int)x;
+			int sum = pT[i - 1] + pT[i] + pT[i + 1] + pM[i - 1] + pM[i] + pM[i + 1] + pB[i - 1] + pB[i] + pB[i + 1];
+			pDstImage[x] = (vx_uint8)((sum * 7282) >> 16);
+		}
+		pSrcImage += srcImageStrideInBytes;
+		pDstImage += dstImageStrideInBytes;
+	}
+	return 0;
+}
+
+int HafCpu_Gaussian_U8_U8_3x3_AVX2
+	(
+		vx_uint32     dstWidth,
+		vx_uint32     dstHeight,
+		vx_uint8    * pDstImage,
+		vx_uint32     dstImageStrideInBytes,
+		vx_uint8    * pSrcImage,
+		vx_uint32     srcImageStrideInBytes,
+		vx_uint8    * pScratch
+	)
+{
+	int stride = (int)srcImageStrideInBytes;
+	for (vx_uint32 y = 0; y < dstHeight; y++) {
+		const vx_uint8 * pT = pSrcImage - stride, * pM = pSrcImage, * pB = pSrcImage + stride;
+		vx_uint32 x = 0;
+		for (; x + 32 <= dstWidth; x += 32) {
+			__m256i result[2];
+			for (int half = 0; half < 2; half++) {
+				int i = (int)x + half * 16;
+				__m256i v[3];
+				for (int dx = -1; dx <= 1; dx++) {
+					// vertical [1 2 1]
+					__m256i m = HafCpu_LoadU8ToU16_AVX2(pM + i + dx);
+					v[dx + 1] = _mm256_add_epi16(_mm256_add_epi16(HafCpu_LoadU8ToU16_AVX2(pT + i + dx), HafCpu_LoadU8ToU16_AVX2(pB + i + dx)), _mm256_slli_epi16(m, 1));
+				}
+				// horizontal [1 2 1] and normalization by 16
+				__m256i sum = _mm256_add_epi16(_mm256_add_epi16(v[0], v[2]), _mm256_slli_epi16(v[1], 1));
+				result[half] = _mm256_srli_epi16(sum, 4);
+			}
+			HafCpu_StoreU16ToU8_AVX2(pDstImage + x, result[0], result[1]);
+		}
+		for (; x < dstWidth; x++) {
+			int i = (int)x;
+			int sum = (pT[i - 1] + 2 * pT[i] + pT[i + 1]) + 2 * (pM[i - 1] + 2 * pM[i] + pM[i + 1]) + (pB[i - 1] + 2 * pB[i] + pB[i + 1]);
+			pDstImage[x] = (vx_uint8)(sum >> 4);
+		}
+		pSrcImage += srcImageStrideInBytes;
+		pDstImage += dstImageStrideInBytes;
+	}
+	return 0;
+}
+
+int HafCpu_Sobel_S16S16_U8_3x3_GXY_AVX2
+	(
+		vx_uint32     dstWidth,
+		vx_uint32     dstHeight,
+		vx_int16    * pDstGxImage,
+		vx_uint32     dstGxImageStrideInBytes,
+		vx_int16    * pDstGyImage,
+		vx_uint32     dstGyImageStrideInBytes,
+		vx_uint8    * pSrcImage,
+		vx_uint32     srcImageStrideInBytes,
+		vx_uint8    * pScratch
+	)
+{
+	int stride = (int)srcImageStrideInBytes;
+	for (vx_uint32 y = 0; y < dstHeight; y++) {
+		const vx_uint8 * pT = pSrcImage - stride, * pM = pSrcImage, * pB = pSrcImage + stride;
+		vx_uint32 x = 0;
+		for (; x + 16 <= dstWidth; x += 16) {
+			int i = (int)x;
+			__m256i tl = HafCpu_LoadU8ToU16_AVX2(pT + i - 1), tc = HafCpu_LoadU8ToU16_AVX2(pT + i), tr = HafCpu_LoadU8ToU16_AVX2(pT + i + 1);
+			__m256i ml = HafCpu_LoadU8ToU16_AVX2(pM + i - 1), mr = HafCpu_LoadU8ToU16_AVX2(pM + i + 1);
+			__m256i bl = HafCpu_LoadU8ToU16_AVX2(pB + i - 1), bc = HafCpu_LoadU8ToU16_AVX2(pB + i), br = HafCpu_LoadU8ToU16_AVX2(pB + i + 1);
+			// Gx = [-1 0 1; -2 0 2; -1 0 1], Gy = [-1 -2 -1; 0 0 0; 1 2 1]
+			__m256i gx = _mm256_add_epi16(_mm256_sub_epi16(tr, tl), _mm256_sub_epi16(br, bl));
+			gx = _mm256_add_epi16(gx, _mm256_slli_epi16(_mm256_sub_epi16(mr, ml), 1));
+			__m256i gy = _mm256_add_epi16(_mm256_sub_epi16(bl, tl), _mm256_sub_epi16(br, tr));
+			gy = _mm256_add_epi16(gy, _mm256_slli_epi16(_mm256_sub_epi16(bc, tc), 1));
+			_mm256_storeu_si256((__m256i *)(pDstGxImage + x), gx);
+			_mm256_storeu_si256((__m256i *)(pDstGyImage + x), gy);
+		}
+		for (; x < dstWidth; x++) {
+			int i = (int)x;
+			pDstGxImage[x] = (vx_int16)((pT[i + 1] - pT[i - 1]) + 2 * (pM[i + 1] - pM[i - 1]) + (pB[i + 1] - pB[i - 1]));
+			pDstGyImage[x] = (vx_int16)((pB[i - 1] - pT[i - 1]) + 2 * (pB[i] - pT[i]) + (pB[i + 1] - pT[i + 1]));
+		}
+		pSrcImage += srcImageStrideInBytes;
+		pDstGxImage = (vx_int16 *)((vx_uint8 *)pDstGxImage + dstGxImageStrideInBytes);
+		pDstGyImage = (vx_int16 *)((vx_uint8 *)pDstGyImage + dstGyImageStrideInBytes);
+	}
+	return 0;
+}
+
+int HafCpu_ColorConvert_RGB_RGBX_AVX2
+	(
+		vx_uint32     dstWidth,
+		vx_uint32     dstHeight,
+		vx_uint8    * pDstImage,
+		vx_uint32     dstImageStrideInBytes,
+		vx_uint8    * pSrcImage,
+		vx_uint32     srcImageStrideInBytes
+	)
+{
+	// drop X from 4 pixels in each 128-bit lane and then pack the two 12-byte lanes
+	const __m256i maskRGB = _mm256_setr_epi8(0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1,
+	                                         0, 1, 2, 4, 5, 6, 8, 9, 10, 12, 13, 14, -1, -1, -1, -1);
+	const __m256i permRGB = _mm256_setr_epi32(0, 1, 2, 4, 5, 6, 3, 7);
+	for (vx_uint32 y = 0; y < dstHeight; y++) {
+		vx_uint32 x = 0;
+		for (; x + 8 <= dstWidth; x += 8) {
+			__m256i pixels = _mm256_loadu_si256((const __m256i *)(pSrcImage + 4 * x));
+			pixels = _mm256_permutevar8x32_epi32(_mm256_shuffle_epi8(pixels, maskRGB), permRGB);
+			_mm_storeu_si128((__m128i *)(pDstImage + 3 * x), _mm256_castsi256_si128(pixels));
+			_mm_storel_epi64((__m128i *)(pDstImage + 3 * x + 16), _mm256_extracti128_si256(pixels, 1));
+		}
+		for (; x < dstWidth; x++) {
+			pDstImage[3 * x + 0] = pSrcImage[4 * x + 0];
+			pDstImage[3 * x + 1] = pSrcImage[4 * x + 1];
+			pDstImage[3 * x + 2] = pSrcImage[4 * x + 2];
+		}
+		pSrcImage += srcImageStrideInBytes;
+		pDstImage += dstImageStrideInBytes;
+	}
+	return 0;
+}
+
+int HafCpu_ColorConvert_RGBX_RGB_AVX2
+	(
+		vx_uint32     dstWidth,
+		vx_uint32     dstHeight,
+		vx_uint8    * pDstImage,
+		vx_uint32     dstImageStrideInBytes,
+		vx_uint8    * pSrcImage,
+		vx_uint32     srcImageStrideInBytes
+	)
+{
+	// expand 4 pixels of each 128-bit lane (loaded at 12 byte offsets) and fill X with 255
+	const __m256i maskRGBX = _mm256_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1,
+	                                          0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+	const __m256i alpha = _mm256_set1_epi32((int)HAFCPU_SIMD_ALPHA_MASK);
+	for (vx_uint32 y = 0; y < dstHeight; y++) {
+		vx_uint32 x = 0;
+		// the upper lane loads 16 bytes at offset 12: keep 4 bytes of the row beyond the 8 pixels
+		for (; x + 10 <= dstWidth; x += 8) {
+			const vx_uint8 * pSrc = pSrcImage + 3 * x;
+			__m256i pixels = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i *)pSrc)),
+			                                         _mm_loadu_si128((const __m128i *)(pSrc + 12)), 1);
+			pixels = _mm256_or_si256(_mm256_shuffle_epi8(pixels, maskRGBX), alpha);
+			_mm256_storeu_si256((__m256i *)(pDstImage + 4 * x), pixels);
+		}
+		for (; x < dstWidth; x++) {
+			pDstImage[4 * x + 0] = pSrcImage[3 * x + 0];
+			pDstImage[4 * x + 1] = pSrcImage[3 * x + 1];
+			pDstImage[4 * x + 2] = pSrcImage[3 * x + 2];
+			pDstImage[4 * x + 3] = 255;
+		}
+		pSrcImage += srcImageStrideInBytes;
+		pDstImage += dstImageStrideInBytes;
+	}
+	return 0;
+}
@@ -0,0 +1,197 @@
+/* 
+Copyright (c) 2015 - 2022 Advanced Micro Devices, Inc. All rights reserved.
+ 
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+ 
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+ 
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+// AVX-512 (F+BW) variants of hot CPU kernels, selected at runtime by HafCpu_SelectDispatch.
+// NOTE: this file is compiled with AVX-512 code generation, so it must not include STL headers:
+//       inline functions instantiated here could be shared with code running on SSE4.2-only CPUs.
+#include "ago_haf_cpu.h"
+#include <immintrin.h>
+#include <stdint.h>
+
+static inline __m512i HafCpu_LoadU8ToU16_AVX512(const vx_uint8 * p)
+{
+	return _mm512_cvtepu8_epi16(_mm256_loadu_si256((const __m256i *)p));
+}
+
+static inline void HafCpu_StoreU16ToU8_AVX512(vx_uint8 * p, __m512i lo, __m512i hi)
+{
+	// packus works within 128-bit lanes: reorder 64-bit elements back into pixel order
+	const __m512i perm = _mm512_setr_epi64(0, 2, 4, 6, 1, 3, 5, 7);
+	_mm512_storeu_si512((__m512i *)p, _mm512_permutexvar_epi64(perm, _mm512_packus_epi16(lo, hi)));
+}
+
+#define HAFCPU_U8_U8U8_AVX512(name, vecop, scalarop) \
+int HafCpu_##name##_AVX512(vx_uint32 dstWidth, vx_uint32 dstHeight, vx_uint8 * pDstImage, vx_uint32 dstImageStrideInBytes, \
+	vx_uint8 * pSrcImage1, vx_uint32 srcImage1StrideInBytes, vx_uint8 * pSrcImage2, vx_uint32 srcImage2StrideInBytes) \
+{ \
+	for (vx_uint32 y = 0; y < dstHeight; y++) { \
+		vx_uint32 x = 0; \
+		for (; x + 64 <= dstWidth; x += 64) { \
+			__m512i a = _mm512_loadu_si512((const __m512i *)(pSrcImage1 + x)); \
+			__m512i b = _mm512_loadu_si512((const __m512i *)(pSrcImage2 + x)); \
+			_mm512_storeu_si512((__m512i *)(pDstImage + x), vecop); \
+		} \
+		for (; x < dstWidth; x++) { \
+			int a = pSrcImage1[x], b = pSrcImage2[x]; \
+			pDstImage[x] = (vx_uint8)(scalarop); \
+		} \
+		pSrcImage1 += srcImage1StrideInBytes; \
+		pSrcImage2 += srcImage2StrideInBytes; \
+		pDstImage += dstImageStrideInBytes; \
+	} \
+	return 0; \
+}
+
+HAFCPU_U8_U8U8_AVX512(Add_U8_U8U8_Wrap, _mm512_add_epi8(a, b), a + b)
+HAFCPU_U8_U8U8_AVX512(Add_U8_U8U8_Sat, _mm512_adds_epu8(a, b), (a + b) > 255 ? 255 : (a + b))
+HAFCPU_U8_U8U8_AVX512(Sub_U8_U8U8_Wrap, _mm512_sub_epi8(a, b), a - b)
+HAFCPU_U8_U8U8_AVX512(Sub_U8_U8U8_Sat, _mm512_subs_epu8(a, b), (a - b) < 0 ? 0 : (a - b))
+HAFCPU_U8_U8U8_AVX512(AbsDiff_U8_U8U8, _mm512_or_si512(_mm512_subs_epu8(a, b), _mm512_subs_epu8(b, a)), (a > b) ? (a - b) : (b - a))
+
+int HafCpu_Box_U8_U8_3x3_AVX512
+	(
+		vx_uint32     dstWidth,
+		vx_uint32     dstHeight,
+		vx_uint8    * pDstImage,
+		vx_uint32     dstImageStrideInBytes,
+		vx_uint8    * pSrcImage,
+		vx_uint32     srcImageStrideInBytes,
+		vx_uint8    * pScratch
+	)
+{
+	// sum/9 is computed as (sum * 7282) >> 16 which matches floor(sum/9) of the SSE4.2 version for all 3x3 U8 sums
+	const __m512i divFactor = _mm512_set1_epi16((short)7282);
+	int stride = (int)srcImageStrideInBytes;
+	for (vx_uint32 y = 0; y < dstHeight; y++) {
+		const vx_uint8 * pT = pSrcImage - stride, * pM = pSrcImage, * pB = pSrcImage + stride;
+		vx_uint32 x = 0;
+		for (; x + 64 <= dstWidth; x += 64) {
+			__m512i result[2];
+			for (int half = 0; half < 2; half++) {
+				int i = (int)x + half * 32;
+				__m512i sum = _mm512_add_epi16(HafCpu_LoadU8ToU16_AVX512(pT + i - 1), HafCpu_LoadU8ToU16_AVX512(pT + i));
+				sum = _mm512_add_epi16(sum, HafCpu_LoadU8ToU16_AVX512(pT + i + 1));
+				sum = _mm512_add_epi16(sum, HafCpu_LoadU8ToU16_AVX512(pM + i - 1));
+				sum = _mm512_add_epi16(sum, HafCpu_LoadU8ToU16_AVX512(pM + i));
+				sum = _mm512_add_epi16(sum, HafCpu_LoadU8ToU16_AVX512(pM + i + 1));
+				sum = _mm512_add_epi16(sum, HafCpu_LoadU8ToU16_AVX512(pB + i - 1));
+				sum = _mm512_add_epi16(sum, HafCpu_LoadU8ToU16_AVX512(pB + i));
+				sum = _mm512_add_epi16(sum, HafCpu_LoadU8ToU16_AVX512(pB + i + 1));
+				result[half] = _mm512_mulhi_epi16(sum, divFactor);
+			}
+			HafCpu_StoreU16ToU8_AVX512(pDstImage + x, result[0], result[1]);
+		}
+		for (; x < dstWidth; x++) {
+			int i = (int)x;
+			int sum = pT[i - 1] + pT[i] + pT[i + 1] + pM[i - 1] + pM[i] + pM[i + 1] + pB[i - 1] + pB[i] + pB[i + 1];
+			pDstImage[x] = (vx_uint8)((sum * 7282) >> 16);
+		}
+		pSrcImage += srcImageStrideInBytes;
+		pDstImage += dstImageStrideInBytes;
+	}
+	return 0;
+}
+
+int HafCpu_Gaussian_U8_U8_3x3_AVX512
+	(
+		vx_uint32     dstWidth,
+		vx_uint32     dstHeight,
+		vx_uint8    * pDstImage,
+		vx_uint32     dstImageStrideInBytes,
+		vx_uint8    * pSrcImage,
+		vx_uint32     srcImageStrideInBytes,
+		vx_uint8    * pScratch
+	)
+{
+	int stride = (int)srcImageStrideInBytes;
+	for (vx_uint32 y = 0; y < dstHeight; y++) {
+		const vx_uint8 * pT = pSrcImage - stride, * pM = pSrcImage, * pB = pSrcImage + stride;
+		vx_uint32 x = 0;
+		for (; x + 64 <= dstWidth; x += 64) {
+			__m512i result[2];
+			for (int half = 0; half < 2; half++) {
+				int i = (int)x + half * 32;
+				__m512i v[3];
+				for (int dx = -1; dx <= 1; dx++) {
+					// vertical [1 2 1]
+					__m512i m = HafCpu_LoadU8ToU16_AVX512(pM + i + dx);
+					v[dx + 1] = _mm512_add_epi16(_mm512_add_epi16(HafCpu_LoadU8ToU16_AVX512(pT + i + dx), HafCpu_LoadU8ToU16_AVX512(pB + i + dx)), _mm512_slli_epi16(m, 1));
+				}
+				// horizontal [1 2 1] and normalization by 16
+				__m512i sum = _mm512_add_epi16(_mm512_add_epi16(v[0], v[2]), _mm512_slli_epi16(v[1], 1));
+				result[half] = _mm512_srli_epi16(sum, 4);
+			}
+			HafCpu_StoreU16ToU8_AVX512(pDstImage + x, result[0], result[1]);
+		}
+		for (; x < dstWidth; x++) {
+			int i = (int)x;
+			int sum = (pT[i - 1] + 2 * pT[i] + pT[i + 1]) + 2 * (pM[i - 1] + 2 * pM[i] + pM[i + 1]) + (pB[i - 1] + 2 * pB[i] + pB[i + 1]);
+			pDstImage[x] = (vx_uint8)(sum >> 4);
+		}
+		pSrcImage += srcImageStrideInBytes;
+		pDstImage += dstImageStrideInBytes;
+	}
+	return 0;
+}
+
+int HafCpu_Sobel_S16S16_U8_3x3_GXY_AVX512
+	(
+		vx_uint32     dstWidth,
+		vx_uint32     dstHeight,
+		vx_int16    * pDstGxImage,
+		vx_uint32     dstGxImageStrideInBytes,
+		vx_int16    * pDstGyImage,
+		vx_uint32     dstGyImageStrideInBytes,
+		vx_uint8    * pSrcImage,
+		vx_uint32     srcImageStrideInBytes,
+		vx_uint8    * pScratch
+	)
+{
+	int stride = (int)srcImageStrideInBytes;
+	for (vx_uint32 y = 0; y < dstHeight; y++) {
+		const vx_uint8 * pT = pSrcImage - stride, * pM = pSrcImage, * pB = pSrcImage + stride;
+		vx_uint32 x = 0;
+		for (; x + 32 <= dstWidth; x += 32) {
+			int i = (int)x;
+			__m512i tl = HafCpu_LoadU8ToU16_AVX512(pT + i - 1), tc = HafCpu_LoadU8ToU16_AVX512(pT + i), tr = HafCpu_LoadU8ToU16_AVX512(pT + i + 1);
+			__m512i ml = HafCpu_LoadU8ToU16_AVX512(pM + i - 1), mr = HafCpu_LoadU8ToU16_AVX512(pM + i + 1);
+			__m512i bl = HafCpu_LoadU8ToU16_AVX512(pB + i - 1), bc = HafCpu_LoadU8ToU16_AVX512(pB + i), br = HafCpu_LoadU8ToU16_AVX512(pB + i + 1);
+			// Gx = [-1 0 1; -2 0 2; -1 0 1], Gy = [-1 -2 -1; 0 0 0; 1 2 1]
+			__m512i gx = _mm512_add_epi16(_mm512_sub_epi16(tr, tl), _mm512_sub_epi16(br, bl));
+			gx = _mm512_add_epi16(gx, _mm512_slli_epi16(_mm512_sub_epi16(mr, ml), 1));
+			__m512i gy = _mm512_add_epi16(_mm512_sub_epi16(bl, tl), _mm512_sub_epi16(br, tr));
+			gy = _mm512_add_epi16(gy, _mm512_slli_epi16(_mm512_sub_epi16(bc, tc), 1));
+			_mm512_storeu_si512((__m512i *)(pDstGxImage + x), gx);
+			_mm512_storeu_si512((__m512i *)(pDstGyImage + x), gy);
+		}
+		for (; x < dstWidth; x++) {
+			int i = (int)x;
+			pDstGxImage[x] = (vx_int16)((pT[i + 1] - pT[i - 1]) + 2 * (pM[i + 1] - pM[i - 1]) + (pB[i + 1] - pB[i - 1]));
+			pDstGyImage[x] = (vx_int16)((pB[i - 1] - pT[i - 1]) + 2 * (pB[i] - pT[i]) + (pB[i + 1] - pT[i + 1]));
+		}
+		pSrcImage += srcImageStrideInBytes;
+		pDstGxImage = (vx_int16 *)((vx_uint8 *)pDstGxImage + dstGxImageStrideInBytes);
+		pDstGyImage = (vx_int16 *)((vx_uint8 *)pDstGyImage + dstGyImageStrideInBytes);
+	}
+	return 0;
+}
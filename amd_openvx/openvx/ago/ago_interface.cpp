@@ -31,8 +31,8 @@ static void agoGraphThreadFunction(LPVOID graph_)
 #endif
 {
     AgoGraph * graph = (AgoGraph *)graph_;
+    agoTraceSetThreadName("AGO graph thread");
     while (WaitForSingleObject(graph->hSemToThread, INFINITE) == WAIT_OBJECT_0) {
-        graph->threadThreadWaitState = 2;
         if (graph->threadThreadTerminationState)
             break;
 
@@ -62,6 +62,9 @@ AgoContext * agoCreateContextFromPlatform(struct _vx_platform * platform)
         return NULL;
     }
 
+    // start the trace requested with AGO_TRACE_FILE
+    agoTraceInitialize();
+
     // create context and initialize
     AgoContext * acontext = new AgoContext;
     if (acontext) {
@@ -81,12 +84,61 @@ AgoContext * agoCreateContextFromPlatform(struct _vx_platform * platform)
         // initialize thread config
         char textBuffer[1024];
         if (agoGetEnvironmentVariable("AGO_THREAD_CONFIG", textBuffer, sizeof(textBuffer))) {
-            acontext->thread_config = atoi(textBuffer);
+            acontext->thread_config = (vx_uint32)strtoul(textBuffer, nullptr, 0);
+            vx_uint32 cpu_thread_count = (acontext->thread_config >> CONFIG_THREAD_CPU_COUNT_SHIFT) & CONFIG_THREAD_CPU_COUNT_MASK;
+            if (cpu_thread_count > 1) {
+                agoSetCpuThreadCount(acontext, cpu_thread_count);
+            }
+        }
+        // select the best CPU kernel instruction set, optionally capped by AGO_CPU_ISA
+        vx_enum cpu_isa = agoGetCpuIsaSupport();
+        if (agoGetEnvironmentVariable("AGO_CPU_ISA", textBuffer, sizeof(textBuffer))) {
+            vx_enum cpu_isa_cap = cpu_isa;
+            if (!_stricmp(textBuffer, "SSE4.2") || !_stricmp(textBuffer, "SSE4_2")) cpu_isa_cap = VX_AMD_CPU_ISA_SSE4_2;
+            else if (!_stricmp(textBuffer, "AVX2")) cpu_isa_cap = VX_AMD_CPU_ISA_AVX2;
+            else if (!_stricmp(textBuffer, "AVX512")) cpu_isa_cap = VX_AMD_CPU_ISA_AVX512;
+            else agoAddLogEntry(&acontext->ref, VX_SUCCESS, "WARNING: AGO_CPU_ISA=%s ignored (use SSE4.2, AVX2, or AVX512)\n", textBuffer);
+            if (cpu_isa_cap < cpu_isa) cpu_isa = cpu_isa_cap;
         }
+        agoSetCpuIsa(acontext, cpu_isa);
     }
     return (AgoContext *)acontext;
 }
 
+int agoSetCpuIsa(AgoContext * acontext, vx_enum isa)
+{
+    // switch the kernel variants used by CPU nodes: all levels produce bit-exact results
+    if (isa < VX_AMD_CPU_ISA_SSE4_2 || isa > agoGetCpuIsaSupport())
+        return VX_ERROR_NOT_SUPPORTED;
+    acontext->cpu_isa = isa;
+    HafCpu_SelectDispatch(&acontext->haf_cpu, isa);
+    return VX_SUCCESS;
+}
+
+int agoSetCpuThreadCount(AgoContext * acontext, vx_uint32 count)
+{
+    // replace the pool used for parallel execution of CPU nodes at the same hierarchical level:
+    // count <= 1 keeps the serial execution of nodes on the graph thread
+    std::lock_guard<std::mutex> lock(acontext->cpu_thread_pool_lock);
+    if (acontext->num_executing_graphs > 0) {
+        agoAddLogEntry(&acontext->ref, VX_ERROR_GRAPH_SCHEDULED, "ERROR: agoSetCpuThreadCount: %d graph(s) executing\n", acontext->num_executing_graphs);
+        return VX_ERROR_GRAPH_SCHEDULED;
+    }
+    if (acontext->cpu_thread_pool) {
+        delete acontext->cpu_thread_pool;
+        acontext->cpu_thread_pool = nullptr;
+    }
+    acontext->cpu_thread_count = count;
+    if (count > 1) {
+        acontext->cpu_thread_pool = new AgoThreadPool(count);
+        if (!acontext->cpu_thread_pool) {
+            acontext->cpu_thread_count = 0;
+            return VX_ERROR_NO_MEMORY;
+        }
+    }
+    return VX_SUCCESS;
+}
+
 int agoReleaseContext(AgoContext * acontext)
 {
     CAgoLockGlobalContext lock;
@@ -105,6 +157,7 @@ int agoReleaseContext(AgoContext * acontext)
         // release all the resources
         LeaveCriticalSection(&acontext->cs);
         delete acontext;
+        agoTraceFlush();
     }
     return 0;
 }
@@ -174,9 +227,9 @@ int agoReleaseGraph(AgoGraph * agraph)
             agraph->threadThreadTerminationState = 1;
             ReleaseSemaphore(agraph->hSemToThread, 1, nullptr);
             while (agraph->threadThreadTerminationState == 1) {
-                // give a chance for the thread to run in case it is waititng
-                std::this_thread::sleep_for(std::chrono::milliseconds(1));
-                ReleaseSemaphore(agraph->hSemToThread, 1, nullptr);
+                // the thread signals hSemFromThread after every execution and once more on termination
+                if (WaitForSingleObject(agraph->hSemFromThread, INFINITE) != WAIT_OBJECT_0)
+                    break;
             }
             if (agraph->hSemToThread) {
                 CloseHandle(agraph->hSemToThread);
@@ -186,6 +239,8 @@ int agoReleaseGraph(AgoGraph * agraph)
             }
             CloseHandle(agraph->hThread);
         }
+        // stop the frames of queued graph parameters and release the graph replicas
+        agoGraphPipelineRelease(agraph);
         // deinitialize the graph
         for (AgoNode * node = agraph->nodeList.head; node; node = node->next)
         {
@@ -1846,7 +1901,8 @@ int agoInitializeGraph(AgoGraph * graph)
             status = kernel->func(node, ago_kernel_cmd_initialize);
         }
         else if (kernel->initialize_f) {
-            if((kernel->user_kernel == vx_true_e) && (node->localDataSize == 0)) {
+            // kernels added with vxAddKernel (e.g., loomsl exposure compensation) also set their local data in the initializer
+            if(node->localDataSize == 0) {
                 node->local_data_change_is_enabled = vx_true_e;
             }
             status = kernel->initialize_f(node, (vx_reference *)node->paramList, node->paramCount);
@@ -2153,8 +2209,194 @@ int agoUpdateDelaySlots(AgoNode * node)
     return 0;
 }
 
+#if (ENABLE_OPENCL||ENABLE_HIP)
+static int agoPrepareCpuNode(AgoGraph * graph, AgoNode * node, vx_uint32& nodeLaunchHierarchicalLevel, bool& opencl_buffer_access_enable)
+{
+    vx_status status = VX_SUCCESS;
+    opencl_buffer_access_enable |= (node->akernel->opencl_buffer_access_enable ? true : false);
+    if (!node->akernel->opencl_buffer_access_enable) {
+        agoPerfProfileEntry(graph, ago_profile_type_wait_begin, &node->ref);
+        if (nodeLaunchHierarchicalLevel > 0 && nodeLaunchHierarchicalLevel < node->hierarchical_level) {
+            status = agoWaitForNodesCompletion(graph);
+            if (status != VX_SUCCESS) {
+                agoAddLogEntry((vx_reference)graph, VX_FAILURE, "ERROR: agoWaitForNodesCompletion failed (%d:%s)\n", status, agoEnum2Name(status));
+                return status;
+            }
+            nodeLaunchHierarchicalLevel = 0;
+        }
+        if(opencl_buffer_access_enable) {
+#if ENABLE_OPENCL
+            cl_int err = clFinish(graph->opencl_cmdq);
+            if (err) {
+                agoAddLogEntry(NULL, VX_FAILURE, "ERROR: clFinish(graph) => %d\n", err);
+                return VX_FAILURE;
+            }
+#else
+            hipError_t err = hipStreamSynchronize(graph->hip_stream0);
+            if (err) {
+                agoAddLogEntry(NULL, VX_FAILURE, "ERROR: hipStreamSynchronize(graph) => %d\n", err);
+                return VX_FAILURE;
+            }
+#endif
+            opencl_buffer_access_enable = false;
+        }
+        agoPerfProfileEntry(graph, ago_profile_type_wait_end, &node->ref);
+    }
+    agoPerfProfileEntry(graph, ago_profile_type_copy_begin, &node->ref);
+    // make sure that all input buffers are synched
+    if (node->akernel->opencl_buffer_access_enable) {
+        for (vx_uint32 i = 0; i < node->paramCount; i++) {
+            AgoData * data = node->paramList[i];
+            if (data &&
+                (node->parameters[i].direction == VX_INPUT || node->parameters[i].direction == VX_BIDIRECTIONAL))
+            {
+                auto dataToSync = (data->ref.type == VX_TYPE_IMAGE && data->u.img.isROI) ? data->u.img.roiMasterImage : data;
+                if (dataToSync->buffer_sync_flags & (AGO_BUFFER_SYNC_FLAG_DIRTY_BY_NODE | AGO_BUFFER_SYNC_FLAG_DIRTY_BY_COMMIT) &&
+#if ENABLE_OPENCL
+                dataToSync->opencl_buffer && !(dataToSync->buffer_sync_flags & AGO_BUFFER_SYNC_FLAG_DIRTY_SYNCHED))
+                {
+                    status = agoDirective((vx_reference)dataToSync, VX_DIRECTIVE_AMD_COPY_TO_OPENCL);
+                    if(status != VX_SUCCESS) {
+                        agoAddLogEntry((vx_reference)graph, VX_FAILURE, "ERROR: agoDirective(*,VX_DIRECTIVE_AMD_COPY_TO_OPENCL) failed (%d:%s)\n", status, agoEnum2Name(status));
+                        return status;
+                    }
+                }
+#else
+                dataToSync->hip_memory && !(dataToSync->buffer_sync_flags & AGO_BUFFER_SYNC_FLAG_DIRTY_SYNCHED))
+                {
+                    status = agoDirective((vx_reference)dataToSync, VX_DIRECTIVE_AMD_COPY_TO_HIPMEM);
+                    if(status != VX_SUCCESS) {
+                        agoAddLogEntry((vx_reference)graph, VX_FAILURE, "ERROR: agoDirective(*,VX_DIRECTIVE_AMD_COPY_TO_HIPMEM) failed (%d:%s)\n", status, agoEnum2Name(status));
+                        return status;
+                    }
+                }
+#endif
+            }
+        }
+    }
+    else {
+        for (vx_uint32 i = 0; i < node->paramCount; i++) {
+            AgoData * data = node->paramList[i];
+            if (data && (node->parameters[i].direction == VX_INPUT || node->parameters[i].direction == VX_BIDIRECTIONAL)) {
+                auto dataToSync = (data->ref.type == VX_TYPE_IMAGE && data->u.img.isROI) ? data->u.img.roiMasterImage : data;
+                status = agoDataSyncFromGpuToCpu(graph, node, dataToSync);
+                for (vx_uint32 j = 0; !status && j < dataToSync->numChildren; j++) {
+                    AgoData * jdata = dataToSync->children[j];
+                    if (jdata)
+                        status = agoDataSyncFromGpuToCpu(graph, node, jdata);
+                }
+                if (status) {
+                    agoAddLogEntry((vx_reference)graph, VX_FAILURE, "ERROR: agoDataSyncFromGpuToCpu failed (%d:%s) for node(%s) arg#%d data(%s)\n", status, agoEnum2Name(status), node->akernel->name, i, data->name.c_str());
+                    return status;
+                }
+            }
+        }
+    }
+    agoPerfProfileEntry(graph, ago_profile_type_copy_end, &node->ref);
+    return status;
+}
+#endif
+
+static int agoExecuteCpuNode(AgoGraph * graph, AgoNode * node, bool profile)
+{
+    // nodes executed in parallel can't add to the graph profile, but can still be traced on their own thread
+    if (profile) agoPerfProfileEntry(graph, ago_profile_type_exec_begin, &node->ref);
+    else if (agoTraceIsEnabled()) agoTraceProfileEntry(graph->execFrameCount, ago_profile_type_exec_begin, &node->ref, agoGetClockCounter());
+    agoPerfCaptureStart(&node->perf);
+    AgoKernel * kernel = node->akernel;
+    vx_status status = VX_SUCCESS;
+    if (kernel->func) {
+        status = kernel->func(node, ago_kernel_cmd_execute);
+        if (status == AGO_ERROR_KERNEL_NOT_IMPLEMENTED)
+            status = VX_ERROR_NOT_IMPLEMENTED;
+    }
+    else if (kernel->kernel_f) {
+        status = kernel->kernel_f(node, (vx_reference *)node->paramList, node->paramCount);
+    }
+    node->status = status;
+    if (status) {
+        return status;
+    }
+    agoPerfCaptureStop(&node->perf);
+    if (profile) agoPerfProfileEntry(graph, ago_profile_type_exec_end, &node->ref);
+    else if (agoTraceIsEnabled()) agoTraceProfileEntry(graph->execFrameCount, ago_profile_type_exec_end, &node->ref, node->perf.end);
+    return status;
+}
+
+static int agoCompleteCpuNode(AgoGraph * graph, AgoNode * node)
+{
+    // mark that node outputs are dirty
+    for (vx_uint32 i = 0; i < node->paramCount; i++) {
+#if ENABLE_OPENCL
+        AgoData * data = node->paramList[i];
+        if (data && data->opencl_buffer &&
+            (node->parameters[i].direction == VX_OUTPUT || node->parameters[i].direction == VX_BIDIRECTIONAL))
+        {
+            auto dataToSync = (data->ref.type == VX_TYPE_IMAGE && data->u.img.isROI) ? data->u.img.roiMasterImage : data;
+            dataToSync->buffer_sync_flags &= ~AGO_BUFFER_SYNC_FLAG_DIRTY_MASK;
+            dataToSync->buffer_sync_flags |=
+                ((node->akernel->opencl_buffer_access_enable || data->u.img.enableUserBufferGPU)
+                    ? AGO_BUFFER_SYNC_FLAG_DIRTY_BY_NODE_CL
+                    : AGO_BUFFER_SYNC_FLAG_DIRTY_BY_NODE);
+        }
+#elif ENABLE_HIP
+        AgoData * data = node->paramList[i];
+        if (data && data->hip_memory &&
+                (node->parameters[i].direction == VX_OUTPUT || node->parameters[i].direction == VX_BIDIRECTIONAL))
+        {
+            auto dataToSync = (data->ref.type == VX_TYPE_IMAGE && data->u.img.isROI) ? data->u.img.roiMasterImage : data;
+            dataToSync->buffer_sync_flags &= ~AGO_BUFFER_SYNC_FLAG_DIRTY_MASK;
+            dataToSync->buffer_sync_flags |=
+                ((node->akernel->opencl_buffer_access_enable || data->u.img.enableUserBufferGPU)
+                    ? AGO_BUFFER_SYNC_FLAG_DIRTY_BY_NODE_CL
+                    : AGO_BUFFER_SYNC_FLAG_DIRTY_BY_NODE);
+        }
+#endif
+    }
+    // node callback
+    if (node->callback) {
+        vx_action action = node->callback(node);
+        if (action == VX_ACTION_ABANDON) {
+            graph->state = VX_GRAPH_STATE_ABANDONED;
+            return VX_ERROR_GRAPH_ABANDONED;
+        }
+    }
+    return VX_SUCCESS;
+}
+
+static bool agoIsCpuNodeParallelizable(AgoNode * node)
+{
+#if (ENABLE_OPENCL||ENABLE_HIP)
+    // nodes that access GPU buffers share the graph command queue
+    if (node->akernel->opencl_buffer_access_enable)
+        return false;
+#endif
+    // bidirectional buffers may be read by other nodes at the same hierarchical level
+    for (vx_uint32 i = 0; i < node->paramCount; i++) {
+        if (node->paramList[i] && node->parameters[i].direction == VX_BIDIRECTIONAL)
+            return false;
+    }
+    return true;
+}
+
+// Marks a graph of the context as executing: agoSetCpuThreadCount doesn't replace the pool while any graph is in this scope.
+class CAgoGraphExecutionScope {
+public:
+    CAgoGraphExecutionScope(AgoContext * context) : m_context{ context } {
+        std::lock_guard<std::mutex> lock(m_context->cpu_thread_pool_lock);
+        m_context->num_executing_graphs++;
+    }
+    ~CAgoGraphExecutionScope() {
+        std::lock_guard<std::mutex> lock(m_context->cpu_thread_pool_lock);
+        m_context->num_executing_graphs--;
+    }
+private:
+    AgoContext * m_context;
+};
+
 int agoExecuteGraph(AgoGraph * graph)
 {
+    CAgoGraphExecutionScope executionScope(graph->ref.context);
     if (graph->detectedInvalidNode) {
         agoAddLogEntry(&graph->ref, VX_FAILURE, "ERROR: agoExecuteGraph: detected invalid node\n");
         return VX_FAILURE;
@@ -2336,145 +2578,70 @@ int agoExecuteGraph(AgoGraph * graph)
             }
         }
 #endif
-        // process CPU nodes at current hierarchical level
-        for (auto node = snode; node != enode; node = node->next) {
-            if (node->attr_affinity.device_type == AGO_KERNEL_FLAG_DEVICE_CPU) {
-#if (ENABLE_OPENCL||ENABLE_HIP)
-                opencl_buffer_access_enable |= (node->akernel->opencl_buffer_access_enable ? true : false);
-                if (!node->akernel->opencl_buffer_access_enable) {
-                    agoPerfProfileEntry(graph, ago_profile_type_wait_begin, &node->ref);
-                    if (nodeLaunchHierarchicalLevel > 0 && nodeLaunchHierarchicalLevel < node->hierarchical_level) {
-                        status = agoWaitForNodesCompletion(graph);
-                        if (status != VX_SUCCESS) {
-                            agoAddLogEntry((vx_reference)graph, VX_FAILURE, "ERROR: agoWaitForNodesCompletion failed (%d:%s)\n", status, agoEnum2Name(status));
-                            return status;
-                        }
-                        nodeLaunchHierarchicalLevel = 0;
-                    }
-                    if(opencl_buffer_access_enable) {
-#if ENABLE_OPENCL
-                        cl_int err = clFinish(graph->opencl_cmdq);
-                        if (err) {
-                            agoAddLogEntry(NULL, VX_FAILURE, "ERROR: clFinish(graph) => %d\n", err);
-                            return VX_FAILURE;
-                        }
-#else
-                        hipError_t err = hipStreamSynchronize(graph->hip_stream0);
-                        if (err) {
-                            agoAddLogEntry(NULL, VX_FAILURE, "ERROR: hipStreamSynchronize(graph) => %d\n", err);
-                            return VX_FAILURE;
-                        }
-#endif
-                        opencl_buffer_access_enable = false;
-                    }
-                    agoPerfProfileEntry(graph, ago_profile_type_wait_end, &node->ref);
-                }
-                agoPerfProfileEntry(graph, ago_profile_type_copy_begin, &node->ref);
-                // make sure that all input buffers are synched
-                if (node->akernel->opencl_buffer_access_enable) {
-                    for (vx_uint32 i = 0; i < node->paramCount; i++) {
-                        AgoData * data = node->paramList[i];
-                        if (data &&
-                            (node->parameters[i].direction == VX_INPUT || node->parameters[i].direction == VX_BIDIRECTIONAL))
-                        {
-                            auto dataToSync = (data->ref.type == VX_TYPE_IMAGE && data->u.img.isROI) ? data->u.img.roiMasterImage : data;
-                            if (dataToSync->buffer_sync_flags & (AGO_BUFFER_SYNC_FLAG_DIRTY_BY_NODE | AGO_BUFFER_SYNC_FLAG_DIRTY_BY_COMMIT) &&
-#if ENABLE_OPENCL
-                            dataToSync->opencl_buffer && !(dataToSync->buffer_sync_flags & AGO_BUFFER_SYNC_FLAG_DIRTY_SYNCHED))
-                            {
-                                status = agoDirective((vx_reference)dataToSync, VX_DIRECTIVE_AMD_COPY_TO_OPENCL);
-                                if(status != VX_SUCCESS) {
-                                    agoAddLogEntry((vx_reference)graph, VX_FAILURE, "ERROR: agoDirective(*,VX_DIRECTIVE_AMD_COPY_TO_OPENCL) failed (%d:%s)\n", status, agoEnum2Name(status));
-                                    return status;
-                                }
-                            }
-#else
-                            dataToSync->hip_memory && !(dataToSync->buffer_sync_flags & AGO_BUFFER_SYNC_FLAG_DIRTY_SYNCHED))
-                            {
-                                status = agoDirective((vx_reference)dataToSync, VX_DIRECTIVE_AMD_COPY_TO_HIPMEM);
-                                if(status != VX_SUCCESS) {
-                                    agoAddLogEntry((vx_reference)graph, VX_FAILURE, "ERROR: agoDirective(*,VX_DIRECTIVE_AMD_COPY_TO_HIPMEM) failed (%d:%s)\n", status, agoEnum2Name(status));
-                                    return status;
-                                }
-                            }
-#endif
-                        }
-                    }
-                }
-                else {
-                    for (vx_uint32 i = 0; i < node->paramCount; i++) {
-                        AgoData * data = node->paramList[i];
-                        if (data && (node->parameters[i].direction == VX_INPUT || node->parameters[i].direction == VX_BIDIRECTIONAL)) {
-                            auto dataToSync = (data->ref.type == VX_TYPE_IMAGE && data->u.img.isROI) ? data->u.img.roiMasterImage : data;
-                            status = agoDataSyncFromGpuToCpu(graph, node, dataToSync);
-                            for (vx_uint32 j = 0; !status && j < dataToSync->numChildren; j++) {
-                                AgoData * jdata = dataToSync->children[j];
-                                if (jdata)
-                                    status = agoDataSyncFromGpuToCpu(graph, node, jdata);
-                            }
-                            if (status) {
-                                agoAddLogEntry((vx_reference)graph, VX_FAILURE, "ERROR: agoDataSyncFromGpuToCpu failed (%d:%s) for node(%s) arg#%d data(%s)\n", status, agoEnum2Name(status), node->akernel->name, i, data->name.c_str());
-                                return status;
-                            }
-                        }
+        // process CPU nodes at current hierarchical level:
+        // with a CPU thread pool, independent nodes are executed concurrently and then
+        // the output dirty flags and callbacks are processed in node order
+        AgoThreadPool * cpu_thread_pool = graph->ref.context->cpu_thread_pool;
+        std::vector<AgoNode *>& cpuNodes = graph->cpu_nodeListParallel;
+        cpuNodes.clear();
+        if (cpu_thread_pool) {
+            for (auto node = snode; node != enode; node = node->next) {
+                if (node->attr_affinity.device_type == AGO_KERNEL_FLAG_DEVICE_CPU) {
+                    if (!agoIsCpuNodeParallelizable(node)) {
+                        cpuNodes.clear();
+                        break;
                     }
+                    cpuNodes.push_back(node);
                 }
-                agoPerfProfileEntry(graph, ago_profile_type_copy_end, &node->ref);
+            }
+        }
+        if (cpuNodes.size() > 1) {
+#if (ENABLE_OPENCL||ENABLE_HIP)
+            for (auto node : cpuNodes) {
+                status = agoPrepareCpuNode(graph, node, nodeLaunchHierarchicalLevel, opencl_buffer_access_enable);
+                if (status != VX_SUCCESS)
+                    return status;
+            }
 #endif
-                // execute node
-                agoPerfProfileEntry(graph, ago_profile_type_exec_begin, &node->ref);
-                agoPerfCaptureStart(&node->perf);
-                AgoKernel * kernel = node->akernel;
-                status = VX_SUCCESS;
-                if (kernel->func) {
-                    status = kernel->func(node, ago_kernel_cmd_execute);
-                    if (status == AGO_ERROR_KERNEL_NOT_IMPLEMENTED)
-                        status = VX_ERROR_NOT_IMPLEMENTED;
-                }
-                else if (kernel->kernel_f) {
-                    status = kernel->kernel_f(node, (vx_reference *)node->paramList, node->paramCount);
-                }
-                if (status) {
-                    agoAddLogEntry((vx_reference)graph, VX_FAILURE, "ERROR: kernel %s exec failed (%d:%s)\n", kernel->name, status, agoEnum2Name(status));
+            std::vector<vx_status>& cpuStatus = graph->cpu_nodeStatusParallel;
+            cpuStatus.assign(cpuNodes.size(), VX_SUCCESS);
+            cpu_thread_pool->parallelFor((vx_uint32)cpuNodes.size(), [graph, &cpuNodes, &cpuStatus](vx_uint32 i) {
+                cpuStatus[i] = agoExecuteCpuNode(graph, cpuNodes[i], false);
+            });
+            for (size_t i = 0; i < cpuNodes.size(); i++) {
+                AgoNode * node = cpuNodes[i];
+                if (cpuStatus[i]) {
+                    agoAddLogEntry((vx_reference)graph, VX_FAILURE, "ERROR: kernel %s exec failed (%d:%s)\n", node->akernel->name, cpuStatus[i], agoEnum2Name(cpuStatus[i]));
+                    return cpuStatus[i];
+                }
+                if (graph->enable_performance_profiling) {
+                    graph->performance_profile.push_back({ graph->execFrameCount, ago_profile_type_exec_begin, &node->ref, (int64_t)node->perf.beg });
+                    graph->performance_profile.push_back({ graph->execFrameCount, ago_profile_type_exec_end, &node->ref, (int64_t)node->perf.end });
+                }
+            }
+            for (auto node : cpuNodes) {
+                status = agoCompleteCpuNode(graph, node);
+                if (status != VX_SUCCESS)
                     return status;
-                }
-                agoPerfCaptureStop(&node->perf);
-                agoPerfProfileEntry(graph, ago_profile_type_exec_end, &node->ref);
-                // mark that node outputs are dirty
-                for (vx_uint32 i = 0; i < node->paramCount; i++) {
-#if ENABLE_OPENCL
-                    AgoData * data = node->paramList[i];
-                    if (data && data->opencl_buffer &&
-                        (node->parameters[i].direction == VX_OUTPUT || node->parameters[i].direction == VX_BIDIRECTIONAL))
-                    {
-                        auto dataToSync = (data->ref.type == VX_TYPE_IMAGE && data->u.img.isROI) ? data->u.img.roiMasterImage : data;
-                        dataToSync->buffer_sync_flags &= ~AGO_BUFFER_SYNC_FLAG_DIRTY_MASK;
-                        dataToSync->buffer_sync_flags |=
-                            ((node->akernel->opencl_buffer_access_enable || data->u.img.enableUserBufferGPU)
-                                ? AGO_BUFFER_SYNC_FLAG_DIRTY_BY_NODE_CL
-                                : AGO_BUFFER_SYNC_FLAG_DIRTY_BY_NODE);
-                    }
-#elif ENABLE_HIP
-                    AgoData * data = node->paramList[i];
-                    if (data && data->hip_memory &&
-                            (node->parameters[i].direction == VX_OUTPUT || node->parameters[i].direction == VX_BIDIRECTIONAL))
-                    {
-                        auto dataToSync = (data->ref.type == VX_TYPE_IMAGE && data->u.img.isROI) ? data->u.img.roiMasterImage : data;
-                        dataToSync->buffer_sync_flags &= ~AGO_BUFFER_SYNC_FLAG_DIRTY_MASK;
-                        dataToSync->buffer_sync_flags |=
-                            ((node->akernel->opencl_buffer_access_enable || data->u.img.enableUserBufferGPU)
-                                ? AGO_BUFFER_SYNC_FLAG_DIRTY_BY_NODE_CL
-                                : AGO_BUFFER_SYNC_FLAG_DIRTY_BY_NODE);
-                    }
+            }
+        }
+        else {
+            for (auto node = snode; node != enode; node = node->next) {
+                if (node->attr_affinity.device_type == AGO_KERNEL_FLAG_DEVICE_CPU) {
+#if (ENABLE_OPENCL||ENABLE_HIP)
+                    status = agoPrepareCpuNode(graph, node, nodeLaunchHierarchicalLevel, opencl_buffer_access_enable);
+                    if (status != VX_SUCCESS)
+                        return status;
 #endif
-                }
-                // node callback
-                if (node->callback) {
-                    vx_action action = node->callback(node);
-                    if (action == VX_ACTION_ABANDON) {
-                        graph->state = VX_GRAPH_STATE_ABANDONED;
-                        return VX_ERROR_GRAPH_ABANDONED;
+                    // execute node
+                    status = agoExecuteCpuNode(graph, node, true);
+                    if (status) {
+                        agoAddLogEntry((vx_reference)graph, VX_FAILURE, "ERROR: kernel %s exec failed (%d:%s)\n", node->akernel->name, status, agoEnum2Name(status));
+                        return status;
                     }
+                    status = agoCompleteCpuNode(graph, node);
+                    if (status != VX_SUCCESS)
+                        return status;
                 }
             }
         }
@@ -2809,6 +2976,13 @@ int agoProcessGraph(AgoGraph * graph)
 {
     vx_status status = VX_ERROR_INVALID_REFERENCE;
     if (agoIsValidGraph(graph)) {
+        if (graph->schedule_mode != VX_GRAPH_SCHEDULE_MODE_NORMAL) {
+            // queued graph parameters: run the enqueued frames and wait for them
+            status = agoGraphPipelineSchedule(graph);
+            if (status == VX_SUCCESS)
+                status = agoGraphPipelineWait(graph);
+            return status;
+        }
         CAgoLock lock(graph->cs);
         // make sure that graph is verified
         status = VX_SUCCESS;
@@ -2819,6 +2993,8 @@ int agoProcessGraph(AgoGraph * graph)
         if (status == VX_SUCCESS) {
             if (graph->verified && graph->isReadyToExecute) {
                 status = agoExecuteGraph(graph);
+                if (!graph->eventList.empty())
+                    agoGraphPostEvents(graph, nullptr, status);
             }
             else {
                 agoAddLogEntry(&graph->ref, VX_FAILURE, "ERROR: agoProcessGraph: not verified (%d) or not ready to execute (%d)\n", graph->verified, graph->isReadyToExecute);
@@ -2835,7 +3011,10 @@ int agoScheduleGraph(AgoGraph * graph)
     if (agoIsValidGraph(graph)) {
         status = VX_SUCCESS;
         graph->threadScheduleCount++;
-        if (graph->hThread) {
+        if (graph->schedule_mode != VX_GRAPH_SCHEDULE_MODE_NORMAL) {
+            status = agoGraphPipelineSchedule(graph);
+        }
+        else if (graph->hThread) {
             if (!graph->verified) {
                 // make sure to verify the graph in master thread
                 CAgoLock lock(graph->cs);
@@ -2861,16 +3040,11 @@ int agoWaitGraph(AgoGraph * graph)
     if (agoIsValidGraph(graph)) {
         status = VX_SUCCESS;
         graph->threadWaitCount++;
+        if (graph->pipeline) // wait for all the frames launched from the queued graph parameters
+            return agoGraphPipelineWait(graph);
         if (graph->threadScheduleCount <= 0) // the graph was never scheduled so return VX_FAILURE
             return VX_FAILURE;
         if (graph->hThread) {
-            graph->threadThreadWaitState = 1;
-            while (graph->threadThreadWaitState == 1) {
-                // wait for the agoGraphThreadFunction to be done
-                std::this_thread::sleep_for(std::chrono::milliseconds(1));
-                // release the semaphore in case the agoScheduleGraph was called before the agoGraphThreadFunction
-                ReleaseSemaphore(graph->hSemToThread, 1, nullptr);
-            }
             while (graph->threadExecuteCount < graph->threadScheduleCount) {
                 if (WaitForSingleObject(graph->hSemFromThread, INFINITE) != WAIT_OBJECT_0) {
                     agoAddLogEntry(&graph->ref, VX_FAILURE, "ERROR: agoWaitGraph: WaitForSingleObject failed\n");
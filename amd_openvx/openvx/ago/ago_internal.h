@@ -28,6 +28,8 @@ THE SOFTWARE.
 #include "ago_kernels.h"
 #include "ago_haf_cpu.h"
 #include "vx_ext_amd.h"
+#include <VX/vx_khr_pipelining.h>
+#include <VX/vx_khr_ix.h>
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // configuration flags and constants
@@ -126,6 +128,9 @@ THE SOFTWARE.
 #define AGO_GRAPH_OPTIMIZER_FLAG_NO_NODE_MERGE            0x00000008 // don't perform node merge
 #define AGO_GRAPH_OPTIMIZER_FLAG_NO_CONVERT_8BIT_TO_1BIT  0x00000010 // don't convert 8-bit images to 1-bit images
 #define AGO_GRAPH_OPTIMIZER_FLAG_NO_SUPERNODE_MERGE       0x00000020 // don't merge supernodes
+#define AGO_GRAPH_OPTIMIZER_FLAG_NO_CPU_BUFFER_ALIAS     0x00000040 // don't share memory between CPU virtual images
+#define AGO_GRAPH_OPTIMIZER_FLAG_NO_POINTWISE_FUSION     0x00000080 // don't fuse chains of pointwise CPU nodes
+#define AGO_GRAPH_OPTIMIZER_FLAG_PREOPTIMIZED             0x00000100 // nodes are already optimized (imported graph snapshot): only allocate
 #define AGO_GRAPH_OPTIMIZER_FLAGS_DEFAULT                 0x00000000 // default options
 
 #if ENABLE_OPENCL
@@ -174,6 +179,17 @@ THE SOFTWARE.
 
 // thread scheduling configuration
 #define CONFIG_THREAD_DEFAULT                 1  // 0:disable 1:enable separate threads for graph scheduling
+#define CONFIG_THREAD_CPU_COUNT_SHIFT         8  // bits[15:8]: number of CPU threads for same-level node execution (0/1: serial)
+#define CONFIG_THREAD_CPU_COUNT_MASK       0xff
+#define CONFIG_THREAD_CPU_MIN_BAND_HEIGHT    64  // minimum number of rows per band when a CPU kernel is split across threads
+
+// graph pipelining configuration (vx_khr_pipelining queueing schedule modes)
+#define CONFIG_GRAPH_PIPELINE_MAX_DEPTH       4  // maximum number of frames of a graph executed concurrently
+
+// pointwise node fusion configuration
+#define CONFIG_FUSED_POINTWISE_MAX_OPS       16  // maximum number of nodes fused into one VX_KERNEL_AMD_FUSED_POINTWISE_DATA_DATA node
+#define CONFIG_FUSED_POINTWISE_MAX_TEMPS      8  // maximum number of intermediate strip buffers of a fused node
+#define CONFIG_FUSED_POINTWISE_STRIP_SIZE (256*1024) // target size of intermediate strip buffers, so that they stay in cache
 
 // module specific
 #define MAX_MODULE_NAME_SIZE 256
@@ -221,6 +237,7 @@ THE SOFTWARE.
 #define AgoNode       _vx_node
 #define AgoParameter  _vx_parameter
 #define AgoMetaFormat _vx_meta_format
+#define AgoImport     _vx_import
 typedef enum {
     ago_kernel_cmd_execute                    =  0,
     ago_kernel_cmd_validate                   =  1,
@@ -475,6 +492,7 @@ struct AgoData {
     vx_uint32 device_type_unused;
     AgoData * alias_data;
     vx_size   alias_offset;
+    struct AgoDataList * ownerList; // list whose name index holds this data (nullptr when not in a list)
 public:
     AgoData();
     ~AgoData();
@@ -484,6 +502,9 @@ struct AgoDataList {
     AgoData * head;
     AgoData * tail;
     AgoData * trash;
+    std::unordered_multimap<std::string, AgoData *> nameIndex; // named data in head..tail
+public:
+    AgoDataList() : count{ 0 }, head{ nullptr }, tail{ nullptr }, trash{ nullptr } { }
 };
 struct AgoMetaFormat {
     // TBD: this data struct needs some cleanup -- just keep only required fields
@@ -586,6 +607,8 @@ struct AgoNode {
     vx_size localDataSize;
     vx_uint8 * localDataPtr;
     vx_uint8 * localDataPtr_allocated;
+    vx_uint8 * bandLocalDataPtr_allocated; // scratch for additional row bands of agoExecuteCpuRowBands
+    vx_uint32 bandLocalDataCount;
     vx_uint32 paramCount;
     AgoData * paramList[AGO_MAX_PARAMS];
     AgoData * paramListForAgeDelay[AGO_MAX_PARAMS];
@@ -645,6 +668,10 @@ struct AgoKernelList {
     vx_uint32 count;
     AgoKernel * head;
     AgoKernel * tail;
+    std::unordered_multimap<std::string, AgoKernel *> nameIndex;
+    std::unordered_multimap<vx_enum, AgoKernel *> enumIndex;
+public:
+    AgoKernelList() : count{ 0 }, head{ nullptr }, tail{ nullptr } { }
 };
 struct AgoNodeList {
     vx_uint32 count;
@@ -652,13 +679,53 @@ struct AgoNodeList {
     AgoNode * tail;
     AgoNode * trash;
 };
+struct AgoGraphQueueSlot {
+    AgoNode * node;             // node that uses a queued graph parameter after optimization
+    vx_uint32 index;            // node parameter index
+    vx_int32 child;             // -1: the queued reference itself, otherwise the index of its child (e.g., image plane)
+};
+struct AgoGraphParameterQueue {
+    vx_uint32 index;            // graph parameter index
+    vx_uint32 refs_list_size;
+    AgoData * data;             // reference bound to the graph parameter when the graph was verified
+    std::vector<AgoData *> refs;
+    std::deque<AgoData *> ready;
+    std::deque<AgoData *> done;
+};
+struct AgoGraphFrame {
+    vx_uint64 seq;
+    std::vector<AgoData *> refs; // one per queued graph parameter
+};
+struct AgoGraphInstance {
+    AgoGraph * graph;           // the graph itself or a replica with its own virtual data and node state
+    std::map<AgoNode *, AgoNode *> nodeMap; // nodes of the original graph to nodes of this instance
+    std::vector<std::vector<AgoGraphQueueSlot>> slots; // per queued graph parameter
+    std::deque<AgoGraphFrame> frames;
+    std::thread thread;
+};
+struct AgoGraphPipeline {
+    std::mutex lock;
+    std::condition_variable cv;
+    std::vector<std::unique_ptr<AgoGraphInstance>> instances;
+    vx_uint64 launchCount;
+    vx_uint64 completeCount;
+    vx_status status;           // first failure since the last vxWaitGraph
+    vx_perf_t perf;
+    bool terminate;
+};
+struct AgoEventRegistration {
+    AgoReference * ref;
+    vx_enum type;
+    vx_uint32 param;
+    vx_uint32 app_value;
+};
 struct AgoGraph {
     AgoReference ref;
     std::string name;
     AgoGraph * next;
     CRITICAL_SECTION cs;
     HANDLE hThread, hSemToThread, hSemFromThread;
-    vx_int32 threadScheduleCount, threadExecuteCount, threadWaitCount, threadThreadTerminationState, threadThreadWaitState;
+    vx_int32 threadScheduleCount, threadExecuteCount, threadWaitCount, threadThreadTerminationState;
     AgoDataList dataList;
     AgoNodeList nodeList;
     vx_bool isReadyToExecute;
@@ -679,6 +746,11 @@ struct AgoGraph {
     bool verified;
     std::vector<vx_parameter> parameters;
     std::vector<AgoData *> autoAgeDelayList;
+    std::vector<AgoNode *> cpu_nodeListParallel;
+    std::vector<vx_status> cpu_nodeStatusParallel;
+    vx_uint8 * cpu_buffer_arena;
+    vx_size cpu_buffer_arena_size;
+    vx_size cpu_buffer_bytes_saved;
 #if (ENABLE_OPENCL||ENABLE_HIP)
     std::vector<AgoNode *> gpu_nodeListQueued;
     AgoSuperNode * supernodeList;
@@ -695,10 +767,18 @@ struct AgoGraph {
     bool enable_performance_profiling;
     std::vector<AgoProfileEntry> performance_profile;
     std::map<std::string,void *> moduleHandle;
+    vx_enum schedule_mode;
+    std::vector<AgoGraphParameterQueue> paramQueues;
+    std::vector<AgoEventRegistration> eventList;
+    AgoGraphPipeline * pipeline;
 public:
     AgoGraph();
     ~AgoGraph();
 };
+struct AgoImport {
+    AgoReference ref;
+    std::vector<AgoReference *> refs; // references of the import, retained until the import is released
+};
 struct AgoGraphList {
     vx_uint32 count;
     AgoGraph * head;
@@ -720,6 +800,35 @@ struct MacroData {
     char * text;
     char * text_allocated;
 };
+class AgoThreadPool {
+public:
+    AgoThreadPool(vx_uint32 numThreads);
+    ~AgoThreadPool();
+    // number of threads executing tasks, including the caller of parallelFor
+    vx_uint32 getThreadCount() const { return (vx_uint32)workers.size() + 1; }
+    // executes func(0..count-1) using all the workers and the calling thread; returns after all tasks are completed
+    void parallelFor(vx_uint32 count, const std::function<void(vx_uint32)>& func);
+private:
+    struct Batch;
+    struct Task {
+        Batch * batch;
+        vx_uint32 index;
+    };
+    struct Worker {
+        std::mutex lock;
+        std::deque<Task> queue;
+        std::thread thread;
+    };
+    bool popTask(int self, Task& task);
+    void runTask(const Task& task);
+    void workerMain(int self);
+    std::vector<std::unique_ptr<Worker>> workers;
+    std::mutex idleLock;
+    std::condition_variable idleCv;
+    std::atomic<vx_int32> pendingCount;
+    std::atomic<vx_uint32> nextVictim;
+    bool terminate;
+};
 struct AgoContext {
     AgoReference ref;
     vx_uint64 perfNormFactor;
@@ -739,6 +848,12 @@ struct AgoContext {
     vx_log_callback_f callback_log;
     vx_bool callback_reentrant;
     vx_uint32 thread_config;
+    vx_uint32 cpu_thread_count;
+    AgoThreadPool * cpu_thread_pool;
+    std::mutex cpu_thread_pool_lock;   // guards cpu_thread_pool replacement against executing graphs
+    vx_uint32 num_executing_graphs;    // graphs in agoExecuteGraph that may use cpu_thread_pool
+    vx_enum cpu_isa;
+    AgoHafCpuDispatch haf_cpu;
     vx_char extensions[256];
     std::vector<ModuleData> modules;
     std::vector<MacroData> macros;
@@ -777,6 +892,11 @@ struct AgoContext {
     vx_size hip_mem_release_count;
 #endif
     AgoTargetAffinityInfo_ attr_affinity;
+    std::mutex event_lock;
+    std::condition_variable event_cv;
+    std::deque<vx_event_t> event_queue;
+    bool event_enabled;
+    std::list<vx_uint8 *> exported_memory_list;
 public:
     AgoContext();
     ~AgoContext();
@@ -821,6 +941,7 @@ int agoShutdownNode(AgoNode * node);
 int agoRemoveData(AgoDataList * list, AgoData * item, AgoData ** trash);
 AgoKernel * agoRemoveKernel(AgoKernelList * list, AgoKernel * item);
 void agoRemoveDataInGraph(AgoGraph * agraph, AgoData * data);
+void agoSetDataName(AgoData * data, const std::string& name);
 void agoReplaceDataInGraph(AgoGraph * agraph, AgoData * dataFind, AgoData * dataReplace);
 void agoResetDataList(AgoDataList * dataList);
 void agoResetNodeList(AgoNodeList * nodeList);
@@ -890,6 +1011,14 @@ void agoPerfCaptureReset(vx_perf_t * perf);
 void agoPerfCaptureStart(vx_perf_t * perf);
 void agoPerfCaptureStop(vx_perf_t * perf);
 void agoPerfCopyNormalize(AgoContext * context, vx_perf_t * perfDst, vx_perf_t * perfSrc);
+// trace
+void agoTraceInitialize();
+vx_status agoTraceOpen(const char * fileName);
+void agoTraceFlush();
+bool agoTraceIsEnabled();
+void agoTraceSetThreadName(const char * name);
+void agoTraceAddEvent(const char * name, const char * category, int64_t begNs, int64_t endNs);
+void agoTraceProfileEntry(vx_uint32 frame, AgoProfileEntryType type, vx_reference ref, int64_t time);
 // log
 void agoRegisterLogCallback(vx_context context, vx_log_callback_f callback, vx_bool reentrant);
 void agoAddLogEntry(AgoReference * ref, vx_status status, const char *message, ...);
@@ -940,6 +1069,10 @@ AgoContext * agoCreateContext();
 AgoGraph * agoCreateGraph(AgoContext * acontext);
 int agoReleaseGraph(AgoGraph * agraph);
 int agoReleaseContext(AgoContext * acontext);
+int agoSetCpuThreadCount(AgoContext * acontext, vx_uint32 count);
+int agoSetCpuIsa(AgoContext * acontext, vx_enum isa);
+int agoExecuteCpuRowBands(AgoNode * node, vx_uint32 height, const std::function<int(vx_uint32 y, vx_uint32 h, vx_uint8 * pLocalData)>& func);
+const char * agoGetFusedPointwiseOpName(vx_enum kernel_id);
 int agoVerifyGraph(AgoGraph * agraph);
 vx_status agoPrepareImageValidRectangleBuffers(AgoGraph * graph);
 vx_status agoComputeImageValidRectangleOutputs(AgoGraph * graph);
@@ -952,6 +1085,24 @@ int agoAgeDelay(AgoData * delay);
 int agoProcessGraph(AgoGraph * agraph);
 int agoScheduleGraph(AgoGraph * agraph);
 int agoWaitGraph(AgoGraph * agraph);
+// graph pipelining and events (vx_khr_pipelining)
+int agoGraphSetScheduleConfig(AgoGraph * graph, vx_enum mode, vx_uint32 count, const vx_graph_parameter_queue_params_t * params);
+int agoGraphPipelinePrepare(AgoGraph * graph);
+int agoGraphPipelineStart(AgoGraph * graph);
+void agoGraphPipelineRelease(AgoGraph * graph);
+int agoGraphPipelineSchedule(AgoGraph * graph);
+int agoGraphPipelineWait(AgoGraph * graph);
+int agoGraphParameterEnqueueReadyRef(AgoGraph * graph, vx_uint32 index, vx_reference * refs, vx_uint32 num_refs);
+int agoGraphParameterDequeueDoneRef(AgoGraph * graph, vx_uint32 index, vx_reference * refs, vx_uint32 max_refs, vx_uint32 * num_refs);
+int agoGraphParameterCheckDoneRef(AgoGraph * graph, vx_uint32 index, vx_uint32 * num_refs);
+int agoRegisterEvent(AgoReference * ref, vx_enum type, vx_uint32 param, vx_uint32 app_value);
+void agoGraphPostEvents(AgoGraph * graph, AgoGraphInstance * instance, vx_status status);
+void agoPostEvent(AgoContext * acontext, vx_enum type, vx_uint32 app_value, const vx_event_info_t& info);
+int agoWaitEvent(AgoContext * acontext, vx_event_t * event, bool do_not_block);
+// graph snapshots (vx_khr_ix)
+int agoExportObjects(AgoContext * context, vx_size numrefs, const vx_reference * refs, const vx_enum * uses, const vx_uint8 ** ptr, vx_size * length);
+int agoReleaseExportedMemory(AgoContext * context, const vx_uint8 * ptr);
+int agoImportObjects(AgoContext * context, vx_size numrefs, vx_reference * refs, const vx_enum * uses, const vx_uint8 * ptr, vx_size length);
 int agoWriteGraph(AgoGraph * agraph, AgoReference * * ref, int num_ref, FILE * fp, const char * comment);
 int agoReadGraph(AgoGraph * agraph, AgoReference * * ref, int num_ref, ago_data_registry_callback_f callback_f, void * callback_obj, FILE * fp, vx_int32 dumpToConsole);
 int agoReadGraphFromString(AgoGraph * agraph, AgoReference * * ref, int num_ref, ago_data_registry_callback_f callback_f, void * callback_obj, char * str, vx_int32 dumpToConsole);
@@ -4467,9 +4467,10 @@ int agoKernel_Add_U8_U8U8_Wrap(AgoNode * node, AgoKernelCommand cmd)
         AgoData * oImg = node->paramList[0];
         AgoData * iImg0 = node->paramList[1];
         AgoData * iImg1 = node->paramList[2];
-        if (HafCpu_Add_U8_U8U8_Wrap(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes, iImg0->buffer, iImg0->u.img.stride_in_bytes, iImg1->buffer, iImg1->u.img.stride_in_bytes)) {
-            status = VX_FAILURE;
-        }
+        status = agoExecuteCpuRowBands(node, oImg->u.img.height, [=](vx_uint32 y, vx_uint32 h, vx_uint8 * pLocalData) {
+            return node->ref.context->haf_cpu.Add_U8_U8U8_Wrap(oImg->u.img.width, h, oImg->buffer + y * oImg->u.img.stride_in_bytes, oImg->u.img.stride_in_bytes,
+                iImg0->buffer + y * iImg0->u.img.stride_in_bytes, iImg0->u.img.stride_in_bytes, iImg1->buffer + y * iImg1->u.img.stride_in_bytes, iImg1->u.img.stride_in_bytes) ? VX_FAILURE : VX_SUCCESS;
+        });
     }
     else if (cmd == ago_kernel_cmd_validate) {
         status = ValidateArguments_Img_1OUT_2IN(node, VX_DF_IMAGE_U8, VX_DF_IMAGE_U8, VX_DF_IMAGE_U8);
@@ -4545,9 +4546,10 @@ int agoKernel_Add_U8_U8U8_Sat(AgoNode * node, AgoKernelCommand cmd)
         AgoData * oImg = node->paramList[0];
         AgoData * iImg0 = node->paramList[1];
         AgoData * iImg1 = node->paramList[2];
-        if (HafCpu_Add_U8_U8U8_Sat(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes, iImg0->buffer, iImg0->u.img.stride_in_bytes, iImg1->buffer, iImg1->u.img.stride_in_bytes)) {
-            status = VX_FAILURE;
-        }
+        status = agoExecuteCpuRowBands(node, oImg->u.img.height, [=](vx_uint32 y, vx_uint32 h, vx_uint8 * pLocalData) {
+            return node->ref.context->haf_cpu.Add_U8_U8U8_Sat(oImg->u.img.width, h, oImg->buffer + y * oImg->u.img.stride_in_bytes, oImg->u.img.stride_in_bytes,
+                iImg0->buffer + y * iImg0->u.img.stride_in_bytes, iImg0->u.img.stride_in_bytes, iImg1->buffer + y * iImg1->u.img.stride_in_bytes, iImg1->u.img.stride_in_bytes) ? VX_FAILURE : VX_SUCCESS;
+        });
     }
     else if (cmd == ago_kernel_cmd_validate) {
         status = ValidateArguments_Img_1OUT_2IN(node, VX_DF_IMAGE_U8, VX_DF_IMAGE_U8, VX_DF_IMAGE_U8);
@@ -4617,9 +4619,10 @@ int agoKernel_Sub_U8_U8U8_Wrap(AgoNode * node, AgoKernelCommand cmd)
         AgoData * oImg = node->paramList[0];
         AgoData * iImg0 = node->paramList[1];
         AgoData * iImg1 = node->paramList[2];
-        if (HafCpu_Sub_U8_U8U8_Wrap(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes, iImg0->buffer, iImg0->u.img.stride_in_bytes, iImg1->buffer, iImg1->u.img.stride_in_bytes)) {
-            status = VX_FAILURE;
-        }
+        status = agoExecuteCpuRowBands(node, oImg->u.img.height, [=](vx_uint32 y, vx_uint32 h, vx_uint8 * pLocalData) {
+            return node->ref.context->haf_cpu.Sub_U8_U8U8_Wrap(oImg->u.img.width, h, oImg->buffer + y * oImg->u.img.stride_in_bytes, oImg->u.img.stride_in_bytes,
+                iImg0->buffer + y * iImg0->u.img.stride_in_bytes, iImg0->u.img.stride_in_bytes, iImg1->buffer + y * iImg1->u.img.stride_in_bytes, iImg1->u.img.stride_in_bytes) ? VX_FAILURE : VX_SUCCESS;
+        });
     }
     else if (cmd == ago_kernel_cmd_validate) {
         status = ValidateArguments_Img_1OUT_2IN(node, VX_DF_IMAGE_U8, VX_DF_IMAGE_U8, VX_DF_IMAGE_U8);
@@ -4695,9 +4698,10 @@ int agoKernel_Sub_U8_U8U8_Sat(AgoNode * node, AgoKernelCommand cmd)
         AgoData * oImg = node->paramList[0];
         AgoData * iImg0 = node->paramList[1];
         AgoData * iImg1 = node->paramList[2];
-        if (HafCpu_Sub_U8_U8U8_Sat(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes, iImg0->buffer, iImg0->u.img.stride_in_bytes, iImg1->buffer, iImg1->u.img.stride_in_bytes)) {
-            status = VX_FAILURE;
-        }
+        status = agoExecuteCpuRowBands(node, oImg->u.img.height, [=](vx_uint32 y, vx_uint32 h, vx_uint8 * pLocalData) {
+            return node->ref.context->haf_cpu.Sub_U8_U8U8_Sat(oImg->u.img.width, h, oImg->buffer + y * oImg->u.img.stride_in_bytes, oImg->u.img.stride_in_bytes,
+                iImg0->buffer + y * iImg0->u.img.stride_in_bytes, iImg0->u.img.stride_in_bytes, iImg1->buffer + y * iImg1->u.img.stride_in_bytes, iImg1->u.img.stride_in_bytes) ? VX_FAILURE : VX_SUCCESS;
+        });
     }
     else if (cmd == ago_kernel_cmd_validate) {
         status = ValidateArguments_Img_1OUT_2IN(node, VX_DF_IMAGE_U8, VX_DF_IMAGE_U8, VX_DF_IMAGE_U8);
@@ -8101,9 +8105,10 @@ int agoKernel_AbsDiff_U8_U8U8(AgoNode * node, AgoKernelCommand cmd)
         AgoData * oImg = node->paramList[0];
         AgoData * iImg0 = node->paramList[1];
         AgoData * iImg1 = node->paramList[2];
-        if (HafCpu_AbsDiff_U8_U8U8(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes, iImg0->buffer, iImg0->u.img.stride_in_bytes, iImg1->buffer, iImg1->u.img.stride_in_bytes)) {
-            status = VX_FAILURE;
-        }
+        status = agoExecuteCpuRowBands(node, oImg->u.img.height, [=](vx_uint32 y, vx_uint32 h, vx_uint8 * pLocalData) {
+            return node->ref.context->haf_cpu.AbsDiff_U8_U8U8(oImg->u.img.width, h, oImg->buffer + y * oImg->u.img.stride_in_bytes, oImg->u.img.stride_in_bytes,
+                iImg0->buffer + y * iImg0->u.img.stride_in_bytes, iImg0->u.img.stride_in_bytes, iImg1->buffer + y * iImg1->u.img.stride_in_bytes, iImg1->u.img.stride_in_bytes) ? VX_FAILURE : VX_SUCCESS;
+        });
     }
     else if (cmd == ago_kernel_cmd_validate) {
         status = ValidateArguments_Img_1OUT_2IN(node, VX_DF_IMAGE_U8, VX_DF_IMAGE_U8, VX_DF_IMAGE_U8);
@@ -12271,11 +12276,10 @@ int agoKernel_ColorConvert_RGB_RGBX(AgoNode * node, AgoKernelCommand cmd)
         status = VX_SUCCESS;
         AgoData * oImg = node->paramList[0];
         AgoData * iImg = node->paramList[1];
-        if (HafCpu_ColorConvert_RGB_RGBX(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes,
-                                         iImg->buffer, iImg->u.img.stride_in_bytes))
-        {
-            status = VX_FAILURE;
-        }
+        status = agoExecuteCpuRowBands(node, oImg->u.img.height, [=](vx_uint32 y, vx_uint32 h, vx_uint8 * pLocalData) {
+            return node->ref.context->haf_cpu.ColorConvert_RGB_RGBX(oImg->u.img.width, h, oImg->buffer + y * oImg->u.img.stride_in_bytes, oImg->u.img.stride_in_bytes,
+                                           iImg->buffer + y * iImg->u.img.stride_in_bytes, iImg->u.img.stride_in_bytes) ? VX_FAILURE : VX_SUCCESS;
+        });
     }
     else if (cmd == ago_kernel_cmd_validate) {
         status = ValidateArguments_Img_1OUT_1IN(node, VX_DF_IMAGE_RGB, VX_DF_IMAGE_RGBX);
@@ -12458,12 +12462,12 @@ int agoKernel_ColorConvert_RGB_IYUV(AgoNode * node, AgoKernelCommand cmd)
         AgoData * iImg1 = node->paramList[1];
         AgoData * iImg2 = node->paramList[2];
         AgoData * iImg3 = node->paramList[3];
-        if (HafCpu_ColorConvert_RGB_IYUV(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes,
-                                         iImg1->buffer, iImg1->u.img.stride_in_bytes, iImg2->buffer, iImg2->u.img.stride_in_bytes,
-                                         iImg3->buffer, iImg3->u.img.stride_in_bytes))
-        {
-            status = VX_FAILURE;
-        }
+        status = agoExecuteCpuRowBands(node, oImg->u.img.height, [=](vx_uint32 y, vx_uint32 h, vx_uint8 * pLocalData) {
+            return HafCpu_ColorConvert_RGB_IYUV(oImg->u.img.width, h, oImg->buffer + y * oImg->u.img.stride_in_bytes, oImg->u.img.stride_in_bytes,
+                                                iImg1->buffer + y * iImg1->u.img.stride_in_bytes, iImg1->u.img.stride_in_bytes,
+                                                iImg2->buffer + (y >> 1) * iImg2->u.img.stride_in_bytes, iImg2->u.img.stride_in_bytes,
+                                                iImg3->buffer + (y >> 1) * iImg3->u.img.stride_in_bytes, iImg3->u.img.stride_in_bytes) ? VX_FAILURE : VX_SUCCESS;
+        });
     }
     else if (cmd == ago_kernel_cmd_validate) {
         // validate parameters
@@ -12533,11 +12537,11 @@ int agoKernel_ColorConvert_RGB_NV12(AgoNode * node, AgoKernelCommand cmd)
         AgoData * oImg = node->paramList[0];
         AgoData * iImg1 = node->paramList[1];
         AgoData * iImg2 = node->paramList[2];
-        if (HafCpu_ColorConvert_RGB_NV12(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes,
-                                         iImg1->buffer, iImg1->u.img.stride_in_bytes, iImg2->buffer, iImg2->u.img.stride_in_bytes))
-        {
-            status = VX_FAILURE;
-        }
+        status = agoExecuteCpuRowBands(node, oImg->u.img.height, [=](vx_uint32 y, vx_uint32 h, vx_uint8 * pLocalData) {
+            return HafCpu_ColorConvert_RGB_NV12(oImg->u.img.width, h, oImg->buffer + y * oImg->u.img.stride_in_bytes, oImg->u.img.stride_in_bytes,
+                                                iImg1->buffer + y * iImg1->u.img.stride_in_bytes, iImg1->u.img.stride_in_bytes,
+                                                iImg2->buffer + (y >> 1) * iImg2->u.img.stride_in_bytes, iImg2->u.img.stride_in_bytes) ? VX_FAILURE : VX_SUCCESS;
+        });
     }
     else if (cmd == ago_kernel_cmd_validate) {
         // validate parameters
@@ -12676,11 +12680,10 @@ int agoKernel_ColorConvert_RGBX_RGB(AgoNode * node, AgoKernelCommand cmd)
         status = VX_SUCCESS;
         AgoData * oImg = node->paramList[0];
         AgoData * iImg = node->paramList[1];
-        if (HafCpu_ColorConvert_RGBX_RGB(oImg->u.img.width, oImg->u.img.height, oImg->buffer, oImg->u.img.stride_in_bytes,
-                                         iImg->buffer, iImg->u.img.stride_in_bytes))
-        {
-            status = VX_FAILURE;
-        }
+        status = agoExecuteCpuRowBands(node, oImg->u.img.height, [=](vx_uint32 y, vx_uint32 h, vx_uint8 * pLocalData) {
+            return node->ref.context->haf_cpu.ColorConvert_RGBX_RGB(oImg->u.img.width, h, oImg->buffer + y * oImg->u.img.stride_in_bytes, oImg->u.img.stride_in_bytes,
+                                           iImg->buffer + y * iImg->u.img.stride_in_bytes, iImg->u.img.stride_in_bytes) ? VX_FAILURE : VX_SUCCESS;
+        });
     }
     else if (cmd == ago_kernel_cmd_validate) {
         status = ValidateArguments_Img_1OUT_1IN(node, VX_DF_IMAGE_RGBX, VX_DF_IMAGE_RGB);
@@ -13453,12 +13456,12 @@ int agoKernel_ColorConvert_IYUV_RGB(AgoNode * node, AgoKernelCommand cmd)
         AgoData * oImgU = node->paramList[1];
         AgoData * oImgV = node->paramList[2];
         AgoData * iImg = node->paramList[3];
-        if (HafCpu_ColorConvert_IYUV_RGB(oImgY->u.img.width, oImgY->u.img.height, oImgY->buffer, oImgY->u.img.stride_in_bytes,
-                                         oImgU->buffer, oImgU->u.img.stride_in_bytes, oImgV->buffer, oImgV->u.img.stride_in_bytes,
-                                         iImg->buffer, iImg->u.img.stride_in_bytes))
-        {
-            status = VX_FAILURE;
-        }
+        status = agoExecuteCpuRowBands(node, oImgY->u.img.height, [=](vx_uint32 y, vx_uint32 h, vx_uint8 * pLocalData) {
+            return HafCpu_ColorConvert_IYUV_RGB(oImgY->u.img.width, h, oImgY->buffer + y * oImgY->u.img.stride_in_bytes, oImgY->u.img.stride_in_bytes,
+                                                oImgU->buffer + (y >> 1) * oImgU->u.img.stride_in_bytes, oImgU->u.img.stride_in_bytes,
+                                                oImgV->buffer + (y >> 1) * oImgV->u.img.stride_in_bytes, oImgV->u.img.stride_in_bytes,
+                                                iImg->buffer + y * iImg->u.img.stride_in_bytes, iImg->u.img.stride_in_bytes) ? VX_FAILURE : VX_SUCCESS;
+        });
     }
     else if (cmd == ago_kernel_cmd_validate) {
         // validate parameters
@@ -15037,10 +15040,10 @@ int agoKernel_Box_U8_U8_3x3(AgoNode * node, AgoKernelCommand cmd)
         status = VX_SUCCESS;
         AgoData * oImg = node->paramList[0];
         AgoData * iImg = node->paramList[1];
-        if (HafCpu_Box_U8_U8_3x3(oImg->u.img.width, oImg->u.img.height - 2, oImg->buffer + oImg->u.img.stride_in_bytes, oImg->u.img.stride_in_bytes,
-            iImg->buffer + iImg->u.img.stride_in_bytes, iImg->u.img.stride_in_bytes, node->localDataPtr)) {
-            status = VX_FAILURE;
-        }
+        status = agoExecuteCpuRowBands(node, oImg->u.img.height - 2, [=](vx_uint32 y, vx_uint32 h, vx_uint8 * pLocalData) {
+            return node->ref.context->haf_cpu.Box_U8_U8_3x3(oImg->u.img.width, h, oImg->buffer + (y + 1) * oImg->u.img.stride_in_bytes, oImg->u.img.stride_in_bytes,
+                iImg->buffer + (y + 1) * iImg->u.img.stride_in_bytes, iImg->u.img.stride_in_bytes, pLocalData) ? VX_FAILURE : VX_SUCCESS;
+        });
     }
     else if (cmd == ago_kernel_cmd_validate) {
         status = ValidateArguments_Img_1OUT_1IN(node, VX_DF_IMAGE_U8, VX_DF_IMAGE_U8, true, 1, 1);
@@ -15104,10 +15107,10 @@ int agoKernel_Dilate_U8_U8_3x3(AgoNode * node, AgoKernelCommand cmd)
         status = VX_SUCCESS;
         AgoData * oImg = node->paramList[0];
         AgoData * iImg = node->paramList[1];
-        if (HafCpu_Dilate_U8_U8_3x3(oImg->u.img.width, oImg->u.img.height - 2, oImg->buffer + oImg->u.img.stride_in_bytes, oImg->u.img.stride_in_bytes,
-            iImg->buffer + iImg->u.img.stride_in_bytes, iImg->u.img.stride_in_bytes)) {
-            status = VX_FAILURE;
-        }
+        status = agoExecuteCpuRowBands(node, oImg->u.img.height - 2, [=](vx_uint32 y, vx_uint32 h, vx_uint8 * pLocalData) {
+            return HafCpu_Dilate_U8_U8_3x3(oImg->u.img.width, h, oImg->buffer + (y + 1) * oImg->u.img.stride_in_bytes, oImg->u.img.stride_in_bytes,
+                iImg->buffer + (y + 1) * iImg->u.img.stride_in_bytes, iImg->u.img.stride_in_bytes) ? VX_FAILURE : VX_SUCCESS;
+        });
     }
     else if (cmd == ago_kernel_cmd_validate) {
         status = ValidateArguments_Img_1OUT_1IN(node, VX_DF_IMAGE_U8, VX_DF_IMAGE_U8, true, 1, 1);
@@ -15162,10 +15165,10 @@ int agoKernel_Erode_U8_U8_3x3(AgoNode * node, AgoKernelCommand cmd)
         status = VX_SUCCESS;
         AgoData * oImg = node->paramList[0];
         AgoData * iImg = node->paramList[1];
-        if (HafCpu_Erode_U8_U8_3x3(oImg->u.img.width, oImg->u.img.height - 2, oImg->buffer + oImg->u.img.stride_in_bytes, oImg->u.img.stride_in_bytes,
-            iImg->buffer + iImg->u.img.stride_in_bytes, iImg->u.img.stride_in_bytes)) {
-            status = VX_FAILURE;
-        }
+        status = agoExecuteCpuRowBands(node, oImg->u.img.height - 2, [=](vx_uint32 y, vx_uint32 h, vx_uint8 * pLocalData) {
+            return HafCpu_Erode_U8_U8_3x3(oImg->u.img.width, h, oImg->buffer + (y + 1) * oImg->u.img.stride_in_bytes, oImg->u.img.stride_in_bytes,
+                iImg->buffer + (y + 1) * iImg->u.img.stride_in_bytes, iImg->u.img.stride_in_bytes) ? VX_FAILURE : VX_SUCCESS;
+        });
     }
     else if (cmd == ago_kernel_cmd_validate) {
         status = ValidateArguments_Img_1OUT_1IN(node, VX_DF_IMAGE_U8, VX_DF_IMAGE_U8, true, 1, 1);
@@ -15220,10 +15223,10 @@ int agoKernel_Median_U8_U8_3x3(AgoNode * node, AgoKernelCommand cmd)
         status = VX_SUCCESS;
         AgoData * oImg = node->paramList[0];
         AgoData * iImg = node->paramList[1];
-        if (HafCpu_Median_U8_U8_3x3(oImg->u.img.width, oImg->u.img.height - 2, oImg->buffer + oImg->u.img.stride_in_bytes, oImg->u.img.stride_in_bytes,
-            iImg->buffer + iImg->u.img.stride_in_bytes, iImg->u.img.stride_in_bytes)) {
-            status = VX_FAILURE;
-        }
+        status = agoExecuteCpuRowBands(node, oImg->u.img.height - 2, [=](vx_uint32 y, vx_uint32 h, vx_uint8 * pLocalData) {
+            return HafCpu_Median_U8_U8_3x3(oImg->u.img.width, h, oImg->buffer + (y + 1) * oImg->u.img.stride_in_bytes, oImg->u.img.stride_in_bytes,
+                iImg->buffer + (y + 1) * iImg->u.img.stride_in_bytes, iImg->u.img.stride_in_bytes) ? VX_FAILURE : VX_SUCCESS;
+        });
     }
     else if (cmd == ago_kernel_cmd_validate) {
         status = ValidateArguments_Img_1OUT_1IN(node, VX_DF_IMAGE_U8, VX_DF_IMAGE_U8, true, 1, 1);
@@ -15278,10 +15281,10 @@ int agoKernel_Gaussian_U8_U8_3x3(AgoNode * node, AgoKernelCommand cmd)
         status = VX_SUCCESS;
         AgoData * oImg = node->paramList[0];
         AgoData * iImg = node->paramList[1];
-        if (HafCpu_Gaussian_U8_U8_3x3(oImg->u.img.width, oImg->u.img.height - 2, oImg->buffer + oImg->u.img.stride_in_bytes, oImg->u.img.stride_in_bytes,
-            iImg->buffer + iImg->u.img.stride_in_bytes, iImg->u.img.stride_in_bytes, node->localDataPtr)) {
-            status = VX_FAILURE;
-        }
+        status = agoExecuteCpuRowBands(node, oImg->u.img.height - 2, [=](vx_uint32 y, vx_uint32 h, vx_uint8 * pLocalData) {
+            return node->ref.context->haf_cpu.Gaussian_U8_U8_3x3(oImg->u.img.width, h, oImg->buffer + (y + 1) * oImg->u.img.stride_in_bytes, oImg->u.img.stride_in_bytes,
+                iImg->buffer + (y + 1) * iImg->u.img.stride_in_bytes, iImg->u.img.stride_in_bytes, pLocalData) ? VX_FAILURE : VX_SUCCESS;
+        });
     }
     else if (cmd == ago_kernel_cmd_validate) {
         status = ValidateArguments_Img_1OUT_1IN(node, VX_DF_IMAGE_U8, VX_DF_IMAGE_U8, true, 1, 1);
@@ -16114,13 +16117,12 @@ int agoKernel_Sobel_S16S16_U8_3x3_GXY(AgoNode * node, AgoKernelCommand cmd)
         AgoData * oImg1 = node->paramList[0];
         AgoData * oImg2 = node->paramList[1];
         AgoData * iImg = node->paramList[2];
-        if (HafCpu_Sobel_S16S16_U8_3x3_GXY(oImg1->u.img.width, oImg1->u.img.height - 2,
-            (vx_int16 *)(oImg1->buffer + oImg1->u.img.stride_in_bytes), oImg1->u.img.stride_in_bytes,
-            (vx_int16 *)(oImg2->buffer + oImg2->u.img.stride_in_bytes), oImg2->u.img.stride_in_bytes,
-            iImg->buffer + iImg->u.img.stride_in_bytes, iImg->u.img.stride_in_bytes, node->localDataPtr))
-        {
-            status = VX_FAILURE;
-        }
+        status = agoExecuteCpuRowBands(node, oImg1->u.img.height - 2, [=](vx_uint32 y, vx_uint32 h, vx_uint8 * pLocalData) {
+            return node->ref.context->haf_cpu.Sobel_S16S16_U8_3x3_GXY(oImg1->u.img.width, h,
+                (vx_int16 *)(oImg1->buffer + (y + 1) * oImg1->u.img.stride_in_bytes), oImg1->u.img.stride_in_bytes,
+                (vx_int16 *)(oImg2->buffer + (y + 1) * oImg2->u.img.stride_in_bytes), oImg2->u.img.stride_in_bytes,
+                iImg->buffer + (y + 1) * iImg->u.img.stride_in_bytes, iImg->u.img.stride_in_bytes, pLocalData) ? VX_FAILURE : VX_SUCCESS;
+        });
     }
     else if (cmd == ago_kernel_cmd_validate) {
         status = ValidateArguments_Img_2OUT_1IN(node, VX_DF_IMAGE_S16, VX_DF_IMAGE_S16, VX_DF_IMAGE_U8, true, 1, 1);
@@ -22618,4 +22620,457 @@ int agoKernel_LaplacianReconstruct_DATA_DATA_DATA(AgoNode * node, AgoKernelComma
         status = VX_SUCCESS;
     }
     return status;
-}
\ No newline at end of file
+}
+///////////////////////////////////////////////////////////////////////////////
+// pointwise kernels that can be fused into VX_KERNEL_AMD_FUSED_POINTWISE_DATA_DATA by agoOptimizeDramaMerge:
+// the fused node gets the list of operations as a string "Kernel(arg,...);Kernel(arg,...)" where each arg is
+// either a parameter index of the fused node or "t<n>" for an intermediate image kept in a strip buffer
+typedef int(*AgoFusedPointwiseOpFunc)(AgoContext * context, vx_uint32 width, vx_uint32 height, vx_uint8 ** ptr, vx_uint32 * stride, AgoData ** data);
+
+#define FUSED_OP_1IN(name,tOut,tIn) \
+static int agoFusedPointwiseOp_ ## name(AgoContext * context, vx_uint32 width, vx_uint32 height, vx_uint8 ** ptr, vx_uint32 * stride, AgoData ** data) \
+{ \
+    return HafCpu_ ## name(width, height, (tOut *)ptr[0], stride[0], (tIn *)ptr[1], stride[1]); \
+}
+#define FUSED_OP_2IN(name,tOut,tIn1,tIn2) \
+static int agoFusedPointwiseOp_ ## name(AgoContext * context, vx_uint32 width, vx_uint32 height, vx_uint8 ** ptr, vx_uint32 * stride, AgoData ** data) \
+{ \
+    return HafCpu_ ## name(width, height, (tOut *)ptr[0], stride[0], (tIn1 *)ptr[1], stride[1], (tIn2 *)ptr[2], stride[2]); \
+}
+#define FUSED_OP_2IN_DISPATCH(name) \
+static int agoFusedPointwiseOp_ ## name(AgoContext * context, vx_uint32 width, vx_uint32 height, vx_uint8 ** ptr, vx_uint32 * stride, AgoData ** data) \
+{ \
+    return context->haf_cpu.name(width, height, ptr[0], stride[0], ptr[1], stride[1], ptr[2], stride[2]); \
+}
+#define FUSED_OP_1IN_DISPATCH(name) \
+static int agoFusedPointwiseOp_ ## name(AgoContext * context, vx_uint32 width, vx_uint32 height, vx_uint8 ** ptr, vx_uint32 * stride, AgoData ** data) \
+{ \
+    return context->haf_cpu.name(width, height, ptr[0], stride[0], ptr[1], stride[1]); \
+}
+#define FUSED_OP_1IN_SHIFT(name,tOut,tIn) \
+static int agoFusedPointwiseOp_ ## name(AgoContext * context, vx_uint32 width, vx_uint32 height, vx_uint8 ** ptr, vx_uint32 * stride, AgoData ** data) \
+{ \
+    return HafCpu_ ## name(width, height, (tOut *)ptr[0], stride[0], (tIn *)ptr[1], stride[1], data[2]->u.scalar.u.i); \
+}
+#define FUSED_OP_2IN_SCALE(name,tOut,tIn1,tIn2) \
+static int agoFusedPointwiseOp_ ## name(AgoContext * context, vx_uint32 width, vx_uint32 height, vx_uint8 ** ptr, vx_uint32 * stride, AgoData ** data) \
+{ \
+    return HafCpu_ ## name(width, height, (tOut *)ptr[0], stride[0], (tIn1 *)ptr[1], stride[1], (tIn2 *)ptr[2], stride[2], data[3]->u.scalar.u.f); \
+}
+
+FUSED_OP_2IN_DISPATCH(Add_U8_U8U8_Wrap)
+FUSED_OP_2IN_DISPATCH(Add_U8_U8U8_Sat)
+FUSED_OP_2IN_DISPATCH(Sub_U8_U8U8_Wrap)
+FUSED_OP_2IN_DISPATCH(Sub_U8_U8U8_Sat)
+FUSED_OP_2IN_DISPATCH(AbsDiff_U8_U8U8)
+FUSED_OP_2IN_SCALE(Mul_U8_U8U8_Wrap_Trunc, vx_uint8, vx_uint8, vx_uint8)
+FUSED_OP_2IN_SCALE(Mul_U8_U8U8_Wrap_Round, vx_uint8, vx_uint8, vx_uint8)
+FUSED_OP_2IN_SCALE(Mul_U8_U8U8_Sat_Trunc, vx_uint8, vx_uint8, vx_uint8)
+FUSED_OP_2IN_SCALE(Mul_U8_U8U8_Sat_Round, vx_uint8, vx_uint8, vx_uint8)
+FUSED_OP_2IN(And_U8_U8U8, vx_uint8, vx_uint8, vx_uint8)
+FUSED_OP_2IN(Or_U8_U8U8, vx_uint8, vx_uint8, vx_uint8)
+FUSED_OP_2IN(Xor_U8_U8U8, vx_uint8, vx_uint8, vx_uint8)
+FUSED_OP_2IN(Nand_U8_U8U8, vx_uint8, vx_uint8, vx_uint8)
+FUSED_OP_2IN(Nor_U8_U8U8, vx_uint8, vx_uint8, vx_uint8)
+FUSED_OP_2IN(Xnor_U8_U8U8, vx_uint8, vx_uint8, vx_uint8)
+FUSED_OP_1IN(Not_U8_U8, vx_uint8, vx_uint8)
+FUSED_OP_2IN(Add_S16_U8U8, vx_int16, vx_uint8, vx_uint8)
+FUSED_OP_2IN(Sub_S16_U8U8, vx_int16, vx_uint8, vx_uint8)
+FUSED_OP_2IN_SCALE(Mul_S16_U8U8_Wrap_Trunc, vx_int16, vx_uint8, vx_uint8)
+FUSED_OP_2IN_SCALE(Mul_S16_U8U8_Wrap_Round, vx_int16, vx_uint8, vx_uint8)
+FUSED_OP_2IN_SCALE(Mul_S16_U8U8_Sat_Trunc, vx_int16, vx_uint8, vx_uint8)
+FUSED_OP_2IN_SCALE(Mul_S16_U8U8_Sat_Round, vx_int16, vx_uint8, vx_uint8)
+FUSED_OP_2IN(Add_S16_S16U8_Wrap, vx_int16, vx_int16, vx_uint8)
+FUSED_OP_2IN(Add_S16_S16U8_Sat, vx_int16, vx_int16, vx_uint8)
+FUSED_OP_2IN(Sub_S16_S16U8_Wrap, vx_int16, vx_int16, vx_uint8)
+FUSED_OP_2IN(Sub_S16_S16U8_Sat, vx_int16, vx_int16, vx_uint8)
+FUSED_OP_2IN_SCALE(Mul_S16_S16U8_Wrap_Trunc, vx_int16, vx_int16, vx_uint8)
+FUSED_OP_2IN_SCALE(Mul_S16_S16U8_Wrap_Round, vx_int16, vx_int16, vx_uint8)
+FUSED_OP_2IN_SCALE(Mul_S16_S16U8_Sat_Trunc, vx_int16, vx_int16, vx_uint8)
+FUSED_OP_2IN_SCALE(Mul_S16_S16U8_Sat_Round, vx_int16, vx_int16, vx_uint8)
+FUSED_OP_2IN(Sub_S16_U8S16_Wrap, vx_int16, vx_uint8, vx_int16)
+FUSED_OP_2IN(Sub_S16_U8S16_Sat, vx_int16, vx_uint8, vx_int16)
+FUSED_OP_2IN(AbsDiff_S16_S16S16_Sat, vx_int16, vx_int16, vx_int16)
+FUSED_OP_2IN(Add_S16_S16S16_Wrap, vx_int16, vx_int16, vx_int16)
+FUSED_OP_2IN(Add_S16_S16S16_Sat, vx_int16, vx_int16, vx_int16)
+FUSED_OP_2IN(Sub_S16_S16S16_Wrap, vx_int16, vx_int16, vx_int16)
+FUSED_OP_2IN(Sub_S16_S16S16_Sat, vx_int16, vx_int16, vx_int16)
+FUSED_OP_2IN_SCALE(Mul_S16_S16S16_Wrap_Trunc, vx_int16, vx_int16, vx_int16)
+FUSED_OP_2IN_SCALE(Mul_S16_S16S16_Wrap_Round, vx_int16, vx_int16, vx_int16)
+FUSED_OP_2IN_SCALE(Mul_S16_S16S16_Sat_Trunc, vx_int16, vx_int16, vx_int16)
+FUSED_OP_2IN_SCALE(Mul_S16_S16S16_Sat_Round, vx_int16, vx_int16, vx_int16)
+FUSED_OP_2IN(Magnitude_S16_S16S16, vx_int16, vx_int16, vx_int16)
+FUSED_OP_2IN(Phase_U8_S16S16, vx_uint8, vx_int16, vx_int16)
+FUSED_OP_1IN_SHIFT(ColorDepth_U8_S16_Wrap, vx_uint8, vx_int16)
+FUSED_OP_1IN_SHIFT(ColorDepth_U8_S16_Sat, vx_uint8, vx_int16)
+FUSED_OP_1IN_SHIFT(ColorDepth_S16_U8, vx_int16, vx_uint8)
+FUSED_OP_1IN(ChannelCopy_U8_U8, vx_uint8, vx_uint8)
+FUSED_OP_1IN(ChannelExtract_U8_U16_Pos0, vx_uint8, vx_uint8)
+FUSED_OP_1IN(ChannelExtract_U8_U16_Pos1, vx_uint8, vx_uint8)
+FUSED_OP_1IN(ChannelExtract_U8_U24_Pos0, vx_uint8, vx_uint8)
+FUSED_OP_1IN(ChannelExtract_U8_U24_Pos1, vx_uint8, vx_uint8)
+FUSED_OP_1IN(ChannelExtract_U8_U24_Pos2, vx_uint8, vx_uint8)
+FUSED_OP_1IN(ChannelExtract_U8_U32_Pos0, vx_uint8, vx_uint8)
+FUSED_OP_1IN(ChannelExtract_U8_U32_Pos1, vx_uint8, vx_uint8)
+FUSED_OP_1IN(ChannelExtract_U8_U32_Pos2, vx_uint8, vx_uint8)
+FUSED_OP_1IN(ChannelExtract_U8_U32_Pos3, vx_uint8, vx_uint8)
+FUSED_OP_2IN(ChannelCombine_U16_U8U8, vx_uint8, vx_uint8, vx_uint8)
+FUSED_OP_1IN_DISPATCH(ColorConvert_RGB_RGBX)
+FUSED_OP_1IN_DISPATCH(ColorConvert_RGBX_RGB)
+
+static int agoFusedPointwiseOp_Lut_U8_U8(AgoContext * context, vx_uint32 width, vx_uint32 height, vx_uint8 ** ptr, vx_uint32 * stride, AgoData ** data)
+{
+    return HafCpu_Lut_U8_U8(width, height, ptr[0], stride[0], ptr[1], stride[1], data[2]->buffer);
+}
+
+static int agoFusedPointwiseOp_ChannelCombine_U24_U8U8U8_RGB(AgoContext * context, vx_uint32 width, vx_uint32 height, vx_uint8 ** ptr, vx_uint32 * stride, AgoData ** data)
+{
+    return HafCpu_ChannelCombine_U24_U8U8U8_RGB(width, height, ptr[0], stride[0], ptr[1], stride[1], ptr[2], stride[2], ptr[3], stride[3]);
+}
+
+static int agoFusedPointwiseOp_ChannelCombine_U32_U8U8U8U8_RGBX(AgoContext * context, vx_uint32 width, vx_uint32 height, vx_uint8 ** ptr, vx_uint32 * stride, AgoData ** data)
+{
+    return HafCpu_ChannelCombine_U32_U8U8U8U8_RGBX(width, height, ptr[0], stride[0], ptr[1], stride[1], ptr[2], stride[2], ptr[3], stride[3], ptr[4], stride[4]);
+}
+
+// argument description: '1'..'4' for images with that many bytes per pixel, 's' for scalars, 'l' for LUTs
+struct AgoFusedPointwiseOp {
+    vx_enum kernel_id;
+    const char * name;
+    const char * args;
+    vx_df_image format;
+    AgoFusedPointwiseOpFunc func;
+};
+#define FUSED_OP_ENTRY(kernel_id,name,args,format) { kernel_id, #name, args, format, agoFusedPointwiseOp_ ## name }
+static const AgoFusedPointwiseOp ago_fused_pointwise_op_list[] = {
+    FUSED_OP_ENTRY(VX_KERNEL_AMD_ADD_U8_U8U8_WRAP, Add_U8_U8U8_Wrap, "111", VX_DF_IMAGE_U8),
+    FUSED_OP_ENTRY(VX_KERNEL_AMD_ADD_U8_U8U8_SAT, Add_U8_U8U8_Sat, "111", VX_DF_IMAGE_U8),
+    FUSED_OP_ENTRY(VX_KERNEL_AMD_SUB_U8_U8U8_WRAP, Sub_U8_U8U8_Wrap, "111", VX_DF_IMAGE_U8),
+    FUSED_OP_ENTRY(VX_KERNEL_AMD_SUB_U8_U8U8_SAT, Sub_U8_U8U8_Sat, "111", VX_DF_IMAGE_U8),
+    FUSED_OP_ENTRY(VX_KERNEL_AMD_ABS_DIFF_U8_U8U8, AbsDiff_U8_U8U8, "111", VX_DF_IMAGE_U8),
+    FUSED_OP_ENTRY(VX_KERNEL_AMD_MUL_U8_U8U8_WRAP_TRUNC, Mul_U8_U8U8_Wrap_Trunc, "111s", VX_DF_IMAGE_U8),
+    FUSED_OP_ENTRY(VX_KERNEL_AMD_MUL_U8_U8U8_WRAP_ROUND, Mul_U8_U8U8_Wrap_Round, "111s", VX_DF_IMAGE_U8),
+    FUSED_OP_ENTRY(VX_KERNEL_AMD_MUL_U8_U8U8_SAT_TRUNC, Mul_U8_U8U8_Sat_Trunc, "111s", VX_DF_IMAGE_U8),
+    FUSED_OP_ENTRY(VX_KERNEL_AMD_MUL_U8_U8U8_SAT_ROUND, Mul_U8_U8U8_Sat_Round, "111s", VX_DF_IMAGE_U8),
+    FUSED_OP_ENTRY(VX_KERNEL_AMD_AND_U8_U8U8, And_U8_U8U8, "111", VX_DF_IMAGE_U8),
+    FUSED_OP_ENTRY(VX_KERNEL_AMD_OR_U8_U8U8, Or_U8_U8U8, "111", VX_DF_IMAGE_U8),
+    FUSED_OP_ENTRY(VX_KERNEL_AMD_XOR_U8_U8U8, Xor_U8_U8U8, "111", VX_DF_IMAGE_U8),
+    FUSED_OP_ENTRY(VX_KERNEL_AMD_NAND_U8_U8U8, Nand_U8_U8U8, "111", VX_DF_IMAGE_U8),
+    FUSED_OP_ENTRY(VX_KERNEL_AMD_NOR_U8_U8U8, Nor_U8_U8U8, "111", VX_DF_IMAGE_U8),
+    FUSED_OP_ENTRY(VX_KERNEL_AMD_XNOR_U8_U8U8, Xnor_U8_U8U8, "111", VX_DF_IMAGE_U8),
+    FUSED_OP_ENTRY(VX_KERNEL_AMD_NOT_U8_U8, Not_U8_U8, "11", VX_DF_IMAGE_U8),
+    FUSED_OP_ENTRY(VX_KERNEL_AMD_LUT_U8_U8, Lut_U8_U8, "11l", VX_DF_IMAGE_U8),
+    FUSED_OP_ENTRY(VX_KERNEL_AMD_ADD_S16_U8U8, Add_S16_U8U8, "211", VX_DF_IMAGE_S16),
+    FUSED_OP_ENTRY(VX_KERNEL_AMD_SUB_S16_U8U8, Sub_S16_U8U8, "211", VX_DF_IMAGE_S16),
+    FUSED_OP_ENTRY(VX_KERNEL_AMD_MUL_S16_U8U8_WRAP_TRUNC, Mul_S16_U8U8_Wrap_Trunc, "211s", VX_DF_IMAGE_S16),
+    FUSED_OP_ENTRY(VX_KERNEL_AMD_MUL_S16_U8U8_WRAP_ROUND, Mul_S16_U8U8_Wrap_Round, "211s", VX_DF_IMAGE_S16),
+    FUSED_OP_ENTRY(VX_KERNEL_AMD_MUL_S16_U8U8_SAT_TRUNC, Mul_S16_U8U8_Sat_Trunc, "211s", VX_DF_IMAGE_S16),
+    FUSED_OP_ENTRY(VX_KERNEL_AMD_MUL_S16_U8U8_SAT_ROUND, Mul_S16_U8U8_Sat_Round, "211s", VX_DF_IMAGE_S16),
+    FUSED_OP_ENTRY(VX_KERNEL_AMD_ADD_S16_S16U8_WRAP, Add_S16_S16U8_Wrap, "221", VX_DF_IMAGE_S16),
+    FUSED_OP_ENTRY(VX_KERNEL_AMD_ADD_S16_S16U8_SAT, Add_S16_S16U8_Sat, "221", VX_DF_IMAGE_S16),
+    FUSED_OP_ENTRY(VX_KERNEL_AMD_SUB_S16_S16U8_WRAP, Sub_S16_S16U8_Wrap, "221", VX_DF_IMAGE_S16),
+    FUSED_OP_ENTRY(VX_KERNEL_AMD_SUB_S16_S16U8_SAT, Sub_S16_S16U8_Sat, "221", VX_DF_IMAGE_S16),
+    FUSED_OP_ENTRY(VX_KERNEL_AMD_MUL_S16_S16U8_WRAP_TRUNC, Mul_S16_S16U8_Wrap_Trunc, "221s", VX_DF_IMAGE_S16),
+    FUSED_OP_ENTRY(VX_KERNEL_AMD_MUL_S16_S16U8_WRAP_ROUND, Mul_S16_S16U8_Wrap_Round, "221s", VX_DF_IMAGE_S16),
+    FUSED_OP_ENTRY(VX_KERNEL_AMD_MUL_S16_S16U8_SAT_TRUNC, Mul_S16_S16U8_Sat_Trunc, "221s", VX_DF_IMAGE_S16),
+    FUSED_OP_ENTRY(VX_KERNEL_AMD_MUL_S16_S16U8_SAT_ROUND, Mul_S16_S16U8_Sat_Round, "221s", VX_DF_IMAGE_S16),
+    FUSED_OP_ENTRY(VX_KERNEL_AMD_SUB_S16_U8S16_WRAP, Sub_S16_U8S16_Wrap, "212", VX_DF_IMAGE_S16),
+    FUSED_OP_ENTRY(VX_KERNEL_AMD_SUB_S16_U8S16_SAT, Sub_S16_U8S16_Sat, "212", VX_DF_IMAGE_S16),
+    FUSED_OP_ENTRY(VX_KERNEL_AMD_ABS_DIFF_S16_S16S16_SAT, AbsDiff_S16_S16S16_Sat, "222", VX_DF_IMAGE_S16),
+    FUSED_OP_ENTRY(VX_KERNEL_AMD_ADD_S16_S16S16_WRAP, Add_S16_S16S16_Wrap, "222", VX_DF_IMAGE_S16),
+    FUSED_OP_ENTRY(VX_KERNEL_AMD_ADD_S16_S16S16_SAT, Add_S16_S16S16_Sat, "222", VX_DF_IMAGE_S16),
+    FUSED_OP_ENTRY(VX_KERNEL_AMD_SUB_S16_S16S16_WRAP, Sub_S16_S16S16_Wrap, "222", VX_DF_IMAGE_S16),
+    FUSED_OP_ENTRY(VX_KERNEL_AMD_SUB_S16_S16S16_SAT, Sub_S16_S16S16_Sat, "222", VX_DF_IMAGE_S16),
+    FUSED_OP_ENTRY(VX_KERNEL_AMD_MUL_S16_S16S16_WRAP_TRUNC, Mul_S16_S16S16_Wrap_Trunc, "222s", VX_DF_IMAGE_S16),
+    FUSED_OP_ENTRY(VX_KERNEL_AMD_MUL_S16_S16S16_WRAP_ROUND, Mul_S16_S16S16_Wrap_Round, "222s", VX_DF_IMAGE_S16),
+    FUSED_OP_ENTRY(VX_KERNEL_AMD_MUL_S16_S16S16_SAT_TRUNC, Mul_S16_S16S16_Sat_Trunc, "222s", VX_DF_IMAGE_S16),
+    FUSED_OP_ENTRY(VX_KERNEL_AMD_MUL_S16_S16S16_SAT_ROUND, Mul_S16_S16S16_Sat_Round, "222s", VX_DF_IMAGE_S16),
+    FUSED_OP_ENTRY(VX_KERNEL_AMD_MAGNITUDE_S16_S16S16, Magnitude_S16_S16S16, "222", VX_DF_IMAGE_S16),
+    FUSED_OP_ENTRY(VX_KERNEL_AMD_PHASE_U8_S16S16, Phase_U8_S16S16, "122", VX_DF_IMAGE_U8),
+    FUSED_OP_ENTRY(VX_KERNEL_AMD_COLOR_DEPTH_U8_S16_WRAP, ColorDepth_U8_S16_Wrap, "12s", VX_DF_IMAGE_U8),
+    FUSED_OP_ENTRY(VX_KERNEL_AMD_COLOR_DEPTH_U8_S16_SAT, ColorDepth_U8_S16_Sat, "12s", VX_DF_IMAGE_U8),
+    FUSED_OP_ENTRY(VX_KERNEL_AMD_COLOR_DEPTH_S16_U8, ColorDepth_S16_U8, "21s", VX_DF_IMAGE_S16),
+    FUSED_OP_ENTRY(VX_KERNEL_AMD_CHANNEL_COPY_U8_U8, ChannelCopy_U8_U8, "11", VX_DF_IMAGE_U8),
+    FUSED_OP_ENTRY(VX_KERNEL_AMD_CHANNEL_EXTRACT_U8_U16_POS0, ChannelExtract_U8_U16_Pos0, "12", VX_DF_IMAGE_U8),
+    FUSED_OP_ENTRY(VX_KERNEL_AMD_CHANNEL_EXTRACT_U8_U16_POS1, ChannelExtract_U8_U16_Pos1, "12", VX_DF_IMAGE_U8),
+    FUSED_OP_ENTRY(VX_KERNEL_AMD_CHANNEL_EXTRACT_U8_U24_POS0, ChannelExtract_U8_U24_Pos0, "13", VX_DF_IMAGE_U8),
+    FUSED_OP_ENTRY(VX_KERNEL_AMD_CHANNEL_EXTRACT_U8_U24_POS1, ChannelExtract_U8_U24_Pos1, "13", VX_DF_IMAGE_U8),
+    FUSED_OP_ENTRY(VX_KERNEL_AMD_CHANNEL_EXTRACT_U8_U24_POS2, ChannelExtract_U8_U24_Pos2, "13", VX_DF_IMAGE_U8),
+    FUSED_OP_ENTRY(VX_KERNEL_AMD_CHANNEL_EXTRACT_U8_U32_POS0, ChannelExtract_U8_U32_Pos0, "14", VX_DF_IMAGE_U8),
+    FUSED_OP_ENTRY(VX_KERNEL_AMD_CHANNEL_EXTRACT_U8_U32_POS1, ChannelExtract_U8_U32_Pos1, "14", VX_DF_IMAGE_U8),
+    FUSED_OP_ENTRY(VX_KERNEL_AMD_CHANNEL_EXTRACT_U8_U32_POS2, ChannelExtract_U8_U32_Pos2, "14", VX_DF_IMAGE_U8),
+    FUSED_OP_ENTRY(VX_KERNEL_AMD_CHANNEL_EXTRACT_U8_U32_POS3, ChannelExtract_U8_U32_Pos3, "14", VX_DF_IMAGE_U8),
+    FUSED_OP_ENTRY(VX_KERNEL_AMD_CHANNEL_COMBINE_U16_U8U8, ChannelCombine_U16_U8U8, "211", VX_DF_IMAGE_U16),
+    FUSED_OP_ENTRY(VX_KERNEL_AMD_CHANNEL_COMBINE_U24_U8U8U8_RGB, ChannelCombine_U24_U8U8U8_RGB, "3111", VX_DF_IMAGE_RGB),
+    FUSED_OP_ENTRY(VX_KERNEL_AMD_CHANNEL_COMBINE_U32_U8U8U8U8_RGBX, ChannelCombine_U32_U8U8U8U8_RGBX, "41111", VX_DF_IMAGE_RGBX),
+    FUSED_OP_ENTRY(VX_KERNEL_AMD_COLOR_CONVERT_RGB_RGBX, ColorConvert_RGB_RGBX, "34", VX_DF_IMAGE_RGB),
+    FUSED_OP_ENTRY(VX_KERNEL_AMD_COLOR_CONVERT_RGBX_RGB, ColorConvert_RGBX_RGB, "43", VX_DF_IMAGE_RGBX),
+};
+#undef FUSED_OP_ENTRY
+
+const char * agoGetFusedPointwiseOpName(vx_enum kernel_id)
+{
+    for (vx_size i = 0; i < sizeof(ago_fused_pointwise_op_list) / sizeof(ago_fused_pointwise_op_list[0]); i++) {
+        if (ago_fused_pointwise_op_list[i].kernel_id == kernel_id)
+            return ago_fused_pointwise_op_list[i].name;
+    }
+    return nullptr;
+}
+
+static vx_uint32 agoFusedPointwiseGetPixelSize(vx_df_image format)
+{
+    switch (format) {
+    case VX_DF_IMAGE_U8:   return 1;
+    case VX_DF_IMAGE_S16:  return 2;
+    case VX_DF_IMAGE_U16:  return 2;
+    case VX_DF_IMAGE_YUYV: return 2;
+    case VX_DF_IMAGE_UYVY: return 2;
+    case VX_DF_IMAGE_RGB:  return 3;
+    case VX_DF_IMAGE_RGBX: return 4;
+    }
+    return 0;
+}
+
+struct AgoFusedPointwiseProgram {
+    vx_uint32 opCount;
+    struct {
+        const AgoFusedPointwiseOp * op;
+        vx_int32 arg[AGO_MAX_PARAMS]; // >= 0: parameter index of fused node, < 0: -1-(intermediate index)
+    } ops[CONFIG_FUSED_POINTWISE_MAX_OPS];
+    vx_uint32 tempCount;
+    vx_uint32 tempPixelSize[CONFIG_FUSED_POINTWISE_MAX_TEMPS];
+};
+
+static int agoFusedPointwiseParseProgram(AgoNode * node, AgoFusedPointwiseProgram * prog)
+{
+    AgoData * iProg = node->paramList[1];
+    if (iProg->ref.type != VX_TYPE_SCALAR || iProg->u.scalar.type != VX_TYPE_STRING_AMD || !iProg->buffer)
+        return VX_ERROR_INVALID_TYPE;
+    const char * s = (const char *)iProg->buffer;
+    prog->opCount = 0;
+    prog->tempCount = 0;
+    bool outputWritten = false;
+    while (*s) {
+        // get the operation
+        if (outputWritten || prog->opCount >= CONFIG_FUSED_POINTWISE_MAX_OPS)
+            return VX_ERROR_INVALID_PARAMETERS;
+        const char * e = strchr(s, '(');
+        if (!e)
+            return VX_ERROR_INVALID_PARAMETERS;
+        const AgoFusedPointwiseOp * op = nullptr;
+        for (vx_size i = 0; i < sizeof(ago_fused_pointwise_op_list) / sizeof(ago_fused_pointwise_op_list[0]); i++) {
+            if (!strncmp(s, ago_fused_pointwise_op_list[i].name, e - s) && !ago_fused_pointwise_op_list[i].name[e - s]) {
+                op = &ago_fused_pointwise_op_list[i];
+                break;
+            }
+        }
+        if (!op)
+            return VX_ERROR_INVALID_PARAMETERS;
+        prog->ops[prog->opCount].op = op;
+        // get the arguments: images must be of the expected pixel size and intermediates must be written before being read
+        vx_uint32 argCount = (vx_uint32)strlen(op->args);
+        s = e + 1;
+        for (vx_uint32 arg = 0; arg < argCount; arg++) {
+            vx_int32 index;
+            bool isTemp = (*s == 't');
+            if (isTemp) s++;
+            if (*s < '0' || *s > '9')
+                return VX_ERROR_INVALID_PARAMETERS;
+            for (index = 0; *s >= '0' && *s <= '9'; s++)
+                index = index * 10 + (*s - '0');
+            if (*s != ((arg == argCount - 1) ? ')' : ','))
+                return VX_ERROR_INVALID_PARAMETERS;
+            s++;
+            vx_uint32 pixelSize = (op->args[arg] >= '1' && op->args[arg] <= '4') ? (vx_uint32)(op->args[arg] - '0') : 0;
+            if (isTemp) {
+                if (!pixelSize || index >= CONFIG_FUSED_POINTWISE_MAX_TEMPS)
+                    return VX_ERROR_INVALID_PARAMETERS;
+                if (arg == 0) {
+                    while (prog->tempCount <= (vx_uint32)index)
+                        prog->tempPixelSize[prog->tempCount++] = 0;
+                    prog->tempPixelSize[index] = max(prog->tempPixelSize[index], pixelSize);
+                }
+                else if ((vx_uint32)index >= prog->tempCount || prog->tempPixelSize[index] < pixelSize)
+                    return VX_ERROR_INVALID_PARAMETERS;
+                prog->ops[prog->opCount].arg[arg] = -1 - index;
+            }
+            else {
+                if (index < 2 || index >= (vx_int32)node->paramCount || !node->paramList[index]) {
+                    // parameter #0 is the output of the last operation and #1 is the program itself
+                    if (!(arg == 0 && index == 0))
+                        return VX_ERROR_INVALID_PARAMETERS;
+                    outputWritten = true;
+                }
+                else if (arg == 0)
+                    return VX_ERROR_INVALID_PARAMETERS;
+                else {
+                    AgoData * data = node->paramList[index];
+                    if (pixelSize) {
+                        if (data->ref.type != VX_TYPE_IMAGE || agoFusedPointwiseGetPixelSize(data->u.img.format) != pixelSize)
+                            return VX_ERROR_INVALID_FORMAT;
+                    }
+                    else if (data->ref.type != ((op->args[arg] == 'l') ? VX_TYPE_LUT : VX_TYPE_SCALAR))
+                        return VX_ERROR_INVALID_TYPE;
+                }
+                prog->ops[prog->opCount].arg[arg] = index;
+            }
+        }
+        prog->opCount++;
+        if (*s == ';')
+            s++;
+        else if (*s)
+            return VX_ERROR_INVALID_PARAMETERS;
+    }
+    if (!outputWritten)
+        return VX_ERROR_INVALID_PARAMETERS;
+    return VX_SUCCESS;
+}
+
+static void agoFusedPointwiseGetStripLayout(AgoNode * node, const AgoFusedPointwiseProgram * prog, vx_uint32 * tempStride, vx_size * tempOffset, vx_uint32 * stripHeight)
+{
+    // intermediates are kept for a strip of rows that fits in cache, with the allocation padding around each buffer
+    vx_uint32 width = node->paramList[0]->u.img.width;
+    vx_uint32 rowSize = 0;
+    for (vx_uint32 i = 0; i < prog->tempCount; i++) {
+        tempStride[i] = (vx_uint32)ALIGN32(width * prog->tempPixelSize[i]);
+        rowSize += tempStride[i];
+    }
+    *stripHeight = rowSize ? max(CONFIG_FUSED_POINTWISE_STRIP_SIZE / rowSize, 1u) : node->paramList[0]->u.img.height;
+    vx_size offset = 0;
+    for (vx_uint32 i = 0; i < prog->tempCount; i++) {
+        tempOffset[i] = offset + AGO_MEMORY_ALLOC_EXTRA_PADDING;
+        offset += ALIGN32((vx_size)tempStride[i] * *stripHeight + 2 * AGO_MEMORY_ALLOC_EXTRA_PADDING);
+    }
+    tempOffset[prog->tempCount] = offset;
+}
+
+// decoded program and strip layout, kept at the start of the node local data from initialize on
+struct AgoFusedPointwisePlan {
+    AgoFusedPointwiseProgram prog;
+    vx_uint32 tempStride[CONFIG_FUSED_POINTWISE_MAX_TEMPS];
+    vx_size tempOffset[CONFIG_FUSED_POINTWISE_MAX_TEMPS + 1]; // relative to the scratch that follows the plan
+    vx_uint32 stripHeight;
+};
+#define AGO_FUSED_POINTWISE_PLAN_SIZE ALIGN32(sizeof(AgoFusedPointwisePlan))
+
+int agoKernel_FusedPointwise_DATA_DATA(AgoNode * node, AgoKernelCommand cmd)
+{
+    vx_status status = AGO_ERROR_KERNEL_NOT_IMPLEMENTED;
+    if (cmd == ago_kernel_cmd_execute) {
+        const AgoFusedPointwisePlan * plan = (const AgoFusedPointwisePlan *)node->localDataPtr;
+        const AgoFusedPointwiseProgram & prog = plan->prog;
+        AgoData * oImg = node->paramList[0];
+        status = agoExecuteCpuRowBands(node, oImg->u.img.height, [&](vx_uint32 y, vx_uint32 h, vx_uint8 * pLocalData) {
+            // run all operations on a strip of rows before moving to the next strip;
+            // every band has the plan sized area in front of its scratch, only the first band's copy holds the plan
+            vx_uint8 * pScratch = pLocalData + AGO_FUSED_POINTWISE_PLAN_SIZE;
+            vx_uint8 * ptr[AGO_MAX_PARAMS];
+            vx_uint32 stride[AGO_MAX_PARAMS];
+            AgoData * data[AGO_MAX_PARAMS];
+            for (vx_uint32 ys = y; ys < y + h; ys += plan->stripHeight) {
+                vx_uint32 hs = min(plan->stripHeight, y + h - ys);
+                for (vx_uint32 i = 0; i < prog.opCount; i++) {
+                    const AgoFusedPointwiseOp * op = prog.ops[i].op;
+                    for (vx_uint32 arg = 0; op->args[arg]; arg++) {
+                        vx_int32 index = prog.ops[i].arg[arg];
+                        if (index < 0) {
+                            ptr[arg] = pScratch + plan->tempOffset[-1 - index];
+                            stride[arg] = plan->tempStride[-1 - index];
+                            data[arg] = nullptr;
+                        }
+                        else {
+                            data[arg] = node->paramList[index];
+                            if (data[arg]->ref.type == VX_TYPE_IMAGE) {
+                                ptr[arg] = data[arg]->buffer + ys * data[arg]->u.img.stride_in_bytes;
+                                stride[arg] = data[arg]->u.img.stride_in_bytes;
+                            }
+                        }
+                    }
+                    if (op->func(node->ref.context, oImg->u.img.width, hs, ptr, stride, data))
+                        return VX_FAILURE;
+                }
+            }
+            return VX_SUCCESS;
+        });
+    }
+    else if (cmd == ago_kernel_cmd_validate) {
+        AgoFusedPointwiseProgram prog;
+        status = agoFusedPointwiseParseProgram(node, &prog);
+        if (!status) {
+            // all images have the same dimensions and the output format is the output of the last operation
+            vx_uint32 width = 0, height = 0;
+            for (vx_uint32 i = 2; i < node->paramCount; i++) {
+                AgoData * data = node->paramList[i];
+                if (data && data->ref.type == VX_TYPE_IMAGE) {
+                    if (!width) {
+                        width = data->u.img.width;
+                        height = data->u.img.height;
+                    }
+                    else if (data->u.img.width != width || data->u.img.height != height)
+                        return VX_ERROR_INVALID_DIMENSION;
+                }
+            }
+            if (!width || !height)
+                return VX_ERROR_INVALID_DIMENSION;
+            vx_meta_format meta;
+            meta = &node->metaList[0];
+            meta->data.u.img.width = width;
+            meta->data.u.img.height = height;
+            meta->data.u.img.format = prog.ops[prog.opCount - 1].op->format;
+        }
+    }
+    else if (cmd == ago_kernel_cmd_initialize) {
+        // parse the program once, execute only reads the plan
+        AgoFusedPointwisePlan plan;
+        status = agoFusedPointwiseParseProgram(node, &plan.prog);
+        if (!status) {
+            agoFusedPointwiseGetStripLayout(node, &plan.prog, plan.tempStride, plan.tempOffset, &plan.stripHeight);
+            if (node->localDataPtr) {
+                agoReleaseMemory(node->localDataPtr);
+                node->localDataPtr = nullptr;
+            }
+            node->localDataSize = AGO_FUSED_POINTWISE_PLAN_SIZE + plan.tempOffset[plan.prog.tempCount];
+            node->localDataPtr = (vx_uint8 *)agoAllocMemory(node->localDataSize);
+            if (!node->localDataPtr) return VX_ERROR_NO_MEMORY;
+            memcpy(node->localDataPtr, &plan, sizeof(plan));
+        }
+    }
+    else if (cmd == ago_kernel_cmd_shutdown) {
+        status = VX_SUCCESS;
+        if (node->localDataPtr) {
+            agoReleaseMemory(node->localDataPtr);
+            node->localDataPtr = nullptr;
+        }
+    }
+    else if (cmd == ago_kernel_cmd_valid_rect_callback) {
+        // all operations are pointwise, so the output is valid where all input images are valid
+        status = VX_SUCCESS;
+        AgoData * out = node->paramList[0];
+        out->u.img.rect_valid.start_x = 0;
+        out->u.img.rect_valid.start_y = 0;
+        out->u.img.rect_valid.end_x = out->u.img.width;
+        out->u.img.rect_valid.end_y = out->u.img.height;
+        for (vx_uint32 i = 2; i < node->paramCount; i++) {
+            AgoData * inp = node->paramList[i];
+            if (inp && inp->ref.type == VX_TYPE_IMAGE) {
+                out->u.img.rect_valid.start_x = max(out->u.img.rect_valid.start_x, inp->u.img.rect_valid.start_x);
+                out->u.img.rect_valid.start_y = max(out->u.img.rect_valid.start_y, inp->u.img.rect_valid.start_y);
+                out->u.img.rect_valid.end_x = min(out->u.img.rect_valid.end_x, inp->u.img.rect_valid.end_x);
+                out->u.img.rect_valid.end_y = min(out->u.img.rect_valid.end_y, inp->u.img.rect_valid.end_y);
+            }
+        }
+    }
+#if ENABLE_OPENCL
+    else if (cmd == ago_kernel_cmd_opencl_codegen) {
+        // fused nodes are only generated for CPU
+        status = VX_ERROR_NOT_SUPPORTED;
+    }
+#endif
+    else if (cmd == ago_kernel_cmd_query_target_support) {
+        node->target_support_flags = 0
+                    | AGO_KERNEL_FLAG_DEVICE_CPU
+                    ;
+        status = VX_SUCCESS;
+    }
+    return status;
+}
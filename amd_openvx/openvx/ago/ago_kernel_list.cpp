@@ -66,6 +66,7 @@ THE SOFTWARE.
 #define AOUTx3_AIN_AOPTINx6                    { AOUT, AOUT, AOUT, AIN, AOPTIN, AOPTIN, AOPTIN, AOPTIN, AOPTIN, AOPTIN }
 #define AOUTx2_AINx2_AOPTINx6                  { AOUT, AOUT, AIN, AIN, AOPTIN, AOPTIN, AOPTIN, AOPTIN, AOPTIN, AOPTIN }
 #define AOUT_AIN_AOPTINx8                      { AOUT, AIN, AOPTIN, AOPTIN, AOPTIN, AOPTIN, AOPTIN, AOPTIN, AOPTIN, AOPTIN }
+#define AOUT_AIN_AOPTINx14                     { AOUT, AIN, AOPTIN, AOPTIN, AOPTIN, AOPTIN, AOPTIN, AOPTIN, AOPTIN, AOPTIN, AOPTIN, AOPTIN, AOPTIN, AOPTIN, AOPTIN, AOPTIN }
 #define AINOUT_AIN                             { AINOUT, AIN }
 #define AINOUT_AINx2                           { AINOUT, AIN, AIN }
 #define AOUTx3_AINx2_AOPTINx5                  { AOUT, AOUT, AOUT, AIN, AIN, AOPTIN, AOPTIN, AOPTIN, AOPTIN, AOPTIN }
@@ -150,6 +151,7 @@ THE SOFTWARE.
 #define ATYPE_SRRR                             { VX_TYPE_SCALAR, VX_TYPE_REFERENCE, VX_TYPE_REFERENCE, VX_TYPE_REFERENCE }
 #define ATYPE_RSRR                             { VX_TYPE_REFERENCE, VX_TYPE_SCALAR, VX_TYPE_REFERENCE, VX_TYPE_REFERENCE }
 #define ATYPE_IMIS                             { VX_TYPE_IMAGE, VX_TYPE_MATRIX, VX_TYPE_IMAGE, VX_TYPE_SCALAR }
+#define ATYPE_IS                               { VX_TYPE_IMAGE, VX_TYPE_SCALAR }
 
 // for kernOpType & kernOpInfo
 #define KOP_UNKNOWN    AGO_KERNEL_OP_TYPE_UNKNOWN,         0,
@@ -517,6 +519,8 @@ static struct {
 	AGO_KERNEL_ENTRY( VX_KERNEL_AMD_NON_LINEAR_FILTER_DATA_DATA_DATA                        , 1, 0, NonLinearFilter_DATA_DATA_DATA, AOUT_AINx3,                   ATYPE_IMIS              , KOP_UNKNOWN   , false ),
 	AGO_KERNEL_ENTRY( VX_KERNEL_AMD_LAPLACIAN_PYRAMID_DATA_DATA_DATA                        , 1, 0, LaplacianPyramid_DATA_DATA_DATA, AOUT_AINx2,                  ATYPE_IPI               , KOP_UNKNOWN   , false ),
 	AGO_KERNEL_ENTRY( VX_KERNEL_AMD_LAPLACIAN_RECONSTRUCT_DATA_DATA_DATA                    , 1, 0, LaplacianReconstruct_DATA_DATA_DATA, AOUT_AINx2,              ATYPE_IIP               , KOP_UNKNOWN   , false ),
+	// kernels generated by the graph optimizer
+	AGO_KERNEL_ENTRY( VX_KERNEL_AMD_FUSED_POINTWISE_DATA_DATA                               , 1, 0, FusedPointwise_DATA_DATA, AOUT_AIN_AOPTINx14,                 ATYPE_IS                , KOP_UNKNOWN   , false ),
 #undef AGO_KERNEL_ENTRY
 #undef OVX_KERNEL_ENTRY
 };
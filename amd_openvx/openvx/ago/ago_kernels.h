@@ -454,6 +454,9 @@ enum vx_kernel_amd_e {
 	VX_KERNEL_AMD_LAPLACIAN_PYRAMID_DATA_DATA_DATA,
 	VX_KERNEL_AMD_LAPLACIAN_RECONSTRUCT_DATA_DATA_DATA,
 
+	// kernels generated by the graph optimizer
+	VX_KERNEL_AMD_FUSED_POINTWISE_DATA_DATA,
+
 	VX_KERNEL_AMD_MAX_1_0, // Used for bounds checking in the internal conformance test
 };
 
@@ -22,6 +22,7 @@ THE SOFTWARE.
 
 
 #include "ago_platform.h"
+#include "vx_ext_amd.h"
 
 // macro to port VisualStudio __cpuid to g++
 #if !_WIN32
@@ -46,6 +47,38 @@ bool agoIsCpuHardwareSupported()
 	return isHardwareSupported;
 }
 
+int agoGetCpuIsaSupport()
+{
+	// returns the best VX_AMD_CPU_ISA_* level usable by CPU kernels: CPUID reports the instruction
+	// sets and XGETBV confirms that the OS saves the wider register state on context switch
+	int isa = VX_AMD_CPU_ISA_SSE4_2;
+	int CPUInfo[4] = { -1 };
+	__cpuid(CPUInfo, 0);
+	if (CPUInfo[0] >= 7) {
+		__cpuid(CPUInfo, 1);
+		bool osxsave = (CPUInfo[2] & 0x08000000) != 0;
+		if (osxsave) {
+#if _WIN32
+			unsigned long long xcr0 = _xgetbv(0);
+			__cpuidex(CPUInfo, 7, 0);
+#else
+			unsigned int xcr0lo, xcr0hi;
+			asm("xgetbv" : "=a" (xcr0lo), "=d" (xcr0hi) : "c" (0));
+			unsigned long long xcr0 = ((unsigned long long)xcr0hi << 32) | xcr0lo;
+			asm("cpuid": "=a" (CPUInfo[0]), "=b" (CPUInfo[1]), "=c" (CPUInfo[2]), "=d" (CPUInfo[3]): "a" (7), "c" (0));
+#endif
+			// AVX2: EBX[5] with XMM/YMM state enabled
+			if ((CPUInfo[1] & 0x20) && (xcr0 & 0x06) == 0x06) {
+				isa = VX_AMD_CPU_ISA_AVX2;
+				// AVX-512F and AVX-512BW: EBX[16] and EBX[30] with opmask/ZMM state enabled
+				if ((CPUInfo[1] & 0x00010000) && (CPUInfo[1] & 0x40000000) && (xcr0 & 0xE6) == 0xE6)
+					isa = VX_AMD_CPU_ISA_AVX512;
+			}
+		}
+	}
+	return isa;
+}
+
 uint32_t agoControlFpSetRoundEven()
 {
 	uint32_t state;
@@ -250,14 +283,15 @@ DWORD WaitForSingleObject(HANDLE h, DWORD dwMilliseconds)
 	if(h) {
 		if(*(int*)h == VX_SEMAPHORE) {
 			vx_semaphore * sem = (vx_semaphore *)h;
-			{
-				unique_lock<mutex> lk(sem->mtx);
-				sem->cv.wait(lk); // TBD: implement with timeout
+			unique_lock<mutex> lk(sem->mtx);
+			// the count is checked under the lock so that a release issued before the wait is not lost
+			if(dwMilliseconds == INFINITE) {
+				sem->cv.wait(lk, [sem] { return sem->count > 0; });
 			}
-			{
-				lock_guard<mutex> lk(sem->mtx);
-				sem->count--;
+			else if(!sem->cv.wait_for(lk, chrono::milliseconds(dwMilliseconds), [sem] { return sem->count > 0; })) {
+				return WAIT_TIMEOUT;
 			}
+			sem->count--;
 		}
     } else
     {
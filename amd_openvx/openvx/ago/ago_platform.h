@@ -45,10 +45,16 @@ THE SOFTWARE.
 #include <vector>
 #include <list>
 #include <map>
+#include <unordered_map>
 #include <algorithm>
 #include <functional>
 #include <chrono>
 #include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <atomic>
+#include <memory>
 
 #if _WIN32
 #include <Windows.h>
@@ -130,6 +136,7 @@ typedef struct _ago_module    * ago_module;
 
 // platform independent functions
 bool       agoIsCpuHardwareSupported();
+int        agoGetCpuIsaSupport(); // returns VX_AMD_CPU_ISA_* level
 uint32_t   agoControlFpSetRoundEven();
 void       agoControlFpReset(uint32_t state);
 int64_t    agoGetClockCounter();
@@ -161,6 +168,7 @@ extern BOOL ReleaseSemaphore(HANDLE hSemaphore, LONG lReleaseCount, LPLONG lpPre
 #define WINAPI
 #define INFINITE 0xFFFFFFFF
 #define WAIT_OBJECT_0 0
+#define WAIT_TIMEOUT 0x102
 #endif
 
 #endif
\ No newline at end of file
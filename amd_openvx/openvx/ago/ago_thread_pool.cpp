@@ -0,0 +1,194 @@
+/* 
+Copyright (c) 2015 - 2022 Advanced Micro Devices, Inc. All rights reserved.
+ 
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+ 
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+ 
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+#include "ago_internal.h"
+
+// each parallelFor call owns a batch that tracks the number of outstanding tasks
+struct AgoThreadPool::Batch {
+    const std::function<void(vx_uint32)> * func;
+    std::atomic<vx_uint32> remaining;
+    std::mutex lock;
+    std::condition_variable done;
+};
+
+AgoThreadPool::AgoThreadPool(vx_uint32 numThreads)
+    : pendingCount{ 0 }, nextVictim{ 0 }, terminate{ false }
+{
+    // the thread calling parallelFor participates, so only numThreads-1 workers are needed
+    for (vx_uint32 i = 1; i < numThreads; i++) {
+        workers.emplace_back(new Worker);
+    }
+    for (size_t i = 0; i < workers.size(); i++) {
+        workers[i]->thread = std::thread(&AgoThreadPool::workerMain, this, (int)i);
+    }
+}
+
+AgoThreadPool::~AgoThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(idleLock);
+        terminate = true;
+    }
+    idleCv.notify_all();
+    for (auto& worker : workers) {
+        if (worker->thread.joinable())
+            worker->thread.join();
+    }
+}
+
+bool AgoThreadPool::popTask(int self, Task& task)
+{
+    int numWorkers = (int)workers.size();
+    // take the most recently queued task from own queue
+    if (self >= 0) {
+        Worker * worker = workers[self].get();
+        std::lock_guard<std::mutex> lock(worker->lock);
+        if (!worker->queue.empty()) {
+            task = worker->queue.back();
+            worker->queue.pop_back();
+            return true;
+        }
+    }
+    // steal the oldest task from another queue
+    int start = (self >= 0) ? self + 1 : (int)(nextVictim++ % (vx_uint32)numWorkers);
+    for (int i = 0; i < numWorkers; i++) {
+        Worker * victim = workers[(start + i) % numWorkers].get();
+        if (victim == (self >= 0 ? workers[self].get() : nullptr))
+            continue;
+        std::lock_guard<std::mutex> lock(victim->lock);
+        if (!victim->queue.empty()) {
+            task = victim->queue.front();
+            victim->queue.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+void AgoThreadPool::runTask(const Task& task)
+{
+    pendingCount--;
+    Batch * batch = task.batch;
+    (*batch->func)(task.index);
+    // the batch may be released by its owner as soon as the lock is dropped
+    std::lock_guard<std::mutex> lock(batch->lock);
+    if (--batch->remaining == 0)
+        batch->done.notify_all();
+}
+
+void AgoThreadPool::workerMain(int self)
+{
+    char threadName[64];
+    sprintf(threadName, "AGO CPU worker %d", self);
+    agoTraceSetThreadName(threadName);
+    for (;;) {
+        Task task;
+        if (popTask(self, task)) {
+            runTask(task);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(idleLock);
+        idleCv.wait(lock, [this] { return terminate || pendingCount > 0; });
+        if (terminate && pendingCount <= 0)
+            break;
+    }
+}
+
+void AgoThreadPool::parallelFor(vx_uint32 count, const std::function<void(vx_uint32)>& func)
+{
+    if (count == 0)
+        return;
+    if (count == 1 || workers.empty()) {
+        for (vx_uint32 i = 0; i < count; i++)
+            func(i);
+        return;
+    }
+
+    // distribute tasks across worker queues: idle workers steal to balance uneven tasks
+    Batch batch;
+    batch.func = &func;
+    batch.remaining = count;
+    vx_uint32 numWorkers = (vx_uint32)workers.size();
+    vx_uint32 first = nextVictim++ % numWorkers;
+    for (vx_uint32 i = 0; i < count; i++) {
+        Worker * worker = workers[(first + i) % numWorkers].get();
+        std::lock_guard<std::mutex> lock(worker->lock);
+        worker->queue.push_back({ &batch, i });
+    }
+    pendingCount += (vx_int32)count;
+    { std::lock_guard<std::mutex> lock(idleLock); }
+    idleCv.notify_all();
+
+    // help with pending tasks until this batch is complete
+    while (batch.remaining > 0) {
+        Task task;
+        if (popTask(-1, task)) {
+            runTask(task);
+        }
+        else {
+            std::unique_lock<std::mutex> lock(batch.lock);
+            batch.done.wait(lock, [&batch] { return batch.remaining == 0; });
+        }
+    }
+    // make sure that the last task has released the batch
+    std::lock_guard<std::mutex> lock(batch.lock);
+}
+
+int agoExecuteCpuRowBands(AgoNode * node, vx_uint32 height, const std::function<int(vx_uint32 y, vx_uint32 h, vx_uint8 * pLocalData)>& func)
+{
+    // split the rows into bands when a CPU thread pool is available and the image is tall enough;
+    // kernels with neighborhood access read the halo rows directly from the input image
+    AgoThreadPool * pool = node->ref.context->cpu_thread_pool;
+    vx_uint32 numBands = pool ? min(pool->getThreadCount(), height / CONFIG_THREAD_CPU_MIN_BAND_HEIGHT) : 1;
+    if (numBands <= 1) {
+        return func(0, height, node->localDataPtr);
+    }
+
+    // each band other than the first needs its own copy of node local scratch memory
+    vx_size bandLocalDataSize = ALIGN32(node->localDataSize);
+    if (bandLocalDataSize > 0 && node->bandLocalDataCount < numBands - 1) {
+        if (node->bandLocalDataPtr_allocated)
+            agoReleaseMemory(node->bandLocalDataPtr_allocated);
+        node->bandLocalDataCount = 0;
+        node->bandLocalDataPtr_allocated = (vx_uint8 *)agoAllocMemory(bandLocalDataSize * (numBands - 1));
+        if (!node->bandLocalDataPtr_allocated) {
+            return func(0, height, node->localDataPtr);
+        }
+        node->bandLocalDataCount = numBands - 1;
+    }
+
+    // band boundaries are kept even so that kernels with 2x2 subsampled planes can be split as well
+    vx_uint32 bandHeight = ((height + numBands - 1) / numBands + 1) & ~1;
+    std::atomic<int> status{ VX_SUCCESS };
+    pool->parallelFor(numBands, [&](vx_uint32 band) {
+        vx_uint32 y = band * bandHeight;
+        if (y >= height)
+            return;
+        vx_uint32 h = min(bandHeight, height - y);
+        vx_uint8 * pLocalData = (band == 0 || bandLocalDataSize == 0) ? node->localDataPtr : node->bandLocalDataPtr_allocated + (band - 1) * bandLocalDataSize;
+        int bandStatus = func(y, h, pLocalData);
+        if (bandStatus)
+            status = bandStatus;
+    });
+    return status;
+}
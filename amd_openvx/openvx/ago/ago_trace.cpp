@@ -0,0 +1,229 @@
+/*
+Copyright (c) 2015 - 2022 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+#include "ago_internal.h"
+#if !_WIN32
+#include <unistd.h>
+#endif
+
+// Trace of the process in Chrome trace event format (JSON array), viewable with chrome://tracing or Perfetto UI:
+// - one writer is shared by all contexts, so AGO graphs and applications like rocAL appear in one timeline
+// - events are buffered and appended to the file as the buffer fills up, the closing bracket is written at
+//   process exit and the format allows it to be missing when the process doesn't exit normally
+// - AGO_TRACE_FILE environment variable starts the trace when the first context is created
+// - every thread gets its own lane; threads named with agoTraceSetThreadName show up with that name
+// - timestamps are in nanoseconds of the clock behind agoGetClockCounter and written in microseconds
+
+#define AGO_TRACE_BUFFER_SIZE  (1 << 20)
+
+struct AgoTraceWriter {
+    std::mutex cs;
+    std::atomic<bool> enabled{ false };
+    FILE * fp{ nullptr };
+    std::string buffer;
+    int64_t baseTime{ 0 };
+    int pid{ 0 };
+    bool hasEvents{ false };
+    std::atomic<vx_uint32> nextThreadId{ 1 };
+};
+
+struct AgoTraceThread {
+    vx_uint32 tid{ 0 };
+    std::string name;
+    bool nameWritten{ false };
+};
+
+static AgoTraceWriter * agoTraceGetWriter()
+{
+    // never destroyed, so that threads ending after exit handlers still find a valid writer
+    static AgoTraceWriter * writer = new AgoTraceWriter;
+    return writer;
+}
+
+static AgoTraceThread& agoTraceGetThread()
+{
+    static thread_local AgoTraceThread thread;
+    if (!thread.tid)
+        thread.tid = agoTraceGetWriter()->nextThreadId++;
+    return thread;
+}
+
+static int64_t agoTraceClockCounterToNs(int64_t counter)
+{
+    static const int64_t freq = agoGetClockFrequency();
+    if (freq == 1000000000)
+        return counter;
+    return (int64_t)((double)counter * (1000000000.0 / (double)freq));
+}
+
+static void agoTraceAppendString(std::string& buffer, const char * str)
+{
+    for (const char * s = str; *s; s++) {
+        if (*s == '"' || *s == '\\') buffer += '\\';
+        if ((unsigned char)*s >= ' ') buffer += *s;
+    }
+}
+
+// append an event to the buffer: caller must hold writer lock
+static void agoTraceAppendEvent(AgoTraceWriter * writer, AgoTraceThread& thread, char ph, const char * name, const char * category, int64_t beg, int64_t dur, const char * args)
+{
+    char text[256];
+    if (writer->hasEvents)
+        writer->buffer += ",\n";
+    writer->hasEvents = true;
+    if (!thread.nameWritten && !thread.name.empty()) {
+        writer->buffer += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":";
+        sprintf(text, "%d,\"tid\":%u,\"args\":{\"name\":\"", writer->pid, thread.tid);
+        writer->buffer += text;
+        agoTraceAppendString(writer->buffer, thread.name.c_str());
+        writer->buffer += "\"}},\n";
+        thread.nameWritten = true;
+    }
+    writer->buffer += "{\"name\":\"";
+    agoTraceAppendString(writer->buffer, name);
+    writer->buffer += "\",\"cat\":\"";
+    agoTraceAppendString(writer->buffer, category);
+    sprintf(text, "\",\"ph\":\"%c\",\"pid\":%d,\"tid\":%u,\"ts\":%.3f", ph, writer->pid, thread.tid, (double)(beg - writer->baseTime) * 0.001);
+    writer->buffer += text;
+    if (ph == 'X') {
+        sprintf(text, ",\"dur\":%.3f", (double)dur * 0.001);
+        writer->buffer += text;
+    }
+    if (args) {
+        writer->buffer += ",\"args\":{";
+        writer->buffer += args;
+        writer->buffer += "}";
+    }
+    writer->buffer += "}";
+    if (writer->buffer.size() >= AGO_TRACE_BUFFER_SIZE) {
+        fwrite(writer->buffer.data(), 1, writer->buffer.size(), writer->fp);
+        writer->buffer.clear();
+    }
+}
+
+static void agoTraceCloseLocked(AgoTraceWriter * writer)
+{
+    if (writer->fp) {
+        writer->enabled = false;
+        writer->buffer += "\n]\n";
+        fwrite(writer->buffer.data(), 1, writer->buffer.size(), writer->fp);
+        writer->buffer.clear();
+        fclose(writer->fp);
+        writer->fp = nullptr;
+    }
+}
+
+static void agoTraceClose()
+{
+    AgoTraceWriter * writer = agoTraceGetWriter();
+    std::lock_guard<std::mutex> lock(writer->cs);
+    agoTraceCloseLocked(writer);
+}
+
+bool agoTraceIsEnabled()
+{
+    return agoTraceGetWriter()->enabled.load(std::memory_order_relaxed);
+}
+
+vx_status agoTraceOpen(const char * fileName)
+{
+    static std::once_flag registerExitHandler;
+    AgoTraceWriter * writer = agoTraceGetWriter();
+    std::lock_guard<std::mutex> lock(writer->cs);
+    agoTraceCloseLocked(writer);
+    if (!fileName || !fileName[0])
+        return VX_SUCCESS;
+    writer->fp = fopen(fileName, "w");
+    if (!writer->fp) {
+        agoAddLogEntry(NULL, VX_FAILURE, "ERROR: agoTraceOpen: unable to create: %s\n", fileName);
+        return VX_FAILURE;
+    }
+    std::call_once(registerExitHandler, []() { atexit(agoTraceClose); });
+#if _WIN32
+    writer->pid = (int)GetCurrentProcessId();
+#else
+    writer->pid = (int)getpid();
+#endif
+    writer->baseTime = agoTraceClockCounterToNs(agoGetClockCounter());
+    writer->buffer = "[\n";
+    writer->hasEvents = false;
+    writer->enabled = true;
+    return VX_SUCCESS;
+}
+
+void agoTraceInitialize()
+{
+    static std::once_flag initialized;
+    std::call_once(initialized, []() {
+        char textBuffer[1024];
+        if (agoGetEnvironmentVariable("AGO_TRACE_FILE", textBuffer, sizeof(textBuffer)))
+            agoTraceOpen(textBuffer);
+    });
+}
+
+void agoTraceFlush()
+{
+    AgoTraceWriter * writer = agoTraceGetWriter();
+    std::lock_guard<std::mutex> lock(writer->cs);
+    if (writer->fp) {
+        fwrite(writer->buffer.data(), 1, writer->buffer.size(), writer->fp);
+        writer->buffer.clear();
+        fflush(writer->fp);
+    }
+}
+
+void agoTraceSetThreadName(const char * name)
+{
+    AgoTraceThread& thread = agoTraceGetThread();
+    thread.name = name ? name : "";
+    thread.nameWritten = false;
+}
+
+void agoTraceAddEvent(const char * name, const char * category, int64_t begNs, int64_t endNs)
+{
+    AgoTraceWriter * writer = agoTraceGetWriter();
+    if (!writer->enabled.load(std::memory_order_relaxed))
+        return;
+    AgoTraceThread& thread = agoTraceGetThread();
+    std::lock_guard<std::mutex> lock(writer->cs);
+    if (writer->fp)
+        agoTraceAppendEvent(writer, thread, 'X', name, category, begNs, endNs - begNs, nullptr);
+}
+
+void agoTraceProfileEntry(vx_uint32 frame, AgoProfileEntryType type, vx_reference ref, int64_t time)
+{
+    AgoTraceWriter * writer = agoTraceGetWriter();
+    if (!writer->enabled.load(std::memory_order_relaxed))
+        return;
+    static const char * category[] = { "launch", "wait", "copy", "exec" };
+    char name[256];
+    if (ref->type == VX_TYPE_GRAPH) strcpy(name, "GRAPH");
+    else if (ref->type == VX_TYPE_NODE) { strncpy(name, ((AgoNode *)ref)->akernel->name, sizeof(name) - 1); name[sizeof(name) - 1] = 0; }
+    else agoGetDataName(name, (AgoData *)ref);
+    char args[32];
+    sprintf(args, "\"frame\":%u", frame);
+    AgoTraceThread& thread = agoTraceGetThread();
+    std::lock_guard<std::mutex> lock(writer->cs);
+    if (writer->fp)
+        agoTraceAppendEvent(writer, thread, (type & 1) ? 'E' : 'B', name, category[(type >> 1) & 3], agoTraceClockCounterToNs(time), 0, args);
+}
@@ -247,6 +247,31 @@ void agoAddData(AgoDataList * dataList, AgoData * data)
     else dataList->head = data;
     dataList->tail = data;
     dataList->count++;
+    data->ownerList = dataList;
+    if (!data->name.empty())
+        dataList->nameIndex.emplace(data->name, data);
+}
+
+static void agoRemoveDataFromNameIndex(AgoData * data)
+{
+    if (data->ownerList && !data->name.empty()) {
+        auto range = data->ownerList->nameIndex.equal_range(data->name);
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second == data) {
+                data->ownerList->nameIndex.erase(it);
+                break;
+            }
+        }
+    }
+}
+
+void agoSetDataName(AgoData * data, const std::string& name)
+{
+    // keep the name index of the list holding data in sync
+    agoRemoveDataFromNameIndex(data);
+    data->name = name;
+    if (data->ownerList && !data->name.empty())
+        data->ownerList->nameIndex.emplace(data->name, data);
 }
 
 void agoAddNode(AgoNodeList * nodeList, AgoNode * node)
@@ -263,6 +288,8 @@ void agoAddKernel(AgoKernelList * kernelList, AgoKernel * kernel)
     else kernelList->head = kernel;
     kernelList->tail = kernel;
     kernelList->count++;
+    kernelList->nameIndex.emplace(kernel->name, kernel);
+    kernelList->enumIndex.emplace(kernel->id, kernel);
 }
 
 void agoAddGraph(AgoGraphList * graphList, AgoGraph * graph)
@@ -299,9 +326,28 @@ AgoGraph * agoRemoveGraph(AgoGraphList * list, AgoGraph * item)
     return 0;
 }
 
+static void agoRemoveKernelFromIndex(AgoKernelList * list, AgoKernel * item)
+{
+    auto range = list->nameIndex.equal_range(item->name);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == item) {
+            list->nameIndex.erase(it);
+            break;
+        }
+    }
+    auto erange = list->enumIndex.equal_range(item->id);
+    for (auto it = erange.first; it != erange.second; ++it) {
+        if (it->second == item) {
+            list->enumIndex.erase(it);
+            break;
+        }
+    }
+}
+
 AgoKernel * agoRemoveKernel(AgoKernelList * list, AgoKernel * item)
 {
     if (list->head == item) {
+        agoRemoveKernelFromIndex(list, item);
         if (list->tail == item)
             list->head = list->tail = NULL;
         else
@@ -313,6 +359,7 @@ AgoKernel * agoRemoveKernel(AgoKernelList * list, AgoKernel * item)
     else {
         for (AgoKernel * cur = list->head; cur->next; cur = cur->next) {
             if (cur->next == item) {
+                agoRemoveKernelFromIndex(list, item);
                 if (list->tail == item)
                     list->tail = cur;
                 cur->next = item->next;
@@ -429,6 +476,8 @@ int agoRemoveData(AgoDataList * list, AgoData * item, AgoData ** trash)
         }
     }
     if (status == 0) {
+        agoRemoveDataFromNameIndex(item);
+        item->ownerList = nullptr;
         if (trash) {
             // keep in trash
             item->next = *trash;
@@ -486,7 +535,7 @@ void agoRemoveDataInGraph(AgoGraph * agraph, AgoData * adata)
                     if (dataName[0] && !adata->children[i]->name.length()) {
                         char nameChild[512];
                         sprintf(nameChild, "%s!%d!", dataName, i);
-                        adata->children[i]->name = nameChild;
+                        agoSetDataName(adata->children[i], nameChild);
                     }
                     adata->children[i]->parent = NULL;
                 }
@@ -549,7 +598,7 @@ void agoReplaceDataInGraph(AgoGraph * agraph, AgoData * dataFind, AgoData * data
                 if (dataName[0] && !dataFind->children[i]->name.length()) {
                     char nameChild[512];
                     sprintf(nameChild, "%s!%d!", dataName, i);
-                    dataFind->children[i]->name = nameChild;
+                    agoSetDataName(dataFind->children[i], nameChild);
                 }
                 dataFind->children[i]->parent = dataReplace;
             }
@@ -607,6 +656,11 @@ int agoShutdownNode(AgoNode * node)
             agoReleaseMemory(node->localDataPtr_allocated);
             node->localDataPtr_allocated = nullptr;
         }
+        if (node->bandLocalDataPtr_allocated) {
+            agoReleaseMemory(node->bandLocalDataPtr_allocated);
+            node->bandLocalDataPtr_allocated = nullptr;
+            node->bandLocalDataCount = 0;
+        }
         node->initialized = false;
     }
     return status;
@@ -624,7 +678,7 @@ void agoResetDataList(AgoDataList * dataList)
             data = next;
         }
     }
-    memset(dataList, 0, sizeof(*dataList));
+    *dataList = AgoDataList();
 }
 
 void agoResetNodeList(AgoNodeList * nodeList)
@@ -652,7 +706,7 @@ void agoResetKernelList(AgoKernelList * kernelList)
         // proceed to next item
         kernel = next;
     }
-    memset(kernelList, 0, sizeof(*kernelList));
+    *kernelList = AgoKernelList();
 }
 
 static void agoResetSuperNodeList(AgoSuperNode * supernodeList)
@@ -673,35 +727,47 @@ static void agoResetSuperNodeList(AgoSuperNode * supernodeList)
     }
 }
 
+// returns the item that comes first in the list among the index entries for key
+template <typename T, typename K>
+static T * agoFindIndexedItem(const std::unordered_multimap<K, T *>& index, T * head, const K& key)
+{
+    auto range = index.equal_range(key);
+    if (range.first == range.second)
+        return nullptr;
+    if (std::next(range.first) == range.second)
+        return range.first->second;
+    // duplicate keys are rare: pick the earliest one in list order
+    for (T * item = head; item; item = item->next) {
+        for (auto it = range.first; it != range.second; ++it) {
+            if (it->second == item)
+                return item;
+        }
+    }
+    return nullptr;
+}
+
 AgoKernel * agoFindKernelByEnum(AgoContext * acontext, vx_enum kernel_id)
 {
     // search context
-    for (AgoKernel * kernel = acontext->kernelList.head; kernel; kernel = kernel->next) {
-        if (kernel->id == kernel_id) return kernel;
-    }
-    return 0;
+    return agoFindIndexedItem(acontext->kernelList.enumIndex, acontext->kernelList.head, kernel_id);
 }
 
 AgoKernel * agoFindKernelByName(AgoContext * acontext, const vx_char * name)
 {
     // search context
-    for (AgoKernel * kernel = acontext->kernelList.head; kernel; kernel = kernel->next) {
-        if (!strcmp(kernel->name, name)) return kernel;
-    }
-    if (!strstr(name, ".")) {
+    AgoKernel * kernel = agoFindIndexedItem(acontext->kernelList.nameIndex, acontext->kernelList.head, std::string(name));
+    if (!kernel && !strstr(name, ".")) {
         char fullName[VX_MAX_KERNEL_NAME];
         // search for org.khronos.openvx.<name>
         sprintf(fullName, "org.khronos.openvx.%s", name);
-        for (AgoKernel * kernel = acontext->kernelList.head; kernel; kernel = kernel->next) {
-            if (!strcmp(kernel->name, fullName)) return kernel;
-        }
-        // search for org.amd.openvx.<name>
-        sprintf(fullName, "com.amd.openvx.%s", name);
-        for (AgoKernel * kernel = acontext->kernelList.head; kernel; kernel = kernel->next) {
-            if (!strcmp(kernel->name, fullName)) return kernel;
+        kernel = agoFindIndexedItem(acontext->kernelList.nameIndex, acontext->kernelList.head, std::string(fullName));
+        if (!kernel) {
+            // search for org.amd.openvx.<name>
+            sprintf(fullName, "com.amd.openvx.%s", name);
+            kernel = agoFindIndexedItem(acontext->kernelList.nameIndex, acontext->kernelList.head, std::string(fullName));
         }
     }
-    return 0;
+    return kernel;
 }
 
 AgoData * agoFindDataByName(AgoContext * acontext, AgoGraph * agraph, vx_char * name)
@@ -724,16 +790,13 @@ AgoData * agoFindDataByName(AgoContext * acontext, AgoGraph * agraph, vx_char *
     }
     // search graph
     AgoData * data = NULL;
+    const std::string key(actualName);
     if (agraph) {
-        for (data = agraph->dataList.head; data; data = data->next) {
-            if (!strcmp(data->name.c_str(), actualName)) break;
-        }
+        data = agoFindIndexedItem(agraph->dataList.nameIndex, agraph->dataList.head, key);
     }
     if (!data) {
         // search context
-        for (data = acontext->dataList.head; data; data = data->next) {
-            if (!strcmp(data->name.c_str(), actualName)) break;
-        }
+        data = agoFindIndexedItem(acontext->dataList.nameIndex, acontext->dataList.head, key);
     }
     if(data) {
         for (int i = 0; i < 4 && index[i] >= 0; i++) {
@@ -2758,10 +2821,7 @@ void agoRetainData(AgoGraph * graph, AgoData * data, bool isForExternalUse)
         }
         if (foundInTrash) {
             // add the data into main part of the list
-            data->next = graph->dataList.tail;
-            graph->dataList.tail = data;
-            if (!graph->dataList.head)
-                graph->dataList.head = data;
+            agoAddData(&graph->dataList, data);
         }
     }
 }
@@ -3055,6 +3115,10 @@ void agoPerfProfileEntry(AgoGraph * graph, AgoProfileEntryType type, vx_referenc
         entry.ref = ref;
         entry.time = agoGetClockCounter();
         graph->performance_profile.push_back(entry);
+        agoTraceProfileEntry(entry.id, type, ref, entry.time);
+    }
+    else if (agoTraceIsEnabled()) {
+        agoTraceProfileEntry(graph->execFrameCount, type, ref, agoGetClockCounter());
     }
 }
 
@@ -3158,7 +3222,7 @@ AgoData::AgoData()
 #elif ENABLE_HIP
       hip_memory { nullptr}, hip_memory_allocated{nullptr},
 #endif
-      gpu_buffer_offset{ 0 }, alias_data{ nullptr }, alias_offset{ 0 },
+      gpu_buffer_offset{ 0 }, alias_data{ nullptr }, alias_offset{ 0 }, ownerList{ nullptr },
       isVirtual{ vx_false_e }, isDelayed{ vx_false_e }, isNotFullyConfigured{ vx_false_e }, isInitialized{ vx_false_e }, siblingIndex{ 0 },
       numChildren{ 0 }, children{ nullptr }, parent{ nullptr }, inputUsageCount{ 0 }, outputUsageCount{ 0 }, inoutUsageCount{ 0 },
       initialization_flags{ 0 }, device_type_unused{ 0 },
@@ -3228,7 +3292,7 @@ AgoSuperNode::~AgoSuperNode()
 {
 }
 AgoNode::AgoNode()
-    : next{ nullptr }, akernel{ nullptr }, flags{ 0 }, localDataSize{ 0 }, localDataPtr{ nullptr }, localDataPtr_allocated{ nullptr },
+    : next{ nullptr }, akernel{ nullptr }, flags{ 0 }, localDataSize{ 0 }, localDataPtr{ nullptr }, localDataPtr_allocated{ nullptr }, bandLocalDataPtr_allocated{ nullptr }, bandLocalDataCount{ 0 },
       valid_rect_reset{ vx_true_e }, valid_rect_num_inputs{ 0 }, valid_rect_num_outputs{ 0 }, valid_rect_inputs{ nullptr }, valid_rect_outputs{ nullptr },
       paramCount{ 0 }, callback{ nullptr }, supernode{ nullptr }, initialized{ false }, target_support_flags{ 0 }, hierarchical_level{ 0 }, status{ VX_SUCCESS }
     , drama_divide_invoked{ false }
@@ -3282,7 +3346,8 @@ AgoGraph::AgoGraph()
     : next{ nullptr }, hThread{ nullptr }, hSemToThread{ nullptr }, hSemFromThread{ nullptr },
       threadScheduleCount{ 0 }, threadExecuteCount{ 0 }, threadWaitCount{ 0 }, threadThreadTerminationState{ 0 },
       isReadyToExecute{ vx_false_e }, detectedInvalidNode{ false }, status{ VX_SUCCESS },
-      virtualDataGenerationCount{ 0 }, optimizer_flags{ AGO_GRAPH_OPTIMIZER_FLAGS_DEFAULT }, verified{ false }, enable_performance_profiling{ false }, execFrameCount{ 0 }
+      virtualDataGenerationCount{ 0 }, optimizer_flags{ AGO_GRAPH_OPTIMIZER_FLAGS_DEFAULT }, verified{ false }, cpu_buffer_arena{ nullptr }, cpu_buffer_arena_size{ 0 }, cpu_buffer_bytes_saved{ 0 },
+      enable_performance_profiling{ false }, execFrameCount{ 0 }, schedule_mode{ VX_GRAPH_SCHEDULE_MODE_NORMAL }, pipeline{ nullptr }
 #if ENABLE_OPENCL
     , supernodeList{ nullptr }, opencl_cmdq{ nullptr }, opencl_device{ nullptr }
     , enable_node_level_gpu_flush{ true }
@@ -3290,7 +3355,6 @@ AgoGraph::AgoGraph()
     , supernodeList{ nullptr }, hip_stream0{ nullptr }
 #endif
 {
-    memset(&dataList, 0, sizeof(dataList));
     memset(&nodeList, 0, sizeof(nodeList));
     memset(&perf, 0, sizeof(perf));
     memset(&gpu_perf, 0, sizeof(gpu_perf));
@@ -3316,6 +3380,10 @@ AgoGraph::~AgoGraph()
     }
 
     agoResetNodeList(&nodeList);
+    if (cpu_buffer_arena) {
+        agoReleaseMemory(cpu_buffer_arena);
+        cpu_buffer_arena = nullptr;
+    }
 #if ENABLE_OPENCL
     agoResetSuperNodeList(supernodeList);
     supernodeList = NULL;
@@ -3332,7 +3400,7 @@ AgoGraph::~AgoGraph()
 AgoContext::AgoContext()
     : perfNormFactor{ 0 }, dataGenerationCount{ 0 }, nextUserStructId{ VX_TYPE_USER_STRUCT_START }, nextUserKernelId{ 0 }, nextUserLibraryId{ 1 },
       num_active_modules{ 0 }, num_active_references{ 0 }, callback_log{ nullptr }, callback_reentrant{ vx_false_e },
-      thread_config{ CONFIG_THREAD_DEFAULT }, importing_module_index_plus1{ 0 }, graph_garbage_data{ nullptr }, graph_garbage_node{ nullptr }, graph_garbage_list{ nullptr }
+      thread_config{ CONFIG_THREAD_DEFAULT }, cpu_thread_count{ 0 }, cpu_thread_pool{ nullptr }, num_executing_graphs{ 0 }, cpu_isa{ VX_AMD_CPU_ISA_SSE4_2 }, importing_module_index_plus1{ 0 }, graph_garbage_data{ nullptr }, graph_garbage_node{ nullptr }, graph_garbage_list{ nullptr }, event_enabled{ true }
 #if ENABLE_OPENCL
 #if defined(CL_VERSION_2_0)
       , opencl_svmcaps{ 0 }
@@ -3346,8 +3414,6 @@ AgoContext::AgoContext()
 
 #endif
 {
-    memset(&kernelList, 0, sizeof(kernelList));
-    memset(&dataList, 0, sizeof(dataList));
     memset(&graphList, 0, sizeof(graphList));
     memset(&immediate_border_mode, 0, sizeof(immediate_border_mode));
     memset(&extensions, 0, sizeof(extensions));
@@ -3357,6 +3423,7 @@ AgoContext::AgoContext()
     memset(&opencl_build_options, 0, sizeof(opencl_build_options));
 #endif
     memset(&attr_affinity, 0, sizeof(attr_affinity));
+    HafCpu_SelectDispatch(&haf_cpu, cpu_isa);
     // critical section
     InitializeCriticalSection(&cs);
     // initialize constants as enumerations with name "!<name>"
@@ -3388,6 +3455,11 @@ AgoContext::~AgoContext()
         agraph = next;
     }
 
+    if (cpu_thread_pool) {
+        delete cpu_thread_pool;
+        cpu_thread_pool = nullptr;
+    }
+
     for (AgoNode * node = graph_garbage_node; node;) {
         AgoNode * item = node;
         node = node->next;
@@ -3401,6 +3473,9 @@ AgoContext::~AgoContext()
     }
 
     agoResetDataList(&dataList);
+    for (auto it = exported_memory_list.begin(); it != exported_memory_list.end(); it++) {
+        delete[] *it;
+    }
     for (AgoData * data = graph_garbage_data; data;) {
         AgoData * item = data;
         data = data->next;
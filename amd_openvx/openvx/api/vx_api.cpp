@@ -126,6 +126,41 @@ VX_API_ENTRY vx_status VX_API_CALL vxGetContextImageFormatDescription(vx_context
     return status;
 }
 
+/**
+* \brief Add an interval of the calling thread to the process trace.
+* \ingroup vx_framework_reference
+* \param [in] name The name of the interval.
+* \param [in] category The category of the interval.
+* \param [in] begin_ns The start time in nanoseconds of std::chrono::high_resolution_clock.
+* \param [in] end_ns The end time in nanoseconds of std::chrono::high_resolution_clock.
+* \return A \ref vx_status_e enumeration.
+* \retval VX_SUCCESS No errors.
+* \retval VX_ERROR_INVALID_PARAMETERS if name or category is NULL.
+*/
+VX_API_ENTRY vx_status VX_API_CALL vxAddTraceEvent(const vx_char * name, const vx_char * category, vx_int64 begin_ns, vx_int64 end_ns)
+{
+    if (!name || !category)
+        return VX_ERROR_INVALID_PARAMETERS;
+    agoTraceAddEvent(name, category, begin_ns, end_ns);
+    return VX_SUCCESS;
+}
+
+/**
+* \brief Set the name of the calling thread in the process trace.
+* \ingroup vx_framework_reference
+* \param [in] name The name of the thread.
+* \return A \ref vx_status_e enumeration.
+* \retval VX_SUCCESS No errors.
+* \retval VX_ERROR_INVALID_PARAMETERS if name is NULL.
+*/
+VX_API_ENTRY vx_status VX_API_CALL vxSetTraceThreadName(const vx_char * name)
+{
+    if (!name)
+        return VX_ERROR_INVALID_PARAMETERS;
+    agoTraceSetThreadName(name);
+    return VX_SUCCESS;
+}
+
 /*! \brief Retrieves the context from any reference from within a context.
 * \param [in] reference The reference from which to extract the context.
 * \ingroup group_context
@@ -256,6 +291,19 @@ VX_API_ENTRY vx_status VX_API_CALL vxQueryContext(vx_context context, vx_enum at
                     status = VX_SUCCESS;
                 }
                 break;
+            case VX_CONTEXT_ATTRIBUTE_AMD_CPU_THREAD_COUNT:
+                if (size == sizeof(vx_uint32)) {
+                    std::lock_guard<std::mutex> lock(context->cpu_thread_pool_lock);
+                    *(vx_uint32 *)ptr = context->cpu_thread_pool ? context->cpu_thread_pool->getThreadCount() : 1;
+                    status = VX_SUCCESS;
+                }
+                break;
+            case VX_CONTEXT_ATTRIBUTE_AMD_CPU_ISA:
+                if (size == sizeof(vx_enum)) {
+                    *(vx_enum *)ptr = context->cpu_isa;
+                    status = VX_SUCCESS;
+                }
+                break;
 #if ENABLE_OPENCL
             case VX_CONTEXT_ATTRIBUTE_AMD_OPENCL_CONTEXT:
                 if (size == sizeof(cl_context)) {
@@ -388,6 +436,24 @@ VX_API_ENTRY vx_status VX_API_CALL vxSetContextAttribute(vx_context context, vx_
                 context->attr_affinity = *(AgoTargetAffinityInfo_ *)ptr;
             }
             break;
+        case VX_CONTEXT_ATTRIBUTE_AMD_CPU_THREAD_COUNT:
+            if(!ptr) return VX_ERROR_INVALID_PARAMETERS;
+            if (size == sizeof(vx_uint32)) {
+                status = agoSetCpuThreadCount(context, *(vx_uint32 *)ptr);
+            }
+            break;
+        case VX_CONTEXT_ATTRIBUTE_AMD_CPU_ISA:
+            if(!ptr) return VX_ERROR_INVALID_PARAMETERS;
+            if (size == sizeof(vx_enum)) {
+                status = agoSetCpuIsa(context, *(vx_enum *)ptr);
+            }
+            break;
+        case VX_CONTEXT_ATTRIBUTE_AMD_TRACE_FILE:
+            if(!ptr) return VX_ERROR_INVALID_PARAMETERS;
+            if (size > 0 && ((const vx_char *)ptr)[size - 1] == '\0') {
+                status = agoTraceOpen((const vx_char *)ptr);
+            }
+            break;
 #if ENABLE_OPENCL
         case VX_CONTEXT_ATTRIBUTE_AMD_OPENCL_CONTEXT:
             if(!ptr) return VX_ERROR_INVALID_PARAMETERS;
@@ -2962,8 +3028,18 @@ VX_API_ENTRY vx_status VX_API_CALL vxVerifyGraph(vx_graph graph)
 #endif
     }
 
+        // replicate the graph for queued graph parameters before the graph gets optimized
+        status = VX_SUCCESS;
+        if (graph->schedule_mode != VX_GRAPH_SCHEDULE_MODE_NORMAL) {
+            status = agoGraphPipelinePrepare(graph);
+        }
+        else {
+            agoGraphPipelineRelease(graph);
+        }
+
         // verify graph per OpenVX specification
-        status = agoVerifyGraph(graph);
+        if (status == VX_SUCCESS)
+            status = agoVerifyGraph(graph);
         if (status == VX_SUCCESS) {
             // run graph optimizer
             if (agoOptimizeGraph(graph)) {
@@ -2979,6 +3055,13 @@ VX_API_ENTRY vx_status VX_API_CALL vxVerifyGraph(vx_graph graph)
             }
             graph->verified = vx_true_e;
             graph->state = VX_GRAPH_STATE_VERIFIED;
+            // start the graph instances that execute the frames of queued graph parameters
+            if (status == VX_SUCCESS && graph->pipeline) {
+                status = agoGraphPipelineStart(graph);
+            }
+        }
+        if (status != VX_SUCCESS) {
+            agoGraphPipelineRelease(graph);
         }
 
         if (ago_graph_dump) {
@@ -3075,7 +3158,12 @@ VX_API_ENTRY vx_status VX_API_CALL vxQueryGraph(vx_graph graph, vx_enum attribut
                 break;
             case VX_GRAPH_ATTRIBUTE_PERFORMANCE:
                 if (size == sizeof(vx_perf_t)) {
-                    agoPerfCopyNormalize(graph->ref.context, (vx_perf_t *)ptr, &graph->perf);
+                    if (graph->pipeline) {
+                        std::lock_guard<std::mutex> plock(graph->pipeline->lock);
+                        agoPerfCopyNormalize(graph->ref.context, (vx_perf_t *)ptr, &graph->pipeline->perf);
+                    }
+                    else
+                        agoPerfCopyNormalize(graph->ref.context, (vx_perf_t *)ptr, &graph->perf);
                     status = VX_SUCCESS;
                 }
                 break;
@@ -3097,6 +3185,24 @@ VX_API_ENTRY vx_status VX_API_CALL vxQueryGraph(vx_graph graph, vx_enum attribut
                     status = VX_SUCCESS;
                 }
                 break;
+            case VX_GRAPH_ATTRIBUTE_AMD_CPU_BUFFER_BYTES_SAVED:
+                if (size == sizeof(vx_size)) {
+                    *(vx_size *)ptr = graph->cpu_buffer_bytes_saved;
+                    status = VX_SUCCESS;
+                }
+                break;
+            case VX_GRAPH_SCHEDULE_MODE:
+                if (size == sizeof(vx_enum)) {
+                    *(vx_enum *)ptr = graph->schedule_mode;
+                    status = VX_SUCCESS;
+                }
+                break;
+            case VX_GRAPH_ATTRIBUTE_AMD_PIPELINE_DEPTH:
+                if (size == sizeof(vx_uint32)) {
+                    *(vx_uint32 *)ptr = graph->pipeline ? (vx_uint32)graph->pipeline->instances.size() : 1;
+                    status = VX_SUCCESS;
+                }
+                break;
             case VX_GRAPH_ATTRIBUTE_AMD_AFFINITY:
                 if (size == sizeof(AgoTargetAffinityInfo_)) {
                     *(AgoTargetAffinityInfo_ *)ptr = graph->attr_affinity;
@@ -3315,6 +3421,368 @@ VX_API_ENTRY vx_bool VX_API_CALL vxIsGraphVerified(vx_graph graph)
     return verified;
 }
 
+/*==============================================================================
+PIPELINING
+=============================================================================*/
+
+/*! \brief Sets the graph scheduler config.
+* \details Queued graph parameters are executed with up to <tt>\ref VX_GRAPH_ATTRIBUTE_AMD_PIPELINE_DEPTH</tt>
+* frames in flight. After <tt>\ref vxVerifyGraph</tt>, only the refs_list of the same configuration can be supplied.
+* \param [in] graph Graph reference
+* \param [in] graph_schedule_mode Graph schedule mode. See <tt>\ref vx_graph_schedule_mode_type_e</tt>
+* \param [in] graph_parameters_list_size Number of elements in graph_parameters_queue_params_list
+* \param [in] graph_parameters_queue_params_list Array containing queuing properties at graph parameters that need to support queueing.
+* \return A <tt>\ref vx_status_e</tt> enumeration.
+* \retval VX_SUCCESS No errors.
+* \retval VX_ERROR_INVALID_REFERENCE graph is not a valid reference
+* \retval VX_ERROR_INVALID_PARAMETERS Invalid graph parameter queueing parameters
+* \retval VX_FAILURE Any other failure.
+* \ingroup group_pipelining
+*/
+VX_API_ENTRY vx_status VX_API_CALL vxSetGraphScheduleConfig(vx_graph graph, vx_enum graph_schedule_mode, vx_uint32 graph_parameters_list_size, const vx_graph_parameter_queue_params_t graph_parameters_queue_params_list[])
+{
+    vx_status status = VX_ERROR_INVALID_REFERENCE;
+    if (agoIsValidGraph(graph)) {
+        CAgoLock lock(graph->cs);
+        status = agoGraphSetScheduleConfig(graph, graph_schedule_mode, graph_parameters_list_size, graph_parameters_queue_params_list);
+    }
+    return status;
+}
+
+/*! \brief Enqueues new references into a graph parameter for processing.
+* \details In <tt>\ref VX_GRAPH_SCHEDULE_MODE_QUEUE_AUTO</tt> mode, a frame is launched as soon as all the
+* queued graph parameters have a reference enqueued.
+* \param [in] graph Graph reference
+* \param [in] graph_parameter_index Graph parameter index
+* \param [in] refs The array of references to enqueue into the graph parameter
+* \param [in] num_refs Number of references to enqueue
+* \return A <tt>\ref vx_status_e</tt> enumeration.
+* \retval VX_SUCCESS No errors.
+* \retval VX_ERROR_INVALID_REFERENCE graph is not a valid reference OR reference is not a valid reference
+* \retval VX_ERROR_INVALID_PARAMETERS graph_parameter_index is NOT a valid graph parameter index
+* \retval VX_FAILURE Reference could not be enqueued.
+* \ingroup group_pipelining
+*/
+VX_API_ENTRY vx_status VX_API_CALL vxGraphParameterEnqueueReadyRef(vx_graph graph, vx_uint32 graph_parameter_index, vx_reference *refs, vx_uint32 num_refs)
+{
+    vx_status status = VX_ERROR_INVALID_REFERENCE;
+    if (agoIsValidGraph(graph)) {
+        status = agoGraphParameterEnqueueReadyRef(graph, graph_parameter_index, refs, num_refs);
+    }
+    return status;
+}
+
+/*! \brief Dequeues 'consumed' references from a graph parameter.
+* \details This API blocks until at least one reference is dequeued.
+* \param [in] graph Graph reference
+* \param [in] graph_parameter_index Graph parameter index
+* \param [out] refs Dequeued references filled in the array
+* \param [in] max_refs Max number of references to dequeue
+* \param [out] num_refs Actual number of references dequeued.
+* \return A <tt>\ref vx_status_e</tt> enumeration.
+* \retval VX_SUCCESS No errors.
+* \retval VX_ERROR_INVALID_REFERENCE graph is not a valid reference
+* \retval VX_ERROR_INVALID_PARAMETERS graph_parameter_index is NOT a valid graph parameter index
+* \retval VX_FAILURE Reference could not be dequeued.
+* \ingroup group_pipelining
+*/
+VX_API_ENTRY vx_status VX_API_CALL vxGraphParameterDequeueDoneRef(vx_graph graph, vx_uint32 graph_parameter_index, vx_reference *refs, vx_uint32 max_refs, vx_uint32 *num_refs)
+{
+    vx_status status = VX_ERROR_INVALID_REFERENCE;
+    if (agoIsValidGraph(graph)) {
+        status = agoGraphParameterDequeueDoneRef(graph, graph_parameter_index, refs, max_refs, num_refs);
+    }
+    return status;
+}
+
+/*! \brief Checks and returns the number of references that are ready for dequeue.
+* \param [in] graph Graph reference
+* \param [in] graph_parameter_index Graph parameter index
+* \param [out] num_refs Number of references that can be dequeued using <tt>\ref vxGraphParameterDequeueDoneRef</tt>
+* \return A <tt>\ref vx_status_e</tt> enumeration.
+* \retval VX_SUCCESS No errors.
+* \retval VX_ERROR_INVALID_REFERENCE graph is not a valid reference
+* \retval VX_ERROR_INVALID_PARAMETERS graph_parameter_index is NOT a valid graph parameter index
+* \ingroup group_pipelining
+*/
+VX_API_ENTRY vx_status VX_API_CALL vxGraphParameterCheckDoneRef(vx_graph graph, vx_uint32 graph_parameter_index, vx_uint32 *num_refs)
+{
+    vx_status status = VX_ERROR_INVALID_REFERENCE;
+    if (agoIsValidGraph(graph)) {
+        status = agoGraphParameterCheckDoneRef(graph, graph_parameter_index, num_refs);
+    }
+    return status;
+}
+
+/*! \brief Waits for any one of the registered events.
+* \param context [in] OpenVX context
+* \param event [out] Data structure which holds information about a received event
+* \param do_not_block [in] When value is vx_true_e API does not block and only checks for the condition
+* \return A <tt>\ref vx_status_e</tt> enumeration.
+* \retval VX_SUCCESS Event received and event information available in 'event'
+* \retval VX_FAILURE No event is received
+* \ingroup group_event
+*/
+VX_API_ENTRY vx_status VX_API_CALL vxWaitEvent(vx_context context, vx_event_t *event, vx_bool do_not_block)
+{
+    vx_status status = VX_ERROR_INVALID_REFERENCE;
+    if (agoIsValidContext(context)) {
+        status = VX_ERROR_INVALID_PARAMETERS;
+        if (event) {
+            status = agoWaitEvent(context, event, do_not_block ? true : false);
+        }
+    }
+    return status;
+}
+
+/*! \brief Enable event generation. Events are enabled by default.
+* \param context [in] OpenVX context
+* \return A <tt>\ref vx_status_e</tt> enumeration.
+* \retval VX_SUCCESS No errors; any other value indicates failure.
+* \ingroup group_event
+*/
+VX_API_ENTRY vx_status VX_API_CALL vxEnableEvents(vx_context context)
+{
+    vx_status status = VX_ERROR_INVALID_REFERENCE;
+    if (agoIsValidContext(context)) {
+        std::lock_guard<std::mutex> lock(context->event_lock);
+        context->event_enabled = true;
+        status = VX_SUCCESS;
+    }
+    return status;
+}
+
+/*! \brief Disable event generation. Events that are already queued are still returned by <tt>\ref vxWaitEvent</tt>.
+* \param context [in] OpenVX context
+* \return A <tt>\ref vx_status_e</tt> enumeration.
+* \retval VX_SUCCESS No errors; any other value indicates failure.
+* \ingroup group_event
+*/
+VX_API_ENTRY vx_status VX_API_CALL vxDisableEvents(vx_context context)
+{
+    vx_status status = VX_ERROR_INVALID_REFERENCE;
+    if (agoIsValidContext(context)) {
+        std::lock_guard<std::mutex> lock(context->event_lock);
+        context->event_enabled = false;
+        status = VX_SUCCESS;
+    }
+    return status;
+}
+
+/*! \brief Generate user defined event.
+* \param context [in] OpenVX context
+* \param app_value [in] Application-specified value that will be returned to user as part of vx_event_t.app_value
+* \param parameter [in] User defined event parameter returned as vx_event_t.event_info.user_event.user_event_parameter
+* \return A <tt>\ref vx_status_e</tt> enumeration.
+* \retval VX_SUCCESS No errors; any other value indicates failure.
+* \ingroup group_event
+*/
+VX_API_ENTRY vx_status VX_API_CALL vxSendUserEvent(vx_context context, vx_uint32 app_value, void *parameter)
+{
+    vx_status status = VX_ERROR_INVALID_REFERENCE;
+    if (agoIsValidContext(context)) {
+        vx_event_info_t info;
+        memset(&info, 0, sizeof(info));
+        info.user_event.user_event_parameter = parameter;
+        agoPostEvent(context, VX_EVENT_USER, app_value, info);
+        status = VX_SUCCESS;
+    }
+    return status;
+}
+
+/*! \brief Register an event to be generated. This API must be called before <tt>\ref vxVerifyGraph</tt>.
+* \details Graph parameter events can be registered on the graph or on the graph parameter. Events of a
+* frame are generated when the frame completes, in the order the frames were launched.
+* \param ref [in] Reference which will generate the event
+* \param type [in] Type or condition on which the event is generated
+* \param param [in] Specifies the graph parameter index when type is VX_EVENT_GRAPH_PARAMETER_CONSUMED
+* \param app_value [in] Application-specified value that will be returned to user as part of \ref vx_event_t.app_value.
+* \return A <tt>\ref vx_status_e</tt> enumeration.
+* \retval VX_SUCCESS No errors; any other value indicates failure.
+* \retval VX_ERROR_INVALID_REFERENCE ref is not a valid <tt>\ref vx_reference</tt> reference.
+* \retval VX_ERROR_NOT_SUPPORTED type is not valid for the provided reference.
+* \ingroup group_event
+*/
+VX_API_ENTRY vx_status VX_API_CALL vxRegisterEvent(vx_reference ref, enum vx_event_type_e type, vx_uint32 param, vx_uint32 app_value)
+{
+    vx_status status = VX_ERROR_INVALID_REFERENCE;
+    if (agoIsValidReference(ref)) {
+        status = agoRegisterEvent(ref, type, param, app_value);
+    }
+    return status;
+}
+
+/*==============================================================================
+IMPORT/EXPORT
+=============================================================================*/
+
+/*! \brief Exports selected objects to memory in a vendor-specific format.
+* \details Graphs are verified if needed and exported in their optimized form, so that
+* <tt>\ref vxImportObjectsFromMemory</tt> doesn't have to run the graph optimizer again.
+* \param [in] context context from which to export objects.
+* \param [in] numrefs number of references to export.
+* \param [in] refs references to export.
+* \param [in] uses how to export the references, see <tt>\ref vx_ix_use_e</tt>.
+* \param [out] ptr returns pointer to binary buffer. On error this is set to NULL.
+* \param [out] length number of bytes at \*ptr. On error this is set to zero.
+* \return A <tt>\ref vx_status_e</tt> enumeration.
+* \retval VX_SUCCESS No errors.
+* \retval VX_ERROR_INVALID_REFERENCE context or any of refs is not a valid reference
+* \retval VX_ERROR_INVALID_PARAMETERS Invalid parameters
+* \retval VX_FAILURE Any other failure.
+* \ingroup group_import
+*/
+VX_API_ENTRY vx_status VX_API_CALL vxExportObjectsToMemory(vx_context context, vx_size numrefs, const vx_reference *refs, const vx_enum * uses, const vx_uint8 ** ptr, vx_size * length)
+{
+    vx_status status = VX_ERROR_INVALID_REFERENCE;
+    if (ptr) *ptr = nullptr;
+    if (length) *length = 0;
+    if (agoIsValidContext(context)) {
+        status = VX_ERROR_INVALID_PARAMETERS;
+        if (numrefs > 0 && refs && uses && ptr && length) {
+            status = VX_SUCCESS;
+            for (vx_size i = 0; i < numrefs && status == VX_SUCCESS; i++) {
+                if (!agoIsValidReference(refs[i]) || refs[i]->context != context)
+                    status = VX_ERROR_INVALID_REFERENCE;
+                else if (refs[i]->type == VX_TYPE_GRAPH && !((vx_graph)refs[i])->verified)
+                    status = vxVerifyGraph((vx_graph)refs[i]);
+            }
+            if (status == VX_SUCCESS) {
+                CAgoLock lock(context->cs);
+                if (agoExportObjects(context, numrefs, refs, uses, ptr, length))
+                    status = VX_FAILURE;
+            }
+        }
+    }
+    return status;
+}
+
+/*! \brief Releases memory allocated for a binary export when it is no longer required.
+* \param [in] context The context for which <tt>\ref vxExportObjectsToMemory</tt> was called.
+* \param [in,out] ptr A pointer previously set by calling <tt>\ref vxExportObjectsToMemory</tt>.
+* \return A <tt>\ref vx_status_e</tt> enumeration.
+* \retval VX_SUCCESS No errors.
+* \retval VX_ERROR_INVALID_REFERENCE context is not a valid reference
+* \retval VX_ERROR_INVALID_PARAMETERS *ptr was not allocated by <tt>\ref vxExportObjectsToMemory</tt>
+* \ingroup group_import
+*/
+VX_API_ENTRY vx_status VX_API_CALL vxReleaseExportedMemory(vx_context context, const vx_uint8 ** ptr)
+{
+    vx_status status = VX_ERROR_INVALID_REFERENCE;
+    if (agoIsValidContext(context)) {
+        status = VX_ERROR_INVALID_PARAMETERS;
+        CAgoLock lock(context->cs);
+        if (ptr && *ptr && !agoReleaseExportedMemory(context, *ptr)) {
+            *ptr = nullptr;
+            status = VX_SUCCESS;
+        }
+    }
+    return status;
+}
+
+/*! \brief Imports objects into a context from a vendor-specific format in memory.
+* \details The imported graphs are verified without running the graph optimizer: the nodes
+* are already the ones selected before export.
+* \param [in] context context into which to import objects.
+* \param [in] numrefs number of references to import, must match export.
+* \param [in,out] refs references imported or application-created data which must match
+* meta-data of the export.
+* \param [in] uses how to import the references, must match export values.
+* \param [in] ptr pointer to binary buffer containing a valid binary export.
+* \param [in] length number of bytes at \*ptr, i.e. the length of the export.
+* \return A <tt>\ref vx_import</tt>. Any possible errors preventing a successful import
+* should be checked using <tt>\ref vxGetStatus</tt>.
+* \ingroup group_import
+*/
+VX_API_ENTRY vx_import VX_API_CALL vxImportObjectsFromMemory(vx_context context, vx_size numrefs, vx_reference *refs, const vx_enum * uses, const vx_uint8 * ptr, vx_size length)
+{
+    AgoImport * import = nullptr;
+    if (agoIsValidContext(context) && numrefs > 0 && refs && uses && ptr) {
+        CAgoLock lock(context->cs);
+        if (!agoImportObjects(context, numrefs, refs, uses, ptr, length)) {
+            vx_status status = VX_SUCCESS;
+            for (vx_size i = 0; i < numrefs && status == VX_SUCCESS; i++) {
+                if (refs[i]->type == VX_TYPE_GRAPH)
+                    status = vxVerifyGraph((vx_graph)refs[i]);
+            }
+            if (status == VX_SUCCESS) {
+                import = new AgoImport;
+                agoResetReference(&import->ref, VX_TYPE_IMPORT, context, NULL);
+                import->ref.external_count = 1;
+                context->num_active_references++;
+                for (vx_size i = 0; i < numrefs; i++) {
+                    vxRetainReference(refs[i]);
+                    import->refs.push_back(refs[i]);
+                }
+            }
+            else {
+                for (vx_size i = 0; i < numrefs; i++) {
+                    if (refs[i]->type == VX_TYPE_GRAPH || uses[i] != VX_IX_USE_APPLICATION_CREATE) {
+                        vxReleaseReference(&refs[i]);
+                        refs[i] = nullptr;
+                    }
+                }
+            }
+        }
+    }
+    return import;
+}
+
+/*! \brief Releases an import object when no longer required.
+* \param [in,out] import The pointer to the reference to the import object.
+* \post After returning from this function the reference is zeroed.
+* \return A <tt>\ref vx_status_e</tt> enumeration.
+* \retval VX_SUCCESS No errors.
+* \retval VX_ERROR_INVALID_REFERENCE import is not a valid <tt>\ref vx_import</tt> reference.
+* \ingroup group_import
+*/
+VX_API_ENTRY vx_status VX_API_CALL vxReleaseImport(vx_import *import)
+{
+    vx_status status = VX_ERROR_INVALID_REFERENCE;
+    if (import && agoIsValidReference((vx_reference)*import) && (*import)->ref.type == VX_TYPE_IMPORT) {
+        AgoImport * aimport = *import;
+        aimport->ref.external_count--;
+        aimport->ref.context->num_active_references--;
+        if (aimport->ref.external_count == 0) {
+            for (auto it = aimport->refs.begin(); it != aimport->refs.end(); it++) {
+                vx_reference ref = *it;
+                vxReleaseReference(&ref);
+            }
+            delete aimport;
+        }
+        *import = nullptr;
+        status = VX_SUCCESS;
+    }
+    return status;
+}
+
+/*! \brief Get a reference from the import object by name.
+* \param [in] import The import object in which to find the name.
+* \param [in] name The name to find.
+* \return A <tt>\ref vx_reference</tt>. Any possible errors preventing a successful
+* lookup should be checked using <tt>\ref vxGetStatus</tt>.
+* \ingroup group_import
+*/
+VX_API_ENTRY vx_reference VX_API_CALL vxGetImportReferenceByName(vx_import import, const vx_char *name)
+{
+    vx_reference ref = nullptr;
+    if (agoIsValidReference((vx_reference)import) && import->ref.type == VX_TYPE_IMPORT && name && name[0]) {
+        vx_uint32 count = 0;
+        for (auto it = import->refs.begin(); it != import->refs.end(); it++) {
+            const std::string& refName = ((*it)->type == VX_TYPE_GRAPH) ? ((AgoGraph *)*it)->name : ((AgoData *)*it)->name;
+            if (refName == name) {
+                ref = *it;
+                count++;
+            }
+        }
+        if (count == 1)
+            vxRetainReference(ref);
+        else
+            ref = nullptr;
+    }
+    return ref;
+}
+
 /*==============================================================================
 NODE
 =============================================================================*/
@@ -4455,6 +4923,9 @@ VX_API_ENTRY vx_status VX_API_CALL vxReleaseReference(vx_reference* ref_ptr)
             case VX_TYPE_PARAMETER:
                 status = vxReleaseParameter((vx_parameter *)ref_ptr);
                 break;
+            case VX_TYPE_IMPORT:
+                status = vxReleaseImport((vx_import *)ref_ptr);
+                break;
             case VX_TYPE_DELAY:
                 status = vxReleaseDelay((vx_delay *)ref_ptr);
                 break;
@@ -4557,7 +5028,7 @@ VX_API_ENTRY vx_status VX_API_CALL vxSetReferenceName(vx_reference ref, const vx
         //printf("%s %s %lu\n", data->name.c_str(), name, strlen(name));
         //printf("before:::strlen(data name) = %lu\n", data->name.length());
         //data->name.assign(name, strlen(name));
-        data->name = name;
+        agoSetDataName(data, name);
         //std::copy(name, name + strlen(name), std::back_inserter(data->name));
         //strncpy((char *)data->name.c_str(), name, strnlen(name, VX_MAX_REFERENCE_NAME));
         //data->name.assign("name", 4);
@@ -8113,6 +8584,62 @@ VX_API_ENTRY vx_status VX_API_CALL vxQueryArray(vx_array arr, vx_enum attribute,
                     status = VX_SUCCESS;
                 }
                 break;
+            case VX_ARRAY_BUFFER:
+                if (size == sizeof(vx_uint8 *)) {
+                    if (data->isVirtual && !data->buffer) {
+                        status = VX_ERROR_OPTIMIZED_AWAY;
+                    }
+                    else {
+                        if (!data->buffer) {
+                            CAgoLock lock(data->ref.context->cs);
+                            if (agoAllocData(data)) {
+                                return VX_FAILURE;
+                            }
+                        }
+#if ENABLE_OPENCL
+                        if (data->opencl_buffer && !(data->buffer_sync_flags & AGO_BUFFER_SYNC_FLAG_DIRTY_SYNCHED)) {
+                            // make sure a buffer written by a GPU node is synched before handing out the host pointer
+                            if (data->buffer_sync_flags & (AGO_BUFFER_SYNC_FLAG_DIRTY_BY_NODE_CL)) {
+                                vx_size bufSize = data->u.arr.itemsize * data->u.arr.numitems;
+                                if (bufSize > 0) {
+                                    cl_int err = clEnqueueReadBuffer(data->ref.context->opencl_cmdq, data->opencl_buffer, CL_TRUE, data->gpu_buffer_offset, bufSize, data->buffer, 0, NULL, NULL);
+                                    if (err) {
+                                        status = VX_FAILURE;
+                                        agoAddLogEntry(&data->ref, status, "ERROR: vxQueryArray: VX_ARRAY_BUFFER: clEnqueueReadBuffer() => %d\n", err);
+                                        return status;
+                                    }
+                                }
+                                data->buffer_sync_flags |= AGO_BUFFER_SYNC_FLAG_DIRTY_SYNCHED;
+                            }
+                        }
+#elif ENABLE_HIP
+                        if (data->hip_memory && !(data->buffer_sync_flags & AGO_BUFFER_SYNC_FLAG_DIRTY_SYNCHED)) {
+                            // make sure a buffer written by a GPU node is synched before handing out the host pointer
+                            if (data->buffer_sync_flags & (AGO_BUFFER_SYNC_FLAG_DIRTY_BY_NODE_CL)) {
+                                vx_size bufSize = data->u.arr.itemsize * data->u.arr.numitems;
+                                if (bufSize > 0) {
+                                    hipError_t err = hipMemcpyDtoH((void *)data->buffer, (data->hip_memory + data->gpu_buffer_offset), bufSize);
+                                    if (err) {
+                                        status = VX_FAILURE;
+                                        agoAddLogEntry(&data->ref, status, "ERROR: vxQueryArray: VX_ARRAY_BUFFER: hipMemcpyDtoH() => %d\n", err);
+                                        return status;
+                                    }
+                                }
+                                data->buffer_sync_flags |= AGO_BUFFER_SYNC_FLAG_DIRTY_SYNCHED;
+                            }
+                        }
+#endif
+                        *(vx_uint8 **)ptr = data->buffer;
+                        status = VX_SUCCESS;
+                    }
+                }
+                break;
+            case VX_ARRAY_WRITE_COUNT:
+                if (size == sizeof(vx_uint32)) {
+                    *(vx_uint32 *)ptr = data->ref.write_count;
+                    status = VX_SUCCESS;
+                }
+                break;
 #if (ENABLE_OPENCL||ENABLE_HIP)
             case VX_ARRAY_OFFSET_GPU:
                 if (size == sizeof(vx_size)) {
@@ -8250,6 +8777,7 @@ VX_API_ENTRY vx_status VX_API_CALL vxAddArrayItems(vx_array arr, vx_size count,
                 // update sync flags
                 data->buffer_sync_flags &= ~AGO_BUFFER_SYNC_FLAG_DIRTY_MASK;
                 data->buffer_sync_flags |= AGO_BUFFER_SYNC_FLAG_DIRTY_BY_COMMIT;
+                data->ref.write_count++;
             }
             status = VX_SUCCESS;
         }
@@ -8457,6 +8985,7 @@ VX_API_ENTRY vx_status VX_API_CALL vxCommitArrayRange(vx_array arr, vx_size star
                     // update sync flags
                     data->buffer_sync_flags &= ~AGO_BUFFER_SYNC_FLAG_DIRTY_MASK;
                     data->buffer_sync_flags |= AGO_BUFFER_SYNC_FLAG_DIRTY_BY_COMMIT;
+                    data->ref.write_count++;
                 }
             }
         }
@@ -8663,6 +9192,7 @@ VX_API_ENTRY vx_status VX_API_CALL vxUnmapArrayRange(vx_array array, vx_map_id m
                     // update sync flags
                     data->buffer_sync_flags &= ~AGO_BUFFER_SYNC_FLAG_DIRTY_MASK;
                     data->buffer_sync_flags |= AGO_BUFFER_SYNC_FLAG_DIRTY_BY_COMMIT;
+                    data->ref.write_count++;
                 }
                 status = VX_SUCCESS;
                 break;
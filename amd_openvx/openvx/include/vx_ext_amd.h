@@ -109,6 +109,26 @@ enum vx_context_attribute_amd_e {
     VX_CONTEXT_CL_QUEUE_PROPERTIES = VX_ATTRIBUTE_BASE(VX_ID_AMD, VX_TYPE_CONTEXT) + 0x06,
     /*! \brief HIP context. Use a <tt>\ref cl_context</tt> parameter.*/
     VX_CONTEXT_ATTRIBUTE_AMD_HIP_DEVICE = VX_ATTRIBUTE_BASE(VX_ID_AMD, VX_TYPE_CONTEXT) + 0x07,
+    /*! \brief number of CPU threads used to execute independent nodes at the same level of a graph (0 or 1: serial execution). Use a <tt>\ref vx_uint32</tt> parameter.
+     *  Returns VX_ERROR_GRAPH_SCHEDULED while a graph in the context is executing. The default can also be set using bits[15:8] of AGO_THREAD_CONFIG environment variable.*/
+    VX_CONTEXT_ATTRIBUTE_AMD_CPU_THREAD_COUNT = VX_ATTRIBUTE_BASE(VX_ID_AMD, VX_TYPE_CONTEXT) + 0x08,
+    /*! \brief instruction set used by CPU kernels with runtime dispatch. Use a <tt>\ref vx_enum</tt> parameter with <tt>\ref vx_amd_cpu_isa_e</tt> values.
+     *  Defaults to the best level detected by CPUID, capped by AGO_CPU_ISA environment variable (SSE4.2, AVX2, or AVX512). A level not supported by the CPU is rejected.*/
+    VX_CONTEXT_ATTRIBUTE_AMD_CPU_ISA = VX_ATTRIBUTE_BASE(VX_ID_AMD, VX_TYPE_CONTEXT) + 0x09,
+    /*! \brief set the file for the trace of the process in Chrome trace event format (set-only). Use a <tt>\ref vx_char</tt> string parameter with size of the string including the terminating null, an empty string stops the trace.
+     *  The trace is shared by all contexts of the process and can also be started using AGO_TRACE_FILE environment variable.*/
+    VX_CONTEXT_ATTRIBUTE_AMD_TRACE_FILE = VX_ATTRIBUTE_BASE(VX_ID_AMD, VX_TYPE_CONTEXT) + 0x0A,
+};
+
+/*! \brief The AMD CPU instruction set levels for <tt>\ref VX_CONTEXT_ATTRIBUTE_AMD_CPU_ISA</tt>.
+*/
+enum vx_amd_cpu_isa_e {
+    /*! \brief SSE4.2 kernels (baseline, always available).*/
+    VX_AMD_CPU_ISA_SSE4_2 = 0,
+    /*! \brief AVX2 kernels.*/
+    VX_AMD_CPU_ISA_AVX2   = 1,
+    /*! \brief AVX-512 (F and BW) kernels.*/
+    VX_AMD_CPU_ISA_AVX512 = 2,
 };
 
 /*! \brief The AMD kernel attributes list.
@@ -147,6 +167,10 @@ enum vx_graph_attribute_amd_e {
     VX_GRAPH_ATTRIBUTE_AMD_PERFORMANCE_INTERNAL_PROFILE = VX_ATTRIBUTE_BASE(VX_ID_AMD, VX_TYPE_GRAPH) + 0x07,
     /*! \brief OpenCL command queue. Use a <tt>\ref cl_command_queue</tt> parameter.*/
     VX_GRAPH_ATTRIBUTE_AMD_OPENCL_COMMAND_QUEUE         = VX_ATTRIBUTE_BASE(VX_ID_AMD, VX_TYPE_GRAPH) + 0x08,
+    /*! \brief bytes of CPU memory saved by sharing one buffer between virtual images with disjoint lifetimes (read-only, valid after vxVerifyGraph). Use a <tt>\ref vx_size</tt> parameter.*/
+    VX_GRAPH_ATTRIBUTE_AMD_CPU_BUFFER_BYTES_SAVED       = VX_ATTRIBUTE_BASE(VX_ID_AMD, VX_TYPE_GRAPH) + 0x09,
+    /*! \brief number of frames of queued graph parameters that can execute concurrently (read-only, valid after vxVerifyGraph). Use a <tt>\ref vx_uint32</tt> parameter.*/
+    VX_GRAPH_ATTRIBUTE_AMD_PIPELINE_DEPTH               = VX_ATTRIBUTE_BASE(VX_ID_AMD, VX_TYPE_GRAPH) + 0x0A,
 };
 
 /*! \brief The AMD node attributes list.
@@ -201,8 +225,13 @@ enum vx_array_attribute_amd_e {
     /*! \brief OpenCL buffer. <tt>cl_mem</tt>. */
     VX_ARRAY_BUFFER_OPENCL   = VX_ATTRIBUTE_BASE(VX_ID_AMD, VX_TYPE_ARRAY) + 0x9,
     VX_ARRAY_BUFFER_HIP   = VX_ATTRIBUTE_BASE(VX_ID_AMD, VX_TYPE_ARRAY) + 0x10,
+    /*! \brief Host buffer. <tt>vx_uint8 *</tt>. The pointer stays valid for the lifetime of the array and holds
+        the latest items as long as the array is only written from the host, e.g. parameters set with vxCopyArrayRange.
+        If a GPU node has written the array, the query first copies the GPU buffer back to the host. */
     VX_ARRAY_BUFFER    = VX_ATTRIBUTE_BASE(VX_ID_AMD, VX_TYPE_ARRAY ) + 0x11,
-    VX_ARRAY_OFFSET_GPU = VX_ATTRIBUTE_BASE(VX_ID_AMD, VX_TYPE_ARRAY ) + 0x12
+    VX_ARRAY_OFFSET_GPU = VX_ATTRIBUTE_BASE(VX_ID_AMD, VX_TYPE_ARRAY ) + 0x12,
+    /*! \brief Number of times the items were written from the host, e.g. with vxCopyArrayRange. <tt>vx_uint32</tt>. */
+    VX_ARRAY_WRITE_COUNT = VX_ATTRIBUTE_BASE(VX_ID_AMD, VX_TYPE_ARRAY ) + 0x13
 };
 
 /*! \brief These enumerations are given to the \c vxDirective API to enable/disable
@@ -580,6 +609,34 @@ VX_API_ENTRY vx_status VX_API_CALL vxSetContextImageFormatDescription(vx_context
 */
 VX_API_ENTRY vx_status VX_API_CALL vxGetContextImageFormatDescription(vx_context context, vx_df_image format, AgoImageFormatDescription * desc);
 
+/**
+* \brief Add an interval of the calling thread to the process trace.
+* \ingroup vx_framework_reference
+*
+* This function is used by applications to show their own work in the same timeline as the graphs, see <tt>\ref VX_CONTEXT_ATTRIBUTE_AMD_TRACE_FILE</tt>.
+* Nothing is recorded when the trace is not enabled.
+*
+* \param [in] name The name of the interval.
+* \param [in] category The category of the interval.
+* \param [in] begin_ns The start time in nanoseconds of std::chrono::high_resolution_clock::now().time_since_epoch().
+* \param [in] end_ns The end time in nanoseconds of std::chrono::high_resolution_clock::now().time_since_epoch().
+* \return A \ref vx_status_e enumeration.
+* \retval VX_SUCCESS No errors.
+* \retval VX_ERROR_INVALID_PARAMETERS if name or category is NULL.
+*/
+VX_API_ENTRY vx_status VX_API_CALL vxAddTraceEvent(const vx_char * name, const vx_char * category, vx_int64 begin_ns, vx_int64 end_ns);
+
+/**
+* \brief Set the name of the calling thread in the process trace.
+* \ingroup vx_framework_reference
+*
+* \param [in] name The name of the thread.
+* \return A \ref vx_status_e enumeration.
+* \retval VX_SUCCESS No errors.
+* \retval VX_ERROR_INVALID_PARAMETERS if name is NULL.
+*/
+VX_API_ENTRY vx_status VX_API_CALL vxSetTraceThreadName(const vx_char * name);
+
 /* Tensor */
 VX_API_ENTRY vx_tensor VX_API_CALL vxCreateTensorFromHandle(vx_context context, vx_size number_of_dims, const vx_size * dims, vx_enum data_type, vx_int8 fixed_point_position, const vx_size * stride, void * ptr, vx_enum memory_type);
 VX_API_ENTRY vx_status VX_API_CALL vxSwapTensorHandle(vx_tensor tensor, void * new_ptr, void** prev_ptr);
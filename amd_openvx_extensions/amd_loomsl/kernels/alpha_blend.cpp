@@ -52,7 +52,7 @@ static vx_status VX_CALLBACK query_target_support(vx_graph graph, vx_node node,
 	vx_uint32& supported_target_affinity // [output] must be set to AGO_TARGET_AFFINITY_CPU or AGO_TARGET_AFFINITY_GPU or (AGO_TARGET_AFFINITY_CPU | AGO_TARGET_AFFINITY_GPU)
 	)
 {
-	supported_target_affinity = AGO_TARGET_AFFINITY_GPU;
+	supported_target_affinity = AGO_TARGET_AFFINITY_CPU | AGO_TARGET_AFFINITY_GPU;
 	return VX_SUCCESS;
 }
 
@@ -142,7 +142,36 @@ static vx_status VX_CALLBACK opencl_codegen(
 //! \brief The kernel execution.
 static vx_status VX_CALLBACK host_kernel(vx_node node, const vx_reference * parameters, vx_uint32 num)
 {
-	return VX_ERROR_NOT_IMPLEMENTED;
+	// get image dimensions and access all the images: RGB input, RGBX overlay and RGB output
+	vx_uint32 width, height;
+	ERROR_CHECK_STATUS(vxQueryImage((vx_image)parameters[2], VX_IMAGE_WIDTH, &width, sizeof(width)));
+	ERROR_CHECK_STATUS(vxQueryImage((vx_image)parameters[2], VX_IMAGE_HEIGHT, &height, sizeof(height)));
+	vx_rectangle_t rect = { 0, 0, width, height };
+	vx_imagepatch_addressing_t addr[3];
+	vx_uint8 * ptr[3] = { nullptr, nullptr, nullptr };
+	for (vx_uint32 i = 0; i < 3; i++) {
+		ERROR_CHECK_STATUS(vxAccessImagePatch((vx_image)parameters[i], &rect, 0, &addr[i], (void **)&ptr[i], (i == 2) ? VX_WRITE_ONLY : VX_READ_ONLY));
+	}
+
+	// blend the overlay over the input with the overlay alpha
+	const float alpha_normalizer = 1.0f / 255.0f;
+#pragma omp parallel for
+	for (vx_int32 gy = 0; gy < (vx_int32)height; gy++) {
+		const vx_uint8 * i0 = ptr[0] + gy * addr[0].stride_y;
+		const vx_uint8 * i1 = ptr[1] + gy * addr[1].stride_y;
+		vx_uint8 * o0 = ptr[2] + gy * addr[2].stride_y;
+		for (vx_uint32 gx = 0; gx < width; gx++, i0 += 3, i1 += 4, o0 += 3) {
+			float alpha1 = i1[3] * alpha_normalizer, alpha0 = 1.0f - alpha1;
+			o0[0] = StitchPackU8(i0[0] * alpha0 + i1[0] * alpha1);
+			o0[1] = StitchPackU8(i0[1] * alpha0 + i1[1] * alpha1);
+			o0[2] = StitchPackU8(i0[2] * alpha0 + i1[2] * alpha1);
+		}
+	}
+
+	for (vx_uint32 i = 0; i < 3; i++) {
+		ERROR_CHECK_STATUS(vxCommitImagePatch((vx_image)parameters[i], &rect, 0, &addr[i], ptr[i]));
+	}
+	return VX_SUCCESS;
 }
 
 //! \brief The kernel publisher.
@@ -151,10 +180,12 @@ vx_status alpha_blend_publish(vx_context context)
 	// add kernel to the context with callbacks
 	vx_kernel kernel = vxAddUserKernel(context, "com.amd.loomsl.alpha_blend", AMDOVX_KERNEL_STITCHING_ALPHA_BLEND, host_kernel, 2, validate, nullptr, nullptr);
 	ERROR_CHECK_OBJECT(kernel);
+#if ENABLE_OPENCL
 	amd_kernel_query_target_support_f query_target_support_f = query_target_support;
 	amd_kernel_opencl_codegen_callback_f opencl_codegen_callback_f = opencl_codegen;
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_QUERY_TARGET_SUPPORT, &query_target_support_f, sizeof(query_target_support_f)));
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_OPENCL_CODEGEN_CALLBACK, &opencl_codegen_callback_f, sizeof(opencl_codegen_callback_f)));
+#endif
 
 	// set kernel parameters
 	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 0, VX_INPUT, VX_TYPE_IMAGE, VX_PARAMETER_STATE_REQUIRED));
@@ -110,7 +110,7 @@ static vx_status VX_CALLBACK chroma_key_mask_generation_query_target_support(vx_
 	if (StitchGetEnvironmentVariable("CHROMAKEY_MASK", textBuffer, sizeof(textBuffer))) { CHROMAKEY_MASK = atoi(textBuffer); }
 
 	if (!CHROMAKEY_MASK)
-		supported_target_affinity = AGO_TARGET_AFFINITY_GPU;
+		supported_target_affinity = AGO_TARGET_AFFINITY_CPU | AGO_TARGET_AFFINITY_GPU;
 	else
 		supported_target_affinity = AGO_TARGET_AFFINITY_CPU;
 
@@ -321,12 +321,14 @@ vx_status chroma_key_mask_generation_publish(vx_context context)
 		nullptr,
 		nullptr);
 	ERROR_CHECK_OBJECT(kernel);
+#if ENABLE_OPENCL
 	amd_kernel_query_target_support_f query_target_support_f = chroma_key_mask_generation_query_target_support;
 	amd_kernel_opencl_codegen_callback_f opencl_codegen_callback_f = chroma_key_mask_generation_opencl_codegen;
 	amd_kernel_opencl_global_work_update_callback_f opencl_global_work_update_callback_f = chroma_key_mask_generation_opencl_global_work_update;
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_QUERY_TARGET_SUPPORT, &query_target_support_f, sizeof(query_target_support_f)));
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_OPENCL_CODEGEN_CALLBACK, &opencl_codegen_callback_f, sizeof(opencl_codegen_callback_f)));
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_OPENCL_GLOBAL_WORK_UPDATE_CALLBACK, &opencl_global_work_update_callback_f, sizeof(opencl_global_work_update_callback_f)));
+#endif
 
 	// set kernel parameters
 	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 0, VX_INPUT, VX_TYPE_SCALAR, VX_PARAMETER_STATE_REQUIRED));
@@ -438,7 +440,7 @@ static vx_status VX_CALLBACK chroma_key_merge_query_target_support(vx_graph grap
 	if (StitchGetEnvironmentVariable("CHROMAKEY_MERGE", textBuffer, sizeof(textBuffer))) { CHROMAKEY_MERGE = atoi(textBuffer); }
 
 	if (!CHROMAKEY_MERGE)
-		supported_target_affinity = AGO_TARGET_AFFINITY_GPU;
+		supported_target_affinity = AGO_TARGET_AFFINITY_CPU | AGO_TARGET_AFFINITY_GPU;
 	else
 		supported_target_affinity = AGO_TARGET_AFFINITY_CPU;
 
@@ -633,12 +635,14 @@ vx_status chroma_key_merge_publish(vx_context context)
 		nullptr,
 		nullptr);
 	ERROR_CHECK_OBJECT(kernel);
+#if ENABLE_OPENCL
 	amd_kernel_query_target_support_f query_target_support_f = chroma_key_merge_query_target_support;
 	amd_kernel_opencl_codegen_callback_f opencl_codegen_callback_f = chroma_key_merge_opencl_codegen;
 	amd_kernel_opencl_global_work_update_callback_f opencl_global_work_update_callback_f = chroma_key_merge_opencl_global_work_update;
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_QUERY_TARGET_SUPPORT, &query_target_support_f, sizeof(query_target_support_f)));
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_OPENCL_CODEGEN_CALLBACK, &opencl_codegen_callback_f, sizeof(opencl_codegen_callback_f)));
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_OPENCL_GLOBAL_WORK_UPDATE_CALLBACK, &opencl_global_work_update_callback_f, sizeof(opencl_global_work_update_callback_f)));
+#endif
 
 	// set kernel parameters
 	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 0, VX_INPUT, VX_TYPE_IMAGE, VX_PARAMETER_STATE_REQUIRED));
@@ -99,7 +99,7 @@ static vx_status VX_CALLBACK color_convert_query_target_support(vx_graph graph,
 	vx_uint32& supported_target_affinity // [output] must be set to AGO_TARGET_AFFINITY_CPU or AGO_TARGET_AFFINITY_GPU or (AGO_TARGET_AFFINITY_CPU | AGO_TARGET_AFFINITY_GPU)
 	)
 {
-	supported_target_affinity = AGO_TARGET_AFFINITY_GPU;
+	supported_target_affinity = AGO_TARGET_AFFINITY_CPU | AGO_TARGET_AFFINITY_GPU;
 	return VX_SUCCESS;
 }
 
@@ -517,7 +517,96 @@ static vx_status VX_CALLBACK color_convert_opencl_codegen(
 //! \brief The kernel execution.
 static vx_status VX_CALLBACK color_convert_kernel(vx_node node, const vx_reference * parameters, vx_uint32 num)
 {
-	return VX_ERROR_NOT_SUPPORTED;
+	// get input and output image configurations
+	vx_image input_image = (vx_image)parameters[0], output_image = (vx_image)parameters[1];
+	vx_uint32 width = 0, height = 0;
+	vx_df_image input_format = VX_DF_IMAGE_VIRT, output_format = VX_DF_IMAGE_VIRT;
+	vx_channel_range_e input_channel_range;
+	vx_color_space_e input_color_space;
+	ERROR_CHECK_STATUS(vxQueryImage(input_image, VX_IMAGE_ATTRIBUTE_WIDTH, &width, sizeof(width)));
+	ERROR_CHECK_STATUS(vxQueryImage(input_image, VX_IMAGE_ATTRIBUTE_HEIGHT, &height, sizeof(height)));
+	ERROR_CHECK_STATUS(vxQueryImage(input_image, VX_IMAGE_ATTRIBUTE_FORMAT, &input_format, sizeof(input_format)));
+	ERROR_CHECK_STATUS(vxQueryImage(input_image, VX_IMAGE_ATTRIBUTE_RANGE, &input_channel_range, sizeof(input_channel_range)));
+	ERROR_CHECK_STATUS(vxQueryImage(input_image, VX_IMAGE_ATTRIBUTE_SPACE, &input_color_space, sizeof(input_color_space)));
+	ERROR_CHECK_STATUS(vxQueryImage(output_image, VX_IMAGE_ATTRIBUTE_FORMAT, &output_format, sizeof(output_format)));
+	vx_rectangle_t rect = { 0, 0, width, height };
+	vx_imagepatch_addressing_t input_addr, output_addr;
+	vx_uint8 * input_ptr = nullptr, * output_ptr = nullptr;
+	ERROR_CHECK_STATUS(vxAccessImagePatch(input_image, &rect, 0, &input_addr, (void **)&input_ptr, VX_READ_ONLY));
+	ERROR_CHECK_STATUS(vxAccessImagePatch(output_image, &rect, 0, &output_addr, (void **)&output_ptr, VX_WRITE_ONLY));
+
+	if (input_format == VX_DF_IMAGE_RGB) {
+		// RGB to UYVY/YUYV (BT709 full range): U and V are taken from the even pixel of each pair
+		const float cY[3] = { 0.2126f, 0.7152f, 0.0722f };
+		const float cU[3] = { -0.1146f, -0.3854f, 0.5f };
+		const float cV[3] = { 0.5f, -0.4542f, -0.0458f };
+		vx_uint32 iY = (output_format == VX_DF_IMAGE_UYVY) ? 1 : 0, iU = 1 - iY;
+#pragma omp parallel for
+		for (vx_int32 y = 0; y < (vx_int32)height; y++) {
+			const vx_uint8 * src = input_ptr + y * input_addr.stride_y;
+			vx_uint8 * dst = output_ptr + y * output_addr.stride_y;
+			for (vx_uint32 x = 0; x < (width & ~1u); x += 2, src += 6, dst += 4) {
+				float r = src[0], g = src[1], b = src[2];
+				dst[iU] = StitchPackU8(cU[0] * r + cU[1] * g + cU[2] * b + 128.0f);
+				dst[iY] = StitchPackU8(cY[0] * r + cY[1] * g + cY[2] * b);
+				dst[iU + 2] = StitchPackU8(cV[0] * r + cV[1] * g + cV[2] * b + 128.0f);
+				dst[iY + 2] = StitchPackU8(cY[0] * src[3] + cY[1] * src[4] + cY[2] * src[5]);
+			}
+		}
+	}
+	else {
+		// UYVY/YUYV/Y210/Y216 to RGB/RGBX: the X channel of RGBX carries the luma like the OpenCL kernel
+		float cR1, cG0, cG1, cB0, r2f[4] = { 1.0f, 0.0f, 1.0f, -128.0f };
+		if (input_format == VX_DF_IMAGE_Y210_AMD) {
+			cR1 = 1.57943176f; cG0 = -0.18785088f; cG1 = -0.46947676f; cB0 = 1.86105765f;
+		}
+		else if (input_format == VX_DF_IMAGE_Y216_AMD) {
+			cR1 = 1.5809516f; cG0 = -0.18803164f; cG1 = -0.46992852f; cB0 = 1.86284844f;
+		}
+		else if (input_color_space == VX_COLOR_SPACE_BT601_525 || input_color_space == VX_COLOR_SPACE_BT601_625) {
+			cR1 = 1.4030f; cG0 = -0.3440f; cG1 = -0.7140f; cB0 = 1.7730f;
+		}
+		else { // VX_COLOR_SPACE_BT709
+			cR1 = 1.5748f; cG0 = -0.1873f; cG1 = -0.4681f; cB0 = 1.8556f;
+		}
+		if ((input_format == VX_DF_IMAGE_UYVY || input_format == VX_DF_IMAGE_YUYV) && input_channel_range == VX_CHANNEL_RANGE_RESTRICTED) {
+			r2f[0] = 256.0f / 219.0f; r2f[1] = -16.0f * 256.0f / 219.0f; r2f[2] = 256.0f / 224.0f; r2f[3] = -128.0f * 256.0f / 224.0f;
+		}
+		bool is_16bit = (input_format == VX_DF_IMAGE_Y210_AMD || input_format == VX_DF_IMAGE_Y216_AMD);
+		vx_uint32 iY = (input_format == VX_DF_IMAGE_YUYV) ? 0 : 1, iU = 1 - iY;
+		vx_uint32 pixel_size = (output_format == VX_DF_IMAGE_RGBX) ? 4 : 3;
+#pragma omp parallel for
+		for (vx_int32 y = 0; y < (vx_int32)height; y++) {
+			const vx_uint8 * src = input_ptr + y * input_addr.stride_y;
+			vx_uint8 * dst = output_ptr + y * output_addr.stride_y;
+			for (vx_uint32 x = 0; x < (width & ~1u); x += 2) {
+				float u, v, yy[2];
+				if (is_16bit) {
+					// each 16-bit sample holds the integer part in its first byte and the fraction in its second
+					const vx_uint8 * s = src + x * 4;
+					u = s[0] + s[1] * 0.00390625f - 128.0f; yy[0] = s[2] + s[3] * 0.00390625f;
+					v = s[4] + s[5] * 0.00390625f - 128.0f; yy[1] = s[6] + s[7] * 0.00390625f;
+				}
+				else {
+					const vx_uint8 * s = src + x * 2;
+					u = s[iU] * r2f[2] + r2f[3]; yy[0] = s[iY] * r2f[0] + r2f[1];
+					v = s[iU + 2] * r2f[2] + r2f[3]; yy[1] = s[iY + 2] * r2f[0] + r2f[1];
+				}
+				for (vx_uint32 k = 0; k < 2; k++) {
+					vx_uint8 * d = dst + (x + k) * pixel_size;
+					d[0] = StitchPackU8(cR1 * v + yy[k]);
+					d[1] = StitchPackU8(cG1 * v + (cG0 * u + yy[k]));
+					d[2] = StitchPackU8(cB0 * u + yy[k]);
+					if (pixel_size == 4)
+						d[3] = StitchPackU8(yy[k]);
+				}
+			}
+		}
+	}
+
+	ERROR_CHECK_STATUS(vxCommitImagePatch(input_image, &rect, 0, &input_addr, input_ptr));
+	ERROR_CHECK_STATUS(vxCommitImagePatch(output_image, &rect, 0, &output_addr, output_ptr));
+	return VX_SUCCESS;
 }
 
 //! \brief The kernel publisher.
@@ -533,10 +622,12 @@ vx_status color_convert_publish(vx_context context)
 		nullptr,
 		nullptr);
 	ERROR_CHECK_OBJECT(kernel);
+#if ENABLE_OPENCL
 	amd_kernel_query_target_support_f query_target_support_f = color_convert_query_target_support;
 	amd_kernel_opencl_codegen_callback_f opencl_codegen_callback_f = color_convert_opencl_codegen;
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_QUERY_TARGET_SUPPORT, &query_target_support_f, sizeof(query_target_support_f)));
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_OPENCL_CODEGEN_CALLBACK, &opencl_codegen_callback_f, sizeof(opencl_codegen_callback_f)));
+#endif
 
 	// set kernel parameters
 	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 0, VX_INPUT, VX_TYPE_IMAGE, VX_PARAMETER_STATE_REQUIRED));
@@ -133,14 +133,118 @@ static vx_status VX_CALLBACK exposure_comp_calcErrorFn_query_target_support(vx_g
 	vx_uint32& supported_target_affinity // [output] must be set to AGO_TARGET_AFFINITY_CPU or AGO_TARGET_AFFINITY_GPU or (AGO_TARGET_AFFINITY_CPU | AGO_TARGET_AFFINITY_GPU)
 	)
 {
-	supported_target_affinity = AGO_TARGET_AFFINITY_GPU;
+	supported_target_affinity = AGO_TARGET_AFFINITY_CPU | AGO_TARGET_AFFINITY_GPU;
+	return VX_SUCCESS;
+}
+
+//! \brief The gamma 2.2 to linear lookup used by the RGB gain matrix, same as g_Gamma2LinearLookUp in the OpenCL code.
+static const vx_uint8 s_Gamma2LinearLookUp[256] = {
+	0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 2, 2,
+	2, 3, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 6, 6, 6, 7, 7, 7, 8, 8, 8, 9, 9, 9, 10, 10, 10, 11, 11, 12,
+	12, 13, 13, 13, 14, 14, 15, 15, 16, 16, 17, 17, 18, 18, 19, 19, 20, 21, 21, 22, 22, 23, 23, 24, 25, 25, 26, 27, 27, 28, 29, 29,
+	30, 31, 31, 32, 33, 33, 34, 35, 36, 36, 37, 38, 39, 40, 40, 41, 42, 43, 44, 45, 45, 46, 47, 48, 49, 50, 51, 52, 53, 54, 55, 55,
+	56, 57, 58, 59, 60, 61, 62, 63, 65, 66, 67, 68, 69, 70, 71, 72, 73, 74, 75, 77, 78, 79, 80, 81, 82, 84, 85, 86, 87, 88, 90, 91,
+	92, 93, 95, 96, 97, 99, 100, 101, 103, 104, 105, 107, 108, 109, 111, 112, 114, 115, 117, 118, 119, 121, 122, 124, 125, 127, 128, 130, 131, 133, 135, 136,
+	138, 139, 141, 142, 144, 146, 147, 149, 151, 152, 154, 156, 157, 159, 161, 162, 164, 166, 168, 169, 171, 173, 175, 176, 178, 180, 182, 184, 186, 187, 189, 191,
+	193, 195, 197, 199, 201, 203, 205, 207, 209, 211, 213, 215, 217, 219, 221, 223, 225, 227, 229, 231, 233, 235, 237, 239, 241, 244, 246, 248, 250, 252, 255 };
+
+//! \brief The CPU gain matrix computation shared by the alpha and the RGB variants.
+//  Each overlap entry covers up to 128x32 pixels of a camera pair; the entry sums are computed in parallel
+//  and then accumulated in entry order, so the matrix does not depend on the number of threads.
+static vx_status exposure_comp_calcErrorFn_cpu(vx_node node, const vx_reference * parameters, bool bRGB)
+{
+	vx_uint32 num_cameras = 0;
+	ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[0], &num_cameras));
+	vx_matrix mat = (vx_matrix)parameters[4];
+	vx_size cols = 0, rows = 0;
+	ERROR_CHECK_STATUS(vxQueryMatrix(mat, VX_MATRIX_ATTRIBUTE_COLUMNS, &cols, sizeof(cols)));
+	ERROR_CHECK_STATUS(vxQueryMatrix(mat, VX_MATRIX_ATTRIBUTE_ROWS, &rows, sizeof(rows)));
+	std::vector<vx_int32> AMat(cols * rows, 0);
+	vx_size num_channels = bRGB ? 3 : 1;
+	vx_array arr = (vx_array)parameters[2];
+	vx_size arr_numitems = 0;
+	ERROR_CHECK_STATUS(vxQueryArray(arr, VX_ARRAY_ATTRIBUTE_NUMITEMS, &arr_numitems, sizeof(arr_numitems)));
+	if (arr_numitems > 0 && num_cameras > 0) {
+		vx_image input_image = (vx_image)parameters[1], mask_image = (vx_image)parameters[3];
+		vx_uint32 input_width = 0, input_height = 0, mask_width = 0, mask_height = 0;
+		ERROR_CHECK_STATUS(vxQueryImage(input_image, VX_IMAGE_ATTRIBUTE_WIDTH, &input_width, sizeof(input_width)));
+		ERROR_CHECK_STATUS(vxQueryImage(input_image, VX_IMAGE_ATTRIBUTE_HEIGHT, &input_height, sizeof(input_height)));
+		vx_rectangle_t input_rect = { 0, 0, input_width, input_height }, mask_rect = { 0, 0, 0, 0 };
+		vx_imagepatch_addressing_t input_addr, mask_addr;
+		vx_uint8 * input_ptr = nullptr, * mask_ptr = nullptr;
+		ERROR_CHECK_STATUS(vxAccessImagePatch(input_image, &input_rect, 0, &input_addr, (void **)&input_ptr, VX_READ_ONLY));
+		if (mask_image) {
+			ERROR_CHECK_STATUS(vxQueryImage(mask_image, VX_IMAGE_ATTRIBUTE_WIDTH, &mask_width, sizeof(mask_width)));
+			ERROR_CHECK_STATUS(vxQueryImage(mask_image, VX_IMAGE_ATTRIBUTE_HEIGHT, &mask_height, sizeof(mask_height)));
+			mask_rect.end_x = mask_width; mask_rect.end_y = mask_height;
+			ERROR_CHECK_STATUS(vxAccessImagePatch(mask_image, &mask_rect, 0, &mask_addr, (void **)&mask_ptr, VX_READ_ONLY));
+		}
+		vx_uint8 * arr_ptr = nullptr;
+		vx_size arr_stride = sizeof(StitchOverlapPixelEntry);
+		ERROR_CHECK_STATUS(vxAccessArrayRange(arr, 0, arr_numitems, &arr_stride, (void **)&arr_ptr, VX_READ_ONLY));
+		vx_uint32 height_one = input_height / num_cameras, mask_height_one = mask_height / num_cameras;
+
+		// per entry sums of camera I and camera J for each channel
+		std::vector<vx_uint32> sums(arr_numitems * 6, 0);
+#pragma omp parallel for
+		for (vx_int32 i = 0; i < (vx_int32)arr_numitems; i++) {
+			const vx_uint32 * offs = (const vx_uint32 *)(arr_ptr + i * arr_stride);
+			vx_uint32 cam_x = offs[0] & 0x1f, start_x = (offs[0] >> 5) & 0x3fff, start_y = offs[0] >> 19;
+			vx_uint32 end_x = offs[1] & 0x7f, end_y = (offs[1] >> 7) & 0x1f, cam_y = (offs[1] >> 12) & 0x1f;
+			if (cam_x >= num_cameras || cam_y >= num_cameras)
+				continue;
+			// every valid work-item of the OpenCL kernel covers 8x2 pixels
+			vx_uint32 last_x = std::min(start_x + ((end_x + 7) & ~7u), input_width);
+			vx_uint32 last_y = std::min(start_y + ((end_y + 1) & ~1u), height_one);
+			vx_uint32 * sumI = &sums[i * 6], * sumJ = &sums[i * 6 + 3];
+			for (vx_uint32 gy = start_y; gy < last_y; gy++) {
+				const vx_uint32 * pI = (const vx_uint32 *)(input_ptr + (cam_x * height_one + gy) * input_addr.stride_y);
+				const vx_uint32 * pJ = (const vx_uint32 *)(input_ptr + (cam_y * height_one + gy) * input_addr.stride_y);
+				const vx_uint8 * pMaskI = mask_ptr ? mask_ptr + (cam_x * mask_height_one + gy) * mask_addr.stride_y : nullptr;
+				const vx_uint8 * pMaskJ = mask_ptr ? mask_ptr + (cam_y * mask_height_one + gy) * mask_addr.stride_y : nullptr;
+				for (vx_uint32 gx = start_x; gx < last_x; gx++) {
+					vx_uint32 I = pI[gx], J = pJ[gx];
+					if (I == 0x80000000 || J == 0x80000000)
+						continue;
+					if (pMaskI && !((pMaskI[gx] & pMaskJ[gx]) & 0x80))
+						continue;
+					if (bRGB) {
+						for (vx_uint32 c = 0; c < 3; c++) {
+							sumI[c] += s_Gamma2LinearLookUp[(I >> (c * 8)) & 0xff];
+							sumJ[c] += s_Gamma2LinearLookUp[(J >> (c * 8)) & 0xff];
+						}
+					}
+					else {
+						sumI[0] += I >> 24;
+						sumJ[0] += J >> 24;
+					}
+				}
+			}
+		}
+		for (vx_size i = 0; i < arr_numitems; i++) {
+			const vx_uint32 * offs = (const vx_uint32 *)(arr_ptr + i * arr_stride);
+			vx_uint32 cam_x = offs[0] & 0x1f, cam_y = (offs[1] >> 12) & 0x1f;
+			if (cam_x >= num_cameras || cam_y >= num_cameras)
+				continue;
+			for (vx_size c = 0; c < num_channels; c++) {
+				vx_size idxI = cam_x * cols + cam_y + c * cols * num_cameras, idxJ = cam_y * cols + cam_x + c * cols * num_cameras;
+				if (idxI < AMat.size()) AMat[idxI] += (vx_int32)(sums[i * 6 + c] * 0.0625f);
+				if (idxJ < AMat.size()) AMat[idxJ] += (vx_int32)(sums[i * 6 + 3 + c] * 0.0625f);
+			}
+		}
+
+		ERROR_CHECK_STATUS(vxCommitArrayRange(arr, 0, arr_numitems, arr_ptr));
+		if (mask_image) ERROR_CHECK_STATUS(vxCommitImagePatch(mask_image, &mask_rect, 0, &mask_addr, mask_ptr));
+		ERROR_CHECK_STATUS(vxCommitImagePatch(input_image, &input_rect, 0, &input_addr, input_ptr));
+	}
+	ERROR_CHECK_STATUS(vxWriteMatrix(mat, AMat.data()));
 	return VX_SUCCESS;
 }
 
 //! \brief The kernel execution.
 static vx_status VX_CALLBACK exposure_comp_calcErrorFn_kernel(vx_node node, const vx_reference * parameters, vx_uint32 num)
 {
-	return VX_ERROR_NOT_SUPPORTED;
+	return exposure_comp_calcErrorFn_cpu(node, parameters, false);
 }
 
 //! \brief The OpenCL global work updater callback.
@@ -428,12 +532,14 @@ vx_status exposure_comp_calcErrorFn_publish(vx_context context)
 		nullptr);
 	ERROR_CHECK_OBJECT(kernel);
 	// set codegen for opencl
+#if ENABLE_OPENCL
 	amd_kernel_query_target_support_f query_target_support_f = exposure_comp_calcErrorFn_query_target_support;
 	amd_kernel_opencl_codegen_callback_f opencl_codegen_callback_f = exposure_comp_calcErrorFn_opencl_codegen;
 	amd_kernel_opencl_global_work_update_callback_f opencl_global_work_update_callback_f = exposure_comp_calcErrorFn_opencl_global_work_update;
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_QUERY_TARGET_SUPPORT, &query_target_support_f, sizeof(query_target_support_f)));
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_OPENCL_CODEGEN_CALLBACK, &opencl_codegen_callback_f, sizeof(opencl_codegen_callback_f)));
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_OPENCL_GLOBAL_WORK_UPDATE_CALLBACK, &opencl_global_work_update_callback_f, sizeof(opencl_global_work_update_callback_f)));
+#endif
 	// set kernel parameters
 	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 0, VX_INPUT, VX_TYPE_SCALAR, VX_PARAMETER_STATE_REQUIRED));
 	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 1, VX_INPUT, VX_TYPE_IMAGE, VX_PARAMETER_STATE_REQUIRED));
@@ -580,14 +686,128 @@ static vx_status VX_CALLBACK exposure_comp_applygains_query_target_support(vx_gr
 	vx_uint32& supported_target_affinity // [output] must be set to AGO_TARGET_AFFINITY_CPU or AGO_TARGET_AFFINITY_GPU or (AGO_TARGET_AFFINITY_CPU | AGO_TARGET_AFFINITY_GPU)
 	)
 {
-	supported_target_affinity = AGO_TARGET_AFFINITY_GPU;
+	supported_target_affinity = AGO_TARGET_AFFINITY_CPU | AGO_TARGET_AFFINITY_GPU;
 	return VX_SUCCESS;
 }
 
+//! \brief Bilinear sample of a camera's block gain grid on the CPU; the grid is clamped at the borders.
+static inline void exposure_comp_sample_block_gain(const vx_float32 * pg, vx_uint32 bg_width, vx_uint32 bg_height, vx_uint32 num_channels, float fx, float fy, float gain[3])
+{
+	float fx0 = floorf(fx), fy0 = floorf(fy), ax = fx - fx0, ay = fy - fy0;
+	vx_int32 x0 = std::min(std::max((vx_int32)fx0, 0), (vx_int32)bg_width - 1), x1 = std::min(std::max((vx_int32)fx0 + 1, 0), (vx_int32)bg_width - 1);
+	vx_int32 y0 = std::min(std::max((vx_int32)fy0, 0), (vx_int32)bg_height - 1), y1 = std::min(std::max((vx_int32)fy0 + 1, 0), (vx_int32)bg_height - 1);
+	const vx_float32 * r0 = pg + y0 * bg_width * num_channels, * r1 = pg + y1 * bg_width * num_channels;
+	for (vx_uint32 c = 0; c < num_channels; c++) {
+		float g0 = r0[x0 * num_channels + c] * (1.0f - ax) + r0[x1 * num_channels + c] * ax;
+		float g1 = r1[x0 * num_channels + c] * (1.0f - ax) + r1[x1 * num_channels + c] * ax;
+		gain[c] = g0 * (1.0f - ay) + g1 * ay;
+	}
+}
+
 //! \brief The kernel execution.
 static vx_status VX_CALLBACK exposure_comp_applygains_kernel(vx_node node, const vx_reference * parameters, vx_uint32 num)
 {
-	return VX_ERROR_NOT_SUPPORTED;
+	vx_image input_image = (vx_image)parameters[0], output_image = (vx_image)parameters[6];
+	vx_array gains = (vx_array)parameters[1], arr = (vx_array)parameters[2];
+	vx_scalar sc_width = (vx_scalar)parameters[4], sc_height = (vx_scalar)parameters[5];
+	vx_uint32 num_cam = 0, bg_width = 1, bg_height = 1;
+	ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[3], &num_cam));
+	if (!num_cam) num_cam = 1;	// has to be atleast 1
+	if (sc_width) ERROR_CHECK_STATUS(vxReadScalarValue(sc_width, &bg_width));
+	if (sc_height) ERROR_CHECK_STATUS(vxReadScalarValue(sc_height, &bg_height));
+	bg_width = std::max(1, (int)bg_width);
+	bg_height = std::max(1, (int)bg_height);
+	vx_size num_gains = 0, arr_numitems = 0;
+	vx_size num_gain_items = 0;
+	ERROR_CHECK_STATUS(vxQueryArray(gains, VX_ARRAY_ATTRIBUTE_CAPACITY, &num_gains, sizeof(num_gains)));
+	ERROR_CHECK_STATUS(vxQueryArray(gains, VX_ARRAY_ATTRIBUTE_NUMITEMS, &num_gain_items, sizeof(num_gain_items)));
+	ERROR_CHECK_STATUS(vxQueryArray(arr, VX_ARRAY_ATTRIBUTE_NUMITEMS, &arr_numitems, sizeof(arr_numitems)));
+	if (num_gains < bg_width*bg_height*num_cam)
+		return VX_ERROR_INVALID_DIMENSION;
+	if (num_gain_items < num_gains) {
+		vxAddLogEntry((vx_reference)node, VX_ERROR_INVALID_DIMENSION, "ERROR: exposure_comp_applygains: gains array has %d items, expects %d\n", (vx_int32)num_gain_items, (vx_int32)num_gains);
+		return VX_ERROR_INVALID_DIMENSION;
+	}
+	if (arr_numitems == 0)
+		return VX_SUCCESS;
+	bool bBlockGain = (sc_width && sc_height) ? true : false;
+	bool bRGBGain = (num_gains >= bg_width*bg_height*num_cam * 3);			// if gain array gives gain for R, G and B seperate
+	bool bColorTransform = !bBlockGain && (num_gains == num_cam * 12);	// if gain array gives color transform for R, G and B with bias offset
+
+	// access the gains, the valid entries and the images
+	vx_uint32 input_width = 0, input_height = 0, output_width = 0, output_height = 0;
+	ERROR_CHECK_STATUS(vxQueryImage(input_image, VX_IMAGE_ATTRIBUTE_WIDTH, &input_width, sizeof(input_width)));
+	ERROR_CHECK_STATUS(vxQueryImage(input_image, VX_IMAGE_ATTRIBUTE_HEIGHT, &input_height, sizeof(input_height)));
+	ERROR_CHECK_STATUS(vxQueryImage(output_image, VX_IMAGE_ATTRIBUTE_WIDTH, &output_width, sizeof(output_width)));
+	ERROR_CHECK_STATUS(vxQueryImage(output_image, VX_IMAGE_ATTRIBUTE_HEIGHT, &output_height, sizeof(output_height)));
+	vx_float32 * pGains = nullptr;
+	vx_uint8 * arr_ptr = nullptr;
+	vx_size gains_stride = sizeof(vx_float32), arr_stride = sizeof(StitchExpCompCalcEntry);
+	ERROR_CHECK_STATUS(vxAccessArrayRange(gains, 0, num_gains, &gains_stride, (void **)&pGains, VX_READ_ONLY));
+	ERROR_CHECK_STATUS(vxAccessArrayRange(arr, 0, arr_numitems, &arr_stride, (void **)&arr_ptr, VX_READ_ONLY));
+	vx_rectangle_t input_rect = { 0, 0, input_width, input_height }, output_rect = { 0, 0, output_width, output_height };
+	vx_imagepatch_addressing_t input_addr, output_addr;
+	vx_uint8 * input_ptr = nullptr, * output_ptr = nullptr;
+	ERROR_CHECK_STATUS(vxAccessImagePatch(input_image, &input_rect, 0, &input_addr, (void **)&input_ptr, VX_READ_ONLY));
+	ERROR_CHECK_STATUS(vxAccessImagePatch(output_image, &output_rect, 0, &output_addr, (void **)&output_ptr, VX_READ_AND_WRITE));
+	vx_uint32 height_one_in = input_height / num_cam, height_one_out = output_height / num_cam;
+	vx_float32 xscale = (vx_float32)bg_width / output_width, xoffset = (vx_float32)(xscale*0.5 - 0.5);
+	vx_float32 yscale = (vx_float32)(bg_height*num_cam) / output_height, yoffset = (vx_float32)(yscale*0.5 - 0.5);
+	vx_uint32 num_channels = bRGBGain ? 3 : 1;
+
+	// every entry covers up to 128x32 pixels of a camera
+#pragma omp parallel for
+	for (vx_int32 i = 0; i < (vx_int32)arr_numitems; i++) {
+		const vx_uint32 * offs = (const vx_uint32 *)(arr_ptr + i * arr_stride);
+		vx_uint32 cam_id = offs[0] & 0x3f, dst_x = ((offs[0] >> 6) & 0xfff) << 3, dst_y = (offs[0] >> 18) << 1;
+		vx_uint32 end_x = (offs[1] >> 16) & 0xff, end_y = offs[1] >> 24;
+		if (cam_id >= num_cam)
+			continue;
+		vx_uint32 last_x = std::min(dst_x + ((end_x + 7) & ~7u), std::min(input_width, output_width));
+		vx_uint32 last_y = std::min(dst_y + std::min(end_y + 1, 32u), std::min(height_one_in, height_one_out));
+		__m128 g4 = _mm_set1_ps(1.0f), r4 = g4, b4 = g4;
+		if (bColorTransform) {
+			r4 = _mm_loadu_ps(pGains + cam_id * 12 + 0);
+			g4 = _mm_loadu_ps(pGains + cam_id * 12 + 4);
+			b4 = _mm_loadu_ps(pGains + cam_id * 12 + 8);
+		}
+		else if (!bBlockGain) {
+			g4 = bRGBGain ? _mm_setr_ps(pGains[cam_id * 3], pGains[cam_id * 3 + 1], pGains[cam_id * 3 + 2], 1.0f) : _mm_setr_ps(pGains[cam_id], pGains[cam_id], pGains[cam_id], 1.0f);
+		}
+		const vx_float32 * pBlockGains = pGains + cam_id * bg_width * bg_height * num_channels;
+		for (vx_uint32 gy = dst_y; gy < last_y; gy++) {
+			const vx_uint8 * pIn = input_ptr + (cam_id * height_one_in + gy) * input_addr.stride_y;
+			vx_uint8 * pOut = output_ptr + (cam_id * height_one_out + gy) * output_addr.stride_y;
+			for (vx_uint32 gx = dst_x; gx < last_x; gx++) {
+				__m128 f = StitchLoadRGBX(pIn + gx * 4);
+				if (bColorTransform) {
+					float fin[4], fout[4];
+					float r[4], g[4], b[4];
+					_mm_storeu_ps(fin, f); _mm_storeu_ps(r, r4); _mm_storeu_ps(g, g4); _mm_storeu_ps(b, b4);
+					fout[0] = fin[0] * r[0] + fin[1] * r[1] + fin[2] * r[2] + r[3];
+					fout[1] = fin[0] * g[0] + fin[1] * g[1] + fin[2] * g[2] + g[3];
+					fout[2] = fin[0] * b[0] + fin[1] * b[1] + fin[2] * b[2] + b[3];
+					fout[3] = fin[3];
+					f = _mm_loadu_ps(fout);
+				}
+				else if (bBlockGain) {
+					float gain[3];
+					exposure_comp_sample_block_gain(pBlockGains, bg_width, bg_height, num_channels, gx * xscale + xoffset, gy * yscale + yoffset, gain);
+					f = _mm_mul_ps(f, bRGBGain ? _mm_setr_ps(gain[0], gain[1], gain[2], 1.0f) : _mm_set1_ps(gain[0]));
+				}
+				else {
+					f = _mm_mul_ps(f, g4);
+				}
+				*(vx_uint32 *)(pOut + gx * 4) = StitchPackRGBX(f);
+			}
+		}
+	}
+
+	ERROR_CHECK_STATUS(vxCommitImagePatch(output_image, &output_rect, 0, &output_addr, output_ptr));
+	ERROR_CHECK_STATUS(vxCommitImagePatch(input_image, &input_rect, 0, &input_addr, input_ptr));
+	ERROR_CHECK_STATUS(vxCommitArrayRange(arr, 0, arr_numitems, arr_ptr));
+	ERROR_CHECK_STATUS(vxCommitArrayRange(gains, 0, num_gains, pGains));
+	return VX_SUCCESS;
 }
 
 //! \brief The OpenCL global work updater callback.
@@ -975,12 +1195,14 @@ vx_status exposure_comp_applygains_publish(vx_context context)
 		nullptr,
 		nullptr);
 	ERROR_CHECK_OBJECT(kernel);
+#if ENABLE_OPENCL
 	amd_kernel_query_target_support_f query_target_support_f = exposure_comp_applygains_query_target_support;
 	amd_kernel_opencl_codegen_callback_f opencl_codegen_callback_f = exposure_comp_applygains_opencl_codegen;
 	amd_kernel_opencl_global_work_update_callback_f opencl_global_work_update_callback_f = exposure_comp_applygains_opencl_global_work_update;
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_QUERY_TARGET_SUPPORT, &query_target_support_f, sizeof(query_target_support_f)));
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_OPENCL_CODEGEN_CALLBACK, &opencl_codegen_callback_f, sizeof(opencl_codegen_callback_f)));
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_OPENCL_GLOBAL_WORK_UPDATE_CALLBACK, &opencl_global_work_update_callback_f, sizeof(opencl_global_work_update_callback_f)));
+#endif
 	// set kernel parameters
 	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 0, VX_INPUT, VX_TYPE_IMAGE, VX_PARAMETER_STATE_REQUIRED));
 	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 1, VX_INPUT, VX_TYPE_ARRAY, VX_PARAMETER_STATE_REQUIRED));
@@ -1669,7 +1891,7 @@ static vx_status VX_CALLBACK exposure_comp_calcRGBErrorFn_opencl_codegen(
 //! \brief The kernel execution.
 static vx_status VX_CALLBACK exposure_comp_calcRGBErrorFn_kernel(vx_node node, const vx_reference * parameters, vx_uint32 num)
 {
-	return VX_ERROR_NOT_SUPPORTED;
+	return exposure_comp_calcErrorFn_cpu(node, parameters, true);
 }
 
 
@@ -1687,12 +1909,14 @@ vx_status exposure_comp_calcRGBErrorFn_publish(vx_context context)
 		nullptr);
 	ERROR_CHECK_OBJECT(kernel);
 	// set codegen for opencl
+#if ENABLE_OPENCL
 	amd_kernel_query_target_support_f query_target_support_f = exposure_comp_calcErrorFn_query_target_support;
 	amd_kernel_opencl_codegen_callback_f opencl_codegen_callback_f = exposure_comp_calcRGBErrorFn_opencl_codegen;
 	amd_kernel_opencl_global_work_update_callback_f opencl_global_work_update_callback_f = exposure_comp_calcErrorFn_opencl_global_work_update;
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_QUERY_TARGET_SUPPORT, &query_target_support_f, sizeof(query_target_support_f)));
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_OPENCL_CODEGEN_CALLBACK, &opencl_codegen_callback_f, sizeof(opencl_codegen_callback_f)));
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_OPENCL_GLOBAL_WORK_UPDATE_CALLBACK, &opencl_global_work_update_callback_f, sizeof(opencl_global_work_update_callback_f)));
+#endif
 	// set kernel parameters
 	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 0, VX_INPUT, VX_TYPE_SCALAR, VX_PARAMETER_STATE_REQUIRED));
 	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 1, VX_INPUT, VX_TYPE_IMAGE, VX_PARAMETER_STATE_REQUIRED));
@@ -1746,8 +1970,9 @@ vx_status CalculateSmallestExpCompBufferSizes(
 	vx_uint32 validEntryCount = 0;
 	for (vx_uint32 i = 0; i < numCamera; i++) {
 		vx_uint32 camMaskBit = (1 << i);
-		vx_uint32 start_x = overlapValid[i][i].start_x, end_x = overlapValid[i][i].end_x;
-		vx_uint32 start_y = overlapValid[i][i].start_y, end_y = overlapValid[i][i].end_y;
+		// valid entries store dstX/8 and dstY/2: align the blocks so that they cover the whole region
+		vx_uint32 start_x = overlapValid[i][i].start_x & ~7u, end_x = overlapValid[i][i].end_x;
+		vx_uint32 start_y = overlapValid[i][i].start_y & ~1u, end_y = overlapValid[i][i].end_y;
 		if ((start_x < end_x) && (start_y < end_y))	{
 			for (vx_uint32 ys = start_y; ys < end_y; ys += 32) {
 				for (vx_uint32 xs = start_x; xs < end_x; xs += 128) {
@@ -1838,8 +2063,9 @@ vx_status GenerateExpCompBuffers(
 	vx_uint32 validEntryCount = 0;
 	for (vx_uint32 i = 0; i < numCamera; i++) {
 		vx_uint32 camMaskBit = (1 << i);
-		vx_uint32 start_x = overlapValid[i][i].start_x, end_x = overlapValid[i][i].end_x;
-		vx_uint32 start_y = overlapValid[i][i].start_y, end_y = overlapValid[i][i].end_y;
+		// valid entries store dstX/8 and dstY/2: align the blocks so that they cover the whole region
+		vx_uint32 start_x = overlapValid[i][i].start_x & ~7u, end_x = overlapValid[i][i].end_x;
+		vx_uint32 start_y = overlapValid[i][i].start_y & ~1u, end_y = overlapValid[i][i].end_y;
 		if ((start_x < end_x) && (start_y < end_y))	{
 			for (vx_uint32 ys = start_y; ys < end_y; ys += 32) {
 				for (vx_uint32 xs = start_x; xs < end_x; xs += 128) {
@@ -386,7 +386,133 @@ static vx_status VX_CALLBACK calc_lens_distortionwarp_map_opencl_codegen(
 //! \brief The kernel execution.
 static vx_status VX_CALLBACK calc_lens_distortionwarp_map_kernel(vx_node node, const vx_reference * parameters, vx_uint32 num)
 {
-	return VX_ERROR_NOT_IMPLEMENTED;
+	vx_uint32 nCam = 0, camWidth = 0, camHeight = 0, paddingPixelCount = 0;
+	ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[0], &nCam));
+	ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[2], &camWidth));
+	ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[3], &camHeight));
+	ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[4], &paddingPixelCount));
+	vx_array cam_params_arr = (vx_array)parameters[5];
+	vx_image valid_map = (vx_image)parameters[6];
+	vx_image padded_map = (vx_image)parameters[7];
+	vx_image src_coord_map = (vx_image)parameters[8];
+	vx_array z_buffer_arr = (vx_array)parameters[9];
+	vx_uint32 width = 0, height = 0;
+	ERROR_CHECK_STATUS(vxQueryImage(valid_map, VX_IMAGE_ATTRIBUTE_WIDTH, &width, sizeof(width)));
+	ERROR_CHECK_STATUS(vxQueryImage(valid_map, VX_IMAGE_ATTRIBUTE_HEIGHT, &height, sizeof(height)));
+
+	// access camera parameters (32 floats per camera) and output maps
+	vx_size num_params = 0, stride_params = sizeof(vx_float32);
+	vx_float32 * cam_params = nullptr;
+	ERROR_CHECK_STATUS(vxQueryArray(cam_params_arr, VX_ARRAY_ATTRIBUTE_NUMITEMS, &num_params, sizeof(num_params)));
+	if (num_params < 32 * nCam) {
+		vxAddLogEntry((vx_reference)node, VX_ERROR_INVALID_PARAMETERS, "ERROR: calc_lens_distortionwarp_map needs 32 parameters per camera\n");
+		return VX_ERROR_INVALID_PARAMETERS;
+	}
+	ERROR_CHECK_STATUS(vxAccessArrayRange(cam_params_arr, 0, num_params, &stride_params, (void **)&cam_params, VX_READ_ONLY));
+	vx_rectangle_t rect = { 0, 0, width, height };
+	vx_rectangle_t rect_src = { 0, 0, width * 2, height * nCam };
+	vx_imagepatch_addressing_t addr_valid, addr_padded, addr_src;
+	vx_uint8 * valid_buf = nullptr, * padded_buf = nullptr, * src_buf = nullptr;
+	ERROR_CHECK_STATUS(vxAccessImagePatch(valid_map, &rect, 0, &addr_valid, (void **)&valid_buf, VX_WRITE_ONLY));
+	if (padded_map) {
+		ERROR_CHECK_STATUS(vxAccessImagePatch(padded_map, &rect, 0, &addr_padded, (void **)&padded_buf, VX_WRITE_ONLY));
+	}
+	ERROR_CHECK_STATUS(vxAccessImagePatch(src_coord_map, &rect_src, 0, &addr_src, (void **)&src_buf, VX_WRITE_ONLY));
+	std::vector<vx_float32> z_buffer((size_t)width * height * nCam);
+
+	// warp every equirectangular pixel into each camera: same math as the OpenCL kernel, one pixel at a time
+	vx_float32 pibyH = (vx_float32)((double)M_PI / (float)height);
+	vx_float32 halfW = (vx_float32)camWidth * 0.5f, halfH = (vx_float32)camHeight * 0.5f;
+#pragma omp parallel for
+	for (vx_int32 gy = 0; gy < (vx_int32)height; gy++) {
+		vx_uint32 * valid_row = (vx_uint32 *)(valid_buf + gy * addr_valid.stride_y);
+		vx_uint32 * padded_row = padded_buf ? (vx_uint32 *)(padded_buf + gy * addr_padded.stride_y) : nullptr;
+		vx_float32 pe = gy * pibyH - (vx_float32)M_PI_2;
+		vx_float32 sin_pe = sinf(pe), cos_pe = cosf(pe);
+		for (vx_uint32 gx = 0; gx < width; gx++) {
+			valid_row[gx] = 0;
+			if (padded_row) padded_row[gx] = 0;
+		}
+		for (vx_uint32 camId = 0; camId < nCam; camId++) {
+			const vx_float32 * par = cam_params + camId * 32;
+			vx_float32 left = par[0], top = par[1], rightMinus1 = par[2] - 1.0f, bottomMinus1 = par[3] - 1.0f;
+			vx_float32 k1 = par[4], k2 = par[5], k3 = par[6], k0 = par[7];
+			vx_float32 r_crop = par[10], F0 = par[11], F1 = par[12];
+			const vx_float32 * T = &par[13], * M = &par[16];
+			vx_float32 lens_type = par[25];
+			vx_float32 center_x = par[8] + halfW, center_y = par[9] + halfH;
+			vx_float32 * z_row = &z_buffer[((size_t)camId * height + gy) * width];
+			vx_float32 * src_row = (vx_float32 *)(src_buf + (camId * height + gy) * addr_src.stride_y);
+			for (vx_uint32 gx = 0; gx < width; gx++) {
+				vx_float32 te = gx * pibyH - (vx_float32)M_PI;
+				vx_float32 x0 = sinf(te) * cos_pe - T[0];
+				vx_float32 x1 = sin_pe - T[1];
+				vx_float32 x2 = cosf(te) * cos_pe - T[2];
+				vx_float32 mul_factor = 1.0f / sqrtf(x0 * x0 + x1 * x1 + x2 * x2);
+				x0 *= mul_factor; x1 *= mul_factor; x2 *= mul_factor;
+				vx_float32 y0 = x0 * M[0] + x1 * M[1] + x2 * M[2];
+				vx_float32 y1 = x0 * M[3] + x1 * M[4] + x2 * M[5];
+				vx_float32 y2 = x0 * M[6] + x1 * M[7] + x2 * M[8];
+				// calculate src coordinates
+				vx_float32 th = asinf(sqrtf(std::min(std::max(y0 * y0 + y1 * y1, 0.0f), 1.0f)));
+				vx_float32 ph = atan2f(y1, y0);
+				vx_float32 rd;
+				if (lens_type == 0) {
+					vx_float32 r = tanf(th) * F0;
+					rd = r * (k0 + r * (k3 + r * (k2 + r * k1)));
+				}
+				else if (lens_type < 3) {
+					vx_float32 r = th * F0;
+					rd = r * (k0 + r * (k3 + r * (k2 + r * k1)));
+				}
+				else if (lens_type == 3) {
+					vx_float32 r = tanf(th) * F0, r2 = r * r;
+					rd = r * (1.0f + r2 * (k1 + r2 * (k2 + r2 * k3)));
+				}
+				else {
+					vx_float32 r = th * F0, r2 = r * r;
+					rd = r * (1.0f + r2 * (k1 + r2 * k2));
+				}
+				vx_float32 x_src = F1 * rd * cosf(ph);
+				vx_float32 y_src = F1 * rd * sinf(ph);
+				vx_float32 rr = sqrtf(x_src * x_src + y_src * y_src);
+				x_src += center_x; y_src += center_y;
+				bool isValid = (y2 > 0.0f) && (x_src >= left) && (x_src <= rightMinus1) && (y_src >= top) && (y_src <= bottomMinus1) &&
+					(r_crop <= 0.0f || rr <= r_crop);
+				if (isValid) valid_row[gx] |= (1 << camId);
+				// update zbuffer
+				z_row[gx] = isValid ? fabsf(y2) : 0.0f;
+				bool isPadding = false;
+				if (paddingPixelCount) {
+					vx_float32 pad = (vx_float32)paddingPixelCount;
+					isPadding = (y2 > 0.0f) && (x_src >= left - pad) && (x_src <= rightMinus1 + pad) && (y_src >= top - pad) && (y_src <= bottomMinus1 + pad) &&
+						(r_crop <= 0.0f || rr <= r_crop + pad);
+				}
+				if (padded_row) {
+					isPadding = isPadding && !isValid && (lens_type != 2);
+					if (isPadding) padded_row[gx] |= (1 << camId);
+				}
+				if (!isValid && !isPadding) {
+					x_src = y_src = -1.0f;
+				}
+				// reflect the source coordinates
+				if (x_src < left) x_src = left - x_src; else if (x_src >= rightMinus1) x_src = 2.0f * rightMinus1 - x_src;
+				if (y_src < top) y_src = top - y_src; else if (y_src >= bottomMinus1) y_src = 2.0f * bottomMinus1 - y_src;
+				src_row[2 * gx + 0] = x_src;
+				src_row[2 * gx + 1] = y_src;
+			}
+		}
+	}
+
+	ERROR_CHECK_STATUS(vxCommitArrayRange(cam_params_arr, 0, num_params, cam_params));
+	ERROR_CHECK_STATUS(vxCommitImagePatch(valid_map, &rect, 0, &addr_valid, valid_buf));
+	if (padded_map) {
+		ERROR_CHECK_STATUS(vxCommitImagePatch(padded_map, &rect, 0, &addr_padded, padded_buf));
+	}
+	ERROR_CHECK_STATUS(vxCommitImagePatch(src_coord_map, &rect_src, 0, &addr_src, src_buf));
+	ERROR_CHECK_STATUS(vxTruncateArray(z_buffer_arr, 0));
+	ERROR_CHECK_STATUS(vxAddArrayItems(z_buffer_arr, z_buffer.size(), z_buffer.data(), sizeof(vx_float32)));
+	return VX_SUCCESS;
 }
 
 //! \brief The kernel target support callback.
@@ -395,7 +521,7 @@ static vx_status VX_CALLBACK calc_lens_distortionwarp_map_target_support(vx_grap
 	vx_uint32& supported_target_affinity // [output] must be set to AGO_TARGET_AFFINITY_CPU or AGO_TARGET_AFFINITY_GPU or (AGO_TARGET_AFFINITY_CPU | AGO_TARGET_AFFINITY_GPU)
 	)
 {
-	supported_target_affinity = AGO_TARGET_AFFINITY_GPU;
+	supported_target_affinity = AGO_TARGET_AFFINITY_CPU | AGO_TARGET_AFFINITY_GPU;
 	return VX_SUCCESS;
 }
 
@@ -413,10 +539,12 @@ vx_status calc_lens_distortionwarp_map_publish(vx_context context)
 		nullptr,
 		nullptr);
 	ERROR_CHECK_OBJECT(kernel);
+#if ENABLE_OPENCL
 	amd_kernel_query_target_support_f query_target_support_f = calc_lens_distortionwarp_map_target_support;
 	amd_kernel_opencl_codegen_callback_f opencl_codegen_callback_f = calc_lens_distortionwarp_map_opencl_codegen;
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_QUERY_TARGET_SUPPORT, &query_target_support_f, sizeof(query_target_support_f)));
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_OPENCL_CODEGEN_CALLBACK, &opencl_codegen_callback_f, sizeof(opencl_codegen_callback_f)));
+#endif
 
 	// set kernel parameters
 	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 0, VX_INPUT, VX_TYPE_SCALAR, VX_PARAMETER_STATE_REQUIRED));
@@ -581,7 +709,50 @@ static vx_status VX_CALLBACK compute_default_camIdx_opencl_codegen(
 //! \brief The kernel execution.
 static vx_status VX_CALLBACK compute_default_camIdx_kernel(vx_node node, const vx_reference * parameters, vx_uint32 num)
 {
-	return VX_ERROR_NOT_IMPLEMENTED;
+	vx_uint32 numCam = 0, eqrWidth = 0, eqrHeight = 0;
+	ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[0], &numCam));
+	ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[1], &eqrWidth));
+	ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[2], &eqrHeight));
+	vx_array z_buffer_arr = (vx_array)parameters[3];
+	vx_image default_cam_map = (vx_image)parameters[4];
+	vx_uint32 width = 0, height = 0;
+	ERROR_CHECK_STATUS(vxQueryImage(default_cam_map, VX_IMAGE_ATTRIBUTE_WIDTH, &width, sizeof(width)));
+	ERROR_CHECK_STATUS(vxQueryImage(default_cam_map, VX_IMAGE_ATTRIBUTE_HEIGHT, &height, sizeof(height)));
+	vx_size num_items = 0, stride = sizeof(vx_float32);
+	ERROR_CHECK_STATUS(vxQueryArray(z_buffer_arr, VX_ARRAY_ATTRIBUTE_NUMITEMS, &num_items, sizeof(num_items)));
+	if (numCam == 0 || num_items < (vx_size)width * height * numCam) {
+		vxAddLogEntry((vx_reference)node, VX_ERROR_INVALID_PARAMETERS, "ERROR: compute_default_camIdx z-buffer has %d items\n", (int)num_items);
+		return VX_ERROR_INVALID_PARAMETERS;
+	}
+	vx_float32 * z_buffer = nullptr;
+	ERROR_CHECK_STATUS(vxAccessArrayRange(z_buffer_arr, 0, num_items, &stride, (void **)&z_buffer, VX_READ_ONLY));
+	vx_rectangle_t rect = { 0, 0, width, height };
+	vx_imagepatch_addressing_t addr;
+	vx_uint8 * dst_buf = nullptr;
+	ERROR_CHECK_STATUS(vxAccessImagePatch(default_cam_map, &rect, 0, &addr, (void **)&dst_buf, VX_WRITE_ONLY));
+
+	// pick the camera with the largest z-value; a tie with the current best means no camera (0xFF)
+	vx_size plane_size = (vx_size)width * height;
+#pragma omp parallel for
+	for (vx_int32 gy = 0; gy < (vx_int32)height; gy++) {
+		vx_uint8 * dst = dst_buf + gy * addr.stride_y;
+		for (vx_uint32 gx = 0; gx < width; gx++) {
+			const vx_float32 * z = z_buffer + gy * eqrWidth + gx;
+			vx_float32 best = z[0];
+			vx_int32 cam_idx = 0;
+			for (vx_uint32 cam_id = 1; cam_id < numCam; cam_id++) {
+				vx_float32 val = z[cam_id * plane_size];
+				if (val > best) cam_idx = cam_id;
+				if (val == best) cam_idx = 0xFF;
+				if (val > best) best = val;
+			}
+			dst[gx] = (vx_uint8)cam_idx;
+		}
+	}
+
+	ERROR_CHECK_STATUS(vxCommitArrayRange(z_buffer_arr, 0, num_items, z_buffer));
+	ERROR_CHECK_STATUS(vxCommitImagePatch(default_cam_map, &rect, 0, &addr, dst_buf));
+	return VX_SUCCESS;
 }
 
 //! \brief The kernel target support callback.
@@ -590,7 +761,7 @@ static vx_status VX_CALLBACK compute_default_camIdx_target_support(vx_graph grap
 	vx_uint32& supported_target_affinity // [output] must be set to AGO_TARGET_AFFINITY_CPU or AGO_TARGET_AFFINITY_GPU or (AGO_TARGET_AFFINITY_CPU | AGO_TARGET_AFFINITY_GPU)
 	)
 {
-	supported_target_affinity = AGO_TARGET_AFFINITY_GPU;
+	supported_target_affinity = AGO_TARGET_AFFINITY_CPU | AGO_TARGET_AFFINITY_GPU;
 	return VX_SUCCESS;
 }
 
@@ -607,10 +778,12 @@ vx_status compute_default_camIdx_publish(vx_context context)
 		nullptr,
 		nullptr);
 	ERROR_CHECK_OBJECT(kernel);
+#if ENABLE_OPENCL
 	amd_kernel_query_target_support_f query_target_support_f = compute_default_camIdx_target_support;
 	amd_kernel_opencl_codegen_callback_f opencl_codegen_callback_f = compute_default_camIdx_opencl_codegen;
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_QUERY_TARGET_SUPPORT, &query_target_support_f, sizeof(query_target_support_f)));
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_OPENCL_CODEGEN_CALLBACK, &opencl_codegen_callback_f, sizeof(opencl_codegen_callback_f)));
+#endif
 
 	// set kernel parameters
 	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 0, VX_INPUT, VX_TYPE_SCALAR, VX_PARAMETER_STATE_REQUIRED));
@@ -810,10 +983,64 @@ static vx_status VX_CALLBACK extend_padding_dilate_opencl_codegen(
 }
 
 
+//! \brief OR of all the items within +/-radius of each item of a line (van Herk/Gil-Werman, linear in the line length).
+static void StitchDilateLineOR(const vx_uint32 * src, vx_size src_step, vx_uint32 * dst, vx_size dst_step, vx_uint32 n, vx_uint32 radius, vx_uint32 * tmp)
+{
+	vx_uint32 w = 2 * radius + 1;
+	vx_uint32 * g = tmp, * h = tmp + n;
+	// g: OR from the start of each block of w items; h: OR to the end of each block
+	for (vx_uint32 i = 0; i < n; i++)
+		g[i] = ((i % w) ? g[i - 1] : 0) | src[i * src_step];
+	for (vx_uint32 i = n; i-- > 0;)
+		h[i] = ((i + 1 < n && (i + 1) % w) ? h[i + 1] : 0) | src[i * src_step];
+	for (vx_uint32 i = 0; i < n; i++) {
+		vx_uint32 lo = (i > radius) ? i - radius : 0;
+		vx_uint32 hi = std::min(i + radius, n - 1);
+		if (lo / w != hi / w) dst[i * dst_step] = h[lo] | g[hi];
+		else dst[i * dst_step] = (lo % w == 0) ? g[hi] : h[lo];
+	}
+}
+
 //! \brief The kernel execution.
 static vx_status VX_CALLBACK extend_padding_dilate_kernel(vx_node node, const vx_reference * parameters, vx_uint32 num)
 {
-	return VX_ERROR_NOT_IMPLEMENTED;
+	vx_uint32 padding_pixels = 0;
+	ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[0], &padding_pixels));
+	vx_image valid_map = (vx_image)parameters[1];
+	vx_image padded_map = (vx_image)parameters[2];
+	vx_uint32 width = 0, height = 0;
+	ERROR_CHECK_STATUS(vxQueryImage(padded_map, VX_IMAGE_ATTRIBUTE_WIDTH, &width, sizeof(width)));
+	ERROR_CHECK_STATUS(vxQueryImage(padded_map, VX_IMAGE_ATTRIBUTE_HEIGHT, &height, sizeof(height)));
+	vx_rectangle_t rect = { 0, 0, width, height };
+	vx_imagepatch_addressing_t addr_valid, addr_padded;
+	vx_uint8 * valid_buf = nullptr, * padded_buf = nullptr;
+	ERROR_CHECK_STATUS(vxAccessImagePatch(valid_map, &rect, 0, &addr_valid, (void **)&valid_buf, VX_READ_ONLY));
+	ERROR_CHECK_STATUS(vxAccessImagePatch(padded_map, &rect, 0, &addr_padded, (void **)&padded_buf, VX_WRITE_ONLY));
+
+	// dilate the camera bits with separable (2N+1 x 1) and (1 x 2N+1) windows, then drop the pixels already valid
+	std::vector<vx_uint32> dilated((size_t)width * height);
+#pragma omp parallel for
+	for (vx_int32 gy = 0; gy < (vx_int32)height; gy++) {
+		std::vector<vx_uint32> line(width), tmp(2 * width);
+		const vx_uint32 * src = (const vx_uint32 *)(valid_buf + gy * addr_valid.stride_y);
+		StitchDilateLineOR(src, 1, line.data(), 1, width, padding_pixels, tmp.data());
+		memcpy(&dilated[(size_t)gy * width], line.data(), width * sizeof(vx_uint32));
+	}
+#pragma omp parallel for
+	for (vx_int32 gx = 0; gx < (vx_int32)width; gx++) {
+		std::vector<vx_uint32> line(height), tmp(2 * height);
+		const vx_uint32 * src = (const vx_uint32 *)valid_buf + gx;
+		StitchDilateLineOR(src, addr_valid.stride_y / sizeof(vx_uint32), line.data(), 1, height, padding_pixels, tmp.data());
+		for (vx_uint32 gy = 0; gy < height; gy++) {
+			vx_uint32 valid = *(const vx_uint32 *)(valid_buf + gy * addr_valid.stride_y + gx * sizeof(vx_uint32));
+			vx_uint32 * dst = (vx_uint32 *)(padded_buf + gy * addr_padded.stride_y) + gx;
+			*dst = (dilated[(size_t)gy * width + gx] | line[gy]) & ~valid;
+		}
+	}
+
+	ERROR_CHECK_STATUS(vxCommitImagePatch(valid_map, &rect, 0, &addr_valid, valid_buf));
+	ERROR_CHECK_STATUS(vxCommitImagePatch(padded_map, &rect, 0, &addr_padded, padded_buf));
+	return VX_SUCCESS;
 }
 
 //! \brief The kernel target support callback.
@@ -822,7 +1049,7 @@ static vx_status VX_CALLBACK extend_padding_dilate_target_support(vx_graph graph
 	vx_uint32& supported_target_affinity // [output] must be set to AGO_TARGET_AFFINITY_CPU or AGO_TARGET_AFFINITY_GPU or (AGO_TARGET_AFFINITY_CPU | AGO_TARGET_AFFINITY_GPU)
 	)
 {
-	supported_target_affinity = AGO_TARGET_AFFINITY_GPU;
+	supported_target_affinity = AGO_TARGET_AFFINITY_CPU | AGO_TARGET_AFFINITY_GPU;
 	return VX_SUCCESS;
 }
 
@@ -839,10 +1066,12 @@ vx_status extend_padding_dilate_publish(vx_context context)
 		nullptr,
 		nullptr);
 	ERROR_CHECK_OBJECT(kernel);
+#if ENABLE_OPENCL
 	amd_kernel_query_target_support_f query_target_support_f = extend_padding_dilate_target_support;
 	amd_kernel_opencl_codegen_callback_f opencl_codegen_callback_f = extend_padding_dilate_opencl_codegen;
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_QUERY_TARGET_SUPPORT, &query_target_support_f, sizeof(query_target_support_f)));
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_OPENCL_CODEGEN_CALLBACK, &opencl_codegen_callback_f, sizeof(opencl_codegen_callback_f)));
+#endif
 
 	// set kernel parameters
 	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 0, VX_INPUT, VX_TYPE_SCALAR, VX_PARAMETER_STATE_REQUIRED));
@@ -83,6 +83,49 @@ static inline vx_uint32 GetOneBitCount(vx_uint32 a)
 }
 #endif
 
+//////////////////////////////////////////////////////////////////////
+//! \brief SSE pixel helpers for the CPU kernels: one pixel is held as (R, G, B, A) in a __m128.
+//  The pack helpers match the OpenCL amd_pack() and convert_short_sat_rte() conversions.
+static inline __m128 StitchLoadRGBX(const vx_uint8 * p)
+{
+	return _mm_cvtepi32_ps(_mm_cvtepu8_epi32(_mm_cvtsi32_si128(*(const int *)p)));
+}
+static inline __m128 StitchLoadRGB(const vx_uint8 * p)
+{
+	return _mm_cvtepi32_ps(_mm_setr_epi32(p[0], p[1], p[2], 0));
+}
+static inline __m128 StitchLoadRGB4(const vx_int16 * p)
+{
+	return _mm_cvtepi32_ps(_mm_setr_epi32(p[0], p[1], p[2], 0));
+}
+static inline vx_uint32 StitchPackRGBX(__m128 f)
+{
+	__m128i i = _mm_cvtps_epi32(f);
+	i = _mm_packs_epi32(i, i);
+	return (vx_uint32)_mm_cvtsi128_si32(_mm_packus_epi16(i, i));
+}
+static inline void StitchStoreRGB(vx_uint8 * p, __m128 f)
+{
+	vx_uint32 v = StitchPackRGBX(f);
+	p[0] = (vx_uint8)v; p[1] = (vx_uint8)(v >> 8); p[2] = (vx_uint8)(v >> 16);
+}
+static inline void StitchStoreRGB4(vx_int16 * p, __m128 f)
+{
+	__m128i i = _mm_cvtps_epi32(f);
+	i = _mm_packs_epi32(i, i);
+	p[0] = (vx_int16)_mm_extract_epi16(i, 0); p[1] = (vx_int16)_mm_extract_epi16(i, 1); p[2] = (vx_int16)_mm_extract_epi16(i, 2);
+}
+static inline vx_uint8 StitchPackU8(float f)
+{
+	int i = _mm_cvtss_si32(_mm_set_ss(f));
+	return (vx_uint8)(i < 0 ? 0 : (i > 255 ? 255 : i));
+}
+static inline vx_int16 StitchPackS16(float f)
+{
+	int i = _mm_cvtss_si32(_mm_set_ss(f));
+	return (vx_int16)(i < -32768 ? -32768 : (i > 32767 ? 32767 : i));
+}
+
 //////////////////////////////////////////////////////////////////////
 //! \brief The AMD extension library for stitching
 #define	AMDOVX_LIBRARY_STITCHING          2
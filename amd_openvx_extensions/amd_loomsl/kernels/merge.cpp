@@ -178,7 +178,7 @@ static vx_status VX_CALLBACK merge_query_target_support(vx_graph graph, vx_node
 	vx_uint32& supported_target_affinity // [output] must be set to AGO_TARGET_AFFINITY_CPU or AGO_TARGET_AFFINITY_GPU or (AGO_TARGET_AFFINITY_CPU | AGO_TARGET_AFFINITY_GPU)
 	)
 {
-	supported_target_affinity = AGO_TARGET_AFFINITY_GPU;
+	supported_target_affinity = AGO_TARGET_AFFINITY_CPU | AGO_TARGET_AFFINITY_GPU;
 	return VX_SUCCESS;
 }
 
@@ -364,7 +364,64 @@ static vx_status VX_CALLBACK merge_deinitialize(vx_node node, const vx_reference
 //! \brief The kernel execution.
 static vx_status VX_CALLBACK merge_kernel(vx_node node, const vx_reference * parameters, vx_uint32 num)
 {
-	return VX_ERROR_NOT_IMPLEMENTED;
+	// access all the images: camId selection, camId groups, input, weight and output
+	vx_image images[6];
+	vx_rectangle_t rect[6];
+	vx_imagepatch_addressing_t addr[6];
+	vx_uint8 * ptr[6];
+	for (vx_uint32 i = 0; i < 6; i++) {
+		vx_uint32 width = 0, height = 0;
+		images[i] = (vx_image)parameters[i];
+		ERROR_CHECK_STATUS(vxQueryImage(images[i], VX_IMAGE_ATTRIBUTE_WIDTH, &width, sizeof(width)));
+		ERROR_CHECK_STATUS(vxQueryImage(images[i], VX_IMAGE_ATTRIBUTE_HEIGHT, &height, sizeof(height)));
+		rect[i].start_x = rect[i].start_y = 0; rect[i].end_x = width; rect[i].end_y = height;
+		ptr[i] = nullptr;
+		ERROR_CHECK_STATUS(vxAccessImagePatch(images[i], &rect[i], 0, &addr[i], (void **)&ptr[i], (i == 5) ? VX_READ_AND_WRITE : VX_READ_ONLY));
+	}
+	vx_df_image output_format = VX_DF_IMAGE_VIRT;
+	ERROR_CHECK_STATUS(vxQueryImage(images[5], VX_IMAGE_ATTRIBUTE_FORMAT, &output_format, sizeof(output_format)));
+	vx_uint32 width = rect[5].end_x, op_height = rect[5].end_y;
+	const float weight_mul_factor = 1.0f / 255.0f;
+
+	// every camId selection and camId group entry covers 8 consecutive output pixels
+#pragma omp parallel for
+	for (vx_int32 gy = 0; gy < (vx_int32)op_height; gy++) {
+		const vx_uint8 * camID0_row = ptr[0] + gy * addr[0].stride_y;
+		const vx_uint16 * camID1_row = (const vx_uint16 *)(ptr[1] + gy * addr[1].stride_y);
+		const vx_uint16 * camID2_row = (const vx_uint16 *)(ptr[2] + gy * addr[2].stride_y);
+		vx_uint8 * op_row = ptr[5] + gy * addr[5].stride_y;
+		for (vx_uint32 gx = 0; gx < width; gx++) {
+			vx_uint8 camIdSelect = camID0_row[gx >> 3];
+			if (camIdSelect == 31)
+				continue;
+			__m128 fa = _mm_setzero_ps();
+			if (camIdSelect < 31) {
+				fa = StitchLoadRGBX(ptr[3] + (gy + op_height * camIdSelect) * addr[3].stride_y + (gx << 2));
+			}
+			else {
+				vx_uint32 camID1 = camID1_row[gx >> 3], camID2 = camID2_row[gx >> 3];
+				vx_uint32 camId[6] = { camID1 & 0x1f, (camID1 >> 5) & 0x1f, (camID1 >> 10) & 0x1f, camID2 & 0x1f, (camID2 >> 5) & 0x1f, (camID2 >> 10) & 0x1f };
+				vx_uint32 count = 2 + (camIdSelect > 128) + (camIdSelect > 129) + (camIdSelect > 130) + (camIdSelect > 131);
+				for (vx_uint32 k = 0; k < count; k++) {
+					if (camId[k] < 31) {
+						vx_uint32 y = gy + op_height * camId[k];
+						__m128 pix = StitchLoadRGBX(ptr[3] + y * addr[3].stride_y + (gx << 2));
+						float weight = ptr[4][y * addr[4].stride_y + gx] * weight_mul_factor;
+						fa = _mm_add_ps(fa, _mm_mul_ps(pix, _mm_set1_ps(weight)));
+					}
+				}
+			}
+			if (output_format == VX_DF_IMAGE_RGB)
+				StitchStoreRGB(op_row + gx * 3, fa);
+			else
+				*(vx_uint32 *)(op_row + (gx << 2)) = StitchPackRGBX(fa) | 0xff000000;
+		}
+	}
+
+	for (vx_uint32 i = 0; i < 6; i++) {
+		ERROR_CHECK_STATUS(vxCommitImagePatch(images[i], &rect[i], 0, &addr[i], ptr[i]));
+	}
+	return VX_SUCCESS;
 }
 
 //! \brief The kernel publisher.
@@ -380,10 +437,12 @@ vx_status merge_publish(vx_context context)
 		merge_initialize,
 		merge_deinitialize);
 	ERROR_CHECK_OBJECT(kernel);
+#if ENABLE_OPENCL
 	amd_kernel_query_target_support_f query_target_support_f = merge_query_target_support;
 	amd_kernel_opencl_codegen_callback_f opencl_codegen_callback_f = merge_opencl_codegen;
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_QUERY_TARGET_SUPPORT, &query_target_support_f, sizeof(query_target_support_f)));
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_OPENCL_CODEGEN_CALLBACK, &opencl_codegen_callback_f, sizeof(opencl_codegen_callback_f)));
+#endif
 
 	// set kernel parameters
 	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 0, VX_INPUT, VX_TYPE_IMAGE, VX_PARAMETER_STATE_REQUIRED));
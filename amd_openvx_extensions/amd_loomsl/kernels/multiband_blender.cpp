@@ -144,7 +144,7 @@ static vx_status VX_CALLBACK multiband_blend_query_target_support(vx_graph graph
 	vx_uint32& supported_target_affinity // [output] must be set to AGO_TARGET_AFFINITY_CPU or AGO_TARGET_AFFINITY_GPU or (AGO_TARGET_AFFINITY_CPU | AGO_TARGET_AFFINITY_GPU)
 	)
 {
-	supported_target_affinity = AGO_TARGET_AFFINITY_GPU;
+	supported_target_affinity = AGO_TARGET_AFFINITY_CPU | AGO_TARGET_AFFINITY_GPU;
 	return VX_SUCCESS;
 }
 
@@ -300,7 +300,58 @@ static vx_status VX_CALLBACK multiband_blend_opencl_codegen(
 //! \brief The kernel execution.
 static vx_status VX_CALLBACK multiband_blend_kernel(vx_node node, const vx_reference * parameters, vx_uint32 num)
 {
-	return VX_ERROR_NOT_IMPLEMENTED;
+	vx_uint32 numCam = 0, arr_offset = 0;
+	ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[0], &numCam));
+	ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[1], &arr_offset));
+	vx_image input = (vx_image)parameters[2];
+	vx_image weight = (vx_image)parameters[3];
+	vx_array arr = (vx_array)parameters[4];
+	vx_image output = (vx_image)parameters[5];
+	vx_uint32 width = 0, height = 0;
+	vx_df_image in_format = VX_DF_IMAGE_VIRT, wt_format = VX_DF_IMAGE_VIRT;
+	ERROR_CHECK_STATUS(vxQueryImage(output, VX_IMAGE_ATTRIBUTE_WIDTH, &width, sizeof(width)));
+	ERROR_CHECK_STATUS(vxQueryImage(output, VX_IMAGE_ATTRIBUTE_HEIGHT, &height, sizeof(height)));
+	ERROR_CHECK_STATUS(vxQueryImage(input, VX_IMAGE_ATTRIBUTE_FORMAT, &in_format, sizeof(in_format)));
+	ERROR_CHECK_STATUS(vxQueryImage(weight, VX_IMAGE_ATTRIBUTE_FORMAT, &wt_format, sizeof(wt_format)));
+	vx_uint32 height1 = numCam ? height / numCam : height;
+	float divfactor = (wt_format == VX_DF_IMAGE_U8) ? 0.0627451f : 0.000490196f;
+
+	// access the level entries and the images
+	vx_size arr_numitems = 0, num_entries = 0; void * arr_base = nullptr;
+	const StitchBlendValidEntry * entries = nullptr;
+	ERROR_CHECK_STATUS(AccessBlendValidEntries(arr, arr_offset, &arr_numitems, &arr_base, &entries, &num_entries));
+	vx_rectangle_t rect = { 0, 0, width, height };
+	vx_imagepatch_addressing_t addr_in, addr_wt, addr_out;
+	vx_uint8 * ptr_in = nullptr, *ptr_wt = nullptr, *ptr_out = nullptr;
+	ERROR_CHECK_STATUS(vxAccessImagePatch(input, &rect, 0, &addr_in, (void **)&ptr_in, VX_READ_ONLY));
+	ERROR_CHECK_STATUS(vxAccessImagePatch(weight, &rect, 0, &addr_wt, (void **)&ptr_wt, VX_READ_ONLY));
+	ERROR_CHECK_STATUS(vxAccessImagePatch(output, &rect, 0, &addr_out, (void **)&ptr_out, VX_READ_AND_WRITE));
+
+	// each entry covers up to 64x16 pixels of one camera: out = in * weight
+#pragma omp parallel for
+	for (vx_int32 i = 0; i < (vx_int32)num_entries; i++) {
+		const vx_uint32 * entry = (const vx_uint32 *)&entries[i];
+		vx_uint32 camId = entry[0] & 0x1f, gx = (entry[0] >> 5) & 0x3fff, gy = (entry[0] >> 19) & 0x1fff;
+		vx_uint32 end_x = gx + ((entry[1] & 0xff) & ~3) + 4, end_y = gy + std::min((entry[1] >> 8) & 0xff, 15u) + 1;
+		end_x = std::min(end_x, width); end_y = std::min(end_y, height1);
+		for (vx_uint32 y = gy; y < end_y; y++) {
+			vx_uint32 row = camId * height1 + y;
+			const vx_uint8 * pIn = ptr_in + row * addr_in.stride_y;
+			const vx_uint8 * pWt = ptr_wt + row * addr_wt.stride_y;
+			vx_int16 * pOut = (vx_int16 *)(ptr_out + row * addr_out.stride_y);
+			for (vx_uint32 x = gx; x < end_x; x++) {
+				float w = (wt_format == VX_DF_IMAGE_U8) ? (float)pWt[x] : (float)((const vx_int16 *)pWt)[x];
+				__m128 f = (in_format == VX_DF_IMAGE_RGBX) ? StitchLoadRGBX(pIn + x * 4) : StitchLoadRGB4((const vx_int16 *)pIn + x * 3);
+				StitchStoreRGB4(pOut + x * 3, _mm_mul_ps(f, _mm_set1_ps(w * divfactor)));
+			}
+		}
+	}
+
+	ERROR_CHECK_STATUS(vxCommitImagePatch(input, &rect, 0, &addr_in, ptr_in));
+	ERROR_CHECK_STATUS(vxCommitImagePatch(weight, &rect, 0, &addr_wt, ptr_wt));
+	ERROR_CHECK_STATUS(vxCommitImagePatch(output, &rect, 0, &addr_out, ptr_out));
+	ERROR_CHECK_STATUS(vxCommitArrayRange(arr, 0, arr_numitems, arr_base));
+	return VX_SUCCESS;
 }
 
 //! \brief The OpenCL global work updater callback.
@@ -345,12 +396,14 @@ vx_status multiband_blend_publish(vx_context context)
 		nullptr,
 		nullptr);
 	ERROR_CHECK_OBJECT(kernel);
+#if ENABLE_OPENCL
 	amd_kernel_query_target_support_f query_target_support_f = multiband_blend_query_target_support;
 	amd_kernel_opencl_codegen_callback_f opencl_codegen_callback_f = multiband_blend_opencl_codegen;
 	amd_kernel_opencl_global_work_update_callback_f opencl_global_work_update_callback_f = multiband_blend_opencl_global_work_update;
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_QUERY_TARGET_SUPPORT, &query_target_support_f, sizeof(query_target_support_f)));
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_OPENCL_CODEGEN_CALLBACK, &opencl_codegen_callback_f, sizeof(opencl_codegen_callback_f)));
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_OPENCL_GLOBAL_WORK_UPDATE_CALLBACK, &opencl_global_work_update_callback_f, sizeof(opencl_global_work_update_callback_f)));
+#endif
 	// set kernel parameters
 	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 0, VX_INPUT, VX_TYPE_SCALAR, VX_PARAMETER_STATE_REQUIRED));
 	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 1, VX_INPUT, VX_TYPE_SCALAR, VX_PARAMETER_STATE_REQUIRED));
@@ -475,3 +528,23 @@ vx_uint32 GenerateBlendBuffers(
 
 	return VX_SUCCESS;
 }
+
+vx_status AccessBlendValidEntries(vx_array arr, vx_uint32 arrayOffset, vx_size * arrayNumItems, void ** arrayBase, const StitchBlendValidEntry ** levelEntries, vx_size * levelNumEntries)
+{
+	*arrayNumItems = 0; *arrayBase = nullptr; *levelEntries = nullptr; *levelNumEntries = 0;
+	vx_size numitems = 0;
+	ERROR_CHECK_STATUS(vxQueryArray(arr, VX_ARRAY_ATTRIBUTE_NUMITEMS, &numitems, sizeof(numitems)));
+	if (arrayOffset < 1 || arrayOffset > numitems) {
+		vxAddLogEntry((vx_reference)arr, VX_ERROR_INVALID_VALUE, "ERROR: AccessBlendValidEntries: array offset %d out of range (%d items)\n", arrayOffset, (vx_uint32)numitems);
+		return VX_ERROR_INVALID_VALUE;
+	}
+	vx_size stride = sizeof(StitchBlendValidEntry);
+	StitchBlendValidEntry * base = nullptr;
+	ERROR_CHECK_STATUS(vxAccessArrayRange(arr, 0, numitems, &stride, (void **)&base, VX_READ_ONLY));
+	vx_size count = *(const vx_uint32 *)&base[arrayOffset - 1];
+	*arrayNumItems = numitems;
+	*arrayBase = base;
+	*levelEntries = base + arrayOffset;
+	*levelNumEntries = std::min(count, numitems - arrayOffset);
+	return VX_SUCCESS;
+}
@@ -99,4 +99,17 @@ vx_uint32 GenerateBlendBuffers(
 	StitchBlendValidEntry * blendOffsetTable         // [out] blend offset table
 	);
 
+//////////////////////////////////////////////////////////////////////
+// Access the blend offset table entries of one level for the CPU kernels:
+//   the entry count of a level is kept in the entry just before arrayOffset.
+//   The whole array is accessed; release it with vxCommitArrayRange(arr, 0, *arrayNumItems, *arrayBase).
+vx_status AccessBlendValidEntries(
+	vx_array arr,                                    // [in] blend offset table
+	vx_uint32 arrayOffset,                           // [in] offset of the level into the blend offset table
+	vx_size * arrayNumItems,                         // [out] number of items accessed
+	void ** arrayBase,                               // [out] base of the accessed items
+	const StitchBlendValidEntry ** levelEntries,     // [out] first entry of the level
+	vx_size * levelNumEntries                        // [out] number of entries in the level
+	);
+
 #endif //__MULTIBAND_BLENDER_H__
@@ -137,7 +137,7 @@ static vx_status VX_CALLBACK noise_filter_query_target_support(vx_graph graph, v
 	vx_uint32& supported_target_affinity // [output] must be set to AGO_TARGET_AFFINITY_CPU or AGO_TARGET_AFFINITY_GPU or (AGO_TARGET_AFFINITY_CPU | AGO_TARGET_AFFINITY_GPU)
 	)
 {
-	supported_target_affinity = AGO_TARGET_AFFINITY_GPU;
+	supported_target_affinity = AGO_TARGET_AFFINITY_CPU | AGO_TARGET_AFFINITY_GPU;
 	return VX_SUCCESS;
 }
 
@@ -217,7 +217,36 @@ static vx_status VX_CALLBACK noise_filter_opencl_codegen(
 //! \brief The kernel execution.
 static vx_status VX_CALLBACK noise_filter_kernel(vx_node node, const vx_reference * parameters, vx_uint32 num)
 {
-	return VX_ERROR_NOT_SUPPORTED;
+	// get lambda and image configurations
+	vx_float32 lambda = 0.0f;
+	ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[0], &lambda));
+	vx_image images[3] = { (vx_image)parameters[1], (vx_image)parameters[2], (vx_image)parameters[3] };
+	vx_uint32 width = 0, height = 0;
+	ERROR_CHECK_STATUS(vxQueryImage(images[0], VX_IMAGE_ATTRIBUTE_WIDTH, &width, sizeof(width)));
+	ERROR_CHECK_STATUS(vxQueryImage(images[0], VX_IMAGE_ATTRIBUTE_HEIGHT, &height, sizeof(height)));
+	vx_rectangle_t rect = { 0, 0, width, height };
+	vx_imagepatch_addressing_t addr[3];
+	vx_uint8 * ptr[3] = { nullptr, nullptr, nullptr };
+	for (vx_uint32 i = 0; i < 3; i++) {
+		ERROR_CHECK_STATUS(vxAccessImagePatch(images[i], &rect, 0, &addr[i], (void **)&ptr[i], (i == 2) ? VX_WRITE_ONLY : VX_READ_ONLY));
+	}
+
+	// blend the current frame with the previous output: op = lambda * ip0 + (1 - lambda) * ip1
+	float oneMinusLambda = 1.0f - lambda;
+#pragma omp parallel for
+	for (vx_int32 y = 0; y < (vx_int32)height; y++) {
+		const vx_uint8 * ip0 = ptr[0] + y * addr[0].stride_y;
+		const vx_uint8 * ip1 = ptr[1] + y * addr[1].stride_y;
+		vx_uint8 * op = ptr[2] + y * addr[2].stride_y;
+		for (vx_uint32 x = 0; x < width * 3; x++) {
+			op[x] = StitchPackU8(ip0[x] * lambda + ip1[x] * oneMinusLambda);
+		}
+	}
+
+	for (vx_uint32 i = 0; i < 3; i++) {
+		ERROR_CHECK_STATUS(vxCommitImagePatch(images[i], &rect, 0, &addr[i], ptr[i]));
+	}
+	return VX_SUCCESS;
 }
 
 //! \brief The kernel publisher.
@@ -233,10 +262,12 @@ vx_status noise_filter_publish(vx_context context)
 		nullptr,
 		nullptr);
 	ERROR_CHECK_OBJECT(kernel);
+#if ENABLE_OPENCL
 	amd_kernel_query_target_support_f query_target_support_f = noise_filter_query_target_support;
 	amd_kernel_opencl_codegen_callback_f opencl_codegen_callback_f = noise_filter_opencl_codegen;
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_QUERY_TARGET_SUPPORT, &query_target_support_f, sizeof(query_target_support_f)));
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_OPENCL_CODEGEN_CALLBACK, &opencl_codegen_callback_f, sizeof(opencl_codegen_callback_f)));
+#endif
 
 	// set kernel parameters
 	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 0, VX_INPUT, VX_TYPE_SCALAR, VX_PARAMETER_STATE_REQUIRED));
@@ -24,6 +24,45 @@ THE SOFTWARE.
 #include "pyramid_scale.h"
 #include "multiband_blender.h"
 
+//////////////////////////////////////////////////////////////////////
+// CPU helpers shared by the pyramid kernels: each camera band is clamped vertically
+// and wrapped horizontally, like the equirectangular image the pyramid is built from.
+static inline vx_int32 pyramid_wrap_x(vx_int32 x, vx_int32 width)
+{
+	x %= width;
+	return x < 0 ? x + width : x;
+}
+static inline vx_int32 pyramid_clamp_y(vx_int32 y, vx_int32 height)
+{
+	return std::min(std::max(y, 0), height - 1);
+}
+static inline __m128 pyramid_load(const vx_uint8 * row, vx_int32 x, vx_df_image format)
+{
+	if (format == VX_DF_IMAGE_RGBX) return StitchLoadRGBX(row + x * 4);
+	else if (format == VX_DF_IMAGE_RGB4_AMD) return StitchLoadRGB4((const vx_int16 *)row + x * 3);
+	else if (format == VX_DF_IMAGE_S16) return _mm_set1_ps((float)((const vx_int16 *)row)[x]);
+	return _mm_set1_ps((float)row[x]);
+}
+//! \brief Upsample the half resolution band at full resolution (x, y): [1 6 1] at even and [4 4] at odd positions, normalized by 64.
+static __m128 pyramid_upsample(const vx_uint8 * band, vx_uint32 stride, vx_df_image format, vx_int32 width, vx_int32 height, vx_int32 x, vx_int32 y)
+{
+	static const float even[3] = { 1.0f, 6.0f, 1.0f }, odd[3] = { 0.0f, 4.0f, 4.0f };
+	const float * cx = (x & 1) ? odd : even, *cy = (y & 1) ? odd : even;
+	vx_int32 ix = (x >> 1) - 1, iy = (y >> 1) - 1;
+	__m128 sum = _mm_setzero_ps();
+	for (vx_int32 j = 0; j < 3; j++) {
+		if (cy[j] == 0.0f) continue;
+		const vx_uint8 * row = band + pyramid_clamp_y(iy + j, height) * stride;
+		__m128 hsum = _mm_setzero_ps();
+		for (vx_int32 i = 0; i < 3; i++) {
+			if (cx[i] != 0.0f)
+				hsum = _mm_add_ps(hsum, _mm_mul_ps(pyramid_load(row, pyramid_wrap_x(ix + i, width), format), _mm_set1_ps(cx[i])));
+		}
+		sum = _mm_add_ps(sum, _mm_mul_ps(hsum, _mm_set1_ps(cy[j])));
+	}
+	return _mm_mul_ps(sum, _mm_set1_ps(0.015625f));
+}
+
 //! \brief The input validator callback.
 static vx_status VX_CALLBACK half_scale_gaussian_input_validator(vx_node node, vx_uint32 index)
 {
@@ -149,7 +188,7 @@ static vx_status VX_CALLBACK half_scale_gaussian_query_target_support(vx_graph g
 	vx_uint32& supported_target_affinity // [output] must be set to AGO_TARGET_AFFINITY_CPU or AGO_TARGET_AFFINITY_GPU or (AGO_TARGET_AFFINITY_CPU | AGO_TARGET_AFFINITY_GPU)
 	)
 {
-	supported_target_affinity = AGO_TARGET_AFFINITY_GPU;
+	supported_target_affinity = AGO_TARGET_AFFINITY_CPU | AGO_TARGET_AFFINITY_GPU;
 	return VX_SUCCESS;
 }
 
@@ -678,7 +717,67 @@ static vx_status VX_CALLBACK half_scale_gaussian_opencl_codegen(
 //! \brief The kernel execution.
 static vx_status VX_CALLBACK half_scale_gaussian_kernel(vx_node node, const vx_reference * parameters, vx_uint32 num)
 {
-	return VX_ERROR_NOT_SUPPORTED;
+	vx_uint32 numCam = 0, arr_offset = 0;
+	ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[0], &numCam));
+	ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[1], &arr_offset));
+	vx_array arr = (vx_array)parameters[2];
+	vx_image input = (vx_image)parameters[3];
+	vx_image output = (vx_image)parameters[4];
+	vx_uint32 input_width = 0, input_height = 0, output_width = 0, output_height = 0;
+	vx_df_image input_format = VX_DF_IMAGE_VIRT, output_format = VX_DF_IMAGE_VIRT;
+	ERROR_CHECK_STATUS(vxQueryImage(input, VX_IMAGE_ATTRIBUTE_WIDTH, &input_width, sizeof(input_width)));
+	ERROR_CHECK_STATUS(vxQueryImage(input, VX_IMAGE_ATTRIBUTE_HEIGHT, &input_height, sizeof(input_height)));
+	ERROR_CHECK_STATUS(vxQueryImage(input, VX_IMAGE_ATTRIBUTE_FORMAT, &input_format, sizeof(input_format)));
+	ERROR_CHECK_STATUS(vxQueryImage(output, VX_IMAGE_ATTRIBUTE_WIDTH, &output_width, sizeof(output_width)));
+	ERROR_CHECK_STATUS(vxQueryImage(output, VX_IMAGE_ATTRIBUTE_HEIGHT, &output_height, sizeof(output_height)));
+	ERROR_CHECK_STATUS(vxQueryImage(output, VX_IMAGE_ATTRIBUTE_FORMAT, &output_format, sizeof(output_format)));
+	if (!numCam) numCam = 1;
+	vx_int32 ip_height1 = (vx_int32)(input_height / numCam), op_height1 = (vx_int32)(output_height / numCam);
+	// the filter taps sum to 256: U8 to S16 scales by 0.5 (multiply by 128 to increase precision), U8 to U8 normalizes by 1/256
+	float norm = (input_format == VX_DF_IMAGE_U8 && output_format == VX_DF_IMAGE_S16) ? 0.5f : 0.00390625f;
+
+	vx_size arr_numitems = 0, num_entries = 0; void * arr_base = nullptr;
+	const StitchBlendValidEntry * entries = nullptr;
+	ERROR_CHECK_STATUS(AccessBlendValidEntries(arr, arr_offset, &arr_numitems, &arr_base, &entries, &num_entries));
+	vx_rectangle_t input_rect = { 0, 0, input_width, input_height }, output_rect = { 0, 0, output_width, output_height };
+	vx_imagepatch_addressing_t addr_in, addr_out;
+	vx_uint8 * ptr_in = nullptr, *ptr_out = nullptr;
+	ERROR_CHECK_STATUS(vxAccessImagePatch(input, &input_rect, 0, &addr_in, (void **)&ptr_in, VX_READ_ONLY));
+	ERROR_CHECK_STATUS(vxAccessImagePatch(output, &output_rect, 0, &addr_out, (void **)&ptr_out, VX_READ_AND_WRITE));
+
+	// each entry covers up to 64x16 output pixels: 5x5 gaussian [1 4 6 4 1] centered at input (2x+1, 2y+1)
+	static const float coef[5] = { 1.0f, 4.0f, 6.0f, 4.0f, 1.0f };
+#pragma omp parallel for
+	for (vx_int32 i = 0; i < (vx_int32)num_entries; i++) {
+		const vx_uint32 * entry = (const vx_uint32 *)&entries[i];
+		vx_int32 camId = entry[0] & 0x1f, gx = (entry[0] >> 5) & 0x3fff, gy = (entry[0] >> 19) & 0x1fff;
+		vx_int32 end_x = std::min(gx + 4 * (std::min((vx_int32)(entry[1] & 0xff) >> 2, 15) + 1), (vx_int32)output_width);
+		vx_int32 end_y = std::min(gy + std::min((vx_int32)((entry[1] >> 8) & 0xff), 15) + 1, op_height1);
+		const vx_uint8 * pInBand = ptr_in + camId * ip_height1 * addr_in.stride_y;
+		vx_uint8 * pOutBand = ptr_out + camId * op_height1 * addr_out.stride_y;
+		for (vx_int32 y = gy; y < end_y; y++) {
+			vx_uint8 * pOut = pOutBand + y * addr_out.stride_y;
+			for (vx_int32 x = gx; x < end_x; x++) {
+				__m128 sum = _mm_setzero_ps();
+				for (vx_int32 j = 0; j < 5; j++) {
+					const vx_uint8 * row = pInBand + pyramid_clamp_y(2 * y - 1 + j, ip_height1) * addr_in.stride_y;
+					__m128 hsum = _mm_setzero_ps();
+					for (vx_int32 k = 0; k < 5; k++)
+						hsum = _mm_add_ps(hsum, _mm_mul_ps(pyramid_load(row, pyramid_wrap_x(2 * x - 1 + k, input_width), input_format), _mm_set1_ps(coef[k])));
+					sum = _mm_add_ps(sum, _mm_mul_ps(hsum, _mm_set1_ps(coef[j])));
+				}
+				sum = _mm_mul_ps(sum, _mm_set1_ps(norm));
+				if (output_format == VX_DF_IMAGE_RGBX) ((vx_uint32 *)pOut)[x] = StitchPackRGBX(sum);
+				else if (output_format == VX_DF_IMAGE_S16) ((vx_int16 *)pOut)[x] = StitchPackS16(_mm_cvtss_f32(sum));
+				else pOut[x] = StitchPackU8(_mm_cvtss_f32(sum));
+			}
+		}
+	}
+
+	ERROR_CHECK_STATUS(vxCommitImagePatch(input, &input_rect, 0, &addr_in, ptr_in));
+	ERROR_CHECK_STATUS(vxCommitImagePatch(output, &output_rect, 0, &addr_out, ptr_out));
+	ERROR_CHECK_STATUS(vxCommitArrayRange(arr, 0, arr_numitems, arr_base));
+	return VX_SUCCESS;
 }
 
 //! \brief The kernel publisher.
@@ -694,12 +793,14 @@ vx_status half_scale_gaussian_publish(vx_context context)
 		nullptr,
 		nullptr);
 	ERROR_CHECK_OBJECT(kernel);
+#if ENABLE_OPENCL
 	amd_kernel_query_target_support_f query_target_support_f = half_scale_gaussian_query_target_support;
 	amd_kernel_opencl_codegen_callback_f opencl_codegen_callback_f = half_scale_gaussian_opencl_codegen;
 	amd_kernel_opencl_global_work_update_callback_f opencl_global_work_update_callback_f = half_scale_gaussian_opencl_global_work_update;
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_QUERY_TARGET_SUPPORT, &query_target_support_f, sizeof(query_target_support_f)));
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_OPENCL_CODEGEN_CALLBACK, &opencl_codegen_callback_f, sizeof(opencl_codegen_callback_f)));
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_OPENCL_GLOBAL_WORK_UPDATE_CALLBACK, &opencl_global_work_update_callback_f, sizeof(opencl_global_work_update_callback_f)));
+#endif
 
 	// set kernel parameters
 	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 0, VX_INPUT, VX_TYPE_SCALAR, VX_PARAMETER_STATE_REQUIRED));
@@ -858,14 +959,79 @@ static vx_status VX_CALLBACK upscale_gaussian_subtract_query_target_support(vx_g
 	vx_uint32& supported_target_affinity // [output] must be set to AGO_TARGET_AFFINITY_CPU or AGO_TARGET_AFFINITY_GPU or (AGO_TARGET_AFFINITY_CPU | AGO_TARGET_AFFINITY_GPU)
 	)
 {
-	supported_target_affinity = AGO_TARGET_AFFINITY_GPU;
+	supported_target_affinity = AGO_TARGET_AFFINITY_CPU | AGO_TARGET_AFFINITY_GPU;
 	return VX_SUCCESS;
 }
 
 //! \brief The kernel execution.
 static vx_status VX_CALLBACK upscale_gaussian_subtract_kernel(vx_node node, const vx_reference * parameters, vx_uint32 num)
 {
-	return VX_ERROR_NOT_IMPLEMENTED;
+	vx_uint32 numCam = 0, arr_offset = 0;
+	ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[0], &numCam));
+	ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[1], &arr_offset));
+	vx_image input = (vx_image)parameters[2];
+	vx_image input_half = (vx_image)parameters[3];
+	vx_array arr = (vx_array)parameters[4];
+	vx_image weight = (vx_image)parameters[5];
+	vx_image output = (vx_image)parameters[6];
+	vx_uint32 width = 0, height = 0, half_width = 0, half_height = 0;
+	vx_df_image wt_format = VX_DF_IMAGE_VIRT;
+	ERROR_CHECK_STATUS(vxQueryImage(output, VX_IMAGE_ATTRIBUTE_WIDTH, &width, sizeof(width)));
+	ERROR_CHECK_STATUS(vxQueryImage(output, VX_IMAGE_ATTRIBUTE_HEIGHT, &height, sizeof(height)));
+	ERROR_CHECK_STATUS(vxQueryImage(input_half, VX_IMAGE_ATTRIBUTE_WIDTH, &half_width, sizeof(half_width)));
+	ERROR_CHECK_STATUS(vxQueryImage(input_half, VX_IMAGE_ATTRIBUTE_HEIGHT, &half_height, sizeof(half_height)));
+	if (weight) {
+		ERROR_CHECK_STATUS(vxQueryImage(weight, VX_IMAGE_ATTRIBUTE_FORMAT, &wt_format, sizeof(wt_format)));
+	}
+	if (!numCam) numCam = 1;
+	vx_int32 height1 = (vx_int32)(height / numCam), half_height1 = (vx_int32)(half_height / numCam);
+	float divfactor = (wt_format == VX_DF_IMAGE_U8) ? 0.0627451f : 0.000490196f;
+
+	vx_size arr_numitems = 0, num_entries = 0; void * arr_base = nullptr;
+	const StitchBlendValidEntry * entries = nullptr;
+	ERROR_CHECK_STATUS(AccessBlendValidEntries(arr, arr_offset, &arr_numitems, &arr_base, &entries, &num_entries));
+	vx_rectangle_t rect = { 0, 0, width, height }, half_rect = { 0, 0, half_width, half_height };
+	vx_imagepatch_addressing_t addr_in, addr_half, addr_wt, addr_out;
+	vx_uint8 * ptr_in = nullptr, *ptr_half = nullptr, *ptr_wt = nullptr, *ptr_out = nullptr;
+	ERROR_CHECK_STATUS(vxAccessImagePatch(input, &rect, 0, &addr_in, (void **)&ptr_in, VX_READ_ONLY));
+	ERROR_CHECK_STATUS(vxAccessImagePatch(input_half, &half_rect, 0, &addr_half, (void **)&ptr_half, VX_READ_ONLY));
+	if (weight) {
+		ERROR_CHECK_STATUS(vxAccessImagePatch(weight, &rect, 0, &addr_wt, (void **)&ptr_wt, VX_READ_ONLY));
+	}
+	ERROR_CHECK_STATUS(vxAccessImagePatch(output, &rect, 0, &addr_out, (void **)&ptr_out, VX_READ_AND_WRITE));
+
+	// each entry covers up to 64x16 pixels: out = (input - upsample(input_half)) * weight
+#pragma omp parallel for
+	for (vx_int32 i = 0; i < (vx_int32)num_entries; i++) {
+		const vx_uint32 * entry = (const vx_uint32 *)&entries[i];
+		vx_int32 camId = entry[0] & 0x1f, gx = (entry[0] >> 5) & 0x3fff, gy = (entry[0] >> 19) & 0x1fff;
+		vx_int32 end_x = std::min(gx + 4 * (std::min((vx_int32)(entry[1] & 0xff) >> 2, 15) + 1), (vx_int32)width);
+		vx_int32 end_y = std::min(gy + 2 * (std::min((vx_int32)((entry[1] >> 8) & 0xff) >> 1, 7) + 1), height1);
+		const vx_uint8 * pHalfBand = ptr_half + camId * half_height1 * addr_half.stride_y;
+		for (vx_int32 y = gy; y < end_y; y++) {
+			vx_int32 row = camId * height1 + y;
+			const vx_uint8 * pIn = ptr_in + row * addr_in.stride_y;
+			vx_int16 * pOut = (vx_int16 *)(ptr_out + row * addr_out.stride_y);
+			for (vx_int32 x = gx; x < end_x; x++) {
+				__m128 f = _mm_sub_ps(StitchLoadRGBX(pIn + x * 4), pyramid_upsample(pHalfBand, addr_half.stride_y, VX_DF_IMAGE_RGBX, half_width, half_height1, x, y));
+				if (ptr_wt) {
+					const vx_uint8 * pWt = ptr_wt + row * addr_wt.stride_y;
+					float w = (wt_format == VX_DF_IMAGE_U8) ? (float)pWt[x] : (float)((const vx_int16 *)pWt)[x];
+					f = _mm_mul_ps(f, _mm_set1_ps(w * divfactor));
+				}
+				StitchStoreRGB4(pOut + x * 3, f);
+			}
+		}
+	}
+
+	ERROR_CHECK_STATUS(vxCommitImagePatch(input, &rect, 0, &addr_in, ptr_in));
+	ERROR_CHECK_STATUS(vxCommitImagePatch(input_half, &half_rect, 0, &addr_half, ptr_half));
+	if (weight) {
+		ERROR_CHECK_STATUS(vxCommitImagePatch(weight, &rect, 0, &addr_wt, ptr_wt));
+	}
+	ERROR_CHECK_STATUS(vxCommitImagePatch(output, &rect, 0, &addr_out, ptr_out));
+	ERROR_CHECK_STATUS(vxCommitArrayRange(arr, 0, arr_numitems, arr_base));
+	return VX_SUCCESS;
 }
 
 //! \brief The OpenCL code generator callback.
@@ -1245,12 +1411,14 @@ vx_status upscale_gaussian_subtract_publish(vx_context context)
 		nullptr,
 		nullptr);
 	ERROR_CHECK_OBJECT(kernel);
+#if ENABLE_OPENCL
 	amd_kernel_query_target_support_f query_target_support_f = upscale_gaussian_subtract_query_target_support;
 	amd_kernel_opencl_codegen_callback_f opencl_codegen_callback_f = upscale_gaussian_subtract_opencl_codegen;
 	amd_kernel_opencl_global_work_update_callback_f opencl_global_work_update_callback_f = upscale_gaussian_subtract_opencl_global_work_update;
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_QUERY_TARGET_SUPPORT, &query_target_support_f, sizeof(query_target_support_f)));
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_OPENCL_CODEGEN_CALLBACK, &opencl_codegen_callback_f, sizeof(opencl_codegen_callback_f)));
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_OPENCL_GLOBAL_WORK_UPDATE_CALLBACK, &opencl_global_work_update_callback_f, sizeof(opencl_global_work_update_callback_f)));
+#endif
 	// set kernel parameters
 	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 0, VX_INPUT, VX_TYPE_SCALAR, VX_PARAMETER_STATE_REQUIRED));
 	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 1, VX_INPUT, VX_TYPE_SCALAR, VX_PARAMETER_STATE_REQUIRED));
@@ -1385,14 +1553,62 @@ static vx_status VX_CALLBACK upscale_gaussian_add_query_target_support(vx_graph
 	vx_uint32& supported_target_affinity // [output] must be set to AGO_TARGET_AFFINITY_CPU or AGO_TARGET_AFFINITY_GPU or (AGO_TARGET_AFFINITY_CPU | AGO_TARGET_AFFINITY_GPU)
 	)
 {
-	supported_target_affinity = AGO_TARGET_AFFINITY_GPU;
+	supported_target_affinity = AGO_TARGET_AFFINITY_CPU | AGO_TARGET_AFFINITY_GPU;
 	return VX_SUCCESS;
 }
 
 //! \brief The kernel execution.
 static vx_status VX_CALLBACK upscale_gaussian_add_kernel(vx_node node, const vx_reference * parameters, vx_uint32 num)
 {
-	return VX_ERROR_NOT_IMPLEMENTED;
+	vx_uint32 numCam = 0, arr_offset = 0;
+	ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[0], &numCam));
+	ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[1], &arr_offset));
+	vx_image input = (vx_image)parameters[2];
+	vx_image input_half = (vx_image)parameters[3];
+	vx_array arr = (vx_array)parameters[4];
+	vx_image output = (vx_image)parameters[5];
+	vx_uint32 width = 0, height = 0, half_width = 0, half_height = 0;
+	ERROR_CHECK_STATUS(vxQueryImage(output, VX_IMAGE_ATTRIBUTE_WIDTH, &width, sizeof(width)));
+	ERROR_CHECK_STATUS(vxQueryImage(output, VX_IMAGE_ATTRIBUTE_HEIGHT, &height, sizeof(height)));
+	ERROR_CHECK_STATUS(vxQueryImage(input_half, VX_IMAGE_ATTRIBUTE_WIDTH, &half_width, sizeof(half_width)));
+	ERROR_CHECK_STATUS(vxQueryImage(input_half, VX_IMAGE_ATTRIBUTE_HEIGHT, &half_height, sizeof(half_height)));
+	if (!numCam) numCam = 1;
+	vx_int32 height1 = (vx_int32)(height / numCam), half_height1 = (vx_int32)(half_height / numCam);
+
+	vx_size arr_numitems = 0, num_entries = 0; void * arr_base = nullptr;
+	const StitchBlendValidEntry * entries = nullptr;
+	ERROR_CHECK_STATUS(AccessBlendValidEntries(arr, arr_offset, &arr_numitems, &arr_base, &entries, &num_entries));
+	vx_rectangle_t rect = { 0, 0, width, height }, half_rect = { 0, 0, half_width, half_height };
+	vx_imagepatch_addressing_t addr_in, addr_half, addr_out;
+	vx_uint8 * ptr_in = nullptr, *ptr_half = nullptr, *ptr_out = nullptr;
+	ERROR_CHECK_STATUS(vxAccessImagePatch(input, &rect, 0, &addr_in, (void **)&ptr_in, VX_READ_ONLY));
+	ERROR_CHECK_STATUS(vxAccessImagePatch(input_half, &half_rect, 0, &addr_half, (void **)&ptr_half, VX_READ_ONLY));
+	ERROR_CHECK_STATUS(vxAccessImagePatch(output, &rect, 0, &addr_out, (void **)&ptr_out, VX_READ_AND_WRITE));
+
+	// each entry covers up to 64x16 pixels: out = input + upsample(input_half)
+#pragma omp parallel for
+	for (vx_int32 i = 0; i < (vx_int32)num_entries; i++) {
+		const vx_uint32 * entry = (const vx_uint32 *)&entries[i];
+		vx_int32 camId = entry[0] & 0x1f, gx = (entry[0] >> 5) & 0x3fff, gy = (entry[0] >> 19) & 0x1fff;
+		vx_int32 end_x = std::min(gx + 8 * (std::min((vx_int32)(entry[1] & 0xff) >> 3, 7) + 1), (vx_int32)width);
+		vx_int32 end_y = std::min(gy + 2 * (std::min((vx_int32)((entry[1] >> 8) & 0xff) >> 1, 7) + 1), height1);
+		const vx_uint8 * pHalfBand = ptr_half + camId * half_height1 * addr_half.stride_y;
+		for (vx_int32 y = gy; y < end_y; y++) {
+			vx_int32 row = camId * height1 + y;
+			const vx_int16 * pIn = (const vx_int16 *)(ptr_in + row * addr_in.stride_y);
+			vx_uint8 * pOut = ptr_out + row * addr_out.stride_y;
+			for (vx_int32 x = gx; x < end_x; x++) {
+				__m128 f = _mm_add_ps(StitchLoadRGB4(pIn + x * 3), pyramid_upsample(pHalfBand, addr_half.stride_y, VX_DF_IMAGE_RGB4_AMD, half_width, half_height1, x, y));
+				StitchStoreRGB4((vx_int16 *)pOut + x * 3, f);
+			}
+		}
+	}
+
+	ERROR_CHECK_STATUS(vxCommitImagePatch(input, &rect, 0, &addr_in, ptr_in));
+	ERROR_CHECK_STATUS(vxCommitImagePatch(input_half, &half_rect, 0, &addr_half, ptr_half));
+	ERROR_CHECK_STATUS(vxCommitImagePatch(output, &rect, 0, &addr_out, ptr_out));
+	ERROR_CHECK_STATUS(vxCommitArrayRange(arr, 0, arr_numitems, arr_base));
+	return VX_SUCCESS;
 }
 
 //! \brief The OpenCL code generator callback.
@@ -1653,12 +1869,14 @@ vx_status upscale_gaussian_add_publish(vx_context context)
 		nullptr,
 		nullptr);
 	ERROR_CHECK_OBJECT(kernel);
+#if ENABLE_OPENCL
 	amd_kernel_query_target_support_f query_target_support_f = upscale_gaussian_add_query_target_support;
 	amd_kernel_opencl_codegen_callback_f opencl_codegen_callback_f = upscale_gaussian_add_opencl_codegen;
 	amd_kernel_opencl_global_work_update_callback_f opencl_global_work_update_callback_f = upscale_gaussian_add_opencl_global_work_update;
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_QUERY_TARGET_SUPPORT, &query_target_support_f, sizeof(query_target_support_f)));
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_OPENCL_CODEGEN_CALLBACK, &opencl_codegen_callback_f, sizeof(opencl_codegen_callback_f)));
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_OPENCL_GLOBAL_WORK_UPDATE_CALLBACK, &opencl_global_work_update_callback_f, sizeof(opencl_global_work_update_callback_f)));
+#endif
  
 	// set kernel parameters
 	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 0, VX_INPUT, VX_TYPE_SCALAR, VX_PARAMETER_STATE_REQUIRED));
@@ -1793,14 +2011,62 @@ static vx_status VX_CALLBACK laplacian_reconstruct_query_target_support(vx_graph
 	vx_uint32& supported_target_affinity // [output] must be set to AGO_TARGET_AFFINITY_CPU or AGO_TARGET_AFFINITY_GPU or (AGO_TARGET_AFFINITY_CPU | AGO_TARGET_AFFINITY_GPU)
 	)
 {
-	supported_target_affinity = AGO_TARGET_AFFINITY_GPU;
+	supported_target_affinity = AGO_TARGET_AFFINITY_CPU | AGO_TARGET_AFFINITY_GPU;
 	return VX_SUCCESS;
 }
 
 //! \brief The kernel execution.
 static vx_status VX_CALLBACK laplacian_reconstruct_kernel(vx_node node, const vx_reference * parameters, vx_uint32 num)
 {
-	return VX_ERROR_NOT_IMPLEMENTED;
+	vx_uint32 numCam = 0, arr_offset = 0;
+	ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[0], &numCam));
+	ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[1], &arr_offset));
+	vx_image input = (vx_image)parameters[2];
+	vx_image input_half = (vx_image)parameters[3];
+	vx_array arr = (vx_array)parameters[4];
+	vx_image output = (vx_image)parameters[5];
+	vx_uint32 width = 0, height = 0, half_width = 0, half_height = 0;
+	ERROR_CHECK_STATUS(vxQueryImage(output, VX_IMAGE_ATTRIBUTE_WIDTH, &width, sizeof(width)));
+	ERROR_CHECK_STATUS(vxQueryImage(output, VX_IMAGE_ATTRIBUTE_HEIGHT, &height, sizeof(height)));
+	ERROR_CHECK_STATUS(vxQueryImage(input_half, VX_IMAGE_ATTRIBUTE_WIDTH, &half_width, sizeof(half_width)));
+	ERROR_CHECK_STATUS(vxQueryImage(input_half, VX_IMAGE_ATTRIBUTE_HEIGHT, &half_height, sizeof(half_height)));
+	if (!numCam) numCam = 1;
+	vx_int32 height1 = (vx_int32)(height / numCam), half_height1 = (vx_int32)(half_height / numCam);
+
+	vx_size arr_numitems = 0, num_entries = 0; void * arr_base = nullptr;
+	const StitchBlendValidEntry * entries = nullptr;
+	ERROR_CHECK_STATUS(AccessBlendValidEntries(arr, arr_offset, &arr_numitems, &arr_base, &entries, &num_entries));
+	vx_rectangle_t rect = { 0, 0, width, height }, half_rect = { 0, 0, half_width, half_height };
+	vx_imagepatch_addressing_t addr_in, addr_half, addr_out;
+	vx_uint8 * ptr_in = nullptr, *ptr_half = nullptr, *ptr_out = nullptr;
+	ERROR_CHECK_STATUS(vxAccessImagePatch(input, &rect, 0, &addr_in, (void **)&ptr_in, VX_READ_ONLY));
+	ERROR_CHECK_STATUS(vxAccessImagePatch(input_half, &half_rect, 0, &addr_half, (void **)&ptr_half, VX_READ_ONLY));
+	ERROR_CHECK_STATUS(vxAccessImagePatch(output, &rect, 0, &addr_out, (void **)&ptr_out, VX_READ_AND_WRITE));
+
+	// each entry covers up to 64x16 pixels: out = (input + upsample(input_half)) / 16 with opaque alpha
+#pragma omp parallel for
+	for (vx_int32 i = 0; i < (vx_int32)num_entries; i++) {
+		const vx_uint32 * entry = (const vx_uint32 *)&entries[i];
+		vx_int32 camId = entry[0] & 0x1f, gx = (entry[0] >> 5) & 0x3fff, gy = (entry[0] >> 19) & 0x1fff;
+		vx_int32 end_x = std::min(gx + 8 * (std::min((vx_int32)(entry[1] & 0xff) >> 3, 7) + 1), (vx_int32)width);
+		vx_int32 end_y = std::min(gy + 2 * (std::min((vx_int32)((entry[1] >> 8) & 0xff) >> 1, 7) + 1), height1);
+		const vx_uint8 * pHalfBand = ptr_half + camId * half_height1 * addr_half.stride_y;
+		for (vx_int32 y = gy; y < end_y; y++) {
+			vx_int32 row = camId * height1 + y;
+			const vx_int16 * pIn = (const vx_int16 *)(ptr_in + row * addr_in.stride_y);
+			vx_uint8 * pOut = ptr_out + row * addr_out.stride_y;
+			for (vx_int32 x = gx; x < end_x; x++) {
+				__m128 f = _mm_add_ps(StitchLoadRGB4(pIn + x * 3), pyramid_upsample(pHalfBand, addr_half.stride_y, VX_DF_IMAGE_RGB4_AMD, half_width, half_height1, x, y));
+				((vx_uint32 *)pOut)[x] = (StitchPackRGBX(_mm_mul_ps(f, _mm_set1_ps(0.0625f))) & 0x00ffffff) | 0xff000000;
+			}
+		}
+	}
+
+	ERROR_CHECK_STATUS(vxCommitImagePatch(input, &rect, 0, &addr_in, ptr_in));
+	ERROR_CHECK_STATUS(vxCommitImagePatch(input_half, &half_rect, 0, &addr_half, ptr_half));
+	ERROR_CHECK_STATUS(vxCommitImagePatch(output, &rect, 0, &addr_out, ptr_out));
+	ERROR_CHECK_STATUS(vxCommitArrayRange(arr, 0, arr_numitems, arr_base));
+	return VX_SUCCESS;
 }
 
 //! \brief The OpenCL code generator callback.
@@ -2068,12 +2334,14 @@ vx_status laplacian_reconstruct_publish(vx_context context)
 		nullptr);
 	ERROR_CHECK_OBJECT(kernel);
 
+#if ENABLE_OPENCL
 	amd_kernel_opencl_global_work_update_callback_f opencl_global_work_update_callback_f = laplacian_reconstruct_opencl_global_work_update;
 	amd_kernel_query_target_support_f query_target_support_f = laplacian_reconstruct_query_target_support;
 	amd_kernel_opencl_codegen_callback_f opencl_codegen_callback_f = laplacian_reconstruct_opencl_codegen;
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_QUERY_TARGET_SUPPORT, &query_target_support_f, sizeof(query_target_support_f)));
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_OPENCL_CODEGEN_CALLBACK, &opencl_codegen_callback_f, sizeof(opencl_codegen_callback_f)));
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_OPENCL_GLOBAL_WORK_UPDATE_CALLBACK, &opencl_global_work_update_callback_f, sizeof(opencl_global_work_update_callback_f)));
+#endif
 	// set kernel parameters
 	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 0, VX_INPUT, VX_TYPE_SCALAR, VX_PARAMETER_STATE_REQUIRED));
 	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 1, VX_INPUT, VX_TYPE_SCALAR, VX_PARAMETER_STATE_REQUIRED));
@@ -745,7 +745,7 @@ static vx_status VX_CALLBACK seamfind_scene_detect_query_target_support(vx_graph
 	if (StitchGetEnvironmentVariable("SEAM_FIND_TARGET", textBuffer, sizeof(textBuffer))) { SEAM_FIND_TARGET = atoi(textBuffer); }
 
 	if (!SEAM_FIND_TARGET)
-		supported_target_affinity = AGO_TARGET_AFFINITY_GPU;
+		supported_target_affinity = AGO_TARGET_AFFINITY_CPU | AGO_TARGET_AFFINITY_GPU;
 	else
 		supported_target_affinity = AGO_TARGET_AFFINITY_CPU;
 
@@ -1269,12 +1269,14 @@ vx_status seamfind_scene_detect_publish(vx_context context)
 		nullptr,
 		nullptr);
 	ERROR_CHECK_OBJECT(kernel);
+#if ENABLE_OPENCL
 	amd_kernel_query_target_support_f query_target_support_f = seamfind_scene_detect_query_target_support;
 	amd_kernel_opencl_codegen_callback_f opencl_codegen_callback_f = seamfind_scene_detect_opencl_codegen;
 	amd_kernel_opencl_global_work_update_callback_f opencl_global_work_update_callback_f = seamfind_scene_detect_opencl_global_work_update;
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_QUERY_TARGET_SUPPORT, &query_target_support_f, sizeof(query_target_support_f)));
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_OPENCL_CODEGEN_CALLBACK, &opencl_codegen_callback_f, sizeof(opencl_codegen_callback_f)));
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_OPENCL_GLOBAL_WORK_UPDATE_CALLBACK, &opencl_global_work_update_callback_f, sizeof(opencl_global_work_update_callback_f)));
+#endif
 
 	// set kernel parameters
 	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 0, VX_INPUT, VX_TYPE_SCALAR, VX_PARAMETER_STATE_REQUIRED));
@@ -1380,7 +1382,7 @@ static vx_status VX_CALLBACK seamfind_cost_generate_query_target_support(vx_grap
 	vx_uint32& supported_target_affinity // [output] must be set to AGO_TARGET_AFFINITY_CPU or AGO_TARGET_AFFINITY_GPU or (AGO_TARGET_AFFINITY_CPU | AGO_TARGET_AFFINITY_GPU)
 	)
 {
-	supported_target_affinity = AGO_TARGET_AFFINITY_GPU;
+	supported_target_affinity = AGO_TARGET_AFFINITY_CPU | AGO_TARGET_AFFINITY_GPU;
 	return VX_SUCCESS;
 }
 
@@ -1532,7 +1534,50 @@ static vx_status VX_CALLBACK seamfind_cost_generate_opencl_codegen(
 //! \brief The kernel execution.
 static vx_status VX_CALLBACK seamfind_cost_generate_kernel(vx_node node, const vx_reference * parameters, vx_uint32 num)
 {
-	return VX_ERROR_NOT_SUPPORTED;
+	vx_uint32 flag = 0;
+	ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[0], &flag));
+	if (!flag)
+		return VX_SUCCESS;
+
+	// access the input, magnitude and phase images
+	vx_uint32 width = 0, height = 0;
+	ERROR_CHECK_STATUS(vxQueryImage((vx_image)parameters[1], VX_IMAGE_ATTRIBUTE_WIDTH, &width, sizeof(width)));
+	ERROR_CHECK_STATUS(vxQueryImage((vx_image)parameters[1], VX_IMAGE_ATTRIBUTE_HEIGHT, &height, sizeof(height)));
+	vx_rectangle_t rect = { 0, 0, width, height };
+	vx_imagepatch_addressing_t addr[3];
+	vx_uint8 * ptr[3] = { nullptr, nullptr, nullptr };
+	for (vx_uint32 i = 0; i < 3; i++) {
+		ERROR_CHECK_STATUS(vxAccessImagePatch((vx_image)parameters[i + 1], &rect, 0, &addr[i], (void **)&ptr[i], (i == 0) ? VX_READ_ONLY : VX_WRITE_ONLY));
+	}
+
+	// 3x3 sobel: magnitude is |Gx| + |Gy| and phase is the direction quantized to 8 sectors in the upper 3 bits;
+	// the borders replicate the edge pixels
+	const float T1 = 0.4142135623730950488016887242097f, T2 = 2.4142135623730950488016887242097f;
+#pragma omp parallel for
+	for (vx_int32 y = 0; y < (vx_int32)height; y++) {
+		const vx_uint8 * row[3] = {
+			ptr[0] + std::max(y - 1, 0) * addr[0].stride_y,
+			ptr[0] + y * addr[0].stride_y,
+			ptr[0] + std::min(y + 1, (vx_int32)height - 1) * addr[0].stride_y
+		};
+		vx_uint8 * mag = ptr[1] + y * addr[1].stride_y;
+		vx_uint8 * phase = ptr[2] + y * addr[2].stride_y;
+		for (vx_int32 x = 0; x < (vx_int32)width; x++) {
+			vx_int32 xl = std::max(x - 1, 0), xr = std::min(x + 1, (vx_int32)width - 1);
+			float Gx = (float)(row[0][xr] - row[0][xl] + 2 * (row[1][xr] - row[1][xl]) + row[2][xr] - row[2][xl]);
+			float Gy = (float)(row[2][xl] - row[0][xl] + 2 * (row[2][x] - row[0][x]) + row[2][xr] - row[0][xr]);
+			vx_int32 quad = std::signbit(Gx) ? (std::signbit(Gy) ? 2 : 1) : (std::signbit(Gy) ? 3 : 0);
+			Gx = fabsf(Gx); Gy = fabsf(Gy);
+			mag[x] = StitchPackU8(Gx + Gy);
+			vx_int32 sector = ((Gy < T1 * Gx) ? 0 : ((Gy < T2 * Gx) ? 1 : 2)) + 2 * quad;
+			phase[x] = (vx_uint8)((sector > 7 ? 0 : sector) << 5);
+		}
+	}
+
+	for (vx_uint32 i = 0; i < 3; i++) {
+		ERROR_CHECK_STATUS(vxCommitImagePatch((vx_image)parameters[i + 1], &rect, 0, &addr[i], ptr[i]));
+	}
+	return VX_SUCCESS;
 }
 
 //! \brief The kernel publisher.
@@ -1548,12 +1593,14 @@ vx_status seamfind_cost_generate_publish(vx_context context)
 		nullptr,
 		nullptr);
 	ERROR_CHECK_OBJECT(kernel);
+#if ENABLE_OPENCL
 	amd_kernel_query_target_support_f query_target_support_f = seamfind_cost_generate_query_target_support;
 	amd_kernel_opencl_codegen_callback_f opencl_codegen_callback_f = seamfind_cost_generate_opencl_codegen;
 	amd_kernel_opencl_global_work_update_callback_f opencl_global_work_update_callback_f = seamfind_cost_generate_opencl_global_work_update;
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_QUERY_TARGET_SUPPORT, &query_target_support_f, sizeof(query_target_support_f)));
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_OPENCL_CODEGEN_CALLBACK, &opencl_codegen_callback_f, sizeof(opencl_codegen_callback_f)));
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_OPENCL_GLOBAL_WORK_UPDATE_CALLBACK, &opencl_global_work_update_callback_f, sizeof(opencl_global_work_update_callback_f)));
+#endif
 
 	// set kernel parameters
 	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 0, VX_INPUT, VX_TYPE_SCALAR, VX_PARAMETER_STATE_REQUIRED));
@@ -1723,7 +1770,7 @@ static vx_status VX_CALLBACK seamfind_cost_accumulate_query_target_support(vx_gr
 	vx_uint32& supported_target_affinity // [output] must be set to AGO_TARGET_AFFINITY_CPU or AGO_TARGET_AFFINITY_GPU or (AGO_TARGET_AFFINITY_CPU | AGO_TARGET_AFFINITY_GPU)
 	)
 {
-	supported_target_affinity = AGO_TARGET_AFFINITY_GPU;
+	supported_target_affinity = AGO_TARGET_AFFINITY_CPU | AGO_TARGET_AFFINITY_GPU;
 	return VX_SUCCESS;
 }
 
@@ -2242,7 +2289,200 @@ static vx_status VX_CALLBACK seamfind_cost_accumulate_opencl_codegen(
 //! \brief The kernel execution.
 static vx_status VX_CALLBACK seamfind_cost_accumulate_kernel(vx_node node, const vx_reference * parameters, vx_uint32 num)
 {
-	return VX_ERROR_NOT_SUPPORTED;
+	vx_uint32 current_frame = 0, equi_width = 0, equi_height = 0;
+	ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[0], &current_frame));
+	ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[1], &equi_width));
+	ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[2], &equi_height));
+
+	// get developer configurations
+	int COST_SELECT = 0, SEAM_QUALITY = 1;
+	char textBuffer[256];
+	if (StitchGetEnvironmentVariable("COST_SELECT", textBuffer, sizeof(textBuffer)))	{ COST_SELECT = atoi(textBuffer); }
+	if (StitchGetEnvironmentVariable("SEAM_QUALITY", textBuffer, sizeof(textBuffer)))	{ SEAM_QUALITY = atoi(textBuffer); }
+
+	// access the cost (magnitude), phase and mask images
+	vx_uint32 width = 0, height = 0;
+	ERROR_CHECK_STATUS(vxQueryImage((vx_image)parameters[3], VX_IMAGE_ATTRIBUTE_WIDTH, &width, sizeof(width)));
+	ERROR_CHECK_STATUS(vxQueryImage((vx_image)parameters[3], VX_IMAGE_ATTRIBUTE_HEIGHT, &height, sizeof(height)));
+	vx_rectangle_t rect = { 0, 0, width, height };
+	vx_imagepatch_addressing_t addr[3];
+	vx_uint8 * img[3] = { nullptr, nullptr, nullptr };
+	for (vx_uint32 i = 0; i < 3; i++) {
+		ERROR_CHECK_STATUS(vxAccessImagePatch((vx_image)parameters[i + 3], &rect, 0, &addr[i], (void **)&img[i], VX_READ_ONLY));
+	}
+	const vx_uint8 * cost_buf = img[0], * phase_buf = img[1], * mask_buf = img[2];
+	const vx_int32 stride = addr[0].stride_y, max_x = (vx_int32)width - 1, max_y = (vx_int32)height - 1;
+	#define SEAMFIND_PIXEL(buf, x, y) (buf)[std::max(0, std::min((vx_int32)(y), max_y)) * stride + std::max(0, std::min((vx_int32)(x), max_x))]
+
+	// access the valid entries, preferences, overlap information and accumulation buffer
+	vx_size num_valid = 0, num_pref = 0, num_info = 0, num_accum = 0;
+	ERROR_CHECK_STATUS(vxQueryArray((vx_array)parameters[6], VX_ARRAY_ATTRIBUTE_NUMITEMS, &num_valid, sizeof(num_valid)));
+	ERROR_CHECK_STATUS(vxQueryArray((vx_array)parameters[7], VX_ARRAY_ATTRIBUTE_NUMITEMS, &num_pref, sizeof(num_pref)));
+	ERROR_CHECK_STATUS(vxQueryArray((vx_array)parameters[8], VX_ARRAY_ATTRIBUTE_NUMITEMS, &num_info, sizeof(num_info)));
+	ERROR_CHECK_STATUS(vxQueryArray((vx_array)parameters[9], VX_ARRAY_ATTRIBUTE_NUMITEMS, &num_accum, sizeof(num_accum)));
+	if (num_valid == 0 || num_pref == 0 || num_info == 0 || num_accum == 0) {
+		for (vx_uint32 i = 0; i < 3; i++) {
+			ERROR_CHECK_STATUS(vxCommitImagePatch((vx_image)parameters[i + 3], &rect, 0, &addr[i], img[i]));
+		}
+		return VX_SUCCESS;
+	}
+	StitchSeamFindValidEntry * valid = nullptr; StitchSeamFindPreference * pref = nullptr;
+	StitchSeamFindInformation * info = nullptr; StitchSeamFindAccumEntry * accum = nullptr;
+	vx_size stride_valid = sizeof(StitchSeamFindValidEntry), stride_pref = sizeof(StitchSeamFindPreference);
+	vx_size stride_info = sizeof(StitchSeamFindInformation), stride_accum = sizeof(StitchSeamFindAccumEntry);
+	ERROR_CHECK_STATUS(vxAccessArrayRange((vx_array)parameters[6], 0, num_valid, &stride_valid, (void **)&valid, VX_READ_ONLY));
+	ERROR_CHECK_STATUS(vxAccessArrayRange((vx_array)parameters[7], 0, num_pref, &stride_pref, (void **)&pref, VX_READ_ONLY));
+	ERROR_CHECK_STATUS(vxAccessArrayRange((vx_array)parameters[8], 0, num_info, &stride_info, (void **)&info, VX_READ_ONLY));
+	ERROR_CHECK_STATUS(vxAccessArrayRange((vx_array)parameters[9], 0, num_accum, &stride_accum, (void **)&accum, VX_READ_AND_WRITE));
+
+	// every valid entry is one column (vertical seam) or one row (horizontal seam) of an overlap: the OpenCL kernel
+	// walks them in lockstep with a barrier after each step, so step i only reads step i-1 of the neighbour entries
+	std::vector<vx_int32> steps(num_valid, 0);
+	vx_int32 max_steps = 0;
+	for (vx_size k = 0; k < num_valid; k++) {
+		const StitchSeamFindValidEntry& dim = valid[k];
+		if (dim.ID < 0 || (vx_size)dim.ID >= num_pref || (vx_size)dim.ID >= num_info)
+			continue;
+		const StitchSeamFindPreference& p = pref[dim.ID];
+		vx_int32 period = p.frequency + p.seam_type_num;
+		if (p.priority != -1 && (p.start_frame == (vx_int32)current_frame || (period != 0 && ((current_frame + 1) % period) == 0))) {
+			steps[k] = (dim.height >= dim.width) ? dim.height : dim.width;
+			max_steps = std::max(max_steps, steps[k]);
+		}
+	}
+	const vx_int32 NO_COST = 0x7F00FFFF;
+	for (vx_int32 i = 0; i < max_steps; i++) {
+#pragma omp parallel for
+		for (vx_int32 k = 0; k < (vx_int32)num_valid; k++) {
+			if (i >= steps[k])
+				continue;
+			const StitchSeamFindValidEntry& dim = valid[k];
+			const StitchSeamFindInformation& inf = info[dim.ID];
+			vx_int32 input_offset = dim.CAMERA_ID_1 * equi_height;
+			bool vertical = (dim.height >= dim.width);
+			// pixel location in the camera band (x1, y1), in the overlapping camera (x2, y2) and the accumulation entry
+			vx_int32 x1, y1, x2, y2, output_ID;
+			vx_uint8 phase_R = 0, phase_L = 0, magnitude_R = 0, magnitude_L = 0;
+			if (vertical) {
+				x1 = dim.dstX; y1 = dim.dstY + i + input_offset; x2 = dim.OverLapX; y2 = dim.OverLapY + i;
+				output_ID = inf.offset + (dim.dstY - inf.start_y + i) * dim.width + (dim.dstX - inf.start_x);
+				phase_R = SEAMFIND_PIXEL(phase_buf, x1 + 1, y1); magnitude_R = SEAMFIND_PIXEL(cost_buf, x1 + 1, y1);
+				phase_L = SEAMFIND_PIXEL(phase_buf, x1 - 1, y1); magnitude_L = SEAMFIND_PIXEL(cost_buf, x1 - 1, y1);
+			}
+			else {
+				x1 = dim.dstX + i; y1 = dim.dstY + input_offset; x2 = dim.OverLapX + i; y2 = dim.OverLapY;
+				output_ID = inf.offset + (dim.dstX - inf.start_x + i) * dim.height + (dim.dstY - inf.start_y);
+				if (dim.dstY > 0 && dim.dstY < (vx_int32)equi_height) {
+					phase_R = SEAMFIND_PIXEL(phase_buf, x1, y1 + 1); magnitude_R = SEAMFIND_PIXEL(cost_buf, x1, y1 + 1);
+					phase_L = SEAMFIND_PIXEL(phase_buf, x1, y1 - 1); magnitude_L = SEAMFIND_PIXEL(cost_buf, x1, y1 - 1);
+				}
+			}
+			if (output_ID < 0 || (vx_size)output_ID >= num_accum)
+				continue;
+			StitchSeamFindAccumEntry out = accum[output_ID];
+			bool mask = SEAMFIND_PIXEL(mask_buf, x1, y1) && SEAMFIND_PIXEL(mask_buf, x2, y2);
+			vx_int32 cost = SEAMFIND_PIXEL(cost_buf, x1, y1);
+			if (vertical && COST_SELECT)
+				cost = (cost + SEAMFIND_PIXEL(cost_buf, x2, y2)) / 2;
+			vx_int32 Pixel = mask ? cost : NO_COST;
+			// quantize the phase image
+			phase_R >>= 5; phase_L >>= 5;
+
+			if (i == 0) {
+				// parent at the start of the seam set to control value
+				out.parent_x = -1; out.parent_y = -1;
+				out.value = Pixel;
+				out.propagate = (Pixel != NO_COST && (!vertical || (dim.dstX > inf.start_x && dim.dstX < inf.end_x))) ? 1 : 0;
+			}
+			else {
+				// parent candidates on the previous step: [0] left, [1] right and [2] middle
+				vx_int32 value[3] = { 0x7FFFFFFF, 0x7FFFFFFF, 0x7FFFFFFF }, prop[3] = { 0, 0, 0 };
+				vx_int32 parent_x[3], parent_y[3], parent_ID[3];
+				bool has_parent[3];
+				if (vertical) {
+					vx_int32 base = inf.offset + (dim.dstY - inf.start_y + i - 1) * dim.width + (dim.dstX - inf.start_x);
+					has_parent[0] = (dim.dstX > 0 && dim.dstX > inf.start_x);
+					has_parent[1] = (dim.dstX < (vx_int32)equi_width - 1 && dim.dstX < inf.end_x);
+					has_parent[2] = true;
+					for (vx_int32 j = 0; j < 3; j++) {
+						vx_int32 dx = (j == 0) ? -1 : ((j == 1) ? 1 : 0);
+						parent_x[j] = dim.dstX + dx; parent_y[j] = dim.dstY + i - 1; parent_ID[j] = base + dx;
+						if (has_parent[j] && SEAMFIND_PIXEL(mask_buf, x1 + dx, y1 - 1) && SEAMFIND_PIXEL(mask_buf, x2 + dx, y2 - 1)
+							&& parent_ID[j] >= 0 && (vx_size)parent_ID[j] < num_accum)
+						{
+							value[j] = accum[parent_ID[j]].value;
+							prop[j] = accum[parent_ID[j]].propagate;
+						}
+					}
+				}
+				else {
+					vx_int32 base = inf.offset + (dim.dstX - inf.start_x + i - 1) * dim.height + (dim.dstY - inf.start_y);
+					has_parent[0] = (dim.dstY > 0);
+					has_parent[1] = (dim.dstY < (vx_int32)equi_height - 1);
+					has_parent[2] = true;
+					for (vx_int32 j = 0; j < 3; j++) {
+						vx_int32 dy = (j == 0) ? -1 : ((j == 1) ? 1 : 0);
+						parent_x[j] = dim.dstX + i - 1; parent_y[j] = dim.dstY + dy; parent_ID[j] = base + dy;
+						if (has_parent[j] && SEAMFIND_PIXEL(mask_buf, x1 - 1, y1 + dy) && SEAMFIND_PIXEL(mask_buf, x2 - 1, y2 + dy)
+							&& parent_ID[j] >= 0 && (vx_size)parent_ID[j] < num_accum)
+						{
+							value[j] = accum[parent_ID[j]].value;
+							prop[j] = accum[parent_ID[j]].propagate;
+						}
+					}
+				}
+
+				// add a bonus to the path next to an edge along the seam direction
+				vx_int32 BONUS = 0, WINNER_R = 0, WINNER_L = 0;
+				vx_int32 winner_threshold = (SEAM_QUALITY == 2 && !vertical) ? 200 : 225;
+				vx_int32 edge_threshold = (SEAM_QUALITY == 2) ? 128 : (vertical ? 75 : 64);
+				vx_uint8 phase_along = vertical ? 0 : 2;
+				if (SEAM_QUALITY == 1 || SEAM_QUALITY == 2) {
+					if (magnitude_R > winner_threshold) WINNER_R = 50;
+					if (magnitude_L > winner_threshold) WINNER_L = 50;
+					if (magnitude_R > edge_threshold && (phase_R == phase_along || phase_R == phase_along + 4))
+						BONUS += magnitude_R + WINNER_R;
+					if (magnitude_L > edge_threshold && (phase_L == phase_along || phase_L == phase_along + 4))
+						BONUS += magnitude_L + WINNER_L;
+				}
+
+				// select right, left or middle parent path
+				vx_int32 pick = -1;
+				out.propagate = 0;
+				if (mask && (prop[0] || prop[1] || prop[2])) {
+					vx_int32 valid_child = 0x7FFFFFFF;
+					if (value[1] < valid_child && prop[1]) { valid_child = value[1]; pick = 1; }
+					if (value[0] < valid_child && prop[0]) { valid_child = value[0]; pick = 0; }
+					if (value[2] < valid_child && prop[2]) { pick = 2; }
+					out.propagate = 1;
+				}
+				else {
+					if (value[1] < value[2] && value[1] < value[0]) pick = 1;
+					else if (value[0] < value[1] && value[0] < value[2]) pick = 0;
+					else pick = 2;
+				}
+				if (pick >= 0) {
+					out.parent_x = (vx_int16)parent_x[pick]; out.parent_y = (vx_int16)parent_y[pick];
+					out.value = (pick == 2) ? (value[2] + Pixel) - 2 * BONUS : (value[pick] + Pixel) + 2 * BONUS;
+				}
+				else if (parent_ID[2] >= 0 && (vx_size)parent_ID[2] < num_accum) {
+					// no candidate is below the maximum cost: the OpenCL kernel writes the previous step again
+					out = accum[parent_ID[2]];
+				}
+			}
+			accum[output_ID] = out;
+		}
+	}
+	#undef SEAMFIND_PIXEL
+
+	ERROR_CHECK_STATUS(vxCommitArrayRange((vx_array)parameters[6], 0, num_valid, valid));
+	ERROR_CHECK_STATUS(vxCommitArrayRange((vx_array)parameters[7], 0, num_pref, pref));
+	ERROR_CHECK_STATUS(vxCommitArrayRange((vx_array)parameters[8], 0, num_info, info));
+	ERROR_CHECK_STATUS(vxCommitArrayRange((vx_array)parameters[9], 0, num_accum, accum));
+	for (vx_uint32 i = 0; i < 3; i++) {
+		ERROR_CHECK_STATUS(vxCommitImagePatch((vx_image)parameters[i + 3], &rect, 0, &addr[i], img[i]));
+	}
+	return VX_SUCCESS;
 }
 
 //! \brief The kernel publisher.
@@ -2258,12 +2498,14 @@ vx_status seamfind_cost_accumulate_publish(vx_context context)
 		nullptr,
 		nullptr);
 	ERROR_CHECK_OBJECT(kernel);
+#if ENABLE_OPENCL
 	amd_kernel_query_target_support_f query_target_support_f = seamfind_cost_accumulate_query_target_support;
 	amd_kernel_opencl_codegen_callback_f opencl_codegen_callback_f = seamfind_cost_accumulate_opencl_codegen;
 	amd_kernel_opencl_global_work_update_callback_f opencl_global_work_update_callback_f = seamfind_cost_accumulate_opencl_global_work_update;
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_QUERY_TARGET_SUPPORT, &query_target_support_f, sizeof(query_target_support_f)));
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_OPENCL_CODEGEN_CALLBACK, &opencl_codegen_callback_f, sizeof(opencl_codegen_callback_f)));
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_OPENCL_GLOBAL_WORK_UPDATE_CALLBACK, &opencl_global_work_update_callback_f, sizeof(opencl_global_work_update_callback_f)));
+#endif
 
 	// set kernel parameters
 	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 0, VX_INPUT, VX_TYPE_SCALAR, VX_PARAMETER_STATE_REQUIRED));
@@ -2410,7 +2652,7 @@ static vx_status VX_CALLBACK seamfind_path_trace_query_target_support(vx_graph g
 	if (StitchGetEnvironmentVariable("SEAM_FIND_TARGET", textBuffer, sizeof(textBuffer))) { SEAM_FIND_TARGET = atoi(textBuffer); }
 
 	if (!SEAM_FIND_TARGET)
-		supported_target_affinity = AGO_TARGET_AFFINITY_GPU;
+		supported_target_affinity = AGO_TARGET_AFFINITY_CPU | AGO_TARGET_AFFINITY_GPU;
 	else
 		supported_target_affinity = AGO_TARGET_AFFINITY_CPU;
 
@@ -2847,12 +3089,14 @@ vx_status seamfind_path_trace_publish(vx_context context)
 		nullptr,
 		nullptr);
 	ERROR_CHECK_OBJECT(kernel);
+#if ENABLE_OPENCL
 	amd_kernel_query_target_support_f query_target_support_f = seamfind_path_trace_query_target_support;
 	amd_kernel_opencl_codegen_callback_f opencl_codegen_callback_f = seamfind_path_trace_opencl_codegen;
 	amd_kernel_opencl_global_work_update_callback_f opencl_global_work_update_callback_f = seamfind_path_trace_opencl_global_work_update;
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_QUERY_TARGET_SUPPORT, &query_target_support_f, sizeof(query_target_support_f)));
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_OPENCL_CODEGEN_CALLBACK, &opencl_codegen_callback_f, sizeof(opencl_codegen_callback_f)));
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_OPENCL_GLOBAL_WORK_UPDATE_CALLBACK, &opencl_global_work_update_callback_f, sizeof(opencl_global_work_update_callback_f)));
+#endif
 
 	// set kernel parameters
 	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 0, VX_INPUT, VX_TYPE_SCALAR, VX_PARAMETER_STATE_REQUIRED));
@@ -2988,7 +3232,83 @@ static vx_status VX_CALLBACK seamfind_set_weights_deinitialize(vx_node node, con
 //! \brief The kernel execution.
 static vx_status VX_CALLBACK seamfind_set_weights_kernel(vx_node node, const vx_reference * parameters, vx_uint32 num)
 {
-	return VX_ERROR_NOT_IMPLEMENTED;
+	vx_uint32 current_frame = 0, NumCam = 0, equi_width = 0, equi_height = 0, debugFlags = 0;
+	ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[0], &current_frame));
+	ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[1], &NumCam));
+	ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[2], &equi_width));
+	ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[3], &equi_height));
+	ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[8], &debugFlags));
+	bool DRAW_SEAM = ((debugFlags >> 8) & 1) ? true : false;
+	bool VIEW_SCENE_CHANGE = ((debugFlags >> 9) & 1) ? true : false;
+	bool SHOW_ALL_SEAMS = ((debugFlags >> 10) & 1) ? true : false;
+	if (SHOW_ALL_SEAMS)
+		DRAW_SEAM = true;
+
+	// access the weight entries, seam paths, preferences and the weight image
+	vx_size num_valid = 0, num_path = 0, num_pref = 0;
+	ERROR_CHECK_STATUS(vxQueryArray((vx_array)parameters[4], VX_ARRAY_ATTRIBUTE_NUMITEMS, &num_valid, sizeof(num_valid)));
+	ERROR_CHECK_STATUS(vxQueryArray((vx_array)parameters[5], VX_ARRAY_ATTRIBUTE_NUMITEMS, &num_path, sizeof(num_path)));
+	ERROR_CHECK_STATUS(vxQueryArray((vx_array)parameters[6], VX_ARRAY_ATTRIBUTE_NUMITEMS, &num_pref, sizeof(num_pref)));
+	if (num_valid == 0 || num_path == 0 || num_pref == 0)
+		return VX_SUCCESS;
+	StitchSeamFindWeightEntry * valid = nullptr; StitchSeamFindPathEntry * path = nullptr; StitchSeamFindPreference * pref = nullptr;
+	vx_size stride_valid = sizeof(StitchSeamFindWeightEntry), stride_path = sizeof(StitchSeamFindPathEntry), stride_pref = sizeof(StitchSeamFindPreference);
+	ERROR_CHECK_STATUS(vxAccessArrayRange((vx_array)parameters[4], 0, num_valid, &stride_valid, (void **)&valid, VX_READ_ONLY));
+	ERROR_CHECK_STATUS(vxAccessArrayRange((vx_array)parameters[5], 0, num_path, &stride_path, (void **)&path, VX_READ_ONLY));
+	ERROR_CHECK_STATUS(vxAccessArrayRange((vx_array)parameters[6], 0, num_pref, &stride_pref, (void **)&pref, VX_READ_ONLY));
+	vx_image weight_image = (vx_image)parameters[7];
+	vx_uint32 width = 0, height = 0;
+	ERROR_CHECK_STATUS(vxQueryImage(weight_image, VX_IMAGE_ATTRIBUTE_WIDTH, &width, sizeof(width)));
+	ERROR_CHECK_STATUS(vxQueryImage(weight_image, VX_IMAGE_ATTRIBUTE_HEIGHT, &height, sizeof(height)));
+	vx_rectangle_t rect = { 0, 0, width, height };
+	vx_imagepatch_addressing_t addr;
+	vx_uint8 * weight_buf = nullptr;
+	ERROR_CHECK_STATUS(vxAccessImagePatch(weight_image, &rect, 0, &addr, (void **)&weight_buf, VX_READ_AND_WRITE));
+
+	// on each side of the seam, one camera of the overlap gets the full weight and the other gets zero;
+	// the cameras outside the overlap get zero
+#pragma omp parallel for
+	for (vx_int32 k = 0; k < (vx_int32)num_valid; k++) {
+		const StitchSeamFindWeightEntry& dim = valid[k];
+		if (dim.overlap_id < 0 || (vx_size)dim.overlap_id >= num_pref)
+			continue;
+		const StitchSeamFindPreference& p = pref[dim.overlap_id];
+		vx_int32 period = p.frequency + p.seam_type_num;
+		if (p.priority == -1 || !(p.start_frame == (vx_int32)current_frame || (period != 0 && ((current_frame + 1) % period) == 0)))
+			continue;
+		if (dim.overlap_type != VERTICAL_SEAM && dim.overlap_type != HORIZONTAL_SEAM)
+			continue;
+		vx_uint8 * pix1 = weight_buf + (dim.y + dim.cam_id_1 * equi_height) * addr.stride_y + dim.x;
+		vx_uint8 * pix2 = weight_buf + (dim.y + dim.cam_id_2 * equi_height) * addr.stride_y + dim.x;
+		vx_int32 pos = (dim.overlap_type == VERTICAL_SEAM) ? dim.x : dim.y;
+		vx_size overlap_ID = ((dim.overlap_type == VERTICAL_SEAM) ? dim.y : dim.x) + dim.overlap_id * equi_width;
+		if (overlap_ID >= num_path)
+			continue;
+		const StitchSeamFindPathEntry& seam = path[overlap_ID];
+		if (!SHOW_ALL_SEAMS) {
+			bool start = (pos >= seam.min_pixel);
+			bool first = (seam.weight_value_i == 255) ? start : !start;
+			*pix1 = first ? 255 : 0;
+			*pix2 = first ? 0 : 255;
+			if (VIEW_SCENE_CHANGE && (p.scene_flag == 2 || p.scene_flag == 3)) {
+				*pix1 = *pix2 = (p.scene_flag == 2) ? 50 : 255;
+			}
+			for (vx_int32 cam = 0; cam < (vx_int32)NumCam; cam++) {
+				if (cam != dim.cam_id_1 && cam != dim.cam_id_2)
+					weight_buf[(dim.y + cam * equi_height) * addr.stride_y + dim.x] = 0;
+			}
+		}
+		if (DRAW_SEAM && pos == seam.min_pixel) {
+			// black seam
+			*pix1 = *pix2 = 0;
+		}
+	}
+
+	ERROR_CHECK_STATUS(vxCommitArrayRange((vx_array)parameters[4], 0, num_valid, valid));
+	ERROR_CHECK_STATUS(vxCommitArrayRange((vx_array)parameters[5], 0, num_path, path));
+	ERROR_CHECK_STATUS(vxCommitArrayRange((vx_array)parameters[6], 0, num_pref, pref));
+	ERROR_CHECK_STATUS(vxCommitImagePatch(weight_image, &rect, 0, &addr, weight_buf));
+	return VX_SUCCESS;
 }
 
 //! \brief The kernel target support callback.
@@ -2997,7 +3317,7 @@ static vx_status VX_CALLBACK seamfind_set_weights_query_target_support(vx_graph
 	vx_uint32& supported_target_affinity // [output] must be set to AGO_TARGET_AFFINITY_CPU or AGO_TARGET_AFFINITY_GPU or (AGO_TARGET_AFFINITY_CPU | AGO_TARGET_AFFINITY_GPU)
 	)
 {
-	supported_target_affinity = AGO_TARGET_AFFINITY_GPU;
+	supported_target_affinity = AGO_TARGET_AFFINITY_CPU | AGO_TARGET_AFFINITY_GPU;
 	return VX_SUCCESS;
 }
 
@@ -3380,13 +3700,14 @@ vx_status seamfind_set_weights_publish(vx_context context)
 		seamfind_set_weights_deinitialize);
 	ERROR_CHECK_OBJECT(kernel);
 
+#if ENABLE_OPENCL
 	amd_kernel_query_target_support_f query_target_support_f = seamfind_set_weights_query_target_support;
 	amd_kernel_opencl_codegen_callback_f opencl_codegen_callback_f = seamfind_set_weights_opencl_codegen;
 	amd_kernel_opencl_global_work_update_callback_f opencl_global_work_update_callback_f = seamfind_set_weights_opencl_global_work_update;
-
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_QUERY_TARGET_SUPPORT, &query_target_support_f, sizeof(query_target_support_f)));
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_OPENCL_CODEGEN_CALLBACK, &opencl_codegen_callback_f, sizeof(opencl_codegen_callback_f)));
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_OPENCL_GLOBAL_WORK_UPDATE_CALLBACK, &opencl_global_work_update_callback_f, sizeof(opencl_global_work_update_callback_f)));
+#endif
 	// set kernel parameters
 	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 0, VX_INPUT, VX_TYPE_SCALAR, VX_PARAMETER_STATE_REQUIRED));
 	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 1, VX_INPUT, VX_TYPE_SCALAR, VX_PARAMETER_STATE_REQUIRED));
@@ -219,7 +219,7 @@ static vx_status VX_CALLBACK warp_query_target_support(vx_graph graph, vx_node n
 	vx_uint32& supported_target_affinity // [output] must be set to AGO_TARGET_AFFINITY_CPU or AGO_TARGET_AFFINITY_GPU or (AGO_TARGET_AFFINITY_CPU | AGO_TARGET_AFFINITY_GPU)
 	)
 {
-	supported_target_affinity = AGO_TARGET_AFFINITY_GPU;
+	supported_target_affinity = AGO_TARGET_AFFINITY_CPU | AGO_TARGET_AFFINITY_GPU;
 	return VX_SUCCESS;
 }
 
@@ -1896,10 +1896,152 @@ static vx_status VX_CALLBACK warp_opencl_codegen(
 	return VX_SUCCESS;
 }
 
+//! \brief Bilinear sample of an RGB/RGBX camera image at a Q13.3 source location (CPU path).
+static inline __m128 warp_sample_bilinear(const vx_uint8 * buf, vx_uint32 stride, vx_uint32 bpp, vx_uint32 width, vx_uint32 height, vx_uint32 sx, vx_uint32 sy)
+{
+	vx_uint32 x0 = std::min(sx >> 3, width - 1), y0 = std::min(sy >> 3, height - 1);
+	vx_uint32 x1 = std::min(x0 + 1, width - 1), y1 = std::min(y0 + 1, height - 1);
+	const vx_uint8 * r0 = buf + y0 * stride, * r1 = buf + y1 * stride;
+	__m128 p00 = (bpp == 4) ? StitchLoadRGBX(r0 + x0 * 4) : StitchLoadRGB(r0 + x0 * 3);
+	__m128 p01 = (bpp == 4) ? StitchLoadRGBX(r0 + x1 * 4) : StitchLoadRGB(r0 + x1 * 3);
+	__m128 p10 = (bpp == 4) ? StitchLoadRGBX(r1 + x0 * 4) : StitchLoadRGB(r1 + x0 * 3);
+	__m128 p11 = (bpp == 4) ? StitchLoadRGBX(r1 + x1 * 4) : StitchLoadRGB(r1 + x1 * 3);
+	__m128 fx = _mm_set1_ps((sx & 7) * 0.125f), fy = _mm_set1_ps((sy & 7) * 0.125f);
+	__m128 fx1 = _mm_sub_ps(_mm_set1_ps(1.0f), fx), fy1 = _mm_sub_ps(_mm_set1_ps(1.0f), fy);
+	__m128 t0 = _mm_add_ps(_mm_mul_ps(p00, fx1), _mm_mul_ps(p01, fx));
+	__m128 t1 = _mm_add_ps(_mm_mul_ps(p10, fx1), _mm_mul_ps(p11, fx));
+	return _mm_add_ps(_mm_mul_ps(t0, fy1), _mm_mul_ps(t1, fy));
+}
+
+//! \brief Bicubic coefficients of the 4 taps for a fractional offset x, same as compute_bicubic_coeffs() in the OpenCL code.
+static inline void warp_bicubic_coeffs(float x, float mf[4])
+{
+	mf[0] = -0.5f*x + x*x - 0.5f*x*x*x;
+	mf[1] = 1.0f - 2.5f*x*x + 1.5f*x*x*x;
+	mf[2] = 0.5f*x + 2.0f*x*x - 1.5f*x*x*x;
+	mf[3] = 0.5f*(-x*x + x*x*x);
+}
+
+//! \brief Bicubic sample of an RGB/RGBX camera image at a Q13.3 source location (CPU path).
+static inline __m128 warp_sample_bicubic(const vx_uint8 * buf, vx_uint32 stride, vx_uint32 bpp, vx_uint32 width, vx_uint32 height, vx_uint32 sx, vx_uint32 sy)
+{
+	float mx[4], my[4];
+	warp_bicubic_coeffs((sx & 7) * 0.125f, mx);
+	warp_bicubic_coeffs((sy & 7) * 0.125f, my);
+	vx_int32 xs = (vx_int32)(sx >> 3) - 1, ys = (vx_int32)(sy >> 3) - 1;
+	__m128 f = _mm_setzero_ps();
+	for (vx_int32 j = 0; j < 4; j++) {
+		const vx_uint8 * row = buf + std::min(std::max(ys + j, 0), (vx_int32)height - 1) * stride;
+		__m128 r = _mm_setzero_ps();
+		for (vx_int32 i = 0; i < 4; i++) {
+			vx_uint32 x = (vx_uint32)std::min(std::max(xs + i, 0), (vx_int32)width - 1);
+			__m128 p = (bpp == 4) ? StitchLoadRGBX(row + x * 4) : StitchLoadRGB(row + x * 3);
+			r = _mm_add_ps(r, _mm_mul_ps(p, _mm_set1_ps(mx[i])));
+		}
+		f = _mm_add_ps(f, _mm_mul_ps(r, _mm_set1_ps(my[j])));
+	}
+	return f;
+}
+
 //! \brief The kernel execution.
 static vx_status VX_CALLBACK warp_kernel(vx_node node, const vx_reference * parameters, vx_uint32 num)
 {
-	return VX_ERROR_NOT_SUPPORTED;
+	vx_enum grayscale_compute_method = STITCH_GRAY_SCALE_COMPUTE_METHOD_AVG;
+	vx_uint32 num_cameras = 0, num_camera_columns = 1;
+	vx_uint8 alpha_value = 0, flags = 0;
+	ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[0], &grayscale_compute_method));
+	ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[1], &num_cameras));
+	if (parameters[7]) ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[7], &num_camera_columns));
+	if (parameters[8]) ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[8], &alpha_value));
+	if (num > 9 && parameters[9]) ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[9], &flags));
+	bool useBilinearInterpolation = (flags & 1) ? false : true;
+	bool useAlphaValue = parameters[8] ? true : false;
+
+	// access the valid pixel and warp remap tables
+	vx_array valid_arr = (vx_array)parameters[2], remap_arr = (vx_array)parameters[3];
+	vx_size arr_numitems = 0;
+	ERROR_CHECK_STATUS(vxQueryArray(valid_arr, VX_ARRAY_ATTRIBUTE_NUMITEMS, &arr_numitems, sizeof(arr_numitems)));
+	if (arr_numitems == 0 || num_cameras == 0 || num_camera_columns == 0)
+		return VX_SUCCESS;
+	vx_uint8 * valid_ptr = nullptr, * remap_ptr = nullptr;
+	vx_size valid_stride = sizeof(StitchValidPixelEntry), remap_stride = sizeof(StitchWarpRemapEntry);
+	ERROR_CHECK_STATUS(vxAccessArrayRange(valid_arr, 0, arr_numitems, &valid_stride, (void **)&valid_ptr, VX_READ_ONLY));
+	ERROR_CHECK_STATUS(vxAccessArrayRange(remap_arr, 0, arr_numitems, &remap_stride, (void **)&remap_ptr, VX_READ_ONLY));
+
+	// access the camera and the equirectangular images
+	vx_image input_image = (vx_image)parameters[4], output_image = (vx_image)parameters[5], luma_image = (vx_image)parameters[6];
+	vx_uint32 input_width = 0, input_height = 0, output_width = 0, output_height = 0, luma_width = 0, luma_height = 0;
+	vx_df_image input_format = VX_DF_IMAGE_VIRT, output_format = VX_DF_IMAGE_VIRT;
+	ERROR_CHECK_STATUS(vxQueryImage(input_image, VX_IMAGE_ATTRIBUTE_WIDTH, &input_width, sizeof(input_width)));
+	ERROR_CHECK_STATUS(vxQueryImage(input_image, VX_IMAGE_ATTRIBUTE_HEIGHT, &input_height, sizeof(input_height)));
+	ERROR_CHECK_STATUS(vxQueryImage(input_image, VX_IMAGE_ATTRIBUTE_FORMAT, &input_format, sizeof(input_format)));
+	ERROR_CHECK_STATUS(vxQueryImage(output_image, VX_IMAGE_ATTRIBUTE_WIDTH, &output_width, sizeof(output_width)));
+	ERROR_CHECK_STATUS(vxQueryImage(output_image, VX_IMAGE_ATTRIBUTE_HEIGHT, &output_height, sizeof(output_height)));
+	ERROR_CHECK_STATUS(vxQueryImage(output_image, VX_IMAGE_ATTRIBUTE_FORMAT, &output_format, sizeof(output_format)));
+	vx_rectangle_t input_rect = { 0, 0, input_width, input_height }, output_rect = { 0, 0, output_width, output_height }, luma_rect = { 0, 0, 0, 0 };
+	vx_imagepatch_addressing_t input_addr, output_addr, luma_addr;
+	vx_uint8 * input_ptr = nullptr, * output_ptr = nullptr, * luma_ptr = nullptr;
+	ERROR_CHECK_STATUS(vxAccessImagePatch(input_image, &input_rect, 0, &input_addr, (void **)&input_ptr, VX_READ_ONLY));
+	ERROR_CHECK_STATUS(vxAccessImagePatch(output_image, &output_rect, 0, &output_addr, (void **)&output_ptr, VX_READ_AND_WRITE));
+	if (luma_image) {
+		ERROR_CHECK_STATUS(vxQueryImage(luma_image, VX_IMAGE_ATTRIBUTE_WIDTH, &luma_width, sizeof(luma_width)));
+		ERROR_CHECK_STATUS(vxQueryImage(luma_image, VX_IMAGE_ATTRIBUTE_HEIGHT, &luma_height, sizeof(luma_height)));
+		luma_rect.end_x = luma_width; luma_rect.end_y = luma_height;
+		ERROR_CHECK_STATUS(vxAccessImagePatch(luma_image, &luma_rect, 0, &luma_addr, (void **)&luma_ptr, VX_READ_AND_WRITE));
+	}
+
+	// each valid pixel entry covers 8 consecutive output pixels
+	vx_uint32 ip_bpp = (input_format == VX_DF_IMAGE_RGBX) ? 4 : 3, op_bpp = (output_format == VX_DF_IMAGE_RGBX) ? 4 : 3;
+	vx_uint32 ip_image_height_offs = input_height / (num_cameras / num_camera_columns);
+	vx_uint32 op_image_height_offs = output_height / num_cameras;
+	const float RGBToY[3] = { 0.2126f, 0.7152f, 0.0722f };
+#pragma omp parallel for
+	for (vx_int32 i = 0; i < (vx_int32)arr_numitems; i++) {
+		vx_uint32 pixelEntry = *(const vx_uint32 *)(valid_ptr + i * valid_stride);
+		if (pixelEntry == 0xffffffff)
+			continue;
+		const vx_uint16 * map = (const vx_uint16 *)(remap_ptr + i * remap_stride);
+		vx_uint32 camera_id = pixelEntry & 0x1f, op_x = ((pixelEntry >> 8) & 0x7ff) << 3, op_y = (pixelEntry >> 19) & 0x1fff;
+		const vx_uint8 * ip_buf = input_ptr + (camera_id / num_camera_columns) * ip_image_height_offs * input_addr.stride_y;
+		vx_uint8 * op_buf = output_ptr + (camera_id * op_image_height_offs + op_y) * output_addr.stride_y + op_x * op_bpp;
+		vx_uint8 * op_u8_buf = luma_ptr ? luma_ptr + (camera_id * op_image_height_offs + op_y) * luma_addr.stride_y + op_x : nullptr;
+		for (vx_uint32 k = 0; k < 8; k++) {
+			vx_uint32 sx = map[2 * k], sy = map[2 * k + 1];
+			float f[4] = { 0.0f, 0.0f, 0.0f, 128.0f }, Y = 0.0f;
+			if (!(sx == 0xffff && sy == 0xffff)) {
+				__m128 pix = useBilinearInterpolation ?
+					warp_sample_bilinear(ip_buf, input_addr.stride_y, ip_bpp, input_width, ip_image_height_offs, sx, sy) :
+					warp_sample_bicubic(ip_buf, input_addr.stride_y, ip_bpp, input_width, ip_image_height_offs, sx, sy);
+				_mm_storeu_ps(f, pix);
+				if (ip_bpp == 3) {
+					if (useAlphaValue)
+						f[3] = (float)alpha_value;
+					else if (grayscale_compute_method == STITCH_GRAY_SCALE_COMPUTE_METHOD_AVG)
+						f[3] = (f[0] + f[1] + f[2]) * 0.3333333333f;
+					else
+						f[3] = sqrtf((f[0] * f[0] + f[1] * f[1] + f[2] * f[2]) * 0.3333333333f);
+				}
+#if WRITE_LUMA_AS_A
+				Y = f[0] * RGBToY[0] + f[1] * RGBToY[1] + f[2] * RGBToY[2];
+#else
+				Y = f[3];
+#endif
+			}
+			if (op_bpp == 4)
+				*(vx_uint32 *)(op_buf + k * 4) = StitchPackRGBX(_mm_loadu_ps(f));
+			else
+				StitchStoreRGB(op_buf + k * 3, _mm_loadu_ps(f));
+			if (op_u8_buf)
+				op_u8_buf[k] = StitchPackU8(Y);
+		}
+	}
+
+	if (luma_image) ERROR_CHECK_STATUS(vxCommitImagePatch(luma_image, &luma_rect, 0, &luma_addr, luma_ptr));
+	ERROR_CHECK_STATUS(vxCommitImagePatch(output_image, &output_rect, 0, &output_addr, output_ptr));
+	ERROR_CHECK_STATUS(vxCommitImagePatch(input_image, &input_rect, 0, &input_addr, input_ptr));
+	ERROR_CHECK_STATUS(vxCommitArrayRange(remap_arr, 0, arr_numitems, remap_ptr));
+	ERROR_CHECK_STATUS(vxCommitArrayRange(valid_arr, 0, arr_numitems, valid_ptr));
+	return VX_SUCCESS;
 }
 
 //! \brief The kernel publisher.
@@ -1915,12 +2057,14 @@ vx_status warp_publish(vx_context context)
 		nullptr,
 		nullptr);
 	ERROR_CHECK_OBJECT(kernel);
+#if ENABLE_OPENCL
 	amd_kernel_query_target_support_f query_target_support_f = warp_query_target_support;
 	amd_kernel_opencl_codegen_callback_f opencl_codegen_callback_f = warp_opencl_codegen;
 	amd_kernel_opencl_global_work_update_callback_f opencl_global_work_update_callback_f = warp_opencl_global_work_update;
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_QUERY_TARGET_SUPPORT, &query_target_support_f, sizeof(query_target_support_f)));
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_OPENCL_CODEGEN_CALLBACK, &opencl_codegen_callback_f, sizeof(opencl_codegen_callback_f)));
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_OPENCL_GLOBAL_WORK_UPDATE_CALLBACK, &opencl_global_work_update_callback_f, sizeof(opencl_global_work_update_callback_f)));
+#endif
 
 	// set kernel parameters
 	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 0, VX_INPUT, VX_TYPE_SCALAR, VX_PARAMETER_STATE_REQUIRED));
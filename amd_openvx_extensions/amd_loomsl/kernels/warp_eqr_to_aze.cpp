@@ -136,7 +136,7 @@ static vx_status VX_CALLBACK warp_eqr_to_aze_query_target_support(vx_graph graph
 	vx_uint32& supported_target_affinity // [output] must be set to AGO_TARGET_AFFINITY_CPU or AGO_TARGET_AFFINITY_GPU or (AGO_TARGET_AFFINITY_CPU | AGO_TARGET_AFFINITY_GPU)
 	)
 {
-	supported_target_affinity = AGO_TARGET_AFFINITY_GPU;
+	supported_target_affinity = AGO_TARGET_AFFINITY_CPU | AGO_TARGET_AFFINITY_GPU;
 	return VX_SUCCESS;
 }
 
@@ -554,7 +554,97 @@ static vx_status VX_CALLBACK warp_eqr_to_aze_opencl_codegen(
 //! \brief The kernel execution.
 static vx_status VX_CALLBACK warp_eqr_to_aze_kernel(vx_node node, const vx_reference * parameters, vx_uint32 num)
 {
-	return VX_ERROR_NOT_SUPPORTED;
+	// get source and destination image configurations
+	vx_image src_image = (vx_image)parameters[0], dst_image = (vx_image)parameters[2];
+	vx_uint32 src_width = 0, src_height = 0, dst_width = 0, dst_height = 0;
+	vx_df_image dst_format = VX_DF_IMAGE_VIRT;
+	ERROR_CHECK_STATUS(vxQueryImage(src_image, VX_IMAGE_WIDTH, &src_width, sizeof(src_width)));
+	ERROR_CHECK_STATUS(vxQueryImage(src_image, VX_IMAGE_HEIGHT, &src_height, sizeof(src_height)));
+	ERROR_CHECK_STATUS(vxQueryImage(dst_image, VX_IMAGE_WIDTH, &dst_width, sizeof(dst_width)));
+	ERROR_CHECK_STATUS(vxQueryImage(dst_image, VX_IMAGE_HEIGHT, &dst_height, sizeof(dst_height)));
+	ERROR_CHECK_STATUS(vxQueryImage(dst_image, VX_IMAGE_FORMAT, &dst_format, sizeof(dst_format)));
+	vx_float32 a = 0.0f, b = 1.0f;
+	vx_uint8 flags = 0;
+	if (parameters[3]) {
+		ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[3], &a));
+	}
+	if (parameters[4]) {
+		ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[4], &b));
+	}
+	if (parameters[5]) {
+		ERROR_CHECK_STATUS(vxReadScalarValue((vx_scalar)parameters[5], &flags));
+	}
+	bool useBilinearInterpolation = (flags & 1) ? true : false;
+	vx_array rad2lat_map_arr = (vx_array)parameters[1];
+	vx_size arr_capacity = 0, arr_numitems = 0;
+	ERROR_CHECK_STATUS(vxQueryArray(rad2lat_map_arr, VX_ARRAY_ATTRIBUTE_CAPACITY, &arr_capacity, sizeof(arr_capacity)));
+	ERROR_CHECK_STATUS(vxQueryArray(rad2lat_map_arr, VX_ARRAY_ATTRIBUTE_NUMITEMS, &arr_numitems, sizeof(arr_numitems)));
+	if (arr_numitems < 1)
+		return VX_ERROR_INVALID_PARAMETERS;
+	vx_float32 * map = nullptr;
+	vx_size stride = sizeof(vx_float32);
+	ERROR_CHECK_STATUS(vxAccessArrayRange(rad2lat_map_arr, 0, arr_numitems, &stride, (void **)&map, VX_READ_ONLY));
+	vx_rectangle_t src_rect = { 0, 0, src_width, src_height }, dst_rect = { 0, 0, dst_width, dst_height };
+	vx_imagepatch_addressing_t src_addr, dst_addr;
+	vx_uint8 * src_ptr = nullptr, * dst_ptr = nullptr;
+	ERROR_CHECK_STATUS(vxAccessImagePatch(src_image, &src_rect, 0, &src_addr, (void **)&src_ptr, VX_READ_ONLY));
+	ERROR_CHECK_STATUS(vxAccessImagePatch(dst_image, &dst_rect, 0, &dst_addr, (void **)&dst_ptr, VX_WRITE_ONLY));
+
+	// remap each destination pixel from its polar coordinates: the radius indexes the latitude map and the angle
+	// gives the longitude; pixels outside the unit circle take the source pixel at (0,0) like the OpenCL kernel
+	const float dr = std::min((float)dst_width, (float)dst_height) / 2.0f;
+	const float sy_mul = (float)src_height / 180.0f, sx_mul = (float)src_width / (float)(M_PI * 2.0);
+	const vx_int32 xmax = (vx_int32)src_width - 1, ymax = (vx_int32)src_height - 1;
+	const vx_uint32 dst_pixel_size = (dst_format == VX_DF_IMAGE_RGBX) ? 4 : 3;
+#pragma omp parallel for
+	for (vx_int32 gy = 0; gy < (vx_int32)dst_height; gy++) {
+		vx_uint8 * dst = dst_ptr + gy * dst_addr.stride_y;
+		float dy = (float)gy - (float)dst_height / 2.0f;
+		for (vx_uint32 gx = 0; gx < dst_width; gx++, dst += dst_pixel_size) {
+			float dx = (float)gx - (float)dst_width / 2.0f;
+			float theta = atan2f(dy, dx) * b;
+			float radius = sqrtf(dx * dx + dy * dy) / dr;
+			vx_size idx = std::min((vx_size)(radius * (float)arr_capacity), arr_numitems - 1);
+			bool isValidRemap = (radius <= 1.0f);
+			float sy = isValidRemap ? (90.0f - map[idx]) * sy_mul : 0.0f;
+			float sx = isValidRemap ? ((float)M_PI - theta - a) * sx_mul : 0.0f;
+			float f[3] = { 0.0f, 0.0f, 0.0f };
+			if (useBilinearInterpolation) {
+				vx_int32 x0 = (vx_int32)sx, y0 = (vx_int32)sy;
+				float fx = sx - (float)x0, fy = sy - (float)y0;
+				vx_int32 xs[2] = { std::max(0, std::min(x0, xmax)), std::max(0, std::min(x0 + 1, xmax)) };
+				vx_int32 ys[2] = { std::max(0, std::min(y0, ymax)), std::max(0, std::min(y0 + 1, ymax)) };
+				for (vx_uint32 c = 0; c < 3; c++) {
+					float top = src_ptr[ys[0] * src_addr.stride_y + xs[0] * 3 + c] * (1.0f - fx) + src_ptr[ys[0] * src_addr.stride_y + xs[1] * 3 + c] * fx;
+					float bot = src_ptr[ys[1] * src_addr.stride_y + xs[0] * 3 + c] * (1.0f - fx) + src_ptr[ys[1] * src_addr.stride_y + xs[1] * 3 + c] * fx;
+					f[c] = top * (1.0f - fy) + bot * fy;
+				}
+			}
+			else {
+				// bicubic (Catmull-Rom) over the 4x4 neighborhood
+				float x = sx - floorf(sx), y = sy - floorf(sy);
+				float mx[4] = { -0.5f*x + x*x - 0.5f*x*x*x, 1.0f - 2.5f*x*x + 1.5f*x*x*x, 0.5f*x + 2.0f*x*x - 1.5f*x*x*x, 0.5f*(-x*x + x*x*x) };
+				float my[4] = { -0.5f*y + y*y - 0.5f*y*y*y, 1.0f - 2.5f*y*y + 1.5f*y*y*y, 0.5f*y + 2.0f*y*y - 1.5f*y*y*y, 0.5f*(-y*y + y*y*y) };
+				vx_int32 x0 = (vx_int32)(sx - 1.0f), y0 = (vx_int32)(sy - 1.0f);
+				for (vx_int32 j = 0; j < 4; j++) {
+					const vx_uint8 * row = src_ptr + std::max(0, std::min(y0 + j, ymax)) * src_addr.stride_y;
+					for (vx_int32 i = 0; i < 4; i++) {
+						const vx_uint8 * pix = row + std::max(0, std::min(x0 + i, xmax)) * 3;
+						float w = mx[i] * my[j];
+						f[0] += pix[0] * w; f[1] += pix[1] * w; f[2] += pix[2] * w;
+					}
+				}
+			}
+			dst[0] = StitchPackU8(f[0]); dst[1] = StitchPackU8(f[1]); dst[2] = StitchPackU8(f[2]);
+			if (dst_pixel_size == 4)
+				dst[3] = 255;
+		}
+	}
+
+	ERROR_CHECK_STATUS(vxCommitArrayRange(rad2lat_map_arr, 0, arr_numitems, map));
+	ERROR_CHECK_STATUS(vxCommitImagePatch(src_image, &src_rect, 0, &src_addr, src_ptr));
+	ERROR_CHECK_STATUS(vxCommitImagePatch(dst_image, &dst_rect, 0, &dst_addr, dst_ptr));
+	return VX_SUCCESS;
 }
 
 //! \brief The kernel publisher.
@@ -570,10 +660,12 @@ vx_status warp_eqr_to_aze_publish(vx_context context)
 		nullptr,
 		nullptr);
 	ERROR_CHECK_OBJECT(kernel);
+#if ENABLE_OPENCL
 	amd_kernel_query_target_support_f query_target_support_f = warp_eqr_to_aze_query_target_support;
 	amd_kernel_opencl_codegen_callback_f opencl_codegen_callback_f = warp_eqr_to_aze_opencl_codegen;
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_QUERY_TARGET_SUPPORT, &query_target_support_f, sizeof(query_target_support_f)));
 	ERROR_CHECK_STATUS(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_OPENCL_CODEGEN_CALLBACK, &opencl_codegen_callback_f, sizeof(opencl_codegen_callback_f)));
+#endif
 
 	// set kernel parameters
 	ERROR_CHECK_STATUS(vxAddParameterToKernel(kernel, 0, VX_INPUT, VX_TYPE_IMAGE, VX_PARAMETER_STATE_REQUIRED));
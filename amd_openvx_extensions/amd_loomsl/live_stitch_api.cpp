@@ -110,6 +110,7 @@ struct ls_context_t {
 	vx_uint32   output_rgb_buffer_width;        // camera buffer width after color conversion
 	vx_uint32   output_rgb_buffer_height;       // camera buffer height after color conversion
 	cl_context  opencl_context;                 // OpenCL context for DGMA interop
+	vx_enum     buffer_memory_type;             // memory type of camera/overlay/output buffers (VX_MEMORY_TYPE_OPENCL/HOST)
 	vx_uint32   camera_buffer_stride_in_bytes;  // stride of each row in input opencl buffer
 	vx_uint32   overlay_buffer_stride_in_bytes; // stride of each row in overlay opencl buffer (optional)
 	vx_uint32   output_buffer_stride_in_bytes;  // stride of each row in output opencl buffer
@@ -389,7 +390,8 @@ static vx_status DumpReference(vx_reference ref, const char * fileName)
 
 static vx_image CreateAlignedImage(ls_context stitch, vx_uint32 width, vx_uint32 height, vx_uint32 alignpixels, vx_df_image format, vx_enum mem_type)
 {
-	if (mem_type == VX_MEMORY_TYPE_OPENCL){
+#if ENABLE_OPENCL
+	if (mem_type == VX_MEMORY_TYPE_OPENCL && stitch->buffer_memory_type == VX_MEMORY_TYPE_OPENCL){
 		cl_context opencl_context = nullptr;
 		vx_imagepatch_addressing_t addr_in = { 0 };
 		void *ptr[1] = { nullptr };
@@ -417,10 +419,8 @@ static vx_image CreateAlignedImage(ls_context stitch, vx_uint32 width, vx_uint32
 		ptr[0] = clImg;
 		return vxCreateImageFromHandle(stitch->context, format, &addr_in, ptr, mem_type);
 	}
-	else
-	{
-		return vxCreateImage(stitch->context, width, height, format);
-	}
+#endif
+	return vxCreateImage(stitch->context, width, height, format);
 }
 
 //! \brief Function to set default values to global attributes
@@ -477,6 +477,7 @@ static void ResetLiveStitchGlobalAttributes()
 		g_live_stitch_attr[LIVE_STITCH_ATTR_NOISE_FILTER] = 0;
 		g_live_stitch_attr[LIVE_STITCH_ATTR_NOISE_FILTER_LAMBDA] = 1;
 		g_live_stitch_attr[LIVE_STITCH_ATTR_SAVE_AND_LOAD_INIT] = 0;
+		g_live_stitch_attr[LIVE_STITCH_ATTR_USE_CPU_FOR_STITCH] = 0;
 	}
 }
 static std::vector<std::string> split(std::string str, char delimiter) {
@@ -649,6 +650,7 @@ static vx_status SyncInternalTables(ls_context stitch)
 		(vx_reference)stitch->overlay_remap,
 		(vx_reference)stitch->camera_remap,
 	};
+#if ENABLE_OPENCL
 	for (vx_size i = 0; i < dimof(refList); i++) {
 		if (refList[i]) {
 			vx_status status = vxDirective(refList[i], VX_DIRECTIVE_AMD_COPY_TO_OPENCL);
@@ -658,6 +660,7 @@ static vx_status SyncInternalTables(ls_context stitch)
 			}
 		}
 	}
+#endif
 	return VX_SUCCESS;
 }
 static vx_status quickSetupFilesLookup(ls_context stitch)
@@ -2202,6 +2205,18 @@ LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsInitialize(ls_context stitch)
 	if (stitch->live_stitch_attr[LIVE_STITCH_ATTR_PROFILER] == 2.0f) {
 		ERROR_CHECK_STATUS_(vxDirective((vx_reference)stitch->graphStitch, VX_DIRECTIVE_AMD_ENABLE_PROFILE_CAPTURE));
 	}
+	// the CPU stitch and builds without OpenCL take host buffers from the application
+	stitch->buffer_memory_type = VX_MEMORY_TYPE_HOST;
+#if ENABLE_OPENCL
+	if (!stitch->live_stitch_attr[LIVE_STITCH_ATTR_USE_CPU_FOR_STITCH])
+		stitch->buffer_memory_type = VX_MEMORY_TYPE_OPENCL;
+#endif
+	if (stitch->buffer_memory_type == VX_MEMORY_TYPE_HOST) {
+		// nodes pick up the graph affinity; kernels without a CPU implementation stay on the GPU
+		AgoTargetAffinityInfo affinity = { 0 };
+		affinity.device_type = AGO_TARGET_AFFINITY_CPU;
+		ERROR_CHECK_STATUS_(vxSetGraphAttribute(stitch->graphStitch, VX_GRAPH_ATTRIBUTE_AMD_AFFINITY, &affinity, sizeof(affinity)));
+	}
 
 	// creating OpenVX image objects for input & output OpenCL buffers
 	if (strlen(stitch->loomio_camera.kernelName) > 0) {
@@ -2243,7 +2258,7 @@ LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsInitialize(ls_context stitch)
 				addr_in[2].dim_x = stitch->camera_buffer_width;	addr_in[2].dim_y = stitch->camera_buffer_height;
 				addr_in[2].stride_x = 1; addr_in[2].stride_y = stitch->camera_buffer_stride_in_bytes;
 			}
-			ERROR_CHECK_OBJECT_(stitch->Img_input = vxCreateImageFromHandle(stitch->context, stitch->camera_buffer_format, &addr_in[0], ptr, VX_MEMORY_TYPE_OPENCL));
+			ERROR_CHECK_OBJECT_(stitch->Img_input = vxCreateImageFromHandle(stitch->context, stitch->camera_buffer_format, &addr_in[0], ptr, stitch->buffer_memory_type));
 		}
 		else{
 			vx_imagepatch_addressing_t addr_in = { 0 };
@@ -2253,7 +2268,7 @@ LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsInitialize(ls_context stitch)
 			addr_in.stride_x = (stitch->camera_buffer_format == VX_DF_IMAGE_RGB) ? 3 : 2;
 			addr_in.stride_y = stitch->camera_buffer_stride_in_bytes;
 			if (addr_in.stride_y == 0) addr_in.stride_y = addr_in.stride_x * addr_in.dim_x;
-			ERROR_CHECK_OBJECT_(stitch->Img_input = vxCreateImageFromHandle(stitch->context, stitch->camera_buffer_format, &addr_in, ptr, VX_MEMORY_TYPE_OPENCL));
+			ERROR_CHECK_OBJECT_(stitch->Img_input = vxCreateImageFromHandle(stitch->context, stitch->camera_buffer_format, &addr_in, ptr, stitch->buffer_memory_type));
 		}
 	}
 	// check attribute for fast init code
@@ -2291,7 +2306,7 @@ LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsInitialize(ls_context stitch)
 			addr_overlay.stride_x = 4;
 			addr_overlay.stride_y = stitch->overlay_buffer_stride_in_bytes;
 			if (addr_overlay.stride_y == 0) addr_overlay.stride_y = addr_overlay.stride_x * addr_overlay.dim_x;
-			ERROR_CHECK_OBJECT_(stitch->Img_overlay = vxCreateImageFromHandle(stitch->context, VX_DF_IMAGE_RGBX, &addr_overlay, ptr_overlay, VX_MEMORY_TYPE_OPENCL));
+			ERROR_CHECK_OBJECT_(stitch->Img_overlay = vxCreateImageFromHandle(stitch->context, VX_DF_IMAGE_RGBX, &addr_overlay, ptr_overlay, stitch->buffer_memory_type));
 		}
 		// create remap table object and image for overlay warp
 		ERROR_CHECK_OBJECT_(stitch->overlay_remap = vxCreateRemap(stitch->context, stitch->overlay_buffer_width, stitch->overlay_buffer_height, stitch->output_rgb_buffer_width, stitch->output_rgb_buffer_height));
@@ -2393,7 +2408,7 @@ LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsInitialize(ls_context stitch)
 				}
 
 				for (vx_uint32 i = 0; i < stitch->output_encode_tiles; i++){
-					ERROR_CHECK_OBJECT_(stitch->encodetileOutput[i] = vxCreateImageFromHandle(stitch->context, stitch->output_buffer_format, &addr_out[0], ptr, VX_MEMORY_TYPE_OPENCL));
+					ERROR_CHECK_OBJECT_(stitch->encodetileOutput[i] = vxCreateImageFromHandle(stitch->context, stitch->output_buffer_format, &addr_out[0], ptr, stitch->buffer_memory_type));
 				}
 			}
 			else{
@@ -2410,7 +2425,7 @@ LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsInitialize(ls_context stitch)
 					addr_out[2].dim_x = stitch->output_rgb_buffer_width;	addr_out[2].dim_y = stitch->output_rgb_buffer_height;
 					addr_out[2].stride_x = 1; addr_out[2].stride_y = stitch->output_buffer_stride_in_bytes;
 				}
-				ERROR_CHECK_OBJECT_(stitch->Img_output = vxCreateImageFromHandle(stitch->context, stitch->output_buffer_format, &addr_out[0], ptr, VX_MEMORY_TYPE_OPENCL));
+				ERROR_CHECK_OBJECT_(stitch->Img_output = vxCreateImageFromHandle(stitch->context, stitch->output_buffer_format, &addr_out[0], ptr, stitch->buffer_memory_type));
 			}			
 		}
 		else{
@@ -2422,7 +2437,7 @@ LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsInitialize(ls_context stitch)
 			addr_out.stride_x = (stitch->output_buffer_format == VX_DF_IMAGE_RGB) ? 3 : 2;
 			addr_out.stride_y = stitch->output_buffer_stride_in_bytes;
 			if (addr_out.stride_y == 0) addr_out.stride_y = addr_out.stride_x * addr_out.dim_x;
-			ERROR_CHECK_OBJECT_(stitch->Img_output = vxCreateImageFromHandle(stitch->context, stitch->output_buffer_format, &addr_out, ptr, VX_MEMORY_TYPE_OPENCL));
+			ERROR_CHECK_OBJECT_(stitch->Img_output = vxCreateImageFromHandle(stitch->context, stitch->output_buffer_format, &addr_out, ptr, stitch->buffer_memory_type));
 		}
 	}
 	if (stitch->output_encode_tiles > 4){ ls_printf("ERROR: lsInitialize: Max Encode Tiles supported is 4\n"); return VX_ERROR_INVALID_PARAMETERS;}
@@ -2446,7 +2461,7 @@ LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsInitialize(ls_context stitch)
 		addr_out.stride_x = 3;
 		addr_out.stride_y = stitch->output_buffer_width * 3;
 		if (addr_out.stride_y == 0) addr_out.stride_y = addr_out.stride_x * addr_out.dim_x;
-		ERROR_CHECK_OBJECT_(stitch->chroma_key_input_img = vxCreateImageFromHandle(stitch->context, VX_DF_IMAGE_RGB, &addr_out, ptr, VX_MEMORY_TYPE_OPENCL));
+		ERROR_CHECK_OBJECT_(stitch->chroma_key_input_img = vxCreateImageFromHandle(stitch->context, VX_DF_IMAGE_RGB, &addr_out, ptr, stitch->buffer_memory_type));
 		// create chroma key mask U8 buffer
 		vx_uint32 output_img_width = stitch->output_buffer_width;
 		vx_uint32 output_img_height = stitch->output_buffer_height;
@@ -3146,7 +3161,9 @@ LIVE_STITCH_API_ENTRY vx_status VX_API_CALL lsScheduleFrame(ls_context stitch)
 	// exposure comp expects A_matrix to be initialized to ZERO on GPU
 	if ((stitch->EXPO_COMP <= 2) && stitch->A_matrix) {
 		ERROR_CHECK_STATUS_(vxWriteMatrix(stitch->A_matrix, stitch->A_matrix_initial_value));
+#if ENABLE_OPENCL
 		ERROR_CHECK_STATUS_(vxDirective((vx_reference)stitch->A_matrix, VX_DIRECTIVE_AMD_COPY_TO_OPENCL));
+#endif
 	}
 
 	// age delay element if temporal noise filter activated
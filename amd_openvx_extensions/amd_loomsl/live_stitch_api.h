@@ -28,11 +28,17 @@ THE SOFTWARE.
 // standard header files
 #ifndef VX_NOT_AVAILABLE
 #include <VX/vx.h>
+#if !defined(ENABLE_OPENCL) || ENABLE_OPENCL
 #if __APPLE__
 #include <opencl.h>
 #else
 #include <CL/cl.h>
 #endif
+#else
+// OpenVX built without OpenCL: buffers are host memory passed as cl_mem handles
+typedef struct _cl_context * cl_context;
+typedef struct _cl_mem * cl_mem;
+#endif
 #endif
 
 //////////////////////////////////////////////////////////////////////
@@ -95,6 +101,7 @@ enum {
 	LIVE_STITCH_ATTR_NOISE_FILTER			  =   55,   // temporal filter to account for the camera noise: 0:OFF 1:ON (default:0)
 	LIVE_STITCH_ATTR_USE_CPU_FOR_INIT         =   56,   // use CPU kernels for initialize stitch: 0:OFF 1:ON (default:0)
 	LIVE_STITCH_ATTR_SAVE_AND_LOAD_INIT		  =	  57,   // save initialized stitch tables for quick load&run: 0:OFF 1:ON (default:0)
+	LIVE_STITCH_ATTR_USE_CPU_FOR_STITCH       =   58,   // use CPU kernels for the stitch graph: 0:OFF 1:ON (default:0)
 	// Dynamic LoomSL attributes
 	LIVE_STITCH_ATTR_SEAM_THRESHOLD           =   64,   // seamfind seam refresh Threshold: 0 - 100 percentage change (default:25)
 	LIVE_STITCH_ATTR_NOISE_FILTER_LAMBDA	  =   65,   // temporal filter variable: 0 - 1 (default:1)
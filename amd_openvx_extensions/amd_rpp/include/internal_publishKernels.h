@@ -65,6 +65,7 @@ vx_status FastCornerDetector_Register(vx_context);
 vx_status FisheyebatchPD_Register(vx_context);
 vx_status FlipbatchPD_Register(vx_context);
 vx_status FogbatchPD_Register(vx_context);
+vx_status FusedPointwisebatchPD_Register(vx_context);
 vx_status GammaCorrectionbatchPD_Register(vx_context);
 vx_status GaussianFilterbatchPD_Register(vx_context);
 vx_status GaussianImagePyramidbatchPD_Register(vx_context);
@@ -197,5 +198,6 @@ vx_status WarpPerspectivebatchPD_Register(vx_context);
 #define VX_KERNEL_RPP_CROPPD_NAME   							"org.rpp.CropPD"
 #define VX_KERNEL_RPP_RESIZECROPMIRRORPD_NAME      				"org.rpp.ResizeCropMirrorPD"
 #define VX_KERNEL_RPP_SEQUENCEREARRANGE_NAME                    "org.rpp.SequenceRearrange"
+#define VX_KERNEL_RPP_FUSEDPOINTWISEBATCHPD_NAME                "org.rpp.FusedPointwisebatchPD"
 
 #endif //_AMDVX_EXT__PUBLISH_KERNELS_H_
@@ -43,6 +43,8 @@ THE SOFTWARE.
 #include<iostream>
 #include<algorithm>
 #include<functional>
+#include<map>
+#include<mutex>
 
 using namespace std;
 
@@ -70,6 +72,30 @@ vx_node createNode(vx_graph graph, vx_enum kernelEnum, vx_reference params[], vx
 vx_status createGraphHandle(vx_node node, RPPCommonHandle ** pHandle);
 vx_status releaseGraphHandle(vx_node node, RPPCommonHandle * handle);
 int getEnvironmentVariable(const char* name);
+//! Brief Returns the host buffer of a per image parameter array (or of the batch width/height arrays) for in place reads
+// The buffer is mapped once when the node is initialized, the array is written from the host before every run so the
+// node reads the current values through the pointer instead of copying them out with vxCopyArrayRange on every run
+vx_status mapBatchArray(vx_array arr, vx_uint32 nbatchSize, vx_size itemSize, void **ptr);
+
+//! Brief Per image dimensions of a batch, shared by all the nodes that read the same width/height arrays
+// The dimensions are rebuilt only when the arrays were written since the last build, so in a chain of nodes
+// reading the same arrays the first node of a batch rebuilds them and the others reuse them as is
+struct RppBatchGeometry {
+    vx_array width;
+    vx_array height;
+    vx_uint32 nbatchSize;
+    Rpp32u *batchWidth;
+    Rpp32u *batchHeight;
+    RppiSize *dimensions;
+    vx_uint32 widthWriteCount;
+    vx_uint32 heightWriteCount;
+    bool valid;
+    int count;
+    std::mutex lock;
+};
+vx_status acquireBatchGeometry(vx_array width, vx_array height, vx_uint32 nbatchSize, RppBatchGeometry **pGeometry);
+vx_status refreshBatchGeometry(RppBatchGeometry *geometry, RppiSize **dimensions);
+vx_status releaseBatchGeometry(RppBatchGeometry *geometry);
 
 class Kernellist
 {
@@ -38,6 +38,18 @@ THE SOFTWARE.
 
 vx_node vxCreateNodeByStructure(vx_graph graph, vx_enum kernelenum, vx_reference params[], vx_uint32 num);
 
+/*! \brief The per pixel operations of vxExtrppNode_FusedPointwisebatchPD, with their parameters in order.
+ * Each parameter is nbatchSize consecutive FLOAT32 values in the params array, one per image.
+ */
+enum vx_rpp_pointwise_op_e {
+    VX_RPP_POINTWISE_BRIGHTNESS = 0,        /*!< alpha, beta: trunc(alpha * x + beta) */
+    VX_RPP_POINTWISE_GAMMA_CORRECTION = 1,  /*!< gamma: 255 * (x / 255) ^ gamma */
+    VX_RPP_POINTWISE_EXPOSURE = 2,          /*!< exposure: x * 2 ^ exposure */
+    VX_RPP_POINTWISE_HUE = 3,               /*!< hue shift in degrees, RGB only */
+    VX_RPP_POINTWISE_SATURATION = 4,        /*!< saturation factor, RGB only */
+    VX_RPP_POINTWISE_COLOR_TWIST = 5        /*!< alpha, beta, hue, saturation, RGB only */
+};
+
 #ifdef __cplusplus
 extern  "C" {
 #endif
@@ -76,6 +88,7 @@ extern  "C" SHARED_PUBLIC vx_node VX_API_CALL vxExtrppNode_FastCornerDetector(vx
 extern  "C" SHARED_PUBLIC vx_node VX_API_CALL vxExtrppNode_FisheyebatchPD(vx_graph graph,vx_image pSrc,vx_array srcImgWidth,vx_array srcImgHeight,vx_image pDst,vx_uint32 nbatchSize);
 extern  "C" SHARED_PUBLIC vx_node VX_API_CALL vxExtrppNode_FlipbatchPD(vx_graph graph,vx_image pSrc,vx_array srcImgWidth,vx_array srcImgHeight,vx_image pDst,vx_array flipAxis,vx_uint32 nbatchSize);
 extern  "C" SHARED_PUBLIC vx_node VX_API_CALL vxExtrppNode_FogbatchPD(vx_graph graph,vx_image pSrc,vx_array srcImgWidth,vx_array srcImgHeight,vx_image pDst,vx_array fogValue,vx_uint32 nbatchSize);
+extern  "C" SHARED_PUBLIC vx_node VX_API_CALL vxExtrppNode_FusedPointwisebatchPD(vx_graph graph,vx_image pSrc,vx_array srcImgWidth,vx_array srcImgHeight,vx_image pDst,vx_array ops,vx_array params,vx_uint32 nbatchSize);
 extern  "C" SHARED_PUBLIC vx_node VX_API_CALL vxExtrppNode_GammaCorrectionbatchPD(vx_graph graph,vx_image pSrc,vx_array srcImgWidth,vx_array srcImgHeight,vx_image pDst,vx_array gamma,vx_uint32 nbatchSize);
 extern  "C" SHARED_PUBLIC vx_node VX_API_CALL vxExtrppNode_GaussianFilterbatchPD(vx_graph graph,vx_image pSrc,vx_array srcImgWidth,vx_array srcImgHeight,vx_image pDst,vx_array stdDev,vx_array kernelSize,vx_uint32 nbatchSize);
 extern  "C" SHARED_PUBLIC vx_node VX_API_CALL vxExtrppNode_GaussianImagePyramidbatchPD(vx_graph graph,vx_image pSrc,vx_array srcImgWidth,vx_array srcImgHeight,vx_image pDst,vx_array stdDev,vx_array kernelSize,vx_uint32 nbatchSize);
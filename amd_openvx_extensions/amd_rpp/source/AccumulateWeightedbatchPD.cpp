@@ -30,8 +30,7 @@ struct AccumulateWeightedbatchPDLocalData
     Rpp32u nbatchSize;
     RppiSize *srcDimensions;
     RppiSize maxSrcDimensions;
-    Rpp32u *srcBatch_width;
-    Rpp32u *srcBatch_height;
+    RppBatchGeometry *srcGeometry;
     RppPtr_t pSrc1;
     RppPtr_t pSrc2;
     vx_float32 *alpha;
@@ -48,17 +47,7 @@ static vx_status VX_CALLBACK refreshAccumulateWeightedbatchPD(vx_node node, cons
 {
     vx_status status = VX_SUCCESS;
     vx_status copy_status;
-    STATUS_ERROR_CHECK(vxCopyArrayRange((vx_array)parameters[4], 0, data->nbatchSize, sizeof(vx_float32), data->alpha, VX_READ_ONLY, VX_MEMORY_TYPE_HOST));
-    STATUS_ERROR_CHECK(vxQueryImage((vx_image)parameters[0], VX_IMAGE_HEIGHT, &data->maxSrcDimensions.height, sizeof(data->maxSrcDimensions.height)));
-    STATUS_ERROR_CHECK(vxQueryImage((vx_image)parameters[0], VX_IMAGE_WIDTH, &data->maxSrcDimensions.width, sizeof(data->maxSrcDimensions.width)));
-    data->maxSrcDimensions.height = data->maxSrcDimensions.height / data->nbatchSize;
-    STATUS_ERROR_CHECK(vxCopyArrayRange((vx_array)parameters[2], 0, data->nbatchSize, sizeof(Rpp32u), data->srcBatch_width, VX_READ_ONLY, VX_MEMORY_TYPE_HOST));
-    STATUS_ERROR_CHECK(vxCopyArrayRange((vx_array)parameters[3], 0, data->nbatchSize, sizeof(Rpp32u), data->srcBatch_height, VX_READ_ONLY, VX_MEMORY_TYPE_HOST));
-    for (int i = 0; i < data->nbatchSize; i++)
-    {
-        data->srcDimensions[i].width = data->srcBatch_width[i];
-        data->srcDimensions[i].height = data->srcBatch_height[i];
-    }
+    STATUS_ERROR_CHECK(refreshBatchGeometry(data->srcGeometry, &data->srcDimensions));
     if (data->device_type == AGO_TARGET_AFFINITY_GPU)
     {
 #if ENABLE_OPENCL
@@ -188,10 +177,11 @@ static vx_status VX_CALLBACK initializeAccumulateWeightedbatchPD(vx_node node, c
 #endif
     STATUS_ERROR_CHECK(vxCopyScalar((vx_scalar)parameters[6], &data->device_type, VX_READ_ONLY, VX_MEMORY_TYPE_HOST));
     STATUS_ERROR_CHECK(vxReadScalarValue((vx_scalar)parameters[5], &data->nbatchSize));
-    data->srcDimensions = (RppiSize *)malloc(sizeof(RppiSize) * data->nbatchSize);
-    data->srcBatch_width = (Rpp32u *)malloc(sizeof(Rpp32u) * data->nbatchSize);
-    data->srcBatch_height = (Rpp32u *)malloc(sizeof(Rpp32u) * data->nbatchSize);
-    data->alpha = (vx_float32 *)malloc(sizeof(vx_float32) * data->nbatchSize);
+    STATUS_ERROR_CHECK(acquireBatchGeometry((vx_array)parameters[2], (vx_array)parameters[3], data->nbatchSize, &data->srcGeometry));
+    STATUS_ERROR_CHECK(mapBatchArray((vx_array)parameters[4], data->nbatchSize, sizeof(vx_float32), (void **)&data->alpha));
+    STATUS_ERROR_CHECK(vxQueryImage((vx_image)parameters[0], VX_IMAGE_HEIGHT, &data->maxSrcDimensions.height, sizeof(data->maxSrcDimensions.height)));
+    STATUS_ERROR_CHECK(vxQueryImage((vx_image)parameters[0], VX_IMAGE_WIDTH, &data->maxSrcDimensions.width, sizeof(data->maxSrcDimensions.width)));
+    data->maxSrcDimensions.height = data->maxSrcDimensions.height / data->nbatchSize;
     refreshAccumulateWeightedbatchPD(node, parameters, num, data);
 #if ENABLE_OPENCL
     if (data->device_type == AGO_TARGET_AFFINITY_GPU)
@@ -217,10 +207,7 @@ static vx_status VX_CALLBACK uninitializeAccumulateWeightedbatchPD(vx_node node,
 #endif
     if (data->device_type == AGO_TARGET_AFFINITY_CPU)
         rppDestroyHost(data->rppHandle);
-    free(data->srcBatch_height);
-    free(data->srcBatch_width);
-    free(data->srcDimensions);
-    free(data->alpha);
+    releaseBatchGeometry(data->srcGeometry);
     delete (data);
     return VX_SUCCESS;
 }
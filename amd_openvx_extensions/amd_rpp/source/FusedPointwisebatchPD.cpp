@@ -0,0 +1,383 @@
+/*
+Copyright (c) 2019 - 2022 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include "internal_publishKernels.h"
+#include "vx_ext_rpp.h"
+
+// A chain of per pixel operations applied to each image of the batch in a single pass: every pixel is read once,
+// goes through all the operations in registers, and is written once. Consecutive operations that map each channel
+// value independently (brightness, gamma correction, exposure) are folded into one 256 entry table per image.
+#define FUSED_POINTWISE_MAX_OPS 16
+
+struct FusedPointwisebatchPDLocalData
+{
+    Rpp32u device_type;
+    Rpp32u nbatchSize;
+    RppiSize maxSrcDimensions;
+    Rpp32u *srcBatch_width;
+    Rpp32u *srcBatch_height;
+    vx_uint32 *ops;
+    vx_size numOps;
+    vx_uint32 paramOffset[FUSED_POINTWISE_MAX_OPS]; // index of the first parameter run of each op in params
+    vx_float32 *params;
+    vx_uint32 channels;
+    RppPtr_t pSrc;
+    RppPtr_t pDst;
+};
+
+struct FusedPointwiseStage
+{
+    bool isTable;
+    vx_uint8 table[256];
+    vx_float32 hueShift, saturationFactor, alpha, beta;
+};
+
+static vx_uint32 pointwiseParamCount(vx_uint32 op)
+{
+    switch (op)
+    {
+    case VX_RPP_POINTWISE_BRIGHTNESS:
+        return 2;
+    case VX_RPP_POINTWISE_GAMMA_CORRECTION:
+    case VX_RPP_POINTWISE_EXPOSURE:
+    case VX_RPP_POINTWISE_HUE:
+    case VX_RPP_POINTWISE_SATURATION:
+        return 1;
+    case VX_RPP_POINTWISE_COLOR_TWIST:
+        return 4;
+    default:
+        return 0;
+    }
+}
+
+static inline vx_uint8 saturateTruncate(vx_float32 value)
+{
+    return (vx_uint8)(value < 0.0f ? 0.0f : (value < 255.0f ? value : 255.0f));
+}
+
+static inline vx_uint8 saturateRound(vx_float32 value)
+{
+    return saturateTruncate(value + 0.5f);
+}
+
+//! \brief Hue shift (degrees), saturation scale and then alpha * value + beta on one RGB pixel, through HSV
+static inline void adjustPixelHsv(vx_uint8 *px, const FusedPointwiseStage &stage)
+{
+    vx_float32 r = px[0] * (1.0f / 255.0f), g = px[1] * (1.0f / 255.0f), b = px[2] * (1.0f / 255.0f);
+    vx_float32 cmax = std::max(r, std::max(g, b)), cmin = std::min(r, std::min(g, b));
+    vx_float32 delta = cmax - cmin;
+    vx_float32 h = 0.0f, s = (cmax > 0.0f) ? delta / cmax : 0.0f, v = cmax;
+    if (delta > 0.0f)
+    {
+        if (cmax == r)
+            h = 60.0f * (g - b) / delta;
+        else if (cmax == g)
+            h = 60.0f * ((b - r) / delta + 2.0f);
+        else
+            h = 60.0f * ((r - g) / delta + 4.0f);
+    }
+    h += stage.hueShift;
+    h -= 360.0f * floorf(h * (1.0f / 360.0f));
+    s = std::min(std::max(s * stage.saturationFactor, 0.0f), 1.0f);
+    vx_float32 c = v * s;
+    vx_float32 hp = h * (1.0f / 60.0f);
+    vx_float32 x = c * (1.0f - fabsf(fmodf(hp, 2.0f) - 1.0f));
+    vx_float32 m = v - c;
+    vx_float32 rr, gg, bb;
+    switch ((int)hp)
+    {
+    case 0:  rr = c; gg = x; bb = 0; break;
+    case 1:  rr = x; gg = c; bb = 0; break;
+    case 2:  rr = 0; gg = c; bb = x; break;
+    case 3:  rr = 0; gg = x; bb = c; break;
+    case 4:  rr = x; gg = 0; bb = c; break;
+    default: rr = c; gg = 0; bb = x; break;
+    }
+    px[0] = saturateRound(stage.alpha * (rr + m) * 255.0f + stage.beta);
+    px[1] = saturateRound(stage.alpha * (gg + m) * 255.0f + stage.beta);
+    px[2] = saturateRound(stage.alpha * (bb + m) * 255.0f + stage.beta);
+}
+
+//! \brief Turns the op list into the stages of one image, folding consecutive per channel ops into a single table
+static int buildStages(const FusedPointwisebatchPDLocalData *data, Rpp32u sample, FusedPointwiseStage *stages)
+{
+    int numStages = 0;
+    const Rpp32u n = data->nbatchSize;
+    for (vx_size i = 0; i < data->numOps; i++)
+    {
+        const vx_float32 *p = data->params + data->paramOffset[i] * n + sample;
+        vx_uint32 op = data->ops[i];
+        if (op == VX_RPP_POINTWISE_BRIGHTNESS || op == VX_RPP_POINTWISE_GAMMA_CORRECTION || op == VX_RPP_POINTWISE_EXPOSURE)
+        {
+            if (numStages == 0 || !stages[numStages - 1].isTable)
+            {
+                FusedPointwiseStage &stage = stages[numStages++];
+                stage.isTable = true;
+                for (int v = 0; v < 256; v++)
+                    stage.table[v] = (vx_uint8)v;
+            }
+            vx_uint8 *table = stages[numStages - 1].table;
+            if (op == VX_RPP_POINTWISE_BRIGHTNESS)
+            {
+                for (int v = 0; v < 256; v++)
+                    table[v] = saturateTruncate(p[0] * table[v] + p[n]);
+            }
+            else if (op == VX_RPP_POINTWISE_GAMMA_CORRECTION)
+            {
+                for (int v = 0; v < 256; v++)
+                    table[v] = saturateTruncate(powf(table[v] * (1.0f / 255.0f), p[0]) * 255.0f);
+            }
+            else
+            {
+                vx_float32 scale = powf(2.0f, p[0]);
+                for (int v = 0; v < 256; v++)
+                    table[v] = saturateTruncate(table[v] * scale);
+            }
+        }
+        else if (data->channels == 3)
+        {
+            // hue, saturation and color twist need the three channels, they are skipped on single channel images
+            FusedPointwiseStage &stage = stages[numStages++];
+            stage.isTable = false;
+            stage.hueShift = 0.0f;
+            stage.saturationFactor = 1.0f;
+            stage.alpha = 1.0f;
+            stage.beta = 0.0f;
+            if (op == VX_RPP_POINTWISE_HUE)
+                stage.hueShift = p[0];
+            else if (op == VX_RPP_POINTWISE_SATURATION)
+                stage.saturationFactor = p[0];
+            else
+            {
+                stage.alpha = p[0];
+                stage.beta = p[n];
+                stage.hueShift = p[2 * n];
+                stage.saturationFactor = p[3 * n];
+            }
+        }
+    }
+    return numStages;
+}
+
+static void processFusedSample(const FusedPointwisebatchPDLocalData *data, Rpp32u sample)
+{
+    FusedPointwiseStage stages[FUSED_POINTWISE_MAX_OPS];
+    int numStages = buildStages(data, sample, stages);
+    const vx_uint32 channels = data->channels;
+    const size_t sampleSize = (size_t)data->maxSrcDimensions.width * data->maxSrcDimensions.height * channels;
+    const size_t stride = (size_t)data->maxSrcDimensions.width * channels;
+    const vx_uint8 *src = (const vx_uint8 *)data->pSrc + sampleSize * sample;
+    vx_uint8 *dst = (vx_uint8 *)data->pDst + sampleSize * sample;
+    Rpp32u width = std::min(data->srcBatch_width[sample], data->maxSrcDimensions.width);
+    Rpp32u height = std::min(data->srcBatch_height[sample], data->maxSrcDimensions.height);
+    // like the RPP batchPD kernels, the pixels outside the ROI are passed through unchanged
+    if (height < data->maxSrcDimensions.height && dst != src)
+        memcpy(dst + stride * height, src + stride * height, stride * (data->maxSrcDimensions.height - height));
+    for (Rpp32u y = 0; y < height; y++)
+    {
+        const vx_uint8 *srcRow = src + stride * y;
+        vx_uint8 *dstRow = dst + stride * y;
+        if (width < data->maxSrcDimensions.width && dst != src)
+            memcpy(dstRow + width * channels, srcRow + width * channels, stride - width * channels);
+        if (numStages == 1 && stages[0].isTable)
+        {
+            // only per channel ops, a single table lookup per value
+            const vx_uint8 *table = stages[0].table;
+            for (Rpp32u x = 0; x < width * channels; x++)
+                dstRow[x] = table[srcRow[x]];
+            continue;
+        }
+        for (Rpp32u x = 0; x < width; x++)
+        {
+            vx_uint8 px[3];
+            for (vx_uint32 c = 0; c < channels; c++)
+                px[c] = srcRow[x * channels + c];
+            for (int s = 0; s < numStages; s++)
+            {
+                if (stages[s].isTable)
+                {
+                    for (vx_uint32 c = 0; c < channels; c++)
+                        px[c] = stages[s].table[px[c]];
+                }
+                else
+                    adjustPixelHsv(px, stages[s]);
+            }
+            for (vx_uint32 c = 0; c < channels; c++)
+                dstRow[x * channels + c] = px[c];
+        }
+    }
+}
+
+static vx_status VX_CALLBACK refreshFusedPointwisebatchPD(vx_node node, const vx_reference *parameters, vx_uint32 num, FusedPointwisebatchPDLocalData *data)
+{
+    vx_status status = VX_SUCCESS;
+    STATUS_ERROR_CHECK(vxQueryImage((vx_image)parameters[0], VX_IMAGE_ATTRIBUTE_AMD_HOST_BUFFER, &data->pSrc, sizeof(vx_uint8)));
+    STATUS_ERROR_CHECK(vxQueryImage((vx_image)parameters[3], VX_IMAGE_ATTRIBUTE_AMD_HOST_BUFFER, &data->pDst, sizeof(vx_uint8)));
+    return status;
+}
+
+static vx_status VX_CALLBACK validateFusedPointwisebatchPD(vx_node node, const vx_reference parameters[], vx_uint32 num, vx_meta_format metas[])
+{
+    vx_status status = VX_SUCCESS;
+    vx_enum scalar_type;
+    STATUS_ERROR_CHECK(vxQueryScalar((vx_scalar)parameters[6], VX_SCALAR_TYPE, &scalar_type, sizeof(scalar_type)));
+    if (scalar_type != VX_TYPE_UINT32)
+        return ERRMSG(VX_ERROR_INVALID_TYPE, "validate: Paramter: #6 type=%d (must be size)\n", scalar_type);
+    STATUS_ERROR_CHECK(vxQueryScalar((vx_scalar)parameters[7], VX_SCALAR_TYPE, &scalar_type, sizeof(scalar_type)));
+    if (scalar_type != VX_TYPE_UINT32)
+        return ERRMSG(VX_ERROR_INVALID_TYPE, "validate: Paramter: #7 type=%d (must be size)\n", scalar_type);
+    vx_enum item_type;
+    STATUS_ERROR_CHECK(vxQueryArray((vx_array)parameters[4], VX_ARRAY_ATTRIBUTE_ITEMTYPE, &item_type, sizeof(item_type)));
+    if (item_type != VX_TYPE_UINT32)
+        return ERRMSG(VX_ERROR_INVALID_TYPE, "validate: Paramter: #4 item type=%d (must be UINT32)\n", item_type);
+    STATUS_ERROR_CHECK(vxQueryArray((vx_array)parameters[5], VX_ARRAY_ATTRIBUTE_ITEMTYPE, &item_type, sizeof(item_type)));
+    if (item_type != VX_TYPE_FLOAT32)
+        return ERRMSG(VX_ERROR_INVALID_TYPE, "validate: Paramter: #5 item type=%d (must be FLOAT32)\n", item_type);
+    // Check for input parameters
+    vx_parameter input_param;
+    vx_image input;
+    vx_df_image df_image;
+    input_param = vxGetParameterByIndex(node, 0);
+    STATUS_ERROR_CHECK(vxQueryParameter(input_param, VX_PARAMETER_ATTRIBUTE_REF, &input, sizeof(vx_image)));
+    STATUS_ERROR_CHECK(vxQueryImage(input, VX_IMAGE_ATTRIBUTE_FORMAT, &df_image, sizeof(df_image)));
+    if (df_image != VX_DF_IMAGE_U8 && df_image != VX_DF_IMAGE_RGB)
+    {
+        return ERRMSG(VX_ERROR_INVALID_FORMAT, "validate: FusedPointwisebatchPD: image: #0 format=%4.4s (must be RGB2 or U008)\n", (char *)&df_image);
+    }
+
+    // Check for output parameters
+    vx_image output;
+    vx_parameter output_param;
+    vx_uint32 height, width;
+    output_param = vxGetParameterByIndex(node, 3);
+    STATUS_ERROR_CHECK(vxQueryParameter(output_param, VX_PARAMETER_ATTRIBUTE_REF, &output, sizeof(vx_image)));
+    STATUS_ERROR_CHECK(vxQueryImage(output, VX_IMAGE_ATTRIBUTE_WIDTH, &width, sizeof(width)));
+    STATUS_ERROR_CHECK(vxQueryImage(output, VX_IMAGE_ATTRIBUTE_HEIGHT, &height, sizeof(height)));
+    STATUS_ERROR_CHECK(vxSetMetaFormatAttribute(metas[3], VX_IMAGE_ATTRIBUTE_WIDTH, &width, sizeof(width)));
+    STATUS_ERROR_CHECK(vxSetMetaFormatAttribute(metas[3], VX_IMAGE_ATTRIBUTE_HEIGHT, &height, sizeof(height)));
+    STATUS_ERROR_CHECK(vxSetMetaFormatAttribute(metas[3], VX_IMAGE_ATTRIBUTE_FORMAT, &df_image, sizeof(df_image)));
+    vxReleaseImage(&input);
+    vxReleaseImage(&output);
+    vxReleaseParameter(&output_param);
+    vxReleaseParameter(&input_param);
+    return status;
+}
+
+static vx_status VX_CALLBACK processFusedPointwisebatchPD(vx_node node, const vx_reference *parameters, vx_uint32 num)
+{
+    FusedPointwisebatchPDLocalData *data = NULL;
+    STATUS_ERROR_CHECK(vxQueryNode(node, VX_NODE_LOCAL_DATA_PTR, &data, sizeof(data)));
+    STATUS_ERROR_CHECK(refreshFusedPointwisebatchPD(node, parameters, num, data));
+#pragma omp parallel for
+    for (int i = 0; i < (int)data->nbatchSize; i++)
+        processFusedSample(data, i);
+    return VX_SUCCESS;
+}
+
+static vx_status VX_CALLBACK initializeFusedPointwisebatchPD(vx_node node, const vx_reference *parameters, vx_uint32 num)
+{
+    FusedPointwisebatchPDLocalData *data = new FusedPointwisebatchPDLocalData;
+    memset(data, 0, sizeof(*data));
+    STATUS_ERROR_CHECK(vxCopyScalar((vx_scalar)parameters[7], &data->device_type, VX_READ_ONLY, VX_MEMORY_TYPE_HOST));
+    STATUS_ERROR_CHECK(vxReadScalarValue((vx_scalar)parameters[6], &data->nbatchSize));
+    vx_df_image df_image = VX_DF_IMAGE_VIRT;
+    STATUS_ERROR_CHECK(vxQueryImage((vx_image)parameters[0], VX_IMAGE_ATTRIBUTE_FORMAT, &df_image, sizeof(df_image)));
+    data->channels = (df_image == VX_DF_IMAGE_RGB) ? 3 : 1;
+    STATUS_ERROR_CHECK(vxQueryImage((vx_image)parameters[0], VX_IMAGE_HEIGHT, &data->maxSrcDimensions.height, sizeof(data->maxSrcDimensions.height)));
+    STATUS_ERROR_CHECK(vxQueryImage((vx_image)parameters[0], VX_IMAGE_WIDTH, &data->maxSrcDimensions.width, sizeof(data->maxSrcDimensions.width)));
+    data->maxSrcDimensions.height = data->maxSrcDimensions.height / data->nbatchSize;
+    STATUS_ERROR_CHECK(mapBatchArray((vx_array)parameters[1], data->nbatchSize, sizeof(Rpp32u), (void **)&data->srcBatch_width));
+    STATUS_ERROR_CHECK(mapBatchArray((vx_array)parameters[2], data->nbatchSize, sizeof(Rpp32u), (void **)&data->srcBatch_height));
+    // the op list is fixed when the node is created, only the parameter values change from run to run
+    STATUS_ERROR_CHECK(vxQueryArray((vx_array)parameters[4], VX_ARRAY_ATTRIBUTE_NUMITEMS, &data->numOps, sizeof(data->numOps)));
+    if (data->numOps < 1 || data->numOps > FUSED_POINTWISE_MAX_OPS)
+        return ERRMSG(VX_ERROR_INVALID_DIMENSION, "initialize: FusedPointwisebatchPD: %d ops (must be 1..%d)\n", (int)data->numOps, FUSED_POINTWISE_MAX_OPS);
+    STATUS_ERROR_CHECK(mapBatchArray((vx_array)parameters[4], data->numOps, sizeof(vx_uint32), (void **)&data->ops));
+    vx_uint32 paramCount = 0;
+    for (vx_size i = 0; i < data->numOps; i++)
+    {
+        vx_uint32 count = pointwiseParamCount(data->ops[i]);
+        if (count == 0)
+            return ERRMSG(VX_ERROR_INVALID_VALUE, "initialize: FusedPointwisebatchPD: unknown op %d\n", data->ops[i]);
+        data->paramOffset[i] = paramCount;
+        paramCount += count;
+    }
+    STATUS_ERROR_CHECK(mapBatchArray((vx_array)parameters[5], data->nbatchSize * paramCount, sizeof(vx_float32), (void **)&data->params));
+    STATUS_ERROR_CHECK(refreshFusedPointwisebatchPD(node, parameters, num, data));
+    STATUS_ERROR_CHECK(vxSetNodeAttribute(node, VX_NODE_LOCAL_DATA_PTR, &data, sizeof(data)));
+    return VX_SUCCESS;
+}
+
+static vx_status VX_CALLBACK uninitializeFusedPointwisebatchPD(vx_node node, const vx_reference *parameters, vx_uint32 num)
+{
+    FusedPointwisebatchPDLocalData *data;
+    STATUS_ERROR_CHECK(vxQueryNode(node, VX_NODE_LOCAL_DATA_PTR, &data, sizeof(data)));
+    delete (data);
+    return VX_SUCCESS;
+}
+
+//! \brief The kernel target support callback.
+// The fused kernel only has a host implementation, rocAL only fuses chains on the CPU affinity
+static vx_status VX_CALLBACK query_target_support(vx_graph graph, vx_node node,
+                                                  vx_bool use_opencl_1_2,              // [input]  false: OpenCL driver is 2.0+; true: OpenCL driver is 1.2
+                                                  vx_uint32 &supported_target_affinity // [output] must be set to AGO_TARGET_AFFINITY_CPU or AGO_TARGET_AFFINITY_GPU or (AGO_TARGET_AFFINITY_CPU | AGO_TARGET_AFFINITY_GPU)
+)
+{
+    supported_target_affinity = AGO_TARGET_AFFINITY_CPU;
+    return VX_SUCCESS;
+}
+
+vx_status FusedPointwisebatchPD_Register(vx_context context)
+{
+    vx_status status = VX_SUCCESS;
+    // Add kernel to the context with callbacks
+    vx_kernel kernel = vxAddUserKernel(context, "org.rpp.FusedPointwisebatchPD",
+                                       VX_KERNEL_RPP_FUSEDPOINTWISEBATCHPD,
+                                       processFusedPointwisebatchPD,
+                                       8,
+                                       validateFusedPointwisebatchPD,
+                                       initializeFusedPointwisebatchPD,
+                                       uninitializeFusedPointwisebatchPD);
+    ERROR_CHECK_OBJECT(kernel);
+    amd_kernel_query_target_support_f query_target_support_f = query_target_support;
+
+    if (kernel)
+    {
+        STATUS_ERROR_CHECK(vxSetKernelAttribute(kernel, VX_KERNEL_ATTRIBUTE_AMD_QUERY_TARGET_SUPPORT, &query_target_support_f, sizeof(query_target_support_f)));
+        PARAM_ERROR_CHECK(vxAddParameterToKernel(kernel, 0, VX_INPUT, VX_TYPE_IMAGE, VX_PARAMETER_STATE_REQUIRED));
+        PARAM_ERROR_CHECK(vxAddParameterToKernel(kernel, 1, VX_INPUT, VX_TYPE_ARRAY, VX_PARAMETER_STATE_REQUIRED));
+        PARAM_ERROR_CHECK(vxAddParameterToKernel(kernel, 2, VX_INPUT, VX_TYPE_ARRAY, VX_PARAMETER_STATE_REQUIRED));
+        PARAM_ERROR_CHECK(vxAddParameterToKernel(kernel, 3, VX_OUTPUT, VX_TYPE_IMAGE, VX_PARAMETER_STATE_REQUIRED));
+        PARAM_ERROR_CHECK(vxAddParameterToKernel(kernel, 4, VX_INPUT, VX_TYPE_ARRAY, VX_PARAMETER_STATE_REQUIRED));
+        PARAM_ERROR_CHECK(vxAddParameterToKernel(kernel, 5, VX_INPUT, VX_TYPE_ARRAY, VX_PARAMETER_STATE_REQUIRED));
+        PARAM_ERROR_CHECK(vxAddParameterToKernel(kernel, 6, VX_INPUT, VX_TYPE_SCALAR, VX_PARAMETER_STATE_REQUIRED));
+        PARAM_ERROR_CHECK(vxAddParameterToKernel(kernel, 7, VX_INPUT, VX_TYPE_SCALAR, VX_PARAMETER_STATE_REQUIRED));
+        PARAM_ERROR_CHECK(vxFinalizeKernel(kernel));
+    }
+    if (status != VX_SUCCESS)
+    {
+    exit:
+        vxRemoveKernel(kernel);
+        return VX_FAILURE;
+    }
+    return status;
+}
@@ -124,6 +124,7 @@ vx_status get_kernels_to_publish()
     STATUS_ERROR_CHECK(ADD_KERENEL(Copy_Register));
     STATUS_ERROR_CHECK(ADD_KERENEL(Nop_Register));
     STATUS_ERROR_CHECK(ADD_KERENEL(SequenceRearrange_Register));
+    STATUS_ERROR_CHECK(ADD_KERENEL(FusedPointwisebatchPD_Register));
     return status;
 }
 
@@ -284,6 +284,29 @@ VX_API_ENTRY vx_node VX_API_CALL vxExtrppNode_FogbatchPD(vx_graph graph, vx_imag
     return node;
 }
 
+VX_API_ENTRY vx_node VX_API_CALL vxExtrppNode_FusedPointwisebatchPD(vx_graph graph, vx_image pSrc, vx_array srcImgWidth, vx_array srcImgHeight, vx_image pDst, vx_array ops, vx_array params, vx_uint32 nbatchSize)
+{
+    vx_node node = NULL;
+    vx_context context = vxGetContext((vx_reference)graph);
+    if (vxGetStatus((vx_reference)context) == VX_SUCCESS)
+    {
+        vx_uint32 dev_type = getGraphAffinity(graph);
+        vx_scalar DEV_TYPE = vxCreateScalar(vxGetContext((vx_reference)graph), VX_TYPE_UINT32, &dev_type);
+        vx_scalar NBATCHSIZE = vxCreateScalar(vxGetContext((vx_reference)graph), VX_TYPE_UINT32, &nbatchSize);
+        vx_reference params_[] = {
+            (vx_reference)pSrc,
+            (vx_reference)srcImgWidth,
+            (vx_reference)srcImgHeight,
+            (vx_reference)pDst,
+            (vx_reference)ops,
+            (vx_reference)params,
+            (vx_reference)NBATCHSIZE,
+            (vx_reference)DEV_TYPE};
+        node = createNode(graph, VX_KERNEL_RPP_FUSEDPOINTWISEBATCHPD, params_, 8);
+    }
+    return node;
+}
+
 VX_API_ENTRY vx_node VX_API_CALL vxExtrppNode_RainbatchPD(vx_graph graph, vx_image pSrc, vx_array srcImgWidth, vx_array srcImgHeight, vx_image pDst, vx_array rainValue, vx_array rainWidth, vx_array rainHeight, vx_array rainTransperancy, vx_uint32 nbatchSize)
 {
     vx_node node = NULL;
@@ -1873,6 +1896,98 @@ vx_node createNode(vx_graph graph, vx_enum kernelEnum, vx_reference params[], vx
     return node;
 }
 
+vx_status mapBatchArray(vx_array arr, vx_uint32 nbatchSize, vx_size itemSize, void **ptr)
+{
+    vx_size capacity = 0, arrItemSize = 0;
+    STATUS_ERROR_CHECK(vxQueryArray(arr, VX_ARRAY_ATTRIBUTE_CAPACITY, &capacity, sizeof(capacity)));
+    STATUS_ERROR_CHECK(vxQueryArray(arr, VX_ARRAY_ATTRIBUTE_ITEMSIZE, &arrItemSize, sizeof(arrItemSize)));
+    if (capacity < nbatchSize || arrItemSize != itemSize)
+        return ERRMSG(VX_ERROR_INVALID_DIMENSION, "mapBatchArray: array of %d items of %d bytes can't hold %d items of %d bytes\n", (int)capacity, (int)arrItemSize, nbatchSize, (int)itemSize);
+    STATUS_ERROR_CHECK(vxQueryArray(arr, VX_ARRAY_BUFFER, ptr, sizeof(vx_uint8 *)));
+    return VX_SUCCESS;
+}
+
+static std::mutex batchGeometryLock;
+static std::map<std::pair<vx_array, vx_array>, RppBatchGeometry *> batchGeometries;
+
+vx_status acquireBatchGeometry(vx_array width, vx_array height, vx_uint32 nbatchSize, RppBatchGeometry **pGeometry)
+{
+    std::lock_guard<std::mutex> guard(batchGeometryLock);
+    RppBatchGeometry *geometry = NULL;
+    auto it = batchGeometries.find(std::make_pair(width, height));
+    if (it != batchGeometries.end())
+    {
+        geometry = it->second;
+        if (nbatchSize > geometry->nbatchSize)
+        {
+            // a node with a larger batch joined, the other nodes pick up the new buffer on their next refresh
+            std::lock_guard<std::mutex> geometryGuard(geometry->lock);
+            STATUS_ERROR_CHECK(mapBatchArray(width, nbatchSize, sizeof(Rpp32u), (void **)&geometry->batchWidth));
+            STATUS_ERROR_CHECK(mapBatchArray(height, nbatchSize, sizeof(Rpp32u), (void **)&geometry->batchHeight));
+            free(geometry->dimensions);
+            geometry->dimensions = (RppiSize *)malloc(sizeof(RppiSize) * nbatchSize);
+            geometry->nbatchSize = nbatchSize;
+            geometry->valid = false;
+        }
+        geometry->count++;
+    }
+    else
+    {
+        geometry = new RppBatchGeometry;
+        geometry->width = width;
+        geometry->height = height;
+        geometry->nbatchSize = nbatchSize;
+        geometry->valid = false;
+        geometry->count = 1;
+        vx_status status = mapBatchArray(width, nbatchSize, sizeof(Rpp32u), (void **)&geometry->batchWidth);
+        if (status == VX_SUCCESS)
+            status = mapBatchArray(height, nbatchSize, sizeof(Rpp32u), (void **)&geometry->batchHeight);
+        if (status != VX_SUCCESS)
+        {
+            delete geometry;
+            return status;
+        }
+        geometry->dimensions = (RppiSize *)malloc(sizeof(RppiSize) * nbatchSize);
+        batchGeometries[std::make_pair(width, height)] = geometry;
+    }
+    *pGeometry = geometry;
+    return VX_SUCCESS;
+}
+
+vx_status refreshBatchGeometry(RppBatchGeometry *geometry, RppiSize **dimensions)
+{
+    vx_uint32 widthWriteCount, heightWriteCount;
+    STATUS_ERROR_CHECK(vxQueryArray(geometry->width, VX_ARRAY_WRITE_COUNT, &widthWriteCount, sizeof(widthWriteCount)));
+    STATUS_ERROR_CHECK(vxQueryArray(geometry->height, VX_ARRAY_WRITE_COUNT, &heightWriteCount, sizeof(heightWriteCount)));
+    std::lock_guard<std::mutex> guard(geometry->lock);
+    if (!geometry->valid || widthWriteCount != geometry->widthWriteCount || heightWriteCount != geometry->heightWriteCount)
+    {
+        for (int i = 0; i < geometry->nbatchSize; i++)
+        {
+            geometry->dimensions[i].width = geometry->batchWidth[i];
+            geometry->dimensions[i].height = geometry->batchHeight[i];
+        }
+        geometry->widthWriteCount = widthWriteCount;
+        geometry->heightWriteCount = heightWriteCount;
+        geometry->valid = true;
+    }
+    *dimensions = geometry->dimensions;
+    return VX_SUCCESS;
+}
+
+vx_status releaseBatchGeometry(RppBatchGeometry *geometry)
+{
+    std::lock_guard<std::mutex> guard(batchGeometryLock);
+    geometry->count--;
+    if (geometry->count == 0)
+    {
+        batchGeometries.erase(std::make_pair(geometry->width, geometry->height));
+        free(geometry->dimensions);
+        delete geometry;
+    }
+    return VX_SUCCESS;
+}
+
 #if ENABLE_OPENCL
 int getEnvironmentVariable(const char *name)
 {
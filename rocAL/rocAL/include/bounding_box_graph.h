@@ -24,11 +24,30 @@ THE SOFTWARE.
 #include <list>
 #include "meta_data_graph.h"
 #include "meta_node.h"
+
+//! Per thread scratch buffers of the box encoder, kept across batches to avoid allocating them for every image
+struct BoxEncoderScratch
+{
+    std::vector<float> anchor_best_iou; //!< best IoU of each anchor over the boxes of the image
+    std::vector<int> anchor_best_box; //!< index of the box giving anchor_best_iou
+    std::vector<float> box_lane_iou; //!< per SIMD lane best IoU of each box over the anchors
+    std::vector<int> box_lane_anchor; //!< index of the anchor giving box_lane_iou
+    std::vector<int> box_best_anchor; //!< best anchor of each box after reducing the lanes
+};
+
 class BoundingBoxGraph : public MetaDataGraph
 {
 public:
     void process(MetaDataBatch* meta_data) override;
     void update_random_bbox_meta_data(MetaDataBatch* meta_data, decoded_image_info decoded_image_info,crop_image_info crop_image_info) override;
     void update_box_encoder_meta_data(std::vector<float> *anchors, pMetaDataBatch full_batch_meta_data ,float criteria, bool offset , float scale, std::vector<float>& means, std::vector<float>& stds) override;
+private:
+    void update_anchors(const std::vector<float> &anchors);
+    void match_boxes_to_anchors(BoxEncoderScratch &scratch, const BoundingBoxCord *bb_coords, unsigned bb_count);
+    std::vector<float> _anchors; //!< anchors in the "ltrb" format as last passed to the encoder
+    unsigned _anchors_count = 0;
+    unsigned _anchors_padded_count = 0; //!< anchors count rounded up to the SIMD width, padding anchors are NaN and never match
+    std::vector<float> _anchors_l, _anchors_t, _anchors_r, _anchors_b, _anchors_area; //!< structure of arrays copy of _anchors
+    std::vector<BoxEncoderScratch> _scratch_pool; //!< indexed by the OpenMP thread number
 };
 
@@ -69,6 +69,8 @@ private:
     RaliMemType _mem_type;
     size_t _output_mem_size;
     bool _internal_thread_running;
+    std::mutex _idle_lock;
+    std::condition_variable _idle_cv;//!< Wakes up the load thread waiting at the end of the media when reset() or shut down stops it
     size_t _batch_size;
     size_t _image_size;
     std::thread _load_thread;
@@ -22,14 +22,13 @@ THE SOFTWARE.
 
 #pragma once
 #include <vector>
-#include <condition_variable>
 #if !ENABLE_HIP
     #include <CL/cl.h>
 #endif
-#include <queue>
 #include "device_manager.h"
 #include "device_manager_hip.h"
 #include "commons.h"
+#include "ring_buffer_index.h"
 struct decoded_image_info
 {
     std::vector<std::string> _image_names;
@@ -60,8 +59,8 @@ public:
     void unblock_writer();// Unblocks the thread currently waiting on get_write_buffer
     void push();// The latest write goes through, effectively adds one element to the buffer
     void pop();// The oldest write will be erased and overwritten in upcoming writes
-    void set_image_info(const decoded_image_info& info) { _last_image_info = info; }
-    void set_crop_image_info(const crop_image_info& info) { _last_crop_image_info = info; }
+    void set_image_info(const decoded_image_info& info) { _circ_image_info[_index.write_index()] = info; }
+    void set_crop_image_info(const crop_image_info& info) { _circ_crop_image_info[_index.write_index()] = info; }
     decoded_image_info& get_image_info();
     crop_image_info& get_cropped_image_info();
     bool random_bbox_crop_flag = false;
@@ -74,16 +73,12 @@ public:
     void block_if_full();// blocks the caller if the buffer is full
 
 private:
-    void increment_read_ptr();
-    void increment_write_ptr();
     bool full();
     bool empty();
     size_t _buff_depth;
-    decoded_image_info _last_image_info;
-    std::queue<decoded_image_info> _circ_image_info;//!< Stores the loaded images names, decoded_width and decoded_height(data is stored in the _circ_buff)
-    crop_image_info _last_crop_image_info; // for Random BBox crop coordinates
-    std::queue<crop_image_info> _circ_crop_image_info;//!< Stores the crop coordinates of the images for random bbox crop (data is stored in the _circ_buff)
-    std::mutex _names_buff_lock;
+    RingBufferIndex _index;//!< Lock-free read/write positions shared by the loader thread (producer) and the graph (consumer)
+    std::vector<decoded_image_info> _circ_image_info;//!< Stores the loaded images names, decoded_width and decoded_height, one slot per image buffer
+    std::vector<crop_image_info> _circ_crop_image_info;//!< Stores the crop coordinates of the images for random bbox crop, one slot per image buffer
     /*
      *  Pinned memory allocated on the host used for fast host to device memory transactions,
      *  or the regular host memory buffers in the host processing case.
@@ -99,14 +94,8 @@ private:
     std::vector<void *> _dev_buffer;// Actual memory allocated on the device (in the case of GPU affinity)
     std::vector<unsigned char*> _host_buffer_ptrs;
     std::vector<std::vector<unsigned char>> _actual_host_buffers;
-    std::condition_variable _wait_for_load;
-    std::condition_variable _wait_for_unload;
-    std::mutex _lock;
     RaliMemType _output_mem_type;
     size_t _output_mem_size;
     bool _initialized = false;
     const size_t MEM_ALIGNMENT = 256;
-    size_t _write_ptr;
-    size_t _read_ptr;
-    size_t _level;
 };
\ No newline at end of file
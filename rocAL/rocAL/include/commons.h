@@ -99,4 +99,10 @@ struct Timing
     long long unsigned video_read_time= 0;
     long long unsigned video_decode_time= 0;
     long long unsigned video_process_time= 0;
+    long long unsigned video_decoded_frames= 0; // frames decoded by the video decoders, including the ones decoded only to reach a seek target
+    long long unsigned video_output_frames= 0; // video_decoded_frames / video_output_frames gives the decoded frames per output frame
+    long long unsigned image_read_bytes= 0; // bytes read by the loader, image_read_bytes / image_read_time gives the read bandwidth
+    unsigned image_read_queue_depth= 0; // number of batches read ahead of the decoder
+    long long unsigned image_cache_hits= 0; // images served by the decoded image cache
+    long long unsigned image_cache_misses= 0; // images read and decoded while the decoded image cache is enabled
 };
\ No newline at end of file
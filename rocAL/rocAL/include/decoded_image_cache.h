@@ -0,0 +1,91 @@
+/*
+Copyright (c) 2019 - 2022 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/*! \brief Keeps decoded images between epochs so that the loader only reads and decodes each of them once
+ *
+ * Entries are keyed by the image id and hold the ROI of the decoded image, i.e. roi_height rows of roi_width * planes
+ * bytes without the padding up to the loader's maximum width. They are kept in memory up to the memory budget and
+ * evicted in least recently used order. If a spill path is given, the evicted entries are appended to that file in a
+ * raw format (a small header followed by the ROI bytes) and served from there until they come back into memory.
+ * All the functions are thread safe.
+ */
+class DecodedImageCache
+{
+public:
+    struct Entry
+    {
+        uint32_t roi_width;
+        uint32_t roi_height;
+        uint32_t original_width;
+        uint32_t original_height;
+        uint32_t planes;
+        std::vector<unsigned char> pixels;
+    };
+    //! The spill file is created (truncated if it exists) right away and removed by the destructor
+    DecodedImageCache(size_t memory_budget, const std::string& spill_path = "");
+    ~DecodedImageCache();
+    //! Returns the entry of the image or nullptr, counts a hit or a miss
+    std::shared_ptr<const Entry> get(const std::string& id);
+    //! Adds the image decoded in image with a row stride of stride bytes
+    void put(const std::string& id, uint32_t roi_width, uint32_t roi_height, uint32_t original_width, uint32_t original_height,
+             uint32_t planes, const unsigned char* image, size_t stride);
+    unsigned long long hits() const { return _hits; }
+    unsigned long long misses() const { return _misses; }
+private:
+    struct SpillRecord
+    {
+        uint32_t roi_width;
+        uint32_t roi_height;
+        uint32_t original_width;
+        uint32_t original_height;
+        uint32_t planes;
+        uint32_t reserved;
+        uint64_t size;
+    };
+    typedef std::list<std::pair<std::string, std::shared_ptr<const Entry>>> LruList;
+    //! Moves an entry into memory and returns the entries evicted to make room for it, the lock must be held
+    std::vector<std::pair<std::string, std::shared_ptr<const Entry>>> insert(const std::string& id, std::shared_ptr<const Entry> entry);
+    //! Appends the evicted entries that are not already there to the spill file
+    void spill(const std::vector<std::pair<std::string, std::shared_ptr<const Entry>>>& evicted);
+    std::shared_ptr<const Entry> read_spilled(uint64_t offset);
+    const size_t _memory_budget;
+    size_t _memory_used = 0;
+    LruList _lru;//!< Most recently used entry first
+    std::unordered_map<std::string, LruList::iterator> _entries;
+    std::unordered_map<std::string, uint64_t> _spill_index;//!< Offset of the record of each image in the spill file
+    std::string _spill_path;
+    int _spill_fd = -1;
+    uint64_t _spill_size = 0;
+    std::mutex _lock;
+    std::atomic<unsigned long long> _hits;
+    std::atomic<unsigned long long> _misses;
+};
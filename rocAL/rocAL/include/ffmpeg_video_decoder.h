@@ -44,5 +44,13 @@ private:
     int _video_stream_idx = -1;
     AVPixelFormat _dec_pix_fmt;
     int _codec_width, _codec_height;
+    // Kept across Decode() calls
+    SwsContext *_sws_ctx = nullptr;
+    AVFrame *_dec_frame = nullptr;
+    // Decode position, used to carry on without a seek when the next sequence starts shortly after the previous one
+    int64_t _next_frame_number = -1;
+    int64_t _last_keyframe_number = -1;
+    int64_t _gop_size = 0; // largest keyframe interval seen so far
+    void close_input();
 };
 #endif
@@ -24,6 +24,7 @@ THE SOFTWARE.
 #include <vector>
 #include <string>
 #include <memory>
+#include <cstdlib>
 #include <dirent.h>
 #include "reader.h"
 #include "commons.h"
@@ -45,6 +46,7 @@ public:
     size_t read_data(unsigned char* buf, size_t max_size) override;
     //! Opens the next file in the folder
     /*!
+     Also asks the kernel to start reading the next readahead_count files of the (shuffled) list in the background
      \return The size of the next file, 0 if couldn't access it
     */
     size_t open() override;
@@ -74,8 +76,11 @@ private:
     struct dirent *_entity;
     std::vector<std::string> _file_names;
     unsigned  _curr_file_idx;
-    FILE* _current_fPtr;
+    int _current_fd;
     unsigned _current_file_size;
+    size_t _current_offset;
+    bool _current_direct;//!< True if the opened file uses O_DIRECT, its content is then read at once into _direct_buffer
+    bool _current_loaded;
     std::string _last_id;
     std::string _last_file_name;
     size_t _shard_id = 0;
@@ -98,5 +103,15 @@ private:
     void replicate_last_image_to_fill_last_shard();
     void replicate_last_batch_to_pad_partial_shard();
     TimingDBG _shuffle_time;
+    size_t _readahead_count = 0;
+    size_t _readahead_end = 0;//!< Value of _read_counter up to which the files have been hinted
+    FileReadMode _file_read_mode = FileReadMode::BUFFERED;
+    bool _direct_unsupported = false;
+    //! Reused for every file read with O_DIRECT, which needs the buffer, the offset and the size to be aligned
+    std::unique_ptr<unsigned char, decltype(&free)> _direct_buffer{nullptr, &free};
+    size_t _direct_buffer_size = 0;
+    static const size_t DIRECT_IO_ALIGNMENT = 4096;
+    void issue_readahead();
+    size_t read_direct(unsigned char* buf, size_t read_size);
 };
 
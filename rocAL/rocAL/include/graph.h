@@ -21,7 +21,9 @@ THE SOFTWARE.
 */
 
 #pragma once
+#include <map>
 #include "commons.h"
+#include "pipeline_random.h"
 #include <VX/vx.h>
 #include <VX/vx_types.h>
 
@@ -30,12 +32,30 @@ class Graph
 {
 public:
     enum class Status { OK = 0 };
-    Graph(vx_context context, RaliAffinity affinity, int cpu_id = 0, int gpu_id = 0 );
+    Graph(vx_context context, RaliAffinity affinity, int cpu_id = 0, int gpu_id = 0, unsigned seed = 0);
     Status verify();
     Status process();
     Status release();
     vx_graph get() { return _graph; }
+    //! Returns the width and height arrays shared by all the nodes that read the given ROI vectors, creates them on the first call
+    std::pair<vx_array, vx_array> roi_arrays(uint32_t* roi_width, uint32_t* roi_height, size_t batch_size);
+    //! Copies the ROI vectors to their shared arrays, only the first call for the vectors in each batch does the copy
+    void publish_roi(uint32_t* roi_width, uint32_t* roi_height, size_t batch_size);
+    //! Marks the start of a new batch, the ROI arrays get copied again on the next publish_roi() call
+    void new_batch() { _batch_id++; _random.new_batch(); }
+    //! Position of the pipeline in the generator of the augmentation parameters
+    PipelineRandom& random() { return _random; }
 private:
+    struct RoiArrays
+    {
+        vx_array width;
+        vx_array height;
+        size_t published_batch_id;
+    };
+    //! Images with the same geometry share their ROI vectors, the nodes reading them share one pair of arrays
+    std::map<std::pair<uint32_t*, uint32_t*>, RoiArrays> _roi_arrays;
+    size_t _batch_id = 1;
+    PipelineRandom _random;
     RaliMemType _mem_type;
     vx_context  _context = nullptr;
     vx_graph    _graph = nullptr;
@@ -46,6 +46,11 @@ private:
     int _codec_width, _codec_height;
     AVHWDeviceType *hwDeviceType;
     AVBufferRef *hw_device_ctx = NULL;
+    // Kept across Decode() calls
+    SwsContext *_sws_ctx = nullptr;
+    AVFrame *_dec_frame = nullptr;
+    AVFrame *_sw_frame = nullptr;
     int hw_decoder_init(AVCodecContext *ctx, const enum AVHWDeviceType type, AVBufferRef *hw_device_ctx);
+    void close_input();
 };
 #endif
@@ -24,6 +24,8 @@ THE SOFTWARE.
 
 #include <string>
 #include <thread>
+#include <mutex>
+#include <condition_variable>
 #include <vector>
 #include "commons.h"
 #include "circular_buffer.h"
@@ -55,6 +57,8 @@ public:
     crop_image_info get_crop_image_info() override;
     void set_prefetch_queue_depth(size_t prefetch_queue_depth)  override;
     void shut_down() override;
+    void enable_decoded_image_cache(size_t memory_budget, const std::string& spill_path) override;
+    void set_file_read_options(size_t readahead_count, FileReadMode mode) override;
 private:
     bool is_out_of_data();
     void de_init();
@@ -68,6 +72,8 @@ private:
     MetaDataBatch* _meta_data = nullptr;//!< The output of the meta_data_graph,
     std::vector<std::vector <float>> _bbox_coords;
     bool _internal_thread_running;
+    std::mutex _idle_lock;
+    std::condition_variable _idle_cv;//!< Wakes up the load thread waiting at the end of the media when reset() or shut down stops it
     size_t _batch_size;
     std::thread _load_thread;
     RaliMemType _mem_type;
@@ -84,6 +90,11 @@ private:
     size_t _image_counter = 0;//!< How many images have been loaded already
     size_t _remaining_image_count;//!< How many images are there yet to be loaded
     bool _decoder_keep_original = false;
+    bool _cache_enabled = false;
+    size_t _cache_memory_budget = 0;
+    std::string _cache_spill_path;
+    size_t _readahead_count = 0;
+    FileReadMode _file_read_mode = FileReadMode::BUFFERED;
     std::shared_ptr<RandomBBoxCrop_MetaDataReader> _randombboxcrop_meta_data_reader = nullptr;
 };
 
@@ -49,6 +49,8 @@ public:
     Timing timing() override;
     void set_prefetch_queue_depth(size_t prefetch_queue_depth) override;
     void shut_down() override;
+    void enable_decoded_image_cache(size_t memory_budget, const std::string& spill_path) override;
+    void set_file_read_options(size_t readahead_count, FileReadMode mode) override;
 private:
     void increment_loader_idx();
 #if ENABLE_HIP
@@ -62,6 +64,11 @@ private:
     size_t _shard_count = 1;
     void fast_forward_through_empty_loaders();
     size_t _prefetch_queue_depth;
+    bool _cache_enabled = false;
+    size_t _cache_memory_budget = 0;
+    std::string _cache_spill_path;
+    size_t _readahead_count = 0;
+    FileReadMode _file_read_mode = FileReadMode::BUFFERED;
 
     Image *_output_image;
     std::shared_ptr<RandomBBoxCrop_MetaDataReader> _randombboxcrop_meta_data_reader = nullptr;
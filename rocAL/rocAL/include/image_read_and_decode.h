@@ -24,11 +24,15 @@ THE SOFTWARE.
 #include <dirent.h>
 #include <vector>
 #include <memory>
+#include <future>
+#include <atomic>
+#include <mutex>
 #include "commons.h"
 #include "turbo_jpeg_decoder.h"
 #include "reader_factory.h"
 #include "timing_debug.h"
 #include "loader_module.h"
+#include "decoded_image_cache.h"
 
 /**
  * Compute the scaled value of <tt>dimension</tt> using the given scaling
@@ -44,6 +48,7 @@ class ImageReadAndDecode
 public:
     ImageReadAndDecode();
     ~ImageReadAndDecode();
+    //! Number of images left for load(), including the batch read ahead. Safe to call while the read-ahead task runs
     size_t count();
     void reset();
     void create(ReaderConfig reader_config, DecoderConfig decoder_config, int batch_size);
@@ -51,8 +56,12 @@ public:
     void set_random_bbox_data_reader(std::shared_ptr<RandomBBoxCrop_MetaDataReader> randombboxcrop_meta_data_reader);
     std::vector<std::vector <float>> get_batch_random_bbox_crop_coords();
     void set_batch_random_bbox_crop_coords(std::vector<std::vector <float>> batch_crop_coords);
+    //! Serves the images found in cache without reading or decoding them and adds the other ones once decoded
+    /// Not used with SKIP_DECODE or when the decoder crops, the decoded images then differ from one epoch to the next
+    void set_decoded_image_cache(std::shared_ptr<DecodedImageCache> cache) { _cache = cache; }
 
     //! Loads a decompressed batch of images into the buffer indicated by buff
+    /// The next batch is read on an async task while this one is decoded, the files of a batch are still read one after the other
     /// \param buff User's buffer provided to be filled with decoded image samples
     /// \param names User's buffer provided to be filled with name of the images decoded
     /// \param max_decoded_width User's buffer maximum width per decoded image. User expects the decoder to downscale the image if image's original width is bigger than max_width
@@ -83,6 +92,25 @@ private:
     std::vector<size_t> _actual_read_size;
     std::vector<std::string> _image_names;
     std::vector<size_t> _compressed_image_size;
+    //! Second set of compressed buffers filled by the read-ahead task while the current batch is being decoded
+    std::vector<std::vector<unsigned char>> _prefetch_compressed_buff;
+    std::vector<size_t> _prefetch_actual_read_size;
+    std::vector<std::string> _prefetch_image_names;
+    std::vector<size_t> _prefetch_compressed_image_size;
+    //! Cache entries found for the images of the batch, nullptr for the ones that are read and decoded
+    std::vector<std::shared_ptr<const DecodedImageCache::Entry>> _cached;
+    std::vector<std::shared_ptr<const DecodedImageCache::Entry>> _prefetch_cached;
+    std::shared_ptr<DecodedImageCache> _cache;
+    bool use_cache();
+    std::future<size_t> _prefetch;
+    //! Guards what count() and timing() read from the read-ahead task: the file load timer and the counts below
+    std::mutex _prefetch_lock;
+    size_t _unread_count = 0;//!< Items left in the reader, refreshed by whoever uses the reader: the read-ahead task or load()
+    size_t _prefetched_count = 0;//!< Items read ahead and not yet handed to load()
+    std::atomic<long long unsigned> _read_bytes;
+    size_t read_compressed_batch();
+    void start_prefetch();
+    size_t wait_for_prefetch();
     std::vector<unsigned char*> _decompressed_buff_ptrs;
     std::vector<size_t> _actual_decoded_width;
     std::vector<size_t> _actual_decoded_height;
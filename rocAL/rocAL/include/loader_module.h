@@ -60,6 +60,10 @@ public:
     // introduce meta data reader
     virtual void set_random_bbox_data_reader(std::shared_ptr<RandomBBoxCrop_MetaDataReader> randombboxcrop_meta_data_reader) = 0;
     virtual void shut_down() = 0;
+    // keeps the decoded images in a cache of memory_budget bytes, spilled to spill_path if not empty, must be called before initialize()
+    virtual void enable_decoded_image_cache(size_t memory_budget, const std::string& spill_path) { WRN("Decoded image cache is not supported by this loader") }
+    // sets the readahead hints and the page cache use of the file reader, must be called before initialize()
+    virtual void set_file_read_options(size_t readahead_count, FileReadMode mode) { WRN("File read options are not supported by this loader") }
 };
 
 using pLoaderModule = std::shared_ptr<LoaderModule>;
\ No newline at end of file
@@ -24,6 +24,9 @@ THE SOFTWARE.
 #include <memory>
 #include <list>
 #include <variant>
+#include <mutex>
+#include <condition_variable>
+#include <future>
 #include <map>
 #include "graph.h"
 #include "ring_buffer.h"
@@ -42,6 +45,7 @@ THE SOFTWARE.
 #include "device_manager_hip.h"
 #endif
 #include "randombboxcrop_meta_data_reader.h"
+#include "shared_memory_ring.h"
 #define MAX_STRING_LENGTH 100
 class MasterGraph
 {
@@ -85,7 +89,7 @@ public:
     MetaDataBatch *create_caffe2_lmdb_record_meta_data_reader(const char *source_path, MetaDataReaderType reader_type,  MetaDataType label_type);
     MetaDataBatch* create_cifar10_label_reader(const char *source_path, const char *file_prefix);
     MetaDataBatch *create_mxnet_label_reader(const char *source_path, bool is_output);
-    void box_encoder(std::vector<float> &anchors, float criteria, const std::vector<float> &means, const std::vector<float> &stds, bool offset, float scale);
+    void box_encoder(std::vector<float> &anchors, float criteria, const std::vector<float> &means, const std::vector<float> &stds, bool offset, float scale, bool pipelined = false);
     void create_randombboxcrop_reader(RandomBBoxCrop_MetaDataReaderType reader_type, RandomBBoxCrop_MetaDataType label_type, bool all_boxes_overlap, bool no_crop, FloatParam* aspect_ratio, bool has_shape, int crop_width, int crop_height, int num_attempts, FloatParam* scaling, int total_num_attempts, int64_t seed=0);
     const std::pair<ImageNameBatch,pMetaDataBatch>& meta_data();
     void set_loop(bool val) { _loop = val; }
@@ -101,11 +105,19 @@ public:
     void set_sequence_reader_output() { _is_sequence_reader_output = true; }
     void set_sequence_batch_size(size_t sequence_length) { _sequence_batch_size = _user_batch_size * sequence_length; }
     void set_sequence_batch_ratio() { _sequence_batch_ratio = _sequence_batch_size / _internal_batch_size; }
+    void set_pointwise_fusion(bool enable) { _fuse_pointwise = enable; }
+    void set_decoded_image_cache(size_t memory_budget, const std::string& spill_path) { _cache_enabled = true; _cache_memory_budget = memory_budget; _cache_spill_path = spill_path; }
+    void set_file_read_options(size_t readahead_count, FileReadMode mode) { _readahead_count = readahead_count; _file_read_mode = mode; }
+    //! Creates the POSIX shared memory ring publish_to_shared_memory() writes to, can only be called after build()
+    void create_shared_memory_output(const std::string& name, unsigned slot_count, unsigned max_consumers);
+    //! Copies the current output batch and its labels to the next free slot of the shared memory ring, blocks while it's full
+    Status publish_to_shared_memory();
 private:
     Status update_node_parameters();
     Status allocate_output_tensor();
     Status deallocate_output_tensor();
     void create_single_graph();
+    void fuse_pointwise_nodes();
     void start_processing();
     void stop_processing();
     void output_routine();
@@ -153,6 +165,8 @@ private:
     std::shared_ptr<RandomBBoxCrop_MetaDataReader> _randombboxcrop_meta_data_reader = nullptr;
     bool _first_run = true;
     bool _processing;//!< Indicates if internal processing thread should keep processing or not
+    std::mutex _processing_lock;
+    std::condition_variable _processing_cv;//!< Wakes up the internal processing thread waiting for more data when processing is stopped
     const static unsigned SAMPLE_SIZE = sizeof(unsigned char);
     int _remaining_count;//!< Keeps the count of remaining images yet to be processed for the user,
     bool _loop;//!< Indicates if user wants to indefinitely loops through images or not
@@ -169,6 +183,13 @@ private:
     size_t _sequence_batch_size = 0; //!< Indicates the _user_batch_size when sequence reader outputs are required
     size_t _sequence_batch_ratio; //!< Indicates the _user_to_internal_batch_ratio when sequence reader outputs are required
     bool _is_sequence_reader_output = false; //!< Set to true if Sequence Reader is invoked.
+    std::unique_ptr<SharedMemoryRing> _shared_memory_ring;//!< Set when the pipeline feeds consumer processes through shared memory
+    bool _fuse_pointwise = false; //!< Set to true to merge chains of pointwise augmentations into one node at build time (CPU only)
+    bool _cache_enabled = false; //!< Set to true to keep the decoded images of the loader between epochs, applied when the loader is added
+    size_t _cache_memory_budget = 0;
+    std::string _cache_spill_path;
+    size_t _readahead_count = 0; //!< Number of upcoming files the file reader hints to the kernel, applied when the loader is added
+    FileReadMode _file_read_mode = FileReadMode::BUFFERED;
     // box encoder variables
     bool _is_box_encoder = false; //bool variable to set the box encoder
     std::vector<float>_anchors; // Anchors to be used for encoding, as the array of floats is in the ltrb format of size 8732x4
@@ -176,6 +197,9 @@ private:
     float _scale; // Rescales the box and anchor values before the offset is calculated (for example, to return to the absolute values).
     bool _offset; // Returns normalized offsets ((encoded_bboxes*scale - anchors*scale) - mean) / stds in EncodedBBoxes that use std and the mean and scale arguments if offset="True"
     std::vector<float> _means, _stds; //_means:  [x y w h] mean values for normalization _stds: [x y w h] standard deviations for offset normalization.
+    bool _is_box_encoder_pipelined = false; // Encodes the boxes of each cycle on a separate thread while the graph processes the images of that cycle
+    void encode_boxes(pMetaDataBatch meta_data);
+    std::future<void> start_box_encoder_stage(pMetaDataBatch meta_data);
 };
 
 template <typename T>
@@ -221,6 +245,9 @@ template<> inline std::shared_ptr<ImageLoaderNode> MasterGraph::add_node(const s
     auto node = std::make_shared<ImageLoaderNode>(outputs[0], _device.resources());
     _loader_module = node->get_loader_module();
     _loader_module->set_prefetch_queue_depth(_prefetch_queue_depth);
+    _loader_module->set_file_read_options(_readahead_count, _file_read_mode);
+    if(_cache_enabled)
+        _loader_module->enable_decoded_image_cache(_cache_memory_budget, _cache_spill_path);
     _root_nodes.push_back(node);
     for(auto& output: outputs)
         _image_map.insert(make_pair(output, node));
@@ -234,6 +261,9 @@ template<> inline std::shared_ptr<ImageLoaderSingleShardNode> MasterGraph::add_n
     auto node = std::make_shared<ImageLoaderSingleShardNode>(outputs[0], _device.resources());
     _loader_module = node->get_loader_module();
     _loader_module->set_prefetch_queue_depth(_prefetch_queue_depth);
+    _loader_module->set_file_read_options(_readahead_count, _file_read_mode);
+    if(_cache_enabled)
+        _loader_module->enable_decoded_image_cache(_cache_memory_budget, _cache_spill_path);
     _root_nodes.push_back(node);
     for(auto& output: outputs)
         _image_map.insert(make_pair(output, node));
@@ -247,6 +277,7 @@ template<> inline std::shared_ptr<FusedJpegCropNode> MasterGraph::add_node(const
     auto node = std::make_shared<FusedJpegCropNode>(outputs[0], _device.resources());
     _loader_module = node->get_loader_module();
     _loader_module->set_prefetch_queue_depth(_prefetch_queue_depth);
+    _loader_module->set_file_read_options(_readahead_count, _file_read_mode);
     _loader_module->set_random_bbox_data_reader(_randombboxcrop_meta_data_reader);
     _root_nodes.push_back(node);
     for(auto& output: outputs)
@@ -262,6 +293,7 @@ template<> inline std::shared_ptr<FusedJpegCropSingleShardNode> MasterGraph::add
     auto node = std::make_shared<FusedJpegCropSingleShardNode>(outputs[0], _device.resources());
     _loader_module = node->get_loader_module();
     _loader_module->set_prefetch_queue_depth(_prefetch_queue_depth);
+    _loader_module->set_file_read_options(_readahead_count, _file_read_mode);
     _loader_module->set_random_bbox_data_reader(_randombboxcrop_meta_data_reader);
     _root_nodes.push_back(node);
     for(auto& output: outputs)
@@ -22,11 +22,12 @@ THE SOFTWARE.
 
 #pragma once
 #include "node.h"
+#include "node_fused_pointwise.h"
 #include "parameter_factory.h"
 #include "parameter_vx.h"
 #include "graph.h"
 
-class BrightnessNode : public Node
+class BrightnessNode : public Node, public PointwiseOp
 {
 public:
     BrightnessNode(const std::vector<Image *> &inputs, const std::vector<Image *> &outputs);
@@ -35,6 +36,8 @@ public:
     void init( float alpha, float beta);
     void init( FloatParam* alpha_param, FloatParam* beta_param);
 
+    vx_uint32 pointwise_op() const override;
+    void append_pointwise_params(std::vector<float> &params, PipelineRandom &random, unsigned batch_size) override;
 protected:
     void create_node() override ;
     void update_node() override;
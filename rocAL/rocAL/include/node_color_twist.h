@@ -22,11 +22,12 @@ THE SOFTWARE.
 
 #pragma once
 #include "node.h"
+#include "node_fused_pointwise.h"
 #include "parameter_factory.h"
 #include "parameter_vx.h"
 #include "graph.h"
 
-class ColorTwistBatchNode : public Node
+class ColorTwistBatchNode : public Node, public PointwiseOp
 {
 public:
     ColorTwistBatchNode(const std::vector<Image *> &inputs, const std::vector<Image *> &outputs);
@@ -34,6 +35,8 @@ public:
     void init(float alpha, float beta, float hue, float sat);
     void init(FloatParam *alpha, FloatParam *beta, FloatParam *hue, FloatParam *sat);
 
+    vx_uint32 pointwise_op() const override;
+    void append_pointwise_params(std::vector<float> &params, PipelineRandom &random, unsigned batch_size) override;
 protected:
     void create_node() override;
     void update_node() override;
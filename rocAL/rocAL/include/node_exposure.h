@@ -22,17 +22,20 @@ THE SOFTWARE.
 
 #pragma once
 #include "node.h"
+#include "node_fused_pointwise.h"
 #include "parameter_factory.h"
 #include "parameter_vx.h"
 #include "graph.h"
 
-class ExposureNode : public Node
+class ExposureNode : public Node, public PointwiseOp
 {
 public:
     ExposureNode(const std::vector<Image *> &inputs, const std::vector<Image *> &outputs);
     ExposureNode() = delete;
     void init(float shift);
     void init(FloatParam *shift);
+    vx_uint32 pointwise_op() const override;
+    void append_pointwise_params(std::vector<float> &params, PipelineRandom &random, unsigned batch_size) override;
 protected:
     void create_node() override;
     void update_node() override;
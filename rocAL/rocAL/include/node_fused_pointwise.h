@@ -0,0 +1,60 @@
+/*
+Copyright (c) 2019 - 2022 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#pragma once
+#include <vector>
+#include "node.h"
+#include "graph.h"
+
+//! \brief Implemented by the nodes that map every pixel on its own and can be merged into a FusedPointwiseNode
+class PointwiseOp
+{
+public:
+    virtual ~PointwiseOp() = default;
+    //! One of vx_rpp_pointwise_op_e
+    virtual vx_uint32 pointwise_op() const = 0;
+    //! Draws the parameters of the current batch of the pipeline and appends them to params, batch_size values per parameter
+    virtual void append_pointwise_params(std::vector<float> &params, PipelineRandom &random, unsigned batch_size) = 0;
+};
+
+//! \brief Runs a chain of pointwise nodes as a single vxExtrppNode_FusedPointwisebatchPD node
+/// Each image is read once and written once instead of once per augmentation. Created by MasterGraph::build()
+/// in place of the chain when pointwise fusion is enabled on a CPU pipeline.
+class FusedPointwiseNode : public Node
+{
+public:
+    FusedPointwiseNode(const std::vector<Image *> &inputs, const std::vector<Image *> &outputs);
+    FusedPointwiseNode() = delete;
+    ~FusedPointwiseNode() override;
+    void init(const std::vector<std::shared_ptr<Node>> &chain);
+    //! True if the node can be a link of a fused chain on the given image
+    static bool can_fuse(const std::shared_ptr<Node> &node);
+protected:
+    void create_node() override;
+    void update_node() override;
+private:
+    std::vector<std::shared_ptr<Node>> _chain;//!< Keeps the fused nodes and their parameters alive
+    std::vector<PointwiseOp *> _ops;
+    std::vector<float> _params;
+    vx_array _ops_array = nullptr;
+    vx_array _params_array = nullptr;
+};
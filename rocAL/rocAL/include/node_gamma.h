@@ -22,11 +22,12 @@ THE SOFTWARE.
 
 #pragma once
 #include "node.h"
+#include "node_fused_pointwise.h"
 #include "parameter_factory.h"
 #include "parameter_vx.h"
 
 
-class GammaNode : public Node
+class GammaNode : public Node, public PointwiseOp
 {
 public:
     GammaNode(const std::vector<Image *> &inputs, const std::vector<Image *> &outputs);
@@ -34,6 +35,8 @@ public:
     void init(float shift);
     void init(FloatParam *shift);
 
+    vx_uint32 pointwise_op() const override;
+    void append_pointwise_params(std::vector<float> &params, PipelineRandom &random, unsigned batch_size) override;
 protected:
     void update_node() override;
     void create_node() override;
@@ -22,17 +22,20 @@ THE SOFTWARE.
 
 #pragma once
 #include "node.h"
+#include "node_fused_pointwise.h"
 #include "parameter_factory.h"
 #include "parameter_vx.h"
 
 
-class HueNode : public Node
+class HueNode : public Node, public PointwiseOp
 {
 public:
     HueNode(const std::vector<Image *> &inputs, const std::vector<Image *> &outputs);
     HueNode() = delete;
     void init(float hue);
     void init(FloatParam *hue);
+    vx_uint32 pointwise_op() const override;
+    void append_pointwise_params(std::vector<float> &params, PipelineRandom &random, unsigned batch_size) override;
 protected:
     void create_node() override;
     void update_node() override;
@@ -22,17 +22,20 @@ THE SOFTWARE.
 
 #pragma once
 #include "node.h"
+#include "node_fused_pointwise.h"
 #include "parameter_factory.h"
 #include "parameter_vx.h"
 
 
-class SatNode : public Node
+class SatNode : public Node, public PointwiseOp
 {
 public:
     SatNode(const std::vector<Image *> &inputs, const std::vector<Image *> &outputs);
     SatNode() = delete;
     void init(float sat);
     void init(FloatParam *sat);
+    vx_uint32 pointwise_op() const override;
+    void append_pointwise_params(std::vector<float> &params, PipelineRandom &random, unsigned batch_size) override;
 protected:
     void create_node() override;
     void update_node() override;
@@ -50,5 +50,6 @@ private:
     constexpr static float COEFFICIENT_RANGE_0 [2] = {-0.35, 0.35};
     constexpr static float COEFFICIENT_RANGE_1 [2] = {0.65, 1.35};
     constexpr static float COEFFICIENT_RANGE_OFFSET [2] = {-10.0, 10.0};
+    void fill_affine_values();
     void update_affine_array();
 };
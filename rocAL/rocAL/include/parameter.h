@@ -21,6 +21,17 @@ THE SOFTWARE.
 */
 
 #pragma once
+#include <cstddef>
+#include <cstdint>
+#include "philox_random.h"
+
+//! Position of a batch in the counter based generator of a pipeline, see PipelineRandom
+struct RandomBatch
+{
+    philox::Key key;        //!< (pipeline seed, id of the user of the parameter in the pipeline)
+    uint32_t epoch;
+    uint64_t first_sample;  //!< Index of the first sample of the batch in the epoch
+};
 
 template <typename T>
 class Parameter
@@ -34,6 +45,22 @@ public:
     /// used to internally renew state of the parameter if needed (for random parameters)
     virtual void renew() {};
 
+    /// Returns the value of the parameter for a sample of a batch. Random parameters take it from a counter based generator:
+    /// the value only depends on the arguments, not on the state of the parameter, so the same parameter can serve several pipelines and threads at once.
+    /// \param idx index of the sample in the batch
+    /// \param draw_idx index of the value for this sample, for the users that need several values per sample
+    virtual T draw(const RandomBatch& batch, size_t idx, uint32_t draw_idx = 0)
+    {
+        return get();
+    }
+
+    /// Fills values[0 .. count) with the values of the parameter for the samples of a batch
+    virtual void generate(T* values, size_t count, const RandomBatch& batch)
+    {
+        for(size_t i = 0; i < count; i++)
+            values[i] = draw(batch, i);
+    }
+
     virtual ~Parameter() {}
     ///
     /// \return returns if this parameter takes a single value (vs a range of values or many values)
@@ -83,6 +83,10 @@ protected:
     Parameter<float>* default_y_drift_factor();
     std::vector<uint32_t> x1_arr_val, y1_arr_val, croph_arr_val, cropw_arr_val, x2_arr_val, y2_arr_val;
     bool _random;
+    std::shared_ptr<Graph> _graph;
+    uint32_t _param_id = 0; //!< Id of the crop in the pipeline, all its factors draw with it
+    //! Position of the current batch in the generator of the pipeline, the factors use different draw indices of each sample
+    RandomBatch random_batch() const;
     virtual void fill_crop_dims(){};
     void update_crop_array();
 };
@@ -26,6 +26,7 @@ THE SOFTWARE.
 #include <thread>
 #include <mutex>
 #include <memory>
+#include <atomic>
 #include "parameter_random.h"
 #include "parameter_simple.h"
 
@@ -74,27 +75,29 @@ class ParameterFactory {
 public:
     static ParameterFactory* instance();
     ~ParameterFactory();
-    void renew_parameters();
     void set_seed(unsigned seed);
     unsigned get_seed();
 
     template<typename T>
     Parameter<T>* create_uniform_rand_param(T start, T end){
-        auto gen = new UniformRand<T>(start, end, _seed);
-        _parameters.insert(gen);
+        auto gen = new UniformRand<T>(start, end, _seed, _next_param_id++);
+        register_param(gen);
         return gen;
     }
     template<typename T>
     Parameter<T>* create_single_value_param(T value){
         auto gen = new SimpleParameter<T>(value);
-        _parameters.insert(gen);
+        register_param(gen);
         return gen;
     }
     template<typename T>
     void destroy_param(Parameter<T>* param)
     {
-        if(_parameters.find(param) != _parameters.end())
-            _parameters.erase(param);
+        {
+            std::lock_guard<std::mutex> lock(_parameters_lock);
+            if(_parameters.find(param) != _parameters.end())
+                _parameters.erase(param);
+        }
         delete param;
     }
     IntParam* create_uniform_int_rand_param(int start, int end);
@@ -104,8 +107,16 @@ public:
     IntParam* create_single_value_int_param(int value);
     FloatParam* create_single_value_float_param(float value);
 private:
+    template<typename T>
+    void register_param(Parameter<T>* param)
+    {
+        std::lock_guard<std::mutex> lock(_parameters_lock);
+        _parameters.insert(param);
+    }
     long long unsigned _seed;
     std::set<pParamCore> _parameters; //<! Keeps the random generators used to randomized the augmentation parameters
+    std::mutex _parameters_lock; //<! Pipelines in different threads create and destroy parameters concurrently
+    std::atomic<uint32_t> _next_param_id { 0 }; //<! Part of the key of the renew() sequence of each random parameter
     static ParameterFactory* _instance;
     static std::mutex _mutex; 
     ParameterFactory();
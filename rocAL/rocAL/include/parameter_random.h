@@ -31,21 +31,24 @@ THE SOFTWARE.
 #include <vector>
 #include <thread>
 #include <random>
+#include <atomic>
+#include <mutex>
 #include "parameter.h"
+#include "philox_random.h"
 #include "log.h"
 template <typename T>
 class UniformRand: public Parameter<T>
 {
 public:
 
-    UniformRand(T start, T end, unsigned seed = 0):_generator(seed)
+    UniformRand(T start, T end, unsigned seed = 0, uint32_t id = 0):_key{seed, id}
     {
         update(start, end);
         renew();
     }
 
-    explicit UniformRand(T start, unsigned seed = 0):
-            UniformRand(start, start, seed) {}
+    explicit UniformRand(T start, unsigned seed = 0, uint32_t id = 0):
+            UniformRand(start, start, seed, id) {}
 
     T default_value() const override
     {
@@ -58,19 +61,22 @@ public:
     };
     void renew() override
     {
-        std::unique_lock<std::mutex> lock(_lock);
-        auto val =_generator();
-
         if(single_value())
         {
             // If there is only a single value possible for the random variable
             // don't waste time on calling the rand function , just return it.
             _updated_val = _start;
         } else {
-            _updated_val = static_cast<T>(
-                    ((double)val / (double) _generator.max()) * ((double) _end - (double) _start) + (double) _start);
+            // Scalar users (decoders, raliGetIntValue/raliGetFloatValue) draw from the parameter's own sequence, claiming a position is the only shared state
+            _updated_val = map(philox::at(_key, RENEW_EPOCH, _draw_count++, 0));
         }
     }
+    T draw(const RandomBatch& batch, size_t idx, uint32_t draw_idx = 0) override
+    {
+        if(single_value())
+            return _start;
+        return map(philox::at(batch.key, batch.epoch, batch.first_sample + idx, draw_idx));
+    }
     int update(T start, T end) {
         std::unique_lock<std::mutex> lock(_lock);
         if(end < start)
@@ -85,10 +91,16 @@ public:
         return (_start == _end);
     }
 private:
+    T map(uint32_t val) const
+    {
+        return static_cast<T>(philox::to_unit(val) * ((double) _end - (double) _start) + (double) _start);
+    }
+    static constexpr uint32_t RENEW_EPOCH = 0xFFFFFFFF;
     T _start;
     T _end;
     T _updated_val;
-    std::mt19937 _generator;
+    const philox::Key _key; //!< Only keys the renew() sequence, the pipelines draw with their own key
+    std::atomic<uint64_t> _draw_count { 0 };
     std::mutex _lock;
 };
 
@@ -102,7 +114,7 @@ struct CustomRand: public Parameter<T>
     (
         const T values[],
         const double frequencies[],
-        size_t size, unsigned seed = 0):_generator(seed)
+        size_t size, unsigned seed = 0, uint32_t id = 0):_key{seed, id}
     {
         update(values, frequencies, size);
         renew();
@@ -169,18 +181,23 @@ struct CustomRand: public Parameter<T>
             _updated_val =  _values[0];
         }
         else {
-            // Generate a value between [0 1]
-            double rand_val = (double) _generator() / (double) _generator.max();
-
-            // Find the iterators pointing to the first element bigger than idx
-            auto it = std::upper_bound(_comltv_dist.begin(), _comltv_dist.end(), rand_val);
-
-            // Get the index and return the associated value
-            unsigned idx = std::distance(_comltv_dist.begin(), it);
-
-            _updated_val = _values[idx];
+            _updated_val = map(philox::at(_key, RENEW_EPOCH, _draw_count++, 0));
         }
     }
+    T draw(const RandomBatch& batch, size_t idx, uint32_t draw_idx = 0) override
+    {
+        // the lock only guards the distribution against a concurrent update()
+        std::unique_lock<std::mutex> lock(_lock);
+        if(single_value())
+            return _values[0];
+        return map(philox::at(batch.key, batch.epoch, batch.first_sample + idx, draw_idx));
+    }
+    void generate(T* values, size_t count, const RandomBatch& batch) override
+    {
+        std::unique_lock<std::mutex> lock(_lock);
+        for(size_t i = 0; i < count; i++)
+            values[i] = single_value() ? _values[0] : map(philox::at(batch.key, batch.epoch, batch.first_sample + i, 0));
+    }
     T get() override
     {
         return _updated_val;
@@ -196,6 +213,21 @@ private:
     std::vector<double> _comltv_dist;//!< commulative probabilities
     double _mean;
     T _updated_val;
-    std::mt19937 _generator;
+    const philox::Key _key; //!< Only keys the renew() sequence, the pipelines draw with their own key
+    std::atomic<uint64_t> _draw_count { 0 };
     std::mutex _lock;
+    static constexpr uint32_t RENEW_EPOCH = 0xFFFFFFFF;
+    T map(uint32_t val) const
+    {
+        // Generate a value between [0 1)
+        double rand_val = philox::to_unit(val);
+
+        // Find the iterators pointing to the first element bigger than idx
+        auto it = std::upper_bound(_comltv_dist.begin(), _comltv_dist.end(), rand_val);
+
+        // Get the index and return the associated value, the last one when rounding left the sum slightly under 1.0
+        unsigned idx = std::min((size_t)std::distance(_comltv_dist.begin(), it), _values.size() - 1);
+
+        return _values[idx];
+    }
 };
\ No newline at end of file
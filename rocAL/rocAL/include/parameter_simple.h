@@ -21,6 +21,8 @@ THE SOFTWARE.
 */
 
 #pragma once
+#include <algorithm>
+#include <memory>
 #include "parameter.h"
 
 template <typename T>
@@ -39,6 +41,10 @@ public:
     {
         return _val;
     }
+    void generate(T* values, size_t count, const RandomBatch& batch) override
+    {
+        std::fill(values, values + count, _val);
+    }
     int update(T new_val)
     {
         _val = new_val;
@@ -25,6 +25,7 @@ THE SOFTWARE.
 #include <VX/vx_compatibility.h>
 #include <vector>
 #include "parameter_factory.h"
+#include "graph.h"
 
 template<typename T>
 class ParameterVX
@@ -58,6 +59,7 @@ public:
     void create_array(std::shared_ptr<Graph> graph, vx_enum data_type, unsigned batch_size)
     {
         // _arrVal = (T*)malloc(sizeof(T) * _batch_size);
+        _graph = graph;
         _batch_size = batch_size;
         _arrVal.resize(_batch_size);
         _array = vxCreateArray(vxGetContext((vx_reference)graph->get()), data_type,_batch_size);
@@ -107,23 +109,26 @@ public:
             WRN("Updating vx scalar failed")
 
     }
+    //! Draws the values of the current batch of the pipeline, also used without the vx array by the nodes that are fused into another node
+    /// The id of this user of _param is given on the first draw, in the order the nodes of the pipeline are created,
+    /// so a fused graph sees the same values as the unfused one
+    const std::vector<T>& next_batch_values(PipelineRandom& random, unsigned batch_size)
+    {
+        if(_param_id == NO_PARAM_ID)
+            _param_id = random.create_param_id();
+        _batch_size = batch_size;
+        _arrVal.resize(_batch_size);
+        _param->generate(_arrVal.data(), _batch_size, random.batch(_param_id, _batch_size));
+        return _arrVal;
+    }
     void update_array( )
     {
         vx_status status;
-        for (uint i=0; i < _batch_size ; i++ )
-        {
-            _arrVal[i] = renew();
-            //INFO("update_array: " + TOSTR(i) + "," + TOSTR(_arrVal[i]));
-        }
+        next_batch_values(_graph->random(), _batch_size);
         status = vxCopyArrayRange((vx_array)_array, 0, _batch_size, sizeof(T), _arrVal.data(), VX_WRITE_ONLY, VX_MEMORY_TYPE_HOST);
         if(status != 0)
             THROW(" vxCopyArrayRange failed in update_array (ParameterVX): "+ TOSTR(status))
     }
-    T renew()
-    {
-        _param->renew();
-        return _param->get();
-    }
 private:
     vx_scalar _scalar;
     vx_array _array;
@@ -131,6 +136,9 @@ private:
     T _val;
     std::vector<T> _arrVal;
     unsigned _batch_size;
+    std::shared_ptr<Graph> _graph;
+    static constexpr uint32_t NO_PARAM_ID = 0xFFFFFFFF;
+    uint32_t _param_id = NO_PARAM_ID;
     unsigned OVX_PARAM_IDX;
     const T _DEFAULT_RANGE_START;
     const T _DEFAULT_RANGE_END;
@@ -0,0 +1,75 @@
+/*
+Copyright (c) 2019 - 2022 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#pragma once
+#include <cstdint>
+#include <cstddef>
+
+/*! \brief Philox4x32-10 counter based random number generator (Salmon et al., "Parallel Random Numbers: As Easy as 1, 2, 3")
+ *
+ * Every output is a pure function of a 128 bit counter and a 64 bit key, so a value can be drawn for any
+ * (epoch, sample) position directly, by any thread and in any order, and still be reproducible.
+ * The random parameters use the key for (pipeline seed, parameter id) and the counter for (sample index, epoch, draw index).
+ */
+namespace philox
+{
+    struct Key
+    {
+        uint32_t k0, k1;
+    };
+
+    inline void philox4x32_10(const uint32_t ctr[4], Key key, uint32_t out[4])
+    {
+        const uint32_t M0 = 0xD2511F53, M1 = 0xCD9E8D57;
+        const uint32_t W0 = 0x9E3779B9, W1 = 0xBB67AE85;
+        uint32_t c0 = ctr[0], c1 = ctr[1], c2 = ctr[2], c3 = ctr[3];
+        uint32_t k0 = key.k0, k1 = key.k1;
+        for (int round = 0; round < 10; round++)
+        {
+            const uint64_t p0 = (uint64_t)M0 * c0;
+            const uint64_t p1 = (uint64_t)M1 * c2;
+            c0 = (uint32_t)(p1 >> 32) ^ c1 ^ k0;
+            c1 = (uint32_t)p1;
+            c2 = (uint32_t)(p0 >> 32) ^ c3 ^ k1;
+            c3 = (uint32_t)p0;
+            k0 += W0;
+            k1 += W1;
+        }
+        out[0] = c0; out[1] = c1; out[2] = c2; out[3] = c3;
+    }
+
+    //! Returns the random word of a draw for a sample, the counter is (sample index, epoch, draw index / 4)
+    /// Draws for different samples don't depend on each other, they can be taken in any order and by any thread
+    inline uint32_t at(Key key, uint32_t epoch, uint64_t sample, uint32_t draw)
+    {
+        const uint32_t ctr[4] = { (uint32_t)sample, (uint32_t)(sample >> 32), epoch, draw / 4 };
+        uint32_t words[4];
+        philox4x32_10(ctr, key, words);
+        return words[draw % 4];
+    }
+
+    //! Maps a random word to [0, 1)
+    inline double to_unit(uint32_t word)
+    {
+        return (double)word * (1.0 / 4294967296.0);
+    }
+}
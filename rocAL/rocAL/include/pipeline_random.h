@@ -0,0 +1,61 @@
+/*
+Copyright (c) 2019 - 2022 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "parameter.h"
+
+/*! \brief Position of a pipeline in the counter based generator of the augmentation parameters
+ *
+ * The values of a batch are keyed on (pipeline seed, parameter id) and counted by (epoch, sample index), where the
+ * parameter ids are given in the order the nodes of the pipeline are created. They don't depend on the other pipelines
+ * of the process, so two pipelines built the same way with the same seed get the same values, whatever their creation order.
+ */
+class PipelineRandom
+{
+public:
+    explicit PipelineRandom(unsigned seed = 0): _seed(seed) {}
+    //! Returns the id of a new user of the parameters of the pipeline
+    uint32_t create_param_id() { return _next_param_id++; }
+    //! Moves to the next batch of the epoch
+    void new_batch() { _batch = _next_batch++; }
+    //! Moves to the next epoch, sample indices start again from 0
+    void new_epoch()
+    {
+        _epoch++;
+        _batch = _next_batch = 0;
+    }
+    //! Returns the position of the current batch for the user with the given id
+    RandomBatch batch(uint32_t param_id, size_t batch_size) const
+    {
+        return { { _seed, param_id }, _epoch, _batch * batch_size };
+    }
+    unsigned seed() const { return _seed; }
+    uint32_t epoch() const { return _epoch; }
+private:
+    const unsigned _seed;
+    uint32_t _next_param_id = 0;
+    uint32_t _epoch = 0;
+    uint64_t _batch = 0;
+    uint64_t _next_batch = 0;
+};
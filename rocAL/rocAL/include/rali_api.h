@@ -41,6 +41,31 @@ THE SOFTWARE.
 extern "C"  RaliContext  RALI_API_CALL raliCreate(size_t batch_size, RaliProcessMode affinity, int gpu_id = 0, size_t cpu_thread_count = 1, size_t prefetch_queue_depth = 3, RaliTensorOutputType output_tensor_data_type = RaliTensorOutputType::RALI_FP32);
 //extern "C"  RaliContext  RALI_API_CALL raliCreate(size_t batch_size, RaliProcessMode affinity, int gpu_id = 0, size_t cpu_thread_count = 1);
 
+/// Merges chains of per pixel augmentations (brightness, gamma, exposure, hue, saturation, color twist) into a single node
+/// that reads and writes each image once. Only applies to CPU pipelines, must be called before raliVerify.
+/// The fused kernel rounds differently from the individual RPP kernels, so outputs can differ slightly, it is off by default.
+/// \param context
+/// \param enable
+/// \return
+extern "C"  RaliStatus RALI_API_CALL raliSetPointwiseFusion(RaliContext context, bool enable);
+
+/// Keeps the decoded images of the image loader between epochs, so that from the second epoch on they are neither read nor decoded.
+/// Images are evicted in least recently used order once the memory budget is used up, and are then written to the spill file if one is given.
+/// Not used with random bbox crop or when the decoder crops the images. Must be called before the image source is created.
+/// \param context
+/// \param memory_budget_mb Memory used by the cache in MB, split evenly between the shards of the loader
+/// \param spill_path File the evicted images are written to, nullptr or an empty string keeps the cache in memory only
+/// \return
+/// Sets how the file readers of the image sources access the storage. Must be called before the image source is created.
+/// \param context
+/// \param readahead_count Number of upcoming files of the (shuffled) file list the reader asks the kernel to read in the background, 0 disables the hints
+/// \param mode RALI_FILE_READ_BUFFERED reads through the page cache, RALI_FILE_READ_DROP_CACHE drops the pages of each file once it's read,
+/// RALI_FILE_READ_DIRECT bypasses the page cache with O_DIRECT (the readahead hints are then not used)
+/// \return
+extern "C"  RaliStatus RALI_API_CALL raliSetFileReadOptions(RaliContext context, unsigned readahead_count, RaliFileReadMode mode = RALI_FILE_READ_BUFFERED);
+
+extern "C"  RaliStatus RALI_API_CALL raliSetDecodedImageCache(RaliContext context, size_t memory_budget_mb, const char* spill_path = nullptr);
+
 ///
 /// \param context
 /// \return
@@ -38,5 +38,35 @@ extern "C"  RaliStatus   RALI_API_CALL raliCopyToOutputTensor(RaliContext rali_c
                                                               float offset1, float offset2,
                                                               bool reverse_channels);
 
+/*! \brief Makes the pipeline feed other processes through a POSIX shared memory ring named name, call after raliVerify
+ * The producer decodes and augments once, any number of trainer processes up to max_consumers attach to the ring
+ * with raliAttachSharedMemory(). Each slot holds one batch, slot_count bounds how far ahead the producer runs.
+*/
+extern "C"  RaliStatus   RALI_API_CALL raliCreateSharedMemoryOutput(RaliContext context, const char* name, unsigned slot_count, unsigned max_consumers);
+
+/*! \brief Copies the batch of the last raliRun() call and its labels to the shared memory ring
+ * Blocks while no consumer is attached or while the consumers have not released the slot's previous batch yet.
+*/
+extern "C"  RaliStatus   RALI_API_CALL raliPublishToSharedMemory(RaliContext context);
+
+/*! \brief Attaches to the shared memory ring of a producer process, returns NULL on failure
+ * The consumer reads the batches whose sequence % num_shards == shard_id, starting with the next batch published.
+ * The slots it holds are reclaimed by the producer if the consumer process dies.
+*/
+extern "C"  RaliSharedMemoryConsumer   RALI_API_CALL raliAttachSharedMemory(const char* name, unsigned shard_id, unsigned num_shards);
+
+/*! \brief Waits up to timeout_ms (negative: no limit) for the next batch of the consumer's shard
+ * Releases the previously acquired batch if it was not released yet. Returns RALI_NO_MORE_DATA once the producer
+ * has released its pipeline (or died) and all of its published batches were read, RALI_TIMEOUT if nothing came in time.
+*/
+extern "C"  RaliStatus   RALI_API_CALL raliAcquireSharedMemoryBatch(RaliSharedMemoryConsumer consumer, RaliSharedMemoryBatch* batch, int timeout_ms);
+
+/*! \brief Hands the last acquired batch back to the producer, its pointers must not be used afterwards
+*/
+extern "C"  RaliStatus   RALI_API_CALL raliReleaseSharedMemoryBatch(RaliSharedMemoryConsumer consumer);
+
+/*! \brief Detaches from the shared memory ring and frees the consumer
+*/
+extern "C"  RaliStatus   RALI_API_CALL raliDetachSharedMemory(RaliSharedMemoryConsumer consumer);
 
 #endif //MIVISIONX_RALI_API_DATA_TRANSFER_H
@@ -85,4 +85,10 @@ extern "C" const char* RALI_API_CALL raliGetErrorMessage(RaliContext rali_contex
 /// \return The timing info associated with recent execution.
 extern "C" TimingInfo RALI_API_CALL raliGetTimingInfo(RaliContext rali_context);
 
+///
+/// \param rali_context
+/// \return The average number of frames the video decoders decoded per frame output by the video loader, 1.0 when no frame is
+/// decoded twice or only to reach a seek target. Returns 0 for non video pipelines or before the first frame is output.
+extern "C" float RALI_API_CALL raliGetVideoDecodedFramesPerOutputFrame(RaliContext rali_context);
+
 #endif //MIVISIONX_RALI_API_INFO_H
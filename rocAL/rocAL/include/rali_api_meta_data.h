@@ -170,8 +170,9 @@ extern "C" void RALI_API_CALL raliGetSequenceFrameTimestamps(RaliContext rali_co
 /// \param means [x y w h] mean values for normalization.
 /// \param stds [x y w h] standard deviations for offset normalization.
 /// \param scale Rescales the box and anchor values before the offset is calculated (for example, to return to the absolute values).
+/// \param pipelined Encodes the boxes of each batch on a separate thread while the graph processes its images, instead of after the graph.
 extern "C" void RALI_API_CALL raliBoxEncoder(RaliContext p_context, std::vector<float> &anchors, float criteria,
-                                             std::vector<float>  &means , std::vector<float>  &stds ,  bool offset = false, float scale = 1.0);
+                                             std::vector<float>  &means , std::vector<float>  &stds ,  bool offset = false, float scale = 1.0, bool pipelined = false);
 
 /// \param boxes_buf  user's buffer that will be filled with encoded bounding boxes . Its needs to be at least of size batch_size.
 /// \param labels_buf  user's buffer that will be filled with encoded labels . Its needs to be at least of size batch_size.
@@ -25,7 +25,7 @@ THE SOFTWARE.
 #include "rali_api_types.h"
 
 ///
-/// \param seed
+/// \param seed The seed of the augmentation parameters of the pipelines built after this call
 extern "C"  void RALI_API_CALL raliSetSeed( unsigned seed);
 
 ///
@@ -41,6 +41,7 @@ typedef void * RaliIntParam;
 typedef void * RaliContext;
 typedef void * RaliImage;
 typedef void * RaliMetaData;
+typedef void * RaliSharedMemoryConsumer;
 
 typedef std::vector<int> ImageIDBatch,AnnotationIDBatch;
 typedef std::vector<std::string> ImagePathBatch;
@@ -54,6 +55,21 @@ struct TimingInfo
     long long unsigned decode_time;
     long long unsigned process_time;
     long long unsigned transfer_time;
+    float cache_hit_rate; //!< Fraction of the images served by the decoded image cache, 0 when it's not enabled
+};
+
+//! A batch read from the shared memory ring of a producer pipeline, the pointers are valid until the batch is released
+struct RaliSharedMemoryBatch
+{
+    unsigned long long sequence;//!< Batch number in the producer's output
+    const unsigned char* images;//!< output_count augmented outputs, each batch_size images of width x height/batch_size x channels
+    const int* labels;
+    unsigned label_count;
+    unsigned width;
+    unsigned height;//!< Height of the batch_size images stacked on top of each other
+    unsigned channels;
+    unsigned batch_size;
+    unsigned output_count;
 };
 
 //HRNet training expects meta data (joints_data) in below format, so added here as a type for exposing to user
@@ -76,7 +92,9 @@ enum RaliStatus
     RALI_CONTEXT_INVALID,
     RALI_RUNTIME_ERROR,
     RALI_UPDATE_PARAMETER_FAILED,
-    RALI_INVALID_PARAMETER_TYPE
+    RALI_INVALID_PARAMETER_TYPE,
+    RALI_NO_MORE_DATA,
+    RALI_TIMEOUT
 };
 
 
@@ -135,5 +153,12 @@ enum RaliDecoderType
     RALI_DECODER_VIDEO_FFMPEG_HW = 3
 };
 
+enum RaliFileReadMode
+{
+    RALI_FILE_READ_BUFFERED = 0,
+    RALI_FILE_READ_DROP_CACHE = 1,
+    RALI_FILE_READ_DIRECT = 2
+};
+
 
 #endif //MIVISIONX_RALI_API_TYPES_H
@@ -44,6 +44,14 @@ enum class StorageType
     MXNET_RECORDIO = 7,
 };
 
+//! How the file readers access the storage
+enum class FileReadMode
+{
+    BUFFERED = 0,   //!< Through the page cache
+    DROP_CACHE,     //!< Through the page cache, the pages of a file are dropped once it's read so that the dataset does not evict other data
+    DIRECT          //!< O_DIRECT reads into aligned buffers, bypassing the page cache
+};
+
 struct ReaderConfig
 {
     explicit ReaderConfig(StorageType type, std::string path = "", std::string json_path = "",
@@ -78,6 +86,11 @@ struct ReaderConfig
     void set_file_prefix(const std::string &prefix) { _file_prefix = prefix; }
     std::string file_prefix() { return _file_prefix; }
     std::shared_ptr<MetaDataReader> meta_data_reader() { return _meta_data_reader; }
+    /// \param readahead_count number of upcoming files the reader asks the kernel to start reading, 0 disables the hints
+    void set_readahead_count(size_t readahead_count) { _readahead_count = readahead_count; }
+    void set_file_read_mode(FileReadMode mode) { _file_read_mode = mode; }
+    size_t readahead_count() { return _readahead_count; }
+    FileReadMode file_read_mode() { return _file_read_mode; }
 private:
     StorageType _type = StorageType::FILE_SYSTEM;
     std::string _path = "";
@@ -93,6 +106,8 @@ private:
     bool _loop = false;
     std::string _file_prefix = ""; //!< to read only files with prefix. supported only for cifar10_data_reader and tf_record_reader
     std::shared_ptr<MetaDataReader> _meta_data_reader = nullptr;
+    size_t _readahead_count = 0; //!< supported only for file_source_reader
+    FileReadMode _file_read_mode = FileReadMode::BUFFERED; //!< supported only for file_source_reader
 };
 
 // MXNet image recordio struct - used to read the contents from the MXNet recordIO files.
@@ -136,6 +151,9 @@ public:
     //! Copies the data of the opened item to the buf
     virtual size_t read_data(unsigned char *buf, size_t read_size) = 0;
 
+    //! Moves past the opened item without copying its data, used when the item is served from the decoded image cache
+    virtual void skip_data() {}
+
     //! Closes the opened item
     virtual int close() = 0;
 
@@ -23,15 +23,14 @@ THE SOFTWARE.
 #pragma once
 #include "commons.h"
 #include <vector>
-#include <condition_variable>
 #if !ENABLE_HIP
 #include <CL/cl.h>
 #endif
-#include <queue>
 #include "meta_data.h"
 #include "device_manager.h"
 #include "commons.h"
 #include "device_manager_hip.h"
+#include "ring_buffer_index.h"
 
 using MetaDataNamePair = std::pair<ImageNameBatch,pMetaDataBatch>;
 class RingBuffer
@@ -67,30 +66,20 @@ public:
     void block_if_full();
     void release_if_empty();
 private:
-    std::queue<MetaDataNamePair> _meta_ring_buffer;
-    MetaDataNamePair _last_image_meta_data;
-    void increment_read_ptr();
-    void increment_write_ptr();
     bool full();
     const unsigned BUFF_DEPTH;
+    RingBufferIndex _index;//!< Lock-free read/write positions shared by the output routine (producer) and the user thread (consumer)
+    std::vector<MetaDataNamePair> _meta_data;//!< One metadata slot per image slot, owned by the same side as the image slot
     unsigned _sub_buffer_size;
     unsigned _sub_buffer_count;
-    std::mutex _lock;
-    std::condition_variable _wait_for_load;
-    std::condition_variable _wait_for_unload;
     std::vector<std::vector<void*>> _dev_sub_buffer;
     std::vector<void*> _host_master_buffers;
     std::vector<std::vector<void*>> _host_sub_buffers;
-    bool _dont_block = false;
     RaliMemType _mem_type;
 #if ENABLE_HIP
     DeviceResourcesHip _devhip;
 #else
     DeviceResources _dev;
 #endif
-    size_t _write_ptr;
-    size_t _read_ptr;
-    size_t _level;
-    std::mutex  _names_buff_lock;
     const size_t MEM_ALIGNMENT = 256;
 };
@@ -0,0 +1,125 @@
+/*
+Copyright (c) 2019 - 2022 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <climits>
+#include <unistd.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+/*! \brief Lock-free single-producer/single-consumer index pair for the RingBuffer and the CircularBuffer
+ *
+ * The producer owns the write counter and the consumer owns the read counter; each lives on its own cache line
+ * so that a push and a pop running concurrently don't bounce the same line. The slot indices are derived from
+ * the counters, so slot contents (image buffers and their metadata) need no further locking: a slot belongs to the
+ * producer until push() publishes it and to the consumer until pop() releases it.
+ *
+ * Blocking only happens on the empty/full transitions, using a futex on a per-side event word. The other side only
+ * issues the wake-up syscall when it sees that a waiter is parked, so steady-state handoffs don't enter the kernel.
+ */
+class RingBufferIndex
+{
+public:
+    explicit RingBufferIndex(size_t depth = 0): _depth(depth) { reset(); }
+    //! Not thread safe, for buffers whose depth is only known at init time
+    void set_depth(size_t depth) { _depth = depth; reset(); }
+    size_t depth() const { return _depth; }
+    size_t level() const { return _write_count.load(std::memory_order_acquire) - _read_count.load(std::memory_order_acquire); }
+    bool empty() const { return level() == 0; }
+    // Write the whole buffer except for the last spot which is being read by the reader thread
+    bool full() const { return level() >= _depth - 1; }
+    size_t read_index() const { return _read_count.load(std::memory_order_relaxed) % _depth; }
+    size_t write_index() const { return _write_count.load(std::memory_order_relaxed) % _depth; }
+    //! Called by the producer once the slot at write_index() is filled, publishes it to the consumer
+    void push()
+    {
+        _write_count.fetch_add(1, std::memory_order_seq_cst);
+        if(_reader_waiting.load(std::memory_order_seq_cst))
+            unblock_reader();
+    }
+    //! Called by the consumer once it's done with the slot at read_index(), hands it back to the producer
+    void pop()
+    {
+        _read_count.fetch_add(1, std::memory_order_seq_cst);
+        if(_writer_waiting.load(std::memory_order_seq_cst))
+            unblock_writer();
+    }
+    //! Blocks the consumer while the buffer is empty, returns early if unblock_reader() is called
+    void block_if_empty() { block_while(_reader_event, _reader_waiting, [this] { return empty(); }); }
+    //! Blocks the producer while the buffer is full, returns early if unblock_writer() is called
+    void block_if_full() { block_while(_writer_event, _writer_waiting, [this] { return full(); }); }
+    void unblock_reader() { wake(_reader_event); }
+    void unblock_writer() { wake(_writer_event); }
+    //! Wakes up both sides and makes any further block_if_xxx() call return right away until reset() is called
+    void release_all_blocked_calls()
+    {
+        _dont_block.store(true, std::memory_order_seq_cst);
+        unblock_reader();
+        unblock_writer();
+    }
+    //! Not thread safe, both sides must be idle
+    void reset()
+    {
+        _write_count.store(0);
+        _read_count.store(0);
+        _reader_waiting.store(0);
+        _writer_waiting.store(0);
+        _dont_block.store(false);
+    }
+private:
+    static constexpr size_t CACHE_LINE_SIZE = 64;
+    template <typename Condition>
+    void block_while(std::atomic<uint32_t> &event, std::atomic<uint32_t> &waiting, Condition condition)
+    {
+        if(_dont_block.load(std::memory_order_seq_cst) || !condition())
+            return;
+        // The event word is sampled before announcing the waiter, so any push/pop or unblock call after this point
+        // changes it and either makes the futex wait return right away or wakes it up
+        uint32_t last_event = event.load(std::memory_order_seq_cst);
+        waiting.store(1, std::memory_order_seq_cst);
+        while(!_dont_block.load(std::memory_order_seq_cst) && condition() && event.load(std::memory_order_seq_cst) == last_event)
+            syscall(SYS_futex, reinterpret_cast<uint32_t *>(&event), FUTEX_WAIT_PRIVATE, last_event, nullptr, nullptr, 0);
+        waiting.store(0, std::memory_order_seq_cst);
+    }
+    static void wake(std::atomic<uint32_t> &event)
+    {
+        event.fetch_add(1, std::memory_order_seq_cst);
+        syscall(SYS_futex, reinterpret_cast<uint32_t *>(&event), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+    }
+    size_t _depth;
+    std::atomic<bool> _dont_block;
+    // Each group below is written by a different party and is kept on its own cache line
+    char _pad0[CACHE_LINE_SIZE];
+    std::atomic<size_t> _write_count; // written by the producer on push
+    char _pad1[CACHE_LINE_SIZE];
+    std::atomic<size_t> _read_count; // written by the consumer on pop
+    char _pad2[CACHE_LINE_SIZE];
+    std::atomic<uint32_t> _reader_event { 0 }; // futex word the consumer blocks on when empty
+    std::atomic<uint32_t> _reader_waiting;
+    char _pad3[CACHE_LINE_SIZE];
+    std::atomic<uint32_t> _writer_event { 0 }; // futex word the producer blocks on when full
+    std::atomic<uint32_t> _writer_waiting;
+    char _pad4[CACHE_LINE_SIZE];
+};
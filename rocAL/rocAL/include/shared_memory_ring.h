@@ -0,0 +1,109 @@
+/*
+Copyright (c) 2019 - 2022 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <sys/types.h>
+
+/*! \brief POSIX shared memory ring that hands the batches of one rocAL producer process to several consumer processes
+ *
+ * The producer publishes batch number n (the sequence) in slot n % slot_count. Consumers attach by name with a
+ * (shard_id, num_shards) pair and read the sequences where n % num_shards == shard_id, so decoding and augmentation
+ * happen once for all of them. Consumers of the same shard all see the same batches.
+ *
+ * A slot is only overwritten once every attached consumer it belongs to has released it, which is what throttles the
+ * producer. Each side blocks on a futex word in the segment with a timeout; on every timeout the producer drops the
+ * consumers whose process is gone and the consumers check that the producer is still alive, so a crashed process
+ * never holds a slot for good.
+ */
+class SharedMemoryRing
+{
+public:
+    struct Geometry
+    {
+        uint32_t width;
+        uint32_t height;//!< Height of all the images of the batch stacked on top of each other
+        uint32_t channels;
+        uint32_t batch_size;
+        uint32_t output_count;//!< Number of augmentation branches, stored one after the other in a slot
+        uint32_t label_capacity;//!< Largest number of labels a slot holds
+        uint64_t image_bytes;//!< Size of all the image data of a slot
+    };
+    struct Batch
+    {
+        uint64_t sequence;
+        const unsigned char* images;
+        const int* labels;
+        uint32_t label_count;
+    };
+    enum class Status { OK = 0, TIMEOUT, END_OF_DATA };
+
+    ~SharedMemoryRing();
+    //! Creates the segment, replacing any stale one left with the same name
+    static SharedMemoryRing* create(const std::string& name, const Geometry& geometry, unsigned slot_count, unsigned max_consumers);
+    //! Attaches to an existing segment as a consumer of one shard
+    static SharedMemoryRing* attach(const std::string& name, unsigned shard_id, unsigned num_shards);
+    const Geometry& geometry() const;
+
+    // Producer side
+    //! Blocks until the next slot is free and at least one consumer is attached, returns the image area of the slot
+    unsigned char* acquire_write_slot();
+    //! Label area of the slot returned by acquire_write_slot(), label_capacity entries
+    int* write_labels();
+    //! Publishes the slot returned by acquire_write_slot()
+    void commit(uint32_t label_count);
+    //! Tells the consumers no more batches will come, they drain what is left and get END_OF_DATA
+    void close();
+
+    // Consumer side
+    //! Waits up to timeout_ms (negative: forever) for the next batch of this consumer's shard
+    Status acquire_read_slot(Batch& batch, int timeout_ms);
+    //! Hands the batch returned by the last acquire_read_slot() back to the producer
+    void release_read_slot();
+
+private:
+    struct Header;
+    struct ConsumerEntry;
+    struct SlotEntry;
+    SharedMemoryRing() = default;
+    void map(int fd, size_t size);
+    ConsumerEntry* consumers() const;
+    SlotEntry* slot(uint64_t sequence) const;
+    unsigned char* slot_data(uint64_t sequence) const;
+    bool slot_released(uint64_t sequence) const;
+    void reclaim_dead_consumers();
+    static bool process_alive(pid_t pid);
+    static void wait(std::atomic<uint32_t>& event, uint32_t last_event, int timeout_ms);
+    static void wake(std::atomic<uint32_t>& event);
+    std::string _name;
+    void* _base = nullptr;
+    size_t _size = 0;
+    Header* _header = nullptr;
+    bool _is_producer = false;
+    int _consumer_idx = -1;
+    uint64_t _read_sequence = 0;//!< Sequence held by this consumer between acquire_read_slot() and release_read_slot()
+    bool _holding = false;
+    uint64_t _write_sequence = 0;
+};
@@ -49,6 +49,8 @@ public:
      \return Size of the loaded resource
     */
     size_t read_data(unsigned char* buf, size_t max_size) override;
+    //! Moves to the next record without reading the opened one
+    void skip_data() override { incremenet_read_ptr(); }
     //! Opens the next file in the folder
     /*!
      \return The size of the next file, 0 if couldn't access it
@@ -98,14 +100,14 @@ private:
     size_t _in_batch_read_count = 0;
     bool _loop;
     bool _shuffle;
+    //! Reads each record with a new ifstream and a heap copy like the reader used to, set with RALI_TF_RECORD_STREAM_READ=1 to benchmark against the mapping
+    bool _stream_read;
     int _read_counter = 0;
     size_t  _file_count_all_shards;
     //!< _record_name_prefix tells the reader to read only files with the prefix
     std::string _record_name_prefix;
     // protobuf message objects
     tensorflow::Example _single_example;
-    tensorflow::Features _features;
-    tensorflow::Feature _single_feature;
     void incremenet_read_ptr();
     int release();
     size_t get_file_shard_id();
@@ -113,7 +115,16 @@ private:
     void replicate_last_image_to_fill_last_shard();
     void replicate_last_batch_to_pad_partial_shard();
     Reader::Status read_image(unsigned char* buff, std::string record_file_name, uint file_size);
-    Reader::Status read_image_names(std::ifstream &file_contents, uint file_size);
+    Reader::Status read_image_names(const char* file_contents, size_t file_size);
     std::map <std::string, uint> _image_record_starting;
+    //! Read-only memory mapping of a record file, opened once and kept for the lifetime of the reader
+    struct RecordFileMapping
+    {
+        const char* data = nullptr;
+        size_t size = 0;
+    };
+    std::map<std::string, RecordFileMapping> _record_files;
+    const RecordFileMapping& map_record_file(const std::string& record_file_name);
+    void unmap_record_files();
     TimingDBG _shuffle_time;
 };
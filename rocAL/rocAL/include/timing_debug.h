@@ -26,12 +26,14 @@ THE SOFTWARE.
 #include <chrono>
 #include <utility>
 #include "commons.h"
+#include "vx_ext_amd.h"
 
 
 #define DEFAULT_DBG_TIMING 1
 /*! \brief Debugging RaliDbgTiming class
 * 
 * Can be used anywhere in the code for adding RaliDbgTiming for debugging and profiling 
+* Every measured interval is also added to the OpenVX process trace when it is enabled (AGO_TRACE_FILE)
 */
 class TimingDBG {
 public:
@@ -72,6 +74,9 @@ public:
             _instantaneous_time = t_end - _t_start;
             _accumulated_time = _accumulated_time + _instantaneous_time;
             _count++;
+            vxAddTraceEvent(_name.c_str(), "rocAL",
+                            std::chrono::duration_cast<std::chrono::nanoseconds>(_t_start.time_since_epoch()).count(),
+                            std::chrono::duration_cast<std::chrono::nanoseconds>(t_end.time_since_epoch()).count());
         }
     }
 
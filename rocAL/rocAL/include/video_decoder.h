@@ -25,6 +25,7 @@ THE SOFTWARE.
 #include <cstddef>
 #include <iostream>
 #include <vector>
+#include <atomic>
 #ifdef RALI_VIDEO
 extern "C"
 {
@@ -83,5 +84,9 @@ public:
     virtual int seek_frame(AVRational avg_frame_rate, AVRational time_base, unsigned frame_number) = 0;
     virtual void release() = 0;
     virtual ~VideoDecoder() = default;
+    //! Number of frames received from the codec since the decoder was created, including the frames decoded only to reach a seek target
+    size_t decoded_frame_count() const { return _decoded_frame_count; }
+protected:
+    std::atomic<size_t> _decoded_frame_count { 0 };
 };
 #endif
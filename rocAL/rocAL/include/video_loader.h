@@ -24,6 +24,8 @@ THE SOFTWARE.
 
 #include <string>
 #include <thread>
+#include <mutex>
+#include <condition_variable>
 #include <vector>
 #include "commons.h"
 #include "circular_buffer.h"
@@ -70,6 +72,8 @@ private:
     std::vector<std::string> _output_names; //!< frame name/ids that are stored in the _output_image
     size_t _output_mem_size;
     bool _internal_thread_running;
+    std::mutex _idle_lock;
+    std::condition_variable _idle_cv;//!< Wakes up the load thread waiting at the end of the media when reset() or shut down stops it
     size_t _batch_size;
     size_t _sequence_count;
     size_t _sequence_length;
@@ -28,6 +28,11 @@ THE SOFTWARE.
 #include <cstring>
 #include <map>
 #include <tuple>
+#include <queue>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
 #include <boost/filesystem.hpp>
 #include "commons.h"
 #include "ffmpeg_video_decoder.h"
@@ -54,7 +59,8 @@ public:
         _video_process_count = (video_count <= _max_video_count) ? video_count : _max_video_count;
     }
     float convert_framenum_to_timestamp(size_t frame_number);
-    void decode_sequence(size_t sequence_index);
+    //! Decodes the sequences of a group, all from the same video
+    void decode_group(size_t group_index);
 
     //! Loads a decompressed batch of sequence of frames into the buffer indicated by buff
     /// \param buff User's buffer provided to be filled with decoded sequence samples
@@ -82,6 +88,11 @@ public:
     //! returns timing info or other status information
     Timing timing();
 private:
+    void start_decode_workers(size_t worker_count);
+    void stop_decode_workers();
+    void decode_worker();
+    //! Decodes the groups on the worker pool and the calling thread, returns once all are done
+    void decode_parallel(size_t group_count);
     struct video_map
     {
         int _video_map_idx;
@@ -100,6 +111,8 @@ private:
     std::vector<size_t> _sequence_start_frame_num;
     std::vector<std::string> _sequence_video_path;
     std::vector<int> _sequence_video_idx;
+    std::vector<std::vector<size_t>> _decode_groups; // sequence indices per video, sorted by start frame
+    std::atomic<size_t> _output_frame_count { 0 };
     TimingDBG _file_load_time, _decode_time;
     size_t _batch_size;
     size_t _sequence_count;
@@ -112,5 +125,13 @@ private:
     size_t _max_decoded_stride;
     AVPixelFormat _out_pix_fmt;
     VideoDecoderConfig _video_decoder_config;
+    // Long-lived decode workers, started once in create() instead of a new set of threads for every batch
+    std::vector<std::thread> _decode_workers;
+    std::mutex _decode_lock;
+    std::condition_variable _decode_cv;
+    std::condition_variable _decode_done_cv;
+    std::queue<size_t> _decode_queue;
+    size_t _pending_decodes = 0;
+    bool _stop_decode_workers = false;
 };
 #endif
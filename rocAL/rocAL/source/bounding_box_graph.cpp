@@ -19,6 +19,10 @@ LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
 OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
 THE SOFTWARE.
 */
+#include <cmath>
+#include <limits>
+#include <omp.h>
+#include <immintrin.h>
 #include "bounding_box_graph.h"
 
 void BoundingBoxGraph::process(MetaDataBatch *meta_data)
@@ -93,67 +97,147 @@ void BoundingBoxGraph::update_random_bbox_meta_data(MetaDataBatch *input_meta_da
     }
 }
 
-inline void calculate_ious_for_box(float *ious, BoundingBoxCord &box, BoundingBoxCord *anchors, unsigned int num_anchors)
-{
-    float box_area = (box.b - box.t) * (box.r - box.l);
-    ious[0] = ssd_BBoxIntersectionOverUnion(box, box_area, anchors[0]);
+// Anchors are processed in tiles of this many anchors for all the boxes of an image, so that the anchor coordinates
+// and their running best match stay in the L1 cache while the boxes are streamed over them
+#define BOX_ENCODER_ANCHOR_TILE 1024
+#define BOX_ENCODER_SIMD_WIDTH 8
 
-    int best_idx = 0;
-    float best_iou = ious[0];
-    for (unsigned int anchor_idx = 1; anchor_idx < num_anchors; anchor_idx++)
+void BoundingBoxGraph::update_anchors(const std::vector<float> &anchors)
+{
+    if (anchors == _anchors)
+        return;
+    _anchors = anchors;
+    _anchors_count = anchors.size() / 4; // divide the anchors_size by 4 to get the total number of anchors
+    _anchors_padded_count = (_anchors_count + BOX_ENCODER_SIMD_WIDTH - 1) & ~(BOX_ENCODER_SIMD_WIDTH - 1);
+    const float nan = std::numeric_limits<float>::quiet_NaN();
+    _anchors_l.assign(_anchors_padded_count, nan);
+    _anchors_t.assign(_anchors_padded_count, nan);
+    _anchors_r.assign(_anchors_padded_count, nan);
+    _anchors_b.assign(_anchors_padded_count, nan);
+    _anchors_area.assign(_anchors_padded_count, nan);
+    const BoundingBoxCord *bbox_anchors = reinterpret_cast<const BoundingBoxCord *>(anchors.data());
+    for (unsigned anchor_idx = 0; anchor_idx < _anchors_count; anchor_idx++)
     {
-        ious[anchor_idx] = ssd_BBoxIntersectionOverUnion(box, box_area, anchors[anchor_idx]);
-        if (ious[anchor_idx] > best_iou)
-        {
-            best_iou = ious[anchor_idx];
-            best_idx = anchor_idx;
-        }
+        _anchors_l[anchor_idx] = bbox_anchors[anchor_idx].l;
+        _anchors_t[anchor_idx] = bbox_anchors[anchor_idx].t;
+        _anchors_r[anchor_idx] = bbox_anchors[anchor_idx].r;
+        _anchors_b[anchor_idx] = bbox_anchors[anchor_idx].b;
+        _anchors_area[anchor_idx] = (bbox_anchors[anchor_idx].b - bbox_anchors[anchor_idx].t) * (bbox_anchors[anchor_idx].r - bbox_anchors[anchor_idx].l);
     }
-    // For best default box matched with current object let iou = 2, to make sure there is a match,
-    // as this object will be the best (highest IoU), for this default box
-    ious[best_idx] = 2.;
 }
 
-inline int find_best_box_for_anchor(unsigned anchor_idx, const std::vector<float> &ious, unsigned num_boxes, unsigned anchors_size)
+// Finds the best box of every anchor (ties go to the last box) and the best anchor of every box (ties go to the first anchor),
+// then lets every box claim its best anchor. This gives the same matches as computing the full boxes x anchors IoU matrix,
+// setting the IoU of each box with its best anchor to 2 and picking the best box of each anchor from the modified matrix.
+// The IoUs are computed with the same operations as ssd_BBoxIntersectionOverUnion() so the results are bit exact.
+void BoundingBoxGraph::match_boxes_to_anchors(BoxEncoderScratch &scratch, const BoundingBoxCord *bb_coords, unsigned bb_count)
 {
-    unsigned best_idx = 0;
-    float best_iou = ious[anchor_idx];
-    for (unsigned bbox_idx = 1; bbox_idx < num_boxes; ++bbox_idx)
+    scratch.anchor_best_iou.resize(_anchors_padded_count);
+    scratch.anchor_best_box.resize(_anchors_padded_count);
+    scratch.box_lane_iou.assign(bb_count * BOX_ENCODER_SIMD_WIDTH, -std::numeric_limits<float>::infinity());
+    scratch.box_lane_anchor.assign(bb_count * BOX_ENCODER_SIMD_WIDTH, -1);
+    scratch.box_best_anchor.resize(bb_count);
+    float *anchor_best_iou = scratch.anchor_best_iou.data();
+    int *anchor_best_box = scratch.anchor_best_box.data();
+    const __m256 zero = _mm256_setzero_ps();
+    const __m256i lane_offsets = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+    for (unsigned tile_start = 0; tile_start < _anchors_padded_count; tile_start += BOX_ENCODER_ANCHOR_TILE)
+    {
+        unsigned tile_end = std::min(tile_start + BOX_ENCODER_ANCHOR_TILE, _anchors_padded_count);
+        for (unsigned bb_idx = 0; bb_idx < bb_count; bb_idx++)
+        {
+            const BoundingBoxCord &box = bb_coords[bb_idx];
+            const __m256 box_l = _mm256_set1_ps(box.l), box_t = _mm256_set1_ps(box.t);
+            const __m256 box_r = _mm256_set1_ps(box.r), box_b = _mm256_set1_ps(box.b);
+            const __m256 box_area = _mm256_set1_ps((box.b - box.t) * (box.r - box.l));
+            const __m256i box_idx = _mm256_set1_epi32(bb_idx);
+            __m256 lane_best_iou = _mm256_loadu_ps(&scratch.box_lane_iou[bb_idx * BOX_ENCODER_SIMD_WIDTH]);
+            __m256i lane_best_anchor = _mm256_loadu_si256((const __m256i *)&scratch.box_lane_anchor[bb_idx * BOX_ENCODER_SIMD_WIDTH]);
+            for (unsigned anchor_idx = tile_start; anchor_idx < tile_end; anchor_idx += BOX_ENCODER_SIMD_WIDTH)
+            {
+                // operands are ordered so that max/min behave like std::max/std::min in ssd_BBoxIntersectionOverUnion()
+                __m256 xA = _mm256_max_ps(_mm256_loadu_ps(&_anchors_l[anchor_idx]), box_l);
+                __m256 yA = _mm256_max_ps(_mm256_loadu_ps(&_anchors_t[anchor_idx]), box_t);
+                __m256 xB = _mm256_min_ps(_mm256_loadu_ps(&_anchors_r[anchor_idx]), box_r);
+                __m256 yB = _mm256_min_ps(_mm256_loadu_ps(&_anchors_b[anchor_idx]), box_b);
+                __m256 intersection_area = _mm256_mul_ps(_mm256_max_ps(_mm256_sub_ps(xB, xA), zero), _mm256_max_ps(_mm256_sub_ps(yB, yA), zero));
+                __m256 union_area = _mm256_sub_ps(_mm256_add_ps(box_area, _mm256_loadu_ps(&_anchors_area[anchor_idx])), intersection_area);
+                __m256 iou = _mm256_div_ps(intersection_area, union_area);
+                // best anchor of the box, per lane
+                __m256 box_mask = _mm256_cmp_ps(iou, lane_best_iou, _CMP_GT_OQ);
+                lane_best_iou = _mm256_blendv_ps(lane_best_iou, iou, box_mask);
+                lane_best_anchor = _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(lane_best_anchor),
+                                                                        _mm256_castsi256_ps(_mm256_add_epi32(_mm256_set1_epi32(anchor_idx), lane_offsets)), box_mask));
+                // best box of the anchor
+                if (bb_idx == 0)
+                {
+                    _mm256_storeu_ps(&anchor_best_iou[anchor_idx], iou);
+                    _mm256_storeu_si256((__m256i *)&anchor_best_box[anchor_idx], _mm256_setzero_si256());
+                }
+                else
+                {
+                    __m256 best_iou = _mm256_loadu_ps(&anchor_best_iou[anchor_idx]);
+                    __m256 anchor_mask = _mm256_cmp_ps(iou, best_iou, _CMP_GE_OQ);
+                    _mm256_storeu_ps(&anchor_best_iou[anchor_idx], _mm256_blendv_ps(best_iou, iou, anchor_mask));
+                    __m256 best_box = _mm256_loadu_ps((const float *)&anchor_best_box[anchor_idx]);
+                    _mm256_storeu_ps((float *)&anchor_best_box[anchor_idx], _mm256_blendv_ps(best_box, _mm256_castsi256_ps(box_idx), anchor_mask));
+                }
+            }
+            _mm256_storeu_ps(&scratch.box_lane_iou[bb_idx * BOX_ENCODER_SIMD_WIDTH], lane_best_iou);
+            _mm256_storeu_si256((__m256i *)&scratch.box_lane_anchor[bb_idx * BOX_ENCODER_SIMD_WIDTH], lane_best_anchor);
+        }
+    }
+    for (unsigned bb_idx = 0; bb_idx < bb_count; bb_idx++)
     {
-        if (ious[bbox_idx * anchors_size + anchor_idx] >= best_iou)
+        // reduce the lanes keeping the lowest anchor index on ties, like a sequential scan with '>' starting from anchor 0
+        int best_idx = 0;
+        float box_area = (bb_coords[bb_idx].b - bb_coords[bb_idx].t) * (bb_coords[bb_idx].r - bb_coords[bb_idx].l);
+        float first_iou = ssd_BBoxIntersectionOverUnion(bb_coords[bb_idx], box_area, reinterpret_cast<const BoundingBoxCord *>(_anchors.data())[0]);
+        if (!std::isnan(first_iou))
         {
-            best_iou = ious[bbox_idx * anchors_size + anchor_idx];
-            best_idx = bbox_idx;
+            float best_iou = first_iou;
+            for (unsigned lane = 0; lane < BOX_ENCODER_SIMD_WIDTH; lane++)
+            {
+                float lane_iou = scratch.box_lane_iou[bb_idx * BOX_ENCODER_SIMD_WIDTH + lane];
+                int lane_anchor = scratch.box_lane_anchor[bb_idx * BOX_ENCODER_SIMD_WIDTH + lane];
+                if (lane_anchor >= 0 && (lane_iou > best_iou || (lane_iou == best_iou && lane_anchor < best_idx)))
+                {
+                    best_iou = lane_iou;
+                    best_idx = lane_anchor;
+                }
+            }
         }
+        scratch.box_best_anchor[bb_idx] = best_idx;
+    }
+    // For best default box matched with current object let iou = 2, to make sure there is a match,
+    // as this object will be the best (highest IoU), for this default box
+    for (unsigned bb_idx = 0; bb_idx < bb_count; bb_idx++)
+    {
+        anchor_best_iou[scratch.box_best_anchor[bb_idx]] = 2.;
+        anchor_best_box[scratch.box_best_anchor[bb_idx]] = bb_idx;
     }
-    return best_idx;
 }
 
 void BoundingBoxGraph::update_box_encoder_meta_data(std::vector<float> *anchors, pMetaDataBatch full_batch_meta_data, float criteria, bool offset, float scale, std::vector<float>& means, std::vector<float>& stds)
 {
+    update_anchors(*anchors);
+    if (_scratch_pool.size() < (size_t)omp_get_max_threads())
+        _scratch_pool.resize(omp_get_max_threads());
     #pragma omp parallel for 
     for (int i = 0; i < full_batch_meta_data->size(); i++)
     {
-        BoundingBoxCord *bbox_anchors = reinterpret_cast<BoundingBoxCord *>(anchors->data());
+        BoxEncoderScratch &scratch = _scratch_pool[omp_get_thread_num()];
+        BoundingBoxCord *bbox_anchors = reinterpret_cast<BoundingBoxCord *>(_anchors.data());
         auto bb_count = full_batch_meta_data->get_bb_labels_batch()[i].size();
-        BoundingBoxCord bb_coords[bb_count];
-        BoundingBoxLabels bb_labels;
-        bb_labels.resize(bb_count);
-        memcpy(bb_labels.data(), full_batch_meta_data->get_bb_labels_batch()[i].data(), sizeof(int) * bb_count);
-        memcpy(bb_coords, full_batch_meta_data->get_bb_cords_batch()[i].data(), full_batch_meta_data->get_bb_cords_batch()[i].size() * sizeof(BoundingBoxCord));
+        const BoundingBoxCord *bb_coords = full_batch_meta_data->get_bb_cords_batch()[i].data();
+        const BoundingBoxLabels &bb_labels = full_batch_meta_data->get_bb_labels_batch()[i];
         BoundingBoxCords_xcycwh encoded_bb;
         BoundingBoxLabels encoded_labels;
-        unsigned anchors_size = anchors->size() / 4; // divide the anchors_size by 4 to get the total number of anchors
-        //Calculate Ious
-        //ious size - bboxes count x anchors count
-        std::vector<float> ious(bb_count * anchors_size);
+        unsigned anchors_size = _anchors_count;
         encoded_bb.resize(anchors_size);
         encoded_labels.resize(anchors_size);
-        for (uint bb_idx = 0; bb_idx < bb_count; bb_idx++)
-        {
-            auto iou_rows = ious.data() + (bb_idx * (anchors_size));
-            calculate_ious_for_box(iou_rows, bb_coords[bb_idx], bbox_anchors, anchors_size);
-        }
+        if (bb_count > 0)
+            match_boxes_to_anchors(scratch, bb_coords, bb_count);
         float inv_stds[4] = {(float)(1./stds[0]), (float)(1./stds[1]), (float)(1./stds[2]), (float)(1./stds[3])};
         float half_scale = 0.5 * scale;
         // Depending on the matches ->place the best bbox instead of the corresponding anchor_idx in anchor
@@ -161,9 +245,9 @@ void BoundingBoxGraph::update_box_encoder_meta_data(std::vector<float> *anchors,
         {
             BoundingBoxCord_xcycwh box_bestidx, anchor_xcyxwh;
             BoundingBoxCord *p_anchor = &bbox_anchors[anchor_idx];
-            const auto best_idx = find_best_box_for_anchor(anchor_idx, ious, bb_count, anchors_size);
+            const auto best_idx = bb_count > 0 ? scratch.anchor_best_box[anchor_idx] : 0;
             // Filter matches by criteria
-            if (ious[(best_idx * anchors_size) + anchor_idx] > criteria) //Its a match
+            if (bb_count > 0 && scratch.anchor_best_iou[anchor_idx] > criteria) //Its a match
             {
                 //Convert the "ltrb" format to "xcycwh"
                 if (offset)
@@ -215,10 +299,8 @@ void BoundingBoxGraph::update_box_encoder_meta_data(std::vector<float> *anchors,
             }
         }
         BoundingBoxCords * encoded_bb_ltrb = (BoundingBoxCords*)&encoded_bb;
-        full_batch_meta_data->get_bb_cords_batch()[i] = (*encoded_bb_ltrb);
-        full_batch_meta_data->get_bb_labels_batch()[i] = encoded_labels;
-        //encoded_bb.clear();
-        //encoded_labels.clear();
+        full_batch_meta_data->get_bb_cords_batch()[i] = std::move(*encoded_bb_ltrb);
+        full_batch_meta_data->get_bb_labels_batch()[i] = std::move(encoded_labels);
     }
 }
 
@@ -65,7 +65,11 @@ void
 CIFAR10DataLoader::reset()
 {
     // stop the writer thread and empty the internal circular buffer
-    _internal_thread_running = false;
+    {
+        std::unique_lock<std::mutex> lock(_idle_lock);
+        _internal_thread_running = false;
+    }
+    _idle_cv.notify_all();
     _circ_buff.unblock_writer();
 
     if(_load_thread.joinable())
@@ -95,7 +99,11 @@ CIFAR10DataLoader::de_init()
 void
 CIFAR10DataLoader::stop_internal_thread()
 {
-    _internal_thread_running = false;
+    {
+        std::unique_lock<std::mutex> lock(_idle_lock);
+        _internal_thread_running = false;
+    }
+    _idle_cv.notify_all();
     _stopped = true;
     _circ_buff.unblock_reader();
     _circ_buff.unblock_writer();
@@ -179,6 +187,7 @@ LoaderModuleStatus
 CIFAR10DataLoader::load_routine()
 {
     LOG("Started the internal loader thread");
+    vxSetTraceThreadName("rocAL loader");
     LoaderModuleStatus last_load_status = LoaderModuleStatus::OK;
     // Initially record number of all the images that are going to be loaded, this is used to know how many still there
 
@@ -236,10 +245,11 @@ CIFAR10DataLoader::load_routine()
             // read semaphore using release() call
             // , and calls the release() allows the reader thread to wake up and handle
             // the out-of-data case properly
-            // It also slows down the reader thread since there is no more data to read,
-            // till program ends or till reset is called
+            // It also parks the reader thread since there is no more data to read,
+            // till program ends or till reset is called, both of them wake it up right away
             _circ_buff.unblock_reader();
-            std::this_thread::sleep_for(std::chrono::seconds(1));
+            std::unique_lock<std::mutex> lock(_idle_lock);
+            _idle_cv.wait_for(lock, std::chrono::seconds(1), [this] { return !_internal_thread_running; });
         }
     }
     return LoaderModuleStatus::OK;
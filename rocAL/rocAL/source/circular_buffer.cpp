@@ -26,10 +26,7 @@ THE SOFTWARE.
 CircularBuffer::CircularBuffer(DeviceResources ocl):
         _cl_cmdq(ocl.cmd_queue),
         _cl_context(ocl.context),
-        _device_id(ocl.device_id),
-        _write_ptr(0),
-        _read_ptr(0),
-        _level(0)
+        _device_id(ocl.device_id)
 {
 
 }
@@ -37,26 +34,14 @@ CircularBuffer::CircularBuffer(DeviceResources ocl):
 CircularBuffer::CircularBuffer(DeviceResourcesHip hipres):
         _hip_stream(hipres.hip_stream),
         _hip_device_id(hipres.device_id),
-        _hip_canMapHostMemory(hipres.dev_prop.canMapHostMemory),
-        _write_ptr(0),
-        _read_ptr(0),
-        _level(0)
+        _hip_canMapHostMemory(hipres.dev_prop.canMapHostMemory)
 {
 }
 #endif
 
 void CircularBuffer::reset()
 {
-    _write_ptr = 0;
-    _read_ptr = 0;
-    _level = 0;
-    while(!_circ_image_info.empty())
-        _circ_image_info.pop();
-    if (random_bbox_crop_flag == true) 
-    {
-        while(!_circ_crop_image_info.empty())
-        _circ_crop_image_info.pop();
-    }
+    _index.reset();
 }
 
 void CircularBuffer::unblock_reader()
@@ -64,7 +49,7 @@ void CircularBuffer::unblock_reader()
     if(!_initialized)
         return;
     // Wake up the reader thread in case it's waiting for a load
-    _wait_for_load.notify_one();
+    _index.unblock_reader();
 }
 
 void CircularBuffer::unblock_writer()
@@ -72,14 +57,14 @@ void CircularBuffer::unblock_writer()
     if(!_initialized)
         return;
     // Wake up the writer thread in case it's waiting for an unload
-    _wait_for_unload.notify_one();
+    _index.unblock_writer();
 }
 
 
 void* CircularBuffer::get_read_buffer_dev()
 {
     block_if_empty();
-    return _dev_buffer[_read_ptr];
+    return _dev_buffer[_index.read_index()];
 }
 
 unsigned char* CircularBuffer::get_read_buffer_host()
@@ -87,7 +72,7 @@ unsigned char* CircularBuffer::get_read_buffer_host()
     if(!_initialized)
         THROW("Circular buffer not initialized")
     block_if_empty();
-    return _host_buffer_ptrs[_read_ptr];
+    return _host_buffer_ptrs[_index.read_index()];
 }
 
 unsigned char*  CircularBuffer::get_write_buffer()
@@ -95,7 +80,7 @@ unsigned char*  CircularBuffer::get_write_buffer()
     if(!_initialized)
         THROW("Circular buffer not initialized")
     block_if_full();
-    return(_host_buffer_ptrs[_write_ptr]);
+    return(_host_buffer_ptrs[_index.write_index()]);
 }
 
 void CircularBuffer::sync()
@@ -107,7 +92,7 @@ void CircularBuffer::sync()
     if(_output_mem_type== RaliMemType::OCL)
     {
     #if 0
-        if(clEnqueueWriteBuffer(_cl_cmdq, _dev_sub_buffer[_write_ptr], CL_TRUE, 0, _output_mem_size, _host_buffer_ptrs[_write_ptr], 0, NULL, NULL) != CL_SUCCESS)
+        if(clEnqueueWriteBuffer(_cl_cmdq, _dev_sub_buffer[_index.write_index()], CL_TRUE, 0, _output_mem_size, _host_buffer_ptrs[_index.write_index()], 0, NULL, NULL) != CL_SUCCESS)
             THROW("clEnqueueMapBuffer of size "+ TOSTR(_output_mem_size) + " failed " + TOSTR(err));
 
     #else
@@ -115,9 +100,9 @@ void CircularBuffer::sync()
         // an unmap/map cen be done to make sure data is copied from the host to device, it's fast
         //NOTE: Using clEnqueueUnmapMemObject/clEnqueuenmapMemObject when buffer is allocated with
         // CL_MEM_ALLOC_HOST_PTR adds almost no overhead
-        clEnqueueUnmapMemObject(_cl_cmdq, (cl_mem)_dev_buffer[_write_ptr], _host_buffer_ptrs[_write_ptr], 0, NULL, NULL);
-        _host_buffer_ptrs[_write_ptr] = (unsigned char*) clEnqueueMapBuffer(_cl_cmdq,
-                                                                            (cl_mem)_dev_buffer[_write_ptr] ,
+        clEnqueueUnmapMemObject(_cl_cmdq, (cl_mem)_dev_buffer[_index.write_index()], _host_buffer_ptrs[_index.write_index()], 0, NULL, NULL);
+        _host_buffer_ptrs[_index.write_index()] = (unsigned char*) clEnqueueMapBuffer(_cl_cmdq,
+                                                                            (cl_mem)_dev_buffer[_index.write_index()] ,
                                                                             CL_FALSE,
                                                                             CL_MAP_WRITE,
                                                                             0,
@@ -132,7 +117,7 @@ void CircularBuffer::sync()
     else if (_output_mem_type== RaliMemType::HIP){
         // copy memory to host only if needed
         if (!_hip_canMapHostMemory) {
-            hipError_t err = hipMemcpy((void *)(_dev_buffer[_write_ptr]), _host_buffer_ptrs[_write_ptr], _output_mem_size, hipMemcpyHostToDevice);
+            hipError_t err = hipMemcpy((void *)(_dev_buffer[_index.write_index()]), _host_buffer_ptrs[_index.write_index()], _output_mem_size, hipMemcpyHostToDevice);
             if (err != hipSuccess) {
                 THROW("hipMemcpy of size "+ TOSTR(_output_mem_size) + " failed " + TOSTR(err));
             }
@@ -151,28 +136,23 @@ void CircularBuffer::push()
     if(!_initialized)
         return;
     sync();
-    // Pushing to the _circ_buff and _circ_buff_names must happen all at the same time
-    std::unique_lock<std::mutex> lock(_names_buff_lock);
-    _circ_image_info.push(_last_image_info);
-    if (random_bbox_crop_flag == true)
-      _circ_crop_image_info.push(_last_crop_image_info);
-    increment_write_ptr();
+    // The image info slots sit next to the image buffer, publishing the write index makes all of them visible at once
+    _index.push();
 }
 
 void CircularBuffer::pop()
 {
     if(!_initialized)
         return;
-    // Pushing to the _circ_buff and _circ_buff_names must happen all at the same time
-    std::unique_lock<std::mutex> lock(_names_buff_lock);
-    increment_read_ptr();
-    _circ_image_info.pop();
-    if (random_bbox_crop_flag == true) 
-        _circ_crop_image_info.pop();
+    // Releasing the read index hands the image buffer and its info slots back to the writer
+    _index.pop();
 }
 void CircularBuffer::init(RaliMemType output_mem_type, size_t output_mem_size, size_t buffer_depth)
 {
     _buff_depth = buffer_depth;
+    _index.set_depth(_buff_depth);
+    _circ_image_info.resize(_buff_depth);
+    _circ_crop_image_info.resize(_buff_depth);
     _dev_buffer.reserve(_buff_depth);
     _host_buffer_ptrs.reserve(_buff_depth);
     for(size_t bufIdx = 0; bufIdx < _buff_depth; bufIdx++)
@@ -296,9 +276,7 @@ void CircularBuffer::release()
 
     _dev_buffer.clear();
     _host_buffer_ptrs.clear();
-    _write_ptr = 0;
-    _read_ptr = 0;
-    _level = 0;
+    _index.reset();
 #if !ENABLE_HIP
     _cl_cmdq = 0;
     _cl_context = 0;
@@ -312,57 +290,29 @@ void CircularBuffer::release()
 
 bool CircularBuffer::empty()
 {
-    return (_level <= 0);
+    return _index.empty();
 }
 
 bool CircularBuffer::full()
 {
-    return (_level >= _buff_depth - 1);
+    return _index.full();
 }
 
 size_t CircularBuffer::level()
 {
-    return _level;
-}
-
-void CircularBuffer::increment_read_ptr()
-{
-    std::unique_lock<std::mutex> lock(_lock);
-    _read_ptr = (_read_ptr+1)%_buff_depth;
-    _level--;
-    lock.unlock();
-    // Wake up the writer thread (in case waiting) since there is an empty spot to write to,
-    _wait_for_unload.notify_all();
-
-}
-
-void CircularBuffer::increment_write_ptr()
-{
-    std::unique_lock<std::mutex> lock(_lock);
-    _write_ptr = (_write_ptr+1)%_buff_depth;
-    _level++;
-    lock.unlock();
-    // Wake up the reader thread (in case waiting) since there is a new load to be read
-    _wait_for_load.notify_all();
+    return _index.level();
 }
 
 void CircularBuffer::block_if_empty()
 {
-    std::unique_lock<std::mutex> lock(_lock);
-    if(empty())
-    { // if the current read buffer is being written wait on it
-        _wait_for_load.wait(lock);
-    }
+    // if the current read buffer is being written wait on it
+    _index.block_if_empty();
 }
 
 void CircularBuffer:: block_if_full()
 {
-    std::unique_lock<std::mutex> lock(_lock);
     // Write the whole buffer except for the last spot which is being read by the reader thread
-    if(full())
-    {
-        _wait_for_unload.wait(lock);
-    }
+    _index.block_if_full();
 }
 
 CircularBuffer::~CircularBuffer()
@@ -373,17 +323,15 @@ CircularBuffer::~CircularBuffer()
 decoded_image_info &CircularBuffer::get_image_info()
 {
     block_if_empty();
-    std::unique_lock<std::mutex> lock(_names_buff_lock);
-    if(_level != _circ_image_info.size())
-        THROW("CircularBuffer internals error, image and image info sizes not the same "+TOSTR(_level) + " != "+TOSTR(_circ_image_info.size()))
-    return  _circ_image_info.front();
+    if(empty())
+        THROW("CircularBuffer internals error, no image info available to read")
+    return  _circ_image_info[_index.read_index()];
 }
 
 crop_image_info &CircularBuffer::get_cropped_image_info()
 {
     block_if_empty();
-    std::unique_lock<std::mutex> lock(_names_buff_lock);
-    if(_level != _circ_crop_image_info.size())
-        THROW("CircularBuffer internals error, image and image info sizes not the same "+TOSTR(_level) + " != "+TOSTR(_circ_crop_image_info.size()))
-    return  _circ_crop_image_info.front();
+    if(empty())
+        THROW("CircularBuffer internals error, no crop image info available to read")
+    return  _circ_crop_image_info[_index.read_index()];
 }
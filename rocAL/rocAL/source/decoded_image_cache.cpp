@@ -0,0 +1,237 @@
+/*
+Copyright (c) 2019 - 2022 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include "commons.h"
+#include "decoded_image_cache.h"
+
+namespace
+{
+    size_t entry_cost(const std::string& id, const DecodedImageCache::Entry& entry)
+    {
+        return entry.pixels.size() + id.size() + sizeof(DecodedImageCache::Entry);
+    }
+
+    bool write_fully(int fd, const void* buf, size_t size, uint64_t offset)
+    {
+        auto ptr = static_cast<const unsigned char*>(buf);
+        while(size > 0)
+        {
+            ssize_t ret = pwrite(fd, ptr, size, offset);
+            if(ret < 0 && errno == EINTR)
+                continue;
+            if(ret <= 0)
+                return false;
+            ptr += ret;
+            size -= ret;
+            offset += ret;
+        }
+        return true;
+    }
+
+    bool read_fully(int fd, void* buf, size_t size, uint64_t offset)
+    {
+        auto ptr = static_cast<unsigned char*>(buf);
+        while(size > 0)
+        {
+            ssize_t ret = pread(fd, ptr, size, offset);
+            if(ret < 0 && errno == EINTR)
+                continue;
+            if(ret <= 0)
+                return false;
+            ptr += ret;
+            size -= ret;
+            offset += ret;
+        }
+        return true;
+    }
+}
+
+DecodedImageCache::DecodedImageCache(size_t memory_budget, const std::string& spill_path):
+    _memory_budget(memory_budget),
+    _spill_path(spill_path),
+    _hits(0),
+    _misses(0)
+{
+    if(_spill_path.empty())
+        return;
+    _spill_fd = ::open(_spill_path.c_str(), O_RDWR | O_CREAT | O_TRUNC | O_CLOEXEC, 0600);
+    if(_spill_fd < 0)
+        THROW("Cannot create the decoded image cache spill file " + _spill_path + ": " + strerror(errno))
+}
+
+DecodedImageCache::~DecodedImageCache()
+{
+    if(_spill_fd < 0)
+        return;
+    ::close(_spill_fd);
+    unlink(_spill_path.c_str());
+}
+
+std::shared_ptr<const DecodedImageCache::Entry>
+DecodedImageCache::get(const std::string& id)
+{
+    uint64_t offset;
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        auto it = _entries.find(id);
+        if(it != _entries.end())
+        {
+            _lru.splice(_lru.begin(), _lru, it->second);
+            _hits++;
+            return it->second->second;
+        }
+        auto spilled = _spill_index.find(id);
+        if(spilled == _spill_index.end())
+        {
+            _misses++;
+            return nullptr;
+        }
+        offset = spilled->second;
+    }
+    auto entry = read_spilled(offset);
+    if(!entry)
+    {
+        _misses++;
+        return nullptr;
+    }
+    _hits++;
+    std::vector<std::pair<std::string, std::shared_ptr<const Entry>>> evicted;
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        evicted = insert(id, entry);
+    }
+    spill(evicted);
+    return entry;
+}
+
+void
+DecodedImageCache::put(const std::string& id, uint32_t roi_width, uint32_t roi_height, uint32_t original_width, uint32_t original_height,
+                       uint32_t planes, const unsigned char* image, size_t stride)
+{
+    auto entry = std::make_shared<Entry>();
+    entry->roi_width = roi_width;
+    entry->roi_height = roi_height;
+    entry->original_width = original_width;
+    entry->original_height = original_height;
+    entry->planes = planes;
+    const size_t row_size = (size_t)roi_width * planes;
+    entry->pixels.resize(row_size * roi_height);
+    for(size_t row = 0; row < roi_height; row++)
+        memcpy(entry->pixels.data() + row * row_size, image + row * stride, row_size);
+    std::vector<std::pair<std::string, std::shared_ptr<const Entry>>> evicted;
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        evicted = insert(id, entry);
+    }
+    spill(evicted);
+}
+
+std::vector<std::pair<std::string, std::shared_ptr<const DecodedImageCache::Entry>>>
+DecodedImageCache::insert(const std::string& id, std::shared_ptr<const Entry> entry)
+{
+    std::vector<std::pair<std::string, std::shared_ptr<const Entry>>> evicted;
+    if(_entries.find(id) != _entries.end())
+        return evicted;
+    const size_t cost = entry_cost(id, *entry);
+    if(cost > _memory_budget)
+    {
+        // Too big to ever be kept in memory, it can only go to the spill file
+        evicted.emplace_back(id, entry);
+        return evicted;
+    }
+    _lru.emplace_front(id, entry);
+    _entries[id] = _lru.begin();
+    _memory_used += cost;
+    while(_memory_used > _memory_budget)
+    {
+        auto& last = _lru.back();
+        _memory_used -= entry_cost(last.first, *last.second);
+        _entries.erase(last.first);
+        evicted.push_back(std::move(last));
+        _lru.pop_back();
+    }
+    return evicted;
+}
+
+void
+DecodedImageCache::spill(const std::vector<std::pair<std::string, std::shared_ptr<const Entry>>>& evicted)
+{
+    if(_spill_fd < 0 || evicted.empty())
+        return;
+    // Space is reserved under the lock, the writes themselves are done without holding it
+    std::vector<std::pair<size_t, uint64_t>> records;
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        for(size_t i = 0; i < evicted.size(); i++)
+        {
+            if(_spill_index.find(evicted[i].first) != _spill_index.end())
+                continue;
+            records.emplace_back(i, _spill_size);
+            _spill_size += sizeof(SpillRecord) + evicted[i].second->pixels.size();
+        }
+    }
+    std::vector<std::pair<size_t, uint64_t>> written;
+    for(auto& record: records)
+    {
+        const Entry& entry = *evicted[record.first].second;
+        SpillRecord header = { entry.roi_width, entry.roi_height, entry.original_width, entry.original_height, entry.planes, 0, entry.pixels.size() };
+        if(!write_fully(_spill_fd, &header, sizeof(header), record.second) ||
+           !write_fully(_spill_fd, entry.pixels.data(), entry.pixels.size(), record.second + sizeof(header)))
+        {
+            WRN("Writing to the decoded image cache spill file " + _spill_path + " failed: " + strerror(errno))
+            continue;
+        }
+        written.push_back(record);
+    }
+    std::lock_guard<std::mutex> lock(_lock);
+    for(auto& record: written)
+        _spill_index[evicted[record.first].first] = record.second;
+}
+
+std::shared_ptr<const DecodedImageCache::Entry>
+DecodedImageCache::read_spilled(uint64_t offset)
+{
+    SpillRecord header;
+    if(!read_fully(_spill_fd, &header, sizeof(header), offset) ||
+       header.size != (uint64_t)header.roi_width * header.roi_height * header.planes)
+    {
+        WRN("Reading from the decoded image cache spill file " + _spill_path + " failed")
+        return nullptr;
+    }
+    auto entry = std::make_shared<Entry>();
+    entry->roi_width = header.roi_width;
+    entry->roi_height = header.roi_height;
+    entry->original_width = header.original_width;
+    entry->original_height = header.original_height;
+    entry->planes = header.planes;
+    entry->pixels.resize(header.size);
+    if(!read_fully(_spill_fd, entry->pixels.data(), header.size, offset + sizeof(header)))
+    {
+        WRN("Reading from the decoded image cache spill file " + _spill_path + " failed")
+        return nullptr;
+    }
+    return entry;
+}
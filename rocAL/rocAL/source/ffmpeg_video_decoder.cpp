@@ -21,6 +21,7 @@ THE SOFTWARE.
 */
 
 #include <stdio.h>
+#include <algorithm>
 #include <commons.h>
 #include "ffmpeg_video_decoder.h"
 
@@ -40,46 +41,102 @@ int FFmpegVideoDecoder::seek_frame(AVRational avg_frame_rate, AVRational time_ba
     return select_frame_pts;
 }
 
-// Seeks to the frame_number in the video file and decodes each frame in the sequence.
+// Decodes each frame in the sequence. The decoder seeks to seek_frame_number unless that frame lies shortly after the
+// position the previous call stopped at; decoding forward from there then costs less than going back to a keyframe.
 VideoDecoder::Status FFmpegVideoDecoder::Decode(unsigned char *out_buffer, unsigned seek_frame_number, size_t sequence_length, size_t stride, int out_width, int out_height, int out_stride, AVPixelFormat out_pix_format)
 {
     VideoDecoder::Status status = Status::OK;
 
-    // Initialize the SwsContext 
+    // The scaler is kept across calls, sws_getCachedContext() only rebuilds it when the conversion changes
     SwsContext *swsctx = nullptr;
     if ((out_width != _codec_width) || (out_height != _codec_height) || (out_pix_format != _dec_pix_fmt))
     {
-        swsctx = sws_getCachedContext(nullptr, _codec_width, _codec_height, _dec_pix_fmt,
-                                      out_width, out_height, out_pix_format, SWS_BILINEAR, nullptr, nullptr, nullptr);
-        if (!swsctx)
+        _sws_ctx = sws_getCachedContext(_sws_ctx, _codec_width, _codec_height, _dec_pix_fmt,
+                                        out_width, out_height, out_pix_format, SWS_BILINEAR, nullptr, nullptr, nullptr);
+        if (!_sws_ctx)
         {
             ERR("Fail to get sws_getCachedContext");
             return Status::FAILED;
         }
+        swsctx = _sws_ctx;
     }
-    int select_frame_pts = seek_frame(_video_stream->avg_frame_rate, _video_stream->time_base, seek_frame_number);
-    if (select_frame_pts < 0)
+    const int64_t last_frame_number = seek_frame_number + (sequence_length - 1) * stride;
+    const int64_t forward_limit = std::max(_gop_size, (int64_t)(sequence_length * stride));
+    const bool seek = (_next_frame_number < 0) || (seek_frame_number < _next_frame_number) ||
+                      (seek_frame_number - _next_frame_number >= forward_limit);
+    int64_t select_frame_pts = 0;
+    int64_t frame_number = _next_frame_number;
+    if (seek)
     {
-        ERR("Error in seeking frame..Unable to seek the given frame in a video");
-        return Status::FAILED;
+        avcodec_flush_buffers(_video_dec_ctx);
+        _next_frame_number = -1;
+        select_frame_pts = seek_frame(_video_stream->avg_frame_rate, _video_stream->time_base, seek_frame_number);
+        if (select_frame_pts < 0)
+        {
+            ERR("Error in seeking frame..Unable to seek the given frame in a video");
+            return Status::FAILED;
+        }
+        // The first frame at or past the selected pts is seek_frame_number, frames before it are only decoded
+        frame_number = seek_frame_number;
     }
-    unsigned frame_count = 0;
-    bool end_of_stream = false;
     bool sequence_filled = false;
+    bool flush_packet_sent = false;
     uint8_t *dst_data[4] = {0};
     int dst_linesize[4] = {0};
     int image_size = out_height * out_stride * sizeof(unsigned char);
     AVPacket pkt;
-    AVFrame *dec_frame = av_frame_alloc();
+    if (!_dec_frame)
+        _dec_frame = av_frame_alloc();
+    AVFrame *dec_frame = _dec_frame;
     if (!dec_frame)
     {
         ERR("Could not allocate dec_frame");
         return Status::NO_MEMORY;
     }
-    do
+    while (!sequence_filled)
     {
-        int ret;
-        // read packet from input file
+        // get the frames already available from the decoder first, they may be left over from the previous call
+        int ret = avcodec_receive_frame(_video_dec_ctx, dec_frame);
+        if (ret == 0)
+        {
+            _decoded_frame_count++;
+            if (seek && dec_frame->pts < select_frame_pts)
+            {
+                av_frame_unref(dec_frame);
+                continue;
+            }
+            if (dec_frame->key_frame)
+            {
+                if (_last_keyframe_number >= 0 && frame_number > _last_keyframe_number)
+                    _gop_size = std::max(_gop_size, frame_number - _last_keyframe_number);
+                _last_keyframe_number = frame_number;
+            }
+            if (frame_number >= seek_frame_number && ((frame_number - seek_frame_number) % stride == 0))
+            {
+                dst_data[0] = out_buffer + ((frame_number - seek_frame_number) / stride) * image_size;
+                dst_linesize[0] = out_stride;
+                if (swsctx)
+                    sws_scale(swsctx, dec_frame->data, dec_frame->linesize, 0, dec_frame->height, dst_data, dst_linesize);
+                else
+                {
+                    // copy from frame to out_buffer
+                    memcpy(dst_data[0], dec_frame->data[0], dec_frame->linesize[0] * out_height);
+                }
+            }
+            av_frame_unref(dec_frame);
+            sequence_filled = (frame_number == last_frame_number);
+            frame_number++;
+            continue;
+        }
+        if (ret == AVERROR_EOF)
+            break;
+        if (ret != AVERROR(EAGAIN))
+        {
+            ERR("Error while receiving a frame from the decoder");
+            status = Status::FAILED;
+            break;
+        }
+        // the decoder needs more input, read packet from input file
         ret = av_read_frame(_fmt_ctx, &pkt);
         if (ret < 0 && ret != AVERROR_EOF)
         {
@@ -87,57 +144,33 @@ VideoDecoder::Status FFmpegVideoDecoder::Decode(unsigned char *out_buffer, unsig
             status = Status::FAILED;
             break;
         }
-        if (ret == 0 && pkt.stream_index != _video_stream_idx) continue;
-        end_of_stream = (ret == AVERROR_EOF);
-        if (end_of_stream)
+        if (ret == 0 && pkt.stream_index != _video_stream_idx)
+        {
+            av_packet_unref(&pkt);
+            continue;
+        }
+        if (ret == AVERROR_EOF)
         {
+            if (flush_packet_sent)
+                break;
             // null packet for bumping process
             pkt.data = nullptr;
             pkt.size = 0;
+            flush_packet_sent = true;
         }
 
         // submit the packet to the decoder
         ret = avcodec_send_packet(_video_dec_ctx, &pkt);
+        av_packet_unref(&pkt);
         if (ret < 0)
         {
             ERR("Error while sending packet to the decoder\n");
             status = Status::FAILED;
             break;
         }
-
-        // get all the available frames from the decoder
-        while (ret >= 0)
-        {
-            ret = avcodec_receive_frame(_video_dec_ctx, dec_frame);
-            if (ret == AVERROR(EAGAIN) || ret == AVERROR_EOF) break;
-            if ((dec_frame->pts < select_frame_pts) || (ret < 0)) continue;
-            if (frame_count % stride == 0)
-            {
-                dst_data[0] = out_buffer;
-                dst_linesize[0] = out_stride;
-                if (swsctx)
-                    sws_scale(swsctx, dec_frame->data, dec_frame->linesize, 0, dec_frame->height, dst_data, dst_linesize);
-                else
-                {
-                    // copy from frame to out_buffer
-                    memcpy(out_buffer, dec_frame->data[0], dec_frame->linesize[0] * out_height);
-                }
-                out_buffer = out_buffer + image_size;
-            }
-            ++frame_count;
-            av_frame_unref(dec_frame);
-            if (frame_count == sequence_length * stride)  
-            {
-                sequence_filled = true;
-                break;
-            }
-        }
-        av_packet_unref(&pkt);
-        if (sequence_filled)  break;
-    } while (!end_of_stream);
-    avcodec_flush_buffers(_video_dec_ctx);
-    av_frame_free(&dec_frame);
-    sws_freeContext(swsctx);
+    }
+    // The next call can carry on from here without a seek, unless the stream is drained or in error
+    _next_frame_number = (sequence_filled && status == Status::OK) ? frame_number : -1;
     return status;
 }
 
@@ -148,6 +181,12 @@ VideoDecoder::Status FFmpegVideoDecoder::Initialize(const char *src_filename)
     int ret;
     AVDictionary *opts = NULL;
 
+    // a decoder instance is reused for another file once its video is done, close the previous one first
+    close_input();
+    _next_frame_number = -1;
+    _last_keyframe_number = -1;
+    _gop_size = 0;
+
     // open input file, and initialize the context required for decoding
     _fmt_ctx = avformat_alloc_context();
     _src_filename = src_filename;
@@ -215,7 +254,7 @@ VideoDecoder::Status FFmpegVideoDecoder::Initialize(const char *src_filename)
     return status;
 }
 
-void FFmpegVideoDecoder::release()
+void FFmpegVideoDecoder::close_input()
 {
     if (_video_dec_ctx)
         avcodec_free_context(&_video_dec_ctx);
@@ -223,6 +262,15 @@ void FFmpegVideoDecoder::release()
         avformat_close_input(&_fmt_ctx);
 }
 
+void FFmpegVideoDecoder::release()
+{
+    close_input();
+    if (_dec_frame)
+        av_frame_free(&_dec_frame);
+    sws_freeContext(_sws_ctx);
+    _sws_ctx = nullptr;
+}
+
 FFmpegVideoDecoder::~FFmpegVideoDecoder()
 {
     release();
@@ -22,6 +22,10 @@ THE SOFTWARE.
 
 #include <cassert>
 #include <algorithm>
+#include <cerrno>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
 #include <commons.h>
 #include "file_source_reader.h"
 #include <boost/filesystem.hpp>
@@ -36,7 +40,10 @@ _shuffle_time("shuffle_time", DBG_TIMING)
     _entity = nullptr;
     _curr_file_idx = 0;
     _current_file_size = 0;
-    _current_fPtr = nullptr;
+    _current_fd = -1;
+    _current_offset = 0;
+    _current_direct = false;
+    _current_loaded = false;
     _loop = false;
     _file_id = 0;
     _shuffle = false;
@@ -62,6 +69,8 @@ Reader::Status FileSourceReader::initialize(ReaderConfig desc)
     _batch_count = desc.get_batch_size();
     _shuffle = desc.shuffle();
     _loop = desc.loop();
+    _readahead_count = desc.readahead_count();
+    _file_read_mode = desc.file_read_mode();
     ret = subfolder_reading();
     // the following code is required to make every shard the same size:: required for multi-gpu training
     if (_shard_count > 1 && _batch_count > 1) {
@@ -86,8 +95,29 @@ void FileSourceReader::incremenet_read_ptr()
     _read_counter++;
     _curr_file_idx = (_curr_file_idx + 1) % _file_names.size();
 }
+void FileSourceReader::issue_readahead()
+{
+    // The pages read ahead would not be used by O_DIRECT reads
+    if(_readahead_count == 0 || _file_read_mode == FileReadMode::DIRECT || _file_names.empty())
+        return;
+    size_t end = _read_counter + _readahead_count + 1;
+    if(!_loop)
+        end = std::min(end, _file_names.size());
+    _readahead_end = std::max(_readahead_end, (size_t)_read_counter);
+    // Every file is hinted once, the first call covers the whole window and the next ones only the file entering it
+    for(; _readahead_end < end; _readahead_end++)
+    {
+        int fd = ::open(_file_names[_readahead_end % _file_names.size()].c_str(), O_RDONLY | O_CLOEXEC);
+        if(fd < 0)
+            continue;
+        posix_fadvise(fd, 0, 0, POSIX_FADV_WILLNEED);
+        ::close(fd);
+    }
+}
+
 size_t FileSourceReader::open()
 {
+    issue_readahead();
     auto file_path = _file_names[_curr_file_idx];// Get next file name
     incremenet_read_ptr();
     _last_id= file_path;
@@ -97,36 +127,87 @@ size_t FileSourceReader::open()
         _last_id.erase(0, last_slash_idx + 1);
     }
 
-    _current_fPtr = fopen(file_path.c_str(), "rb");// Open the file,
+    _current_direct = (_file_read_mode == FileReadMode::DIRECT && !_direct_unsupported);
+    _current_fd = ::open(file_path.c_str(), O_RDONLY | O_CLOEXEC | (_current_direct ? O_DIRECT : 0));// Open the file,
+    if(_current_fd < 0 && _current_direct && errno == EINVAL)
+    {
+        // The file system does not support O_DIRECT (tmpfs for instance), fall back to regular reads
+        WRN("FileReader ShardID ["+ TOSTR(_shard_id)+ "] O_DIRECT is not supported for " + file_path + ", reading through the page cache")
+        _direct_unsupported = true;
+        _current_direct = false;
+        _current_fd = ::open(file_path.c_str(), O_RDONLY | O_CLOEXEC);
+    }
 
-    if(!_current_fPtr) // Check if it is ready for reading
+    if(_current_fd < 0) // Check if it is ready for reading
         return 0;
 
-    fseek(_current_fPtr, 0 , SEEK_END);// Take the file read pointer to the end
-
-    _current_file_size = ftell(_current_fPtr);// Check how many bytes are there between and the current read pointer position (end of the file)
-
-    if(_current_file_size == 0)
+    struct stat file_stat;
+    if(fstat(_current_fd, &file_stat) != 0 || file_stat.st_size == 0)
     { // If file is empty continue
-        fclose(_current_fPtr);
-        _current_fPtr = nullptr;
+        release();
         return 0;
     }
-
-    fseek(_current_fPtr, 0 , SEEK_SET);// Take the file pointer back to the start
+    _current_file_size = file_stat.st_size;
+    _current_offset = 0;
+    _current_loaded = false;
 
     return _current_file_size;
 }
 
+size_t FileSourceReader::read_direct(unsigned char* buf, size_t read_size)
+{
+    if(!_current_loaded)
+    {
+        // O_DIRECT transfers whole aligned blocks, the file is read at once into the pooled buffer and copied out from there
+        size_t aligned_size = (_current_file_size + DIRECT_IO_ALIGNMENT - 1) / DIRECT_IO_ALIGNMENT * DIRECT_IO_ALIGNMENT;
+        if(aligned_size > _direct_buffer_size)
+        {
+            void* ptr = nullptr;
+            if(posix_memalign(&ptr, DIRECT_IO_ALIGNMENT, aligned_size) != 0)
+                THROW("FileReader ShardID ["+ TOSTR(_shard_id)+ "] Failed to allocate the O_DIRECT read buffer")
+            _direct_buffer.reset(static_cast<unsigned char*>(ptr));
+            _direct_buffer_size = aligned_size;
+        }
+        size_t loaded = 0;
+        while(loaded < _current_file_size)
+        {
+            ssize_t ret = pread(_current_fd, _direct_buffer.get() + loaded, aligned_size - loaded, loaded);
+            if(ret < 0 && errno == EINTR)
+                continue;
+            if(ret <= 0)
+                break;
+            loaded += ret;
+        }
+        _current_file_size = std::min((size_t)_current_file_size, loaded);
+        _current_loaded = true;
+    }
+    read_size = std::min(read_size, _current_file_size - _current_offset);
+    memcpy(buf, _direct_buffer.get() + _current_offset, read_size);
+    _current_offset += read_size;
+    return read_size;
+}
+
 size_t FileSourceReader::read_data(unsigned char* buf, size_t read_size)
 {
-    if(!_current_fPtr)
+    if(_current_fd < 0)
         return 0;
 
     // Requested read size bigger than the file size? just read as many bytes as the file size
     read_size = (read_size > _current_file_size) ? _current_file_size : read_size;
 
-    size_t actual_read_size = fread(buf, sizeof(unsigned char), read_size, _current_fPtr);
+    if(_current_direct)
+        return read_direct(buf, read_size);
+
+    size_t actual_read_size = 0;
+    while(actual_read_size < read_size)
+    {
+        ssize_t ret = ::read(_current_fd, buf + actual_read_size, read_size - actual_read_size);
+        if(ret < 0 && errno == EINTR)
+            continue;
+        if(ret <= 0)
+            break;
+        actual_read_size += ret;
+    }
     return actual_read_size;
 }
 
@@ -143,10 +224,12 @@ FileSourceReader::~FileSourceReader()
 int
 FileSourceReader::release()
 {
-    if(!_current_fPtr)
+    if(_current_fd < 0)
         return 0;
-    fclose(_current_fPtr);
-    _current_fPtr = nullptr;
+    if(_file_read_mode == FileReadMode::DROP_CACHE)
+        posix_fadvise(_current_fd, 0, 0, POSIX_FADV_DONTNEED);
+    ::close(_current_fd);
+    _current_fd = -1;
     return 0;
 }
 
@@ -157,6 +240,7 @@ void FileSourceReader::reset()
     _shuffle_time.end();
     _read_counter = 0;
     _curr_file_idx = 0;
+    _readahead_end = 0;
 }
 
 Reader::Status FileSourceReader::subfolder_reading()
@@ -48,7 +48,8 @@ get_ago_affinity_info(
     return affinity;
 }
 
-Graph::Graph(vx_context context, RaliAffinity affinity, int cpu_id, int gpu_id):
+Graph::Graph(vx_context context, RaliAffinity affinity, int cpu_id, int gpu_id, unsigned seed):
+_random(seed),
 _mem_type(((affinity == RaliAffinity::GPU) ? RaliMemType::OCL : RaliMemType::HOST)),
 _context(context),
 _graph(nullptr),
@@ -103,11 +104,55 @@ Graph::process()
     return  Status::OK;    
 }
 
+std::pair<vx_array, vx_array>
+Graph::roi_arrays(uint32_t* roi_width, uint32_t* roi_height, size_t batch_size)
+{
+    auto key = std::make_pair(roi_width, roi_height);
+    auto it = _roi_arrays.find(key);
+    if(it != _roi_arrays.end())
+        return std::make_pair(it->second.width, it->second.height);
+
+    vx_status width_status, height_status;
+    RoiArrays arrays;
+    arrays.width = vxCreateArray(_context, VX_TYPE_UINT32, batch_size);
+    arrays.height = vxCreateArray(_context, VX_TYPE_UINT32, batch_size);
+    arrays.published_batch_id = 0;
+    width_status = vxAddArrayItems(arrays.width, batch_size, roi_width, sizeof(vx_uint32));
+    height_status = vxAddArrayItems(arrays.height, batch_size, roi_height, sizeof(vx_uint32));
+    if (width_status != 0 || height_status != 0)
+        THROW(" vxAddArrayItems failed : " + TOSTR(width_status) + "  " + TOSTR(height_status))
+    _roi_arrays.emplace(key, arrays);
+    return std::make_pair(arrays.width, arrays.height);
+}
+
+void
+Graph::publish_roi(uint32_t* roi_width, uint32_t* roi_height, size_t batch_size)
+{
+    auto it = _roi_arrays.find(std::make_pair(roi_width, roi_height));
+    if(it == _roi_arrays.end())
+        THROW("No ROI arrays created for the given ROI vectors")
+    if(it->second.published_batch_id == _batch_id)
+        return;
+    vx_status width_status, height_status;
+    width_status = vxCopyArrayRange(it->second.width, 0, batch_size, sizeof(vx_uint32), roi_width, VX_WRITE_ONLY, VX_MEMORY_TYPE_HOST);
+    height_status = vxCopyArrayRange(it->second.height, 0, batch_size, sizeof(vx_uint32), roi_height, VX_WRITE_ONLY, VX_MEMORY_TYPE_HOST);
+    if(width_status != 0 || height_status != 0)
+        THROW(" Failed calling vxCopyArrayRange for width / height status : "+ TOSTR(width_status) + " / "+ TOSTR(height_status))
+    it->second.published_batch_id = _batch_id;
+}
+
 Graph::Status
 Graph::release()
 {
     vx_status status = VX_SUCCESS;
 
+    for(auto& roi: _roi_arrays)
+    {
+        vxReleaseArray(&roi.second.width);
+        vxReleaseArray(&roi.second.height);
+    }
+    _roi_arrays.clear();
+
     if(_graph && (status = vxReleaseGraph(&_graph)) != VX_SUCCESS) 
         LOG ("Failed to call vxReleaseGraph " + TOSTR(status))
 
@@ -54,17 +54,18 @@ VideoDecoder::Status HardWareVideoDecoder::Decode(unsigned char *out_buffer, uns
 {
     VideoDecoder::Status status = Status::OK;
 
-    // Initialize the SwsContext 
+    // The scaler is kept across calls, sws_getCachedContext() only rebuilds it when the conversion changes
     SwsContext *swsctx = nullptr;
     if ((out_width != _codec_width) || (out_height != _codec_height) || (out_pix_format != _dec_pix_fmt))
     {
-        swsctx = sws_getCachedContext(nullptr, _codec_width, _codec_height, _dec_pix_fmt,
-                                      out_width, out_height, out_pix_format, SWS_BILINEAR, nullptr, nullptr, nullptr);
-        if (!swsctx)
+        _sws_ctx = sws_getCachedContext(_sws_ctx, _codec_width, _codec_height, _dec_pix_fmt,
+                                        out_width, out_height, out_pix_format, SWS_BILINEAR, nullptr, nullptr, nullptr);
+        if (!_sws_ctx)
         {
             ERR("HardWareVideoDecoder::Decode Failed to get sws_getCachedContext");
             return Status::FAILED;
         }
+        swsctx = _sws_ctx;
     }
     int select_frame_pts = seek_frame(_video_stream->avg_frame_rate, _video_stream->time_base, seek_frame_number);
     if (select_frame_pts < 0)
@@ -79,8 +80,12 @@ VideoDecoder::Status HardWareVideoDecoder::Decode(unsigned char *out_buffer, uns
     int dst_linesize[4] = {0};
     int image_size = out_height * out_stride * sizeof(unsigned char);
     AVPacket pkt;
-    AVFrame *dec_frame = av_frame_alloc();
-    AVFrame *sw_frame = av_frame_alloc();
+    if (!_dec_frame)
+        _dec_frame = av_frame_alloc();
+    if (!_sw_frame)
+        _sw_frame = av_frame_alloc();
+    AVFrame *dec_frame = _dec_frame;
+    AVFrame *sw_frame = _sw_frame;
     if (!dec_frame)
     {
         ERR("HardWareVideoDecoder::Decode Could not allocate dec_frame");
@@ -125,12 +130,16 @@ VideoDecoder::Status HardWareVideoDecoder::Decode(unsigned char *out_buffer, uns
         {
             ret = avcodec_receive_frame(_video_dec_ctx, dec_frame);
             if (ret == AVERROR(EAGAIN) || ret == AVERROR_EOF) break;
+            if (ret == 0) _decoded_frame_count++;
             if ((dec_frame->pts < select_frame_pts) || (ret < 0)) continue;
             if (frame_count % stride == 0)
             {
                 //retrieve data from GPU to CPU
                 if ((av_hwframe_transfer_data(sw_frame, dec_frame, 0)) < 0) {
                     ERR("HardWareVideoDecoder::Decode avcodec_receive_frame() failed");
+                    av_frame_unref(dec_frame);
+                    av_packet_unref(&pkt);
+                    avcodec_flush_buffers(_video_dec_ctx);
                     return Status::FAILED;
                 }
 
@@ -158,9 +167,6 @@ VideoDecoder::Status HardWareVideoDecoder::Decode(unsigned char *out_buffer, uns
         if (sequence_filled)  break;
     } while (!end_of_stream);
     avcodec_flush_buffers(_video_dec_ctx);
-    av_frame_free(&dec_frame);
-    av_frame_free(&sw_frame);
-    sws_freeContext(swsctx);
     return status;
 }
 
@@ -171,6 +177,9 @@ VideoDecoder::Status HardWareVideoDecoder::Initialize(const char *src_filename)
     int ret;
     AVDictionary *opts = NULL;
 
+    // a decoder instance is reused for another file once its video is done, close the previous one first
+    close_input();
+
     // open input file, and initialize the context required for decoding
     _fmt_ctx = avformat_alloc_context();
     _src_filename = src_filename;
@@ -268,7 +277,7 @@ VideoDecoder::Status HardWareVideoDecoder::Initialize(const char *src_filename)
     return status;
 }
 
-void HardWareVideoDecoder::release()
+void HardWareVideoDecoder::close_input()
 {
     if (_video_dec_ctx)
         avcodec_free_context(&_video_dec_ctx);
@@ -276,6 +285,17 @@ void HardWareVideoDecoder::release()
         avformat_close_input(&_fmt_ctx);
 }
 
+void HardWareVideoDecoder::release()
+{
+    close_input();
+    if (_dec_frame)
+        av_frame_free(&_dec_frame);
+    if (_sw_frame)
+        av_frame_free(&_sw_frame);
+    sws_freeContext(_sws_ctx);
+    _sws_ctx = nullptr;
+}
+
 HardWareVideoDecoder::~HardWareVideoDecoder()
 {
     release();
@@ -71,7 +71,11 @@ ImageLoader::remaining_count()
 void ImageLoader::reset()
 {
     // stop the writer thread and empty the internal circular buffer
-    _internal_thread_running = false;
+    {
+        std::unique_lock<std::mutex> lock(_idle_lock);
+        _internal_thread_running = false;
+    }
+    _idle_cv.notify_all();
     _circ_buff.unblock_writer();
 
     if (_load_thread.joinable())
@@ -117,7 +121,11 @@ void ImageLoader::set_random_bbox_data_reader(std::shared_ptr<RandomBBoxCrop_Met
 
 void ImageLoader::stop_internal_thread()
 {
-    _internal_thread_running = false;
+    {
+        std::unique_lock<std::mutex> lock(_idle_lock);
+        _internal_thread_running = false;
+    }
+    _idle_cv.notify_all();
     _stopped = true;
     _circ_buff.unblock_reader();
     _circ_buff.unblock_writer();
@@ -139,6 +147,8 @@ void ImageLoader::initialize(ReaderConfig reader_cfg, DecoderConfig decoder_cfg,
     _loop = reader_cfg.loop();
     _decoder_keep_original = decoder_keep_original;
     _image_loader = std::make_shared<ImageReadAndDecode>();
+    reader_cfg.set_readahead_count(_readahead_count);
+    reader_cfg.set_file_read_mode(_file_read_mode);
     try
     {
         _image_loader->create(reader_cfg, decoder_cfg, _batch_size);
@@ -157,6 +167,10 @@ void ImageLoader::initialize(ReaderConfig reader_cfg, DecoderConfig decoder_cfg,
     _circ_buff.init(_mem_type, _output_mem_size,_prefetch_queue_depth );
     _is_initialized = true;
     _image_loader->set_random_bbox_data_reader(_randombboxcrop_meta_data_reader);
+    if (_cache_enabled) {
+        _image_loader->set_decoded_image_cache(std::make_shared<DecodedImageCache>(_cache_memory_budget, _cache_spill_path));
+        LOG("Decoded image cache enabled with a budget of " + std::to_string(_cache_memory_budget) + " bytes")
+    }
     LOG("Loader module initialized");
 }
 
@@ -174,6 +188,7 @@ LoaderModuleStatus
 ImageLoader::load_routine()
 {
     LOG("Started the internal loader thread");
+    vxSetTraceThreadName("rocAL loader");
     LoaderModuleStatus last_load_status = LoaderModuleStatus::OK;
     // Initially record number of all the images that are going to be loaded, this is used to know how many still there
 
@@ -228,10 +243,11 @@ ImageLoader::load_routine()
             // read semaphore using release() call
             // , and calls the release() allows the reader thread to wake up and handle
             // the out-of-data case properly
-            // It also slows down the reader thread since there is no more data to read,
-            // till program ends or till reset is called
+            // It also parks the reader thread since there is no more data to read,
+            // till program ends or till reset is called, both of them wake it up right away
             _circ_buff.unblock_reader();
-            std::this_thread::sleep_for(std::chrono::seconds(1));
+            std::unique_lock<std::mutex> lock(_idle_lock);
+            _idle_cv.wait_for(lock, std::chrono::seconds(1), [this] { return !_internal_thread_running; });
         }
     }
     return LoaderModuleStatus::OK;
@@ -285,6 +301,23 @@ ImageLoader::update_output_image()
     return status;
 }
 
+void ImageLoader::enable_decoded_image_cache(size_t memory_budget, const std::string& spill_path)
+{
+    if (_is_initialized)
+        THROW("enable_decoded_image_cache() should be called before initialize() function")
+    _cache_enabled = true;
+    _cache_memory_budget = memory_budget;
+    _cache_spill_path = spill_path;
+}
+
+void ImageLoader::set_file_read_options(size_t readahead_count, FileReadMode mode)
+{
+    if (_is_initialized)
+        THROW("set_file_read_options() should be called before initialize() function")
+    _readahead_count = readahead_count;
+    _file_read_mode = mode;
+}
+
 Timing ImageLoader::timing()
 {
     auto t = _image_loader->timing();
@@ -97,6 +97,11 @@ ImageLoaderSharded::initialize(ReaderConfig reader_cfg, DecoderConfig decoder_cf
     {
         std::shared_ptr loader = std::make_shared<ImageLoader>(_dev_resources);
         loader->set_prefetch_queue_depth(_prefetch_queue_depth);
+        loader->set_file_read_options(_readahead_count, _file_read_mode);
+        // Shards read disjoint sets of images, each gets its own cache and an equal part of the budget
+        if(_cache_enabled)
+            loader->enable_decoded_image_cache(_cache_memory_budget / _shard_count,
+                                               _cache_spill_path.empty() ? _cache_spill_path : _cache_spill_path + "." + std::to_string(i));
         _loaders.push_back(loader);
     }
     // Initialize loader modules
@@ -142,6 +147,23 @@ void ImageLoaderSharded::shut_down()
 }
 
 
+void ImageLoaderSharded::enable_decoded_image_cache(size_t memory_budget, const std::string& spill_path)
+{
+    if(_initialized)
+        THROW("enable_decoded_image_cache() should be called before initialize() function")
+    _cache_enabled = true;
+    _cache_memory_budget = memory_budget;
+    _cache_spill_path = spill_path;
+}
+
+void ImageLoaderSharded::set_file_read_options(size_t readahead_count, FileReadMode mode)
+{
+    if(_initialized)
+        THROW("set_file_read_options() should be called before initialize() function")
+    _readahead_count = readahead_count;
+    _file_read_mode = mode;
+}
+
 void ImageLoaderSharded::set_output_image (Image* output_image)
 {
     _output_image = output_image;
@@ -175,6 +197,10 @@ Timing ImageLoaderSharded::timing()
     long long unsigned  max_decode_time = 0;
     long long unsigned  max_read_time = 0;
     long long unsigned  swap_handle_time = 0;
+    long long unsigned  read_bytes = 0;
+    unsigned  read_queue_depth = 0;
+    long long unsigned cache_hits = 0;
+    long long unsigned cache_misses = 0;
 
     // image read and decode runs in parallel using multiple loaders, and the observable latency that the ImageLoaderSharded user
     // is experiences on the load_next() call due to read and decode time is the maximum of all
@@ -184,9 +210,17 @@ Timing ImageLoaderSharded::timing()
         max_read_time = (info.image_read_time > max_read_time) ?  info.image_read_time : max_read_time;
         max_decode_time = (info.image_decode_time > max_decode_time) ? info.image_decode_time : max_decode_time;
         swap_handle_time += info.image_process_time;
+        read_bytes += info.image_read_bytes;
+        read_queue_depth += info.image_read_queue_depth;
+        cache_hits += info.image_cache_hits;
+        cache_misses += info.image_cache_misses;
     }
     t.image_decode_time = max_decode_time;
     t.image_read_time = max_read_time;
     t.image_process_time = swap_handle_time;
+    t.image_read_bytes = read_bytes;
+    t.image_read_queue_depth = read_queue_depth;
+    t.image_cache_hits = cache_hits;
+    t.image_cache_misses = cache_misses;
     return t;
 }
@@ -50,12 +50,22 @@ ImageReadAndDecode::timing()
 {
     Timing t;
     t.image_decode_time = _decode_time.get_timing();
-    t.image_read_time = _file_load_time.get_timing();
+    {
+        std::lock_guard<std::mutex> lock(_prefetch_lock);
+        t.image_read_time = _file_load_time.get_timing();
+        t.image_read_queue_depth = (_prefetched_count > 0) ? 1 : 0;
+    }
     t.shuffle_time = _reader->get_shuffle_time();
+    t.image_read_bytes = _read_bytes;
+    if (_cache) {
+        t.image_cache_hits = _cache->hits();
+        t.image_cache_misses = _cache->misses();
+    }
     return t;
 }
 
 ImageReadAndDecode::ImageReadAndDecode():
+    _read_bytes(0),
     _file_load_time("FileLoadTime", DBG_TIMING ),
     _decode_time("DecodeTime", DBG_TIMING)
 {
@@ -63,6 +73,8 @@ ImageReadAndDecode::ImageReadAndDecode():
 
 ImageReadAndDecode::~ImageReadAndDecode()
 {
+    if (_prefetch.valid())
+        _prefetch.wait();
     _reader = nullptr;
     _decoder.clear();
 }   
@@ -77,6 +89,12 @@ ImageReadAndDecode::create(ReaderConfig reader_config, DecoderConfig decoder_con
     _actual_read_size.resize(batch_size);
     _image_names.resize(batch_size);
     _compressed_image_size.resize(batch_size);
+    _prefetch_compressed_buff.resize(batch_size);
+    _prefetch_actual_read_size.resize(batch_size);
+    _prefetch_image_names.resize(batch_size);
+    _prefetch_compressed_image_size.resize(batch_size);
+    _cached.resize(batch_size);
+    _prefetch_cached.resize(batch_size);
     _decompressed_buff_ptrs.resize(_batch_size);
     _actual_decoded_width.resize(_batch_size);
     _actual_decoded_height.resize(_batch_size);
@@ -90,6 +108,7 @@ ImageReadAndDecode::create(ReaderConfig reader_config, DecoderConfig decoder_con
         for (int i = 0; i < batch_size; i++) {
             _compressed_buff[i].resize(
                     MAX_COMPRESSED_SIZE); // If we don't need MAX_COMPRESSED_SIZE we can remove this & resize in load module
+            _prefetch_compressed_buff[i].resize(MAX_COMPRESSED_SIZE);
             _decoder[i] = create_decoder(decoder_config);
             _decoder_cv[i] = nullptr;
 #if ENABLE_OPENCV
@@ -100,19 +119,91 @@ ImageReadAndDecode::create(ReaderConfig reader_config, DecoderConfig decoder_con
         }
     }
     _reader = create_reader(reader_config);
+    _unread_count = _reader->count_items();
 }
 
 void 
 ImageReadAndDecode::reset()
 {
     // TODO: Reload images from the folder if needed
+    // A batch read ahead of the reset belongs to the previous epoch, drop it
+    wait_for_prefetch();
     _reader->reset();
+    std::lock_guard<std::mutex> lock(_prefetch_lock);
+    _unread_count = _reader->count_items();
 }
 
 size_t
 ImageReadAndDecode::count()
 {
-    return _reader->count_items();
+    // The reader is not thread safe, its count is the snapshot taken by its last user
+    std::lock_guard<std::mutex> lock(_prefetch_lock);
+    return _unread_count + _prefetched_count;
+}
+
+bool
+ImageReadAndDecode::use_cache()
+{
+    return _cache && _decoder_config._type != DecoderType::SKIP_DECODE && !_randombboxcrop_meta_data_reader &&
+           !_decoder[0]->is_partial_decoder();
+}
+
+size_t
+ImageReadAndDecode::read_compressed_batch()
+{
+    // File read is done serially since the reader walks its file list with a single cursor,
+    // it runs on its own thread so that it overlaps with the decode of the previous batch
+    size_t file_counter = 0;
+    const bool cache = use_cache();
+    _file_load_time.start();// Debug timing
+    while ((file_counter != _batch_size) && _reader->count_items() > 0) {
+
+        size_t fsize = _reader->open();
+        if (fsize == 0) {
+            WRN("Opened file " + _reader->id() + " of size 0");
+            continue;
+        }
+        _prefetch_image_names[file_counter] = _reader->id();
+        _prefetch_compressed_image_size[file_counter] = fsize;
+        // The id is only the file name for some readers, the size tells apart same named files of different folders
+        _prefetch_cached[file_counter] = cache ? _cache->get(_prefetch_image_names[file_counter] + ":" + std::to_string(fsize)) : nullptr;
+        if (_prefetch_cached[file_counter]) {
+            _reader->skip_data();
+            _prefetch_actual_read_size[file_counter] = 0;
+        } else {
+            _prefetch_compressed_buff[file_counter].reserve(fsize);
+            _prefetch_actual_read_size[file_counter] = _reader->read_data(_prefetch_compressed_buff[file_counter].data(), fsize);
+            _read_bytes += _prefetch_actual_read_size[file_counter];
+        }
+        _reader->close();
+        file_counter++;
+    }
+    // The batch moves from the reader to the prefetched buffers at once, count() doesn't change
+    std::lock_guard<std::mutex> lock(_prefetch_lock);
+    _file_load_time.end();// Debug timing
+    _unread_count = _reader->count_items();
+    _prefetched_count = file_counter;
+    return file_counter;
+}
+
+void
+ImageReadAndDecode::start_prefetch()
+{
+    // Only read ahead when a full batch is available, a partial batch is never returned by load()
+    if (_reader->count_items() < _batch_size)
+        return;
+    _prefetch = std::async(std::launch::async, &ImageReadAndDecode::read_compressed_batch, this);
+}
+
+size_t
+ImageReadAndDecode::wait_for_prefetch()
+{
+    if (!_prefetch.valid())
+        return 0;
+    size_t file_counter = _prefetch.get();
+    std::lock_guard<std::mutex> lock(_prefetch_lock);
+    _prefetched_count = 0;
+    return file_counter;
 }
 
 void ImageReadAndDecode::set_random_bbox_data_reader(std::shared_ptr<RandomBBoxCrop_MetaDataReader> randombboxcrop_meta_data_reader)
@@ -149,7 +240,7 @@ ImageReadAndDecode::load(unsigned char* buff,
         THROW("Zero image dimension is not valid")
     if(!buff)
         THROW("Null pointer passed as output buffer")
-    if(_reader->count_items() < _batch_size)
+    if(count() < _batch_size)
         return LoaderModuleStatus::NO_MORE_DATA_TO_READ;
     // load images/frames from the disk and push them as a large image onto the buff
     unsigned file_counter = 0;
@@ -160,9 +251,9 @@ ImageReadAndDecode::load(unsigned char* buff,
     const size_t image_size = max_decoded_width * max_decoded_height * output_planes * sizeof(unsigned char);
 
     // Decode with the height and size equal to a single image  
-    // File read is done serially since I/O parallelization does not work very well.
-    _file_load_time.start();// Debug timing
     if (_decoder_config._type == DecoderType::SKIP_DECODE) {
+        // File read is done serially since I/O parallelization does not work very well.
+        _file_load_time.start();// Debug timing
         while ((file_counter != _batch_size) && _reader->count_items() > 0)
         {
             auto read_ptr = buff + image_size * file_counter;
@@ -175,6 +266,7 @@ ImageReadAndDecode::load(unsigned char* buff,
             _actual_read_size[file_counter] = _reader->read_data(read_ptr, fsize);
             if(_actual_read_size[file_counter] < fsize)
                 LOG("Reader read less than requested bytes of size: " + _actual_read_size[file_counter]);
+            _read_bytes += _actual_read_size[file_counter];
 
             _image_names[file_counter] = _reader->id();
             _reader->close();
@@ -186,24 +278,22 @@ ImageReadAndDecode::load(unsigned char* buff,
             actual_height[file_counter] = max_decoded_height;
             file_counter++;
         }
-        //_file_load_time.end();// Debug timing
-        //return LoaderModuleStatus::OK;
+        std::lock_guard<std::mutex> lock(_prefetch_lock);
+        _file_load_time.end();// Debug timing
+        _unread_count = _reader->count_items();
     }else {
-        while ((file_counter != _batch_size) && _reader->count_items() > 0) {
+        // The batch is normally read ahead during the previous call, it's only read here on the first call after a reset
+        if (!_prefetch.valid())
+            start_prefetch();
+        file_counter = wait_for_prefetch();
+        std::swap(_compressed_buff, _prefetch_compressed_buff);
+        std::swap(_actual_read_size, _prefetch_actual_read_size);
+        std::swap(_image_names, _prefetch_image_names);
+        std::swap(_compressed_image_size, _prefetch_compressed_image_size);
+        std::swap(_cached, _prefetch_cached);
+        // Start reading the next batch while this one is decoded
+        start_prefetch();
 
-            size_t fsize = _reader->open();
-            if (fsize == 0) {
-                WRN("Opened file " + _reader->id() + " of size 0");
-                continue;
-            }
-            _compressed_buff[file_counter].reserve(fsize);
-            _actual_read_size[file_counter] = _reader->read_data(_compressed_buff[file_counter].data(), fsize);
-            _image_names[file_counter] = _reader->id();
-            _reader->close();
-            _compressed_image_size[file_counter] = fsize;
-            file_counter++;
-        }
-        
         if (_randombboxcrop_meta_data_reader)
         {
             //Fetch the crop co-ordinates for a batch of images
@@ -212,10 +302,9 @@ ImageReadAndDecode::load(unsigned char* buff,
         }
     }
 
-    _file_load_time.end();// Debug timing
-
     _decode_time.start();// Debug timing
     if (_decoder_config._type != DecoderType::SKIP_DECODE) {
+        const bool cache = use_cache();
         for (size_t i = 0; i < _batch_size; i++)
             _decompressed_buff_ptrs[i] = buff + image_size * i;
 
@@ -225,7 +314,20 @@ ImageReadAndDecode::load(unsigned char* buff,
             // initialize the actual decoded height and width with the maximum
             _actual_decoded_width[i] = max_decoded_width;
             _actual_decoded_height[i] = max_decoded_height;
+            if (_cached[i]) {
+                const auto& entry = *_cached[i];
+                const size_t row_size = entry.roi_width * entry.planes;
+                for (size_t row = 0; row < entry.roi_height; row++)
+                    memcpy(_decompressed_buff_ptrs[i] + row * max_decoded_width * output_planes, entry.pixels.data() + row * row_size, row_size);
+                _actual_decoded_width[i] = entry.roi_width;
+                _actual_decoded_height[i] = entry.roi_height;
+                _original_width[i] = entry.original_width;
+                _original_height[i] = entry.original_height;
+                _cached[i] = nullptr;
+                continue;
+            }
             int original_width, original_height, jpeg_sub_samp;
+            bool decoded = false;
             if (_decoder[i]->decode_info(_compressed_buff[i].data(), _actual_read_size[i], &original_width, &original_height,
                                          &jpeg_sub_samp) != Decoder::Status::OK) {
                 // try open_cv decoder
@@ -265,9 +367,14 @@ ImageReadAndDecode::load(unsigned char* buff,
 
                 }
 #endif
+            } else {
+                decoded = true;
             }
             _actual_decoded_width[i] = scaledw;
             _actual_decoded_height[i] = scaledh;
+            if (cache && decoded)
+                _cache->put(_image_names[i] + ":" + std::to_string(_compressed_image_size[i]), scaledw, scaledh,
+                            original_width, original_height, output_planes, _decompressed_buff_ptrs[i], max_decoded_width * output_planes);
         }
         for (size_t i = 0; i < _batch_size; i++) {
             names[i] = _image_names[i];           
@@ -34,6 +34,7 @@ THE SOFTWARE.
 #include "meta_data_reader_factory.h"
 #include "meta_data_graph_factory.h"
 #include "randombboxcrop_meta_data_reader_factory.h"
+#include "node_fused_pointwise.h"
 
 using half_float::half;
 
@@ -250,7 +251,8 @@ void
 MasterGraph::create_single_graph()
 {
     // Actual graph creating and calls into adding nodes to graph is deferred and is happening here to enable potential future optimizations
-    _graph = std::make_shared<Graph>(_context, _affinity, 0, _gpu_id);
+    // The pipeline keeps the seed it is built with, raliSetSeed() calls for other pipelines don't change its parameters
+    _graph = std::make_shared<Graph>(_context, _affinity, 0, _gpu_id, ParameterFactory::instance()->get_seed());
     for(auto& node: _nodes)
     {
         // Any image not yet created can be created as virtual image
@@ -265,6 +267,66 @@ MasterGraph::create_single_graph()
     _graph->verify();
 }
 
+void
+MasterGraph::fuse_pointwise_nodes()
+{
+    // Number of nodes reading each image, an image read by more than one node has to be kept
+    std::map<Image*, unsigned> consumers;
+    std::map<Image*, std::shared_ptr<Node>> consumer_of;
+    for(auto& node: _nodes)
+        for(auto& image: node->input())
+        {
+            consumers[image]++;
+            consumer_of[image] = node;
+        }
+
+    // _nodes is in creation order, so the first node of a chain is always seen before the rest of it
+    std::set<Node*> absorbed;
+    std::vector<std::vector<std::shared_ptr<Node>>> chains;
+    for(auto& node: _nodes)
+    {
+        if(absorbed.count(node.get()) || !FusedPointwiseNode::can_fuse(node))
+            continue;
+        std::vector<std::shared_ptr<Node>> chain = { node };
+        while(true)
+        {
+            auto image = chain.back()->output()[0];
+            if(consumers[image] != 1 ||
+               std::find(_output_images.begin(), _output_images.end(), image) != _output_images.end())
+                break;
+            auto next = consumer_of[image];
+            if(!FusedPointwiseNode::can_fuse(next))
+                break;
+            chain.push_back(next);
+        }
+        if(chain.size() < 2)
+            continue;
+        for(auto& link: chain)
+            absorbed.insert(link.get());
+        chains.push_back(chain);
+    }
+
+    for(auto& chain: chains)
+    {
+        auto fused = std::make_shared<FusedPointwiseNode>(chain.front()->input(), chain.back()->output());
+        fused->init(chain);
+        auto position = std::find(_nodes.begin(), _nodes.end(), chain.front());
+        _nodes.insert(position, fused);
+        for(auto& link: chain)
+        {
+            _nodes.remove(link);
+            // The intermediate images are never created, they're only released along with the other internal images
+            if(link != chain.back())
+            {
+                _image_map.erase(link->output()[0]);
+                _internal_images.push_back(link->output()[0]);
+            }
+        }
+        _image_map[chain.back()->output()[0]] = fused;
+        LOG("Fused " + TOSTR(chain.size()) + " pointwise augmentations into one node")
+    }
+}
+
 MasterGraph::Status
 MasterGraph::build()
 {
@@ -283,6 +345,8 @@ MasterGraph::build()
 #else
     _ring_buffer.init(_mem_type, _device.resources(), output_byte_size(), _output_images.size());
 #endif
+    if(_fuse_pointwise && _affinity == RaliAffinity::CPU)
+        fuse_pointwise_nodes();
     create_single_graph();
     start_processing();
     return Status::OK;
@@ -323,6 +387,12 @@ void MasterGraph::release()
 {
     LOG("MasterGraph release ...")
     stop_processing();
+    if(_shared_memory_ring)
+    {
+        // The consumers drain the batches already published and then see the end of the data
+        _shared_memory_ring->close();
+        _shared_memory_ring.reset();
+    }
     _nodes.clear();
     _root_nodes.clear();
     _image_map.clear();
@@ -356,10 +426,8 @@ void MasterGraph::release()
 MasterGraph::Status
 MasterGraph::update_node_parameters()
 {
-    // Randomize random parameters
-    ParameterFactory::instance()->renew_parameters();
-
-    // Apply renewed parameters to VX parameters used in augmentation
+    // Draw the random parameters of the next batch and apply them to VX parameters used in augmentation
+    _graph->new_batch();
     for(auto& node: _nodes)
         node->update_parameters();
 
@@ -464,7 +532,11 @@ MasterGraph::Status
 MasterGraph::reset()
 {
     // stop the internal processing thread so that the
-    _processing = false;
+    {
+        std::unique_lock<std::mutex> lock(_processing_lock);
+        _processing = false;
+    }
+    _processing_cv.notify_all();
     _ring_buffer.unblock_writer();
     if(_output_thread.joinable())
         _output_thread.join();
@@ -487,6 +559,10 @@ MasterGraph::reset()
         _loader_module->reset();
     }
 
+    // the next epoch draws new augmentation parameters
+    if(_graph)
+        _graph->random().new_epoch();
+
     // restart processing of the images
     _first_run = true;
     _output_routine_finished_processing = false;
@@ -856,6 +932,7 @@ MasterGraph::copy_output(unsigned char *out_ptr)
 
 void MasterGraph::output_routine()
 {
+    vxSetTraceThreadName("rocAL output routine");
     _process_time.start();
     INFO("Output routine started with "+TOSTR(_remaining_count) + " to load");
     size_t batch_ratio = _is_sequence_reader_output ? _sequence_batch_ratio : _user_to_internal_batch_ratio;
@@ -884,7 +961,9 @@ void MasterGraph::output_routine()
                 notify_user_thread();
                 // the following call is required in case the ring buffer is waiting for more data to be loaded and there is no more data to process.
                 _ring_buffer.release_if_empty();
-                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                // nothing is left to load till reset() or shut down stops this thread
+                std::unique_lock<std::mutex> lock(_processing_lock);
+                _processing_cv.wait(lock, [this] { return !_processing; });
                 continue;
             }
             // _ring_buffer.get_write_buffers() is blocking and blocks here until user uses processed image by calling run() and frees space in the ring_buffer
@@ -942,6 +1021,8 @@ void MasterGraph::output_routine()
                 }
 
                 update_node_parameters();
+                std::future<void> box_encoder_stage;
+                pMetaDataBatch cycle_meta_data = nullptr;
                 if(_augmented_meta_data)
                 {
                     if (_meta_data_graph)
@@ -952,19 +1033,35 @@ void MasterGraph::output_routine()
                         }
                         _meta_data_graph->process(_augmented_meta_data);
                     }
-                    if (full_batch_meta_data)
+                    if (_is_box_encoder && _is_box_encoder_pipelined)
+                    {
+                        // The boxes of this cycle are encoded on their own copy of the meta data while the graph processes the images
+                        cycle_meta_data = _augmented_meta_data->clone();
+                        box_encoder_stage = start_box_encoder_stage(cycle_meta_data);
+                    }
+                    else if (full_batch_meta_data)
                         full_batch_meta_data->concatenate(_augmented_meta_data);
                     else
                         full_batch_meta_data = _augmented_meta_data->clone();
                 }
                 _graph->process();
+                if (box_encoder_stage.valid())
+                {
+                    _bencode_time.start();
+                    box_encoder_stage.get(); // rethrows the exceptions thrown by the encoder
+                    _bencode_time.end();
+                    if (full_batch_meta_data)
+                        full_batch_meta_data->concatenate(cycle_meta_data.get());
+                    else
+                        full_batch_meta_data = cycle_meta_data;
+                }
             }
-            _bencode_time.start();
-            if(_is_box_encoder )
+            if(_is_box_encoder && !_is_box_encoder_pipelined)
             {
-                _meta_data_graph->update_box_encoder_meta_data(&_anchors, full_batch_meta_data, _criteria, _offset, _scale, _means, _stds);
+                _bencode_time.start();
+                encode_boxes(full_batch_meta_data);
+                _bencode_time.end();
             }
-            _bencode_time.end();
             _ring_buffer.set_meta_data(full_batch_image_names, full_batch_meta_data);
             _ring_buffer.push(); // Image data and metadata is now stored in output the ring_buffer, increases it's level by 1
         }
@@ -981,6 +1078,7 @@ void MasterGraph::output_routine()
 #ifdef RALI_VIDEO
 void MasterGraph::output_routine_video()
 {
+    vxSetTraceThreadName("rocAL output routine");
     _process_time.start();
     INFO("Output routine of video pipeline started with "+TOSTR(_remaining_count) + " to load");
 #if !ENABLE_HIP
@@ -1005,7 +1103,9 @@ void MasterGraph::output_routine_video()
                 notify_user_thread();
                 // the following call is required in case the ring buffer is waiting for more data to be loaded and there is no more data to process.
                 _ring_buffer.release_if_empty();
-                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                // nothing is left to load till reset() or shut down stops this thread
+                std::unique_lock<std::mutex> lock(_processing_lock);
+                _processing_cv.wait(lock, [this] { return !_processing; });
                 continue;
             }
             // _ring_buffer.get_write_buffers() is blocking and blocks here until user uses processed image by calling run() and frees space in the ring_buffer
@@ -1064,22 +1164,40 @@ void MasterGraph::output_routine_video()
                 }
 
                 update_node_parameters();
+                std::future<void> box_encoder_stage;
+                pMetaDataBatch cycle_meta_data = nullptr;
                 if(_augmented_meta_data)
                 {
                     if (_meta_data_graph)
                     {
                         _meta_data_graph->process(_augmented_meta_data);
                     }
-                    if (full_batch_meta_data)
+                    if (_is_box_encoder && _is_box_encoder_pipelined)
+                    {
+                        // The boxes of this cycle are encoded on their own copy of the meta data while the graph processes the images
+                        cycle_meta_data = _augmented_meta_data->clone();
+                        box_encoder_stage = start_box_encoder_stage(cycle_meta_data);
+                    }
+                    else if (full_batch_meta_data)
                         full_batch_meta_data->concatenate(_augmented_meta_data);
                     else
                         full_batch_meta_data = _augmented_meta_data->clone();
                 }
                 _graph->process();
+                if (box_encoder_stage.valid())
+                {
+                    _bencode_time.start();
+                    box_encoder_stage.get(); // rethrows the exceptions thrown by the encoder
+                    _bencode_time.end();
+                    if (full_batch_meta_data)
+                        full_batch_meta_data->concatenate(cycle_meta_data.get());
+                    else
+                        full_batch_meta_data = cycle_meta_data;
+                }
             }
-            if(_is_box_encoder )
+            if(_is_box_encoder && !_is_box_encoder_pipelined)
             {
-                _meta_data_graph->update_box_encoder_meta_data(&_anchors, full_batch_meta_data, _criteria, _offset, _scale, _means, _stds);
+                encode_boxes(full_batch_meta_data);
             }
             _ring_buffer.set_meta_data(full_batch_image_names, full_batch_meta_data);
             _ring_buffer.push(); // Image data and metadata is now stored in output the ring_buffer, increases it's level by 1
@@ -1127,7 +1245,11 @@ void MasterGraph::start_processing()
 
 void MasterGraph::stop_processing()
 {
-    _processing = false;
+    {
+        std::unique_lock<std::mutex> lock(_processing_lock);
+        _processing = false;
+    }
+    _processing_cv.notify_all();
     _ring_buffer.unblock_reader();
     _ring_buffer.unblock_writer();
     if(_output_thread.joinable())
@@ -1238,9 +1360,10 @@ void MasterGraph::create_randombboxcrop_reader(RandomBBoxCrop_MetaDataReaderType
         _random_bbox_crop_cords_data = _randombboxcrop_meta_data_reader->get_output();
 }
 
-void MasterGraph::box_encoder(std::vector<float> &anchors, float criteria, const std::vector<float> &means, const std::vector<float> &stds, bool offset, float scale)
+void MasterGraph::box_encoder(std::vector<float> &anchors, float criteria, const std::vector<float> &means, const std::vector<float> &stds, bool offset, float scale, bool pipelined)
 {
     _is_box_encoder = true;
+    _is_box_encoder_pipelined = pipelined;
     _offset = offset;
     _anchors = anchors;
     _scale = scale;
@@ -1249,6 +1372,16 @@ void MasterGraph::box_encoder(std::vector<float> &anchors, float criteria, const
 
 }
 
+void MasterGraph::encode_boxes(pMetaDataBatch meta_data)
+{
+    _meta_data_graph->update_box_encoder_meta_data(&_anchors, meta_data, _criteria, _offset, _scale, _means, _stds);
+}
+
+std::future<void> MasterGraph::start_box_encoder_stage(pMetaDataBatch meta_data)
+{
+    return std::async(std::launch::async, [this, meta_data] { encode_boxes(meta_data); });
+}
+
 MetaDataBatch * MasterGraph::create_caffe2_lmdb_record_meta_data_reader(const char *source_path, MetaDataReaderType reader_type , MetaDataType label_type)
 {
     if( _meta_data_reader)
@@ -1297,6 +1430,49 @@ MetaDataBatch * MasterGraph::create_cifar10_label_reader(const char *source_path
 }
 
 
+void MasterGraph::create_shared_memory_output(const std::string& name, unsigned slot_count, unsigned max_consumers)
+{
+    if(!_graph)
+        THROW("The shared memory output can only be created once the graph is built")
+    if(_shared_memory_ring)
+        THROW("The shared memory output is already created")
+    SharedMemoryRing::Geometry geometry;
+    geometry.width = output_width();
+    geometry.height = output_height();
+    geometry.channels = output_depth();
+    geometry.batch_size = _user_batch_size;
+    geometry.output_count = _output_images.size();
+    // one label per image of the output batch
+    geometry.label_capacity = _is_sequence_reader_output ? _sequence_batch_size : _user_batch_size;
+    geometry.image_bytes = output_byte_size() * _output_images.size();
+    _shared_memory_ring.reset(SharedMemoryRing::create(name, geometry, slot_count, max_consumers));
+    LOG("Publishing batches to shared memory " + name + " with " + TOSTR(slot_count) + " slots")
+}
+
+MasterGraph::Status MasterGraph::publish_to_shared_memory()
+{
+    if(!_shared_memory_ring)
+        THROW("The shared memory output has not been created")
+    if(no_more_processed_data())
+        return MasterGraph::Status::NO_MORE_DATA;
+    // Blocks until the consumers of the slot's previous batch released it
+    auto slot = _shared_memory_ring->acquire_write_slot();
+    auto status = copy_output(slot);
+    if(status != Status::OK)
+        return status;
+    uint32_t label_count = 0;
+    auto labels = _ring_buffer.get_meta_data().second;
+    if(labels)
+    {
+        label_count = labels->get_label_batch().size();
+        if(label_count > _shared_memory_ring->geometry().label_capacity)
+            THROW("The batch has " + TOSTR(label_count) + " labels, the shared memory slots hold " + TOSTR(_shared_memory_ring->geometry().label_capacity))
+        memcpy(_shared_memory_ring->write_labels(), labels->get_label_batch().data(), sizeof(int) * label_count);
+    }
+    _shared_memory_ring->commit(label_count);
+    return Status::OK;
+}
+
 const std::pair<ImageNameBatch,pMetaDataBatch>& MasterGraph::meta_data()
 {
     if(_ring_buffer.level() == 0)
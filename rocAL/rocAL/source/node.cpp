@@ -39,15 +39,10 @@ Node::create(std::shared_ptr<Graph> graph)
 
     if(!_inputs.empty())
     {
-        vx_status width_status, height_status;
-        std::vector<uint32_t> roi_width(_batch_size, _inputs[0]->info().width());
-        std::vector<uint32_t> roi_height(_batch_size, _inputs[0]->info().height_single());
-        _src_roi_width = vxCreateArray(vxGetContext((vx_reference) _graph->get()), VX_TYPE_UINT32, _batch_size);
-        _src_roi_height = vxCreateArray(vxGetContext((vx_reference) _graph->get()), VX_TYPE_UINT32, _batch_size);
-        width_status = vxAddArrayItems(_src_roi_width, _batch_size, roi_width.data(), sizeof(vx_uint32));
-        height_status = vxAddArrayItems(_src_roi_height, _batch_size, roi_height.data(), sizeof(vx_uint32));
-        if (width_status != 0 || height_status != 0)
-            THROW(" vxAddArrayItems failed : " + TOSTR(width_status) + "  " + TOSTR(height_status))
+        // Nodes whose inputs share the ROI vectors also share the width/height arrays, published once per batch
+        auto roi = _graph->roi_arrays(_inputs[0]->info().get_roi_width(), _inputs[0]->info().get_roi_height(), _batch_size);
+        _src_roi_width = roi.first;
+        _src_roi_height = roi.second;
     }
 
     create_node();
@@ -63,9 +58,5 @@ Node::update_parameters()
 void
 Node::update_src_roi()
 {
-    vx_status width_status, height_status;
-    width_status = vxCopyArrayRange((vx_array)_src_roi_width, 0, _batch_size, sizeof(vx_uint32), _inputs[0]->info().get_roi_width(), VX_WRITE_ONLY, VX_MEMORY_TYPE_HOST);
-    height_status = vxCopyArrayRange((vx_array)_src_roi_height, 0, _batch_size, sizeof(vx_uint32), _inputs[0]->info().get_roi_height(), VX_WRITE_ONLY, VX_MEMORY_TYPE_HOST);
-    if(width_status != 0 || height_status != 0)
-        THROW(" Failed calling vxCopyArrayRange for width / height status : "+ TOSTR(width_status) + " / "+ TOSTR(height_status))
-}
\ No newline at end of file
+    _graph->publish_roi(_inputs[0]->info().get_roi_width(), _inputs[0]->info().get_roi_height(), _batch_size);
+}
@@ -66,3 +66,15 @@ void BrightnessNode::update_node()
     _beta.update_array();
 }
 
+vx_uint32 BrightnessNode::pointwise_op() const
+{
+    return VX_RPP_POINTWISE_BRIGHTNESS;
+}
+
+void BrightnessNode::append_pointwise_params(std::vector<float> &params, PipelineRandom &random, unsigned batch_size)
+{
+    auto& alpha = _alpha.next_batch_values(random, batch_size);
+    params.insert(params.end(), alpha.begin(), alpha.end());
+    auto& beta = _beta.next_batch_values(random, batch_size);
+    params.insert(params.end(), beta.begin(), beta.end());
+}
@@ -74,4 +74,21 @@ void ColorTwistBatchNode::update_node()
     _beta.update_array();
     _hue.update_array();
     _sat.update_array();
-}
\ No newline at end of file
+}
+
+vx_uint32 ColorTwistBatchNode::pointwise_op() const
+{
+    return VX_RPP_POINTWISE_COLOR_TWIST;
+}
+
+void ColorTwistBatchNode::append_pointwise_params(std::vector<float> &params, PipelineRandom &random, unsigned batch_size)
+{
+    auto& alpha = _alpha.next_batch_values(random, batch_size);
+    params.insert(params.end(), alpha.begin(), alpha.end());
+    auto& beta = _beta.next_batch_values(random, batch_size);
+    params.insert(params.end(), beta.begin(), beta.end());
+    auto& hue = _hue.next_batch_values(random, batch_size);
+    params.insert(params.end(), hue.begin(), hue.end());
+    auto& sat = _sat.next_batch_values(random, batch_size);
+    params.insert(params.end(), sat.begin(), sat.end());
+}
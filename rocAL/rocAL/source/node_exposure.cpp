@@ -57,4 +57,15 @@ void ExposureNode::init(FloatParam* shfit)
 void ExposureNode::update_node()
 {
     _shift.update_array();
-}
\ No newline at end of file
+}
+
+vx_uint32 ExposureNode::pointwise_op() const
+{
+    return VX_RPP_POINTWISE_EXPOSURE;
+}
+
+void ExposureNode::append_pointwise_params(std::vector<float> &params, PipelineRandom &random, unsigned batch_size)
+{
+    auto& shift = _shift.next_batch_values(random, batch_size);
+    params.insert(params.end(), shift.begin(), shift.end());
+}
@@ -0,0 +1,98 @@
+/*
+Copyright (c) 2019 - 2022 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include <vx_ext_rpp.h>
+#include "node_fused_pointwise.h"
+#include "exception.h"
+
+FusedPointwiseNode::FusedPointwiseNode(const std::vector<Image *> &inputs, const std::vector<Image *> &outputs) :
+        Node(inputs, outputs)
+{
+}
+
+FusedPointwiseNode::~FusedPointwiseNode()
+{
+    if(_ops_array)
+        vxReleaseArray(&_ops_array);
+    if(_params_array)
+        vxReleaseArray(&_params_array);
+}
+
+bool FusedPointwiseNode::can_fuse(const std::shared_ptr<Node> &node)
+{
+    auto op = dynamic_cast<PointwiseOp*>(node.get());
+    if(!op || node->input().size() != 1 || node->output().size() != 1)
+        return false;
+    auto color_format = node->input()[0]->info().color_format();
+    if(color_format == RaliColorFormat::U8)
+        // hue, saturation and color twist are defined on RGB images only
+        return op->pointwise_op() < VX_RPP_POINTWISE_HUE;
+    return color_format == RaliColorFormat::RGB24 || color_format == RaliColorFormat::BGR24;
+}
+
+void FusedPointwiseNode::init(const std::vector<std::shared_ptr<Node>> &chain)
+{
+    _chain = chain;
+    for(auto& node: _chain)
+    {
+        auto op = dynamic_cast<PointwiseOp*>(node.get());
+        if(!op)
+            THROW("Only pointwise nodes can be fused")
+        _ops.push_back(op);
+    }
+}
+
+void FusedPointwiseNode::create_node()
+{
+    if(_node)
+        return;
+
+    std::vector<vx_uint32> ops;
+    for(auto op: _ops)
+        ops.push_back(op->pointwise_op());
+    _params.clear();
+    for(auto op: _ops)
+        op->append_pointwise_params(_params, _graph->random(), _batch_size);
+
+    vx_context context = vxGetContext((vx_reference)_graph->get());
+    _ops_array = vxCreateArray(context, VX_TYPE_UINT32, ops.size());
+    _params_array = vxCreateArray(context, VX_TYPE_FLOAT32, _params.size());
+    vx_status status;
+    if((status = vxAddArrayItems(_ops_array, ops.size(), ops.data(), sizeof(vx_uint32))) != VX_SUCCESS ||
+       (status = vxAddArrayItems(_params_array, _params.size(), _params.data(), sizeof(float))) != VX_SUCCESS)
+        THROW("Creating the fused pointwise arrays failed: "+ TOSTR(status))
+
+    _node = vxExtrppNode_FusedPointwisebatchPD(_graph->get(), _inputs[0]->handle(), _src_roi_width, _src_roi_height, _outputs[0]->handle(), _ops_array, _params_array, _batch_size);
+
+    if((status = vxGetStatus((vx_reference)_node)) != VX_SUCCESS)
+        THROW("Adding the fused pointwise (vxExtrppNode_FusedPointwisebatchPD) node failed: "+ TOSTR(status))
+}
+
+void FusedPointwiseNode::update_node()
+{
+    _params.clear();
+    for(auto op: _ops)
+        op->append_pointwise_params(_params, _graph->random(), _batch_size);
+    vx_status status = vxCopyArrayRange(_params_array, 0, _params.size(), sizeof(float), _params.data(), VX_WRITE_ONLY, VX_MEMORY_TYPE_HOST);
+    if(status != VX_SUCCESS)
+        THROW("vxCopyArrayRange failed in the fused pointwise node: "+ TOSTR(status))
+}
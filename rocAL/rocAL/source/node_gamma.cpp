@@ -63,4 +63,15 @@ void GammaNode::init(FloatParam* shfit)
 void GammaNode::update_node()
 {
      _shift.update_array();
-}
\ No newline at end of file
+}
+
+vx_uint32 GammaNode::pointwise_op() const
+{
+    return VX_RPP_POINTWISE_GAMMA_CORRECTION;
+}
+
+void GammaNode::append_pointwise_params(std::vector<float> &params, PipelineRandom &random, unsigned batch_size)
+{
+    auto& shift = _shift.next_batch_values(random, batch_size);
+    params.insert(params.end(), shift.begin(), shift.end());
+}
@@ -60,3 +60,14 @@ void HueNode::update_node()
 {
      _hue.update_array();
 }
+
+vx_uint32 HueNode::pointwise_op() const
+{
+    return VX_RPP_POINTWISE_HUE;
+}
+
+void HueNode::append_pointwise_params(std::vector<float> &params, PipelineRandom &random, unsigned batch_size)
+{
+    auto& hue = _hue.next_batch_values(random, batch_size);
+    params.insert(params.end(), hue.begin(), hue.end());
+}
@@ -59,4 +59,15 @@ void SatNode::init(FloatParam* sat)
 void SatNode::update_node()
 {
      _sat.update_array();
-}
\ No newline at end of file
+}
+
+vx_uint32 SatNode::pointwise_op() const
+{
+    return VX_RPP_POINTWISE_SATURATION;
+}
+
+void SatNode::append_pointwise_params(std::vector<float> &params, PipelineRandom &random, unsigned batch_size)
+{
+    auto& sat = _sat.next_batch_values(random, batch_size);
+    params.insert(params.end(), sat.begin(), sat.end());
+}
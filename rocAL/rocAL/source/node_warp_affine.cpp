@@ -44,18 +44,7 @@ void WarpAffineNode::create_node()
 
     vx_status width_status, height_status;
     _affine.resize(6 * _batch_size);
-
-    uint batch_size = _batch_size;
-    for (uint i=0; i < batch_size; i++ )
-    {
-         _affine[i*6 + 0] = _x0.renew();
-         _affine[i*6 + 1] = _y0.renew();
-         _affine[i*6 + 2] = _x1.renew();
-         _affine[i*6 + 3] = _y1.renew();
-         _affine[i*6 + 4] = _o0.renew();
-         _affine[i*6 + 5] = _o1.renew();
-
-    }
+    fill_affine_values();
     _dst_roi_width = vxCreateArray(vxGetContext((vx_reference)_graph->get()), VX_TYPE_UINT32, _batch_size);
     _dst_roi_height = vxCreateArray(vxGetContext((vx_reference)_graph->get()), VX_TYPE_UINT32, _batch_size);
     std::vector<uint32_t> dst_roi_width(_batch_size,_outputs[0]->info().width());
@@ -75,17 +64,21 @@ void WarpAffineNode::create_node()
         THROW("Adding the warp affine (vxExtrppNode_WarpAffinePD) node failed: "+ TOSTR(status))
 }
 
-void WarpAffineNode::update_affine_array()
+void WarpAffineNode::fill_affine_values()
 {
-    for (uint i = 0; i < _batch_size; i++ )
+    // each coefficient draws the values of the whole batch, the matrices interleave them
+    ParameterVX<float>* coefficients[6] = { &_x0, &_y0, &_x1, &_y1, &_o0, &_o1 };
+    for (uint c = 0; c < 6; c++)
     {
-        _affine[i*6 + 0] = _x0.renew();
-        _affine[i*6 + 1] = _y0.renew();
-        _affine[i*6 + 2] = _x1.renew();
-        _affine[i*6 + 3] = _y1.renew();
-        _affine[i*6 + 4] = _o0.renew();
-        _affine[i*6 + 5] = _o1.renew();
+        auto& values = coefficients[c]->next_batch_values(_graph->random(), _batch_size);
+        for (uint i = 0; i < _batch_size; i++ )
+            _affine[i*6 + c] = values[i];
     }
+}
+
+void WarpAffineNode::update_affine_array()
+{
+    fill_affine_values();
     vx_status affine_status;
     affine_status = vxCopyArrayRange((vx_array)_affine_array, 0, _batch_size * 6, sizeof(vx_float32), _affine.data(), VX_WRITE_ONLY, VX_MEMORY_TYPE_HOST); //vxAddArrayItems(_width_array,_batch_size, _width, sizeof(vx_uint32));
     if(affine_status != 0)
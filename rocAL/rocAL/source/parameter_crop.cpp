@@ -63,6 +63,8 @@ void CropParam::array_init()
 
 void CropParam::create_array(std::shared_ptr<Graph> graph)
 {
+    _graph = graph;
+    _param_id = _graph->random().create_param_id();
     array_init();
     x1_arr =    vxCreateArray(vxGetContext((vx_reference)graph->get()), VX_TYPE_UINT32,batch_size);
     cropw_arr = vxCreateArray(vxGetContext((vx_reference)graph->get()), VX_TYPE_UINT32,batch_size);
@@ -79,6 +81,11 @@ void CropParam::create_array(std::shared_ptr<Graph> graph)
     update_array();
 }
 
+RandomBatch CropParam::random_batch() const
+{
+    return _graph->random().batch(_param_id, batch_size);
+}
+
 void CropParam::update_crop_array()
 {
     vx_status status = VX_SUCCESS;
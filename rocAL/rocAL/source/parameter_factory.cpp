@@ -99,17 +99,6 @@ ParameterFactory::~ParameterFactory() {
                 rand_obj);
 }
 
-void ParameterFactory::renew_parameters()
-{
-    for(auto&& rand_obj : _parameters)
-        std::visit(
-                [](auto&& arg)
-                {
-                    arg->renew();
-                },
-                rand_obj);
-}
-
 unsigned
 ParameterFactory::get_seed()
 {
@@ -124,34 +113,34 @@ ParameterFactory::set_seed(unsigned seed)
 
 IntParam* ParameterFactory::create_uniform_int_rand_param(int start, int end)
 {
-    auto gen = new UniformRand<int>(start, end, _seed);
+    auto gen = new UniformRand<int>(start, end, _seed, _next_param_id++);
     auto ret = new IntParam(gen, RaliParameterType::RANDOM_UNIFORM);
-    _parameters.insert(gen);
+    register_param(gen);
     return ret;
 }
 
 FloatParam* ParameterFactory::create_uniform_float_rand_param(float start, float end)
 {
-    auto gen = new UniformRand<float>(start, end, _seed);
+    auto gen = new UniformRand<float>(start, end, _seed, _next_param_id++);
     auto ret = new FloatParam(gen, RaliParameterType::RANDOM_UNIFORM);
-    _parameters.insert(gen);
+    register_param(gen);
     return ret;
 }
 
 
 IntParam* ParameterFactory::create_custom_int_rand_param(const int *value, const double *frequencies, size_t size)
 {
-    auto gen = new CustomRand<int>(value, frequencies, size, _seed);
+    auto gen = new CustomRand<int>(value, frequencies, size, _seed, _next_param_id++);
     auto ret = new IntParam(gen, RaliParameterType::RANDOM_CUSTOM);
-    _parameters.insert(gen);
+    register_param(gen);
     return ret;
 }
 
 FloatParam* ParameterFactory::create_custom_float_rand_param(const float *value, const double *frequencies, size_t size)
 {
-    auto gen = new CustomRand<float>(value, frequencies, size, _seed);
+    auto gen = new CustomRand<float>(value, frequencies, size, _seed, _next_param_id++);
     auto ret = new FloatParam(gen, RaliParameterType::RANDOM_CUSTOM);
-    _parameters.insert(gen);
+    register_param(gen);
     return ret;
 }
 
@@ -160,7 +149,7 @@ IntParam* ParameterFactory::create_single_value_int_param(int value)
 {
     auto gen = new SimpleParameter<int>(value);
     auto ret = new IntParam(gen, RaliParameterType::DETERMINISTIC);
-    _parameters.insert(gen);
+    register_param(gen);
     return ret;
 }
 
@@ -168,7 +157,7 @@ FloatParam* ParameterFactory::create_single_value_float_param(float value)
 {
     auto gen = new SimpleParameter<float>(value);
     auto ret = new FloatParam(gen, RaliParameterType::DETERMINISTIC);
-    _parameters.insert(gen);
+    register_param(gen);
     return ret;
 }
 
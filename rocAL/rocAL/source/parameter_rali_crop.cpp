@@ -51,6 +51,7 @@ void RaliCropParam::update_array()
 
 void RaliCropParam::fill_crop_dims()
 {
+    auto batch = random_batch();
     for(uint img_idx =0; img_idx < batch_size; img_idx++)
     {
         if(!(_random))
@@ -64,17 +65,12 @@ void RaliCropParam::fill_crop_dims()
         else
         {
             float crop_h_factor_, crop_w_factor_, x_drift, y_drift;
-            crop_height_factor->renew();
-            crop_h_factor_ = crop_height_factor->get();
-            crop_width_factor->renew();
-            crop_w_factor_ = crop_width_factor->get();   
+            crop_h_factor_ = crop_height_factor->draw(batch, img_idx, 0);
+            crop_w_factor_ = crop_width_factor->draw(batch, img_idx, 1);
             cropw_arr_val[img_idx] = static_cast<size_t> (crop_w_factor_ * in_width[img_idx]);
             croph_arr_val[img_idx] = static_cast<size_t> (crop_h_factor_ * in_height[img_idx]);
-            x_drift_factor->renew();
-            y_drift_factor->renew();
-            y_drift_factor->renew();
-            x_drift = x_drift_factor->get();
-            y_drift = y_drift_factor->get();
+            x_drift = x_drift_factor->draw(batch, img_idx, 2);
+            y_drift = y_drift_factor->draw(batch, img_idx, 3);
             x1_arr_val[img_idx] = static_cast<size_t>(x_drift * (in_width[img_idx]  - cropw_arr_val[img_idx]));
             y1_arr_val[img_idx] = static_cast<size_t>(y_drift * (in_height[img_idx] - croph_arr_val[img_idx]));
         }
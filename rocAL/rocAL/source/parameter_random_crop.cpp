@@ -61,25 +61,21 @@ void RaliRandomCropParam::fill_crop_dims()
     {
         return (h < height && w < width); 
     };
+    auto batch = random_batch();
     for(uint img_idx = 0; img_idx < batch_size; img_idx++)
     {
-        // Try for num_of_attempts time to get a good crop
+        // Try for num_of_attempts time to get a good crop, each attempt draws its own 4 values
         for(int i=0; i < num_of_attempts; i++)
         {
-            area_factor->renew();
-            aspect_ratio->renew();
-            crop_area_factor  = area_factor->get();
-            crop_aspect_ratio = aspect_ratio->get();
+            crop_area_factor  = area_factor->draw(batch, img_idx, i * 4);
+            crop_aspect_ratio = aspect_ratio->draw(batch, img_idx, i * 4 + 1);
             target_area = crop_area_factor * in_height[img_idx] * in_width[img_idx];
             cropw_arr_val[img_idx] = static_cast<size_t>(std::sqrt(target_area * crop_aspect_ratio));
             croph_arr_val[img_idx] = static_cast<size_t>(std::sqrt(target_area * (1 / crop_aspect_ratio)));  
             if(is_valid_crop(croph_arr_val[img_idx], cropw_arr_val[img_idx], in_height[img_idx], in_width[img_idx])) 
             {
-                x_drift_factor->renew();
-                y_drift_factor->renew();
-                y_drift_factor->renew();
-                x_drift = x_drift_factor->get();
-                y_drift = y_drift_factor->get();
+                x_drift = x_drift_factor->draw(batch, img_idx, i * 4 + 2);
+                y_drift = y_drift_factor->draw(batch, img_idx, i * 4 + 3);
                 x1_arr_val[img_idx] = static_cast<size_t>(x_drift * (in_width[img_idx]  - cropw_arr_val[img_idx]));
                 y1_arr_val[img_idx] = static_cast<size_t>(y_drift * (in_height[img_idx] - croph_arr_val[img_idx]));
                 break;
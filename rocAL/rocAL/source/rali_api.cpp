@@ -100,6 +100,72 @@ raliRun(RaliContext p_context)
     return RALI_OK;
 }
 
+RaliStatus RALI_API_CALL
+raliSetPointwiseFusion(RaliContext p_context, bool enable)
+{
+    auto context = static_cast<Context*>(p_context);
+    try
+    {
+        context->master_graph->set_pointwise_fusion(enable);
+    }
+    catch(const std::exception& e)
+    {
+        context->capture_error(e.what());
+        ERR(e.what())
+        return RALI_RUNTIME_ERROR;
+    }
+    return RALI_OK;
+}
+
+RaliStatus RALI_API_CALL
+raliSetFileReadOptions(RaliContext p_context, unsigned readahead_count, RaliFileReadMode mode)
+{
+    auto context = static_cast<Context*>(p_context);
+    try
+    {
+        FileReadMode read_mode;
+        switch(mode)
+        {
+            case RALI_FILE_READ_BUFFERED:
+                read_mode = FileReadMode::BUFFERED;
+                break;
+            case RALI_FILE_READ_DROP_CACHE:
+                read_mode = FileReadMode::DROP_CACHE;
+                break;
+            case RALI_FILE_READ_DIRECT:
+                read_mode = FileReadMode::DIRECT;
+                break;
+            default:
+                THROW("Unsupported file read mode " + TOSTR(mode))
+        }
+        context->master_graph->set_file_read_options(readahead_count, read_mode);
+    }
+    catch(const std::exception& e)
+    {
+        context->capture_error(e.what());
+        ERR(e.what())
+        return RALI_RUNTIME_ERROR;
+    }
+    return RALI_OK;
+}
+
+RaliStatus RALI_API_CALL
+raliSetDecodedImageCache(RaliContext p_context, size_t memory_budget_mb, const char* spill_path)
+{
+    auto context = static_cast<Context*>(p_context);
+    try
+    {
+        context->master_graph->set_decoded_image_cache(memory_budget_mb * 1024 * 1024, spill_path ? spill_path : "");
+    }
+    catch(const std::exception& e)
+    {
+        context->capture_error(e.what());
+        ERR(e.what())
+        return RALI_RUNTIME_ERROR;
+    }
+    return RALI_OK;
+}
+
 RaliStatus RALI_API_CALL
 raliVerify(RaliContext p_context)
 {
@@ -92,3 +92,105 @@ raliCopyToOutput(
 
 
 
+
+RaliStatus RALI_API_CALL
+raliCreateSharedMemoryOutput(RaliContext p_context, const char* name, unsigned slot_count, unsigned max_consumers)
+{
+    auto context = static_cast<Context*>(p_context);
+    try
+    {
+        context->master_graph->create_shared_memory_output(name, slot_count, max_consumers);
+    }
+    catch(const std::exception& e)
+    {
+        context->capture_error(e.what());
+        ERR(e.what())
+        return RALI_RUNTIME_ERROR;
+    }
+    return RALI_OK;
+}
+
+RaliStatus RALI_API_CALL
+raliPublishToSharedMemory(RaliContext p_context)
+{
+    auto context = static_cast<Context*>(p_context);
+    try
+    {
+        if(context->master_graph->publish_to_shared_memory() == MasterGraph::Status::NO_MORE_DATA)
+            return RALI_NO_MORE_DATA;
+    }
+    catch(const std::exception& e)
+    {
+        context->capture_error(e.what());
+        ERR(e.what())
+        return RALI_RUNTIME_ERROR;
+    }
+    return RALI_OK;
+}
+
+RaliSharedMemoryConsumer RALI_API_CALL
+raliAttachSharedMemory(const char* name, unsigned shard_id, unsigned num_shards)
+{
+    try
+    {
+        return SharedMemoryRing::attach(name, shard_id, num_shards);
+    }
+    catch(const std::exception& e)
+    {
+        ERR(e.what())
+    }
+    return nullptr;
+}
+
+RaliStatus RALI_API_CALL
+raliAcquireSharedMemoryBatch(RaliSharedMemoryConsumer p_consumer, RaliSharedMemoryBatch* batch, int timeout_ms)
+{
+    auto consumer = static_cast<SharedMemoryRing*>(p_consumer);
+    if(!consumer || !batch)
+        return RALI_CONTEXT_INVALID;
+    try
+    {
+        SharedMemoryRing::Batch slot;
+        auto status = consumer->acquire_read_slot(slot, timeout_ms);
+        if(status == SharedMemoryRing::Status::END_OF_DATA)
+            return RALI_NO_MORE_DATA;
+        if(status == SharedMemoryRing::Status::TIMEOUT)
+            return RALI_TIMEOUT;
+        auto& geometry = consumer->geometry();
+        batch->sequence = slot.sequence;
+        batch->images = slot.images;
+        batch->labels = slot.labels;
+        batch->label_count = slot.label_count;
+        batch->width = geometry.width;
+        batch->height = geometry.height;
+        batch->channels = geometry.channels;
+        batch->batch_size = geometry.batch_size;
+        batch->output_count = geometry.output_count;
+    }
+    catch(const std::exception& e)
+    {
+        ERR(e.what())
+        return RALI_RUNTIME_ERROR;
+    }
+    return RALI_OK;
+}
+
+RaliStatus RALI_API_CALL
+raliReleaseSharedMemoryBatch(RaliSharedMemoryConsumer p_consumer)
+{
+    auto consumer = static_cast<SharedMemoryRing*>(p_consumer);
+    if(!consumer)
+        return RALI_CONTEXT_INVALID;
+    consumer->release_read_slot();
+    return RALI_OK;
+}
+
+RaliStatus RALI_API_CALL
+raliDetachSharedMemory(RaliSharedMemoryConsumer p_consumer)
+{
+    auto consumer = static_cast<SharedMemoryRing*>(p_consumer);
+    if(!consumer)
+        return RALI_CONTEXT_INVALID;
+    delete consumer;
+    return RALI_OK;
+}
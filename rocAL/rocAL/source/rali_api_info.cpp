@@ -121,9 +121,20 @@ RALI_API_CALL raliGetTimingInfo(RaliContext p_context)
     //INFO("shuffle time "+ TOSTR(info.shuffle_time)); to display time taken for shuffling dataset
     //INFO("bbencode time "+ TOSTR(info.bb_process_time)); //to display time taken for bbox encoder
     if (context->master_graph->is_video_loader())
-        return {info.video_read_time, info.video_decode_time, info.video_process_time, info.copy_to_output};
-    else
-        return {info.image_read_time, info.image_decode_time, info.image_process_time, info.copy_to_output};
+        return {info.video_read_time, info.video_decode_time, info.video_process_time, info.copy_to_output, 0};
+    auto cache_lookups = info.image_cache_hits + info.image_cache_misses;
+    float cache_hit_rate = cache_lookups ? (float)info.image_cache_hits / cache_lookups : 0;
+    return {info.image_read_time, info.image_decode_time, info.image_process_time, info.copy_to_output, cache_hit_rate};
+}
+
+float
+RALI_API_CALL raliGetVideoDecodedFramesPerOutputFrame(RaliContext p_context)
+{
+    auto context = static_cast<Context*>(p_context);
+    if (!context->master_graph->is_video_loader())
+        return 0;
+    auto info = context->timing();
+    return info.video_output_frames ? (float)info.video_decoded_frames / info.video_output_frames : 0;
 }
 
 RaliMetaData
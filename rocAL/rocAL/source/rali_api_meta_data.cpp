@@ -400,12 +400,12 @@ RALI_API_CALL raliGetSequenceFrameTimestamps(RaliContext p_context,  float* buf)
 }
 
 void RALI_API_CALL raliBoxEncoder(RaliContext p_context, std::vector<float>& anchors, float criteria,
-                                  std::vector<float> &means, std::vector<float> &stds, bool offset, float scale)
+                                  std::vector<float> &means, std::vector<float> &stds, bool offset, float scale, bool pipelined)
 {
     if (!p_context)
         THROW("Invalid rali context passed to raliBoxEncoder")
     auto context = static_cast<Context *>(p_context);
-    context->master_graph->box_encoder(anchors, criteria, means, stds, offset, scale);
+    context->master_graph->box_encoder(anchors, criteria, means, stds, offset, scale, pipelined);
 }
 
 void 
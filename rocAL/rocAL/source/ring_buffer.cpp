@@ -25,6 +25,8 @@ THE SOFTWARE.
 
 RingBuffer::RingBuffer(unsigned buffer_depth):
         BUFF_DEPTH(buffer_depth),
+        _index(buffer_depth),
+        _meta_data(buffer_depth),
         _dev_sub_buffer(buffer_depth),
         _host_master_buffers(BUFF_DEPTH)
 {
@@ -32,32 +34,21 @@ RingBuffer::RingBuffer(unsigned buffer_depth):
 }
 void RingBuffer::block_if_empty()
 {
-    std::unique_lock<std::mutex> lock(_lock);
-    if(empty())
-    { // if the current read buffer is being written wait on it
-        if(_dont_block)
-            return;
-        _wait_for_load.wait(lock);
-    }
+    // if the current read buffer is being written wait on it
+    _index.block_if_empty();
 }
 
 void RingBuffer:: block_if_full()
 {
-    std::unique_lock<std::mutex> lock(_lock);
     // Write the whole buffer except for the last spot which is being read by the reader thread
-    if(full())
-    {
-        if(_dont_block)
-            return;
-        _wait_for_unload.wait(lock);
-    }
+    _index.block_if_full();
 }
 std::vector<void*> RingBuffer::get_read_buffers()
 {
     block_if_empty();
     if((_mem_type == RaliMemType::OCL) || (_mem_type == RaliMemType::HIP))
-        return _dev_sub_buffer[_read_ptr];
-    return _host_sub_buffers[_read_ptr];
+        return _dev_sub_buffer[_index.read_index()];
+    return _host_sub_buffers[_index.read_index()];
 }
 
 void *RingBuffer::get_host_master_read_buffer() {
@@ -65,7 +56,7 @@ void *RingBuffer::get_host_master_read_buffer() {
     if((_mem_type == RaliMemType::OCL) || (_mem_type == RaliMemType::HIP))
         return nullptr;
 
-    return _host_master_buffers[_read_ptr];
+    return _host_master_buffers[_index.read_index()];
 }
 
 
@@ -73,23 +64,21 @@ std::vector<void*> RingBuffer::get_write_buffers()
 {
     block_if_full();
     if((_mem_type == RaliMemType::OCL) || (_mem_type == RaliMemType::HIP))
-        return _dev_sub_buffer[_write_ptr];
+        return _dev_sub_buffer[_index.write_index()];
 
-    return _host_sub_buffers[_write_ptr];
+    return _host_sub_buffers[_index.write_index()];
 }
 
 
 void RingBuffer::unblock_reader()
 {
     // Wake up the reader thread in case it's waiting for a load
-    _wait_for_load.notify_all();
+    _index.unblock_reader();
 }
 
 void RingBuffer::release_all_blocked_calls()
 {
-    _dont_block = true;
-    unblock_reader();
-    unblock_writer();
+    _index.release_all_blocked_calls();
 }
 
 void RingBuffer::release_if_empty()
@@ -100,7 +89,7 @@ void RingBuffer::release_if_empty()
 void RingBuffer::unblock_writer()
 {
     // Wake up the writer thread in case it's waiting for an unload
-    _wait_for_unload.notify_all();
+    _index.unblock_writer();
 }
 
 #if !ENABLE_HIP
@@ -209,30 +198,23 @@ void RingBuffer::initHip(RaliMemType mem_type, DeviceResourcesHip dev, unsigned
 
 void RingBuffer::push()
 {
-    // pushing and popping to and from image and metadata buffer should be atomic so that their level stays the same at all times
-    std::unique_lock<std::mutex> lock(_names_buff_lock);
-    _meta_ring_buffer.push(_last_image_meta_data);
-    increment_write_ptr();
+    // The metadata slot sits next to the image slot, publishing the write index makes both visible to the reader at once
+    _index.push();
 }
 
 void RingBuffer::pop()
 {
     if(empty())
         return;
-    // pushing and popping to and from image and metadata buffer should be atomic so that their level stays the same at all times
-    std::unique_lock<std::mutex> lock(_names_buff_lock);
-    increment_read_ptr();
-    _meta_ring_buffer.pop();
+    // Releasing the read index hands both the image and the metadata slot back to the writer
+    _index.pop();
 }
 
 void RingBuffer::reset()
 {
-    _write_ptr = 0;
-    _read_ptr = 0;
-    _level = 0;
-    _dont_block = false;
-    while(!_meta_ring_buffer.empty())
-        _meta_ring_buffer.pop();
+    _index.reset();
+    for(auto& meta_data: _meta_data)
+        meta_data = MetaDataNamePair();
 }
 
 void RingBuffer::release_gpu_res()
@@ -277,50 +259,30 @@ RingBuffer::~RingBuffer()
 
 bool RingBuffer::empty()
 {
-    return (_level <= 0);
+    return _index.empty();
 }
 
 bool RingBuffer::full()
 {
-    return (_level >= BUFF_DEPTH - 1);
+    return _index.full();
 }
 
 size_t RingBuffer::level()
 {
-    return _level;
-}
-void RingBuffer::increment_read_ptr()
-{
-    std::unique_lock<std::mutex> lock(_lock);
-    _read_ptr = (_read_ptr+1)%BUFF_DEPTH;
-    _level--;
-    lock.unlock();
-    // Wake up the writer thread (in case waiting) since there is an empty spot to write to,
-    _wait_for_unload.notify_all();
-
-}
-
-void RingBuffer::increment_write_ptr()
-{
-    std::unique_lock<std::mutex> lock(_lock);
-    _write_ptr = (_write_ptr+1)%BUFF_DEPTH;
-    _level++;
-    lock.unlock();
-    // Wake up the reader thread (in case waiting) since there is a new load to be read
-    _wait_for_load.notify_all();
+    return _index.level();
 }
 
 void RingBuffer::set_meta_data( ImageNameBatch names, pMetaDataBatch meta_data)
 {
-    _last_image_meta_data = std::move(std::make_pair(std::move(names), meta_data));
+    // Called by the writer after get_write_buffers(), the slot at the write index is not visible to the reader until push()
+    _meta_data[_index.write_index()] = std::make_pair(std::move(names), meta_data);
 }
 
 MetaDataNamePair& RingBuffer::get_meta_data()
 {
     block_if_empty();
-    std::unique_lock<std::mutex> lock(_names_buff_lock);
-    if(_level != _meta_ring_buffer.size())
-        THROW("ring buffer internals error, image and metadata sizes not the same "+TOSTR(_level) + " != "+TOSTR(_meta_ring_buffer.size()))
-    return  _meta_ring_buffer.front();
+    if(empty())
+        THROW("ring buffer internals error, no metadata available to read")
+    return  _meta_data[_index.read_index()];
 }
 
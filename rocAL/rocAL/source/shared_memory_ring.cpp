@@ -0,0 +1,377 @@
+/*
+Copyright (c) 2019 - 2022 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <climits>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <fcntl.h>
+#include <linux/futex.h>
+#include <signal.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#include "commons.h"
+#include "shared_memory_ring.h"
+
+namespace
+{
+    constexpr uint32_t SHARED_MEMORY_RING_MAGIC = 0x4c415253; // "SRAL"
+    constexpr uint32_t SHARED_MEMORY_RING_VERSION = 2;
+    constexpr size_t PAGE_ALIGNMENT = 4096;
+    // Longest time a side sleeps before checking that the other side is still alive
+    constexpr int LIVENESS_CHECK_MS = 100;
+    enum ConsumerState : uint32_t { FREE = 0, CLAIMING, ACTIVE };
+
+    size_t align_up(size_t value, size_t alignment) { return (value + alignment - 1) / alignment * alignment; }
+    std::string segment_name(const std::string& name) { return (!name.empty() && name[0] == '/') ? name : "/" + name; }
+}
+
+struct SharedMemoryRing::Header
+{
+    uint32_t magic;
+    uint32_t version;
+    uint32_t slot_count;
+    uint32_t max_consumers;
+    uint64_t slots_offset;//!< Offset of the first slot from the start of the segment
+    uint64_t slot_stride;
+    uint64_t labels_offset;//!< Offset of the labels within a slot
+    Geometry geometry;
+    pid_t producer_pid;
+    std::atomic<uint32_t> closed;
+    alignas(64) std::atomic<uint64_t> write_count;//!< Number of published batches, written by the producer only
+    alignas(64) std::atomic<uint32_t> producer_event;//!< futex word the producer waits on for a slot to be released
+    alignas(64) std::atomic<uint32_t> consumer_event;//!< futex word the consumers wait on for a batch to be published
+};
+
+struct SharedMemoryRing::ConsumerEntry
+{
+    std::atomic<uint32_t> state;
+    std::atomic<pid_t> pid;
+    uint32_t shard_id;
+    uint32_t num_shards;
+    std::atomic<uint64_t> released_upto;//!< The consumer is done with all of its sequences below this one
+    char pad[64 - 2 * sizeof(uint32_t) - sizeof(pid_t) - sizeof(uint32_t) - sizeof(uint64_t)];
+};
+
+struct SharedMemoryRing::SlotEntry
+{
+    std::atomic<uint64_t> sequence;
+    uint32_t label_count;
+};
+
+SharedMemoryRing::~SharedMemoryRing()
+{
+    if(_header && !_is_producer && _consumer_idx >= 0)
+    {
+        // Detaching releases whatever this consumer still holds
+        consumers()[_consumer_idx].state.store(FREE, std::memory_order_seq_cst);
+        wake(_header->producer_event);
+    }
+    if(_base)
+        munmap(_base, _size);
+    if(_is_producer)
+        shm_unlink(_name.c_str());
+}
+
+void SharedMemoryRing::map(int fd, size_t size)
+{
+    _base = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if(_base == MAP_FAILED)
+    {
+        _base = nullptr;
+        THROW("Mapping the shared memory segment " + _name + " failed: " + STR(strerror(errno)))
+    }
+    _size = size;
+    _header = static_cast<Header*>(_base);
+}
+
+SharedMemoryRing* SharedMemoryRing::create(const std::string& name, const Geometry& geometry, unsigned slot_count, unsigned max_consumers)
+{
+    if(slot_count < 2 || max_consumers < 1)
+        THROW("The shared memory ring needs at least two slots and one consumer")
+    std::unique_ptr<SharedMemoryRing> ring(new SharedMemoryRing());
+    ring->_name = segment_name(name);
+    ring->_is_producer = true;
+
+    const size_t labels_offset = align_up(geometry.image_bytes, 64);
+    const size_t slot_stride = align_up(labels_offset + sizeof(int) * geometry.label_capacity, PAGE_ALIGNMENT);
+    const size_t slots_offset = align_up(sizeof(Header) + sizeof(ConsumerEntry) * max_consumers + sizeof(SlotEntry) * slot_count, PAGE_ALIGNMENT);
+    const size_t size = slots_offset + slot_stride * slot_count;
+
+    // A segment left behind by a producer that crashed is replaced, consumers still mapping it keep their copy
+    shm_unlink(ring->_name.c_str());
+    int fd = shm_open(ring->_name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if(fd < 0)
+        THROW("Creating the shared memory segment " + ring->_name + " failed: " + STR(strerror(errno)))
+    if(ftruncate(fd, size) != 0)
+    {
+        ::close(fd);
+        shm_unlink(ring->_name.c_str());
+        THROW("Sizing the shared memory segment " + ring->_name + " to " + TOSTR(size) + " bytes failed: " + STR(strerror(errno)))
+    }
+    ring->map(fd, size);
+
+    // ftruncate zero fills the segment, which is the initial state of all the atomics and of the FREE consumer entries
+    auto header = new (ring->_header) Header();
+    header->version = SHARED_MEMORY_RING_VERSION;
+    header->slot_count = slot_count;
+    header->max_consumers = max_consumers;
+    header->slots_offset = slots_offset;
+    header->slot_stride = slot_stride;
+    header->labels_offset = labels_offset;
+    header->geometry = geometry;
+    header->producer_pid = getpid();
+    header->write_count.store(0);
+    for(unsigned idx = 0; idx < max_consumers; idx++)
+        new (&ring->consumers()[idx]) ConsumerEntry();
+    for(unsigned idx = 0; idx < slot_count; idx++)
+        new (ring->slot(idx)) SlotEntry();
+    // Consumers only trust the segment once the magic number is there
+    std::atomic_thread_fence(std::memory_order_release);
+    reinterpret_cast<std::atomic<uint32_t>*>(&header->magic)->store(SHARED_MEMORY_RING_MAGIC, std::memory_order_release);
+    return ring.release();
+}
+
+SharedMemoryRing* SharedMemoryRing::attach(const std::string& name, unsigned shard_id, unsigned num_shards)
+{
+    if(num_shards < 1 || shard_id >= num_shards)
+        THROW("Invalid shard " + TOSTR(shard_id) + " of " + TOSTR(num_shards) + " for the shared memory consumer")
+    std::unique_ptr<SharedMemoryRing> ring(new SharedMemoryRing());
+    ring->_name = segment_name(name);
+
+    int fd = shm_open(ring->_name.c_str(), O_RDWR, 0);
+    if(fd < 0)
+        THROW("Opening the shared memory segment " + ring->_name + " failed: " + STR(strerror(errno)))
+    struct stat st;
+    if(fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(Header))
+    {
+        ::close(fd);
+        THROW("The shared memory segment " + ring->_name + " is not ready")
+    }
+    ring->map(fd, st.st_size);
+    auto header = ring->_header;
+    if(reinterpret_cast<std::atomic<uint32_t>*>(&header->magic)->load(std::memory_order_acquire) != SHARED_MEMORY_RING_MAGIC ||
+       header->version != SHARED_MEMORY_RING_VERSION)
+        THROW("The shared memory segment " + ring->_name + " is not a rocAL ring or is not ready")
+
+    for(unsigned idx = 0; idx < header->max_consumers; idx++)
+    {
+        auto& entry = ring->consumers()[idx];
+        uint32_t expected = FREE;
+        if(!entry.state.compare_exchange_strong(expected, CLAIMING, std::memory_order_seq_cst))
+            continue;
+        entry.pid.store(getpid());
+        entry.shard_id = shard_id;
+        entry.num_shards = num_shards;
+        // Reading starts at the next batch to be published, older slots may be overwritten at any time
+        entry.released_upto.store(header->write_count.load(std::memory_order_seq_cst));
+        expected = CLAIMING;
+        if(!entry.state.compare_exchange_strong(expected, ACTIVE, std::memory_order_seq_cst))
+            THROW("The consumer entry " + TOSTR(idx) + " of " + ring->_name + " was reclaimed while attaching")
+        ring->_consumer_idx = idx;
+        wake(header->producer_event);
+        return ring.release();
+    }
+    THROW("All the " + TOSTR(header->max_consumers) + " consumer entries of " + ring->_name + " are in use")
+}
+
+const SharedMemoryRing::Geometry& SharedMemoryRing::geometry() const
+{
+    return _header->geometry;
+}
+
+SharedMemoryRing::ConsumerEntry* SharedMemoryRing::consumers() const
+{
+    return reinterpret_cast<ConsumerEntry*>(static_cast<unsigned char*>(_base) + sizeof(Header));
+}
+
+SharedMemoryRing::SlotEntry* SharedMemoryRing::slot(uint64_t sequence) const
+{
+    auto entries = reinterpret_cast<SlotEntry*>(reinterpret_cast<unsigned char*>(consumers() + _header->max_consumers));
+    return entries + sequence % _header->slot_count;
+}
+
+unsigned char* SharedMemoryRing::slot_data(uint64_t sequence) const
+{
+    return static_cast<unsigned char*>(_base) + _header->slots_offset + _header->slot_stride * (sequence % _header->slot_count);
+}
+
+bool SharedMemoryRing::process_alive(pid_t pid)
+{
+    if(pid <= 0 || (kill(pid, 0) != 0 && errno != EPERM))
+        return false;
+    // A process that exited but was not reaped yet still answers kill(), its state in /proc is Z
+    char path[64], line[512];
+    snprintf(path, sizeof(path), "/proc/%d/stat", (int)pid);
+    FILE* stat_file = fopen(path, "r");
+    if(!stat_file)
+        return true;
+    // The command name can contain spaces and parentheses, the state follows the last ')'
+    const char* name_end = fgets(line, sizeof(line), stat_file) ? strrchr(line, ')') : nullptr;
+    fclose(stat_file);
+    return !name_end || (name_end[1] != '\0' && name_end[2] != 'Z' && name_end[2] != 'X');
+}
+
+void SharedMemoryRing::wait(std::atomic<uint32_t>& event, uint32_t last_event, int timeout_ms)
+{
+    struct timespec timeout = { timeout_ms / 1000, (timeout_ms % 1000) * 1000000L };
+    // Not FUTEX_PRIVATE, the waiters and the wakers live in different processes
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&event), FUTEX_WAIT, last_event, &timeout, nullptr, 0);
+}
+
+void SharedMemoryRing::wake(std::atomic<uint32_t>& event)
+{
+    event.fetch_add(1, std::memory_order_seq_cst);
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(&event), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+}
+
+bool SharedMemoryRing::slot_released(uint64_t sequence) const
+{
+    for(unsigned idx = 0; idx < _header->max_consumers; idx++)
+    {
+        auto& entry = consumers()[idx];
+        if(entry.state.load(std::memory_order_seq_cst) != ACTIVE || sequence % entry.num_shards != entry.shard_id)
+            continue;
+        if(entry.released_upto.load(std::memory_order_seq_cst) <= sequence)
+            return false;
+    }
+    return true;
+}
+
+void SharedMemoryRing::reclaim_dead_consumers()
+{
+    for(unsigned idx = 0; idx < _header->max_consumers; idx++)
+    {
+        auto& entry = consumers()[idx];
+        // A CLAIMING entry may still hold the pid of its previous owner, only the attached consumers are checked
+        uint32_t state = ACTIVE;
+        if(entry.state.load(std::memory_order_seq_cst) != ACTIVE || process_alive(entry.pid.load()))
+            continue;
+        if(entry.state.compare_exchange_strong(state, FREE, std::memory_order_seq_cst))
+            WRN("Consumer process " + TOSTR(entry.pid.load()) + " of " + _name + " is gone, releasing its slots")
+    }
+}
+
+unsigned char* SharedMemoryRing::acquire_write_slot()
+{
+    if(!_is_producer)
+        THROW("Only the producer can write to the shared memory ring")
+    _write_sequence = _header->write_count.load(std::memory_order_relaxed);
+    const uint64_t slot_count = _header->slot_count;
+    auto ready = [&]()
+    {
+        bool any_consumer = false;
+        for(unsigned idx = 0; idx < _header->max_consumers && !any_consumer; idx++)
+            any_consumer = consumers()[idx].state.load(std::memory_order_seq_cst) == ACTIVE;
+        // The slot still holds batch _write_sequence - slot_count, the consumers of its shard must be done with it
+        return any_consumer && (_write_sequence < slot_count || slot_released(_write_sequence - slot_count));
+    };
+    while(true)
+    {
+        uint32_t last_event = _header->producer_event.load(std::memory_order_seq_cst);
+        if(ready())
+            break;
+        wait(_header->producer_event, last_event, LIVENESS_CHECK_MS);
+        reclaim_dead_consumers();
+    }
+    return slot_data(_write_sequence);
+}
+
+int* SharedMemoryRing::write_labels()
+{
+    return reinterpret_cast<int*>(slot_data(_write_sequence) + _header->labels_offset);
+}
+
+void SharedMemoryRing::commit(uint32_t label_count)
+{
+    auto entry = slot(_write_sequence);
+    entry->label_count = label_count;
+    entry->sequence.store(_write_sequence, std::memory_order_release);
+    _header->write_count.store(_write_sequence + 1, std::memory_order_seq_cst);
+    wake(_header->consumer_event);
+}
+
+void SharedMemoryRing::close()
+{
+    if(!_is_producer || !_header)
+        return;
+    _header->closed.store(1, std::memory_order_seq_cst);
+    wake(_header->consumer_event);
+}
+
+SharedMemoryRing::Status SharedMemoryRing::acquire_read_slot(Batch& batch, int timeout_ms)
+{
+    if(_is_producer)
+        THROW("The producer cannot read from the shared memory ring")
+    if(_holding)
+        release_read_slot();
+    auto& entry = consumers()[_consumer_idx];
+    // Next sequence of this shard
+    uint64_t sequence = entry.released_upto.load(std::memory_order_relaxed);
+    sequence += (entry.shard_id + entry.num_shards - sequence % entry.num_shards) % entry.num_shards;
+
+    auto start = std::chrono::steady_clock::now();
+    while(true)
+    {
+        uint32_t last_event = _header->consumer_event.load(std::memory_order_seq_cst);
+        if(_header->write_count.load(std::memory_order_acquire) > sequence)
+            break;
+        if(_header->closed.load(std::memory_order_seq_cst) || !process_alive(_header->producer_pid))
+            return Status::END_OF_DATA;
+        int wait_ms = LIVENESS_CHECK_MS;
+        if(timeout_ms >= 0)
+        {
+            int elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+            if(elapsed >= timeout_ms)
+                return Status::TIMEOUT;
+            wait_ms = std::min(wait_ms, timeout_ms - elapsed);
+        }
+        wait(_header->consumer_event, last_event, wait_ms);
+    }
+    auto slot_entry = slot(sequence);
+    if(slot_entry->sequence.load(std::memory_order_acquire) != sequence)
+        THROW("Shared memory ring internal error, slot of batch " + TOSTR(sequence) + " was overwritten")
+    batch.sequence = sequence;
+    batch.images = slot_data(sequence);
+    batch.labels = reinterpret_cast<const int*>(slot_data(sequence) + _header->labels_offset);
+    batch.label_count = slot_entry->label_count;
+    _read_sequence = sequence;
+    _holding = true;
+    return Status::OK;
+}
+
+void SharedMemoryRing::release_read_slot()
+{
+    if(!_holding)
+        return;
+    consumers()[_consumer_idx].released_upto.store(_read_sequence + 1, std::memory_order_seq_cst);
+    _holding = false;
+    wake(_header->producer_event);
+}
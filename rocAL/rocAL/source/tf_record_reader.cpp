@@ -31,6 +31,11 @@ THE SOFTWARE.
 #include <sstream>
 #include <fstream>
 #include <stdint.h>
+#include <cstdlib>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
 
 namespace filesys = boost::filesystem;
 
@@ -44,6 +49,7 @@ TFRecordReader::TFRecordReader():
     _current_file_size = 0;
     _loop = false;
     _shuffle = false;
+    _stream_read = false;
     _file_id = 0;
     _last_rec = false;
     _record_name_prefix = "";
@@ -72,6 +78,8 @@ Reader::Status TFRecordReader::initialize(ReaderConfig desc)
     _loop = desc.loop();
     _shuffle = desc.shuffle();
     _record_name_prefix = desc.file_prefix();
+    const char* stream_read = getenv("RALI_TF_RECORD_STREAM_READ");
+    _stream_read = stream_read && atoi(stream_read) > 0;
     _encoded_key = _feature_key_map.at("image/encoded");
     _filename_key = _feature_key_map.at("image/filename");
     ret = folder_reading();
@@ -126,6 +134,7 @@ int TFRecordReader::close()
 TFRecordReader::~TFRecordReader()
 {
     release();
+    unmap_record_files();
 }
 
 int TFRecordReader::release()
@@ -201,25 +210,50 @@ Reader::Status TFRecordReader::tf_record_reader()
     std::string fname = _folder_path;
     // if _record_name_prefix is specified, read only the records with prefix
     if  (_record_name_prefix.empty() || fname.find(_record_name_prefix) != std::string::npos) {
-        uint file_size;
-        std::ifstream file_contents(fname.c_str(), std::ios::binary);
-        if (!file_contents)
-            THROW("TFRecordReader: Failed to open file " + fname);
-        file_contents.seekg(0, std::ifstream::end);
-        file_size = file_contents.tellg();
-        // std::cerr<<"\n length of the file:: "<<length<<std::endl;
-        file_contents.seekg(0, std::ifstream::beg);
-        auto ret = read_image_names(file_contents, file_size);
+        const auto& record_file = map_record_file(fname);
+        auto ret = read_image_names(record_file.data, record_file.size);
         if (ret != Reader::Status::OK)
             THROW("TFRecordReader: Error in reading TF records");
         _last_rec = false;
         if (_file_names.size() != _file_size.size())
             std::cerr << "\n Size of vectors are not same";
-        file_contents.close();
     }
     return Reader::Status::OK;
 }
 
+const TFRecordReader::RecordFileMapping& TFRecordReader::map_record_file(const std::string& record_file_name)
+{
+    auto it = _record_files.find(record_file_name);
+    if (it != _record_files.end())
+        return it->second;
+    int fd = ::open(record_file_name.c_str(), O_RDONLY);
+    if (fd < 0)
+        THROW("TFRecordReader: Failed to open file " + record_file_name);
+    struct stat file_stat;
+    if (fstat(fd, &file_stat) != 0 || file_stat.st_size == 0) {
+        ::close(fd);
+        THROW("TFRecordReader: Failed to read the size of file " + record_file_name);
+    }
+    RecordFileMapping record_file;
+    record_file.size = file_stat.st_size;
+    void* addr = mmap(nullptr, record_file.size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // the mapping stays valid after the descriptor is closed
+    ::close(fd);
+    if (addr == MAP_FAILED)
+        THROW("TFRecordReader: Failed to map file " + record_file_name);
+    // shuffled reads jump across the file, read-ahead would only pollute the page cache
+    madvise(addr, record_file.size, _shuffle ? MADV_RANDOM : MADV_SEQUENTIAL);
+    record_file.data = static_cast<const char*>(addr);
+    return _record_files.emplace(record_file_name, record_file).first->second;
+}
+
+void TFRecordReader::unmap_record_files()
+{
+    for (auto& record_file : _record_files)
+        munmap(const_cast<char*>(record_file.second.data), record_file.second.size);
+    _record_files.clear();
+}
+
 size_t TFRecordReader::get_file_shard_id()
 {
     if (_batch_count == 0 || _shard_count == 0)
@@ -227,38 +261,31 @@ size_t TFRecordReader::get_file_shard_id()
     return _file_id  % _shard_count;
 }
 
-Reader::Status TFRecordReader::read_image_names(std::ifstream &file_contents, uint file_size)
+Reader::Status TFRecordReader::read_image_names(const char* file_contents, size_t file_size)
 {
     auto ret = Reader::Status::OK;
+    size_t length = 0;
     while (!_last_rec)
     {
-        uint length;
+        // record layout: uint64 length, uint32 length crc, data, uint32 data crc
         uint64_t data_length;
-        uint32_t length_crc, data_crc;
-
-        length = file_contents.tellg();
-        file_contents.read((char *)&data_length, sizeof(data_length));
-        if(!file_contents)
+        if (length + sizeof(data_length) + sizeof(uint32_t) > file_size)
             THROW("TFRecordReader: Error in reading TF records")
-        file_contents.read((char *)&length_crc, sizeof(length_crc));
-        if(!file_contents)
+        memcpy(&data_length, file_contents + length, sizeof(data_length));
+        size_t data_offset = length + sizeof(data_length) + sizeof(uint32_t);
+        size_t next_record = data_offset + data_length + sizeof(uint32_t);
+        if (next_record > file_size)
             THROW("TFRecordReader: Error in reading TF records")
-        if (uint(length + data_length + 16) == file_size)
+        if (next_record == file_size)
         {
             _last_rec = true;
         }
-        std::unique_ptr<char[]> data(new char[data_length]);
-        file_contents.read(data.get(), data_length);
-        if(!file_contents)
-            THROW("TFRecordReader: Error in reading TF records")  
-        _single_example.ParseFromArray(data.get(), data_length);
-        _features = _single_example.features();
-        auto feature = _features.feature();
+        _single_example.ParseFromArray(file_contents + data_offset, data_length);
+        const auto& feature = _single_example.features().feature();
         std::string file_path = _folder_path;
         std::string fname;
         if (!_filename_key.empty()) {
-            _single_feature = feature.at(_filename_key);
-            fname = _single_feature.bytes_list().value()[0];
+            fname = feature.at(_filename_key).bytes_list().value(0);
             file_path.append("/");
             file_path.append(fname);
         } else {
@@ -271,24 +298,18 @@ Reader::Status TFRecordReader::read_image_names(std::ifstream &file_contents, ui
         _in_batch_read_count++;
         _in_batch_read_count = (_in_batch_read_count % _batch_count == 0) ? 0 : _in_batch_read_count;
         _last_file_name = file_path;
+        length = next_record;
         if (get_file_shard_id() != _shard_id)
         {
             incremenet_file_id();
             _file_count_all_shards++;
-            file_contents.read((char *)&data_crc, sizeof(data_crc));
-            if(!file_contents)
-                THROW("TFRecordReader: Error in reading TF records")
             continue;
         }
         _file_names.push_back(file_path);
         incremenet_file_id();
         _file_count_all_shards++;
-        _single_feature = feature.at(_encoded_key);
-        _last_file_size = _single_feature.bytes_list().value()[0].size();
+        _last_file_size = feature.at(_encoded_key).bytes_list().value(0).size();
         _file_size.insert(std::pair<std::string, unsigned int>(_last_file_name, _last_file_size));
-        file_contents.read((char *)&data_crc, sizeof(data_crc));
-        if(!file_contents)
-            THROW("TFRecordReader: Error in reading TF records")
     }
     return ret;
 }
@@ -302,45 +323,57 @@ Reader::Status TFRecordReader::read_image(unsigned char *buff, std::string file_
     {
         file_name.erase(0, last_slash_idx + 1);
     }
-    std::ifstream file_contents(temp.c_str(), std::ios::binary);
-    if(!file_contents)
-        THROW("TFRecordReader: Failed to open file "+file_name);
     auto it = _image_record_starting.find(file_name);
     if (_image_record_starting.end() == it)
     {
         THROW("ERROR: Given name not present in the map" + file_name)
     }
-    // std::cerr<<"\n image present at loc:: "<<it->second;
-    file_contents.seekg(it->second, std::ifstream::beg);
     uint64_t data_length;
-    uint32_t length_crc, data_crc;
-    file_contents.read((char *)&data_length, sizeof(data_length));
-    if(!file_contents)
-        THROW("TFRecordReader: Error in reading TF records")
-    file_contents.read((char *)&length_crc, sizeof(length_crc));
-    if(!file_contents)
-        THROW("TFRecordReader: Error in reading TF records")
-    std::unique_ptr<char[]> data(new char[data_length]);
-    file_contents.read(data.get(), data_length);
-    if(!file_contents)
-        THROW("TFRecordReader: Error in reading TF records")
-    _single_example.ParseFromArray(data.get(), data_length);
-    _features = _single_example.features();
-    auto feature = _features.feature();
+    std::unique_ptr<char[]> data;
+    const char* record_data;
+    if (_stream_read)
+    {
+        // previous path, kept to compare against: open, seek and copy the record for every image
+        std::ifstream file_contents(temp.c_str(), std::ios::binary);
+        if(!file_contents)
+            THROW("TFRecordReader: Failed to open file "+file_name);
+        file_contents.seekg(it->second, std::ifstream::beg);
+        uint32_t length_crc;
+        file_contents.read((char *)&data_length, sizeof(data_length));
+        if(!file_contents)
+            THROW("TFRecordReader: Error in reading TF records")
+        file_contents.read((char *)&length_crc, sizeof(length_crc));
+        if(!file_contents)
+            THROW("TFRecordReader: Error in reading TF records")
+        data.reset(new char[data_length]);
+        file_contents.read(data.get(), data_length);
+        if(!file_contents)
+            THROW("TFRecordReader: Error in reading TF records")
+        record_data = data.get();
+    }
+    else
+    {
+        const auto& record_file = map_record_file(temp);
+        if (it->second + sizeof(data_length) + sizeof(uint32_t) > record_file.size)
+            THROW("TFRecordReader: Error in reading TF records")
+        memcpy(&data_length, record_file.data + it->second, sizeof(data_length));
+        size_t data_offset = it->second + sizeof(data_length) + sizeof(uint32_t);
+        if (data_offset + data_length + sizeof(uint32_t) > record_file.size)
+            THROW("TFRecordReader: Error in reading TF records")
+        // the record is parsed in place from the mapping, no intermediate copy
+        record_data = record_file.data + data_offset;
+    }
+    _single_example.ParseFromArray(record_data, data_length);
+    const auto& feature = _single_example.features().feature();
     std::string fname;
     if (!_filename_key.empty()) {
-        _single_feature = feature.at(_filename_key);
-        fname = _single_feature.bytes_list().value()[0];
+        fname = feature.at(_filename_key).bytes_list().value(0);
     }
     // if _filename key is empty, just read the encoded/raw feature
     if (_filename_key.empty() || (fname == file_name))
     {
-        _single_feature = feature.at(_encoded_key);
-        memcpy(buff, _single_feature.bytes_list().value()[0].c_str(), _single_feature.bytes_list().value()[0].size());
+        const auto& encoded = feature.at(_encoded_key).bytes_list().value(0);
+        memcpy(buff, encoded.data(), encoded.size());
     }
-    file_contents.read((char *)&data_crc, sizeof(data_crc));
-    if(!file_contents)
-        THROW("TFRecordReader: Error in reading TF records")
-    file_contents.close();
     return ret;
 }
@@ -70,7 +70,11 @@ VideoLoader::remaining_count()
 void VideoLoader::reset()
 {
     // stop the writer thread and empty the internal circular buffer
-    _internal_thread_running = false;
+    {
+        std::unique_lock<std::mutex> lock(_idle_lock);
+        _internal_thread_running = false;
+    }
+    _idle_cv.notify_all();
     _circ_buff.unblock_writer();
     if (_load_thread.joinable())
         _load_thread.join();
@@ -113,7 +117,11 @@ void VideoLoader::set_output_image(Image *output_image)
 
 void VideoLoader::stop_internal_thread()
 {
-    _internal_thread_running = false;
+    {
+        std::unique_lock<std::mutex> lock(_idle_lock);
+        _internal_thread_running = false;
+    }
+    _idle_cv.notify_all();
     _stopped = true;
     _circ_buff.unblock_reader();
     _circ_buff.unblock_writer();
@@ -167,6 +175,7 @@ VideoLoaderModuleStatus
 VideoLoader::load_routine()
 {
     LOG("Started the internal loader thread");
+    vxSetTraceThreadName("rocAL loader");
     VideoLoaderModuleStatus last_load_status = VideoLoaderModuleStatus::OK;
 
     // Initially record number of all the frames that are going to be loaded, this is used to know how many still there
@@ -217,10 +226,11 @@ VideoLoader::load_routine()
             // read semaphore using release() call
             // , and calls the release() allows the reader thread to wake up and handle
             // the out-of-data case properly
-            // It also slows down the reader thread since there is no more data to read,
-            // till program ends or till reset is called
+            // It also parks the reader thread since there is no more data to read,
+            // till program ends or till reset is called, both of them wake it up right away
             _circ_buff.unblock_reader();
-            std::this_thread::sleep_for(std::chrono::seconds(1));
+            std::unique_lock<std::mutex> lock(_idle_lock);
+            _idle_cv.wait_for(lock, std::chrono::seconds(1), [this] { return !_internal_thread_running; });
         }
     }
     return VideoLoaderModuleStatus::OK;
@@ -186,6 +186,8 @@ Timing VideoLoaderSharded::timing()
         max_read_time = (info.video_read_time > max_read_time) ? info.video_read_time : max_read_time;
         max_decode_time = (info.video_decode_time > max_decode_time) ? info.video_decode_time : max_decode_time;
         swap_handle_time += info.video_process_time;
+        t.video_decoded_frames += info.video_decoded_frames;
+        t.video_output_frames += info.video_output_frames;
     }
     t.video_decode_time = max_decode_time;
     t.video_read_time = max_read_time;
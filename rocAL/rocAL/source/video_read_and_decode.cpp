@@ -52,6 +52,9 @@ VideoReadAndDecode::timing()
     t.video_decode_time = _decode_time.get_timing();
     t.video_read_time = _file_load_time.get_timing();
     t.shuffle_time = _video_reader->get_shuffle_time();
+    for (auto &decoder : _video_decoder)
+        t.video_decoded_frames += decoder->decoded_frame_count();
+    t.video_output_frames = _output_frame_count;
     return t;
 }
 
@@ -62,6 +65,7 @@ VideoReadAndDecode::VideoReadAndDecode() : _file_load_time("FileLoadTime", DBG_T
 
 VideoReadAndDecode::~VideoReadAndDecode()
 {
+    stop_decode_workers();
     _video_reader = nullptr;
     _video_decoder.clear();
 }
@@ -113,6 +117,78 @@ void VideoReadAndDecode::create(VideoReaderConfig reader_config, VideoDecoderCon
         }
     }
     _video_reader = create_video_reader(reader_config);
+    // The loading thread decodes one of the sequences itself
+    start_decode_workers((_sequence_count > 1) ? _sequence_count - 1 : 0);
+}
+
+void VideoReadAndDecode::start_decode_workers(size_t worker_count)
+{
+    stop_decode_workers();
+    _stop_decode_workers = false;
+    for (size_t i = 0; i < worker_count; i++)
+        _decode_workers.emplace_back(&VideoReadAndDecode::decode_worker, this);
+}
+
+void VideoReadAndDecode::stop_decode_workers()
+{
+    {
+        std::unique_lock<std::mutex> lock(_decode_lock);
+        _stop_decode_workers = true;
+    }
+    _decode_cv.notify_all();
+    for (auto &th : _decode_workers)
+        th.join();
+    _decode_workers.clear();
+}
+
+void VideoReadAndDecode::decode_worker()
+{
+    while (true)
+    {
+        size_t group_index;
+        {
+            std::unique_lock<std::mutex> lock(_decode_lock);
+            _decode_cv.wait(lock, [this] { return _stop_decode_workers || !_decode_queue.empty(); });
+            if (_decode_queue.empty())
+                return;
+            group_index = _decode_queue.front();
+            _decode_queue.pop();
+        }
+        decode_group(group_index);
+        std::unique_lock<std::mutex> lock(_decode_lock);
+        if (--_pending_decodes == 0)
+            _decode_done_cv.notify_all();
+    }
+}
+
+void VideoReadAndDecode::decode_parallel(size_t group_count)
+{
+    if (group_count == 0)
+        return;
+    {
+        std::unique_lock<std::mutex> lock(_decode_lock);
+        for (size_t group_index = 0; group_index < group_count; group_index++)
+            _decode_queue.push(group_index);
+        _pending_decodes += group_count;
+    }
+    _decode_cv.notify_all();
+    // Help draining the queue, then wait for the sequences picked up by the workers
+    while (true)
+    {
+        size_t group_index;
+        {
+            std::unique_lock<std::mutex> lock(_decode_lock);
+            if (_decode_queue.empty())
+                break;
+            group_index = _decode_queue.front();
+            _decode_queue.pop();
+        }
+        decode_group(group_index);
+        std::unique_lock<std::mutex> lock(_decode_lock);
+        --_pending_decodes;
+    }
+    std::unique_lock<std::mutex> lock(_decode_lock);
+    _decode_done_cv.wait(lock, [this] { return _pending_decodes == 0; });
 }
 
 void VideoReadAndDecode::reset()
@@ -133,13 +209,34 @@ float VideoReadAndDecode::convert_framenum_to_timestamp(size_t frame_number)
     return timestamp;
 }
 
-void VideoReadAndDecode::decode_sequence(size_t sequence_index)
+void VideoReadAndDecode::decode_group(size_t group_index)
 {
-    if (_video_decoder[_sequence_video_idx[sequence_index]]->Decode(_decompressed_buff_ptrs[sequence_index], _sequence_start_frame_num[sequence_index], _sequence_length, _stride,
-                                                                    _max_decoded_width, _max_decoded_height, _max_decoded_stride, _out_pix_fmt) == VideoDecoder::Status::OK)
+    // Frames of this batch already decoded from the group's video, by frame number. The sequences of a group are sorted
+    // by start frame, so the frames an overlapping sequence shares with the previous ones are the first ones it needs.
+    std::map<size_t, unsigned char *> decoded_frames;
+    const size_t image_size = _max_decoded_stride * _max_decoded_height;
+    for (auto sequence_index : _decode_groups[group_index])
     {
+        const size_t start_frame_num = _sequence_start_frame_num[sequence_index];
+        unsigned char *out_buffer = _decompressed_buff_ptrs[sequence_index];
+        size_t cached_frames = 0;
+        for (; cached_frames < _sequence_length; cached_frames++)
+        {
+            auto frame = decoded_frames.find(start_frame_num + cached_frames * _stride);
+            if (frame == decoded_frames.end())
+                break;
+            memcpy(out_buffer + cached_frames * image_size, frame->second, image_size);
+        }
+        if (cached_frames < _sequence_length &&
+            _video_decoder[_sequence_video_idx[sequence_index]]->Decode(out_buffer + cached_frames * image_size, start_frame_num + cached_frames * _stride,
+                                                                        _sequence_length - cached_frames, _stride, _max_decoded_width, _max_decoded_height,
+                                                                        _max_decoded_stride, _out_pix_fmt) != VideoDecoder::Status::OK)
+            continue;
+        for (size_t s = 0; s < _sequence_length; s++)
+            decoded_frames[start_frame_num + s * _stride] = out_buffer + s * image_size;
         _actual_decoded_width[sequence_index] = _max_decoded_width;
         _actual_decoded_height[sequence_index] = _max_decoded_height;
+        _output_frame_count += _sequence_length;
     }
 }
 
@@ -178,12 +275,9 @@ VideoReadAndDecode::load(unsigned char *buff,
 
     _file_load_time.start(); // Debug timing
 
-    std::vector<size_t> sequential_decode_sequences;
-    std::vector<size_t> parallel_decode_sequences;
-    std::vector<int> video_index;
-    size_t parallel_sequence_count = 0;
     _sequence_start_frame_num.resize(_sequence_count);
     _sequence_video_path.resize(_sequence_count);
+    _sequence_video_idx.assign(_sequence_count, -1);
     for (size_t i = 0; i < _sequence_count; i++)
     {
         auto sequence_info = _video_reader->get_sequence_info();
@@ -202,7 +296,7 @@ VideoReadAndDecode::load(unsigned char *buff,
                 if (temp_itr->second._is_decoder_instance == true)
                 {
                     int video_idx = temp_itr->second._video_map_idx;
-                    if ((std::count(_sequence_video_idx.begin(), _sequence_video_idx.end(), video_idx) >= 1) && (_sequence_video_idx.size() != 0))
+                    if (std::count(_sequence_video_idx.begin(), _sequence_video_idx.end(), video_idx) >= 1)
                         continue;
                     std::vector<std::string> substrings;
                     char delim = '#';
@@ -219,40 +313,30 @@ VideoReadAndDecode::load(unsigned char *buff,
         }
         if (itr->second._is_decoder_instance == false)
             continue;
-        _sequence_video_idx.push_back(itr->second._video_map_idx);
-
-        // Check if the sequences are from same or different video file 
-        video_index.push_back(_video_file_name_map[_sequence_video_path[i]]._video_map_idx);
-        if (std::count(video_index.begin(), video_index.end(), video_index[i]) > 1)
-        {
-            sequential_decode_sequences.push_back(i);
-        }
-        else
-        {
-            parallel_decode_sequences.push_back(i);
-            parallel_sequence_count++;
-        }
+        _sequence_video_idx[i] = itr->second._video_map_idx;
     }
-    if (parallel_sequence_count == 1)
+
+    // Group the sequences per video, in frame order: each group runs on its own decoder, which then moves forward
+    // through the video and decodes the frames shared by overlapping sequences once
+    std::map<int, std::vector<size_t>> video_sequences;
+    for (size_t i = 0; i < _sequence_count; i++)
+        if (_sequence_video_idx[i] >= 0)
+            video_sequences[_sequence_video_idx[i]].push_back(i);
+    _decode_groups.clear();
+    for (auto &group : video_sequences)
     {
-        sequential_decode_sequences.push_back(parallel_decode_sequences.back());
-        parallel_decode_sequences.clear();
+        std::stable_sort(group.second.begin(), group.second.end(), [this](size_t a, size_t b) {
+            return _sequence_start_frame_num[a] < _sequence_start_frame_num[b];
+        });
+        _decode_groups.push_back(std::move(group.second));
     }
 
     _file_load_time.end(); // Debug timing
 
     _decode_time.start(); // Debug timing
 
-    for (size_t i = 0; i < sequential_decode_sequences.size(); i++)
-        decode_sequence(sequential_decode_sequences[i]);
-
-    // Initialize threads to decode
-    std::vector<std::thread> decode_threads;
-    for (size_t i = 0; i < parallel_decode_sequences.size(); i++)
-        decode_threads.push_back(std::thread(&VideoReadAndDecode::decode_sequence, this, parallel_decode_sequences[i]));
-
-    for (auto &th : decode_threads)
-        th.join();
+    // Groups use distinct decoders and are decoded concurrently
+    decode_parallel(_decode_groups.size());
 
     _decode_time.end(); // Debug timing
 
@@ -877,9 +877,11 @@ class BoxEncoder(Node):
         seed (int, optional, default = -1) – Random seed (If not provided it will be populated based on the global seed of the pipeline)
 
         stds (float or list of float, optional, default = [1.0, 1.0, 1.0, 1.0]) – [x y w h] standard deviations for offset normalization.
+
+        pipelined (bool, optional, default = False) – Encode the boxes on a separate thread while the images of the batch are being processed.
     """
 
-    def __init__(self, anchors, bytes_per_sample_hint=0, criteria=0.5, means=None, offset=False, preserve=False, scale=1.0, seed=-1, stds=None ,device = None):
+    def __init__(self, anchors, bytes_per_sample_hint=0, criteria=0.5, means=None, offset=False, preserve=False, scale=1.0, seed=-1, stds=None ,device = None, pipelined=False):
         Node().__init__()
         self._anchors = anchors
         self._bytes_per_sample_hint = bytes_per_sample_hint
@@ -890,6 +892,7 @@ class BoxEncoder(Node):
         self._scale = scale
         self._seed = seed
         self._stds = stds if stds else [1.0, 1.0, 1.0, 1.0]
+        self._pipelined = pipelined
         self.output = Node()
 
     def __call__(self, bboxes, labels):
@@ -902,7 +905,7 @@ class BoxEncoder(Node):
         return self.output, self.output
 
     def rali_c_func_call(self, handle, criteria=0.5):
-        b.BoxEncoder(handle, self._anchors, self._criteria, self._means, self._stds, self._offset,self._scale)
+        b.BoxEncoder(handle, self._anchors, self._criteria, self._means, self._stds, self._offset,self._scale, self._pipelined)
         return 0,0
         
 
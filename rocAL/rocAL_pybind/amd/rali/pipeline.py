@@ -245,7 +245,15 @@ class Pipeline(object):
 
     def copyToTensor(self, array,  multiplier, offset, reverse_channels, tensor_format, tensor_dtype):
 
-        b.raliCopyToOutputTensor(self._handle, ctypes.c_void_p(array.data_ptr()), tensor_format, tensor_dtype,
+        # accepts torch tensors as well as numpy arrays
+        ptr = array.ctypes.data if isinstance(array, np.ndarray) else array.data_ptr()
+        b.raliCopyToOutputTensor(self._handle, ctypes.c_void_p(ptr), tensor_format, tensor_dtype,
+                                    multiplier[0], multiplier[1], multiplier[2], offset[0], offset[1], offset[2], (1 if reverse_channels else 0))
+
+    def getOutputTensorDLPack(self, multiplier, offset, reverse_channels, tensor_format, tensor_dtype):
+        """Returns the output batch as a DLPack capsule, to be consumed by torch.utils.dlpack.from_dlpack()
+        or tf.experimental.dlpack.from_dlpack() without any further copy"""
+        return b.raliGetOutputTensorDLPack(self._handle, self._batch_size, tensor_format, tensor_dtype,
                                     multiplier[0], multiplier[1], multiplier[2], offset[0], offset[1], offset[2], (1 if reverse_channels else 0))
 
     def encode(self, bboxes_in, labels_in):
@@ -275,6 +283,11 @@ class Pipeline(object):
     def GetBBCords(self, array):
         return b.getBBCords(self._handle, array)
 
+    def GetPaddedBoundingBoxes(self, max_rows=0):
+        """Returns (bboxes, labels, counts): the boxes and labels of the batch zero padded to max_rows per image,
+        or to the largest count in the batch when max_rows is 0, and the number of boxes of each image"""
+        return b.getPaddedBoundingBoxes(self._handle, self._batch_size, max_rows)
+
     def getImageLabels(self, array):
         b.getImageLabels(self._handle, array)
 
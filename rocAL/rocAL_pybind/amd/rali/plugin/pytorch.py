@@ -1,4 +1,5 @@
 import torch
+import torch.utils.dlpack
 import numpy as np
 import rali_pybind as b
 import amd.rali.types as types
@@ -64,10 +65,6 @@ class RALIGenericIterator(object):
         self.bs = pipeline._batch_size
         color_format = b.getOutputColorFormat(self.loader._handle)
         self.p = (1 if (color_format == int(types.GRAY)) else 3)
-        if self.tensor_dtype == types.FLOAT:
-            self.out = np.zeros(( self.bs*self.n, self.p, int(self.h/self.bs), self.w,), dtype = "float32")
-        elif self.tensor_dtype == types.FLOAT16:
-            self.out = np.zeros(( self.bs*self.n, self.p, int(self.h/self.bs), self.w,), dtype = "float16")
         # self.labels = np.zeros((self.bs),dtype = "int32")
         if(self.loader._oneHotEncoding == True):
             self.labels = np.zeros((self.bs)*(self.loader._numOfClasses),dtype = "int32")
@@ -93,61 +90,22 @@ class RALIGenericIterator(object):
         if self.loader.run() != 0:
             raise StopIteration
 
-        if(types.NCHW == self.tensor_format):
-            self.loader.copyToTensorNCHW(self.out, self.multiplier, self.offset, self.reverse_channels, int(self.tensor_dtype))
-        else:
-            self.loader.copyToTensorNHWC(self.out, self.multiplier, self.offset, self.reverse_channels, int(self.tensor_dtype))
-        
+        # The output tensor is handed over through DLPack: torch owns the buffer, so there's no copy into a
+        # preallocated array nor any dtype conversion here
+        self.out = torch.utils.dlpack.from_dlpack(self.loader.getOutputTensorDLPack(self.multiplier, self.offset,
+                                                  self.reverse_channels, self.tensor_format, self.tensor_dtype))
+
         if((self.loader._name == "Caffe2ReaderDetection") or (self.loader._name == "CaffeReaderDetection")):
-            self.lis = []  # Empty list for bboxes
-            self.lis_lab = []  # Empty list of labels
-            
-            #Count of labels/ bboxes in a batch
-            self.bboxes_label_count = np.zeros(self.bs, dtype="int32")
-            self.count_batch = self.loader.GetBoundingBoxCount(self.bboxes_label_count)
-            # 1D labels array in a batch
-            self.labels = np.zeros(self.count_batch, dtype="int32")
-            self.loader.GetBBLabels(self.labels)
-            # 1D bboxes array in a batch
-            self.bboxes = np.zeros((self.count_batch*4), dtype="float32")
-            self.loader.GetBBCords(self.bboxes)
+            #Bboxes and labels of the batch padded to the largest box count, and the count of each image
+            bboxes, labels, self.bboxes_label_count = self.loader.GetPaddedBoundingBoxes()
             #Image sizes of a batch
             self.img_size = np.zeros((self.bs * 2),dtype = "int32")
             self.loader.GetImgSizes(self.img_size)
-            
-            count =0
-            sum_count=0
-            for i in range(self.bs):
-                count = self.bboxes_label_count[i]
-  
-                self.label_2d_numpy = (self.labels[sum_count : sum_count+count])
-                self.label_2d_numpy = np.reshape(self.label_2d_numpy, (-1, 1)).tolist()
-                self.bb_2d_numpy = (self.bboxes[sum_count*4 : (sum_count+count)*4])
-                self.bb_2d_numpy = np.reshape(self.bb_2d_numpy, (-1, 4)).tolist()
-                
-                self.lis_lab.append(self.label_2d_numpy)
-                self.lis.append(self.bb_2d_numpy)
-                
-                sum_count = sum_count +count
-
-            self.target = self.lis
-            self.target1 = self.lis_lab
-            max_cols = max([len(row) for batch in self.target for row in batch])
-            max_rows = max([len(batch) for batch in self.target])
-            self.bb_padded = [batch + [[0] * (max_cols)] * (max_rows - len(batch)) for batch in self.target]
-            self.bb_padded = torch.FloatTensor([row + [0] * (max_cols - len(row)) for batch in self.bb_padded for row in batch])
-            self.bb_padded = self.bb_padded.view(-1, max_rows, max_cols)
-
-            max_cols1 = max([len(row) for batch in self.target1 for row in batch])
-            max_rows1 = max([len(batch) for batch in self.target1])
-            self.labels_padded = [batch + [[0] * (max_cols1)] * (max_rows1 - len(batch)) for batch in self.target1]
-            self.labels_padded = torch.LongTensor([row + [0] * (max_cols1 - len(row)) for batch in self.labels_padded for row in batch])
-            self.labels_padded = self.labels_padded.view(-1, max_rows1, max_cols1)
-
-            if self.tensor_dtype == types.FLOAT:
-                return torch.from_numpy(self.out),self.bb_padded, self.labels_padded
-            elif self.tensor_dtype == types.FLOAT16:
-                return torch.from_numpy(self.out.astype(np.float16)),self.bb_padded, self.labels_padded
+
+            self.bb_padded = torch.from_numpy(bboxes)
+            # labels is (bs, max_rows), add the trailing axis explicitly so a batch without boxes gives (bs, 0, 1)
+            self.labels_padded = torch.from_numpy(labels).type(torch.LongTensor).unsqueeze(2)
+            return self.out, self.bb_padded, self.labels_padded
 
         else:
             if(self.loader._oneHotEncoding == True):
@@ -158,10 +116,7 @@ class RALIGenericIterator(object):
                 self.loader.getImageLabels(self.labels)
                 self.labels_tensor = torch.from_numpy(self.labels).type(torch.LongTensor)
 
-            if self.tensor_dtype == types.FLOAT:
-                return torch.from_numpy(self.out), self.labels_tensor
-            elif self.tensor_dtype == types.FLOAT16:
-                return torch.from_numpy(self.out.astype(np.float16)), self.labels_tensor
+            return self.out, self.labels_tensor
 
     def reset(self):
         b.raliResetLoaders(self.loader._handle)
@@ -48,10 +48,12 @@ class RALIGenericIteratorDetection(object):
         color_format = b.getOutputColorFormat(self.loader._handle)
         self.p = (1 if (color_format == int(types.GRAY)) else 3)
 
-        if self.tensor_dtype == types.FLOAT:
-            self.out = np.zeros(( self.bs*self.n, self.p, int(self.h/self.bs), self.w,), dtype = "float32")
-        elif self.tensor_dtype == types.FLOAT16:
-            self.out = np.zeros(( self.bs*self.n, self.p, int(self.h/self.bs), self.w,), dtype = "float16")
+        # rocAL converts to the requested layout and data type while copying, so no further conversion is needed
+        dtype = "float16" if self.tensor_dtype == types.FLOAT16 else "float32"
+        if(types.NCHW == self.tensor_format):
+            self.out = np.zeros(( self.bs*self.n, self.p, int(self.h/self.bs), self.w,), dtype = dtype)
+        else:
+            self.out = np.zeros(( self.bs*self.n, int(self.h/self.bs), self.w, self.p,), dtype = dtype)
         # self.labels = np.zeros((self.bs),dtype = "int32")
 
     def next(self):
@@ -69,62 +71,18 @@ class RALIGenericIteratorDetection(object):
         if self.loader.run() != 0:
             raise StopIteration
 
-        if(types.NCHW == self.tensor_format):
-            self.loader.copyToTensorNCHW(self.out, self.multiplier, self.offset, self.reverse_channels, int(self.tensor_dtype))
-        else:
-            self.loader.copyToTensorNHWC(self.out, self.multiplier, self.offset, self.reverse_channels, int(self.tensor_dtype))
-        
+        self.loader.copyToTensor(self.out, self.multiplier, self.offset, self.reverse_channels, self.tensor_format, self.tensor_dtype)
+
         if(self.loader._name == "TFRecordReaderDetection"):
-            self.bbox_list =[]
-            self.label_list=[]
-            self.num_bboxes_list=[]
-            #Count of labels/ bboxes in a batch
-            self.bboxes_label_count = np.zeros(self.bs, dtype="int32")
-            self.count_batch = self.loader.GetBoundingBoxCount(self.bboxes_label_count)
-            self.num_bboxes_list = self.bboxes_label_count.tolist()
-            # 1D labels array in a batch
-            self.labels = np.zeros(self.count_batch, dtype="int32")
-            self.loader.GetBBLabels(self.labels)
-            # 1D bboxes array in a batch
-            self.bboxes = np.zeros((self.count_batch*4), dtype="float32")
-            self.loader.GetBBCords(self.bboxes)
+            #Bboxes and labels of the batch padded to 100 boxes per image, and the count of each image
+            self.res, labels, self.bboxes_label_count = self.loader.GetPaddedBoundingBoxes(100)
+            self.l = np.reshape(labels, (self.bs, -1, 1))
+            self.num_bboxes_arr = self.bboxes_label_count
             #1D Image sizes array of image in a batch
             self.img_size = np.zeros((self.bs * 2),dtype = "int32")
             self.loader.GetImgSizes(self.img_size)
-            count =0 # number of bboxes per image
-            sum_count=0 # sum of the no. of the bboxes
-            for i in range(self.bs):
-                count = self.bboxes_label_count[i]
-                self.label_2d_numpy = (self.labels[sum_count : sum_count+count])
-                self.label_2d_numpy = np.reshape(self.label_2d_numpy, (-1, 1)).tolist()
-                self.bb_2d_numpy = (self.bboxes[sum_count*4 : (sum_count+count)*4])
-                self.bb_2d_numpy = np.reshape(self.bb_2d_numpy, (-1, 4)).tolist()
-                self.label_list.append(self.label_2d_numpy)
-                self.bbox_list.append(self.bb_2d_numpy)
-                sum_count = sum_count +count
-
-            self.target = self.bbox_list
-            self.target1 = self.label_list
-            max_cols = max([len(row) for batch in self.target for row in batch])
-            # max_rows = max([len(batch) for batch in self.target])
-            max_rows = 100
-            bb_padded = [batch + [[0] * (max_cols)] * (max_rows - len(batch)) for batch in self.target]
-            bb_padded_1=[row + [0] * (max_cols - len(row)) for batch in bb_padded for row in batch]
-            arr = np.asarray(bb_padded_1)
-            self.res = np.reshape(arr, (-1, max_rows, max_cols))
-            max_cols = max([len(row) for batch in self.target1 for row in batch])
-            # max_rows = max([len(batch) for batch in self.target1])
-            max_rows = 100
-            lab_padded = [batch + [[0] * (max_cols)] * (max_rows - len(batch)) for batch in self.target1]
-            lab_padded_1=[row + [0] * (max_cols - len(row)) for batch in lab_padded for row in batch]
-            labarr = np.asarray(lab_padded_1)
-            self.l = np.reshape(labarr, (-1, max_rows, max_cols))
-            self.num_bboxes_arr = np.array(self.num_bboxes_list)
-
-            if self.tensor_dtype == types.FLOAT:
-                return self.out.astype(np.float32), self.res, self.l, self.num_bboxes_arr
-            elif self.tensor_dtype == types.FLOAT16:
-                return self.out.astype(np.float16), self.res, self.l, self.num_bboxes_arr
+
+            return self.out, self.res, self.l, self.num_bboxes_arr
         elif (self.loader._name == "TFRecordReaderClassification"):
             if(self.loader._oneHotEncoding == True):
                 self.labels = np.zeros((self.bs)*(self.loader._numOfClasses),dtype = "int32")
@@ -134,10 +92,7 @@ class RALIGenericIteratorDetection(object):
                 self.labels = np.zeros((self.bs),dtype = "int32")
                 self.loader.getImageLabels(self.labels)
         
-            if self.tensor_dtype == types.FLOAT:
-                return self.out.astype(np.float32), self.labels
-            elif self.tensor_dtype == types.TensorDataType.FLOAT16:
-                return self.out.astype(np.float16), self.labels
+            return self.out, self.labels
         
     def reset(self):
         b.raliResetLoaders(self.loader._handle)
@@ -7,6 +7,8 @@ from rali_pybind.types import CONTEXT_INVALID
 from rali_pybind.types import RUNTIME_ERROR
 from rali_pybind.types import UPDATE_PARAMETER_FAILED
 from rali_pybind.types import INVALID_PARAMETER_TYPE
+from rali_pybind.types import NO_MORE_DATA
+from rali_pybind.types import TIMEOUT
 
 #  RaliProcessMode
 from rali_pybind.types import GPU
@@ -34,6 +36,11 @@ from rali_pybind.types import RGB_PLANAR
 from rali_pybind.types import NHWC
 from rali_pybind.types import NCHW
 
+#     RaliFileReadMode
+from rali_pybind.types import FILE_READ_BUFFERED
+from rali_pybind.types import FILE_READ_DROP_CACHE
+from rali_pybind.types import FILE_READ_DIRECT
+
 
 
 
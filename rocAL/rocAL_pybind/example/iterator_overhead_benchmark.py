@@ -0,0 +1,76 @@
+import sys
+import time
+import torch
+import torch.utils.dlpack
+import rali_pybind as b
+from amd.rali.pipeline import Pipeline
+import amd.rali.ops as ops
+import amd.rali.types as types
+
+# Measures the per batch overhead of handing the rocAL output to PyTorch, on top of the pipeline run itself:
+#  - copy:   copyToTensor() into a preallocated tensor, then a host side dtype conversion as the iterator used to do
+#  - dlpack: getOutputTensorDLPack() consumed by torch.utils.dlpack.from_dlpack(), no further copy
+
+class BenchmarkPipe(Pipeline):
+	def __init__(self, batch_size, num_threads, device_id, data_dir, crop, tensor_dtype, rali_cpu = True):
+		super(BenchmarkPipe, self).__init__(batch_size, num_threads, device_id, seed=12 + device_id, rali_cpu=rali_cpu)
+		self.input = ops.FileReader(file_root=data_dir, random_shuffle=False)
+		self.decode = ops.ImageDecoder(device='cpu', output_type=types.RGB)
+		self.res = ops.Resize(device='cpu', resize_x=crop, resize_y=crop)
+		self.cmnp = ops.CropMirrorNormalize(device="cpu",
+											output_dtype=tensor_dtype,
+											output_layout=types.NCHW,
+											crop=(crop, crop),
+											image_type=types.RGB,
+											mean=[0.485 * 255,0.456 * 255,0.406 * 255],
+											std=[0.229 * 255,0.224 * 255,0.225 * 255])
+
+	def define_graph(self):
+		jpegs, labels = self.input(name="Reader")
+		images = self.decode(jpegs)
+		images = self.res(images)
+		return [self.cmnp(images)]
+
+def run_benchmark(pipe, mode, iterations, tensor_dtype):
+	multiplier = [1.0, 1.0, 1.0]
+	offset = [0.0, 0.0, 0.0]
+	out = None
+	run_time = 0.0
+	export_time = 0.0
+	for i in range(iterations):
+		if b.isEmpty(pipe._handle):
+			b.raliResetLoaders(pipe._handle)
+		start = time.perf_counter()
+		pipe.run()
+		mid = time.perf_counter()
+		if mode == "copy":
+			if out is None:
+				out = torch.empty((pipe._batch_size, 3, pipe.getOutputHeight() // pipe._batch_size, pipe.getOutputWidth()),
+								  dtype=torch.float32)
+			# the iterator used to always copy out FP32 and convert to FP16 on the host
+			pipe.copyToTensor(out, multiplier, offset, False, types.NCHW, types.FLOAT)
+			tensor = out.half() if tensor_dtype == types.FLOAT16 else out
+		else:
+			tensor = torch.utils.dlpack.from_dlpack(pipe.getOutputTensorDLPack(multiplier, offset, False, types.NCHW, tensor_dtype))
+		end = time.perf_counter()
+		run_time += mid - start
+		export_time += end - mid
+	return run_time * 1000 / iterations, export_time * 1000 / iterations
+
+def main():
+	if len(sys.argv) < 3:
+		print('Please pass image_folder batch_size [iterations] [fp16]')
+		exit(0)
+	image_path = sys.argv[1]
+	bs = int(sys.argv[2])
+	iterations = int(sys.argv[3]) if len(sys.argv) > 3 else 100
+	tensor_dtype = types.FLOAT16 if (len(sys.argv) > 4 and sys.argv[4] == "fp16") else types.FLOAT
+	pipe = BenchmarkPipe(batch_size=bs, num_threads=1, device_id=0, data_dir=image_path, crop=224, tensor_dtype=tensor_dtype)
+	pipe.build()
+	for mode in ["copy", "dlpack"]:
+		run_benchmark(pipe, mode, 5, tensor_dtype) # warm up
+		run_ms, export_ms = run_benchmark(pipe, mode, iterations, tensor_dtype)
+		print("%-7s pipeline run %8.3f ms/batch, iterator overhead %8.3f ms/batch" % (mode, run_ms, export_ms))
+
+if __name__ == '__main__':
+	main()
@@ -0,0 +1,73 @@
+import sys
+import time
+import threading
+import numpy as np
+import rali_pybind as b
+from amd.rali.pipeline import Pipeline
+import amd.rali.ops as ops
+import amd.rali.types as types
+
+# Runs 1..N rocAL pipelines, each fed from its own Python thread of this process, and reports the aggregate
+# throughput. The blocking rali_pybind calls release the GIL, so the pipelines only contend for CPU cores.
+
+class BenchmarkPipe(Pipeline):
+	def __init__(self, batch_size, num_threads, device_id, data_dir, crop, shard_id, num_shards, rali_cpu = True):
+		super(BenchmarkPipe, self).__init__(batch_size, num_threads, device_id, seed=12 + shard_id, rali_cpu=rali_cpu)
+		self.input = ops.FileReader(file_root=data_dir, random_shuffle=True, shard_id=shard_id, num_shards=num_shards)
+		self.decode = ops.ImageDecoder(device='cpu', output_type=types.RGB)
+		self.res = ops.Resize(device='cpu', resize_x=crop, resize_y=crop)
+		self.cmnp = ops.CropMirrorNormalize(device="cpu",
+											output_dtype=types.FLOAT,
+											output_layout=types.NCHW,
+											crop=(crop, crop),
+											image_type=types.RGB,
+											mean=[0.485 * 255,0.456 * 255,0.406 * 255],
+											std=[0.229 * 255,0.224 * 255,0.225 * 255])
+
+	def define_graph(self):
+		jpegs, labels = self.input(name="Reader")
+		images = self.decode(jpegs)
+		images = self.res(images)
+		return [self.cmnp(images)]
+
+def feed(pipe, iterations, images_done, idx):
+	out = np.zeros((pipe._batch_size, 3, pipe.getOutputHeight() // pipe._batch_size, pipe.getOutputWidth()), dtype = "float32")
+	for i in range(iterations):
+		if b.isEmpty(pipe._handle):
+			b.raliResetLoaders(pipe._handle)
+		pipe.run()
+		pipe.copyToTensor(out, [1.0, 1.0, 1.0], [0.0, 0.0, 0.0], False, types.NCHW, types.FLOAT)
+		images_done[idx] += pipe._batch_size
+
+def main():
+	if len(sys.argv) < 3:
+		print('Please pass image_folder batch_size [max_pipelines] [iterations] [cpu_threads_per_pipeline]')
+		exit(0)
+	image_path = sys.argv[1]
+	bs = int(sys.argv[2])
+	max_pipelines = int(sys.argv[3]) if len(sys.argv) > 3 else 4
+	iterations = int(sys.argv[4]) if len(sys.argv) > 4 else 50
+	nt = int(sys.argv[5]) if len(sys.argv) > 5 else 1
+	base_rate = 0.0
+	for count in range(1, max_pipelines + 1):
+		pipes = [BenchmarkPipe(batch_size=bs, num_threads=nt, device_id=0, data_dir=image_path, crop=224,
+							   shard_id=i, num_shards=count) for i in range(count)]
+		for pipe in pipes:
+			pipe.build()
+		images_done = [0] * count
+		threads = [threading.Thread(target=feed, args=(pipes[i], iterations, images_done, i)) for i in range(count)]
+		start = time.perf_counter()
+		for t in threads:
+			t.start()
+		for t in threads:
+			t.join()
+		elapsed = time.perf_counter() - start
+		rate = sum(images_done) / elapsed
+		if count == 1:
+			base_rate = rate
+		print("%2d pipeline(s): %10.1f images/sec, scaling %5.2fx" % (count, rate, rate / base_rate))
+		for pipe in pipes:
+			b.raliRelease(pipe._handle)
+
+if __name__ == '__main__':
+	main()
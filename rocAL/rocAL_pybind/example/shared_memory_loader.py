@@ -0,0 +1,86 @@
+import sys
+import time
+import multiprocessing as mp
+import rali_pybind as b
+from amd.rali.pipeline import Pipeline
+import amd.rali.ops as ops
+import amd.rali.types as types
+
+# One producer process decodes and augments, N trainer processes read its batches from a POSIX shared memory ring.
+# Consumer i attaches as shard i of N and gets every N-th batch; killing a consumer does not stall the producer.
+
+SHM_NAME = "rali_shared_memory_loader"
+
+class ProducerPipe(Pipeline):
+	def __init__(self, batch_size, num_threads, device_id, data_dir, crop, rali_cpu = True):
+		super(ProducerPipe, self).__init__(batch_size, num_threads, device_id, seed=12, rali_cpu=rali_cpu)
+		self.input = ops.FileReader(file_root=data_dir, random_shuffle=True)
+		self.decode = ops.ImageDecoder(device='cpu', output_type=types.RGB)
+		self.res = ops.Resize(device='cpu', resize_x=crop, resize_y=crop)
+
+	def define_graph(self):
+		jpegs, labels = self.input(name="Reader")
+		images = self.decode(jpegs)
+		return [self.res(images)]
+
+def producer(image_path, bs, num_consumers, iterations, ready):
+	pipe = ProducerPipe(batch_size=bs, num_threads=1, device_id=0, data_dir=image_path, crop=224)
+	pipe.build()
+	if b.raliCreateSharedMemoryOutput(pipe._handle, SHM_NAME, 4, num_consumers) != types.OK:
+		print("Could not create the shared memory output")
+		ready.set()
+		return
+	ready.set()
+	for i in range(iterations):
+		if b.isEmpty(pipe._handle):
+			b.raliResetLoaders(pipe._handle)
+		pipe.run()
+		b.raliPublishToSharedMemory(pipe._handle)
+	# releasing the pipeline tells the consumers the data ends after what was published
+	b.raliRelease(pipe._handle)
+
+def consumer(shard_id, num_shards, results):
+	handle = b.raliAttachSharedMemory(SHM_NAME, shard_id, num_shards)
+	if handle is None:
+		results.put((shard_id, 0, 0.0))
+		return
+	count = 0
+	start = time.perf_counter()
+	while True:
+		status, images, labels = b.raliAcquireSharedMemoryBatch(handle, 10000)
+		if status != types.OK:
+			break
+		# a trainer would hand images (a view of the slot) to its model here, before releasing the slot
+		count += images.shape[0]
+		b.raliReleaseSharedMemoryBatch(handle)
+	results.put((shard_id, count, time.perf_counter() - start))
+	b.raliDetachSharedMemory(handle)
+
+def main():
+	if len(sys.argv) < 3:
+		print('Please pass image_folder batch_size [num_consumers] [iterations]')
+		exit(0)
+	image_path = sys.argv[1]
+	bs = int(sys.argv[2])
+	num_consumers = int(sys.argv[3]) if len(sys.argv) > 3 else 2
+	iterations = int(sys.argv[4]) if len(sys.argv) > 4 else 100
+	ready = mp.Event()
+	prod = mp.Process(target=producer, args=(image_path, bs, num_consumers, iterations, ready))
+	prod.start()
+	ready.wait()
+	results = mp.Queue()
+	consumers = [mp.Process(target=consumer, args=(i, num_consumers, results)) for i in range(num_consumers)]
+	for c in consumers:
+		c.start()
+	for c in consumers:
+		c.join()
+	prod.join()
+	total = 0
+	for i in range(num_consumers):
+		shard_id, count, elapsed = results.get()
+		total += count
+		print("consumer %d: %8d images, %10.1f images/sec" % (shard_id, count, count / elapsed if elapsed > 0 else 0.0))
+	print("total: %d images read by %d consumers from one decode" % (total, num_consumers))
+
+if __name__ == '__main__':
+	main()
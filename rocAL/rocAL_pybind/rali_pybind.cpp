@@ -2,6 +2,8 @@
 #include <pybind11/stl.h>
 #include <pybind11/numpy.h>
 #include <iostream>
+#include <mutex>
+#include <map>
 #include <pybind11/embed.h>
 #include <pybind11/eval.h>
 #include "rali_api_types.h"
@@ -11,6 +13,7 @@
 #include "rali_api_augmentation.h"
 #include "rali_api_data_transfer.h"
 #include "rali_api_info.h"
+#include "dlpack/dlpack.h"
 namespace py = pybind11;
 
 using float16 = half_float::half;
@@ -52,7 +55,11 @@ namespace rali{
         auto buf = array.request();
         unsigned char* ptr = (unsigned char*) buf.ptr;
         // call pure C++ function
-        int status = raliCopyToOutput(context,ptr,buf.size);
+        int status;
+        {
+            py::gil_scoped_release release;
+            status = raliCopyToOutput(context,ptr,buf.size);
+        }
         return py::cast<py::none>(Py_None);
     }
 
@@ -87,20 +94,193 @@ namespace rali{
     {
         auto ptr = ctypes_void_ptr(p);
         // call pure C++ function
-
-        int status = raliCopyToOutputTensor(context, ptr, tensor_format, tensor_output_type, multiplier0,
+        int status;
+        {
+            py::gil_scoped_release release;
+            status = raliCopyToOutputTensor(context, ptr, tensor_format, tensor_output_type, multiplier0,
                                               multiplier1, multiplier2, offset0,
                                               offset1, offset2, reverse_channels);
+        }
         // std::cerr<<"\n Copy failed with status :: "<<status;
         return py::cast<py::none>(Py_None);
     }
 
+    // Host buffers handed to the frameworks through DLPack. A buffer comes back to the pool when the framework
+    // frees its tensor, so steady state iterations neither allocate nor copy the output a second time
+    class OutputTensorPool
+    {
+    public:
+        void* acquire(size_t size)
+        {
+            {
+                std::lock_guard<std::mutex> lock(_lock);
+                auto it = _free_buffers.find(size);
+                if (it != _free_buffers.end())
+                {
+                    void* ptr = it->second;
+                    _free_buffers.erase(it);
+                    return ptr;
+                }
+            }
+            // a minimum of extra MEM_ALIGNMENT is allocated
+            return aligned_alloc(MEM_ALIGNMENT, MEM_ALIGNMENT * (size / MEM_ALIGNMENT + 1));
+        }
+        void release(void* ptr, size_t size)
+        {
+            std::lock_guard<std::mutex> lock(_lock);
+            if (_free_buffers.size() < MAX_FREE_BUFFERS)
+                _free_buffers.emplace(size, ptr);
+            else
+                free(ptr);
+        }
+    private:
+        const size_t MEM_ALIGNMENT = 256;
+        const size_t MAX_FREE_BUFFERS = 8;
+        std::mutex _lock;
+        std::multimap<size_t, void*> _free_buffers;
+    };
+    // never destroyed: frameworks may still release tensors while the interpreter shuts down
+    static OutputTensorPool* output_tensor_pool = new OutputTensorPool;
+
+    struct DLPackTensorContext
+    {
+        DLManagedTensor managed_tensor;
+        int64_t shape[4];
+        size_t size;
+    };
+
+    static void dlpack_tensor_deleter(DLManagedTensor* managed_tensor)
+    {
+        auto tensor_context = static_cast<DLPackTensorContext*>(managed_tensor->manager_ctx);
+        output_tensor_pool->release(managed_tensor->dl_tensor.data, tensor_context->size);
+        delete tensor_context;
+    }
+
+    static void dlpack_capsule_destructor(PyObject* capsule)
+    {
+        // frameworks rename the capsule to "used_dltensor" once they own the tensor, then the deleter is theirs to call
+        if (PyCapsule_IsValid(capsule, "dltensor"))
+        {
+            auto managed_tensor = static_cast<DLManagedTensor*>(PyCapsule_GetPointer(capsule, "dltensor"));
+            managed_tensor->deleter(managed_tensor);
+        }
+    }
+
+    py::object wrapper_tensor_dlpack(RaliContext context, size_t batch_size, RaliTensorLayout tensor_format, RaliTensorOutputType tensor_output_type,
+                                     float multiplier0, float multiplier1, float multiplier2,
+                                     float offset0, float offset1, float offset2, bool reverse_channels)
+    {
+        const int64_t n = raliGetAugmentationBranchCount(context) * batch_size;
+        const int64_t c = (raliGetOutputColorFormat(context) == RALI_COLOR_U8) ? 1 : 3;
+        const int64_t h = raliGetOutputHeight(context) / batch_size;
+        const int64_t w = raliGetOutputWidth(context);
+        const unsigned element_size = (tensor_output_type == RALI_FP16) ? sizeof(float16) : sizeof(float);
+        auto tensor_context = new DLPackTensorContext;
+        tensor_context->size = n * c * h * w * element_size;
+        void* ptr = output_tensor_pool->acquire(tensor_context->size);
+        // the conversion to the requested layout and data type is the only copy of the output
+        int status;
+        {
+            py::gil_scoped_release release;
+            status = raliCopyToOutputTensor(context, ptr, tensor_format, tensor_output_type, multiplier0,
+                                            multiplier1, multiplier2, offset0,
+                                            offset1, offset2, reverse_channels);
+        }
+        if (status != RALI_OK)
+        {
+            output_tensor_pool->release(ptr, tensor_context->size);
+            delete tensor_context;
+            throw std::runtime_error("raliCopyToOutputTensor failed with status " + std::to_string(status));
+        }
+        if (tensor_format == RALI_NHWC)
+        {
+            int64_t shape[4] = { n, h, w, c };
+            std::copy(shape, shape + 4, tensor_context->shape);
+        }
+        else
+        {
+            int64_t shape[4] = { n, c, h, w };
+            std::copy(shape, shape + 4, tensor_context->shape);
+        }
+        DLTensor& dl_tensor = tensor_context->managed_tensor.dl_tensor;
+        dl_tensor.data = ptr;
+        dl_tensor.device = { kDLCPU, 0 };
+        dl_tensor.ndim = 4;
+        dl_tensor.dtype = { kDLFloat, (uint8_t)(element_size * 8), 1 };
+        dl_tensor.shape = tensor_context->shape;
+        dl_tensor.strides = nullptr;
+        dl_tensor.byte_offset = 0;
+        tensor_context->managed_tensor.manager_ctx = tensor_context;
+        tensor_context->managed_tensor.deleter = dlpack_tensor_deleter;
+        return py::capsule(&tensor_context->managed_tensor, "dltensor", dlpack_capsule_destructor);
+    }
+
+    // Waits for the next batch of a shared memory consumer, returns (status, images, labels). The images are a view
+    // of the shared memory slot, valid until raliReleaseSharedMemoryBatch() or the next acquire; the labels are a copy
+    py::tuple wrapper_acquire_shared_memory_batch(RaliSharedMemoryConsumer consumer, int timeout_ms)
+    {
+        RaliSharedMemoryBatch batch;
+        RaliStatus status;
+        {
+            py::gil_scoped_release release;
+            status = raliAcquireSharedMemoryBatch(consumer, &batch, timeout_ms);
+        }
+        if (status != RALI_OK)
+            return py::make_tuple(status, py::none(), py::none());
+        const size_t n = (size_t)batch.output_count * batch.batch_size;
+        const size_t h = batch.height / batch.batch_size;
+        py::capsule no_owner(batch.images, [](void *) {});
+        py::array_t<unsigned char> images({ n, h, (size_t)batch.width, (size_t)batch.channels }, batch.images, no_owner);
+        py::array_t<int> labels(batch.label_count);
+        std::copy(batch.labels, batch.labels + batch.label_count, labels.mutable_data());
+        return py::make_tuple(status, images, labels);
+    }
+
+    // Returns the bounding boxes and labels of the batch padded with zeros to max_rows boxes per image
+    // (or to the largest box count of the batch when max_rows is 0), and the box count of each image
+    py::object wrapper_padded_BB_copy(RaliContext context, size_t batch_size, unsigned max_rows)
+    {
+        py::array_t<int> counts(batch_size);
+        int* counts_ptr = counts.mutable_data();
+        std::vector<int> labels;
+        std::vector<float> cords;
+        {
+            py::gil_scoped_release release;
+            unsigned total_count = raliGetBoundingBoxCount(context, counts_ptr);
+            labels.resize(total_count);
+            cords.resize(total_count * 4);
+            raliGetBoundingBoxLabel(context, labels.data());
+            raliGetBoundingBoxCords(context, cords.data());
+        }
+        if (max_rows == 0)
+            for (size_t i = 0; i < batch_size; i++)
+                max_rows = std::max(max_rows, (unsigned)counts_ptr[i]);
+        py::array_t<float> padded_cords({ batch_size, (size_t)max_rows, (size_t)4 });
+        py::array_t<int> padded_labels({ batch_size, (size_t)max_rows });
+        float* cords_ptr = padded_cords.mutable_data();
+        int* labels_ptr = padded_labels.mutable_data();
+        std::fill(cords_ptr, cords_ptr + batch_size * max_rows * 4, 0.0f);
+        std::fill(labels_ptr, labels_ptr + batch_size * max_rows, 0);
+        size_t src_idx = 0;
+        for (size_t i = 0; i < batch_size; i++)
+        {
+            unsigned count = std::min((unsigned)counts_ptr[i], max_rows);
+            std::copy(cords.data() + src_idx * 4, cords.data() + (src_idx + count) * 4, cords_ptr + i * max_rows * 4);
+            std::copy(labels.data() + src_idx, labels.data() + src_idx + count, labels_ptr + i * max_rows);
+            src_idx += counts_ptr[i];
+        }
+        return py::make_tuple(padded_cords, padded_labels, counts);
+    }
+
     py::object wrapper_label_copy(RaliContext context, py::array_t<int> array)
     {
         auto buf = array.request();
         int* ptr = (int*) buf.ptr;
         // call pure C++ function
-        raliGetImageLabels(context,ptr);
+        {
+            py::gil_scoped_release release;
+            raliGetImageLabels(context,ptr);
+        }
         return py::cast<py::none>(Py_None);
     }
 
@@ -109,7 +289,10 @@ namespace rali{
         auto buf = array.request();
         int* ptr = (int*) buf.ptr;
         // call pure C++ function
-        raliGetImageId(context,ptr);
+        {
+            py::gil_scoped_release release;
+            raliGetImageId(context,ptr);
+        }
         return py::cast<py::none>(Py_None);
     }
     py::object wrapper_labels_BB_count_copy(RaliContext context, py::array_t<int> array)
@@ -118,7 +301,11 @@ namespace rali{
         auto buf = array.request();
         int* ptr = (int*) buf.ptr;
         // call pure C++ function
-        int count =raliGetBoundingBoxCount(context,ptr);
+        int count;
+        {
+            py::gil_scoped_release release;
+            count = raliGetBoundingBoxCount(context,ptr);
+        }
 
         return py::cast(count);
     }
@@ -129,7 +316,10 @@ namespace rali{
         auto buf = array.request();
         int* ptr = (int*) buf.ptr;
         // call pure C++ function
-        raliGetBoundingBoxLabel(context,ptr);
+        {
+            py::gil_scoped_release release;
+            raliGetBoundingBoxLabel(context,ptr);
+        }
         return py::cast<py::none>(Py_None);
     }
 
@@ -140,7 +330,10 @@ namespace rali{
         auto labels_buf = labels_array.request();
         int* labels_ptr = (int*) labels_buf.ptr;
         // call pure C++ function
-        raliCopyEncodedBoxesAndLables(context, bboxes_ptr , labels_ptr);
+        {
+            py::gil_scoped_release release;
+            raliCopyEncodedBoxesAndLables(context, bboxes_ptr , labels_ptr);
+        }
         return py::cast<py::none>(Py_None);
     }
 
@@ -149,7 +342,10 @@ namespace rali{
         auto buf = array.request();
         float* ptr = (float*) buf.ptr;
         // call pure C++ function
-        raliGetBoundingBoxCords(context,ptr);
+        {
+            py::gil_scoped_release release;
+            raliGetBoundingBoxCords(context,ptr);
+        }
         return py::cast<py::none>(Py_None);
     }
 
@@ -158,7 +354,10 @@ namespace rali{
         auto buf = array.request();
         int* ptr = (int*) buf.ptr;
         // call pure C++ function
-        raliGetImageSizes(context,ptr);
+        {
+            py::gil_scoped_release release;
+            raliGetImageSizes(context,ptr);
+        }
         return py::cast<py::none>(Py_None);
     }
 
@@ -167,7 +366,10 @@ namespace rali{
         auto buf = array.request();
         int* ptr = (int*) buf.ptr;
         // call pure C++ function
-        raliGetOneHotImageLabels(context, ptr, numOfClasses);
+        {
+            py::gil_scoped_release release;
+            raliGetOneHotImageLabels(context, ptr, numOfClasses);
+        }
         return py::cast<py::none>(Py_None);
     }
 
@@ -192,15 +394,24 @@ namespace rali{
                 py::arg("cpu_thread_count") = 1,
                 py::arg("prefetch_queue_depth") = 3,
                 py::arg("output_data_type") = 0);
-        m.def("raliVerify",&raliVerify);
-        m.def("raliRun",&raliRun);
-        m.def("raliRelease",&raliRelease);
+        m.def("raliSetFileReadOptions",&raliSetFileReadOptions,
+                py::arg("context"),
+                py::arg("readahead_count"),
+                py::arg("mode") = RALI_FILE_READ_BUFFERED);
+        m.def("raliSetDecodedImageCache",&raliSetDecodedImageCache,
+                py::arg("context"),
+                py::arg("memory_budget_mb"),
+                py::arg("spill_path") = nullptr);
+        m.def("raliVerify",&raliVerify, py::call_guard<py::gil_scoped_release>());
+        m.def("raliRun",&raliRun, py::call_guard<py::gil_scoped_release>());
+        m.def("raliRelease",&raliRelease, py::call_guard<py::gil_scoped_release>());
         // rali_api_types.h
         py::class_<TimingInfo>(m, "TimingInfo")
             .def_readwrite("load_time",&TimingInfo::load_time)
             .def_readwrite("decode_time",&TimingInfo::decode_time)
             .def_readwrite("process_time",&TimingInfo::process_time)
-            .def_readwrite("transfer_time",&TimingInfo::transfer_time);
+            .def_readwrite("transfer_time",&TimingInfo::transfer_time)
+            .def_readwrite("cache_hit_rate",&TimingInfo::cache_hit_rate);
         py::module types_m = m.def_submodule("types");
         types_m.doc() = "Datatypes and options used by RALI";
         py::enum_<RaliStatus>(types_m, "RaliStatus", "Status info")
@@ -209,6 +420,8 @@ namespace rali{
             .value("RUNTIME_ERROR",RALI_RUNTIME_ERROR)
             .value("UPDATE_PARAMETER_FAILED",RALI_UPDATE_PARAMETER_FAILED)
             .value("INVALID_PARAMETER_TYPE",RALI_INVALID_PARAMETER_TYPE)
+            .value("NO_MORE_DATA",RALI_NO_MORE_DATA)
+            .value("TIMEOUT",RALI_TIMEOUT)
             .export_values();
         py::enum_<RaliProcessMode>(types_m,"RaliProcessMode","Processing mode")
             .value("GPU",RALI_PROCESS_GPU)
@@ -235,6 +448,11 @@ namespace rali{
             .value("NHWC",RALI_NHWC)
             .value("NCHW",RALI_NCHW)
             .export_values();
+        py::enum_<RaliFileReadMode>(types_m,"RaliFileReadMode","File reader storage access")
+            .value("FILE_READ_BUFFERED",RALI_FILE_READ_BUFFERED)
+            .value("FILE_READ_DROP_CACHE",RALI_FILE_READ_DROP_CACHE)
+            .value("FILE_READ_DIRECT",RALI_FILE_READ_DIRECT)
+            .export_values();
         // rali_api_info.h
         m.def("getOutputWidth",&raliGetOutputWidth);
         m.def("getOutputHeight",&raliGetOutputHeight);
@@ -264,10 +482,12 @@ namespace rali{
         m.def("raliCopyEncodedBoxesAndLables",&wrapper_encoded_bbox_label);
         m.def("getImgSizes",&wrapper_img_sizes_copy);
         m.def("getBoundingBoxCount",&wrapper_labels_BB_count_copy);
+        m.def("getPaddedBoundingBoxes",&wrapper_padded_BB_copy);
         m.def("getOneHotEncodedLabels",&wrapper_one_hot_label_copy );
         m.def("isEmpty",&raliIsEmpty);
         m.def("BoxEncoder",&raliBoxEncoder);
         m.def("getTimingInfo",raliGetTimingInfo);
+        m.def("getVideoDecodedFramesPerOutputFrame",&raliGetVideoDecodedFramesPerOutputFrame);
         // rali_api_parameter.h
         m.def("setSeed",&raliSetSeed);
         m.def("getSeed",&raliGetSeed);
@@ -286,6 +506,13 @@ namespace rali{
         // rali_api_data_transfer.h
         m.def("raliCopyToOutput",&wrapper);
         m.def("raliCopyToOutputTensor",&wrapper_tensor);
+        m.def("raliGetOutputTensorDLPack",&wrapper_tensor_dlpack);
+        m.def("raliCreateSharedMemoryOutput",&raliCreateSharedMemoryOutput);
+        m.def("raliPublishToSharedMemory",&raliPublishToSharedMemory, py::call_guard<py::gil_scoped_release>());
+        m.def("raliAttachSharedMemory",&raliAttachSharedMemory, py::return_value_policy::reference);
+        m.def("raliAcquireSharedMemoryBatch",&wrapper_acquire_shared_memory_batch, py::arg("consumer"), py::arg("timeout_ms") = -1);
+        m.def("raliReleaseSharedMemoryBatch",&raliReleaseSharedMemoryBatch, py::call_guard<py::gil_scoped_release>());
+        m.def("raliDetachSharedMemory",&raliDetachSharedMemory);
         // rali_api_data_loaders.h
          m.def("COCO_ImageDecoderSlice",&raliJpegCOCOFileSourcePartial,"Reads file from the source given and decodes it according to the policy",
             py::return_value_policy::reference,
@@ -498,7 +725,7 @@ namespace rali{
               py::arg("file_name_prefix") = "",
               py::arg("loop") = false);
 
-        m.def("raliResetLoaders",&raliResetLoaders);
+        m.def("raliResetLoaders",&raliResetLoaders, py::call_guard<py::gil_scoped_release>());
         // rali_api_augmentation.h
         m.def("SSDRandomCrop",&raliSSDRandomCrop,
             py::return_value_policy::reference,
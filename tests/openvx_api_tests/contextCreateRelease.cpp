@@ -0,0 +1,92 @@
+/*
+Copyright (c) 2015 - 2022 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+// Creates and releases OpenVX contexts in a loop and checks that the resident set size stays flat.
+// Each context registers all built-in kernels, so a leak in the context teardown shows up as steady growth.
+
+#include <VX/vx.h>
+#include <stdio.h>
+#if __linux__
+#include <unistd.h>
+#endif
+
+#define WARMUP_CYCLES   50
+#define TEST_CYCLES     400
+#define MAX_GROWTH_KB   4096
+
+static long GetResidentSetSizeKB()
+{
+#if __linux__
+    long pages = 0, resident = 0;
+    FILE * fp = fopen("/proc/self/statm", "r");
+    if (!fp) return -1;
+    if (fscanf(fp, "%ld %ld", &pages, &resident) != 2) resident = -1;
+    fclose(fp);
+    return resident < 0 ? -1 : resident * (sysconf(_SC_PAGESIZE) / 1024);
+#else
+    return -1;
+#endif
+}
+
+static int CreateAndReleaseContext()
+{
+    vx_context context = vxCreateContext();
+    if (vxGetStatus((vx_reference)context) != VX_SUCCESS) {
+        printf("ERROR: vxCreateContext() failed\n");
+        return -1;
+    }
+    vx_graph graph = vxCreateGraph(context);
+    vx_image image = vxCreateImage(context, 64, 64, VX_DF_IMAGE_U8);
+    if (vxGetStatus((vx_reference)graph) != VX_SUCCESS || vxGetStatus((vx_reference)image) != VX_SUCCESS) {
+        printf("ERROR: vxCreateGraph() or vxCreateImage() failed\n");
+        return -1;
+    }
+    vxReleaseImage(&image);
+    vxReleaseGraph(&graph);
+    if (vxReleaseContext(&context) != VX_SUCCESS) {
+        printf("ERROR: vxReleaseContext() failed\n");
+        return -1;
+    }
+    return 0;
+}
+
+int main(int argc, char * argv[])
+{
+    for (int i = 0; i < WARMUP_CYCLES; i++) {
+        if (CreateAndReleaseContext() < 0) return -1;
+    }
+    long rss_start = GetResidentSetSizeKB();
+    for (int i = 0; i < TEST_CYCLES; i++) {
+        if (CreateAndReleaseContext() < 0) return -1;
+    }
+    long rss_end = GetResidentSetSizeKB();
+    if (rss_start < 0 || rss_end < 0) {
+        printf("OK: %d context create/release cycles (resident set size not available)\n", TEST_CYCLES);
+        return 0;
+    }
+    printf("OK: %d context create/release cycles: resident set size %ld KB -> %ld KB\n", TEST_CYCLES, rss_start, rss_end);
+    if (rss_end - rss_start > MAX_GROWTH_KB) {
+        printf("ERROR: resident set size grew by %ld KB (limit %d KB)\n", rss_end - rss_start, MAX_GROWTH_KB);
+        return -1;
+    }
+    return 0;
+}
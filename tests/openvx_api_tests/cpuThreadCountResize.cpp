@@ -0,0 +1,95 @@
+/*
+Copyright (c) 2015 - 2022 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+// Changes VX_CONTEXT_ATTRIBUTE_AMD_CPU_THREAD_COUNT while another thread executes a graph of the same context.
+// The change must be rejected with VX_ERROR_GRAPH_SCHEDULED while the graph executes, and every execution must succeed.
+
+#include <VX/vx.h>
+#include <vx_ext_amd.h>
+#include <stdio.h>
+#include <atomic>
+#include <thread>
+
+#define NUM_BRANCHES    4
+#define NUM_FRAMES      200
+
+int main(int argc, char * argv[])
+{
+    vx_context context = vxCreateContext();
+    if (vxGetStatus((vx_reference)context) != VX_SUCCESS) {
+        printf("ERROR: vxCreateContext() failed\n");
+        return -1;
+    }
+    AgoTargetAffinityInfo affinity = { 0 };
+    affinity.device_type = AGO_TARGET_AFFINITY_CPU;
+    vxSetContextAttribute(context, VX_CONTEXT_ATTRIBUTE_AMD_AFFINITY, &affinity, sizeof(affinity));
+    vx_uint32 thread_count = 4;
+    if (vxSetContextAttribute(context, VX_CONTEXT_ATTRIBUTE_AMD_CPU_THREAD_COUNT, &thread_count, sizeof(thread_count)) != VX_SUCCESS) {
+        printf("ERROR: setting the CPU thread count failed with no graph executing\n");
+        return -1;
+    }
+
+    // independent nodes at the same level run on the CPU thread pool
+    vx_graph graph = vxCreateGraph(context);
+    vx_image input = vxCreateImage(context, 512, 512, VX_DF_IMAGE_U8);
+    vx_image output[NUM_BRANCHES];
+    for (int i = 0; i < NUM_BRANCHES; i++) {
+        output[i] = vxCreateImage(context, 512, 512, VX_DF_IMAGE_U8);
+        vxBox3x3Node(graph, input, output[i]);
+    }
+    if (vxVerifyGraph(graph) != VX_SUCCESS) {
+        printf("ERROR: vxVerifyGraph() failed\n");
+        return -1;
+    }
+
+    std::atomic<bool> done{ false };
+    std::atomic<int> failures{ 0 };
+    std::thread executor([&]() {
+        for (int i = 0; i < NUM_FRAMES; i++) {
+            if (vxProcessGraph(graph) != VX_SUCCESS) failures++;
+        }
+        done = true;
+    });
+    int accepted = 0, rejected = 0, unexpected = 0;
+    for (vx_uint32 i = 0; !done; i++) {
+        thread_count = 2 + (i & 3);
+        vx_status status = vxSetContextAttribute(context, VX_CONTEXT_ATTRIBUTE_AMD_CPU_THREAD_COUNT, &thread_count, sizeof(thread_count));
+        if (status == VX_SUCCESS) accepted++;
+        else if (status == VX_ERROR_GRAPH_SCHEDULED) rejected++;
+        else unexpected++;
+    }
+    executor.join();
+
+    for (int i = 0; i < NUM_BRANCHES; i++)
+        vxReleaseImage(&output[i]);
+    vxReleaseImage(&input);
+    vxReleaseGraph(&graph);
+    vxReleaseContext(&context);
+
+    printf("OK: %d frames: thread count changes accepted %d, rejected %d\n", NUM_FRAMES, accepted, rejected);
+    if (failures > 0 || unexpected > 0) {
+        printf("ERROR: %d graph executions failed, %d thread count changes returned an unexpected status\n", (int)failures, unexpected);
+        return -1;
+    }
+    return 0;
+}
@@ -0,0 +1,153 @@
+/*
+Copyright (c) 2015 - 2022 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+// Runs a chain of pointwise nodes with virtual intermediates at an odd image size, once with the default optimizer
+// flags so that the chain is fused into one node, and once with AGO_GRAPH_OPTIMIZER_FLAG_NO_POINTWISE_FUSION.
+// Both outputs must be bit-exact.
+
+#include <VX/vx.h>
+#include <vx_ext_amd.h>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+#define WIDTH       1283
+#define HEIGHT      721
+#define NUM_FRAMES  3
+
+// same value as AGO_GRAPH_OPTIMIZER_FLAG_NO_POINTWISE_FUSION in ago_internal.h
+#define OPTIMIZER_FLAG_NO_POINTWISE_FUSION  0x00000080
+
+static vx_status fillImage(vx_image image, vx_uint32 seed)
+{
+    vx_rectangle_t rect = { 0, 0, WIDTH, HEIGHT };
+    vx_imagepatch_addressing_t addr = { 0 };
+    vx_map_id map_id;
+    void * ptr = nullptr;
+    vx_status status = vxMapImagePatch(image, &rect, 0, &map_id, &addr, &ptr, VX_WRITE_ONLY, VX_MEMORY_TYPE_HOST, VX_NOGAP_X);
+    if (status != VX_SUCCESS)
+        return status;
+    for (vx_uint32 y = 0; y < HEIGHT; y++) {
+        vx_uint8 * row = (vx_uint8 *)ptr + y * addr.stride_y;
+        for (vx_uint32 x = 0; x < WIDTH; x++) {
+            seed = seed * 1664525u + 1013904223u;
+            row[x] = (vx_uint8)(seed >> 24);
+        }
+    }
+    return vxUnmapImagePatch(image, map_id);
+}
+
+static vx_status readImage(vx_image image, std::vector<vx_uint8>& pixels)
+{
+    vx_rectangle_t rect = { 0, 0, WIDTH, HEIGHT };
+    vx_imagepatch_addressing_t addr = { 0 };
+    addr.dim_x = WIDTH;
+    addr.dim_y = HEIGHT;
+    addr.stride_x = 1;
+    addr.stride_y = WIDTH;
+    pixels.resize(WIDTH * HEIGHT);
+    return vxCopyImagePatch(image, &rect, 0, &addr, pixels.data(), VX_READ_ONLY, VX_MEMORY_TYPE_HOST);
+}
+
+static int runChain(vx_context context, vx_uint32 optimizer_flags, std::vector<vx_uint8>& pixels)
+{
+    vx_graph graph = vxCreateGraph(context);
+    vxSetGraphAttribute(graph, VX_GRAPH_ATTRIBUTE_AMD_OPTIMIZER_FLAGS, &optimizer_flags, sizeof(optimizer_flags));
+    vx_image in1 = vxCreateImage(context, WIDTH, HEIGHT, VX_DF_IMAGE_U8);
+    vx_image in2 = vxCreateImage(context, WIDTH, HEIGHT, VX_DF_IMAGE_U8);
+    vx_image out = vxCreateImage(context, WIDTH, HEIGHT, VX_DF_IMAGE_U8);
+    vx_image sum = vxCreateVirtualImage(graph, WIDTH, HEIGHT, VX_DF_IMAGE_S16);
+    vx_image depth = vxCreateVirtualImage(graph, WIDTH, HEIGHT, VX_DF_IMAGE_U8);
+    vx_image product = vxCreateVirtualImage(graph, WIDTH, HEIGHT, VX_DF_IMAGE_U8);
+    vx_image bits = vxCreateVirtualImage(graph, WIDTH, HEIGHT, VX_DF_IMAGE_U8);
+    vx_image inverted = vxCreateVirtualImage(graph, WIDTH, HEIGHT, VX_DF_IMAGE_U8);
+    vx_int32 shift_value = 1;
+    vx_float32 scale_value = 1.0f / 64;
+    vx_scalar shift = vxCreateScalar(context, VX_TYPE_INT32, &shift_value);
+    vx_scalar scale = vxCreateScalar(context, VX_TYPE_FLOAT32, &scale_value);
+    vxAddNode(graph, in1, in2, VX_CONVERT_POLICY_SATURATE, sum);
+    vxConvertDepthNode(graph, sum, depth, VX_CONVERT_POLICY_SATURATE, shift);
+    vxMultiplyNode(graph, depth, in2, scale, VX_CONVERT_POLICY_SATURATE, VX_ROUND_POLICY_TO_NEAREST_EVEN, product);
+    vxXorNode(graph, product, in1, bits);
+    vxNotNode(graph, bits, inverted);
+    vxAddNode(graph, inverted, in2, VX_CONVERT_POLICY_WRAP, out);
+    int result = 0;
+    if (vxVerifyGraph(graph) != VX_SUCCESS) {
+        printf("ERROR: vxVerifyGraph() failed with optimizer flags 0x%x\n", optimizer_flags);
+        result = -1;
+    }
+    for (int i = 0; i < NUM_FRAMES && !result; i++) {
+        // new inputs every frame, the output of the last frame is compared
+        if (fillImage(in1, 1 + i) != VX_SUCCESS || fillImage(in2, 101 + i) != VX_SUCCESS || vxProcessGraph(graph) != VX_SUCCESS) {
+            printf("ERROR: frame %d failed with optimizer flags 0x%x\n", i, optimizer_flags);
+            result = -1;
+        }
+    }
+    if (!result && readImage(out, pixels) != VX_SUCCESS) {
+        printf("ERROR: reading the output failed with optimizer flags 0x%x\n", optimizer_flags);
+        result = -1;
+    }
+    vxReleaseScalar(&shift);
+    vxReleaseScalar(&scale);
+    vxReleaseImage(&sum);
+    vxReleaseImage(&depth);
+    vxReleaseImage(&product);
+    vxReleaseImage(&bits);
+    vxReleaseImage(&inverted);
+    vxReleaseImage(&in1);
+    vxReleaseImage(&in2);
+    vxReleaseImage(&out);
+    vxReleaseGraph(&graph);
+    return result;
+}
+
+int main(int argc, char * argv[])
+{
+    vx_context context = vxCreateContext();
+    if (vxGetStatus((vx_reference)context) != VX_SUCCESS) {
+        printf("ERROR: vxCreateContext() failed\n");
+        return -1;
+    }
+    AgoTargetAffinityInfo affinity = { 0 };
+    affinity.device_type = AGO_TARGET_AFFINITY_CPU;
+    vxSetContextAttribute(context, VX_CONTEXT_ATTRIBUTE_AMD_AFFINITY, &affinity, sizeof(affinity));
+    // run the rows in bands so that every band uses its own strip buffers
+    vx_uint32 thread_count = 4;
+    vxSetContextAttribute(context, VX_CONTEXT_ATTRIBUTE_AMD_CPU_THREAD_COUNT, &thread_count, sizeof(thread_count));
+
+    std::vector<vx_uint8> fused, unfused;
+    int result = runChain(context, 0, fused);
+    if (!result)
+        result = runChain(context, OPTIMIZER_FLAG_NO_POINTWISE_FUSION, unfused);
+    vxReleaseContext(&context);
+    if (result)
+        return -1;
+
+    if (fused.size() != unfused.size() || memcmp(fused.data(), unfused.data(), fused.size()) != 0) {
+        size_t i = 0;
+        while (i < fused.size() && fused[i] == unfused[i]) i++;
+        printf("ERROR: fused and unfused outputs differ at pixel (%d,%d): %d != %d\n", (int)(i % WIDTH), (int)(i / WIDTH), fused[i], unfused[i]);
+        return -1;
+    }
+    printf("OK: %dx%d pointwise chain is bit-exact with and without fusion\n", WIDTH, HEIGHT);
+    return 0;
+}
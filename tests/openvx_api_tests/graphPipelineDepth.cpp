@@ -0,0 +1,193 @@
+/*
+Copyright (c) 2015 - 2022 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+// Runs the same graph with queued graph parameters at pipeline depth 1 and depth 4 over several enqueued
+// frames with a new input per frame. The frames must complete in submission order with identical outputs.
+
+#include <VX/vx.h>
+#include <VX/vx_khr_pipelining.h>
+#include <vx_ext_amd.h>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+#define WIDTH       641
+#define HEIGHT      481
+#define NUM_FRAMES  10
+#define MAX_DEPTH   4
+
+static vx_status fillImage(vx_image image, vx_uint32 seed)
+{
+    vx_rectangle_t rect = { 0, 0, WIDTH, HEIGHT };
+    vx_imagepatch_addressing_t addr = { 0 };
+    vx_map_id map_id;
+    void * ptr = nullptr;
+    vx_status status = vxMapImagePatch(image, &rect, 0, &map_id, &addr, &ptr, VX_WRITE_ONLY, VX_MEMORY_TYPE_HOST, VX_NOGAP_X);
+    if (status != VX_SUCCESS)
+        return status;
+    for (vx_uint32 y = 0; y < HEIGHT; y++) {
+        vx_uint8 * row = (vx_uint8 *)ptr + y * addr.stride_y;
+        for (vx_uint32 x = 0; x < WIDTH; x++) {
+            seed = seed * 1664525u + 1013904223u;
+            row[x] = (vx_uint8)(seed >> 24);
+        }
+    }
+    return vxUnmapImagePatch(image, map_id);
+}
+
+static vx_status readImage(vx_image image, std::vector<vx_uint8>& pixels)
+{
+    vx_rectangle_t rect = { 0, 0, WIDTH, HEIGHT };
+    vx_imagepatch_addressing_t addr = { 0 };
+    addr.dim_x = WIDTH;
+    addr.dim_y = HEIGHT;
+    addr.stride_x = 1;
+    addr.stride_y = WIDTH;
+    pixels.resize(WIDTH * HEIGHT);
+    return vxCopyImagePatch(image, &rect, 0, &addr, pixels.data(), VX_READ_ONLY, VX_MEMORY_TYPE_HOST);
+}
+
+// runs NUM_FRAMES frames through a graph with 'depth' references per queued graph parameter and
+// returns the outputs in the order the frames were dequeued
+static int runFrames(vx_context context, vx_uint32 depth, std::vector<std::vector<vx_uint8>>& outputs)
+{
+    vx_graph graph = vxCreateGraph(context);
+    vx_image in[MAX_DEPTH], out[MAX_DEPTH];
+    for (vx_uint32 i = 0; i < depth; i++) {
+        in[i] = vxCreateImage(context, WIDTH, HEIGHT, VX_DF_IMAGE_U8);
+        out[i] = vxCreateImage(context, WIDTH, HEIGHT, VX_DF_IMAGE_U8);
+    }
+    vx_image blurred = vxCreateVirtualImage(graph, WIDTH, HEIGHT, VX_DF_IMAGE_U8);
+    vx_image dilated = vxCreateVirtualImage(graph, WIDTH, HEIGHT, VX_DF_IMAGE_U8);
+    vx_image diff = vxCreateVirtualImage(graph, WIDTH, HEIGHT, VX_DF_IMAGE_U8);
+    vx_node nodeIn = vxGaussian3x3Node(graph, in[0], blurred);
+    vxDilate3x3Node(graph, blurred, dilated);
+    vxAbsDiffNode(graph, dilated, in[0], diff);
+    vx_node nodeOut = vxNotNode(graph, diff, out[0]);
+    vx_parameter parameter = vxGetParameterByIndex(nodeIn, 0);
+    vxAddParameterToGraph(graph, parameter);
+    vxReleaseParameter(&parameter);
+    parameter = vxGetParameterByIndex(nodeOut, 1);
+    vxAddParameterToGraph(graph, parameter);
+    vxReleaseParameter(&parameter);
+
+    int result = 0;
+    vx_graph_parameter_queue_params_t queueParams[2];
+    queueParams[0].graph_parameter_index = 0;
+    queueParams[0].refs_list_size = depth;
+    queueParams[0].refs_list = (vx_reference *)in;
+    queueParams[1].graph_parameter_index = 1;
+    queueParams[1].refs_list_size = depth;
+    queueParams[1].refs_list = (vx_reference *)out;
+    vx_uint32 pipelineDepth = 0;
+    if (vxSetGraphScheduleConfig(graph, VX_GRAPH_SCHEDULE_MODE_QUEUE_AUTO, 2, queueParams) != VX_SUCCESS) {
+        printf("ERROR: vxSetGraphScheduleConfig() failed with depth %d\n", depth);
+        result = -1;
+    }
+    else if (vxVerifyGraph(graph) != VX_SUCCESS) {
+        printf("ERROR: vxVerifyGraph() failed with depth %d\n", depth);
+        result = -1;
+    }
+    else if (vxQueryGraph(graph, VX_GRAPH_ATTRIBUTE_AMD_PIPELINE_DEPTH, &pipelineDepth, sizeof(pipelineDepth)) != VX_SUCCESS || pipelineDepth != depth) {
+        printf("ERROR: VX_GRAPH_ATTRIBUTE_AMD_PIPELINE_DEPTH is %d instead of %d\n", pipelineDepth, depth);
+        result = -1;
+    }
+
+    // keep up to 'depth' frames in flight: frame f uses in[f % depth] and out[f % depth]
+    vx_uint32 launchCount = 0;
+    for (vx_uint32 frame = 0; frame < NUM_FRAMES && !result; frame++) {
+        for (; launchCount < NUM_FRAMES && launchCount < frame + depth && !result; launchCount++) {
+            vx_uint32 slot = launchCount % depth;
+            if (fillImage(in[slot], 1 + launchCount) != VX_SUCCESS ||
+                vxGraphParameterEnqueueReadyRef(graph, 0, (vx_reference *)&in[slot], 1) != VX_SUCCESS ||
+                vxGraphParameterEnqueueReadyRef(graph, 1, (vx_reference *)&out[slot], 1) != VX_SUCCESS)
+            {
+                printf("ERROR: enqueue of frame %d failed with depth %d\n", launchCount, depth);
+                result = -1;
+            }
+        }
+        vx_reference doneIn = nullptr, doneOut = nullptr;
+        vx_uint32 numIn = 0, numOut = 0;
+        if (!result && (vxGraphParameterDequeueDoneRef(graph, 0, &doneIn, 1, &numIn) != VX_SUCCESS ||
+                        vxGraphParameterDequeueDoneRef(graph, 1, &doneOut, 1, &numOut) != VX_SUCCESS || numIn != 1 || numOut != 1))
+        {
+            printf("ERROR: dequeue of frame %d failed with depth %d\n", frame, depth);
+            result = -1;
+        }
+        else if (!result && (doneIn != (vx_reference)in[frame % depth] || doneOut != (vx_reference)out[frame % depth])) {
+            printf("ERROR: frame %d completed out of submission order with depth %d\n", frame, depth);
+            result = -1;
+        }
+        else if (!result) {
+            outputs.emplace_back();
+            if (readImage(out[frame % depth], outputs.back()) != VX_SUCCESS) {
+                printf("ERROR: reading the output of frame %d failed with depth %d\n", frame, depth);
+                result = -1;
+            }
+        }
+    }
+    if (vxWaitGraph(graph) != VX_SUCCESS && !result) {
+        printf("ERROR: vxWaitGraph() failed with depth %d\n", depth);
+        result = -1;
+    }
+
+    vxReleaseNode(&nodeIn);
+    vxReleaseNode(&nodeOut);
+    vxReleaseImage(&blurred);
+    vxReleaseImage(&dilated);
+    vxReleaseImage(&diff);
+    vxReleaseGraph(&graph);
+    for (vx_uint32 i = 0; i < depth; i++) {
+        vxReleaseImage(&in[i]);
+        vxReleaseImage(&out[i]);
+    }
+    return result;
+}
+
+int main(int argc, char * argv[])
+{
+    vx_context context = vxCreateContext();
+    if (vxGetStatus((vx_reference)context) != VX_SUCCESS) {
+        printf("ERROR: vxCreateContext() failed\n");
+        return -1;
+    }
+    AgoTargetAffinityInfo affinity = { 0 };
+    affinity.device_type = AGO_TARGET_AFFINITY_CPU;
+    vxSetContextAttribute(context, VX_CONTEXT_ATTRIBUTE_AMD_AFFINITY, &affinity, sizeof(affinity));
+
+    std::vector<std::vector<vx_uint8>> serial, pipelined;
+    int result = runFrames(context, 1, serial);
+    if (!result)
+        result = runFrames(context, MAX_DEPTH, pipelined);
+    vxReleaseContext(&context);
+    if (result)
+        return -1;
+
+    for (vx_uint32 frame = 0; frame < NUM_FRAMES; frame++) {
+        if (memcmp(serial[frame].data(), pipelined[frame].data(), serial[frame].size()) != 0) {
+            printf("ERROR: output of frame %d differs between depth 1 and depth %d\n", frame, MAX_DEPTH);
+            return -1;
+        }
+    }
+    printf("OK: %d frames are identical and in submission order with depth 1 and depth %d\n", NUM_FRAMES, MAX_DEPTH);
+    return 0;
+}
@@ -0,0 +1,97 @@
+#!/bin/bash
+
+############# Help and Syntax #############
+
+# Help
+
+# The runvxBandTilingBenchmark.sh bash script measures the speedup of CPU kernels that are split into row bands.
+# - Each kernel GDF is run on runvx with serial execution and with a CPU thread pool (AGO_THREAD_CONFIG bits[15:8]).
+# - The average frame time reported by runvx is used to print a per-kernel speedup table.
+
+# Syntax
+
+# Syntax: `./runvxBandTilingBenchmark.sh <W> <H> <T> <F> <P>` where:
+# ```
+# - W     WIDTH of image in pixels (ex: 3840)
+# - H     HEIGHT of image in pixels (ex: 2160)
+# - T     number of CPU THREADS (ex: 8)
+# - F     number of FRAMES to run (ex: 100)
+# - P     RunVX path (for MIVisionX built with any backend)
+# ```
+
+############# Help and Syntax #############
+
+
+
+
+
+############# Edit GDF path and kernel names here #############
+
+GDF_PATH="kernelGDFs"
+
+GDF_BAND_LIST="arithmetic/Add_U8_U8U8_Wrap
+arithmetic/Add_U8_U8U8_Sat
+arithmetic/Sub_U8_U8U8_Wrap
+arithmetic/Sub_U8_U8U8_Sat
+arithmetic/AbsDiff_U8_U8U8
+filter/Box_U8_U8_3x3
+filter/Dilate_U8_U8_3x3
+filter/Erode_U8_U8_3x3
+filter/Median_U8_U8_3x3
+filter/Gaussian_U8_U8_3x3
+filter/Sobel_S16S16_U8_3x3_GXY
+color/ColorConvert_RGB_RGBX
+color/ColorConvert_RGBX_RGB
+color/ColorConvert_IYUV_RGB
+color/ColorConvert_RGB_IYUV
+color/ColorConvert_RGB_NV12"
+
+############# Edit GDF path and kernel names here #############
+
+
+
+
+
+############# Need not edit - Main script #############
+
+if (( "$#" < 5 )); then
+    echo
+    echo "The runvxBandTilingBenchmark.sh bash script measures the speedup of CPU kernels that are split into row bands."
+    echo
+    echo "Syntax: ./runvxBandTilingBenchmark.sh <W> <H> <T> <F> <P>"
+    echo "W     WIDTH of image in pixels"
+    echo "H     HEIGHT of image in pixels"
+    echo "T     number of CPU THREADS"
+    echo "F     number of FRAMES to run"
+    echo "P     RunVX path"
+    exit 1
+fi
+
+WIDTH="$1"
+HEIGHT="$2"
+THREADS="$3"
+FRAMES="$4"
+RUNVX_PATH="$5/"
+GENERATED_GDF_PATH="generatedBandTilingGDFs"
+
+mkdir -p "$GENERATED_GDF_PATH"
+
+# run_avg_ms function to run a GDF with a given AGO_THREAD_CONFIG and print average frame time
+run_avg_ms() {
+    AGO_THREAD_CONFIG="$1" "$RUNVX_PATH"runvx -frames:"$FRAMES" -affinity:CPU "$2" | grep "csv,OVERALL" | cut -d, -f6 | tr -d ' '
+}
+
+printf "\nCPU row band tiling on %sx%s with %s threads (%s frames)\n\n" "$WIDTH" "$HEIGHT" "$THREADS" "$FRAMES"
+printf "| %-32s | %10s | %10s | %7s |\n" "Kernel" "1T ms" "${THREADS}T ms" "Speedup"
+printf "|%s|%s|%s|%s|\n" "----------------------------------" "------------" "------------" "---------"
+for GDF in $GDF_BAND_LIST;
+do
+    NAME=$(basename "$GDF")
+    sed "s/1920,1080/$WIDTH,$HEIGHT/" "$GDF_PATH/$GDF.gdf" > "$GENERATED_GDF_PATH/$NAME.gdf"
+    SERIAL_MS=$(run_avg_ms 1 "$GENERATED_GDF_PATH/$NAME.gdf")
+    PARALLEL_MS=$(run_avg_ms $(( (THREADS << 8) | 1 )) "$GENERATED_GDF_PATH/$NAME.gdf")
+    SPEEDUP=$(awk -v s="$SERIAL_MS" -v p="$PARALLEL_MS" 'BEGIN { if (p > 0) printf "%.2fx", s / p; else print "n/a" }')
+    printf "| %-32s | %10s | %10s | %7s |\n" "$NAME" "$SERIAL_MS" "$PARALLEL_MS" "$SPEEDUP"
+done
+
+############# Need not edit - Main script #############
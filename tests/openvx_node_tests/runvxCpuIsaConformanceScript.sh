@@ -0,0 +1,118 @@
+#!/bin/bash
+
+############# Help and Syntax #############
+
+# Help
+
+# The runvxCpuIsaConformanceScript.sh bash script checks that the runtime dispatched CPU kernels are bit-exact across instruction sets.
+# - Each kernel GDF is run on runvx with random inputs and AGO_CPU_ISA set to SSE4.2, AVX2, and AVX512.
+# - The outputs of AVX2 and AVX512 are compared with the SSE4.2 outputs (levels not supported by the CPU fall back to the best supported level).
+# - Color conversion kernels require an even WIDTH: use an odd WIDTH to exercise the scalar tails of the other kernels.
+
+# Syntax
+
+# Syntax: `./runvxCpuIsaConformanceScript.sh <W> <H> <P>` where:
+# ```
+# - W     WIDTH of image in pixels (ex: 1001)
+# - H     HEIGHT of image in pixels (ex: 778)
+# - P     RunVX path (for MIVisionX built with any backend)
+# ```
+
+############# Help and Syntax #############
+
+
+
+
+
+############# Edit GDF path and kernel names here #############
+
+GDF_PATH="kernelGDFs"
+
+GDF_DISPATCH_LIST="arithmetic/Add_U8_U8U8_Wrap
+arithmetic/Add_U8_U8U8_Sat
+arithmetic/Sub_U8_U8U8_Wrap
+arithmetic/Sub_U8_U8U8_Sat
+arithmetic/AbsDiff_U8_U8U8
+filter/Box_U8_U8_3x3
+filter/Gaussian_U8_U8_3x3
+filter/Sobel_S16S16_U8_3x3_GXY
+color/ColorConvert_RGB_RGBX
+color/ColorConvert_RGBX_RGB"
+
+ISA_LIST="SSE4.2 AVX2 AVX512"
+
+############# Edit GDF path and kernel names here #############
+
+
+
+
+
+############# Need not edit - Main script #############
+
+if (( "$#" < 3 )); then
+    echo
+    echo "The runvxCpuIsaConformanceScript.sh bash script checks that the runtime dispatched CPU kernels are bit-exact across instruction sets."
+    echo
+    echo "Syntax: ./runvxCpuIsaConformanceScript.sh <W> <H> <P>"
+    echo "W     WIDTH of image in pixels"
+    echo "H     HEIGHT of image in pixels"
+    echo "P     RunVX path"
+    exit 1
+fi
+
+WIDTH="$1"
+HEIGHT="$2"
+RUNVX_PATH="$3/"
+GENERATED_GDF_PATH="generatedCpuIsaGDFs"
+
+mkdir -p "$GENERATED_GDF_PATH"
+GENERATED_DATA_PATH="$(cd "$GENERATED_GDF_PATH" && pwd)"
+
+# random input large enough for any 4 bytes per pixel image
+head -c $(( WIDTH * HEIGHT * 4 )) /dev/urandom > "$GENERATED_DATA_PATH/random_input.raw"
+
+FAILED=0
+printf "\nCPU instruction set conformance on %sx%s\n\n" "$WIDTH" "$HEIGHT"
+printf "| %-32s | %-8s | %-8s |\n" "Kernel" "AVX2" "AVX512"
+printf "|%s|%s|%s|\n" "----------------------------------" "----------" "----------"
+for GDF in $GDF_DISPATCH_LIST;
+do
+    NAME=$(basename "$GDF")
+    RESULT=""
+    RUN_FAILED=""
+    for ISA in $ISA_LIST;
+    do
+        # replace uniform inputs with random data and write all outputs
+        GENERATED_GDF="$GENERATED_GDF_PATH/${NAME}_$ISA.gdf"
+        sed -e "s/1920,1080/$WIDTH,$HEIGHT/" -e "s/uniform-image:\([0-9]*\),\([0-9]*\),\([A-Z0-9]*\),.*/image:\1,\2,\3/" "$GDF_PATH/$GDF.gdf" > "$GENERATED_GDF"
+        echo >> "$GENERATED_GDF"
+        for INPUT in $(grep -o "^data input_[0-9]*" "$GDF_PATH/$GDF.gdf" | cut -d' ' -f2); do
+            echo "read $INPUT $GENERATED_DATA_PATH/random_input.raw" >> "$GENERATED_GDF"
+        done
+        for OUTPUT in $(grep -o "^data output_[0-9]*" "$GDF_PATH/$GDF.gdf" | cut -d' ' -f2); do
+            echo "write $OUTPUT $GENERATED_DATA_PATH/${NAME}_${ISA}_$OUTPUT.raw" >> "$GENERATED_GDF"
+        done
+        rm -f "$GENERATED_DATA_PATH/${NAME}_${ISA}_"output_*.raw
+        if ! AGO_CPU_ISA="$ISA" "$RUNVX_PATH"runvx -frames:1 -affinity:CPU "$GENERATED_GDF" > /dev/null; then
+            RUN_FAILED=1
+        fi
+        if [ "$ISA" != "SSE4.2" ]; then
+            STATUS="PASS"
+            for OUTPUT in $(grep -o "^data output_[0-9]*" "$GDF_PATH/$GDF.gdf" | cut -d' ' -f2); do
+                if [ -n "$RUN_FAILED" ]; then
+                    STATUS="ERROR"
+                    FAILED=1
+                elif ! cmp -s "$GENERATED_DATA_PATH/${NAME}_SSE4.2_$OUTPUT.raw" "$GENERATED_DATA_PATH/${NAME}_${ISA}_$OUTPUT.raw"; then
+                    STATUS="FAIL"
+                    FAILED=1
+                fi
+            done
+            RESULT="$RESULT $STATUS"
+        fi
+    done
+    printf "| %-32s | %-8s | %-8s |\n" "$NAME" $RESULT
+done
+
+exit $FAILED
+
+############# Need not edit - Main script #############
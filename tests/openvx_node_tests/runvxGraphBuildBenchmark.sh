@@ -0,0 +1,85 @@
+#!/bin/bash
+
+############# Help and Syntax #############
+
+# Help
+
+# The runvxGraphBuildBenchmark.sh bash script measures how the time to build and verify a graph grows with the node count.
+# - A chain of N org.khronos.openvx.box_3x3 nodes on small named virtual images is run once on runvx for each node count.
+# - With small images the pixel work is negligible, so the time is spent on creating, naming and looking up kernels
+#   and data objects, and in the graph optimizer.
+
+# Syntax
+
+# Syntax: `./runvxGraphBuildBenchmark.sh <P>` where:
+# ```
+# - P     RunVX path
+# ```
+
+############# Help and Syntax #############
+
+
+
+
+
+############# Edit node counts here #############
+
+NODE_COUNT_LIST="1000
+2500
+5000
+10000"
+
+############# Edit node counts here #############
+
+
+
+
+
+############# Need not edit - Main script #############
+
+if (( "$#" < 1 )); then
+    echo
+    echo "The runvxGraphBuildBenchmark.sh bash script measures how the time to build and verify a graph grows with the node count."
+    echo
+    echo "Syntax: ./runvxGraphBuildBenchmark.sh <P>"
+    echo "P     RunVX path"
+    exit 1
+fi
+
+RUNVX_PATH="$1/"
+GENERATED_GDF_PATH="generatedGraphBuildGDFs"
+
+mkdir -p "$GENERATED_GDF_PATH"
+
+# write_gdf function to generate a GDF with a chain of NODES box filters on 16x16 images
+write_gdf() {
+    local NODES="$1" GDF="$2"
+    {
+        echo "data src = image:16,16,U008"
+        echo "data dst = image:16,16,U008"
+        local IN="src"
+        for (( n = 1; n < NODES; n++ )); do
+            echo "data tmp$n = virtual-image:16,16,U008"
+            echo "node org.khronos.openvx.box_3x3 $IN tmp$n"
+            IN="tmp$n"
+        done
+        echo "node org.khronos.openvx.box_3x3 $IN dst"
+    } > "$GDF"
+}
+
+printf "\nGraph build and verify time with a chain of box_3x3 nodes\n\n"
+printf "| %-10s | %12s | %12s |\n" "Nodes" "ms" "us/node"
+printf "|%s|%s|%s|\n" "------------" "--------------" "--------------"
+for NODES in $NODE_COUNT_LIST;
+do
+    GDF="$GENERATED_GDF_PATH/BoxChain_${NODES}.gdf"
+    write_gdf "$NODES" "$GDF"
+    START=$(date +%s%N)
+    "$RUNVX_PATH"runvx -frames:1 -affinity:CPU "$GDF" > /dev/null
+    END=$(date +%s%N)
+    MS=$(( (END - START) / 1000000 ))
+    US_PER_NODE=$(awk -v t="$MS" -v n="$NODES" 'BEGIN { printf "%.2f", t * 1000 / n }')
+    printf "| %-10s | %12s | %12s |\n" "$NODES" "$MS" "$US_PER_NODE"
+done
+
+############# Need not edit - Main script #############
@@ -0,0 +1,109 @@
+#!/bin/bash
+
+############# Help and Syntax #############
+
+# Help
+
+# The runvxRppNodeOverheadBenchmark.sh bash script measures the per node overhead of the amd_rpp batchPD kernels.
+# - A chain of N org.rpp.BrightnessbatchPD nodes is run on runvx for each image size, as a rocAL augmentation chain does.
+# - At small image sizes the pixel work is negligible, so the time per node is mostly the cost of refreshing the batch
+#   parameters and geometry before the RPP call.
+
+# Syntax
+
+# Syntax: `./runvxRppNodeOverheadBenchmark.sh <B> <N> <F> <P>` where:
+# ```
+# - B     BATCH size (ex: 64)
+# - N     NUMBER of chained nodes (ex: 10)
+# - F     number of FRAMES to run (ex: 1000)
+# - P     RunVX path (for MIVisionX built with the amd_rpp extension)
+# ```
+
+############# Help and Syntax #############
+
+
+
+
+
+############# Edit image sizes here #############
+
+IMAGE_SIZE_LIST="4x4
+16x16
+64x64
+224x224"
+
+############# Edit image sizes here #############
+
+
+
+
+
+############# Need not edit - Main script #############
+
+if (( "$#" < 4 )); then
+    echo
+    echo "The runvxRppNodeOverheadBenchmark.sh bash script measures the per node overhead of the amd_rpp batchPD kernels."
+    echo
+    echo "Syntax: ./runvxRppNodeOverheadBenchmark.sh <B> <N> <F> <P>"
+    echo "B     BATCH size"
+    echo "N     NUMBER of chained nodes"
+    echo "F     number of FRAMES to run"
+    echo "P     RunVX path"
+    exit 1
+fi
+
+BATCH="$1"
+NODES="$2"
+FRAMES="$3"
+RUNVX_PATH="$4/"
+GENERATED_GDF_PATH="generatedRppOverheadGDFs"
+
+mkdir -p "$GENERATED_GDF_PATH"
+
+# write_values function to write BATCH copies of a value, one per line, to a text file for array initialization
+write_values() {
+    for (( i = 0; i < BATCH; i++ )); do echo "$1"; done > "$2"
+}
+
+# write_gdf function to generate a GDF with a chain of NODES brightness nodes on a batch of WxH RGB images
+write_gdf() {
+    local W="$1" H="$2" GDF="$3"
+    write_values "$W" "$GENERATED_GDF_PATH/width_$W.txt"
+    write_values "$H" "$GENERATED_GDF_PATH/height_$H.txt"
+    write_values 1.1 "$GENERATED_GDF_PATH/alpha.txt"
+    write_values 10 "$GENERATED_GDF_PATH/beta.txt"
+    {
+        echo "import vx_rpp"
+        echo "data src = image:$W,$(( H * BATCH )),RGB2"
+        echo "data dst = image:$W,$(( H * BATCH )),RGB2"
+        echo "data width = array:UINT32,$BATCH:init,$GENERATED_GDF_PATH/width_$W.txt"
+        echo "data height = array:UINT32,$BATCH:init,$GENERATED_GDF_PATH/height_$H.txt"
+        echo "data alpha = array:FLOAT32,$BATCH:init,$GENERATED_GDF_PATH/alpha.txt"
+        echo "data beta = array:FLOAT32,$BATCH:init,$GENERATED_GDF_PATH/beta.txt"
+        echo "data batch = scalar:UINT32,$BATCH"
+        echo "data device = scalar:UINT32,16"
+        local IN="src"
+        for (( n = 1; n < NODES; n++ )); do
+            echo "data tmp$n = virtual-image:$W,$(( H * BATCH )),RGB2"
+            echo "node org.rpp.BrightnessbatchPD $IN width height tmp$n alpha beta batch device"
+            IN="tmp$n"
+        done
+        echo "node org.rpp.BrightnessbatchPD $IN width height dst alpha beta batch device"
+    } > "$GDF"
+}
+
+printf "\namd_rpp per node overhead with a chain of %s nodes, batch size %s (%s frames)\n\n" "$NODES" "$BATCH" "$FRAMES"
+printf "| %-10s | %12s | %12s |\n" "Image" "ms/batch" "us/node"
+printf "|%s|%s|%s|\n" "------------" "--------------" "--------------"
+for SIZE in $IMAGE_SIZE_LIST;
+do
+    W=${SIZE%x*}
+    H=${SIZE#*x}
+    GDF="$GENERATED_GDF_PATH/Brightness_${SIZE}.gdf"
+    write_gdf "$W" "$H" "$GDF"
+    AVG_MS=$("$RUNVX_PATH"runvx -frames:"$FRAMES" -affinity:CPU "$GDF" | grep "csv,OVERALL" | cut -d, -f6 | tr -d ' ')
+    US_PER_NODE=$(awk -v t="$AVG_MS" -v n="$NODES" 'BEGIN { if (t != "") printf "%.2f", t * 1000 / n; else print "n/a" }')
+    printf "| %-10s | %12s | %12s |\n" "$SIZE" "$AVG_MS" "$US_PER_NODE"
+done
+
+############# Need not edit - Main script #############
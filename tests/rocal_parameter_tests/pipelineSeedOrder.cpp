@@ -0,0 +1,132 @@
+/*
+Copyright (c) 2015 - 2022 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+
+// Builds two pipelines with the same seed in different orders, with the parameters of other pipelines created in between.
+// The augmentation parameters of the two pipelines must be identical for every batch and epoch, and differ between parameters and seeds.
+
+#include <stdio.h>
+#include <algorithm>
+#include <vector>
+#include "parameter_factory.h"
+#include "pipeline_random.h"
+
+#define BATCH_SIZE      8
+#define NUM_BATCHES     4
+#define NUM_EPOCHS      2
+
+// the parameters of the nodes of a pipeline, they get their ids in node order when the pipeline is built
+struct Pipeline
+{
+    explicit Pipeline(unsigned seed) : random(seed) {}
+    void create_params()
+    {
+        const float values[] = { 0.5f, 1.0f, 1.5f };
+        const double frequencies[] = { 1.0, 2.0, 1.0 };
+        params.push_back(ParameterFactory::instance()->create_uniform_float_rand_param(0.1f, 1.9f)->core);
+        params.push_back(ParameterFactory::instance()->create_custom_float_rand_param(values, frequencies, 3)->core);
+        params.push_back(ParameterFactory::instance()->create_uniform_float_rand_param(-20.0f, 20.0f)->core);
+    }
+    void build()
+    {
+        for (size_t i = 0; i < params.size(); i++)
+            ids.push_back(random.create_param_id());
+    }
+    std::vector<float> run()
+    {
+        std::vector<float> values;
+        for (int epoch = 0; epoch < NUM_EPOCHS; epoch++) {
+            for (int b = 0; b < NUM_BATCHES; b++) {
+                random.new_batch();
+                for (size_t i = 0; i < params.size(); i++) {
+                    float batch[BATCH_SIZE];
+                    params[i]->generate(batch, BATCH_SIZE, random.batch(ids[i], BATCH_SIZE));
+                    values.insert(values.end(), batch, batch + BATCH_SIZE);
+                }
+            }
+            random.new_epoch();
+        }
+        return values;
+    }
+    PipelineRandom random;
+    std::vector<Parameter<float>*> params;
+    std::vector<uint32_t> ids;
+};
+
+int main(int argc, char * argv[])
+{
+    const unsigned seed = 42;
+
+    // first order: pipeline A, then pipeline B
+    Pipeline a1(seed), b1(seed + 1);
+    a1.create_params();
+    a1.build();
+    b1.create_params();
+    b1.build();
+
+    // second order: an unrelated pipeline, then B and A with interleaved parameter creation, B built first
+    Pipeline other(seed), b2(seed + 1), a2(seed);
+    other.create_params();
+    other.build();
+    b2.create_params();
+    a2.create_params();
+    b2.build();
+    a2.build();
+
+    // the parameters drawn before must not change the values of the other pipelines
+    other.run();
+    std::vector<float> va1 = a1.run(), vb1 = b1.run(), va2 = a2.run(), vb2 = b2.run();
+    if (va1 != va2 || vb1 != vb2) {
+        printf("ERROR: pipelines with the same seed got different parameters when created in a different order\n");
+        return -1;
+    }
+    if (va1 == vb1) {
+        printf("ERROR: pipelines with different seeds got the same parameters\n");
+        return -1;
+    }
+    // the parameters of a pipeline don't repeat between batches, epochs or parameters
+    const size_t batch_values = BATCH_SIZE * a1.params.size();
+    for (size_t b = 1; b < NUM_EPOCHS * NUM_BATCHES; b++) {
+        if (std::equal(va1.begin(), va1.begin() + BATCH_SIZE, va1.begin() + b * batch_values)) {
+            printf("ERROR: batch %d repeats the parameters of the first batch\n", (int)b);
+            return -1;
+        }
+    }
+    if (std::equal(va1.begin(), va1.begin() + BATCH_SIZE, va1.begin() + 2 * BATCH_SIZE)) {
+        printf("ERROR: two parameters of a pipeline got the same values\n");
+        return -1;
+    }
+    // the values stay in the ranges of the parameters
+    for (size_t i = 0; i < va1.size(); i++) {
+        float v = va1[i];
+        size_t param = (i / BATCH_SIZE) % a1.params.size();
+        bool valid = (param == 0) ? (v >= 0.1f && v <= 1.9f) :
+                     (param == 1) ? (v == 0.5f || v == 1.0f || v == 1.5f) : (v >= -20.0f && v <= 20.0f);
+        if (!valid) {
+            printf("ERROR: value %g of parameter %d is out of its range\n", v, (int)param);
+            return -1;
+        }
+    }
+
+    printf("OK: %d epochs of %d batches: identical parameters for identically seeded pipelines in any creation order\n", NUM_EPOCHS, NUM_BATCHES);
+    return 0;
+}
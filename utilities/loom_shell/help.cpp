@@ -93,6 +93,7 @@ void CLoomShellParser::help(bool detailed)
 	Message("    ~ OpenCL buffers\n");
 	Message("        cl_mem buf[count];\n");
 	Message("        createBuffer(opencl_context,size,&buf[#]);\n");
+	Message("        createHostBuffer(size,&buf[#]);   // CPU stitch (attribute 58) or OpenVX without OpenCL\n");
 	Message("        releaseBuffer(&buf[#]);\n");
 	Message("    ~ load/save OpenCL buffers\n");
 	Message("        saveBufferToImage(buf[#],\"image.bmp\",format,width,height,stride);\n");
@@ -289,11 +289,10 @@ int CLoomShellParser::ReleaseAllResources()
 	if (ClearCmdqCache())
 		Terminate(1, "ERROR: ClearCmdqCache() failed\n");
 	if (opencl_buf_mem_) {
-		for (vx_uint32 i = 0; i < num_opencl_context_; i++) {
+		for (vx_uint32 i = 0; i < num_opencl_buf_; i++) {
 			if (opencl_buf_mem_[i]) {
-				cl_int status = clReleaseMemObject(opencl_buf_mem_[i]);
-				if (status < 0) Terminate(1, "ERROR: clReleaseMemObject(%s[%d]) failed (%d)\n", name_buf, i, status);
-				opencl_buf_mem_[i] = nullptr;
+				vx_status status = releaseBuffer(&opencl_buf_mem_[i]);
+				if (status < 0) Terminate(1, "ERROR: releaseBuffer(%s[%d]) failed (%d)\n", name_buf, i, status);
 				Message("..released %s[%d]\n", name_buf, i);
 			}
 		}
@@ -325,8 +324,8 @@ int CLoomShellParser::ReleaseAllResources()
 		for (vx_uint32 i = 0; i < num_opencl_context_; i++) {
 			if (opencl_context_[i]) {
 				if (opencl_context_allocated_[i]) {
-					cl_int status = clReleaseContext(opencl_context_[i]);
-					if (status < 0) Terminate(1, "ERROR: clReleaseContext(%s[%d]) failed (%d)\n", name_cl, i, status);
+					vx_status status = releaseOpenCLContext(&opencl_context_[i]);
+					if (status < 0) Terminate(1, "ERROR: releaseOpenCLContext(%s[%d]) failed (%d)\n", name_cl, i, status);
 					Message("..released %s[%d]\n", name_cl, i);
 				}
 				opencl_context_[i] = nullptr;
@@ -1251,7 +1250,7 @@ int CLoomShellParser::OnCommand()
 		if (vxIndex >= num_openvx_context_) return Error("ERROR: OpenVX context out-of-range: expects: 0..%d", num_openvx_context_ - 1);
 		if (openvx_context_[vxIndex] && openvx_context_allocated_[vxIndex]) return Error("ERROR: OpenVX context %s[%d] already created", name_vx, vxIndex);
 		// process the command
-		cl_int status = createOpenVXContext(&openvx_context_[vxIndex]);
+		vx_status status = createOpenVXContext(&openvx_context_[vxIndex]);
 		if (status) return status;
 		openvx_context_allocated_[vxIndex] = true;
 	}
@@ -1267,7 +1266,7 @@ int CLoomShellParser::OnCommand()
 		if (!openvx_context_[vxIndex]) return Error("ERROR: OpenVX context %s[%d] doesn't exist", name_vx, vxIndex);
 		if (!openvx_context_allocated_[vxIndex]) return Error("ERROR: attempted to release OpenVX context not created here", name_vx, vxIndex);
 		// process the command
-		cl_int status = releaseOpenVXContext(&openvx_context_[vxIndex]);
+		vx_status status = releaseOpenVXContext(&openvx_context_[vxIndex]);
 		if (status) return status;
 		openvx_context_allocated_[vxIndex] = false;
 	}
@@ -1287,7 +1286,7 @@ int CLoomShellParser::OnCommand()
 		if (clIndex >= num_opencl_context_) return Error("ERROR: OpenCL context out-of-range: expects: 0..%d", num_opencl_context_ - 1);
 		if (opencl_context_[clIndex] && opencl_context_allocated_[clIndex]) return Error("ERROR: OpenCL context %s[%d] already created", name_cl, clIndex);
 		// process the command
-		cl_int status = createOpenCLContext(platform, device, &opencl_context_[clIndex]);
+		vx_status status = createOpenCLContext(platform, device, &opencl_context_[clIndex]);
 		if (status) return status;
 		opencl_context_allocated_[clIndex] = true;
 	}
@@ -1303,7 +1302,7 @@ int CLoomShellParser::OnCommand()
 		if (!opencl_context_[clIndex]) return Error("ERROR: OpenCL context %s[%d] doesn't exist", name_cl, clIndex);
 		if (!opencl_context_allocated_[clIndex]) return Error("ERROR: attempted to release OpenCL context not created here", name_cl, clIndex);
 		// process the command
-		cl_int status = releaseOpenCLContext(&opencl_context_[clIndex]);
+		vx_status status = releaseOpenCLContext(&opencl_context_[clIndex]);
 		if (status) return status;
 		opencl_context_allocated_[clIndex] = false;
 	}
@@ -1324,17 +1323,35 @@ int CLoomShellParser::OnCommand()
 		if (bufIndex >= num_opencl_buf_) return Error("ERROR: OpenCL buffer out-of-range: expects: 0..%d", num_opencl_buf_ - 1);
 		if (opencl_buf_mem_[bufIndex]) return Error("ERROR: OpenCL buffer %s[%d] already exists", name_buf, bufIndex);
 		// process the command
-		cl_int status = createBuffer(opencl_context_[clIndex], bufSize, &opencl_buf_mem_[bufIndex]);
+		vx_status status = createBuffer(opencl_context_[clIndex], bufSize, &opencl_buf_mem_[bufIndex]);
 		if (status) return status;
 		// initialize buffer
 		char textBuffer[1024];
-		cl_int LS_INITIALIZE_CLMEM = 0;
-		if (GetEnvVariable("LS_INITIALIZE_CLMEM", textBuffer, sizeof(textBuffer))){ LS_INITIALIZE_CLMEM = (cl_int)atoi(textBuffer); }
+		vx_int32 LS_INITIALIZE_CLMEM = 0;
+		if (GetEnvVariable("LS_INITIALIZE_CLMEM", textBuffer, sizeof(textBuffer))){ LS_INITIALIZE_CLMEM = (vx_int32)atoi(textBuffer); }
 		if (LS_INITIALIZE_CLMEM >= 0){
 			status = initializeBuffer(opencl_buf_mem_[bufIndex], bufSize, LS_INITIALIZE_CLMEM);
 			if (status) return status;
 		}
 	}
+	else if (!_stricmp(command, "createHostBuffer")) {
+		// parse the command
+		vx_uint32 bufIndex = 0, bufSize = 0;
+		const char * invalidSyntax = "ERROR: invalid syntax: expects: createHostBuffer(<size-in-bytes>,&buf[#])";
+		SYNTAX_CHECK(ParseSkip(s, "("));
+		SYNTAX_CHECK(ParseUInt(s, bufSize));
+		SYNTAX_CHECK(ParseSkip(s, ",&"));
+		SYNTAX_CHECK(ParseIndex(s, name_buf, bufIndex, num_opencl_buf_));
+		SYNTAX_CHECK(ParseSkip(s, ")"));
+		SYNTAX_CHECK(ParseEndOfLine(s));
+		if (bufIndex >= num_opencl_buf_) return Error("ERROR: buffer out-of-range: expects: 0..%d", num_opencl_buf_ - 1);
+		if (opencl_buf_mem_[bufIndex]) return Error("ERROR: buffer %s[%d] already exists", name_buf, bufIndex);
+		// process the command
+		vx_status status = createHostBuffer(bufSize, &opencl_buf_mem_[bufIndex]);
+		if (status) return status;
+		status = initializeBuffer(opencl_buf_mem_[bufIndex], bufSize, 0);
+		if (status) return status;
+	}
 	else if (!_stricmp(command, "releaseBuffer")) {
 		// parse the command
 		vx_uint32 bufIndex = 0;
@@ -1346,7 +1363,7 @@ int CLoomShellParser::OnCommand()
 		if (bufIndex >= num_opencl_buf_) return Error("ERROR: OpenCL buffer out-of-range: expects: 0..%d", num_opencl_buf_ - 1);
 		if (!opencl_buf_mem_[bufIndex]) return Error("ERROR: OpenCL buffer %s[%d] doesn't exist", name_buf, bufIndex);
 		// process the command
-		cl_int status = releaseBuffer(&opencl_buf_mem_[bufIndex]);
+		vx_status status = releaseBuffer(&opencl_buf_mem_[bufIndex]);
 		if (status) return status;
 	}
 	else if (!_stricmp(command, "loadBufferFromImage") || !_stricmp(command, "saveBufferToImage")) {
@@ -27,11 +27,13 @@ THE SOFTWARE.
 #include <map>
 
 #include "live_stitch_api.h"
+#if ENABLE_OPENCL
 #if __APPLE__
 #include <cl_ext.h>
 #else
 #include <CL/cl_ext.h>
 #endif
+#endif
 
 #define VERSION          "0.9.9"
 #define SCRIPT_EXTENSION ".lss"
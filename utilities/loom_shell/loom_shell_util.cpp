@@ -24,11 +24,13 @@ THE SOFTWARE.
 #define _CRT_SECURE_NO_WARNINGS
 #endif
 #include "loom_shell_util.h"
+#if ENABLE_OPENCL
 #if __APPLE__
 #include <cl_ext.h>
 #else
 #include <CL/cl_ext.h>
 #endif
+#endif
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdarg.h>
@@ -47,10 +49,14 @@ THE SOFTWARE.
 #define _stricmp  strcasecmp
 #endif
 
+#if ENABLE_OPENCL
 // local cache for OpenCL buffer management
 static std::map<cl_context, cl_command_queue> globalClCtx2CmdqMap;
 static std::map<cl_mem, cl_command_queue> globalClMem2CmdqMap;
 static std::map<cl_mem, vx_uint32> globalClMem2SizeMap;
+#endif
+// host buffers created by createHostBuffer: accessed directly without a command queue
+static std::map<cl_mem, vx_uint32> globalHostMem2SizeMap;
 
 //! \brief The macro for fread error checking and reporting.
 #define ERROR_CHECK_FREAD_(call,value) {size_t retVal = (call); if(retVal != (size_t)value) { Error("ERROR: fread call expected to return [ %d elements ] but returned [ %d elements ] at " __FILE__ "#%d\n", (int)value, (int)retVal, __LINE__); }  }
@@ -113,6 +119,7 @@ static int Error(const char * format, ...)
 	return -1;
 }
 
+#if ENABLE_OPENCL
 static cl_command_queue GetCmdqCached(cl_mem mem)
 {
 	cl_command_queue cmdq = nullptr;
@@ -154,15 +161,6 @@ static cl_command_queue GetCmdqCached(cl_mem mem)
 	return cmdq;
 }
 
-vx_status initializeBuffer(cl_mem mem, vx_uint32 size, cl_int pattern)
-{
-	cl_command_queue cmdq = GetCmdqCached(mem); if (!cmdq) return -1;
-	cl_int status = clEnqueueFillBuffer(cmdq, mem, &pattern, sizeof(cl_int), 0, size, 0, NULL, NULL);
-	if (status) return status;
-
-	return VX_SUCCESS;
-}
-
 static vx_status ReleaseCmdqCached(cl_context opencl_context)
 {
 	if (globalClCtx2CmdqMap.find(opencl_context) != globalClCtx2CmdqMap.end()) {
@@ -211,9 +209,60 @@ static vx_status ReleaseCmdqCached(cl_mem mem)
 	}
 	return VX_SUCCESS;
 }
+#endif
+
+static unsigned char * MapBuffer(cl_mem mem, bool write, vx_uint32& size)
+{
+	if (globalHostMem2SizeMap.find(mem) != globalHostMem2SizeMap.end()) {
+		size = globalHostMem2SizeMap[mem];
+		return (unsigned char *)mem;
+	}
+#if ENABLE_OPENCL
+	cl_command_queue cmdq = GetCmdqCached(mem); if (!cmdq) return nullptr;
+	size = globalClMem2SizeMap[mem];
+	cl_int err;
+	unsigned char * img = (unsigned char *)clEnqueueMapBuffer(cmdq, mem, CL_TRUE, write ? CL_MAP_WRITE : CL_MAP_READ, 0, size, 0, NULL, NULL, &err);
+	if (err) { Error("ERROR: clEnqueueMapBuffer() failed (%d)", err); return nullptr; }
+	err = clFinish(cmdq); if (err) { Error("ERROR: clFinish() failed (%d)", err); return nullptr; }
+	return img;
+#else
+	Error("ERROR: not a host buffer: OpenVX is built without OpenCL");
+	return nullptr;
+#endif
+}
+
+static vx_status UnmapBuffer(cl_mem mem, unsigned char * img)
+{
+	if (globalHostMem2SizeMap.find(mem) != globalHostMem2SizeMap.end())
+		return VX_SUCCESS;
+#if ENABLE_OPENCL
+	cl_command_queue cmdq = GetCmdqCached(mem); if (!cmdq) return -1;
+	cl_int err = clEnqueueUnmapMemObject(cmdq, mem, img, 0, NULL, NULL);
+	if (err) return Error("ERROR: clEnqueueUnmapMemObject failed (%d)", err);
+	err = clFinish(cmdq); if (err) return Error("ERROR: clFinish() failed (%d)", err);
+#endif
+	return VX_SUCCESS;
+}
+
+vx_status initializeBuffer(cl_mem mem, vx_uint32 size, vx_int32 pattern)
+{
+	if (globalHostMem2SizeMap.find(mem) != globalHostMem2SizeMap.end()) {
+		vx_int32 * buf = (vx_int32 *)mem;
+		for (vx_uint32 i = 0; i < size / sizeof(vx_int32); i++)
+			buf[i] = pattern;
+		return VX_SUCCESS;
+	}
+#if ENABLE_OPENCL
+	cl_command_queue cmdq = GetCmdqCached(mem); if (!cmdq) return -1;
+	cl_int status = clEnqueueFillBuffer(cmdq, mem, &pattern, sizeof(cl_int), 0, size, 0, NULL, NULL);
+	if (status) return status;
+#endif
+	return VX_SUCCESS;
+}
 
 vx_status ClearCmdqCache()
 {
+#if ENABLE_OPENCL
 	for (auto it = globalClCtx2CmdqMap.begin(); it != globalClCtx2CmdqMap.end(); it++) {
 		// release command queue
 		cl_int err = clReleaseCommandQueue(it->second);
@@ -223,6 +272,7 @@ vx_status ClearCmdqCache()
 	globalClCtx2CmdqMap.clear();
 	globalClMem2CmdqMap.clear();
 	globalClMem2SizeMap.clear();
+#endif
 	return VX_SUCCESS;
 }
 
@@ -262,6 +312,7 @@ vx_status run(ls_context context, vx_uint32 frameCount)
 	}
 	else if (msec_count > 0) {
 		Message("OK: run: Time: %7.3lf ms (min); %7.3lf ms (avg); %7.3lf ms (max); %7.3lf ms (1st-frame) of %d frames\n", msec_min, msec_sum / msec_count, msec_max, msec_first, count);
+		Message("OK: run: Rate: %7.3lf frames/sec (excluding 1st-frame)\n", 1000.0 * msec_count / msec_sum);
 	}
 	return VX_SUCCESS;
 }
@@ -312,6 +363,7 @@ vx_status runParallel(ls_context * context, vx_uint32 contextCount, vx_uint32 fr
 	}
 	else if (msec_count > 0) {
 		Message("OK: runParallel: Time: %7.3lf ms (min); %7.3lf ms (avg); %7.3lf ms (max); %7.3lf ms (1st-frame) of %d frames\n", msec_min, msec_sum / msec_count, msec_max, msec_first, count);
+		Message("OK: runParallel: Rate: %7.3lf frames/sec (excluding 1st-frame)\n", 1000.0 * msec_count / msec_sum);
 	}
 	return VX_SUCCESS;
 }
@@ -469,25 +521,50 @@ vx_status showConfiguration(ls_context context, const char * exportType)
 
 vx_status createBuffer(cl_context opencl_context, vx_uint32 size, cl_mem * mem)
 {
+#if ENABLE_OPENCL
 	cl_int err;
 	*mem = clCreateBuffer(opencl_context, CL_MEM_READ_WRITE, size, NULL, &err);
 	if (!*mem) return Error("ERROR: clCreateBuffer(...,%d,...): failed (%d)", size, err);
 	globalClMem2SizeMap[*mem] = size;
 	return VX_SUCCESS;
+#else
+	return Error("ERROR: createBuffer: OpenVX is built without OpenCL: use createHostBuffer");
+#endif
+}
+
+vx_status createHostBuffer(vx_uint32 size, cl_mem * mem)
+{
+	*mem = (cl_mem)malloc(size);
+	if (!*mem) return Error("ERROR: createHostBuffer(%d,...): failed", size);
+	globalHostMem2SizeMap[*mem] = size;
+	return VX_SUCCESS;
 }
 
 vx_status releaseBuffer(cl_mem * mem)
 {
+	if (globalHostMem2SizeMap.find(*mem) != globalHostMem2SizeMap.end()) {
+		globalHostMem2SizeMap.erase(*mem);
+		free(*mem);
+		*mem = nullptr;
+		return VX_SUCCESS;
+	}
+#if ENABLE_OPENCL
 	if (ReleaseCmdqCached(*mem) != VX_SUCCESS) return -1;
 	cl_int status = clReleaseMemObject(*mem);
 	if (status) return Error("ERROR: clReleaseMemObject() failed (%d)", status);
 	globalClMem2SizeMap.erase(*mem);
 	*mem = nullptr;
 	return VX_SUCCESS;
+#else
+	return Error("ERROR: releaseBuffer: unknown buffer");
+#endif
 }
 
 vx_status createOpenCLContext(const char * platform, const char * device, cl_context * opencl_context)
 {
+#if !ENABLE_OPENCL
+	return Error("ERROR: createOpenCLContext: OpenVX is built without OpenCL");
+#else
 	// get OpenCL platform ID
 	cl_platform_id platform_id[16]; cl_uint num_platform_id = 0;
 	cl_int err = clGetPlatformIDs(16, platform_id, &num_platform_id);
@@ -561,13 +638,16 @@ vx_status createOpenCLContext(const char * platform, const char * device, cl_con
 	*opencl_context = clCreateContext(ctx_properties, 1, &device_id[device_index], NULL, NULL, &err);
 	if (!*opencl_context) return Error("ERROR: clCreateContext() failed (%d)", err);
 	return VX_SUCCESS;
+#endif
 }
 
 vx_status releaseOpenCLContext(cl_context * opencl_context)
 {
+#if ENABLE_OPENCL
 	if (ReleaseCmdqCached(*opencl_context) != VX_SUCCESS) return -1;
 	cl_int status = clReleaseContext(*opencl_context);
 	if (status) return Error("ERROR: clReleaseContext() failed (%d)", status);
+#endif
 	*opencl_context = nullptr;
 	return VX_SUCCESS;
 }
@@ -703,12 +783,8 @@ vx_status loadBufferFromMultipleImages(cl_mem mem, const char * fileName, vx_uin
 	if ((buffer_format != VX_DF_IMAGE_RGB && buffer_format != VX_DF_IMAGE_RGBX) || !!_stricmp(fileNameExt, ".bmp")) {
 		return Error("ERROR: loadBufferFromImage/loadBufferFromMultipleImages: supports only RGB images and BMP files");
 	}
-	cl_command_queue cmdq = GetCmdqCached(mem); if (!cmdq) return -1;
-	vx_uint32 size = globalClMem2SizeMap[mem];
-	cl_int err;
-	unsigned char * img = (unsigned char *)clEnqueueMapBuffer(cmdq, mem, CL_TRUE, CL_MAP_WRITE, 0, size, 0, NULL, NULL, &err);
-	if (err) return Error("ERROR: clEnqueueMapBuffer() failed (%d)", err);
-	err = clFinish(cmdq); if (err) return Error("ERROR: clFinish() failed (%d)", err);
+	vx_uint32 size = 0;
+	unsigned char * img = MapBuffer(mem, true, size); if (!img) return -1;
 	if (stride_in_bytes == 0) {
 		if (buffer_format == VX_DF_IMAGE_RGBX) stride_in_bytes = buffer_width * 4;
 		else stride_in_bytes = buffer_width * 3;
@@ -792,9 +868,7 @@ vx_status loadBufferFromMultipleImages(cl_mem mem, const char * fileName, vx_uin
 		}
 	}
 	if(buf) delete[] buf;
-	err = clEnqueueUnmapMemObject(cmdq, mem, img, 0, NULL, NULL);
-	if (err) return Error("ERROR: clEnqueueUnmapMemObject failed (%d)", err);
-	err = clFinish(cmdq); if (err) return Error("ERROR: clFinish() failed (%d)", err);
+	if (UnmapBuffer(mem, img) != VX_SUCCESS) return -1;
 	return VX_SUCCESS;
 }
 
@@ -804,12 +878,8 @@ vx_status saveBufferToMultipleImages(cl_mem mem, const char * fileName, vx_uint3
 	if ((buffer_format != VX_DF_IMAGE_RGB && buffer_format != VX_DF_IMAGE_RGBX && buffer_format != VX_DF_IMAGE_UYVY && buffer_format != VX_DF_IMAGE_YUYV) || !!_stricmp(fileNameExt, ".bmp")) {
 		return Error("ERROR: saveBufferToImage/saveBufferToMultipleImages: supports only RGB images and BMP files");
 	}
-	cl_command_queue cmdq = GetCmdqCached(mem); if (!cmdq) return -1;
-	vx_uint32 size = globalClMem2SizeMap[mem];
-	cl_int err;
-	unsigned char * img = (unsigned char *)clEnqueueMapBuffer(cmdq, mem, CL_TRUE, CL_MAP_READ, 0, size, 0, NULL, NULL, &err);
-	if (err) return Error("ERROR: clEnqueueMapBuffer() failed (%d)", err);
-	err = clFinish(cmdq); if (err) return Error("ERROR: clFinish() failed (%d)", err);
+	vx_uint32 size = 0;
+	unsigned char * img = MapBuffer(mem, false, size); if (!img) return -1;
 	if (stride_in_bytes == 0) {
 		if (buffer_format == VX_DF_IMAGE_RGBX) stride_in_bytes = buffer_width * 4;
 		else if (buffer_format == VX_DF_IMAGE_UYVY || buffer_format == VX_DF_IMAGE_YUYV) stride_in_bytes = buffer_width * 2;
@@ -928,27 +998,19 @@ vx_status saveBufferToMultipleImages(cl_mem mem, const char * fileName, vx_uint3
 		}
 		delete[] buf;
 	}
-	err = clEnqueueUnmapMemObject(cmdq, mem, img, 0, NULL, NULL);
-	if (err) return Error("ERROR: clEnqueueUnmapMemObject failed (%d)", err);
-	err = clFinish(cmdq); if (err) return Error("ERROR: clFinish() failed (%d)", err);
+	if (UnmapBuffer(mem, img) != VX_SUCCESS) return -1;
 	return VX_SUCCESS;
 }
 
 vx_status loadBuffer(cl_mem mem, const char * fileName, vx_uint32 offset)
 {
-	cl_command_queue cmdq = GetCmdqCached(mem); if (!cmdq) return -1;
-	vx_uint32 size = globalClMem2SizeMap[mem];
-	cl_int err;
-	unsigned char * img = (unsigned char *)clEnqueueMapBuffer(cmdq, mem, CL_TRUE, CL_MAP_WRITE, 0, size, 0, NULL, NULL, &err);
-	if (err) return Error("ERROR: clEnqueueMapBuffer() failed (%d)", err);
-	err = clFinish(cmdq); if (err) return Error("ERROR: clFinish() failed (%d)", err);
+	vx_uint32 size = 0;
+	unsigned char * img = MapBuffer(mem, true, size); if (!img) return -1;
 	FILE * fp = fopen(fileName, "rb"); if (!fp) return Error("ERROR: unable to open: %s", fileName);
 	fseek(fp, offset, SEEK_SET);
 	ERROR_CHECK_FREAD_(fread(img, 1, size, fp), size);
 	fclose(fp);
-	err = clEnqueueUnmapMemObject(cmdq, mem, img, 0, NULL, NULL);
-	if (err) return Error("ERROR: clEnqueueUnmapMemObject failed (%d)", err);
-	err = clFinish(cmdq); if (err) return Error("ERROR: clFinish() failed (%d)", err);
+	if (UnmapBuffer(mem, img) != VX_SUCCESS) return -1;
 	Message("OK: loaded %d bytes from %s\n", size, fileName);
 	return VX_SUCCESS;
 }
@@ -963,18 +1025,12 @@ vx_status saveBuffer(cl_mem mem, const char * fileName, vx_uint32 flags)
 		fileName++;
 		append = true;
 	}
-	cl_command_queue cmdq = GetCmdqCached(mem); if (!cmdq) return -1;
-	vx_uint32 size = globalClMem2SizeMap[mem];
-	cl_int err;
-	unsigned char * img = (unsigned char *)clEnqueueMapBuffer(cmdq, mem, CL_TRUE, CL_MAP_READ, 0, size, 0, NULL, NULL, &err);
-	if (err) return Error("ERROR: clEnqueueMapBuffer() failed (%d)", err);
-	err = clFinish(cmdq); if (err) return Error("ERROR: clFinish() failed (%d)", err);
+	vx_uint32 size = 0;
+	unsigned char * img = MapBuffer(mem, false, size); if (!img) return -1;
 	FILE * fp = fopen(fileName, append ? "ab" : "wb"); if (!fp) return Error("ERROR: unable to %s: %s", append ? "append" : "create", fileName);
 	fwrite(img, 1, size, fp);
 	fclose(fp);
-	err = clEnqueueUnmapMemObject(cmdq, mem, img, 0, NULL, NULL);
-	if (err) return Error("ERROR: clEnqueueUnmapMemObject failed (%d)", err);
-	err = clFinish(cmdq); if (err) return Error("ERROR: clFinish() failed (%d)", err);
+	if (UnmapBuffer(mem, img) != VX_SUCCESS) return -1;
 	Message("OK: saved %d bytes into %s\n", size, fileName);
 	return VX_SUCCESS;
 }
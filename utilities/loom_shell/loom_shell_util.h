@@ -44,6 +44,7 @@ vx_status showAttributes(ls_context context, vx_uint32 offset, vx_uint32 count);
 vx_status showGlobalAttributes(vx_uint32 offset, vx_uint32 count);
 
 vx_status createBuffer(cl_context opencl_context, vx_uint32 size, cl_mem * mem);
+vx_status createHostBuffer(vx_uint32 size, cl_mem * mem);
 vx_status releaseBuffer(cl_mem * mem);
 vx_status createOpenCLContext(const char * platform, const char * device, cl_context * opencl_context);
 vx_status releaseOpenCLContext(cl_context * opencl_context);
@@ -69,7 +70,7 @@ vx_status loadExpCompGains(ls_context stitch, size_t num_entries, const char * f
 vx_status saveExpCompGains(ls_context stitch, size_t num_entries, const char * fileName);
 
 vx_status loadBlendWeights(ls_context stitch, const char * fileName);
-vx_status initializeBuffer(cl_mem mem, vx_uint32 size, cl_int pattern);
+vx_status initializeBuffer(cl_mem mem, vx_uint32 size, vx_int32 pattern);
 
 vx_status ClearCmdqCache();
 int64_t GetClockFrequency();
@@ -34,6 +34,7 @@ THE SOFTWARE.
 #include "rali_api.h"
 #define TEST_2
 using namespace cv;
+using namespace std::chrono;
 
 int main(int argc, const char ** argv)
 {
@@ -142,6 +143,7 @@ int main(int argc, const char ** argv)
     std::vector<int> labels;
     names.resize(inputBatchSize);
     labels.resize(inputBatchSize);
+    long long reset_latency = -1;
 
     while( ++test_id < total_tests)
     {
@@ -162,8 +164,15 @@ int main(int argc, const char ** argv)
 
         while((test_case == 0) ? !raliIsEmpty(handle) : (counter < run_len[test_id]))
         {
+            auto run_start = high_resolution_clock::now();
             if (raliRun(handle) != 0)
                 break;
+            if (reset_latency >= 0) {
+                // latency added by the reset: the raliResetLoaders() call plus the wait for the first batch of the new epoch
+                auto first_batch_latency = duration_cast<microseconds>(high_resolution_clock::now() - run_start).count();
+                std::cout << ">>>>> Reset " << reset_latency << " us, first batch after reset " << first_batch_latency << " us" << std::endl;
+                reset_latency = -1;
+            }
 
             raliCopyToOutput(handle, mat_input.data, h * w * p);
 
@@ -193,7 +202,9 @@ int main(int argc, const char ** argv)
         std::cout << ">>>>> Done test id " << test_id << " processed " << counter << " images ,press a key \n";
         cv::waitKey(0);
         std::cout << "#### Going to reset\n";
+        auto reset_start = high_resolution_clock::now();
         raliResetLoaders(handle);
+        reset_latency = duration_cast<microseconds>(high_resolution_clock::now() - reset_start).count();
         mat_input.release();
         mat_output.release();
         mat_color.release();
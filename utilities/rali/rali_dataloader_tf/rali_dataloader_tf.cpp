@@ -39,56 +39,9 @@ using namespace cv;
 using namespace std::chrono;
 
 
-int main(int argc, const char ** argv)
+static int run_pipeline(const char * folderPath1, const char * record_prefix, bool processing_device, int decode_width, int decode_height,
+                        int inputBatchSize, RaliImageColor color_format, bool display, bool shuffle, double &images_per_sec)
 {
-    // check command-line usage
-    const int MIN_ARG_COUNT = 2;
-    if(argc < MIN_ARG_COUNT) {
-        printf( "Usage: rali_dataloader_tf <Folder> <TFrecod_prefix> <processing_device=1/cpu=0>  <decode_width> <decode_height> <batch_size> <gray_scale/rgb/rgbplanar> display_on_off shuffle\n" );
-        return -1;
-    }
-    int argIdx = 0;
-    const char * folderPath1 = argv[++argIdx];
-    const char * record_prefix = argv[++argIdx];
-    bool display = 0;// Display the images
-    //int aug_depth = 1;// how deep is the augmentation tree
-    int rgb = 0;// process gray images
-    int decode_width = 28;          // mnist data_set
-    int decode_height = 28;
-    int inputBatchSize = 16;
-    bool processing_device = 1;
-    bool shuffle = 0;
-
-    if(argc >= argIdx+MIN_ARG_COUNT)
-        processing_device = atoi(argv[++argIdx]);
-
-    if(argc >= argIdx+MIN_ARG_COUNT)
-        decode_width = atoi(argv[++argIdx]);
-
-    if(argc >= argIdx+MIN_ARG_COUNT)
-        decode_height = atoi(argv[++argIdx]);
-
-    if(argc >= argIdx+MIN_ARG_COUNT)
-        inputBatchSize = atoi(argv[++argIdx]);
-
-    if(argc >= argIdx+MIN_ARG_COUNT)
-        rgb = atoi(argv[++argIdx]);
-
-    if(argc >= argIdx+MIN_ARG_COUNT)
-        display = atoi(argv[++argIdx]);
-
-    if(argc >= argIdx+MIN_ARG_COUNT)
-        shuffle = atoi(argv[++argIdx]);
-
-    std::cout << ">>> Running on " << (processing_device?"GPU":"CPU") << std::endl;
-    RaliImageColor color_format = RaliImageColor::RALI_COLOR_U8;
-    if (rgb == 0) 
-      color_format = RaliImageColor::RALI_COLOR_U8;
-    else if (rgb == 1)
-      color_format = RaliImageColor::RALI_COLOR_RGB24;
-    else if (rgb == 2)
-      color_format = RaliImageColor::RALI_COLOR_RGB_PLANAR;
-
     auto handle = raliCreate(inputBatchSize, processing_device?RaliProcessMode::RALI_PROCESS_GPU:RaliProcessMode::RALI_PROCESS_CPU, 0,1);
 
     if(raliGetStatus(handle) != RALI_OK)
@@ -285,8 +238,83 @@ int main(int argc, const char ** argv)
     std::cout << "Process  time "<< rali_timing.process_time << std::endl;
     std::cout << "Transfer time "<< rali_timing.transfer_time << std::endl;
     std::cout << ">>>>> "<< counter << " images/frames Processed. Total Elapsed Time " << dur/1000000 << " sec " << dur%1000000 << " us " << std::endl;
+    images_per_sec = (dur > 0) ? (counter * 1000000.0 / dur) : 0;
+    std::cout << ">>>>> Throughput " << images_per_sec << " images/sec" << std::endl;
     raliRelease(handle);
     mat_input.release();
     mat_output.release();
     return 0;
 }
+
+int main(int argc, const char ** argv)
+{
+    // check command-line usage
+    const int MIN_ARG_COUNT = 2;
+    if(argc < MIN_ARG_COUNT) {
+        printf( "Usage: rali_dataloader_tf <Folder> <TFrecod_prefix> <processing_device=1/cpu=0>  <decode_width> <decode_height> <batch_size> <gray_scale/rgb/rgbplanar> display_on_off shuffle compare_read_paths\n" );
+        return -1;
+    }
+    int argIdx = 0;
+    const char * folderPath1 = argv[++argIdx];
+    const char * record_prefix = argv[++argIdx];
+    bool display = 0;// Display the images
+    //int aug_depth = 1;// how deep is the augmentation tree
+    int rgb = 0;// process gray images
+    int decode_width = 28;          // mnist data_set
+    int decode_height = 28;
+    int inputBatchSize = 16;
+    bool processing_device = 1;
+    bool shuffle = 0;
+    bool compare_read_paths = 0;
+
+    if(argc >= argIdx+MIN_ARG_COUNT)
+        processing_device = atoi(argv[++argIdx]);
+
+    if(argc >= argIdx+MIN_ARG_COUNT)
+        decode_width = atoi(argv[++argIdx]);
+
+    if(argc >= argIdx+MIN_ARG_COUNT)
+        decode_height = atoi(argv[++argIdx]);
+
+    if(argc >= argIdx+MIN_ARG_COUNT)
+        inputBatchSize = atoi(argv[++argIdx]);
+
+    if(argc >= argIdx+MIN_ARG_COUNT)
+        rgb = atoi(argv[++argIdx]);
+
+    if(argc >= argIdx+MIN_ARG_COUNT)
+        display = atoi(argv[++argIdx]);
+
+    if(argc >= argIdx+MIN_ARG_COUNT)
+        shuffle = atoi(argv[++argIdx]);
+
+    if(argc >= argIdx+MIN_ARG_COUNT)
+        compare_read_paths = atoi(argv[++argIdx]);
+
+    std::cout << ">>> Running on " << (processing_device?"GPU":"CPU") << std::endl;
+    RaliImageColor color_format = RaliImageColor::RALI_COLOR_U8;
+    if (rgb == 0) 
+      color_format = RaliImageColor::RALI_COLOR_U8;
+    else if (rgb == 1)
+      color_format = RaliImageColor::RALI_COLOR_RGB24;
+    else if (rgb == 2)
+      color_format = RaliImageColor::RALI_COLOR_RGB_PLANAR;
+
+    if(compare_read_paths)
+    {
+        // time the previous TFRecord read path (ifstream and copy per record) and then the mapped one on the same shards
+        double stream_images_per_sec = 0, mapped_images_per_sec = 0;
+        setenv("RALI_TF_RECORD_STREAM_READ", "1", 1);
+        if(run_pipeline(folderPath1, record_prefix, processing_device, decode_width, decode_height, inputBatchSize, color_format, display, shuffle, stream_images_per_sec) != 0)
+            return -1;
+        unsetenv("RALI_TF_RECORD_STREAM_READ");
+        if(run_pipeline(folderPath1, record_prefix, processing_device, decode_width, decode_height, inputBatchSize, color_format, display, shuffle, mapped_images_per_sec) != 0)
+            return -1;
+        std::cout << ">>>>> Stream read throughput " << stream_images_per_sec << " images/sec" << std::endl;
+        std::cout << ">>>>> Mapped read throughput " << mapped_images_per_sec << " images/sec" << std::endl;
+        return 0;
+    }
+
+    double images_per_sec = 0;
+    return run_pipeline(folderPath1, record_prefix, processing_device, decode_width, decode_height, inputBatchSize, color_format, display, shuffle, images_per_sec);
+}
@@ -0,0 +1,152 @@
+/*
+MIT License
+
+Copyright (c) 2018 - 2022 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <vector>
+#include <string>
+#include <ftw.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "rali_api.h"
+
+using namespace std::chrono;
+
+// Files of the dataset, collected once by walking the folder
+static std::vector<std::string> dataset_files;
+
+static int collect_file(const char* path, const struct stat* sb, int type, struct FTW*)
+{
+    if (type == FTW_F && sb->st_size > 0)
+        dataset_files.push_back(path);
+    return 0;
+}
+
+// Drops the pages of the dataset from the page cache so that each run starts cold, without needing root to write to
+// /proc/sys/vm/drop_caches. Only clean pages are dropped, which is all a dataset read by rocAL has.
+static void evict_dataset()
+{
+    for (auto& path : dataset_files) {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            continue;
+        posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+        close(fd);
+    }
+}
+
+// Returns the number of bytes of the dataset resident in the page cache
+static size_t resident_bytes(size_t& total_bytes)
+{
+    const size_t page_size = sysconf(_SC_PAGESIZE);
+    size_t resident = 0;
+    total_bytes = 0;
+    std::vector<unsigned char> pages;
+    for (auto& path : dataset_files) {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0)
+            continue;
+        struct stat sb;
+        if (fstat(fd, &sb) == 0 && sb.st_size > 0) {
+            total_bytes += sb.st_size;
+            void* addr = mmap(nullptr, sb.st_size, PROT_READ, MAP_SHARED, fd, 0);
+            if (addr != MAP_FAILED) {
+                pages.resize((sb.st_size + page_size - 1) / page_size);
+                if (mincore(addr, sb.st_size, pages.data()) == 0)
+                    for (auto page : pages)
+                        resident += (page & 1) ? page_size : 0;
+                munmap(addr, sb.st_size);
+            }
+        }
+        close(fd);
+    }
+    return resident;
+}
+
+static int run_epoch(const char* path, int batch_size, int shards, unsigned readahead_count, RaliFileReadMode mode, const char* name)
+{
+    auto handle = raliCreate(batch_size, RALI_PROCESS_CPU, 0, 1);
+    if (raliGetStatus(handle) != RALI_OK) {
+        std::cout << "Could not create the Rali context\n";
+        return -1;
+    }
+    raliSetFileReadOptions(handle, readahead_count, mode);
+    raliJpegFileSource(handle, path, RALI_COLOR_RGB24, shards, true, true, false, RALI_USE_USER_GIVEN_SIZE, 224, 224);
+    if (raliGetStatus(handle) != RALI_OK) {
+        std::cout << "JPEG source could not initialize : " << raliGetErrorMessage(handle) << std::endl;
+        return -1;
+    }
+    // The loader starts reading as soon as it's created, evict the dataset right before the timed epoch
+    // (the first batches may have been read warm already, they are a small part of an epoch)
+    evict_dataset();
+    high_resolution_clock::time_point t1 = high_resolution_clock::now();
+    raliVerify(handle);
+    if (raliGetStatus(handle) != RALI_OK) {
+        std::cout << "Could not verify the augmentation graph " << raliGetErrorMessage(handle);
+        return -1;
+    }
+    int images = 0;
+    while (!raliIsEmpty(handle)) {
+        if (raliRun(handle) != 0)
+            break;
+        images += batch_size;
+    }
+    auto dur = duration_cast<microseconds>(high_resolution_clock::now() - t1).count();
+    auto timing = raliGetTimingInfo(handle);
+    size_t total_bytes;
+    size_t resident = resident_bytes(total_bytes);
+    printf("%-28s %8d images %10.1f images/sec  load time %10llu us  page cache footprint %8.1f MB of %8.1f MB\n",
+           name, images, images * 1e6 / dur, timing.load_time, resident / 1048576.0, total_bytes / 1048576.0);
+    raliRelease(handle);
+    return 0;
+}
+
+int main(int argc, const char** argv)
+{
+    if (argc < 2) {
+        printf("Usage: rali_file_reader_benchmark <image-dataset-folder> <batch_size=64> <readahead_count=16> <shard_count=4>\n");
+        return -1;
+    }
+    const char* path = argv[1];
+    int batch_size = argc > 2 ? atoi(argv[2]) : 64;
+    unsigned readahead_count = argc > 3 ? atoi(argv[3]) : 16;
+    int shards = argc > 4 ? atoi(argv[4]) : 4;
+
+    nftw(path, collect_file, 16, FTW_PHYS);
+    if (dataset_files.empty()) {
+        printf("No files found in %s\n", path);
+        return -1;
+    }
+
+    run_epoch(path, batch_size, shards, 0, RALI_FILE_READ_BUFFERED, "buffered");
+    run_epoch(path, batch_size, shards, readahead_count, RALI_FILE_READ_BUFFERED, "buffered + readahead");
+    run_epoch(path, batch_size, shards, readahead_count, RALI_FILE_READ_DROP_CACHE, "drop cache + readahead");
+    run_epoch(path, batch_size, shards, 0, RALI_FILE_READ_DIRECT, "direct");
+    return 0;
+}
@@ -40,12 +40,12 @@ using namespace cv;
 using namespace std::chrono;
 
 
-int test(int test_case, const char* path, int rgb, int processing_device, int width, int height, int batch_size, int shards, int shuffle);
+int test(int test_case, const char* path, int rgb, int processing_device, int width, int height, int batch_size, int shards, int shuffle, int fuse_pointwise, int cache_mb);
 int main(int argc, const char ** argv)
 {
     // check command-line usage
     const size_t MIN_ARG_COUNT = 2;
-    printf( "Usage: rali_performance_tests <image-dataset-folder> <width> <height> <test_case> <batch_size> <gpu=1/cpu=0> <rgb=1/grayscale=0> <shard_count>  <shuffle=1>\n" );
+    printf( "Usage: rali_performance_tests <image-dataset-folder> <width> <height> <test_case> <batch_size> <gpu=1/cpu=0> <rgb=1/grayscale=0> <shard_count>  <shuffle=1> <fuse_pointwise=1> <decoded_cache_mb=0>\n" );
     if(argc < MIN_ARG_COUNT)
         return -1;
 
@@ -60,6 +60,8 @@ int main(int argc, const char ** argv)
     int batch_size = 10;
     int shards = 4;
     int shuffle = 0;
+    int fuse_pointwise = 0;
+    int cache_mb = 0;
 
     if (argc >= argIdx + MIN_ARG_COUNT)
         test_case = atoi(argv[++argIdx]);
@@ -79,12 +81,18 @@ int main(int argc, const char ** argv)
     if (argc >= argIdx + MIN_ARG_COUNT)
 	shuffle = atoi(argv[++argIdx]);
 
-    test(test_case, path, rgb, processing_device, width, height, batch_size, shards, shuffle);
+    if (argc >= argIdx + MIN_ARG_COUNT)
+        fuse_pointwise = atoi(argv[++argIdx]);
+
+    if (argc >= argIdx + MIN_ARG_COUNT)
+        cache_mb = atoi(argv[++argIdx]);
+
+    test(test_case, path, rgb, processing_device, width, height, batch_size, shards, shuffle, fuse_pointwise, cache_mb);
 
     return 0;
 }
 
-int test(int test_case, const char* path, int rgb, int processing_device, int width, int height, int batch_size, int shards, int shuffle)
+int test(int test_case, const char* path, int rgb, int processing_device, int width, int height, int batch_size, int shards, int shuffle, int fuse_pointwise, int cache_mb)
 {
     size_t num_threads = shards;
     int inputBatchSize = batch_size;
@@ -120,6 +128,10 @@ int test(int test_case, const char* path, int rgb, int processing_device, int wi
 
 
     /*>>>>>>>>>>>>>>>>>>> Graph description <<<<<<<<<<<<<<<<<<<*/
+    // The decoded image cache is set up by the loader, it has to be enabled before the source is created
+    if (cache_mb > 0)
+        raliSetDecodedImageCache(handle, cache_mb);
+
     RaliImage image0;
     RaliImage image0_b;
 
@@ -293,11 +305,29 @@ int test(int test_case, const char* path, int rgb, int processing_device, int wi
             raliNop(handle, image0, true);
         }
             break;
+        case 29: {
+            // Run with fuse_pointwise 0 and 1 to compare the chain against its fused single pass version
+            std::cout << ">>>>>>> Running " << "Pointwise chain" << (fuse_pointwise ? " (fused)" : "") << std::endl;
+            RaliImage image = raliBrightness(handle, image0, false);
+            image = raliGamma(handle, image, false);
+            if (rgb)
+            {
+                image = raliExposure(handle, image, false);
+                image = raliHue(handle, image, false);
+                image = raliSaturation(handle, image, false);
+                raliColorTwist(handle, image, true);
+            }
+            else
+                raliExposure(handle, image, true);
+        }
+            break;
 	default:
             std::cout << "Not a valid option! Exiting!\n";
             return -1;
     }
 
+    raliSetPointwiseFusion(handle, fuse_pointwise != 0);
+
     // Calling the API to verify and build the augmentation graph
     raliVerify(handle);
 
@@ -317,8 +347,15 @@ int test(int test_case, const char* path, int rgb, int processing_device, int wi
     high_resolution_clock::time_point t1 = high_resolution_clock::now();
 
     int i = 0;
-    while (i++ < 100 && !raliIsEmpty(handle)){  
+    while (i++ < 100){  
         
+        if (raliIsEmpty(handle)) {
+            // With the decoded image cache on, keep going over the dataset so that the later epochs are served from the cache
+            if (cache_mb == 0)
+                break;
+            raliResetLoaders(handle);
+        }
+
         if (raliRun(handle) != 0)
             break;
 
@@ -336,6 +373,8 @@ int test(int test_case, const char* path, int rgb, int processing_device, int wi
     std::cout << "Decode   time " << rali_timing.decode_time << std::endl;
     std::cout << "Process  time " << rali_timing.process_time << std::endl;
     std::cout << "Transfer time " << rali_timing.transfer_time << std::endl;
+    if (cache_mb > 0)
+        std::cout << "Decoded image cache hit rate " << rali_timing.cache_hit_rate << std::endl;
     std::cout << "Total time " << dur << std::endl;
     std::cout << ">>>>> Total Elapsed Time " << dur / 1000000 << " sec " << dur % 1000000 << " us " << std::endl;
     
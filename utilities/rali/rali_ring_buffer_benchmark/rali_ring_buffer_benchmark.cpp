@@ -0,0 +1,148 @@
+/*
+MIT License
+
+Copyright (c) 2018 - 2022 Advanced Micro Devices, Inc. All rights reserved.
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in
+all copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT.  IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+THE SOFTWARE.
+*/
+
+#include <iostream>
+#include <cstdio>
+#include <cstdlib>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <vector>
+
+#include "ring_buffer_index.h"
+
+using namespace std::chrono;
+
+// The buffer synchronization rocAL used before RingBufferIndex: a mutex guarding the level plus two condition variables
+class LockedIndex
+{
+public:
+    explicit LockedIndex(size_t depth): _depth(depth) {}
+    size_t read_index() { return _read_ptr; }
+    size_t write_index() { return _write_ptr; }
+    void block_if_empty()
+    {
+        std::unique_lock<std::mutex> lock(_lock);
+        if(_level <= 0)
+            _wait_for_load.wait(lock);
+    }
+    void block_if_full()
+    {
+        std::unique_lock<std::mutex> lock(_lock);
+        if(_level >= _depth - 1)
+            _wait_for_unload.wait(lock);
+    }
+    void push()
+    {
+        std::unique_lock<std::mutex> names_lock(_names_buff_lock);
+        std::unique_lock<std::mutex> lock(_lock);
+        _write_ptr = (_write_ptr + 1) % _depth;
+        _level++;
+        lock.unlock();
+        _wait_for_load.notify_all();
+    }
+    void pop()
+    {
+        std::unique_lock<std::mutex> names_lock(_names_buff_lock);
+        std::unique_lock<std::mutex> lock(_lock);
+        _read_ptr = (_read_ptr + 1) % _depth;
+        _level--;
+        lock.unlock();
+        _wait_for_unload.notify_all();
+    }
+private:
+    const size_t _depth;
+    size_t _write_ptr = 0, _read_ptr = 0, _level = 0;
+    std::mutex _lock, _names_buff_lock;
+    std::condition_variable _wait_for_load, _wait_for_unload;
+};
+
+static void busy_work(unsigned ns)
+{
+    if(!ns)
+        return;
+    auto end = high_resolution_clock::now() + nanoseconds(ns);
+    while(high_resolution_clock::now() < end);
+}
+
+// Runs count handoffs through the index, returns the handoffs per second or 0 if the consumer saw a slot out of order
+template <typename Index>
+double run(size_t depth, size_t count, unsigned producer_work, unsigned consumer_work)
+{
+    Index index(depth);
+    std::vector<size_t> slots(depth);
+    bool in_order = true;
+    auto start = high_resolution_clock::now();
+    std::thread producer([&] {
+        for(size_t i = 0; i < count; i++) {
+            index.block_if_full();
+            busy_work(producer_work);
+            slots[index.write_index()] = i;
+            index.push();
+        }
+    });
+    for(size_t i = 0; i < count; i++) {
+        index.block_if_empty();
+        if(slots[index.read_index()] != i)
+            in_order = false;
+        busy_work(consumer_work);
+        index.pop();
+    }
+    producer.join();
+    double seconds = duration_cast<duration<double>>(high_resolution_clock::now() - start).count();
+    return in_order ? count / seconds : 0;
+}
+
+int main(int argc, const char ** argv)
+{
+    printf("Usage: rali_ring_buffer_benchmark <buffer_depth> <handoff_count> <producer_work_ns> <consumer_work_ns>\n");
+    int argIdx = 0;
+    size_t depth = 3;
+    size_t count = 1000000;
+    unsigned producer_work = 0, consumer_work = 0;
+    if(argc > ++argIdx)
+        depth = atoi(argv[argIdx]);
+    if(argc > ++argIdx)
+        count = atol(argv[argIdx]);
+    if(argc > ++argIdx)
+        producer_work = atoi(argv[argIdx]);
+    if(argc > ++argIdx)
+        consumer_work = atoi(argv[argIdx]);
+    if(depth < 2) {
+        printf("ERROR: buffer depth should be greater than one\n");
+        return -1;
+    }
+
+    double locked = run<LockedIndex>(depth, count, producer_work, consumer_work);
+    double lock_free = run<RingBufferIndex>(depth, count, producer_work, consumer_work);
+    if(locked == 0 || lock_free == 0) {
+        printf("ERROR: consumer received the slots out of order\n");
+        return -1;
+    }
+    printf("depth %zu, %zu handoffs, producer work %u ns, consumer work %u ns\n", depth, count, producer_work, consumer_work);
+    printf("mutex/condition variable : %12.0f handoffs/sec\n", locked);
+    printf("lock-free SPSC index     : %12.0f handoffs/sec (%.2fx)\n", lock_free, lock_free / locked);
+    return 0;
+}
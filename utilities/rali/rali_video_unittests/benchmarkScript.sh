@@ -0,0 +1,40 @@
+#!/bin/bash
+
+# Reports the video loader throughput (sequences/sec) for short sequences, where per batch setup costs dominate.
+# Frames are neither saved nor displayed. Assumes rali_video_unittests was built by testScript.sh.
+
+INPUT_PATH=$1
+READER_CASE=$2
+
+if [ -z "$INPUT_PATH" ]
+  then
+    echo "No input argument supplied"
+    exit
+fi
+
+if [ -z "$READER_CASE" ]
+  then
+    READER_CASE=1
+fi
+
+cd build || exit
+
+SAVE_FRAMES=0   # (save_frames:on/off)
+RGB=1           # (rgb:1/gray:0)
+DEVICE=0        # (cpu:0/gpu:1)
+HARDWARE_DECODE_MODE=0 # (hardware_decode_mode:on/off)
+SHUFFLE=1       # (shuffle:on/off)
+STEP=3          # Frame interval from one sequence to another sequence
+STRIDE=1        # Frame interval within frames in a sequences
+RESIZE_WIDTH=320   # applicable only for READER_CASE 2
+RESIZE_HEIGHT=240  # applicable only for READER_CASE 2
+
+for BATCH_SIZE in 1 4 8
+do
+    for SEQUENCE_LENGTH in 1 3 8
+    do
+        echo "Batch size $BATCH_SIZE, sequence length $SEQUENCE_LENGTH"
+        ./rali_video_unittests "$INPUT_PATH" $READER_CASE $DEVICE $HARDWARE_DECODE_MODE $BATCH_SIZE $SEQUENCE_LENGTH $STEP $STRIDE \
+        $RGB $SAVE_FRAMES $SHUFFLE $RESIZE_WIDTH $RESIZE_HEIGHT 1 0 0 0 0 | grep ">>>>>"
+    done
+done
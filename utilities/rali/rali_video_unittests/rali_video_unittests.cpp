@@ -342,6 +342,15 @@ int main(int argc, const char **argv)
     std::cout << "Process  time " << rali_timing.process_time << std::endl;
     std::cout << "Transfer time " << rali_timing.transfer_time << std::endl;
     std::cout << ">>>>> " << counter << " images/frames Processed. Total Elapsed Time " << dur / 1000000 << " sec " << dur % 1000000 << " us " << std::endl;
+    // counter holds the number of sequences, run with display off to benchmark the video loader
+    if (dur > 0 && counter > 0)
+    {
+        std::cout << ">>>>> Throughput " << (double)counter * 1000000 / dur << " sequences/sec, "
+                  << (double)counter * ouput_frames_per_sequence * 1000000 / dur << " frames/sec" << std::endl;
+        std::cout << ">>>>> Load + decode time per sequence " << (double)(rali_timing.load_time + rali_timing.decode_time) / counter << std::endl;
+        if (reader_case != 3)
+            std::cout << ">>>>> Decoded frames per output frame " << raliGetVideoDecodedFramesPerOutputFrame(handle) << std::endl;
+    }
     raliRelease(handle);
     mat_input.release();
     return 0;
@@ -67,6 +67,9 @@ void show_usage(const char * program, bool detail)
 	printf("      Set context affinity to CPU or GPU.\n");
 	printf("  -dump-profile\n");
 	printf("      Print performance profiling information after graph launch.\n");
+	printf("  -dump-trace:<file>\n");
+	printf("      Write a timeline of the graph execution to <file> in Chrome trace event format,\n");
+	printf("      which can be viewed with chrome://tracing or https://ui.perfetto.dev.\n");
 	printf("  -enable-profile\n");
 	printf("      use directive VX_DIRECTIVE_AMD_ENABLE_PROFILE_CAPTURE when graph is created\n");
 	printf("  -discard-compare-errors\n");
@@ -79,6 +82,13 @@ void show_usage(const char * program, bool detail)
 	printf("      into files '<dumpFilePrefix>dumpdata_####_<object-type>_<object-name>.raw'.\n");
 	printf("  -discard-commands:<cmd>[,cmd[...]]\n");
 	printf("      Discard the listed commands.\n");
+	printf("  -pipeline:<depth>\n");
+	printf("      Queue the non-virtual node outputs with <depth> references each and\n");
+	printf("      run up to <depth> frames concurrently. Inputs are read once and\n");
+	printf("      outputs are not written or compared. Requires -frames:<count>.\n");
+	printf("  -graph-snapshot:<file>\n");
+	printf("      Import the verified graph from <file> instead of verifying the GDF graph.\n");
+	printf("      If <file> doesn't exist, verify the graph and save its snapshot there.\n");
 	printf("\n");
 
 	if (!detail) return;
@@ -108,6 +118,9 @@ int main(int argc, char * argv[])
 	bool enableFullProfile = false, disableNodeFlushForCL = false;
 	std::string dumpDataConfig = "";
 	std::string discardCommandList = "";
+	int pipelineDepth = 1;
+	std::string graphSnapshotFile = "";
+	std::string traceFile = "";
 	for (arg = 1; arg < argc; arg++){
 		if (argv[arg][0] == '-'){
 			if (!_stricmp(argv[arg], "-h")) {
@@ -160,6 +173,9 @@ int main(int argc, char * argv[])
 			else if (!_stricmp(argv[arg], "-dump-profile")) {
 				enableDumpProfile = true;
 			}
+			else if (!_strnicmp(argv[arg], "-dump-trace:", 12)) {
+				traceFile = &argv[arg][12];
+			}
 			else if (!_stricmp(argv[arg], "-enable-profile")) {
 				enableFullProfile = true;
 			}
@@ -190,6 +206,14 @@ int main(int argc, char * argv[])
 				}
 				else { printf("ERROR: invalid graph optimizer flags: %s\n", argv[arg]); return -1; }
 			}
+			else if (!_strnicmp(argv[arg], "-pipeline:", 10)) {
+				if (sscanf(&argv[arg][10], "%i", &pipelineDepth) != 1 || pipelineDepth < 1) {
+					printf("ERROR: invalid pipeline depth: %s\n", argv[arg]); return -1;
+				}
+			}
+			else if (!_strnicmp(argv[arg], "-graph-snapshot:", 16)) {
+				graphSnapshotFile = &argv[arg][16];
+			}
 			else if (!_strnicmp(argv[arg], "-key-wait-delay:", 16)) {
 				(void)sscanf(&argv[arg][16], "%i", &waitKeyDelayInMilliSeconds);
 			}
@@ -203,6 +227,7 @@ int main(int argc, char * argv[])
 		}
 		else break;
 	}
+	if (pipelineDepth > 1 && graphSnapshotFile.length() > 0) { printf("ERROR: -graph-snapshot can't be used with -pipeline\n"); return -1; }
 	if (arg == argc) { show_usage(program, false); return -1; }
 	int argCount = argc - arg - 1;
 	int argParamOffset = 1;
@@ -220,6 +245,11 @@ int main(int argc, char * argv[])
 		if (doSetGraphOptimizerFlags) {
 			engine.SetGraphOptimizerFlags(graphOptimizerFlags);
 		}
+		engine.SetPipelineDepth(pipelineDepth);
+		engine.SetGraphSnapshot(graphSnapshotFile);
+		if (traceFile.length() > 0) {
+			engine.SetTraceFile(traceFile);
+		}
 		if (dumpDataConfig.find(",") != std::string::npos) {
 			engine.SetDumpDataConfig(dumpDataConfig);
 		}
@@ -24,6 +24,7 @@ THE SOFTWARE.
 #include "vxEngine.h"
 #include "vxEngineUtil.h"
 #include "vxParamHelper.h"
+#include "vxTensor.h"
 
 #define MAX_GDF_LEVELS  4
 #define NANO2MILLISECONDS(t) (((float)t)*0.000001f)
@@ -80,6 +81,8 @@ CVxEngine::CVxEngine()
 	m_dumpDataEnabled = false;
 	m_dumpDataCount = 0;
 	m_setBorderMode = false;
+	m_pipelineDepth = 1;
+	m_graphSnapshotFile = "";
 }
 
 CVxEngine::~CVxEngine()
@@ -149,6 +152,24 @@ int CVxEngine::SetGraphOptimizerFlags(vx_uint32 graph_optimizer_flags)
 	return 0;
 }
 
+void CVxEngine::SetPipelineDepth(int pipelineDepth)
+{
+	m_pipelineDepth = pipelineDepth;
+}
+
+void CVxEngine::SetGraphSnapshot(std::string graphSnapshotFile)
+{
+	m_graphSnapshotFile = graphSnapshotFile;
+}
+
+void CVxEngine::SetTraceFile(std::string traceFile)
+{
+	vx_status status = vxSetContextAttribute(m_context, VX_CONTEXT_ATTRIBUTE_AMD_TRACE_FILE, traceFile.c_str(), traceFile.length() + 1);
+	if (status)
+		ReportError("ERROR: vxSetContextAttribute(*,VX_CONTEXT_ATTRIBUTE_AMD_TRACE_FILE,%s) failed (%d:%s)\n", traceFile.c_str(), status, ovxEnum2Name(status));
+	vxSetTraceThreadName("runvx");
+}
+
 void CVxEngine::SetDumpDataConfig(std::string dumpDataConfig)
 {
 	m_dumpDataEnabled = false;
@@ -306,10 +327,20 @@ int CVxEngine::ProcessGraph(std::vector<const char *> * graphNameList, size_t be
 	m_numGraphProcessed++;
 
 	if (!graphNameList && !m_graphVerified)
-	{ // verify the graph
-		vx_status status = vxVerifyGraph(m_graph); fflush(stdout);
-		if (status != VX_SUCCESS)
-			ReportError("ERROR: vxVerifyGraph(graph) failed (%d:%s)\n", status, ovxEnum2Name(status));
+	{ // queue the node outputs for graph pipelining (if requested)
+		if (m_pipelineDepth > 1 && SetupGraphPipeline() < 0)
+			return -1;
+
+		// verify the graph, or replace it with a verified graph snapshot (if requested)
+		if (m_graphSnapshotFile.length() > 0) {
+			if (ProcessGraphSnapshot() < 0)
+				return -1;
+		}
+		else {
+			vx_status status = vxVerifyGraph(m_graph); fflush(stdout);
+			if (status != VX_SUCCESS)
+				ReportError("ERROR: vxVerifyGraph(graph) failed (%d:%s)\n", status, ovxEnum2Name(status));
+		}
 
 		// mark that graph has been verified
 		m_graphVerified = true;
@@ -389,6 +420,9 @@ int CVxEngine::ProcessGraph(std::vector<const char *> * graphNameList, size_t be
 	bool abortRequested = false;
 	int count = 0, status = 0;
 	m_timeMeasurements.clear();
+	if (!graphNameList && !m_pipelineRefs.empty()) {
+		return ProcessGraphPipeline(graphObjList);
+	}
 	int64_t start_time = utilGetClockCounter();
 	for (int frameNumber = m_frameStart; m_usingMultiFrameCapture || frameNumber < m_frameEnd; frameNumber++, count++){
 		// sync frame
@@ -712,6 +746,8 @@ int CVxEngine::BuildAndProcessGraphFromLine(int level, char * line)
 				ReleaseAllVirtualObjects();
 				ERROR_CHECK(vxReleaseGraph(&m_graph));
 				m_graphAutoAgeList.clear();
+				m_pipelineOutputs.clear();
+				m_pipelineRefs.clear();
 				// open a new graph
 				m_graphVerified = false;
 				m_graph = vxCreateGraph(m_context);
@@ -737,6 +773,8 @@ int CVxEngine::BuildAndProcessGraphFromLine(int level, char * line)
 			// open a new graph with empty virtual object list and delay age-list
 			ReleaseAllVirtualObjects();
 			m_graphAutoAgeList.clear();
+			m_pipelineOutputs.clear();
+			m_pipelineRefs.clear();
 			m_graphVerified = false;
 			m_graph = vxCreateGraph(m_context);
 			status = vxGetStatus((vx_reference)m_graph);
@@ -849,9 +887,8 @@ int CVxEngine::BuildAndProcessGraphFromLine(int level, char * line)
 		vx_size type_size = 0;
 		if (wordList.size() != 3 || _strnicmp(wordList[2], "userstruct:", 11) != 0 || sscanf(wordList[2]+11, "%i", (int *)&type_size) != 1)
 			ReportError("ERROR: syntax error: %s\n" "valid sytax: type <typeName> userstruct:<size-in-bytes>\n", originalText);
-		for (auto it = m_userStructMap.begin(); it != m_userStructMap.end(); ++it)
-			if (strcmp(wordList[1], it->first.c_str()) == 0)
-				ReportError("ERROR: syntax error: %s # <typeName> %s already used.\n", originalText, wordList[1]);
+		if (m_userStructMap.find(wordList[1]) != m_userStructMap.end())
+			ReportError("ERROR: syntax error: %s # <typeName> %s already used.\n", originalText, wordList[1]);
 		vx_enum type_enum = vxRegisterUserStruct(m_context, type_size);
 		if (type_enum < VX_TYPE_USER_STRUCT_START || type_enum > VX_TYPE_USER_STRUCT_END)
 			ReportError("ERROR: vxRegisterUserStruct(context,%d) failed (%d:%s)\n", (int)type_size, type_enum, ovxEnum2Name(type_enum));
@@ -859,9 +896,8 @@ int CVxEngine::BuildAndProcessGraphFromLine(int level, char * line)
 	}
 	else if (!_stricmp(wordList[0], "data") && wordList.size() == 4 && !strcmp(wordList[2], "="))
 	{ // syntax: data <name> = <data-description>[:<io-operations>]
-		for (auto it = m_paramMap.begin(); it != m_paramMap.end(); ++it)
-			if (strcmp(wordList[1], it->first.c_str()) == 0)
-				ReportError("ERROR: syntax error: %s # <dataName> %s already used.\n", originalText, wordList[1]);
+		if (m_paramMap.find(wordList[1]) != m_paramMap.end())
+			ReportError("ERROR: syntax error: %s # <dataName> %s already used.\n", originalText, wordList[1]);
 		std::string objDesc = wordList[3];
 		if (m_disableVirtual)
 			RemoveVirtualKeywordFromParamDescription(objDesc);
@@ -1060,6 +1096,19 @@ int CVxEngine::BuildAndProcessGraphFromLine(int level, char * line)
 				status = vxSetParameterByIndex(node, index, ref);
 				if (status != VX_SUCCESS)
 					ReportError("ERROR: vxSetParameterByIndex(node(%s),%d,obj(%s)) failed (%d:%s)\n", kernelName, index, paramDesc, status, ovxEnum2Name(status));
+				// non-virtual node outputs become queued graph parameters for graph pipelining
+				if (m_pipelineDepth > 1 && !paramDescIndex && !m_paramMap[name]->IsVirtualObject() &&
+					std::find(m_pipelineOutputs.begin(), m_pipelineOutputs.end(), ref) == m_pipelineOutputs.end())
+				{
+					vx_parameter parameter = vxGetParameterByIndex(node, index);
+					vx_enum direction = VX_INPUT;
+					ERROR_CHECK(vxQueryParameter(parameter, VX_PARAMETER_ATTRIBUTE_DIRECTION, &direction, sizeof(direction)));
+					if (direction != VX_INPUT) {
+						ERROR_CHECK(vxAddParameterToGraph(m_graph, parameter));
+						m_pipelineOutputs.push_back(ref);
+					}
+					ERROR_CHECK(vxReleaseParameter(&parameter));
+				}
 				if (needToReleaseImage)
 					ERROR_CHECK(vxReleaseImage((vx_image *)&ref));
 				index++;
@@ -1295,6 +1344,184 @@ void CVxEngine::PerformanceStatistics(int status, std::vector<vx_graph>& graphLi
 	fflush(stdout);
 }
 
+int CVxEngine::ProcessGraphSnapshot()
+{
+	// the snapshot carries the graph and its virtual data: the non-virtual GDF objects stay with the application
+	std::vector<vx_reference> refs;
+	std::vector<vx_enum> uses;
+	refs.push_back((vx_reference)m_graph);
+	uses.push_back(VX_IX_USE_EXPORT_VALUES);
+	for (auto it = m_paramMap.begin(); it != m_paramMap.end(); ++it) {
+		if (!it->second->IsVirtualObject() && it->second->GetVxObject()) {
+			refs.push_back(it->second->GetVxObject());
+			uses.push_back(VX_IX_USE_APPLICATION_CREATE);
+		}
+	}
+	FILE * fp = fopen(RootDirUpdated(m_graphSnapshotFile.c_str()), "rb");
+	if (fp) {
+		// import the verified graph from the snapshot and drop the graph built from the GDF
+		fseek(fp, 0L, SEEK_END);
+		long length = ftell(fp);
+		fseek(fp, 0L, SEEK_SET);
+		std::vector<vx_uint8> blob(length > 0 ? length : 1);
+		if (length <= 0 || fread(blob.data(), 1, length, fp) != (size_t)length) {
+			fclose(fp);
+			ReportError("ERROR: unable to read graph snapshot: %s\n", m_graphSnapshotFile.c_str());
+		}
+		fclose(fp);
+		int64_t clk = utilGetClockCounter();
+		vx_import import = vxImportObjectsFromMemory(m_context, refs.size(), refs.data(), uses.data(), blob.data(), blob.size());
+		vx_status status = vxGetStatus((vx_reference)import);
+		if (status != VX_SUCCESS)
+			ReportError("ERROR: vxImportObjectsFromMemory(%s) failed (%d:%s)\n", m_graphSnapshotFile.c_str(), status, ovxEnum2Name(status));
+		float msec = (float)(utilGetClockCounter() - clk) * 1000.0f / (float)utilGetClockFrequency();
+		ERROR_CHECK(vxReleaseGraph(&m_graph));
+		m_graph = (vx_graph)refs[0];
+		ERROR_CHECK(vxReleaseImport(&import));
+		printf("OK: imported graph snapshot %s (%.3f msec)\n", m_graphSnapshotFile.c_str(), msec);
+	}
+	else {
+		// verify the graph built from the GDF and save it as a snapshot for the next run
+		int64_t clk = utilGetClockCounter();
+		vx_status status = vxVerifyGraph(m_graph); fflush(stdout);
+		if (status != VX_SUCCESS)
+			ReportError("ERROR: vxVerifyGraph(graph) failed (%d:%s)\n", status, ovxEnum2Name(status));
+		float msec = (float)(utilGetClockCounter() - clk) * 1000.0f / (float)utilGetClockFrequency();
+		const vx_uint8 * blob = nullptr;
+		vx_size length = 0;
+		status = vxExportObjectsToMemory(m_context, refs.size(), refs.data(), uses.data(), &blob, &length);
+		if (status != VX_SUCCESS)
+			ReportError("ERROR: vxExportObjectsToMemory(graph) failed (%d:%s)\n", status, ovxEnum2Name(status));
+		fp = fopen(RootDirUpdated(m_graphSnapshotFile.c_str()), "wb");
+		if (!fp || fwrite(blob, 1, length, fp) != length) {
+			if (fp) fclose(fp);
+			vxReleaseExportedMemory(m_context, &blob);
+			ReportError("ERROR: unable to write graph snapshot: %s\n", m_graphSnapshotFile.c_str());
+		}
+		fclose(fp);
+		ERROR_CHECK(vxReleaseExportedMemory(m_context, &blob));
+		printf("OK: verified graph in %.3f msec and saved graph snapshot %s (%d bytes)\n", msec, m_graphSnapshotFile.c_str(), (int)length);
+	}
+	fflush(stdout);
+	return 0;
+}
+
+int CVxEngine::SetupGraphPipeline()
+{
+	if (m_pipelineOutputs.empty()) {
+		printf("WARNING: graph has no non-virtual outputs to pipeline -- processing one frame at a time\n");
+		return 0;
+	}
+	// create m_pipelineDepth references for each output: the GDF object is the first one
+	std::vector<vx_graph_parameter_queue_params_t> queueParams;
+	m_pipelineRefs.clear();
+	for (size_t i = 0; i < m_pipelineOutputs.size(); i++) {
+		vx_reference ref = m_pipelineOutputs[i];
+		vx_enum type; ERROR_CHECK(vxQueryReference(ref, VX_REFERENCE_TYPE, &type, sizeof(type)));
+		std::vector<vx_reference> refs(1, ref);
+		for (int k = 1; k < m_pipelineDepth; k++) {
+			vx_reference item = nullptr;
+			if (type == VX_TYPE_IMAGE) {
+				vx_uint32 width, height; vx_df_image format;
+				ERROR_CHECK(vxQueryImage((vx_image)ref, VX_IMAGE_ATTRIBUTE_WIDTH, &width, sizeof(width)));
+				ERROR_CHECK(vxQueryImage((vx_image)ref, VX_IMAGE_ATTRIBUTE_HEIGHT, &height, sizeof(height)));
+				ERROR_CHECK(vxQueryImage((vx_image)ref, VX_IMAGE_ATTRIBUTE_FORMAT, &format, sizeof(format)));
+				item = (vx_reference)vxCreateImage(m_context, width, height, format);
+			}
+			else if (type == VX_TYPE_ARRAY) {
+				vx_enum itemtype; vx_size capacity;
+				ERROR_CHECK(vxQueryArray((vx_array)ref, VX_ARRAY_ATTRIBUTE_ITEMTYPE, &itemtype, sizeof(itemtype)));
+				ERROR_CHECK(vxQueryArray((vx_array)ref, VX_ARRAY_ATTRIBUTE_CAPACITY, &capacity, sizeof(capacity)));
+				item = (vx_reference)vxCreateArray(m_context, itemtype, capacity);
+			}
+			else if (type == VX_TYPE_SCALAR) {
+				vx_enum datatype; vx_uint64 value = 0;
+				ERROR_CHECK(vxQueryScalar((vx_scalar)ref, VX_SCALAR_ATTRIBUTE_TYPE, &datatype, sizeof(datatype)));
+				item = (vx_reference)vxCreateScalar(m_context, datatype, &value);
+			}
+			else if (type == VX_TYPE_MATRIX) {
+				vx_enum datatype; vx_size columns, rows;
+				ERROR_CHECK(vxQueryMatrix((vx_matrix)ref, VX_MATRIX_ATTRIBUTE_TYPE, &datatype, sizeof(datatype)));
+				ERROR_CHECK(vxQueryMatrix((vx_matrix)ref, VX_MATRIX_ATTRIBUTE_COLUMNS, &columns, sizeof(columns)));
+				ERROR_CHECK(vxQueryMatrix((vx_matrix)ref, VX_MATRIX_ATTRIBUTE_ROWS, &rows, sizeof(rows)));
+				item = (vx_reference)vxCreateMatrix(m_context, datatype, columns, rows);
+			}
+			else if (type == VX_TYPE_TENSOR) {
+				vx_size num_dims, dims[MAX_TENSOR_DIMENSIONS]; vx_enum datatype; vx_int8 fixed_point_pos;
+				ERROR_CHECK(vxQueryTensor((vx_tensor)ref, VX_TENSOR_NUMBER_OF_DIMS, &num_dims, sizeof(num_dims)));
+				ERROR_CHECK(vxQueryTensor((vx_tensor)ref, VX_TENSOR_DIMS, dims, sizeof(dims[0]) * num_dims));
+				ERROR_CHECK(vxQueryTensor((vx_tensor)ref, VX_TENSOR_DATA_TYPE, &datatype, sizeof(datatype)));
+				ERROR_CHECK(vxQueryTensor((vx_tensor)ref, VX_TENSOR_FIXED_POINT_POSITION, &fixed_point_pos, sizeof(fixed_point_pos)));
+				item = (vx_reference)vxCreateTensor(m_context, num_dims, dims, datatype, fixed_point_pos);
+			}
+			else
+				ReportError("ERROR: graph pipelining: outputs of type %s can't be queued\n", ovxEnum2Name(type));
+			vx_status status = vxGetStatus(item);
+			if (status != VX_SUCCESS)
+				ReportError("ERROR: graph pipelining: unable to create a %s (%d:%s)\n", ovxEnum2Name(type), status, ovxEnum2Name(status));
+			refs.push_back(item);
+		}
+		m_pipelineRefs.push_back(refs);
+	}
+	for (size_t i = 0; i < m_pipelineRefs.size(); i++) {
+		vx_graph_parameter_queue_params_t params;
+		params.graph_parameter_index = (vx_uint32)i;
+		params.refs_list_size = (vx_uint32)m_pipelineRefs[i].size();
+		params.refs_list = m_pipelineRefs[i].data();
+		queueParams.push_back(params);
+	}
+	vx_status status = vxSetGraphScheduleConfig(m_graph, VX_GRAPH_SCHEDULE_MODE_QUEUE_AUTO, (vx_uint32)queueParams.size(), queueParams.data());
+	if (status != VX_SUCCESS)
+		ReportError("ERROR: vxSetGraphScheduleConfig(graph,VX_GRAPH_SCHEDULE_MODE_QUEUE_AUTO,%d) failed (%d:%s)\n", (int)queueParams.size(), status, ovxEnum2Name(status));
+	return 0;
+}
+
+int CVxEngine::ProcessGraphPipeline(std::vector<vx_graph>& graphList)
+{
+	// inputs are read once: frames of a pipelined graph only differ in the references their outputs are written to
+	if (m_usingMultiFrameCapture)
+		ReportError("ERROR: graph pipelining needs a frame count -- use -frames:<count>\n");
+	int status = ReadFrame(m_frameStart);
+	if (status < 0) throw - 1;
+	else if (status > 0)
+		ReportError("ERROR: insufficient input data -- check input files\n");
+	vx_uint32 depth = 1;
+	ERROR_CHECK(vxQueryGraph(m_graph, VX_GRAPH_ATTRIBUTE_AMD_PIPELINE_DEPTH, &depth, sizeof(depth)));
+	int frameCount = m_frameEnd - m_frameStart, launchCount = 0;
+	int64_t start_time = utilGetClockCounter();
+	for (; launchCount < frameCount && launchCount < m_pipelineDepth; launchCount++) {
+		for (size_t i = 0; i < m_pipelineRefs.size(); i++) {
+			ERROR_CHECK(vxGraphParameterEnqueueReadyRef(m_graph, (vx_uint32)i, &m_pipelineRefs[i][launchCount], 1));
+		}
+	}
+	for (int frameNumber = m_frameStart; frameNumber < m_frameEnd; frameNumber++) {
+		for (size_t i = 0; i < m_pipelineRefs.size(); i++) {
+			vx_reference ref; vx_uint32 num_refs = 0;
+			ERROR_CHECK(vxGraphParameterDequeueDoneRef(m_graph, (vx_uint32)i, &ref, 1, &num_refs));
+			if (launchCount < frameCount) {
+				ERROR_CHECK(vxGraphParameterEnqueueReadyRef(m_graph, (vx_uint32)i, &ref, 1));
+			}
+		}
+		if (launchCount < frameCount)
+			launchCount++;
+		MeasureFrame(frameNumber, 0, graphList);
+	}
+	status = vxWaitGraph(m_graph);
+	if (status != VX_SUCCESS)
+		ReportError("ERROR: vxWaitGraph() failed (%d:%s)\n", status, ovxEnum2Name(status));
+	int64_t end_time = utilGetClockCounter();
+	int64_t frequency = utilGetClockFrequency();
+	float elapsed_time = (float)(end_time - start_time) / frequency;
+	PerformanceStatistics(status, graphList);
+	printf("> total elapsed time: %6.2f sec (%d frames with pipeline depth %d: %.1f fps)\n", elapsed_time, frameCount, depth, frameCount / elapsed_time);
+	if (m_enableDumpProfile) {
+		char fileName[] = "stdout";
+		ERROR_CHECK(vxQueryGraph(m_graph, VX_GRAPH_ATTRIBUTE_AMD_PERFORMANCE_INTERNAL_PROFILE, fileName, 0));
+	}
+	fflush(stdout);
+	return BUILD_GRAPH_SUCCESS;
+}
+
 int CVxEngine::Shutdown()
 {
 	for (auto it = m_paramMap.begin(); it != m_paramMap.end(); ++it){
@@ -1307,6 +1534,12 @@ int CVxEngine::Shutdown()
 		vxReleaseGraph(&m_graph);
 		m_graph = nullptr;
 	}
+	for (size_t i = 0; i < m_pipelineRefs.size(); i++) {
+		for (size_t k = 1; k < m_pipelineRefs[i].size(); k++)
+			vxReleaseReference(&m_pipelineRefs[i][k]);
+	}
+	m_pipelineRefs.clear();
+	m_pipelineOutputs.clear();
 
 	if (m_context) {
 		vxReleaseContext(&m_context);
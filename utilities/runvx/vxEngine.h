@@ -34,6 +34,9 @@ public:
 	void SetConfigOptions(bool verbose, bool discardCompareErrors, bool enableDumpProfile, bool enableDumpGDF, int waitKeyDelayInMilliSeconds);
 	void SetFrameCountOptions(bool enableMultiFrameProcessing, bool framesEofRequested, bool frameCountSpecified, int frameStart, int frameEnd);
 	int SetGraphOptimizerFlags(vx_uint32 graph_optimizer_flags);
+	void SetPipelineDepth(int pipelineDepth);
+	void SetGraphSnapshot(std::string graphSnapshotFile);
+	void SetTraceFile(std::string traceFile);
 	void SetDumpDataConfig(std::string dumpDataConfig);
 	int SetParameter(int index, const char * param);
 	int Shell(int level, FILE * fp = nullptr);
@@ -59,6 +62,9 @@ protected:
 	bool IsUsingMultiFrameCapture();
 	void ReleaseAllVirtualObjects();
 	int RenameData(const char * oldName, const char * newName);
+	int SetupGraphPipeline();
+	int ProcessGraphPipeline(std::vector<vx_graph>& graphList);
+	int ProcessGraphSnapshot();
 
 private:
 	// implementation specific data
@@ -97,6 +103,12 @@ private:
 	std::string m_discardCommandList;
 	bool m_setBorderMode;
 	std::string m_cmdBorderMode;
+	// graph pipelining: non-virtual node outputs are queued graph parameters with m_pipelineDepth references each
+	int m_pipelineDepth;
+	std::vector<vx_reference> m_pipelineOutputs;
+	std::vector<std::vector<vx_reference> > m_pipelineRefs;
+	// graph snapshot: imported instead of verifying the GDF graph when the file exists, otherwise saved after verify
+	std::string m_graphSnapshotFile;
 };
 
 void PrintHelpGDF(const char * command = nullptr);
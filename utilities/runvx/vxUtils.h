@@ -35,6 +35,8 @@ THE SOFTWARE.
 
 #include <VX/vx.h>
 #include <VX/vx_compatibility.h>
+#include <VX/vx_khr_pipelining.h>
+#include <VX/vx_khr_ix.h>
 
 #include <stdio.h>
 #include <stdlib.h>